@@ -0,0 +1,42 @@
+#include <new>
+#include <atomic>
+#include <cstdlib>
+
+#include "AllocationCounter.h"
+
+namespace
+{
+	std::atomic<uint64> NumAllocations = 0x0;
+	std::atomic<uint64> NumBytesAllocated = 0x0;
+}
+
+uint64 AllocationCounter::GetNumAllocations()
+{
+	return NumAllocations.load(std::memory_order_relaxed);
+}
+
+uint64 AllocationCounter::GetNumBytesAllocated()
+{
+	return NumBytesAllocated.load(std::memory_order_relaxed);
+}
+
+void* operator new(size_t Size)
+{
+	NumAllocations.fetch_add(1, std::memory_order_relaxed);
+	NumBytesAllocated.fetch_add(Size, std::memory_order_relaxed);
+
+	if (void* Memory = std::malloc(Size > 0x0 ? Size : 0x1))
+		return Memory;
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* Memory) noexcept
+{
+	std::free(Memory);
+}
+
+void operator delete(void* Memory, size_t) noexcept
+{
+	std::free(Memory);
+}
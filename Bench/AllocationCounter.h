@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Unreal/Enums.h"
+
+/*
+* Counts all allocations made through the global operator new, which includes every standard container. The replaced operators are defined in
+* AllocationCounter.cpp, which must be linked into every executable using this header.
+*/
+namespace AllocationCounter
+{
+	uint64 GetNumAllocations();
+	uint64 GetNumBytesAllocated();
+}
@@ -0,0 +1,421 @@
+#include <Windows.h>
+#include <map>
+#include <format>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iterator>
+#include <algorithm>
+#include <filesystem>
+
+#include "Generators/CppGenerator.h"
+#include "Generators/MappingGenerator.h"
+#include "Generators/IDAMappingGenerator.h"
+#include "Generators/DumpspaceGenerator.h"
+
+#include "Generators/Generator.h"
+#include "HashStringTable.h"
+#include "FileManifest.h"
+#include "WorkerPool.h"
+#include "Profiler.h"
+
+#include "AllocationCounter.h"
+
+/*
+* Dumper7Bench runs the dumper on a MemorySnapshot instead of a live game, written by the dumper with "CaptureMemorySnapshot=1" in Dumper-7.ini.
+*
+*	Dumper7Bench <Snapshot.d7snap> [-n <Iterations>] [-o <OutputFolder>] [--baseline <File>] [--write-baseline <File>]
+*
+* Every iteration runs in a new process, the managers are only initialized once per process and a new process has the same cold start as a real dump.
+* An iteration runs InitEngineCore, InitInternal and all generators, and writes the profiler-phases, its allocations and hashes of the output to a file.
+*
+* The parent reports min/median/max of every phase. Output-hashes must be identical across iterations, and equal to the ones in the baseline-file if one
+* is passed. The exit-code is non-zero if any hash differs, so snapshots of reference games can be checked in CI.
+*/
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	/* Files that differ between identical runs, they're not part of the output-hashes */
+	constexpr const char* TraceFileName = "Dumper-7-Trace.json";
+
+	struct PhaseResult
+	{
+		uint64 NumCalls = 0x0;
+		int64 TotalNs = 0x0;
+	};
+
+	struct IterationResult
+	{
+		std::map<std::string, PhaseResult> Phases;
+		std::map<std::string, uint64> Counters;
+		std::map<std::string, uint64> Hashes;
+
+		uint64 NumAllocations = 0x0;
+		uint64 NumBytesAllocated = 0x0;
+	};
+}
+
+/* Whether the hashes of this top-level folder are compared, the Dumpspace-files contain the time they were generated at */
+static bool IsComparedOutput(const std::string& Group)
+{
+	return Group != DumpspaceGenerator::MainFolderName;
+}
+
+/* One hash per top-level entry of the dump-folder, over the relative paths and contents of all files beneath it */
+static std::map<std::string, uint64> HashOutput(const fs::path& DumperFolder)
+{
+	std::vector<fs::path> Files;
+
+	for (const fs::directory_entry& Entry : fs::recursive_directory_iterator(DumperFolder))
+	{
+		if (Entry.is_regular_file())
+			Files.push_back(Entry.path());
+	}
+
+	std::sort(Files.begin(), Files.end());
+
+	/* Caches of the incremental CppGenerator depend on the build of the dumper, not on the generated SDK */
+	const std::string CppCachePrefix = CppGenerator::MainFolderName + "/Cache/";
+
+	std::map<std::string, uint64> Hashes;
+
+	for (const fs::path& File : Files)
+	{
+		const fs::path RelativePath = File.lexically_relative(DumperFolder);
+		const std::string PathString = RelativePath.generic_string();
+		const std::string FileName = RelativePath.filename().string();
+
+		if (FileName == TraceFileName || FileName == FileManifest::ManifestFileName || PathString.starts_with(CppCachePrefix))
+			continue;
+
+		std::ifstream Input(File, std::ios::binary);
+		const std::string Content((std::istreambuf_iterator<char>(Input)), std::istreambuf_iterator<char>());
+
+		uint64& Hash = Hashes[RelativePath.begin()->string()];
+		Hash = (Hash * 0x100000001B3) ^ StringHash64(PathString.data(), static_cast<int32>(PathString.size()));
+		Hash = (Hash * 0x100000001B3) ^ StringHash64(Content.data(), static_cast<int32>(Content.size()));
+	}
+
+	return Hashes;
+}
+
+static int32 RunIteration(const fs::path& SnapshotPath, const fs::path& OutputFolder, const fs::path& ResultPath)
+{
+	/* Dumper-7.ini is not loaded, settings like the PackageFilter would change the results of the benchmark */
+	if (!Generator::LoadMemorySnapshot(SnapshotPath))
+		return 1;
+
+	Generator::SetGenerationRoot(OutputFolder);
+
+	const uint64 AllocationsBefore = AllocationCounter::GetNumAllocations();
+	const uint64 BytesAllocatedBefore = AllocationCounter::GetNumBytesAllocated();
+
+	{
+		Profiler::Scope TotalScope("Total");
+
+		Generator::InitEngineCore();
+		Generator::InitInternal();
+
+		Generator::GenerateAll<CppGenerator, MappingGenerator, IDAMappingGenerator, DumpspaceGenerator>();
+
+		Generator::WaitForBackgroundTasks();
+	}
+
+	const uint64 IterationAllocations = AllocationCounter::GetNumAllocations() - AllocationsBefore;
+	const uint64 IterationBytesAllocated = AllocationCounter::GetNumBytesAllocated() - BytesAllocatedBefore;
+
+	WorkerPool::Shutdown();
+
+	std::ofstream Result(ResultPath, std::ios::binary | std::ios::trunc);
+
+	if (!Result.is_open())
+		return 1;
+
+	for (const Profiler::PhaseSummary& Phase : Profiler::GetSummary())
+		Result << std::format("phase\t{}\t{}\t{}\n", Phase.Name, Phase.NumCalls, Phase.TotalNs);
+
+	for (int32 i = 0; i < static_cast<int32>(EProfilerCounter::Num); i++)
+		Result << std::format("counter\t{}\t{}\n", Profiler::GetCounterName(static_cast<EProfilerCounter>(i)), Profiler::GetCount(static_cast<EProfilerCounter>(i)));
+
+	Result << std::format("allocations\t{}\t{}\n", IterationAllocations, IterationBytesAllocated);
+
+	for (const auto& [Group, Hash] : HashOutput(Generator::GetDumperFolder()))
+		Result << std::format("hash\t{}\t{:016X}\n", Group, Hash);
+
+	return Result.good() ? 0 : 1;
+}
+
+static bool ReadIterationResult(const fs::path& ResultPath, IterationResult& OutResult)
+{
+	std::ifstream Input(ResultPath, std::ios::binary);
+
+	if (!Input.is_open())
+		return false;
+
+	std::string Line;
+
+	while (std::getline(Input, Line))
+	{
+		std::vector<std::string> Fields;
+		std::stringstream LineStream(Line);
+
+		for (std::string Field; std::getline(LineStream, Field, '\t');)
+			Fields.push_back(std::move(Field));
+
+		if (Fields.size() == 4 && Fields[0] == "phase")
+		{
+			OutResult.Phases[Fields[1]] = { std::stoull(Fields[2]), std::stoll(Fields[3]) };
+		}
+		else if (Fields.size() == 3 && Fields[0] == "counter")
+		{
+			OutResult.Counters[Fields[1]] = std::stoull(Fields[2]);
+		}
+		else if (Fields.size() == 3 && Fields[0] == "allocations")
+		{
+			OutResult.NumAllocations = std::stoull(Fields[1]);
+			OutResult.NumBytesAllocated = std::stoull(Fields[2]);
+		}
+		else if (Fields.size() == 3 && Fields[0] == "hash")
+		{
+			OutResult.Hashes[Fields[1]] = std::stoull(Fields[2], nullptr, 0x10);
+		}
+	}
+
+	return true;
+}
+
+template<typename T>
+static T GetMedian(std::vector<T> Values)
+{
+	std::sort(Values.begin(), Values.end());
+
+	return Values[Values.size() / 2];
+}
+
+static std::map<std::string, uint64> ReadBaseline(const fs::path& BaselinePath)
+{
+	std::map<std::string, uint64> Hashes;
+
+	std::ifstream Input(BaselinePath, std::ios::binary);
+
+	std::string Group;
+	std::string Hash;
+
+	while (Input >> Group >> Hash)
+		Hashes[Group] = std::stoull(Hash, nullptr, 0x10);
+
+	return Hashes;
+}
+
+static int32 RunBench(const fs::path& SnapshotPath, int32 NumIterations, const fs::path& OutputRoot, const fs::path& BaselinePath, const fs::path& WriteBaselinePath)
+{
+	wchar_t ExecutablePath[MAX_PATH] = {};
+	GetModuleFileNameW(nullptr, ExecutablePath, MAX_PATH);
+
+	std::error_code Error;
+	fs::create_directories(OutputRoot, Error);
+
+	std::vector<IterationResult> Results(NumIterations);
+
+	for (int32 i = 0; i < NumIterations; i++)
+	{
+		const fs::path IterationFolder = OutputRoot / std::format("Iteration{}", i);
+		const fs::path ResultPath = OutputRoot / std::format("Iteration{}.txt", i);
+
+		fs::remove_all(IterationFolder, Error);
+		fs::remove(ResultPath, Error);
+
+		std::wstring CommandLine = std::format(L"\"{}\" --run \"{}\" -o \"{}\" --result \"{}\"", ExecutablePath, SnapshotPath.wstring(), IterationFolder.wstring(), ResultPath.wstring());
+
+		STARTUPINFOW StartupInfo = { sizeof(StartupInfo) };
+		PROCESS_INFORMATION ProcessInfo = {};
+
+		if (!CreateProcessW(nullptr, CommandLine.data(), nullptr, nullptr, TRUE, 0x0, nullptr, nullptr, &StartupInfo, &ProcessInfo))
+		{
+			std::cerr << std::format("Could not start iteration {}!\n", i);
+			return 1;
+		}
+
+		WaitForSingleObject(ProcessInfo.hProcess, INFINITE);
+
+		DWORD ExitCode = 0x0;
+		GetExitCodeProcess(ProcessInfo.hProcess, &ExitCode);
+
+		CloseHandle(ProcessInfo.hThread);
+		CloseHandle(ProcessInfo.hProcess);
+
+		if (ExitCode != 0x0 || !ReadIterationResult(ResultPath, Results[i]))
+		{
+			std::cerr << std::format("Iteration {} failed with exit-code 0x{:X}!\n", i, ExitCode);
+			return 1;
+		}
+
+		/* Only the output of the last iteration is kept, to be inspected */
+		if (i < (NumIterations - 1))
+			fs::remove_all(IterationFolder, Error);
+	}
+
+	/* Longest phases first, by their median */
+	std::vector<std::pair<std::string, std::vector<int64>>> PhaseTimes;
+
+	for (const auto& [Name, Phase] : Results[0].Phases)
+	{
+		std::vector<int64> Times;
+
+		for (const IterationResult& Result : Results)
+		{
+			auto It = Result.Phases.find(Name);
+			Times.push_back(It != Result.Phases.end() ? It->second.TotalNs : 0x0);
+		}
+
+		PhaseTimes.emplace_back(Name, std::move(Times));
+	}
+
+	std::sort(PhaseTimes.begin(), PhaseTimes.end(), [](const auto& Left, const auto& Right) { return GetMedian(Left.second) > GetMedian(Right.second); });
+
+	std::cerr << std::format("\n{} iterations of '{}'\n\n", NumIterations, SnapshotPath.string());
+	std::cerr << std::format("{:<48} {:>8} {:>12} {:>12} {:>12}\n", "Phase", "Calls", "Min (ms)", "Median (ms)", "Max (ms)");
+
+	for (const auto& [Name, Times] : PhaseTimes)
+	{
+		const auto [Min, Max] = std::minmax_element(Times.begin(), Times.end());
+
+		std::cerr << std::format("{:<48} {:>8} {:>12.2f} {:>12.2f} {:>12.2f}\n", Name, Results[0].Phases[Name].NumCalls, *Min / 1e6, GetMedian(Times) / 1e6, *Max / 1e6);
+	}
+
+	std::vector<uint64> Allocations;
+	std::vector<uint64> BytesAllocated;
+
+	for (const IterationResult& Result : Results)
+	{
+		Allocations.push_back(Result.NumAllocations);
+		BytesAllocated.push_back(Result.NumBytesAllocated);
+	}
+
+	std::cerr << std::format("\nAllocations: {} (median), {:.2f}MiB\n", GetMedian(Allocations), GetMedian(BytesAllocated) / (1024.0 * 1024.0));
+
+	for (const auto& [Name, Count] : Results[0].Counters)
+		std::cerr << std::format("{}: {}\n", Name, Count);
+
+	const bool bHasBaseline = !BaselinePath.empty();
+	const std::map<std::string, uint64> Baseline = bHasBaseline ? ReadBaseline(BaselinePath) : std::map<std::string, uint64>();
+
+	bool bHasDifferences = false;
+
+	/* A missing or empty baseline would otherwise pass every comparison */
+	if (bHasBaseline && Baseline.empty())
+	{
+		std::cerr << std::format("\nBaseline '{}' is missing or contains no hashes!\n", BaselinePath.string());
+		bHasDifferences = true;
+	}
+
+	std::cerr << "\nOutput hashes:\n";
+
+	for (const auto& [Group, Hash] : Results[0].Hashes)
+	{
+		if (!IsComparedOutput(Group))
+		{
+			std::cerr << std::format("{:<32} {:016X} (not compared, contains the time of the dump)\n", Group, Hash);
+			continue;
+		}
+
+		const bool bIsStable = std::all_of(Results.begin(), Results.end(), [&](const IterationResult& Result) { return Result.Hashes.contains(Group) && Result.Hashes.at(Group) == Hash; });
+
+		auto BaselineIt = Baseline.find(Group);
+		const bool bIsInBaseline = !bHasBaseline || BaselineIt != Baseline.end();
+		const bool bMatchesBaseline = !bHasBaseline || (bIsInBaseline && BaselineIt->second == Hash);
+
+		bHasDifferences = bHasDifferences || !bIsStable || !bMatchesBaseline;
+
+		const char* BaselineResult = !bIsInBaseline ? " NOT IN BASELINE" : (bMatchesBaseline ? "" : " DIFFERS FROM BASELINE");
+
+		std::cerr << std::format("{:<32} {:016X}{}{}\n", Group, Hash, bIsStable ? "" : " DIFFERS BETWEEN ITERATIONS", BaselineResult);
+	}
+
+	/* Outputs the baseline expects, but this build didn't produce */
+	for (const auto& [Group, Hash] : Baseline)
+	{
+		if (Results[0].Hashes.contains(Group) && IsComparedOutput(Group))
+			continue;
+
+		bHasDifferences = true;
+
+		std::cerr << std::format("{:<32} {:016X} MISSING FROM OUTPUT\n", Group, Hash);
+	}
+
+	if (!WriteBaselinePath.empty())
+	{
+		std::ofstream BaselineFile(WriteBaselinePath, std::ios::binary | std::ios::trunc);
+
+		for (const auto& [Group, Hash] : Results[0].Hashes)
+		{
+			if (IsComparedOutput(Group))
+				BaselineFile << std::format("{} {:016X}\n", Group, Hash);
+		}
+	}
+
+	return bHasDifferences ? 2 : 0;
+}
+
+int main(int argc, char** argv)
+{
+	fs::path SnapshotPath;
+	fs::path OutputFolder = fs::temp_directory_path() / "Dumper7Bench";
+	fs::path ResultPath;
+	fs::path BaselinePath;
+	fs::path WriteBaselinePath;
+
+	int32 NumIterations = 5;
+	bool bIsIteration = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string_view Argument = argv[i];
+		const bool bHasValue = (i + 1) < argc;
+
+		if (Argument == "-n" && bHasValue)
+		{
+			NumIterations = std::max(std::atoi(argv[++i]), 1);
+		}
+		else if (Argument == "-o" && bHasValue)
+		{
+			OutputFolder = argv[++i];
+		}
+		else if (Argument == "--baseline" && bHasValue)
+		{
+			BaselinePath = argv[++i];
+		}
+		else if (Argument == "--write-baseline" && bHasValue)
+		{
+			WriteBaselinePath = argv[++i];
+		}
+		else if (Argument == "--result" && bHasValue)
+		{
+			ResultPath = argv[++i];
+		}
+		else if (Argument == "--run" && bHasValue)
+		{
+			bIsIteration = true;
+			SnapshotPath = argv[++i];
+		}
+		else
+		{
+			SnapshotPath = argv[i];
+		}
+	}
+
+	if (SnapshotPath.empty())
+	{
+		std::cerr << "Usage: Dumper7Bench <Snapshot.d7snap> [-n <Iterations>] [-o <OutputFolder>] [--baseline <File>] [--write-baseline <File>]\n";
+		return 1;
+	}
+
+	if (bIsIteration)
+		return RunIteration(SnapshotPath, OutputFolder, ResultPath);
+
+	return RunBench(fs::absolute(SnapshotPath), NumIterations, fs::absolute(OutputFolder), BaselinePath, WriteBaselinePath);
+}
@@ -0,0 +1,111 @@
+#include <Windows.h>
+#include <format>
+#include <string>
+#include <iostream>
+#include <filesystem>
+
+#include "Generators/CppGenerator.h"
+#include "Generators/MappingGenerator.h"
+#include "Generators/IDAMappingGenerator.h"
+#include "Generators/DumpspaceGenerator.h"
+
+#include "Generators/Generator.h"
+#include "WorkerPool.h"
+#include "Settings.h"
+#include "Platform.h"
+
+/*
+* Dumper7External dumps a running game from another process, all memory of the game is read through ProcessMemory.
+*
+*	Dumper7External <ProcessId> [-o <OutputFolder>] [--name <GameName>] [--version <GameVersion>]
+*
+* Nothing can be scanned or called in the game, so all offsets come from the entry of its build in Dumper-7-Offsets.ini, which is written when the
+* dumper runs inside of the game once. The game-name and -version can't be asked from the engine either, without Dumper-7.ini or arguments the
+* output-folder is named after the executable.
+*/
+
+namespace fs = std::filesystem;
+
+/* File-name of the main executable of the attached process, without its extension */
+static std::string GetAttachedExecutableName()
+{
+	wchar_t ImagePath[MAX_PATH] = {};
+	DWORD PathLength = MAX_PATH;
+
+	if (!QueryFullProcessImageNameW(ProcessMemory::GetExternalProcessHandle(), 0x0, ImagePath, &PathLength))
+		return "Unknown";
+
+	return fs::path(ImagePath).stem().string();
+}
+
+int main(int argc, char** argv)
+{
+	uint32 ProcessId = 0x0;
+	fs::path OutputFolder;
+
+	std::string GameName;
+	std::string GameVersion;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string_view Argument = argv[i];
+		const bool bHasValue = (i + 1) < argc;
+
+		if (Argument == "-o" && bHasValue)
+		{
+			OutputFolder = argv[++i];
+		}
+		else if (Argument == "--name" && bHasValue)
+		{
+			GameName = argv[++i];
+		}
+		else if (Argument == "--version" && bHasValue)
+		{
+			GameVersion = argv[++i];
+		}
+		else
+		{
+			ProcessId = static_cast<uint32>(std::strtoul(argv[i], nullptr, 0));
+		}
+	}
+
+	if (ProcessId == 0x0)
+	{
+		std::cerr << "Usage: Dumper7External <ProcessId> [-o <OutputFolder>] [--name <GameName>] [--version <GameVersion>]\n";
+		return 1;
+	}
+
+	Settings::Config::Load();
+
+	if (!Generator::AttachToProcess(ProcessId))
+		return 1;
+
+	if (!OutputFolder.empty())
+		Generator::SetGenerationRoot(fs::absolute(OutputFolder));
+
+	Generator::InitEngineCore();
+
+	if (!GameName.empty() || !GameVersion.empty())
+	{
+		Settings::Generator::GameName = GameName;
+		Settings::Generator::GameVersion = GameVersion;
+	}
+	else if (Settings::Generator::GameName.empty() && Settings::Generator::GameVersion.empty())
+	{
+		Settings::Generator::GameName = GetAttachedExecutableName();
+		Settings::Generator::GameVersion = "External";
+	}
+
+	std::cerr << std::format("FolderName: {}-{}\n\n", Settings::Generator::GameVersion, Settings::Generator::GameName);
+
+	Generator::InitInternal();
+
+	Generator::GenerateAll<CppGenerator, MappingGenerator, IDAMappingGenerator, DumpspaceGenerator>();
+
+	Generator::WaitForBackgroundTasks();
+
+	WorkerPool::Shutdown();
+	ProcessMemory::DetachExternal();
+
+	return 0;
+}
@@ -0,0 +1,649 @@
+#include <cmath>
+#include <memory>
+#include <random>
+#include <chrono>
+#include <format>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <iostream>
+#include <algorithm>
+#include <string_view>
+#include <unordered_set>
+
+#include "Managers/CollisionManager.h"
+#include "Managers/DependencyManager.h"
+#include "Managers/PackageManager.h"
+#include "HashStringTable.h"
+#include "MemoryReport.h"
+
+#include "AllocationCounter.h"
+
+/*
+* Dumper7MicroBench times the data structures every dump runs through on synthetic workloads, it requires neither a game nor a MemorySnapshot.
+*
+*	Dumper7MicroBench [-n <NumNames>] [-r <Repetitions>] [--seed <Seed>] [--filter <Substring>]
+*
+* All workloads are derived from NumNames and generated from a fixed seed, so the results of two builds are comparable. Every benchmark runs
+* 'Repetitions' times and reports its fastest run as ns/op and allocations/op, next to the memory of the resulting structure (see MemoryReport).
+*
+* CollisionManager and PackageManager only work on UEStructs in game-memory. Their benchmarks run the structures they are built on instead,
+* NameLookupTable for the names inherited through class-hierarchies and PackageIncludeSet for the includes between packages.
+*/
+
+namespace
+{
+	struct BenchOptions
+	{
+		int32 NumNames = 500'000;
+		int32 NumRepetitions = 5;
+		uint64 Seed = 0xD7D7D7D7;
+		std::string Filter;
+	};
+
+	struct Measurement
+	{
+		int64 Ns = INT64_MAX;
+		uint64 NumAllocations = 0x0;
+		uint64 NumBytesAllocated = 0x0;
+	};
+
+	struct NameWorkload
+	{
+		/* Names in the order they are added, including duplicates */
+		std::vector<std::string> Names;
+		int32 NumUniqueNames = 0x0;
+	};
+
+	struct HierarchyWorkload
+	{
+		/* Super of every class, -1 for the root of a hierarchy. Supers always come before the classes inheriting from them. */
+		std::vector<int32> Supers;
+
+		/* Structs used by the members of every class, always classes with a lower index */
+		std::vector<std::vector<int32>> MemberDependencies;
+
+		/* Names of the members declared by every class, indices into NameWorkload::Names */
+		std::vector<std::vector<int32>> MemberNames;
+
+		int32 MaxDepth = 0x0;
+	};
+
+	struct PackageWorkload
+	{
+		/* Packages included by every package, as dense indices */
+		std::vector<std::vector<int32>> Includes;
+	};
+
+	/* Results are added to this, so the compiler can't remove the benchmarked work */
+	volatile uint64 Sink = 0x0;
+}
+
+/* Calls 'Setup' untimed and 'Run' timed, 'Repetitions' times each. Returns the fastest repetition. */
+template<typename SetupType, typename RunType>
+static Measurement Measure(int32 NumRepetitions, SetupType&& Setup, RunType&& Run)
+{
+	Measurement Best;
+
+	for (int32 i = 0; i < NumRepetitions; i++)
+	{
+		Setup();
+
+		const uint64 AllocationsBefore = AllocationCounter::GetNumAllocations();
+		const uint64 BytesAllocatedBefore = AllocationCounter::GetNumBytesAllocated();
+		const auto StartTime = std::chrono::steady_clock::now();
+
+		Run();
+
+		const int64 Ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - StartTime).count();
+
+		if (Ns < Best.Ns)
+			Best = { Ns, AllocationCounter::GetNumAllocations() - AllocationsBefore, AllocationCounter::GetNumBytesAllocated() - BytesAllocatedBefore };
+	}
+
+	return Best;
+}
+
+static bool ShouldRun(const BenchOptions& Options, std::string_view Name)
+{
+	return Options.Filter.empty() || Name.find(Options.Filter) != std::string_view::npos;
+}
+
+static void PrintHeader()
+{
+	std::cerr << std::format("\n{:<48} {:>10} {:>10} {:>10} {:>12} {:>12}\n", "Benchmark", "Ops", "ns/op", "allocs/op", "Used (KiB)", "Alloc (KiB)");
+}
+
+/* 'Memory' is the state of the structure after the benchmark, structures without a MemoryReport only show their allocations */
+static void PrintResult(std::string_view Name, uint64 NumOps, const Measurement& Result, const MemoryReport* Memory = nullptr)
+{
+	NumOps = std::max(NumOps, 1ull);
+
+	const std::string UsedKiB = Memory ? std::format("{:.2f}", Memory->BytesUsed / 1024.0) : "-";
+	const std::string AllocatedKiB = Memory ? std::format("{:.2f}", Memory->BytesAllocated / 1024.0) : std::format("{:.2f}", Result.NumBytesAllocated / 1024.0);
+
+	std::cerr << std::format("{:<48} {:>10} {:>10.2f} {:>10.3f} {:>12} {:>12}\n", Name, NumOps, static_cast<double>(Result.Ns) / NumOps,
+		static_cast<double>(Result.NumAllocations) / NumOps, UsedKiB, AllocatedKiB);
+}
+
+
+/*
+* Member-, function- and type-names are built from a small vocabulary, so combinations repeat by themselves. On top of that a share of all
+* names repeats an earlier one, skewed towards the first names, like 'Value', 'Owner' or 'ReturnValue' are shared by thousands of structs.
+*/
+static NameWorkload GenerateNames(int32 NumNames, std::mt19937_64& Random)
+{
+	static constexpr std::string_view Prefixes[] = {
+		"", "", "", "", "b", "K2_", "On", "Get", "Set", "Is", "Has", "Server", "Client", "BP_", "Default", "Cached", "Max", "Min", "Num", "Current"
+	};
+
+	static constexpr std::string_view Words[] = {
+		"Actor", "Component", "Location", "Rotation", "Scale", "Velocity", "Health", "Damage", "Target", "Owner", "Instigator", "Weapon",
+		"Ammo", "Ability", "Effect", "Tag", "Mesh", "Material", "Anim", "Montage", "Sound", "Widget", "Input", "Camera", "Movement", "Speed",
+		"Time", "Delay", "Count", "Index", "Value", "Name", "Class", "Struct", "Data", "Config", "State", "Mode", "Team", "Player", "Controller",
+		"Pawn", "Character", "Vehicle", "Spawn", "Socket", "Bone", "Transform", "Visible", "Enabled", "Active", "Replicated", "Item", "Slot",
+		"Inventory", "Quest", "Level", "World", "Settings", "Handle", "Event", "Delegate", "Offset", "Radius"
+	};
+
+	/* Share of all names that repeat an earlier name */
+	constexpr double DuplicateRate = 0.3;
+
+	std::uniform_int_distribution<size_t> PrefixDist(0, std::size(Prefixes) - 1);
+	std::uniform_int_distribution<size_t> WordDist(0, std::size(Words) - 1);
+	std::uniform_real_distribution<double> UnitDist(0.0, 1.0);
+
+	NameWorkload Workload;
+	Workload.Names.reserve(NumNames);
+
+	for (int32 i = 0; i < NumNames; i++)
+	{
+		if (!Workload.Names.empty() && UnitDist(Random) < DuplicateRate)
+		{
+			const double Skew = std::pow(UnitDist(Random), 3.0);
+			Workload.Names.push_back(Workload.Names[static_cast<size_t>(Skew * (Workload.Names.size() - 1))]);
+			continue;
+		}
+
+		std::string Name = std::string(Prefixes[PrefixDist(Random)]) + std::string(Words[WordDist(Random)]) + std::string(Words[WordDist(Random)]);
+
+		if ((Random() % 2) == 0)
+			Name += Words[WordDist(Random)];
+
+		if ((Random() % 4) == 0)
+			Name += std::format("_{}", Random() % 0x40);
+
+		Workload.Names.push_back(std::move(Name));
+	}
+
+	std::unordered_set<std::string_view> UniqueNames(Workload.Names.begin(), Workload.Names.end());
+	Workload.NumUniqueNames = static_cast<int32>(UniqueNames.size());
+
+	return Workload;
+}
+
+/* Forests of classes up to 'MaxHierarchyDepth' deep, every class declares a few members and uses structs declared before it */
+static HierarchyWorkload GenerateHierarchies(int32 NumClasses, int32 NumNames, std::mt19937_64& Random)
+{
+	constexpr int32 MaxHierarchyDepth = 0x20;
+
+	HierarchyWorkload Workload;
+	Workload.Supers.resize(NumClasses);
+	Workload.MemberDependencies.resize(NumClasses);
+	Workload.MemberNames.resize(NumClasses);
+
+	std::vector<int32> Depths(NumClasses, 0x0);
+
+	int32 NameCursor = 0x0;
+
+	for (int32 i = 0; i < NumClasses; i++)
+	{
+		const int32 HierarchyStart = i - (i % MaxHierarchyDepth);
+
+		/* Mostly chains, sometimes siblings of the previous class */
+		if (i == HierarchyStart)
+		{
+			Workload.Supers[i] = -1;
+		}
+		else
+		{
+			Workload.Supers[i] = std::max(HierarchyStart, i - 1 - static_cast<int32>(Random() % 3));
+			Depths[i] = Depths[Workload.Supers[i]] + 1;
+		}
+
+		Workload.MaxDepth = std::max(Workload.MaxDepth, Depths[i]);
+
+		if (i > 0)
+		{
+			for (int32 j = static_cast<int32>(Random() % 7); j > 0; j--)
+				Workload.MemberDependencies[i].push_back(static_cast<int32>(Random() % i));
+		}
+
+		for (int32 j = 4 + static_cast<int32>(Random() % 13); j > 0; j--)
+		{
+			Workload.MemberNames[i].push_back(NameCursor);
+			NameCursor = (NameCursor + 1) % NumNames;
+		}
+	}
+
+	return Workload;
+}
+
+/* Every package includes a random selection of other packages, like the modules of a large game do */
+static PackageWorkload GeneratePackages(int32 NumPackages, std::mt19937_64& Random)
+{
+	PackageWorkload Workload;
+	Workload.Includes.resize(NumPackages);
+
+	for (int32 i = 0; i < NumPackages; i++)
+	{
+		for (int32 j = 20 + static_cast<int32>(Random() % 81); j > 0; j--)
+			Workload.Includes[i].push_back(static_cast<int32>(Random() % NumPackages));
+	}
+
+	return Workload;
+}
+
+
+static void RunNameBenchmarks(const BenchOptions& Options, const NameWorkload& Workload, std::mt19937_64& Random)
+{
+	const uint64 NumNames = Workload.Names.size();
+
+	std::unique_ptr<HashStringTable> Table;
+
+	/* Filled by the first benchmark that needs it, or by the insertion-benchmark */
+	auto FillTable = [&]() -> void
+	{
+		Table = std::make_unique<HashStringTable>();
+
+		for (const std::string& Name : Workload.Names)
+			Table->FindOrAdd(Name);
+	};
+
+	if (ShouldRun(Options, "HashStringTable::FindOrAdd (insert)"))
+	{
+		const Measurement Result = Measure(Options.NumRepetitions, [&]() { Table = std::make_unique<HashStringTable>(); }, [&]()
+		{
+			for (const std::string& Name : Workload.Names)
+				Table->FindOrAdd(Name);
+		});
+
+		const MemoryReport Memory = Table->GetMemoryReport();
+		PrintResult("HashStringTable::FindOrAdd (insert)", NumNames, Result, &Memory);
+	}
+
+	if (!Table)
+		FillTable();
+
+	const MemoryReport TableMemory = Table->GetMemoryReport();
+
+	if (ShouldRun(Options, "HashStringTable::FindOrAdd (lookup)"))
+	{
+		std::vector<const std::string*> Lookups;
+		Lookups.reserve(NumNames);
+
+		for (const std::string& Name : Workload.Names)
+			Lookups.push_back(&Name);
+
+		std::shuffle(Lookups.begin(), Lookups.end(), Random);
+
+		const Measurement Result = Measure(Options.NumRepetitions, []() {}, [&]()
+		{
+			uint64 Sum = 0x0;
+
+			for (const std::string* Name : Lookups)
+				Sum += static_cast<uint32>(Table->FindOrAdd(*Name, false).first);
+
+			Sink = Sink + Sum;
+		});
+
+		PrintResult("HashStringTable::FindOrAdd (lookup)", NumNames, Result, &TableMemory);
+	}
+
+	if (ShouldRun(Options, "HashStringTable iteration"))
+	{
+		const Measurement Result = Measure(Options.NumRepetitions, []() {}, [&]()
+		{
+			uint64 Sum = 0x0;
+
+			for (const StringEntry& Entry : *Table)
+				Sum += Entry.GetNameView().size();
+
+			Sink = Sink + Sum;
+		});
+
+		PrintResult("HashStringTable iteration", Workload.NumUniqueNames, Result, &TableMemory);
+	}
+
+	/* Entries of the same length, the only ones Strcmp is called on by HashStringTable::Find */
+	std::vector<const StringEntry*> Entries;
+	Entries.reserve(Workload.NumUniqueNames);
+
+	for (const StringEntry& Entry : *Table)
+		Entries.push_back(&Entry);
+
+	std::stable_sort(Entries.begin(), Entries.end(), [](const StringEntry* Left, const StringEntry* Right) { return Left->GetNameView().size() < Right->GetNameView().size(); });
+
+	if (ShouldRun(Options, "StringEntry Strcmp (mismatch)"))
+	{
+		uint64 NumComparisons = 0x0;
+
+		const Measurement Result = Measure(Options.NumRepetitions, [&]() { NumComparisons = 0x0; }, [&]()
+		{
+			uint64 Sum = 0x0;
+
+			for (size_t i = 1; i < Entries.size(); i++)
+			{
+				if (Entries[i - 1]->GetNameView().size() != Entries[i]->GetNameView().size())
+					continue;
+
+				Sum += Strcmp(Entries[i - 1]->GetNameView().data(), *Entries[i]) != 0;
+				NumComparisons++;
+			}
+
+			Sink = Sink + Sum;
+		});
+
+		PrintResult("StringEntry Strcmp (mismatch)", NumComparisons, Result);
+	}
+
+	if (ShouldRun(Options, "StringEntry Strcmp (match)"))
+	{
+		/* Compared against a copy, like a string looked up in the table */
+		std::vector<std::string> Copies;
+		Copies.reserve(Entries.size());
+
+		for (const StringEntry* Entry : Entries)
+			Copies.push_back(Entry->GetName());
+
+		const Measurement Result = Measure(Options.NumRepetitions, []() {}, [&]()
+		{
+			uint64 Sum = 0x0;
+
+			for (size_t i = 0; i < Entries.size(); i++)
+				Sum += Strcmp(Copies[i].data(), *Entries[i]) == 0;
+
+			Sink = Sink + Sum;
+		});
+
+		PrintResult("StringEntry Strcmp (match)", Entries.size(), Result);
+	}
+}
+
+static void RunHierarchyBenchmarks(const BenchOptions& Options, const NameWorkload& Names, const HierarchyWorkload& Workload)
+{
+	const int32 NumClasses = static_cast<int32>(Workload.Supers.size());
+
+	uint64 NumDependencies = 0x0;
+
+	for (int32 i = 0; i < NumClasses; i++)
+		NumDependencies += 1 + (Workload.Supers[i] != -1) + Workload.MemberDependencies[i].size();
+
+	auto AddAllDependencies = [&](DependencyManager& Manager) -> void
+	{
+		for (int32 i = 0; i < NumClasses; i++)
+		{
+			Manager.SetExists(i);
+
+			if (Workload.Supers[i] != -1)
+				Manager.AddDependency(i, Workload.Supers[i]);
+
+			for (const int32 Dependency : Workload.MemberDependencies[i])
+				Manager.AddDependency(i, Dependency);
+		}
+	};
+
+	std::unique_ptr<DependencyManager> Manager;
+
+	if (ShouldRun(Options, "DependencyManager::AddDependency"))
+	{
+		const Measurement Result = Measure(Options.NumRepetitions, [&]() { Manager = std::make_unique<DependencyManager>(); }, [&]() { AddAllDependencies(*Manager); });
+
+		const MemoryReport Memory = Manager->GetMemoryReport();
+		PrintResult("DependencyManager::AddDependency", NumDependencies, Result, &Memory);
+	}
+
+	if (ShouldRun(Options, "DependencyManager::Freeze"))
+	{
+		auto Setup = [&]() -> void
+		{
+			Manager = std::make_unique<DependencyManager>();
+			AddAllDependencies(*Manager);
+		};
+
+		const Measurement Result = Measure(Options.NumRepetitions, Setup, [&]() { Manager->Freeze(); });
+
+		const MemoryReport Memory = Manager->GetMemoryReport();
+		PrintResult("DependencyManager::Freeze", NumClasses, Result, &Memory);
+	}
+
+	if (!Manager || !Manager->IsFrozen())
+	{
+		Manager = std::make_unique<DependencyManager>();
+		AddAllDependencies(*Manager);
+		Manager->Freeze();
+	}
+
+	const MemoryReport FrozenMemory = Manager->GetMemoryReport();
+
+	if (ShouldRun(Options, "DependencyManager::VisitAllNodes"))
+	{
+		const Measurement Result = Measure(Options.NumRepetitions, []() {}, [&]()
+		{
+			uint64 Sum = 0x0;
+			Manager->VisitAllNodes([&](int32 Index) { Sum += Index; });
+			Sink = Sink + Sum;
+		});
+
+		PrintResult("DependencyManager::VisitAllNodes", NumClasses, Result, &FrozenMemory);
+	}
+
+	if (ShouldRun(Options, "DependencyManager::VisitIndexAndDependencies"))
+	{
+		/* The last class of every hierarchy, the one with the most (indirect) dependencies */
+		constexpr int32 ClassesPerVisit = 0x20;
+
+		const Measurement Result = Measure(Options.NumRepetitions, []() {}, [&]()
+		{
+			uint64 Sum = 0x0;
+
+			for (int32 i = ClassesPerVisit - 1; i < NumClasses; i += ClassesPerVisit)
+				Manager->VisitIndexAndDependencies(i, [&](int32 Index) { Sum += Index; });
+
+			Sink = Sink + Sum;
+		});
+
+		PrintResult("DependencyManager::VisitIndexAndDependencies", NumClasses / ClassesPerVisit, Result, &FrozenMemory);
+	}
+
+	/* Same names as the member-names of structs, collisions within this table are the ones CollisionManager resolves */
+	HashStringTable MemberNames;
+	std::vector<HashStringTableIndex> NameIndices;
+	NameIndices.reserve(Names.Names.size());
+
+	for (const std::string& Name : Names.Names)
+		NameIndices.push_back(MemberNames.FindOrAdd(Name).first);
+
+	uint64 NumMemberNames = 0x0;
+
+	for (const std::vector<int32>& ClassNames : Workload.MemberNames)
+		NumMemberNames += ClassNames.size();
+
+	/* Like CollisionManager::GetInheritedNames, the table of a class starts as a copy of the one of its super */
+	std::vector<NameLookupTable> InheritedNames;
+
+	auto BuildInheritedNames = [&]() -> void
+	{
+		for (int32 i = 0; i < NumClasses; i++)
+		{
+			if (Workload.Supers[i] != -1)
+				InheritedNames[i] = InheritedNames[Workload.Supers[i]];
+
+			for (const int32 NameIndex : Workload.MemberNames[i])
+				InheritedNames[i].Add(NameInfo(NameIndices[NameIndex], ECollisionType::MemberName));
+		}
+	};
+
+	if (ShouldRun(Options, "NameLookupTable (inherited names)"))
+	{
+		const Measurement Result = Measure(Options.NumRepetitions, [&]() { InheritedNames = std::vector<NameLookupTable>(NumClasses); }, BuildInheritedNames);
+
+		PrintResult(std::format("NameLookupTable (inherited names, depth {})", Workload.MaxDepth), NumMemberNames, Result);
+	}
+
+	if (ShouldRun(Options, "NameLookupTable::Find"))
+	{
+		if (InheritedNames.empty())
+		{
+			InheritedNames = std::vector<NameLookupTable>(NumClasses);
+			BuildInheritedNames();
+		}
+
+		uint64 NumLookups = 0x0;
+
+		const Measurement Result = Measure(Options.NumRepetitions, [&]() { NumLookups = 0x0; }, [&]()
+		{
+			uint64 NumCollisions = 0x0;
+
+			/* Names of a class are looked up in the names inherited from its super */
+			for (int32 i = 0; i < NumClasses; i++)
+			{
+				if (Workload.Supers[i] == -1)
+					continue;
+
+				const NameLookupTable& SuperNames = InheritedNames[Workload.Supers[i]];
+
+				for (const int32 NameIndex : Workload.MemberNames[i])
+				{
+					NumCollisions += SuperNames.Find(NameIndices[NameIndex]) != nullptr;
+					NumLookups++;
+				}
+			}
+
+			Sink = Sink + NumCollisions;
+		});
+
+		PrintResult("NameLookupTable::Find", NumLookups, Result);
+	}
+}
+
+static void RunPackageBenchmarks(const BenchOptions& Options, const PackageWorkload& Workload)
+{
+	const int32 NumPackages = static_cast<int32>(Workload.Includes.size());
+
+	std::vector<PackageIncludeSet> IncludeSets(NumPackages);
+	MemoryReport Memory;
+
+	uint64 NumIncludes = 0x0;
+
+	for (int32 i = 0; i < NumPackages; i++)
+	{
+		IncludeSets[i].Resize(NumPackages);
+
+		/* Two of three includes are "_structs.hpp", the rest "_classes.hpp" */
+		for (const int32 Include : Workload.Includes[i])
+		{
+			if ((Include % 3) != 0)
+			{
+				IncludeSets[i].Structs.Set(Include);
+			}
+			else
+			{
+				IncludeSets[i].Classes.Set(Include);
+			}
+		}
+
+		NumIncludes += Workload.Includes[i].size();
+		Memory += IncludeSets[i].GetMemoryReport();
+	}
+
+	if (ShouldRun(Options, "PackageIncludeSet::operator|="))
+	{
+		/* Merges the includes of every included package, the first step of the transitive includes computed in PackageManager::PostInit */
+		std::vector<PackageIncludeSet> Merged;
+
+		const Measurement Result = Measure(Options.NumRepetitions, [&]() { Merged = IncludeSets; }, [&]()
+		{
+			for (int32 i = 0; i < NumPackages; i++)
+			{
+				for (const int32 Include : Workload.Includes[i])
+					Merged[i] |= IncludeSets[Include];
+			}
+		});
+
+		PrintResult("PackageIncludeSet::operator|=", NumIncludes, Result, &Memory);
+	}
+
+	if (ShouldRun(Options, "PackageIncludeSet::ForEach"))
+	{
+		uint64 NumVisited = 0x0;
+
+		const Measurement Result = Measure(Options.NumRepetitions, [&]() { NumVisited = 0x0; }, [&]()
+		{
+			uint64 Sum = 0x0;
+
+			for (const PackageIncludeSet& Includes : IncludeSets)
+			{
+				Includes.ForEach([&](int32 DenseIndex, bool bIncludesStructs, bool bIncludesClasses)
+				{
+					Sum += DenseIndex + bIncludesStructs + bIncludesClasses;
+					NumVisited++;
+				});
+			}
+
+			Sink = Sink + Sum;
+		});
+
+		PrintResult("PackageIncludeSet::ForEach", NumVisited, Result, &Memory);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	BenchOptions Options;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string_view Argument = argv[i];
+		const bool bHasValue = (i + 1) < argc;
+
+		if (Argument == "-n" && bHasValue)
+		{
+			Options.NumNames = std::max(std::atoi(argv[++i]), 0x400);
+		}
+		else if (Argument == "-r" && bHasValue)
+		{
+			Options.NumRepetitions = std::max(std::atoi(argv[++i]), 1);
+		}
+		else if (Argument == "--seed" && bHasValue)
+		{
+			Options.Seed = std::stoull(argv[++i], nullptr, 0);
+		}
+		else if (Argument == "--filter" && bHasValue)
+		{
+			Options.Filter = argv[++i];
+		}
+		else
+		{
+			std::cerr << "Usage: Dumper7MicroBench [-n <NumNames>] [-r <Repetitions>] [--seed <Seed>] [--filter <Substring>]\n";
+			return 1;
+		}
+	}
+
+	std::mt19937_64 Random(Options.Seed);
+
+	/* Sizes relative to the number of names, roughly the ratios of a large game */
+	const NameWorkload Names = GenerateNames(Options.NumNames, Random);
+	const HierarchyWorkload Hierarchies = GenerateHierarchies(Options.NumNames / 50, Options.NumNames, Random);
+	const PackageWorkload Packages = GeneratePackages(std::max(Options.NumNames / 125, 0x40), Random);
+
+	std::cerr << std::format("Names: {} ({} unique), Classes: {}, Packages: {}, Repetitions: {}\n", Names.Names.size(), Names.NumUniqueNames,
+		Hierarchies.Supers.size(), Packages.Includes.size(), Options.NumRepetitions);
+
+	PrintHeader();
+
+	RunNameBenchmarks(Options, Names, Random);
+	RunHierarchyBenchmarks(Options, Names, Hierarchies);
+	RunPackageBenchmarks(Options, Packages);
+
+	return 0;
+}
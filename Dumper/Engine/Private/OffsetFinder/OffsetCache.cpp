@@ -0,0 +1,377 @@
+
+#include <format>
+#include <vector>
+#include <cstdlib>
+#include <filesystem>
+
+#include "OffsetFinder/OffsetCache.h"
+#include "OffsetFinder/Offsets.h"
+
+#include "Unreal/ObjectArray.h"
+#include "Unreal/NameArray.h"
+
+#include "Platform.h"
+
+
+namespace OffsetCache
+{
+	enum class ECachedNameSource : int32
+	{
+		None,
+		AppendString,
+		ToString,
+		GNames
+	};
+
+	struct CachedOffsets
+	{
+		int32 GObjects = 0x0;
+		bool bIsChunked = false;
+		FFixedUObjectArrayLayout FixedLayout;
+		FChunkedFixedUObjectArrayLayout ChunkedLayout;
+
+		ECachedNameSource NameSource = ECachedNameSource::None;
+		int32 AppendNameToString = 0x0;
+		int32 GNames = 0x0;
+		bool bUseNamePool = false;
+
+		int32 PEIndex = -1;
+		int32 GWorld = 0x0;
+
+		/* Only stored in memory-snapshots, finding them requires calling ProcessEvent */
+		int32 TextDatOffset = 0x0;
+		int32 InTextDataStringOffset = 0x0;
+		int32 TextSize = 0x0;
+	};
+
+	static CachedOffsets Cached;
+	static bool bIsLoaded = false;
+
+	static std::string GetSectionName()
+	{
+		return std::format("{:016X}", Platform::GetModuleFingerprint());
+	}
+
+	static int32 ReadInt(const std::string& Section, const char* Key, int32 Default, const std::string& Path)
+	{
+		char Buffer[32] = {};
+		GetPrivateProfileStringA(Section.c_str(), Key, "", Buffer, sizeof(Buffer), Path.c_str());
+
+		if (Buffer[0] == '\0')
+			return Default;
+
+		return static_cast<int32>(std::strtoll(Buffer, nullptr, 0x10));
+	}
+
+	static void WriteInt(const std::string& Section, const char* Key, int32 Value, const std::string& Path)
+	{
+		WritePrivateProfileStringA(Section.c_str(), Key, std::format("{:X}", static_cast<uint32>(Value)).c_str(), Path.c_str());
+	}
+
+	/* Fills 'Cached' through GetValue(Key, Default), for entries of the ini-file as well as for the properties of a memory-snapshot */
+	template<typename GetterType>
+	static void ReadCachedOffsets(GetterType&& GetValue)
+	{
+		Cached.GObjects = GetValue("GObjects", 0x0);
+		Cached.bIsChunked = GetValue("bIsChunked", 0x0) != 0x0;
+
+		Cached.FixedLayout.ObjectsOffset = GetValue("FixedLayout.ObjectsOffset", -1);
+		Cached.FixedLayout.MaxObjectsOffset = GetValue("FixedLayout.MaxObjectsOffset", -1);
+		Cached.FixedLayout.NumObjectsOffset = GetValue("FixedLayout.NumObjectsOffset", -1);
+
+		Cached.ChunkedLayout.ObjectsOffset = GetValue("ChunkedLayout.ObjectsOffset", -1);
+		Cached.ChunkedLayout.MaxElementsOffset = GetValue("ChunkedLayout.MaxElementsOffset", -1);
+		Cached.ChunkedLayout.NumElementsOffset = GetValue("ChunkedLayout.NumElementsOffset", -1);
+		Cached.ChunkedLayout.MaxChunksOffset = GetValue("ChunkedLayout.MaxChunksOffset", -1);
+		Cached.ChunkedLayout.NumChunksOffset = GetValue("ChunkedLayout.NumChunksOffset", -1);
+
+		Cached.NameSource = static_cast<ECachedNameSource>(GetValue("NameSource", 0x0));
+		Cached.AppendNameToString = GetValue("AppendNameToString", 0x0);
+		Cached.GNames = GetValue("GNames", 0x0);
+		Cached.bUseNamePool = GetValue("bUseNamePool", 0x0) != 0x0;
+
+		Cached.PEIndex = GetValue("PEIndex", -1);
+		Cached.GWorld = GetValue("GWorld", 0x0);
+	}
+
+	/* All offsets found during this run that are written to the cache, keys match the ones read in ReadCachedOffsets */
+	static std::vector<std::pair<const char*, int32>> CollectOffsets()
+	{
+		/* An inlined AppendString can't be restored through FName::Init(), it's rediscovered every run */
+		ECachedNameSource NameSource = ECachedNameSource::None;
+
+		if (Off::InSDK::Name::AppendNameToString != 0x0 && !Off::InSDK::Name::bIsAppendStringInlinedAndUsed)
+		{
+			NameSource = Off::InSDK::Name::bIsUsingAppendStringOverToString ? ECachedNameSource::AppendString : ECachedNameSource::ToString;
+		}
+		else if (Off::InSDK::Name::AppendNameToString == 0x0 && NameArray::IsInitialized())
+		{
+			NameSource = ECachedNameSource::GNames;
+		}
+
+		return {
+			{ "GObjects", Off::InSDK::ObjArray::GObjects },
+			{ "bIsChunked", Off::FUObjectArray::bIsChunked },
+
+			{ "FixedLayout.ObjectsOffset", Off::FUObjectArray::FixedLayout.ObjectsOffset },
+			{ "FixedLayout.MaxObjectsOffset", Off::FUObjectArray::FixedLayout.MaxObjectsOffset },
+			{ "FixedLayout.NumObjectsOffset", Off::FUObjectArray::FixedLayout.NumObjectsOffset },
+
+			{ "ChunkedLayout.ObjectsOffset", Off::FUObjectArray::ChunkedFixedLayout.ObjectsOffset },
+			{ "ChunkedLayout.MaxElementsOffset", Off::FUObjectArray::ChunkedFixedLayout.MaxElementsOffset },
+			{ "ChunkedLayout.NumElementsOffset", Off::FUObjectArray::ChunkedFixedLayout.NumElementsOffset },
+			{ "ChunkedLayout.MaxChunksOffset", Off::FUObjectArray::ChunkedFixedLayout.MaxChunksOffset },
+			{ "ChunkedLayout.NumChunksOffset", Off::FUObjectArray::ChunkedFixedLayout.NumChunksOffset },
+
+			{ "NameSource", static_cast<int32>(NameSource) },
+			{ "AppendNameToString", Off::InSDK::Name::AppendNameToString },
+			{ "GNames", Off::InSDK::NameArray::GNames },
+			{ "bUseNamePool", Settings::Internal::bUseNamePool },
+
+			{ "PEIndex", Off::InSDK::ProcessEvent::PEOffset != 0x0 ? Off::InSDK::ProcessEvent::PEIndex : -1 },
+			{ "GWorld", Off::InSDK::World::GWorld },
+		};
+	}
+}
+
+std::string OffsetCache::GetCachePath()
+{
+	namespace fs = std::filesystem;
+
+	const fs::path LocalConfigPath = fs::current_path() / "Dumper-7.ini";
+
+	if (fs::exists(LocalConfigPath))
+		return (fs::current_path() / "Dumper-7-Offsets.ini").string();
+
+	return (fs::path(Settings::GlobalConfigPath).parent_path() / "Dumper-7-Offsets.ini").string();
+}
+
+bool OffsetCache::Load()
+{
+	if constexpr (!Settings::General::bUseOffsetCache)
+		return false;
+
+	const std::string Path = GetCachePath();
+	const std::string Section = GetSectionName();
+
+	if (!std::filesystem::exists(Path))
+		return false;
+
+	ReadCachedOffsets([&](const char* Key, int32 Default) -> int32 { return ReadInt(Section, Key, Default, Path); });
+
+	/* An entry always contains GObjects, anything else is optional */
+	if (Cached.GObjects == 0x0)
+		return false;
+
+	std::cerr << std::format("Found cached offsets for this build [{}] in '{}'\n\n", Section, Path);
+
+	bIsLoaded = true;
+
+	return true;
+}
+
+bool OffsetCache::LoadForExternalProcess()
+{
+	const std::string Path = GetCachePath();
+	const std::string Section = GetSectionName();
+
+	if (std::filesystem::exists(Path))
+		ReadCachedOffsets([&](const char* Key, int32 Default) -> int32 { return ReadInt(Section, Key, Default, Path); });
+
+	/* AppendString and ToString are game-code, an attached process can only read names from GNames */
+	if (Cached.GObjects == 0x0 || Cached.GNames == 0x0)
+	{
+		std::cerr << std::format("'{}' has no entry with GObjects and GNames for this build [{}] of the game. Run the dumper inside of the game once, or add the entry by hand.\n\n", Path, Section);
+		return false;
+	}
+
+	std::cerr << std::format("Found cached offsets for the attached game [{}] in '{}'\n\n", Section, Path);
+
+	Cached.NameSource = ECachedNameSource::GNames;
+
+	bIsLoaded = true;
+
+	return true;
+}
+
+bool OffsetCache::IsLoaded()
+{
+	return bIsLoaded;
+}
+
+bool OffsetCache::TryInitObjectArray()
+{
+	if (!bIsLoaded)
+		return false;
+
+	if (ObjectArray::TryInit(Cached.GObjects, Cached.bIsChunked, Cached.FixedLayout, Cached.ChunkedLayout))
+		return true;
+
+	std::cerr << "Cached GObjects offset is invalid, falling back to scanning.\n\n";
+
+	return false;
+}
+
+bool OffsetCache::TryInitFName()
+{
+	if (!bIsLoaded || Cached.NameSource == ECachedNameSource::None)
+		return false;
+
+	if (Cached.NameSource == ECachedNameSource::GNames)
+	{
+		if (Cached.GNames == 0x0)
+			return false;
+
+		FName::Init(Cached.GNames, FName::EOffsetOverrideType::GNames, Cached.bUseNamePool);
+
+		if (NameArray::IsInitialized())
+			return true;
+
+		/* Reset, so the regular discovery doesn't consider GNames as already found */
+		Off::InSDK::NameArray::GNames = 0x0;
+
+		std::cerr << "Cached GNames offset is invalid, falling back to scanning.\n\n";
+
+		return false;
+	}
+
+	if (Cached.AppendNameToString == 0x0 || !Platform::IsAddressInAnyModule(Platform::GetModuleBase() + Cached.AppendNameToString))
+		return false;
+
+	const FName::EOffsetOverrideType Type = Cached.NameSource == ECachedNameSource::AppendString ? FName::EOffsetOverrideType::AppendString : FName::EOffsetOverrideType::ToString;
+
+	FName::Init(Cached.AppendNameToString, Type);
+
+	/* Same as NameArray::SetGNamesWithoutCommiting(), the SDK can still use GNames */
+	Off::InSDK::NameArray::GNames = Cached.GNames;
+	Settings::Internal::bUseNamePool = Cached.bUseNamePool;
+
+	return true;
+}
+
+bool OffsetCache::TryInitProcessEvent()
+{
+	if (!bIsLoaded || Cached.PEIndex < 0)
+		return false;
+
+	void** Vft = ProcessMemory::Read<void**>(ObjectArray::GetByIndex(0).GetAddress());
+
+	if (Platform::IsBadReadPtr(&Vft[Cached.PEIndex]) || !Platform::IsAddressInAnyModule(ProcessMemory::Read<void*>(&Vft[Cached.PEIndex])))
+		return false;
+
+	Off::InSDK::ProcessEvent::InitPE(Cached.PEIndex);
+	std::cerr << std::format("PE-Index: 0x{:X}\n\n", Cached.PEIndex);
+
+	return true;
+}
+
+bool OffsetCache::TryInitGWorld()
+{
+	if (!bIsLoaded || Cached.GWorld == 0x0)
+		return false;
+
+	const uintptr_t GWorldAddress = Platform::GetModuleBase() + Cached.GWorld;
+
+	if (Platform::IsBadReadPtr(GWorldAddress))
+		return false;
+
+	const UEObject World = ProcessMemory::Read<void*>(reinterpret_cast<void*>(GWorldAddress));
+
+	/* GWorld may be nullptr while a level is loading, but must never point to anything else than a UWorld */
+	if (World && !World.IsA(ObjectArray::FindClassFast("World")))
+	{
+		std::cerr << "Cached GWorld offset is invalid, falling back to scanning.\n\n";
+		return false;
+	}
+
+	Off::InSDK::World::GWorld = Cached.GWorld;
+	std::cerr << std::format("GWorld-Offset: 0x{:X}\n\n", Off::InSDK::World::GWorld);
+
+	return true;
+}
+
+void OffsetCache::Save()
+{
+	if constexpr (!Settings::General::bUseOffsetCache)
+		return;
+
+	if (Off::InSDK::ObjArray::GObjects == 0x0)
+		return;
+
+	const std::string Path = GetCachePath();
+	const std::string Section = GetSectionName();
+
+	std::error_code IgnoredError;
+	std::filesystem::create_directories(std::filesystem::path(Path).parent_path(), IgnoredError);
+
+	for (const auto& [Key, Value] : CollectOffsets())
+		WriteInt(Section, Key, Value, Path);
+}
+
+MemorySnapshot::PropertyList OffsetCache::GetSnapshotProperties()
+{
+	MemorySnapshot::PropertyList Properties;
+
+	for (const auto& [Key, Value] : CollectOffsets())
+		Properties.emplace_back(Key, std::format("{:X}", static_cast<uint32>(Value)));
+
+	Properties.emplace_back("Text.TextDatOffset", std::format("{:X}", static_cast<uint32>(Off::InSDK::Text::TextDatOffset)));
+	Properties.emplace_back("Text.InTextDataStringOffset", std::format("{:X}", static_cast<uint32>(Off::InSDK::Text::InTextDataStringOffset)));
+	Properties.emplace_back("Text.TextSize", std::format("{:X}", static_cast<uint32>(Off::InSDK::Text::TextSize)));
+
+	return Properties;
+}
+
+bool OffsetCache::LoadFromSnapshot(const MemorySnapshot::PropertyList& Properties)
+{
+	auto GetValue = [&Properties](const char* Key, int32 Default) -> int32
+	{
+		const std::string Value = MemorySnapshot::FindProperty(Properties, Key);
+
+		return Value.empty() ? Default : static_cast<int32>(std::strtoll(Value.c_str(), nullptr, 0x10));
+	};
+
+	ReadCachedOffsets(GetValue);
+
+	Cached.TextDatOffset = GetValue("Text.TextDatOffset", 0x0);
+	Cached.InTextDataStringOffset = GetValue("Text.InTextDataStringOffset", 0x0);
+	Cached.TextSize = GetValue("Text.TextSize", 0x0);
+
+	if (Cached.GObjects == 0x0)
+		return false;
+
+	/* AppendString and ToString are game-code, a replayed snapshot can only read names from GNames */
+	if (Cached.GNames == 0x0)
+	{
+		std::cerr << "The memory-snapshot doesn't contain a GNames offset, its names can't be read without running game-code!\n\n";
+		return false;
+	}
+
+	Cached.NameSource = ECachedNameSource::GNames;
+
+	bIsLoaded = true;
+
+	return true;
+}
+
+bool OffsetCache::TryInitTextOffsets()
+{
+	if (!bIsLoaded || Cached.TextSize == 0x0)
+		return false;
+
+	Off::InSDK::Text::TextDatOffset = Cached.TextDatOffset;
+	Off::InSDK::Text::InTextDataStringOffset = Cached.InTextDataStringOffset;
+	Off::InSDK::Text::TextSize = Cached.TextSize;
+
+	return true;
+}
+
+void OffsetCache::Invalidate()
+{
+	if constexpr (!Settings::General::bUseOffsetCache)
+		return;
+
+	WritePrivateProfileStringA(GetSectionName().c_str(), nullptr, nullptr, GetCachePath().c_str());
+
+	bIsLoaded = false;
+}
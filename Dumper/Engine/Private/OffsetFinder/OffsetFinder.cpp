@@ -34,7 +34,7 @@ int32_t OffsetFinder::FindUObjectFlagsOffset()
 				if (Counter++ == 0x100)
 					break;
 
-				const int32 TypedValueAtOffset = *reinterpret_cast<int32*>(reinterpret_cast<uintptr_t>(Obj.GetAddress()) + Offset);
+				const int32 TypedValueAtOffset = ProcessMemory::Read<int32>(reinterpret_cast<const uint8*>(Obj.GetAddress()) + Offset);
 
 				if (TypedValueAtOffset == EnumFlagValueToSearch)
 					NumObjectsWithFlagAtOffset++;
@@ -72,8 +72,8 @@ int32_t OffsetFinder::FindUObjectClassOffset()
 			const uint8_t* CurrentClassA = NextClassA;
 			const uint8_t* CurrentClassB = NextClassB;
 
-			NextClassA = *reinterpret_cast<const uint8_t* const*>(NextClassA + ClassPtrOffset);
-			NextClassB = *reinterpret_cast<const uint8_t* const*>(NextClassB + ClassPtrOffset);
+			NextClassA = ProcessMemory::Read<const uint8_t*>(NextClassA + ClassPtrOffset);
+			NextClassB = ProcessMemory::Read<const uint8_t*>(NextClassB + ClassPtrOffset);
 
 			/* If this was UObject::Class it would never be invalid. The pointer would simply point to itself.*/
 			if (!NextClassA || !NextClassB || Platform::IsBadReadPtr(NextClassA) || Platform::IsBadReadPtr(NextClassB))
@@ -146,7 +146,7 @@ int32_t FindNameOffsetForSomeClass(std::function<bool(int32_t Value)> IsPotentia
 		PossibleOffsets.push_back(ValueInfo{ i });
 	}
 
-	auto GetDataAtOffsetAsInt = [](const void* Ptr, int32 Offset) -> uint32 { return *reinterpret_cast<const uint32*>(reinterpret_cast<const uintptr_t>(Ptr) + Offset); };
+	auto GetDataAtOffsetAsInt = [](const void* Ptr, int32 Offset) -> uint32 { return ProcessMemory::Read<uint32>(static_cast<const uint8*>(Ptr) + Offset); };
 
 	int NumObjectsConsidered = 0;
 
@@ -295,8 +295,8 @@ void OffsetFinder::InitFNameSettings()
 
 	const uint8* NameAddress = static_cast<const uint8*>(FirstObject.GetFName().GetAddress());
 
-	const int32 FNameFirstInt /* ComparisonIndex */ = *reinterpret_cast<const int32*>(NameAddress);
-	const int32 FNameSecondInt /* [Number/DisplayIndex] */ = *reinterpret_cast<const int32*>(NameAddress + 0x4);
+	const int32 FNameFirstInt /* ComparisonIndex */ = ProcessMemory::Read<int32>(NameAddress);
+	const int32 FNameSecondInt /* [Number/DisplayIndex] */ = ProcessMemory::Read<int32>(NameAddress + 0x4);
 
 	/* Some games move 'Name' before 'Class'. Just substract the offset of 'Name' with the offset of the member that follows right after it, to get an estimate of sizeof(FName). */
 	const int32 FNameSize = !Settings::Internal::bIsObjectNameBeforeClass ? (Off::UObject::Outer - Off::UObject::Name) : (Off::UObject::Class - Off::UObject::Name);
@@ -382,8 +382,8 @@ void OffsetFinder::PostInitFNameSettings()
 
 	const uint8* NameAddress = static_cast<const uint8*>(PlayerStart.GetFName().GetAddress());
 
-	const int32 FNameFirstInt /* ComparisonIndex */ = *reinterpret_cast<const int32*>(NameAddress);
-	const int32 FNameSecondInt /* [Number/DisplayIndex] */ = *reinterpret_cast<const int32*>(NameAddress + 0x4);
+	const int32 FNameFirstInt /* ComparisonIndex */ = ProcessMemory::Read<int32>(NameAddress);
+	const int32 FNameSecondInt /* [Number/DisplayIndex] */ = ProcessMemory::Read<int32>(NameAddress + 0x4);
 
 	if (FNameSize == 0x8 && FNameFirstInt == FNameSecondInt) /* WITH_CASE_PRESERVING_NAME + FNAME_OUTLINE_NUMBER */
 	{
@@ -513,16 +513,25 @@ int32_t OffsetFinder::FindEnumNamesOffset()
 
 	uint8* ArrayAddress = static_cast<uint8*>(Infos[0].first) + Ret;
 
+	/* Only the array-header is copied, the values are read one by one */
+	auto GetValue = [](const auto& Array, int32 Index) -> ValueType
+	{
+		if (!Array.IsValidIndex(Index))
+			throw std::out_of_range("Index was out of range!");
+
+		return ProcessMemory::Read<ValueType>(&Array.GetDataPtr()[Index].Second);
+	};
+
 	if (Settings::Internal::bUseCasePreservingName)
 	{
-		auto& ArrayOfNameValuePairs = *reinterpret_cast<TArray<TPair<Name16Byte, ValueType>>*>(ArrayAddress);
+		const auto ArrayOfNameValuePairs = ProcessMemory::Read<TArray<TPair<Name16Byte, ValueType>>>(ArrayAddress);
 
-		if (ArrayOfNameValuePairs[1].Second == 1)
+		if (GetValue(ArrayOfNameValuePairs, 1) == 1)
 			return Ret;
 
 		if constexpr (Settings::EngineCore::bCheckEnumNamesInUEnum)
 		{
-			if (static_cast<uint8_t>(ArrayOfNameValuePairs[1].Second) == 1 && static_cast<uint8_t>(ArrayOfNameValuePairs[2].Second) == 2)
+			if (static_cast<uint8_t>(GetValue(ArrayOfNameValuePairs, 1)) == 1 && static_cast<uint8_t>(GetValue(ArrayOfNameValuePairs, 2)) == 2)
 			{
 
 				Settings::Internal::bIsSmallEnumValue = true;
@@ -534,14 +543,14 @@ int32_t OffsetFinder::FindEnumNamesOffset()
 	}
 	else
 	{
-		const auto& Array = *reinterpret_cast<TArray<TPair<Name08Byte, ValueType>>*>(static_cast<uint8*>(Infos[0].first) + Ret);
+		const auto Array = ProcessMemory::Read<TArray<TPair<Name08Byte, ValueType>>>(ArrayAddress);
 
-		if (Array[1].Second == 1)
+		if (GetValue(Array, 1) == 1)
 			return Ret;
 
 		if constexpr (Settings::EngineCore::bCheckEnumNamesInUEnum)
 		{
-			if (static_cast<uint8_t>(Array[1].Second) == 1 && static_cast<uint8_t>(Array[2].Second) == 2)
+			if (static_cast<uint8_t>(GetValue(Array, 1)) == 1 && static_cast<uint8_t>(GetValue(Array, 2)) == 2)
 			{
 				Settings::Internal::bIsSmallEnumValue = true;
 				return Ret;
@@ -665,8 +674,8 @@ int32_t OffsetFinder::FindFunctionNativeFuncOffset()
 
 	for (int i = 0x30; i < 0x140; i += sizeof(void*))
 	{
-		if (Platform::IsAddressInProcessRange(*reinterpret_cast<uintptr_t*>(WasInputKeyJustPressed + i)) &&
-			Platform::IsAddressInProcessRange(*reinterpret_cast<uintptr_t*>(ToggleSpeaking + i)) && Platform::IsAddressInProcessRange(*reinterpret_cast<uintptr_t*>(SwitchLevel_Or_FOV + i)))
+		if (Platform::IsAddressInProcessRange(ProcessMemory::Read<uintptr_t>(reinterpret_cast<const void*>(WasInputKeyJustPressed + i))) &&
+			Platform::IsAddressInProcessRange(ProcessMemory::Read<uintptr_t>(reinterpret_cast<const void*>(ToggleSpeaking + i))) && Platform::IsAddressInProcessRange(ProcessMemory::Read<uintptr_t>(reinterpret_cast<const void*>(SwitchLevel_Or_FOV + i))))
 			return i;
 	}
 
@@ -702,11 +711,11 @@ int32_t OffsetFinder::FindImplementedInterfacesOffset()
 
 	for (int i = Off::UClass::ClassDefaultObject; i <= (0x350 - 0x10); i += sizeof(void*))
 	{
-		const auto& ActorArray = *reinterpret_cast<const TArray<FImplementedInterface>*>(ActorComponentClassPtr + i);
+		const auto ActorArray = ProcessMemory::Read<TArray<FImplementedInterface>>(ActorComponentClassPtr + i);
 
 		if (ActorArray.IsValid() && !Platform::IsBadReadPtr(ActorArray.GetDataPtr()))
 		{
-			if (ActorArray[0].InterfaceClass == Interface_AssetUserDataClass)
+			if (ProcessMemory::Read<FImplementedInterface>(ActorArray.GetDataPtr()).InterfaceClass == Interface_AssetUserDataClass)
 				return i;
 		}
 	}
@@ -927,7 +936,7 @@ int32_t OffsetFinder::FindInnerTypeOffset(const int32 PropertySize)
 
 	if (const UEProperty Property = ObjectArray::FindClassFast("GameViewportClient").FindMember("DebugProperties", EClassCastFlags::ArrayProperty))
 	{
-		void* AddressToCheck = *reinterpret_cast<void* const*>(reinterpret_cast<const uint8*>(Property.GetAddress()) + PropertySize);
+		void* AddressToCheck = ProcessMemory::Read<void*>(reinterpret_cast<const uint8*>(Property.GetAddress()) + PropertySize);
 
 		if (Platform::IsBadReadPtr(AddressToCheck))
 			return PropertySize + sizeof(void*);
@@ -944,7 +953,7 @@ int32_t OffsetFinder::FindSetPropertyBaseOffset(const int32 PropertySize)
 
 	if (const auto Object = ObjectArray::FindStructFast("LevelCollection").FindMember("Levels", EClassCastFlags::SetProperty))
 	{
-		const void* AddressToCheck = *reinterpret_cast<void* const*>(reinterpret_cast<const uint8*>(Object.GetAddress()) + PropertySize);
+		const void* AddressToCheck = ProcessMemory::Read<void*>(reinterpret_cast<const uint8*>(Object.GetAddress()) + PropertySize);
 
 		if (Platform::IsBadReadPtr(AddressToCheck))
 			return PropertySize + sizeof(void*);
@@ -962,7 +971,7 @@ int32_t OffsetFinder::FindMapPropertyBaseOffset(const int32 PropertySize)
 
 	if (const auto Object = ObjectArray::FindClassFast("UserDefinedEnum").FindMember("DisplayNameMap", EClassCastFlags::MapProperty))
 	{
-		const void* AddressToCheck = *reinterpret_cast<void* const*>(reinterpret_cast<const uint8*>(Object.GetAddress()) + PropertySize);
+		const void* AddressToCheck = ProcessMemory::Read<void*>(reinterpret_cast<const uint8*>(Object.GetAddress()) + PropertySize);
 
 		if (Platform::IsBadReadPtr(AddressToCheck))
 			return PropertySize + sizeof(void*);
@@ -1006,7 +1015,7 @@ int32_t OffsetFinder::FindLevelActorsOffset()
 
 	for (int i = SearchStart; i <= (SearchEnd - 0x10); i += sizeof(void*))
 	{
-		const TArray<void*>& ActorArray = *reinterpret_cast<TArray<void*>*>(Lvl + i);
+		const TArray<void*> ActorArray = ProcessMemory::Read<TArray<void*>>(Lvl + i);
 
 		if (ActorArray.IsValid() && !Platform::IsBadReadPtr(ActorArray.GetDataPtr()))
 		{
@@ -1,4 +1,8 @@
 #include <format>
+#include <future>
+#include <chrono>
+#include <functional>
+#include <vector>
 
 #include "Utils.h"
 
@@ -77,9 +81,9 @@ void Off::InSDK::ProcessEvent::InitPE(const int32 Index, const char* const Modul
 {
 	Off::InSDK::ProcessEvent::PEIndex = Index;
 
-	void** VFT = *reinterpret_cast<void***>(ObjectArray::GetByIndex(0).GetAddress());
+	void** VFT = ProcessMemory::Read<void**>(ObjectArray::GetByIndex(0).GetAddress());
 
-	Off::InSDK::ProcessEvent::PEOffset = Platform::GetOffset(VFT[Off::InSDK::ProcessEvent::PEIndex], ModuleName);
+	Off::InSDK::ProcessEvent::PEOffset = Platform::GetOffset(ProcessMemory::Read<void*>(&VFT[Off::InSDK::ProcessEvent::PEIndex]), ModuleName);
 
 	std::cerr << std::format("PE-Offset: 0x{:X}\n", Off::InSDK::ProcessEvent::PEOffset);
 }
@@ -250,6 +254,85 @@ void Off::InSDK::Text::InitTextOffsets()
 	std::cerr << std::format("Off::InSDK::Text::InTextDataStringOffset: 0x{:X}\n\n", Off::InSDK::Text::InTextDataStringOffset);
 }
 
+/* A single OffsetFinder heuristic and the offsets it reads, which must be produced by a task declared before this one */
+struct OffsetFinderTask
+{
+	const char* Name;
+	int32* Offset;
+	std::function<int32()> Find;
+	std::vector<const int32*> Dependencies = {};
+
+	double DurationMs = 0.0;
+};
+
+/*
+* Runs the tasks level by level, every task of a level only depends on tasks of previous levels.
+* Results and timings are printed in declaration-order afterwards, so the output doesn't depend on the scheduling.
+*/
+static void RunOffsetFinders(std::vector<OffsetFinderTask>& Tasks)
+{
+	std::vector<int32> Levels(Tasks.size(), 0);
+	int32 NumLevels = 0;
+
+	for (int i = 0; i < Tasks.size(); i++)
+	{
+		for (const int32* Dependency : Tasks[i].Dependencies)
+		{
+			for (int j = 0; j < i; j++)
+			{
+				if (Tasks[j].Offset == Dependency && Levels[j] >= Levels[i])
+					Levels[i] = Levels[j] + 1;
+			}
+		}
+
+		if (Levels[i] >= NumLevels)
+			NumLevels = Levels[i] + 1;
+	}
+
+	auto RunTask = [](OffsetFinderTask& Task) -> void
+	{
+		const auto StartTime = std::chrono::high_resolution_clock::now();
+
+		*Task.Offset = Task.Find();
+
+		Task.DurationMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - StartTime).count();
+	};
+
+	for (int Level = 0; Level < NumLevels; Level++)
+	{
+		std::vector<std::future<void>> Pending;
+
+		for (int i = 0; i < Tasks.size(); i++)
+		{
+			if (Levels[i] != Level)
+				continue;
+
+			if constexpr (Settings::EngineCore::bRunOffsetFindersInParallel)
+			{
+				Pending.push_back(std::async(std::launch::async, RunTask, std::ref(Tasks[i])));
+			}
+			else
+			{
+				RunTask(Tasks[i]);
+			}
+		}
+
+		/* get() rethrows exceptions from the finders */
+		for (std::future<void>& Task : Pending)
+			Task.get();
+	}
+
+	for (const OffsetFinderTask& Task : Tasks)
+		std::cerr << std::format("{}: 0x{:X}\n", Task.Name, *Task.Offset);
+
+	std::cerr << '\n';
+
+	for (const OffsetFinderTask& Task : Tasks)
+		std::cerr << std::format("[Level {}] {} took ({:.2f}ms)\n", Levels[&Task - Tasks.data()], Task.Name, Task.DurationMs);
+
+	std::cerr << '\n';
+}
+
 void Off::Init()
 {
 	auto OverwriteIfInvalidOffset = [](int32& Offset, int32 DefaultValue)
@@ -342,39 +425,28 @@ void Off::Init()
 		std::cerr << std::format("Off::FField::Flags: 0x{:X}\n", Off::FField::Flags);
 	}
 
-	Off::UClass::ClassDefaultObject = OffsetFinder::FindDefaultObjectOffset();
-	std::cerr << std::format("Off::UClass::ClassDefaultObject: 0x{:X}\n", Off::UClass::ClassDefaultObject);
-
-	Off::UClass::ImplementedInterfaces = OffsetFinder::FindImplementedInterfacesOffset();
-	std::cerr << std::format("Off::UClass::ImplementedInterfaces: 0x{:X}\n", Off::UClass::ImplementedInterfaces);
-
-	Off::UEnum::Names = OffsetFinder::FindEnumNamesOffset();
-	std::cerr << std::format("Off::UEnum::Names: 0x{:X}\n", Off::UEnum::Names);
-
-	Off::UFunction::FunctionFlags = OffsetFinder::FindFunctionFlagsOffset();
-	std::cerr << std::format("Off::UFunction::FunctionFlags: 0x{:X}\n", Off::UFunction::FunctionFlags);
-
-	Off::UFunction::ExecFunction = OffsetFinder::FindFunctionNativeFuncOffset();
-	std::cerr << std::format("Off::UFunction::ExecFunction: 0x{:X}\n", Off::UFunction::ExecFunction);
-
-	Off::Property::ElementSize = OffsetFinder::FindElementSizeOffset();
-	std::cerr << std::format("Off::Property::ElementSize: 0x{:X}\n", Off::Property::ElementSize);
-
-	Off::Property::ArrayDim = OffsetFinder::FindArrayDimOffset();
-	std::cerr << std::format("Off::Property::ArrayDim: 0x{:X}\n", Off::Property::ArrayDim);
-
-	Off::Property::Offset_Internal = OffsetFinder::FindOffsetInternalOffset();
-	std::cerr << std::format("Off::Property::Offset_Internal: 0x{:X}\n", Off::Property::Offset_Internal);
-
-	Off::Property::PropertyFlags = OffsetFinder::FindPropertyFlagsOffset();
-	std::cerr << std::format("Off::Property::PropertyFlags: 0x{:X}\n", Off::Property::PropertyFlags);
-
-	Off::BoolProperty::Base = OffsetFinder::FindBoolPropertyBaseOffset();
-	std::cerr << std::format("UBoolProperty::Base: 0x{:X}\n", Off::BoolProperty::Base);
-
-	Off::EnumProperty::Base = OffsetFinder::FindEnumPropertyBaseOffset();
-	std::cerr << std::format("Off::EnumProperty::Base: 0x{:X}\n", Off::EnumProperty::Base);
+	/* Everything below only depends on the offsets found above, and on the offsets listed in the tasks dependencies */
+	std::vector<OffsetFinderTask> PropertyOffsetTasks = {
+		{ "Off::UClass::ClassDefaultObject", &Off::UClass::ClassDefaultObject, OffsetFinder::FindDefaultObjectOffset },
+		{ "Off::UClass::ImplementedInterfaces", &Off::UClass::ImplementedInterfaces, OffsetFinder::FindImplementedInterfacesOffset, { &Off::UClass::ClassDefaultObject } },
+		{ "Off::UEnum::Names", &Off::UEnum::Names, OffsetFinder::FindEnumNamesOffset },
+		{ "Off::UFunction::FunctionFlags", &Off::UFunction::FunctionFlags, OffsetFinder::FindFunctionFlagsOffset },
+		{ "Off::UFunction::ExecFunction", &Off::UFunction::ExecFunction, OffsetFinder::FindFunctionNativeFuncOffset },
+		{ "Off::Property::ElementSize", &Off::Property::ElementSize, OffsetFinder::FindElementSizeOffset },
+		{ "Off::Property::ArrayDim", &Off::Property::ArrayDim, OffsetFinder::FindArrayDimOffset, { &Off::Property::ElementSize } },
+		{ "Off::Property::Offset_Internal", &Off::Property::Offset_Internal, OffsetFinder::FindOffsetInternalOffset },
+		{ "Off::Property::PropertyFlags", &Off::Property::PropertyFlags, OffsetFinder::FindPropertyFlagsOffset },
+		{ "UBoolProperty::Base", &Off::BoolProperty::Base, OffsetFinder::FindBoolPropertyBaseOffset, { &Off::Property::Offset_Internal } },
+		{ "Off::EnumProperty::Base", &Off::EnumProperty::Base, OffsetFinder::FindEnumPropertyBaseOffset, { &Off::Property::Offset_Internal } },
+		{ "Off::ObjectProperty::PropertyClass", &Off::ObjectProperty::PropertyClass, OffsetFinder::FindObjectPropertyClassOffset, { &Off::Property::Offset_Internal } },
+		{ "Off::ByteProperty::Enum", &Off::ByteProperty::Enum, OffsetFinder::FindBytePropertyEnumOffset, { &Off::Property::Offset_Internal } },
+		{ "Off::StructProperty::Struct", &Off::StructProperty::Struct, OffsetFinder::FindStructPropertyStructOffset, { &Off::Property::Offset_Internal } },
+		{ "Off::DelegateProperty::SignatureFunction", &Off::DelegateProperty::SignatureFunction, OffsetFinder::FindDelegatePropertySignatureFunctionOffset, { &Off::Property::Offset_Internal } },
+		{ "Off::InSDK::ULevel::Actors", &Off::InSDK::ULevel::Actors, OffsetFinder::FindLevelActorsOffset, { &Off::Property::Offset_Internal } },
+		{ "Off::InSDK::UDataTable::RowMap", &Off::InSDK::UDataTable::RowMap, OffsetFinder::FindDatatableRowMapOffset, { &Off::Property::Offset_Internal, &Off::Property::ElementSize } },
+	};
 
+	RunOffsetFinders(PropertyOffsetTasks);
 
 	if (Off::EnumProperty::Base == OffsetFinder::OffsetNotFound)
 	{
@@ -388,36 +460,20 @@ void Off::Init()
 
 	std::cerr << std::format("UPropertySize: 0x{:X}\n", Off::InSDK::Properties::PropertySize);
 
-	Off::ObjectProperty::PropertyClass = OffsetFinder::FindObjectPropertyClassOffset();
-	std::cerr << std::format("Off::ObjectProperty::PropertyClass: 0x{:X}", Off::ObjectProperty::PropertyClass);
 	OverwriteIfInvalidOffset(Off::ObjectProperty::PropertyClass, Off::InSDK::Properties::PropertySize);
-
-	Off::ByteProperty::Enum = OffsetFinder::FindBytePropertyEnumOffset();
 	OverwriteIfInvalidOffset(Off::ByteProperty::Enum, Off::InSDK::Properties::PropertySize);
-	std::cerr << std::format("Off::ByteProperty::Enum: 0x{:X}", Off::ByteProperty::Enum);
-
-	Off::StructProperty::Struct = OffsetFinder::FindStructPropertyStructOffset();
 	OverwriteIfInvalidOffset(Off::StructProperty::Struct, Off::InSDK::Properties::PropertySize);
-	std::cerr << std::format("Off::StructProperty::Struct: 0x{:X}\n", Off::StructProperty::Struct);
-
-	Off::DelegateProperty::SignatureFunction = OffsetFinder::FindDelegatePropertySignatureFunctionOffset();
 	OverwriteIfInvalidOffset(Off::DelegateProperty::SignatureFunction, Off::InSDK::Properties::PropertySize);
-	std::cerr << std::format("Off::DelegateProperty::SignatureFunction: 0x{:X}\n", Off::DelegateProperty::SignatureFunction);
 
-	Off::ArrayProperty::Inner = OffsetFinder::FindInnerTypeOffset(Off::InSDK::Properties::PropertySize);
-	std::cerr << std::format("Off::ArrayProperty::Inner: 0x{:X}\n", Off::ArrayProperty::Inner);
+	const int32 PropertySize = Off::InSDK::Properties::PropertySize;
 
-	Off::SetProperty::ElementProp = OffsetFinder::FindSetPropertyBaseOffset(Off::InSDK::Properties::PropertySize);
-	std::cerr << std::format("Off::SetProperty::ElementProp: 0x{:X}\n", Off::SetProperty::ElementProp);
-
-	Off::MapProperty::Base = OffsetFinder::FindMapPropertyBaseOffset(Off::InSDK::Properties::PropertySize);
-	std::cerr << std::format("Off::MapProperty::Base: 0x{:X}\n", Off::MapProperty::Base);
-
-	Off::InSDK::ULevel::Actors = OffsetFinder::FindLevelActorsOffset();
-	std::cerr << std::format("Off::InSDK::ULevel::Actors: 0x{:X}\n", Off::InSDK::ULevel::Actors);
+	std::vector<OffsetFinderTask> ContainerOffsetTasks = {
+		{ "Off::ArrayProperty::Inner", &Off::ArrayProperty::Inner, [=]() { return OffsetFinder::FindInnerTypeOffset(PropertySize); } },
+		{ "Off::SetProperty::ElementProp", &Off::SetProperty::ElementProp, [=]() { return OffsetFinder::FindSetPropertyBaseOffset(PropertySize); } },
+		{ "Off::MapProperty::Base", &Off::MapProperty::Base, [=]() { return OffsetFinder::FindMapPropertyBaseOffset(PropertySize); } },
+	};
 
-	Off::InSDK::UDataTable::RowMap = OffsetFinder::FindDatatableRowMapOffset();
-	std::cerr << std::format("Off::InSDK::UDataTable::RowMap: 0x{:X}\n", Off::InSDK::UDataTable::RowMap);
+	RunOffsetFinders(ContainerOffsetTasks);
 
 	OffsetFinder::PostInitFNameSettings();
 
@@ -1,5 +1,6 @@
 
 #include <format>
+#include <vector>
 
 #include "Unreal/ObjectArray.h"
 #include "Unreal/NameArray.h"
@@ -9,6 +10,19 @@
 
 uint8* NameArray::GNames = nullptr;
 
+namespace
+{
+	/* Copies 'Length' characters of a name, the entries might be in the memory of an external process */
+	template<typename CharType>
+	inline std::basic_string<CharType> ReadNameString(const uint8* Address, int32 Length)
+	{
+		std::basic_string<CharType> Str(Length, CharType(0));
+		ProcessMemory::ReadRaw(reinterpret_cast<uintptr_t>(Address), Str.data(), Length * sizeof(CharType));
+
+		return Str;
+	}
+}
+
 FNameEntry::FNameEntry(void* Ptr)
 	: Address((uint8*)Ptr)
 {
@@ -27,9 +41,30 @@ std::string FNameEntry::GetString()
 	if (!Address)
 		return "";
 
+	if (GetUtf8Str)
+		return GetUtf8Str(Address);
+
 	return UtfN::WStringToString(GetWString());
 }
 
+std::string FNameEntry::WideToUtf8(const wchar_t* Str, int32 Length)
+{
+	bool bIsAscii = true;
+
+	for (int i = 0; i < Length; i++)
+		bIsAscii &= Str[i] < 0x80;
+
+	if (!bIsAscii)
+		return UtfN::Utf16StringToUtf8String<std::string>(Str, Length);
+
+	std::string Ret(Length, '\0');
+
+	for (int i = 0; i < Length; i++)
+		Ret[i] = static_cast<char>(Str[i]);
+
+	return Ret;
+}
+
 void* FNameEntry::GetAddress()
 {
 	return Address;
@@ -47,12 +82,12 @@ void FNameEntry::Init(const uint8_t* FirstChunkPtr, int64 NameEntryStringOffset)
 		Off::FNameEntry::NamePool::StringOffset = NameEntryStringOffset;
 		Off::FNameEntry::NamePool::HeaderOffset = NameEntryStringOffset == 6 ? 4 : 0;
 
-		const uint8* AssumedBytePropertyEntry = *reinterpret_cast<uint8* const*>(FirstChunkPtr) + NameEntryStringOffset + NoneStrLen;
+		const uint8* AssumedBytePropertyEntry = ProcessMemory::Read<uint8*>(FirstChunkPtr) + NameEntryStringOffset + NoneStrLen;
 
 		/* Check if there's pading after an FNameEntry. Check if there's up to 0x4 bytes padding. */
 		for (int i = 0; i < 0x4; i++)
 		{
-			const uint32 FirstPartOfByteProperty = *reinterpret_cast<const uint32*>(AssumedBytePropertyEntry + NameEntryStringOffset);
+			const uint32 FirstPartOfByteProperty = ProcessMemory::Read<uint32>(AssumedBytePropertyEntry + NameEntryStringOffset);
 
 			if (FirstPartOfByteProperty == BytePropertyStartAsUint32)
 				break;
@@ -60,7 +95,7 @@ void FNameEntry::Init(const uint8_t* FirstChunkPtr, int64 NameEntryStringOffset)
 			AssumedBytePropertyEntry += 0x1;
 		}
 
-		uint16 BytePropertyHeader = *reinterpret_cast<const uint16*>(AssumedBytePropertyEntry + Off::FNameEntry::NamePool::HeaderOffset);
+		uint16 BytePropertyHeader = ProcessMemory::Read<uint16>(AssumedBytePropertyEntry + Off::FNameEntry::NamePool::HeaderOffset);
 
 		/* Shifiting past the size of the header is not allowed, so limmit the shiftcount here */
 		constexpr int32 MaxAllowedShiftCount = sizeof(BytePropertyHeader) * 0x8;
@@ -80,15 +115,15 @@ void FNameEntry::Init(const uint8_t* FirstChunkPtr, int64 NameEntryStringOffset)
 
 		GetStr = [](uint8* NameEntry) -> std::wstring
 		{
-			const uint16 HeaderWithoutNumber = *reinterpret_cast<uint16*>(NameEntry + Off::FNameEntry::NamePool::HeaderOffset);
+			const uint16 HeaderWithoutNumber = ProcessMemory::Read<uint16>(NameEntry + Off::FNameEntry::NamePool::HeaderOffset);
 			const int32 NameLen = HeaderWithoutNumber >> FNameEntry::FNameEntryLengthShiftCount;
 
 			if (NameLen == 0)
 			{
 				const int32 EntryIdOffset = Off::FNameEntry::NamePool::StringOffset + ((Off::FNameEntry::NamePool::StringOffset == 6) * 2);
 
-				const int32 NextEntryIndex = *reinterpret_cast<int32*>(NameEntry + EntryIdOffset);
-				const int32 Number = *reinterpret_cast<int32*>(NameEntry + EntryIdOffset + sizeof(int32));
+				const int32 NextEntryIndex = ProcessMemory::Read<int32>(NameEntry + EntryIdOffset);
+				const int32 Number = ProcessMemory::Read<int32>(NameEntry + EntryIdOffset + sizeof(int32));
 
 				if (Number > 0)
 					return NameArray::GetNameEntry(NextEntryIndex).GetWString() + L'_' + std::to_wstring(Number - 1);
@@ -97,9 +132,34 @@ void FNameEntry::Init(const uint8_t* FirstChunkPtr, int64 NameEntryStringOffset)
 			}
 
 			if (HeaderWithoutNumber & NameWideMask)
-				return std::wstring(reinterpret_cast<const wchar_t*>(NameEntry + Off::FNameEntry::NamePool::StringOffset), NameLen);
+				return ReadNameString<wchar_t>(NameEntry + Off::FNameEntry::NamePool::StringOffset, NameLen);
+
+			return UtfN::StringToWString(ReadNameString<char>(NameEntry + Off::FNameEntry::NamePool::StringOffset, NameLen));
+		};
+
+		/* Ansi FNameEntries only contain pure-ASCII strings, so they are valid UTF-8 already */
+		GetUtf8Str = [](uint8* NameEntry) -> std::string
+		{
+			const uint16 HeaderWithoutNumber = ProcessMemory::Read<uint16>(NameEntry + Off::FNameEntry::NamePool::HeaderOffset);
+			const int32 NameLen = HeaderWithoutNumber >> FNameEntry::FNameEntryLengthShiftCount;
+
+			if (NameLen == 0)
+			{
+				const int32 EntryIdOffset = Off::FNameEntry::NamePool::StringOffset + ((Off::FNameEntry::NamePool::StringOffset == 6) * 2);
+
+				const int32 NextEntryIndex = ProcessMemory::Read<int32>(NameEntry + EntryIdOffset);
+				const int32 Number = ProcessMemory::Read<int32>(NameEntry + EntryIdOffset + sizeof(int32));
+
+				if (Number > 0)
+					return NameArray::GetNameEntry(NextEntryIndex).GetString() + '_' + std::to_string(Number - 1);
+
+				return NameArray::GetNameEntry(NextEntryIndex).GetString();
+			}
+
+			if (HeaderWithoutNumber & NameWideMask)
+				return WideToUtf8(ReadNameString<wchar_t>(NameEntry + Off::FNameEntry::NamePool::StringOffset, NameLen).c_str(), NameLen);
 
-			return UtfN::StringToWString(std::string(reinterpret_cast<const char*>(NameEntry + Off::FNameEntry::NamePool::StringOffset), NameLen));
+			return ReadNameString<char>(NameEntry + Off::FNameEntry::NamePool::StringOffset, NameLen);
 		};
 	}
 	else
@@ -110,7 +170,7 @@ void FNameEntry::Init(const uint8_t* FirstChunkPtr, int64 NameEntryStringOffset)
 
 		for (int i = 0; i < 0x20; i++)
 		{
-			if (*reinterpret_cast<const uint32*>(FNameEntryNone + i) == 'enoN') // None
+			if (ProcessMemory::Read<uint32>(FNameEntryNone + i) == 'enoN') // None
 			{
 				Off::FNameEntry::NameArray::StringOffset = i;
 				break;
@@ -120,8 +180,8 @@ void FNameEntry::Init(const uint8_t* FirstChunkPtr, int64 NameEntryStringOffset)
 		for (int i = 0; i < 0x20; i++)
 		{
 			// lowest bit is bIsWide mask, shift right by 1 to get the index
-			if ((*reinterpret_cast<const uint32*>(FNameEntryIdxThree + i) >> 1) == 0x3 &&
-				(*reinterpret_cast<const uint32*>(FNameEntryIdxEight + i) >> 1) == 0x8)
+			if ((ProcessMemory::Read<uint32>(FNameEntryIdxThree + i) >> 1) == 0x3 &&
+				(ProcessMemory::Read<uint32>(FNameEntryIdxEight + i) >> 1) == 0x8)
 			{
 				Off::FNameEntry::NameArray::IndexOffset = i;
 				break;
@@ -130,13 +190,27 @@ void FNameEntry::Init(const uint8_t* FirstChunkPtr, int64 NameEntryStringOffset)
 
 		GetStr = [](uint8* NameEntry) -> std::wstring
 		{
-			const int32 NameIdx = *reinterpret_cast<int32*>(NameEntry + Off::FNameEntry::NameArray::IndexOffset);
+			const int32 NameIdx = ProcessMemory::Read<int32>(NameEntry + Off::FNameEntry::NameArray::IndexOffset);
 			const void* NameString = reinterpret_cast<void*>(NameEntry + Off::FNameEntry::NameArray::StringOffset);
 
 			if (NameIdx & NameWideMask)
-				return std::wstring(reinterpret_cast<const wchar_t*>(NameString));
+				return ProcessMemory::ReadCString<wchar_t>(NameString);
 
-			return UtfN::StringToWString<std::string>(reinterpret_cast<const char*>(NameString));
+			return UtfN::StringToWString<std::string>(ProcessMemory::ReadCString<char>(NameString));
+		};
+
+		GetUtf8Str = [](uint8* NameEntry) -> std::string
+		{
+			const int32 NameIdx = ProcessMemory::Read<int32>(NameEntry + Off::FNameEntry::NameArray::IndexOffset);
+			const void* NameString = reinterpret_cast<void*>(NameEntry + Off::FNameEntry::NameArray::StringOffset);
+
+			if (NameIdx & NameWideMask)
+			{
+				const std::wstring WideString = ProcessMemory::ReadCString<wchar_t>(NameString);
+				return WideToUtf8(WideString.c_str(), static_cast<int32>(WideString.size()));
+			}
+
+			return ProcessMemory::ReadCString<char>(NameString);
 		};
 	}
 }
@@ -153,7 +227,7 @@ bool NameArray::InitializeNameArray(uint8_t* NameArray)
 
 	for (int i = 0; i < 0x800; i += sizeof(void*))
 	{
-		uint8_t* SomePtr = *reinterpret_cast<uint8_t**>(NameArray + i);
+		uint8_t* SomePtr = ProcessMemory::Read<uint8_t*>(NameArray + i);
 
 		if (SomePtr == 0)
 		{
@@ -165,8 +239,8 @@ bool NameArray::InitializeNameArray(uint8_t* NameArray)
 		}
 		else if (ZeroQWordCount > 0 && SomePtr != 0)
 		{
-			int32 NumElements = *reinterpret_cast<int32_t*>(NameArray + i);
-			int32 NumChunks = *reinterpret_cast<int32_t*>(NameArray + i + 4);
+			int32 NumElements = ProcessMemory::Read<int32_t>(NameArray + i);
+			int32 NumChunks = ProcessMemory::Read<int32_t>(NameArray + i + 4);
 
 			if (NumChunks == ValidPtrCount)
 			{
@@ -181,7 +255,9 @@ bool NameArray::InitializeNameArray(uint8_t* NameArray)
 					if (ComparisonIndex > NameArray::GetNumElements())
 						return nullptr;
 
-					return reinterpret_cast<void***>(NamesArray)[ChunkIdx][InChunk];
+					void** Chunk = ProcessMemory::Read<void**>(static_cast<void**>(NamesArray) + ChunkIdx);
+
+					return ProcessMemory::Read<void*>(Chunk + InChunk);
 				};
 
 				return true;
@@ -203,7 +279,7 @@ bool NameArray::InitializeNamePool(uint8_t* NamePool)
 
 	for (int i = 0x0; i < 0x20; i += 4)
 	{
-		const int32 PossibleMaxChunkIdx = *reinterpret_cast<int32*>(NamePool + i);
+		const int32 PossibleMaxChunkIdx = ProcessMemory::Read<int32>(NamePool + i);
 
 		if (PossibleMaxChunkIdx <= 0 || PossibleMaxChunkIdx > 0x10000)
 			continue;
@@ -219,7 +295,7 @@ bool NameArray::InitializeNamePool(uint8_t* NamePool)
 		{
 			const int32 ChunkOffset = i + 8 + j + (i % 8);
 
-			if ((*reinterpret_cast<uint8_t**>(NamePool + ChunkOffset)) != nullptr)
+			if (ProcessMemory::Read<uint8_t*>(NamePool + ChunkOffset) != nullptr)
 			{
 				NotNullptrCount++;
 				NumPtrsSinceLastValid = 0;
@@ -256,6 +332,7 @@ bool NameArray::InitializeNamePool(uint8_t* NamePool)
 	constexpr uint32 NoneAsUint32 = 0x656E6F4E; // little endian "None"
 
 	uint8_t** ChunkPtr = reinterpret_cast<uint8_t**>(NamePool + Off::NameArray::ChunksStart);
+	const uint8_t* FirstChunk = ProcessMemory::Read<uint8_t*>(ChunkPtr);
 
 	// "/Script/CoreUObject"
 	bool bFoundCoreUObjectString = false;
@@ -265,11 +342,11 @@ bool NameArray::InitializeNamePool(uint8_t* NamePool)
 
 	for (int i = 0; i < LoopLimit; i++)
 	{
-		if (*reinterpret_cast<uint32*>(*ChunkPtr + i) == NoneAsUint32 && FNameEntryHeaderSize == 0)
+		if (ProcessMemory::Read<uint32>(FirstChunk + i) == NoneAsUint32 && FNameEntryHeaderSize == 0)
 		{
 			FNameEntryHeaderSize = i;
 		}
-		else if (*reinterpret_cast<uint64*>(*ChunkPtr + i) == CoreUObjAsUint64)
+		else if (ProcessMemory::Read<uint64>(FirstChunk + i) == CoreUObjAsUint64)
 		{
 			bFoundCoreUObjectString = true;
 			break;
@@ -294,7 +371,7 @@ bool NameArray::InitializeNamePool(uint8_t* NamePool)
 
 		uint8_t* ChunkPtr = reinterpret_cast<uint8_t*>(NamesArray) + 0x10;
 
-		return reinterpret_cast<uint8_t**>(ChunkPtr)[ChunkIdx] + InChunkOffset;
+		return ProcessMemory::Read<uint8_t*>(reinterpret_cast<uint8_t**>(ChunkPtr) + ChunkIdx) + InChunkOffset;
 	};
 
 	Settings::Internal::bUseNamePool = true;
@@ -392,13 +469,21 @@ bool NameArray::TryFindNameArray_Windows()
 	/* Call GetNames to retreive the pointer to the allocation of the name-table, used for later comparison */
 	void* Names = reinterpret_cast<GetNameType>(Address)();
 
-	for (int i = 0; i < GetNamesCallSearchRange; i++)
+	Architecture_x86_64::InstructionInfo Info;
+
+	for (uintptr_t Current = Address; Current < (Address + GetNamesCallSearchRange); Current += Info.Length)
 	{
-		/* Check upwards (yes negative indexing) for a relative call opcode */
-		if (*reinterpret_cast<const uint16*>(Address + i) != 0x8B48)
+		if (!Architecture_x86_64::DecodeInstruction(Current, Info))
+		{
+			Info.Length = 0x1;
 			continue;
+		}
 
-		const uintptr_t MoveTarget = Architecture_x86_64::Resolve32BitRelativeMove(Address + i);
+		/* Check for a 'mov register, [rip + offset]' */
+		if (Info.OpcodeMap != 0x0 || Info.Opcode != 0x8B || !Info.bIsRipRelative)
+			continue;
+
+		const uintptr_t MoveTarget = Architecture_x86_64::GetRipRelativeTarget(Current, Info);
 
 		if (!Platform::IsAddressInProcessRange(MoveTarget))
 			continue;
@@ -459,30 +544,35 @@ bool NameArray::TryFindNamePool_Windows()
 		if (!Platform::IsAddressInProcessRange(PossibleConstructorAddress))
 			continue;
 
-		for (int i = 0; i < InitSRWLockSearchRange; i++)
+		Architecture_x86_64::InstructionInfo Info;
+
+		for (uintptr_t Current = PossibleConstructorAddress; Current < (PossibleConstructorAddress + InitSRWLockSearchRange); Current += Info.Length)
 		{
-			/* Check for a relative call with the opcodes FF 15 00 00 00 00 */
-			if (*reinterpret_cast<uint16*>(PossibleConstructorAddress + i) != 0x15FF)
+			if (!Architecture_x86_64::DecodeInstruction(Current, Info))
+			{
+				Info.Length = 0x1;
 				continue;
+			}
 
-			const uintptr_t RelativeCallTarget = Architecture_x86_64::Resolve32BitSectionRelativeCall(PossibleConstructorAddress + i);
-
-			if (!Platform::IsAddressInProcessRange(RelativeCallTarget))
+			/* Check for an indirect call through the import table, FF 15 00 00 00 00 */
+			if (Info.OpcodeMap != 0x0 || Info.Opcode != 0xFF || ((Info.ModRM >> 3) & 0x7) != 0x2)
 				continue;
 
-			const uintptr_t ValueOfCallTarget = *reinterpret_cast<uintptr_t*>(RelativeCallTarget);
+			const uintptr_t ValueOfCallTarget = Architecture_x86_64::ResolveBranchTarget(Current);
 
 			if (ValueOfCallTarget != InitSRWLockAddress && ValueOfCallTarget != RtlInitSRWLockAddress)
 				continue;
 
 			/* Try to find the "ByteProperty" string, as it's always referenced in FNamePool::FNamePool, so we use it to verify that we got the right function */
-			const void* StringRef = Platform::FindByStringInAllSections(L"ByteProperty", PossibleConstructorAddress, BytePropertySearchRange, Settings::General::bSearchOnlyExecutableSectionsForStrings);
+			Platform::ScanBatch StringRefScan(/* bStopOnFirstComplete */ true);
+
+			/* Search for the wchar_t string L"ByteProperty" and the char string "ByteProperty" in the same pass, either one is enough */
+			const int32 WideStringRefId = StringRefScan.AddStringRef(L"ByteProperty", false, Settings::General::bSearchOnlyExecutableSectionsForStrings);
+			const int32 StringRefId = StringRefScan.AddStringRef("ByteProperty", false, Settings::General::bSearchOnlyExecutableSectionsForStrings);
 
-			/* We couldn't find a wchar_t string L"ByteProperty", now see if we can find a char string "ByteProperty" */
-			if (StringRef == nullptr)
-				StringRef = Platform::FindByStringInAllSections("ByteProperty", PossibleConstructorAddress, BytePropertySearchRange, Settings::General::bSearchOnlyExecutableSectionsForStrings);
+			StringRefScan.ScanAllSections(PossibleConstructorAddress, BytePropertySearchRange);
 
-			if (StringRef)
+			if (StringRefScan.GetMatch(WideStringRefId) || StringRefScan.GetMatch(StringRefId))
 			{
 				NamePoolIntance = reinterpret_cast<void*>(Architecture_x86_64::Resolve32BitRelativeMove(SigOccurrence));
 				break;
@@ -513,7 +603,7 @@ bool NameArray::TryInit(bool bIsTestOnly)
 	if (CALL_PLATFORM_SPECIFIC_FUNCTION(NameArray::TryFindNameArray))
 	{
 		std::cerr << std::format("Found 'TNameEntryArray GNames' at offset 0x{:X}\n", Off::InSDK::NameArray::GNames) ;
-		GNamesAddress = *reinterpret_cast<uint8**>(ImageBase + Off::InSDK::NameArray::GNames);// Derefernce
+		GNamesAddress = ProcessMemory::Read<uint8*>(reinterpret_cast<void*>(ImageBase + Off::InSDK::NameArray::GNames));// Derefernce
 		Settings::Internal::bUseNamePool = false;
 		bFoundNameArray = true;
 	}
@@ -572,7 +662,7 @@ bool NameArray::TryInit(int32 OffsetOverride, bool bIsNamePool, const char* cons
 	if (bIsNameArrayOverride)
 	{
 		std::cerr << std::format("Overwrote offset: 'TNameEntryArray GNames' set as offset 0x{:X}\n", Off::InSDK::NameArray::GNames) ;
-		GNamesAddress = *reinterpret_cast<uint8**>(ImageBase + Off::InSDK::NameArray::GNames);// Derefernce
+		GNamesAddress = ProcessMemory::Read<uint8*>(reinterpret_cast<void*>(ImageBase + Off::InSDK::NameArray::GNames));// Derefernce
 		Settings::Internal::bUseNamePool = false;
 		bFoundNameArray = true;
 	}
@@ -673,19 +763,137 @@ void NameArray::PostInit()
 	}
 }
 
+bool NameArray::TryCommitGNames()
+{
+	if (GNames)
+		return true;
+
+	if (Off::InSDK::NameArray::GNames == 0x0)
+		return false;
+
+	const uintptr_t ImageBase = Platform::GetModuleBase();
+
+	if (!Settings::Internal::bUseNamePool)
+	{
+		uint8* GNamesAddress = ProcessMemory::Read<uint8*>(reinterpret_cast<void*>(ImageBase + Off::InSDK::NameArray::GNames)); // Derefernce
+
+		if (!NameArray::InitializeNameArray(GNamesAddress))
+			return false;
+
+		GNames = GNamesAddress;
+		FNameEntry::Init();
+	}
+	else
+	{
+		uint8* GNamesAddress = reinterpret_cast<uint8*>(ImageBase + Off::InSDK::NameArray::GNames); // No derefernce
+
+		/* FNameEntry::Init() is called inside of InitializeNamePool */
+		if (!NameArray::InitializeNamePool(GNamesAddress))
+			return false;
+
+		GNames = GNamesAddress;
+	}
+
+	NameArray::PostInit();
+
+	return true;
+}
+
+bool NameArray::IterateNamePool(const std::function<void(int32 ComparisonIndex, std::string&& Name)>& Callback)
+{
+	if (!GNames || !Settings::Internal::bUseNamePool)
+		return false;
+
+	const int32 StringOffset = Off::FNameEntry::NamePool::StringOffset;
+	const int32 HeaderOffset = Off::FNameEntry::NamePool::HeaderOffset;
+	const int32 EntryIdOffset = StringOffset + ((StringOffset == 6) * 2);
+
+	const int64 BlockSizeBytes = NameEntryStride << FNameBlockOffsetBits;
+
+	const int32 LastBlock = GetNumChunks();
+	const int32 LastBlockCursor = GetByteCursor();
+
+	uint8** Blocks = reinterpret_cast<uint8**>(GNames + Off::NameArray::ChunksStart);
+
+	/* Entries of an external process are decoded from a copy of their block, one read per block instead of several per name */
+	std::vector<uint8> BlockCopy;
+
+	for (int32 Block = 0; Block <= LastBlock; Block++)
+	{
+		uint8* BlockStart = ProcessMemory::Read<uint8*>(Blocks + Block);
+
+		if (!BlockStart)
+			continue;
+
+		const int64 BlockEnd = Block == LastBlock ? LastBlockCursor : BlockSizeBytes;
+
+		if (ProcessMemory::IsExternal())
+		{
+			BlockCopy.resize(BlockSizeBytes);
+			ProcessMemory::ReadRaw(reinterpret_cast<uintptr_t>(BlockStart), BlockCopy.data(), BlockCopy.size());
+
+			BlockStart = BlockCopy.data();
+		}
+
+		int64 Offset = 0x0;
+
+		while ((Offset + StringOffset) <= BlockEnd)
+		{
+			uint8* Entry = BlockStart + Offset;
+
+			const uint16 Header = *reinterpret_cast<uint16*>(Entry + HeaderOffset);
+			const int32 NameLen = Header >> FNameEntry::FNameEntryLengthShiftCount;
+			const bool bIsWide = Header & FNameEntry::NameWideMask;
+
+			int64 EntrySize = 0x0;
+
+			if (NameLen == 0)
+			{
+				const int32 NextEntryIndex = *reinterpret_cast<int32*>(Entry + EntryIdOffset);
+
+				/* Zeroed memory, the rest of this block is unused */
+				if (!Settings::Internal::bUseOutlineNumberName || NextEntryIndex == 0x0)
+					break;
+
+				EntrySize = EntryIdOffset + sizeof(int32) + sizeof(int32);
+			}
+			else
+			{
+				const int32 ComparisonIndex = (Block << FNameBlockOffsetBits) | static_cast<int32>(Offset / NameEntryStride);
+
+				if (bIsWide)
+				{
+					Callback(ComparisonIndex, FNameEntry::WideToUtf8(reinterpret_cast<const wchar_t*>(Entry + StringOffset), NameLen));
+				}
+				else
+				{
+					Callback(ComparisonIndex, std::string(reinterpret_cast<const char*>(Entry + StringOffset), NameLen));
+				}
+
+				EntrySize = StringOffset + (NameLen * (bIsWide ? sizeof(wchar_t) : sizeof(char)));
+			}
+
+			/* Entries are aligned to the stride of the pool */
+			Offset += Align(EntrySize, NameEntryStride);
+		}
+	}
+
+	return true;
+}
+
 int32 NameArray::GetNumChunks()
 {
-	return *reinterpret_cast<int32*>(GNames + Off::NameArray::MaxChunkIndex);
+	return ProcessMemory::Read<int32>(GNames + Off::NameArray::MaxChunkIndex);
 }
 
 int32 NameArray::GetNumElements()
 {
-	return !Settings::Internal::bUseNamePool ? *reinterpret_cast<int32*>(GNames + Off::NameArray::NumElements) : 0;
+	return !Settings::Internal::bUseNamePool ? ProcessMemory::Read<int32>(GNames + Off::NameArray::NumElements) : 0;
 }
 
 int32 NameArray::GetByteCursor()
 {
-	return Settings::Internal::bUseNamePool ? *reinterpret_cast<int32*>(GNames + Off::NameArray::ByteCursor) : 0;
+	return Settings::Internal::bUseNamePool ? ProcessMemory::Read<int32>(GNames + Off::NameArray::ByteCursor) : 0;
 }
 
 FNameEntry NameArray::GetNameEntry(const void* Name)
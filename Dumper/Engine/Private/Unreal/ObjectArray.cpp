@@ -1,12 +1,23 @@
 
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+#include <thread>
 #include <format>
 #include <filesystem>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 #include "Unreal/ObjectArray.h"
+#include "Unreal/ObjectArraySnapshot.h"
 #include "OffsetFinder/Offsets.h"
 #include "Utils.h"
+#include "Profiler.h"
+#include "TimeSlicer.h"
 
 #include "Platform.h"
 
@@ -68,9 +79,9 @@ bool IsAddressValidGObjects(const uintptr_t Address, const FFixedUObjectArrayLay
 		uint8_t Pad[sizeof(void*) * 2];
 	};
 
-	void* Objects = *reinterpret_cast<void**>(Address + Layout.ObjectsOffset);
-	const int32 MaxElements = *reinterpret_cast<const int32*>(Address + Layout.MaxObjectsOffset);
-	const int32 NumElements = *reinterpret_cast<const int32*>(Address + Layout.NumObjectsOffset);
+	void* Objects = ProcessMemory::Read<void*>(reinterpret_cast<void*>(Address + Layout.ObjectsOffset));
+	const int32 MaxElements = ProcessMemory::Read<int32>(reinterpret_cast<void*>(Address + Layout.MaxObjectsOffset));
+	const int32 NumElements = ProcessMemory::Read<int32>(reinterpret_cast<void*>(Address + Layout.NumObjectsOffset));
 
 	FUObjectItem* ObjectsButDecrypted = reinterpret_cast<FUObjectItem*>(ObjectArray::DecryptPtr(Objects));
 
@@ -86,11 +97,12 @@ bool IsAddressValidGObjects(const uintptr_t Address, const FFixedUObjectArrayLay
 	if (Platform::IsBadReadPtr(ObjectsButDecrypted))
 		return false;
 
-	if (Platform::IsBadReadPtr(ObjectsButDecrypted[5].Object))
+	const uintptr_t FifthObject = reinterpret_cast<uintptr_t>(ProcessMemory::Read<void*>(&ObjectsButDecrypted[0x5].Object));
+
+	if (Platform::IsBadReadPtr(FifthObject))
 		return false;
 
-	const uintptr_t FifthObject = reinterpret_cast<uintptr_t>(ObjectsButDecrypted[0x5].Object);
-	const int32 IndexOfFithobject = *reinterpret_cast<int32_t*>(FifthObject + sizeof(void*) + sizeof(int32)); // FifthObject -> InternalIndex
+	const int32 IndexOfFithobject = ProcessMemory::Read<int32_t>(reinterpret_cast<void*>(FifthObject + sizeof(void*) + sizeof(int32))); // FifthObject -> InternalIndex
 
 	if (IndexOfFithobject != 0x5)
 		return false;
@@ -100,11 +112,11 @@ bool IsAddressValidGObjects(const uintptr_t Address, const FFixedUObjectArrayLay
 
 bool IsAddressValidGObjects(const uintptr_t Address, const FChunkedFixedUObjectArrayLayout& Layout)
 {
-	void* Objects = *reinterpret_cast<void**>(Address + Layout.ObjectsOffset);
-	const int32 MaxElements = *reinterpret_cast<const int32*>(Address + Layout.MaxElementsOffset);
-	const int32 NumElements = *reinterpret_cast<const int32*>(Address + Layout.NumElementsOffset);
-	const int32 MaxChunks   = *reinterpret_cast<const int32*>(Address + Layout.MaxChunksOffset);
-	const int32 NumChunks   = *reinterpret_cast<const int32*>(Address + Layout.NumChunksOffset);
+	void* Objects = ProcessMemory::Read<void*>(reinterpret_cast<void*>(Address + Layout.ObjectsOffset));
+	const int32 MaxElements = ProcessMemory::Read<int32>(reinterpret_cast<void*>(Address + Layout.MaxElementsOffset));
+	const int32 NumElements = ProcessMemory::Read<int32>(reinterpret_cast<void*>(Address + Layout.NumElementsOffset));
+	const int32 MaxChunks   = ProcessMemory::Read<int32>(reinterpret_cast<void*>(Address + Layout.MaxChunksOffset));
+	const int32 NumChunks   = ProcessMemory::Read<int32>(reinterpret_cast<void*>(Address + Layout.NumChunksOffset));
 
 	void** ObjectsPtrButDecrypted = reinterpret_cast<void**>(ObjectArray::DecryptPtr(Objects));
 
@@ -146,7 +158,9 @@ bool IsAddressValidGObjects(const uintptr_t Address, const FChunkedFixedUObjectA
 
 	for (int i = 0; i < NumChunks; i++)
 	{
-		if (!ObjectsPtrButDecrypted[i] || Platform::IsBadReadPtr(ObjectsPtrButDecrypted[i]))
+		void* Chunk = ProcessMemory::Read<void*>(&ObjectsPtrButDecrypted[i]);
+
+		if (!Chunk || Platform::IsBadReadPtr(Chunk))
 			return false;
 	}
 
@@ -158,7 +172,7 @@ void ObjectArray::InitializeFUObjectItem(uint8_t* FirstItemPtr)
 {
 	for (int i = 0x0; i < 0x20; i += 4)
 	{
-		if (!Platform::IsBadReadPtr(*reinterpret_cast<uint8_t**>(FirstItemPtr + i)))
+		if (!Platform::IsBadReadPtr(ProcessMemory::Read<uint8_t*>(FirstItemPtr + i)))
 		{
 			FUObjectItemInitialOffset = i;
 			break;
@@ -167,11 +181,11 @@ void ObjectArray::InitializeFUObjectItem(uint8_t* FirstItemPtr)
 
 	for (int i = FUObjectItemInitialOffset + sizeof(void*); i <= 0x38; i += 4)
 	{
-		void* SecondObject = *reinterpret_cast<uint8**>(FirstItemPtr + i);
-		void* ThirdObject  = *reinterpret_cast<uint8**>(FirstItemPtr + (i * 2) - FUObjectItemInitialOffset);
+		void* SecondObject = ProcessMemory::Read<uint8*>(FirstItemPtr + i);
+		void* ThirdObject  = ProcessMemory::Read<uint8*>(FirstItemPtr + (i * 2) - FUObjectItemInitialOffset);
 
-		if (!Platform::IsBadReadPtr(SecondObject) && !Platform::IsBadReadPtr(*reinterpret_cast<void**>(SecondObject)) &&
-			!Platform::IsBadReadPtr(ThirdObject) && !Platform::IsBadReadPtr(*reinterpret_cast<void**>(ThirdObject)))
+		if (!Platform::IsBadReadPtr(SecondObject) && !Platform::IsBadReadPtr(ProcessMemory::Read<void*>(SecondObject)) &&
+			!Platform::IsBadReadPtr(ThirdObject) && !Platform::IsBadReadPtr(ProcessMemory::Read<void*>(ThirdObject)))
 		{
 			SizeOfFUObjectItem = i - FUObjectItemInitialOffset;
 			break;
@@ -181,6 +195,8 @@ void ObjectArray::InitializeFUObjectItem(uint8_t* FirstItemPtr)
 	Off::InSDK::ObjArray::FUObjectItemInitialOffset = FUObjectItemInitialOffset;
 	Off::InSDK::ObjArray::FUObjectItemSize = SizeOfFUObjectItem;
 
+	SelectAccessors();
+
 	std::cerr << "Off::InSDK::ObjArray::FUObjectItemSize: " << Off::InSDK::ObjArray::FUObjectItemSize << "\n" ;
 }
 
@@ -188,10 +204,156 @@ void ObjectArray::InitDecryption(uint8_t* (*DecryptionFunction)(void* ObjPtr), c
 {
 	DecryptPtr = DecryptionFunction;
 	DecryptionLambdaStr = DecryptionLambdaAsStr;
+
+	bIsDecryptionEnabled = true;
+
+	if (GObjects)
+		SelectAccessors();
+}
+
+template<bool bIsChunked, bool bIsEncrypted, uint32 StaticItemSize>
+void* ObjectArray::GetAddressByIndexImpl(int32 Index)
+{
+	if (Index < 0 || Index >= Num())
+		return nullptr;
+
+	const uint32 ItemSize = StaticItemSize != 0x0 ? StaticItemSize : SizeOfFUObjectItem;
+	const int32 ObjectsOffset = bIsChunked ? Off::FUObjectArray::ChunkedFixedLayout.ObjectsOffset : Off::FUObjectArray::FixedLayout.ObjectsOffset;
+
+	uint8* Objects = ProcessMemory::Read<uint8*>(GObjects + ObjectsOffset);
+
+	if constexpr (bIsEncrypted)
+		Objects = DecryptPtr(Objects);
+
+	if constexpr (bIsChunked)
+	{
+		uint8* Chunk = ProcessMemory::Read<uint8*>(Objects + ((Index / NumElementsPerChunk) * sizeof(void*)));
+
+		return ProcessMemory::Read<void*>(Chunk + FUObjectItemInitialOffset + ((Index % NumElementsPerChunk) * ItemSize));
+	}
+	else
+	{
+		return ProcessMemory::Read<void*>(Objects + FUObjectItemInitialOffset + (Index * ItemSize));
+	}
+}
+
+template<bool bIsChunked, bool bIsEncrypted, uint32 StaticItemSize>
+void ObjectArray::ReadAddressesImpl(int32 First, int32 Count, void** OutAddresses)
+{
+	const uint32 ItemSize = StaticItemSize != 0x0 ? StaticItemSize : SizeOfFUObjectItem;
+	const int32 ObjectsOffset = bIsChunked ? Off::FUObjectArray::ChunkedFixedLayout.ObjectsOffset : Off::FUObjectArray::FixedLayout.ObjectsOffset;
+
+	uint8* Objects = ProcessMemory::Read<uint8*>(GObjects + ObjectsOffset);
+
+	if constexpr (bIsEncrypted)
+		Objects = DecryptPtr(Objects);
+
+	/* Process one chunk at a time, so the chunk-pointer is only read once for all of its items */
+	auto ReadItems = [ItemSize, OutAddresses](uint8* Items, int32 OutIndex, int32 NumItems) -> void
+	{
+		ProcessMemory::Prefetch(reinterpret_cast<uintptr_t>(Items), static_cast<size_t>(NumItems) * ItemSize);
+
+		for (int32 i = 0; i < NumItems; i++)
+			OutAddresses[OutIndex + i] = ProcessMemory::Read<void*>(Items + (i * ItemSize));
+	};
+
+	if constexpr (bIsChunked)
+	{
+		for (int32 i = 0; i < Count;)
+		{
+			const int32 Index = First + i;
+			const int32 InChunkIdx = Index % NumElementsPerChunk;
+			const int32 NumInChunk = std::min<int32>(Count - i, NumElementsPerChunk - InChunkIdx);
+
+			uint8* Chunk = ProcessMemory::Read<uint8*>(Objects + ((Index / NumElementsPerChunk) * sizeof(void*)));
+
+			ReadItems(Chunk + FUObjectItemInitialOffset + (InChunkIdx * ItemSize), i, NumInChunk);
+
+			i += NumInChunk;
+		}
+	}
+	else
+	{
+		ReadItems(Objects + FUObjectItemInitialOffset + (First * ItemSize), 0x0, Count);
+	}
+}
+
+template<bool bIsChunked, bool bIsEncrypted>
+void ObjectArray::SelectAccessorsForItemSize()
+{
+	/* Sizes of FUObjectItem with and without ClusterRootIndex, anything else falls back to reading SizeOfFUObjectItem at runtime */
+#if defined(_WIN64)
+	constexpr uint32 CommonItemSizes[] = { 0x18, 0x10 };
+#else
+	constexpr uint32 CommonItemSizes[] = { 0x10, 0x0C };
+#endif
+
+	switch (SizeOfFUObjectItem)
+	{
+	case CommonItemSizes[0]:
+		ByIndex = &GetAddressByIndexImpl<bIsChunked, bIsEncrypted, CommonItemSizes[0]>;
+		ReadRange = &ReadAddressesImpl<bIsChunked, bIsEncrypted, CommonItemSizes[0]>;
+		break;
+	case CommonItemSizes[1]:
+		ByIndex = &GetAddressByIndexImpl<bIsChunked, bIsEncrypted, CommonItemSizes[1]>;
+		ReadRange = &ReadAddressesImpl<bIsChunked, bIsEncrypted, CommonItemSizes[1]>;
+		break;
+	default:
+		ByIndex = &GetAddressByIndexImpl<bIsChunked, bIsEncrypted, 0x0>;
+		ReadRange = &ReadAddressesImpl<bIsChunked, bIsEncrypted, 0x0>;
+		break;
+	}
+}
+
+void ObjectArray::SelectAccessors()
+{
+	if (Off::FUObjectArray::bIsChunked)
+	{
+		bIsDecryptionEnabled ? SelectAccessorsForItemSize<true, true>() : SelectAccessorsForItemSize<true, false>();
+	}
+	else
+	{
+		bIsDecryptionEnabled ? SelectAccessorsForItemSize<false, true>() : SelectAccessorsForItemSize<false, false>();
+	}
 }
 
 
 /* We don't speak about this function... */
+void ObjectArray::InitFromAddress(void* GObjectsAddress, bool bIsChunked)
+{
+	if (!bIsChunked)
+	{
+		GObjects = static_cast<uint8*>(GObjectsAddress);
+		NumElementsPerChunk = -1;
+
+		Off::InSDK::ObjArray::GObjects = Platform::GetOffset(GObjectsAddress);
+
+		std::cerr << "Found FFixedUObjectArray GObjects at offset 0x" << std::hex << Off::InSDK::ObjArray::GObjects << "\n\n";
+
+		uint8_t* FirstItem = DecryptPtr(ProcessMemory::Read<uint8_t*>(GObjects + Off::FUObjectArray::GetObjectsOffset()));
+
+		ObjectArray::InitializeFUObjectItem(FirstItem);
+	}
+	else
+	{
+		GObjects = static_cast<uint8*>(GObjectsAddress);
+		
+		NumElementsPerChunk = Max() / MaxChunks();
+		Off::InSDK::ObjArray::ChunkSize = NumElementsPerChunk;
+
+		SizeOfFUObjectItem = sizeof(void*) + sizeof(int32) + sizeof(int32);
+		FUObjectItemInitialOffset = 0x0;
+
+		Off::InSDK::ObjArray::GObjects = Platform::GetOffset(GObjectsAddress);
+
+		std::cerr << "Found FChunkedFixedUObjectArray GObjects at offset 0x" << std::hex << Off::InSDK::ObjArray::GObjects << "\n\n";
+
+		uint8_t* ChunksPtr = DecryptPtr(ProcessMemory::Read<uint8_t*>(GObjects + Off::FUObjectArray::GetObjectsOffset()));
+
+		ObjectArray::InitializeFUObjectItem(ProcessMemory::Read<uint8_t*>(ChunksPtr));
+	}
+}
+
 void ObjectArray::Init(bool bScanAllMemory, const char* const ModuleName)
 {
 	if (!bScanAllMemory)
@@ -242,78 +404,34 @@ void ObjectArray::Init(bool bScanAllMemory, const char* const ModuleName)
 		return false;
 	};
 
+	/* Doesn't write the layout to Off::FUObjectArray, so it can be called from multiple threads at once */
+	auto IsAddressValidGObjectsForAnyLayout = [](const void* CurrentAddress) -> bool
+	{
+		const uintptr_t Address = reinterpret_cast<uintptr_t>(CurrentAddress);
+
+		auto IsValidForLayout = [Address](const auto& Layout) -> bool { return ::IsAddressValidGObjects(Address, Layout); };
+
+		return std::any_of(FFixedUObjectArrayLayouts.begin(), FFixedUObjectArrayLayouts.end(), IsValidForLayout)
+			|| std::any_of(FChunkedFixedUObjectArrayLayouts.begin(), FChunkedFixedUObjectArrayLayouts.end(), IsValidForLayout);
+	};
+
+	constexpr bool bMultithreaded = Settings::General::bUseMultithreadedMemoryScans;
+
 	void* GObjectsAddress = nullptr;
 
 	if (bScanAllMemory)
 	{
-		GObjectsAddress = Platform::IterateAllSectionsWithCallback(IsAddressValidGObjects, 0x4, 0x50, ModuleName);
+		GObjectsAddress = Platform::IterateAllSectionsWithCallback(IsAddressValidGObjectsForAnyLayout, 0x4, 0x50, ModuleName, bMultithreaded);
 	}
 	else
 	{
-		GObjectsAddress = Platform::IterateSectionWithCallback(Platform::GetSectionInfo(".data"), IsAddressValidGObjects, 0x4, 0x50);
+		GObjectsAddress = Platform::IterateSectionWithCallback(Platform::GetSectionInfo(".data"), IsAddressValidGObjectsForAnyLayout, 0x4, 0x50, bMultithreaded);
 	}
 
-
-	if (GObjectsAddress)
+	/* Check the winning address once more on this thread, to store the layout that matched */
+	if (GObjectsAddress && IsAddressValidGObjects(GObjectsAddress))
 	{
-		if (!bIsGObjectsChunked)
-		{
-			GObjects = static_cast<uint8*>(GObjectsAddress);
-			NumElementsPerChunk = -1;
-
-			Off::InSDK::ObjArray::GObjects = Platform::GetOffset(GObjectsAddress);
-
-			std::cerr << "Found FFixedUObjectArray GObjects at offset 0x" << std::hex << Off::InSDK::ObjArray::GObjects << "\n\n";
-
-			ByIndex = [](void* ObjectsArray, int32 Index, uint32 FUObjectItemSize, uint32 FUObjectItemOffset, uint32 PerChunk) -> void*
-			{
-				if (Index < 0 || Index > Num())
-					return nullptr;
-
-				uint8_t* ChunkPtr = DecryptPtr(*reinterpret_cast<uint8_t**>(ObjectsArray));
-
-				return *reinterpret_cast<void**>(ChunkPtr + FUObjectItemOffset + (Index * FUObjectItemSize));
-			};
-
-			uint8_t* FirstItem = DecryptPtr(*reinterpret_cast<uint8_t**>(GObjects + Off::FUObjectArray::GetObjectsOffset()));
-
-			ObjectArray::InitializeFUObjectItem(FirstItem);
-		}
-		else
-		{
-			GObjects = static_cast<uint8*>(GObjectsAddress);
-			
-			NumElementsPerChunk = Max() / MaxChunks();
-			Off::InSDK::ObjArray::ChunkSize = NumElementsPerChunk;
-
-			SizeOfFUObjectItem = sizeof(void*) + sizeof(int32) + sizeof(int32);
-			FUObjectItemInitialOffset = 0x0;
-
-			Off::InSDK::ObjArray::GObjects = Platform::GetOffset(GObjectsAddress);
-
-			std::cerr << "Found FChunkedFixedUObjectArray GObjects at offset 0x" << std::hex << Off::InSDK::ObjArray::GObjects << "\n\n";
-
-			ByIndex = [](void* ObjectsArray, int32 Index, uint32 FUObjectItemSize, uint32 FUObjectItemOffset, uint32 PerChunk) -> void*
-			{
-				if (Index < 0 || Index > Num())
-					return nullptr;
-
-				const int32 ChunkIndex = Index / PerChunk;
-				const int32 InChunkIdx = Index % PerChunk;
-
-				uint8_t* ChunkPtr = DecryptPtr(*reinterpret_cast<uint8_t**>(ObjectsArray));
-
-				uint8_t* Chunk = reinterpret_cast<uint8_t**>(ChunkPtr)[ChunkIndex];
-				uint8_t* ItemPtr = Chunk + (InChunkIdx * FUObjectItemSize);
-
-				return *reinterpret_cast<void**>(ItemPtr + FUObjectItemOffset);
-			};
-			
-			uint8_t* ChunksPtr = DecryptPtr(*reinterpret_cast<uint8_t**>(GObjects + Off::FUObjectArray::GetObjectsOffset()));
-
-			ObjectArray::InitializeFUObjectItem(*reinterpret_cast<uint8_t**>(ChunksPtr));
-		}
-
+		InitFromAddress(GObjectsAddress, bIsGObjectsChunked);
 		return;
 	}
 
@@ -331,6 +449,29 @@ void ObjectArray::Init(bool bScanAllMemory, const char* const ModuleName)
 	}
 }
 
+bool ObjectArray::TryInit(int32 GObjectsOffset, bool bIsChunked, const FFixedUObjectArrayLayout& FixedLayout, const FChunkedFixedUObjectArrayLayout& ChunkedLayout, const char* const ModuleName)
+{
+	const uintptr_t GObjectsAddress = Platform::GetModuleBase(ModuleName) + GObjectsOffset;
+
+	if (bIsChunked ? !ChunkedLayout.IsValid() || !IsAddressValidGObjects(GObjectsAddress, ChunkedLayout) : !FixedLayout.IsValid() || !IsAddressValidGObjects(GObjectsAddress, FixedLayout))
+		return false;
+
+	Off::FUObjectArray::bIsChunked = bIsChunked;
+
+	if (bIsChunked)
+	{
+		Off::FUObjectArray::ChunkedFixedLayout = ChunkedLayout;
+	}
+	else
+	{
+		Off::FUObjectArray::FixedLayout = FixedLayout;
+	}
+
+	InitFromAddress(reinterpret_cast<void*>(GObjectsAddress), bIsChunked);
+
+	return true;
+}
+
 void ObjectArray::Init(int32 GObjectsOffset, const FFixedUObjectArrayLayout& ObjectArrayLayout, const char* const ModuleName)
 {
 	GObjects = reinterpret_cast<uint8_t*>(Platform::GetModuleBase(ModuleName) + GObjectsOffset);
@@ -341,21 +482,11 @@ void ObjectArray::Init(int32 GObjectsOffset, const FFixedUObjectArrayLayout& Obj
 	Off::FUObjectArray::bIsChunked = false;
 	Off::FUObjectArray::FixedLayout = ObjectArrayLayout.IsValid() ? ObjectArrayLayout : FFixedUObjectArrayLayouts[0];
 
-	ByIndex = [](void* ObjectsArray, int32 Index, uint32 FUObjectItemSize, uint32 FUObjectItemOffset, uint32 PerChunk) -> void*
-	{
-		if (Index < 0 || Index > Num())
-			return nullptr;
-
-		uint8_t* ItemPtr = *reinterpret_cast<uint8_t**>(ObjectsArray) + (Index * FUObjectItemSize);
-
-		return *reinterpret_cast<void**>(ItemPtr + FUObjectItemOffset);
-	};
-
-	uint8_t* ChunksPtr = DecryptPtr(*reinterpret_cast<uint8_t**>(GObjects + Off::FUObjectArray::GetObjectsOffset()));
+	uint8_t* ChunksPtr = DecryptPtr(ProcessMemory::Read<uint8_t*>(GObjects + Off::FUObjectArray::GetObjectsOffset()));
 
 	std::cerr << "Overwrote FFixedUObjectArray GObjects to offset 0x" << std::hex << Off::InSDK::ObjArray::GObjects << "\n" ;
 
-	ObjectArray::InitializeFUObjectItem(*reinterpret_cast<uint8_t**>(ChunksPtr));
+	ObjectArray::InitializeFUObjectItem(ProcessMemory::Read<uint8_t*>(ChunksPtr));
 }
 
 void ObjectArray::Init(int32 GObjectsOffset, int32 ElementsPerChunk, const FChunkedFixedUObjectArrayLayout& ObjectArrayLayout, const char* const ModuleName)
@@ -369,25 +500,221 @@ void ObjectArray::Init(int32 GObjectsOffset, int32 ElementsPerChunk, const FChun
 	NumElementsPerChunk = ElementsPerChunk;
 	Off::InSDK::ObjArray::ChunkSize = ElementsPerChunk;
 
-	ByIndex = [](void* ObjectsArray, int32 Index, uint32 FUObjectItemSize, uint32 FUObjectItemOffset, uint32 PerChunk) -> void*
+	uint8_t* ChunksPtr = DecryptPtr(ProcessMemory::Read<uint8_t*>(GObjects + Off::FUObjectArray::GetObjectsOffset()));
+
+	std::cerr << "Overwrote FChunkedFixedUObjectArray GObjects to offset 0x" << std::hex << Off::InSDK::ObjArray::GObjects << "\n" ;
+
+	ObjectArray::InitializeFUObjectItem(ProcessMemory::Read<uint8_t*>(ChunksPtr));
+}
+
+void ObjectArray::PostInit()
+{
+	bAllowLookupTables = true;
+
+	NameLookupTableNum = -1;
+	FullNameLookupTableNum = -1;
+}
+
+void ObjectArray::ResetLookupTables()
+{
+	std::scoped_lock Lock(NameLookupTableLock, FullNameLookupTableLock);
+
+	NameLookupTable.clear();
+	NameLookupTableNum = -1;
+
+	FullNameLookupTable.clear();
+	FullNameLookupTableNum = -1;
+}
+
+MemoryReport ObjectArray::GetLookupTablesMemoryReport()
+{
+	auto GetTableReport = [](const LookupTableType& Table) -> MemoryReport
 	{
-		if (Index < 0 || Index > Num())
-			return nullptr;
+		MemoryReport Report = MemoryReport::FromHashContainer(Table);
 
-		const int32 ChunkIndex = Index / PerChunk;
-		const int32 InChunkIdx = Index % PerChunk;
+		for (const auto& [Name, Indices] : Table)
+		{
+			Report += MemoryReport::FromString(Name);
+			Report += MemoryReport::FromVector(Indices);
+		}
 
-		uint8_t* Chunk = (*reinterpret_cast<uint8_t***>(ObjectsArray))[ChunkIndex];
-		uint8_t* ItemPtr = reinterpret_cast<uint8_t*>(Chunk) + (InChunkIdx * FUObjectItemSize);
+		return Report;
+	};
 
-		return *reinterpret_cast<void**>(ItemPtr + FUObjectItemOffset);
+	std::shared_lock NameLock(NameLookupTableLock);
+	std::shared_lock FullNameLock(FullNameLookupTableLock);
+
+	MemoryReport Report = GetTableReport(NameLookupTable);
+	Report += GetTableReport(FullNameLookupTable);
+
+	return Report;
+}
+
+std::vector<int32> ObjectArray::FindIndicesByName(const std::string& Name)
+{
+	if (!bAllowLookupTables)
+		return {};
+
+	const int32 NumObjects = GetIterationNum();
+
+	auto FindIndices = [&Name]() -> std::vector<int32>
+	{
+		auto It = NameLookupTable.find(Name);
+
+		return It != NameLookupTable.end() ? It->second : std::vector<int32>();
 	};
 
-	uint8_t* ChunksPtr = DecryptPtr(*reinterpret_cast<uint8_t**>(GObjects + Off::FUObjectArray::GetObjectsOffset()));
+	{
+		std::shared_lock Lock(NameLookupTableLock);
+
+		if (NameLookupTableNum == NumObjects) [[likely]]
+			return FindIndices();
+	}
 
-	std::cerr << "Overwrote FChunkedFixedUObjectArray GObjects to offset 0x" << std::hex << Off::InSDK::ObjArray::GObjects << "\n" ;
+	std::unique_lock Lock(NameLookupTableLock);
+
+	if (NameLookupTableNum > NumObjects)
+	{
+		NameLookupTable.clear();
+		NameLookupTableNum = -1;
+	}
+
+	/* Only objects added since the last lookup need to be indexed, GObjects only grows while the dumper runs. Another thread might have done it already. */
+	if (NameLookupTableNum < NumObjects)
+	{
+		/* Group objects by their FName first, so every distinct name is only converted to a string once */
+		std::unordered_map<uint64, std::vector<int32>> IndicesByFName;
+
+		const ObjectsIterator EndIt(NumObjects);
+
+		for (auto It = ObjectsIterator(std::max(NameLookupTableNum, 0)); It != EndIt; ++It)
+		{
+			if (!*It)
+				continue;
+
+			const FName ObjName = (*It).GetFName();
+
+			const uint64 Key = (static_cast<uint64>(ObjName.GetNumber()) << 32) | static_cast<uint32>(ObjName.GetCompIdx());
+
+			IndicesByFName[Key].push_back(It.GetIndex());
+		}
+
+		NameLookupTable.reserve(NameLookupTable.size() + IndicesByFName.size());
+
+		for (auto& [Key, Indices] : IndicesByFName)
+		{
+			std::vector<int32>& Entry = NameLookupTable[GetByIndex(Indices[0]).GetName()];
+
+			const size_t OldSize = Entry.size();
+			Entry.insert(Entry.end(), Indices.begin(), Indices.end());
+
+			/* Keep the order of a linear search through GObjects, the first match has the lowest index */
+			std::inplace_merge(Entry.begin(), Entry.begin() + OldSize, Entry.end());
+		}
+
+		NameLookupTableNum = NumObjects;
+	}
 
-	ObjectArray::InitializeFUObjectItem(*reinterpret_cast<uint8_t**>(ChunksPtr));
+	return FindIndices();
+}
+
+std::vector<int32> ObjectArray::FindIndicesByFullName(const std::string& FullName)
+{
+	if (!bAllowLookupTables)
+		return {};
+
+	const int32 NumObjects = GetIterationNum();
+
+	auto FindIndices = [&FullName]() -> std::vector<int32>
+	{
+		auto It = FullNameLookupTable.find(FullName);
+
+		return It != FullNameLookupTable.end() ? It->second : std::vector<int32>();
+	};
+
+	{
+		std::shared_lock Lock(FullNameLookupTableLock);
+
+		if (FullNameLookupTableNum == NumObjects) [[likely]]
+			return FindIndices();
+	}
+
+	std::unique_lock Lock(FullNameLookupTableLock);
+
+	if (FullNameLookupTableNum > NumObjects)
+	{
+		FullNameLookupTable.clear();
+		FullNameLookupTableNum = -1;
+	}
+
+	if (FullNameLookupTableNum < NumObjects)
+	{
+		FullNameLookupTable.reserve(NumObjects);
+
+		const ObjectsIterator EndIt(NumObjects);
+
+		for (auto It = ObjectsIterator(std::max(FullNameLookupTableNum, 0)); It != EndIt; ++It)
+		{
+			if (*It)
+				FullNameLookupTable[(*It).GetFullName()].push_back(It.GetIndex());
+		}
+
+		FullNameLookupTableNum = NumObjects;
+	}
+
+	return FindIndices();
+}
+
+/* Formats all objects into per-thread buffers, in parallel, and writes the buffers to the stream in order of their object-indices */
+template<typename FormatterType>
+static void DumpObjectsInParallel(std::ofstream& DumpStream, FormatterType&& FormatObject)
+{
+	const int32 NumObjects = ObjectArray::Num();
+
+	const int32 NumThreads = std::clamp(static_cast<int32>(std::thread::hardware_concurrency()), 1, 32);
+	const int32 ObjectsPerThread = (NumObjects / NumThreads) + 1;
+
+	std::vector<std::string> Buffers(NumThreads);
+	std::vector<std::thread> Threads;
+	Threads.reserve(NumThreads);
+
+	for (int i = 0; i < NumThreads; i++)
+	{
+		Threads.emplace_back([&, i]()
+		{
+			const int32 StartIndex = i * ObjectsPerThread;
+			const int32 EndIndex = std::min(StartIndex + ObjectsPerThread, NumObjects);
+
+			std::string& Buffer = Buffers[i];
+			Buffer.reserve(static_cast<size_t>(std::max(EndIndex - StartIndex, 0)) * 0x80);
+
+			constexpr int32 AddressBlockSize = 0x400;
+			void* Addresses[AddressBlockSize];
+
+			for (int32 BlockStart = StartIndex; BlockStart < EndIndex; BlockStart += AddressBlockSize)
+			{
+				const int32 BlockSize = std::min(AddressBlockSize, EndIndex - BlockStart);
+
+				TimeSlicer::YieldPoint();
+
+				ObjectArray::GetAddressesInRange(BlockStart, BlockSize, Addresses);
+
+				for (int32 j = 0; j < BlockSize; j++)
+				{
+					if (UEObject Object = Addresses[j])
+						FormatObject(Buffer, Object);
+				}
+			}
+		});
+	}
+
+	for (int i = 0; i < NumThreads; i++)
+	{
+		Threads[i].join();
+
+		DumpStream.write(Buffers[i].data(), Buffers[i].size());
+		Buffers[i] = std::string();
+	}
 }
 
 void ObjectArray::DumpObjects(const fs::path& Path, bool bWithPathname)
@@ -398,17 +725,21 @@ void ObjectArray::DumpObjects(const fs::path& Path, bool bWithPathname)
 	DumpStream << (!Settings::Generator::GameVersion.empty() && !Settings::Generator::GameName.empty() ? (Settings::Generator::GameVersion + '-' + Settings::Generator::GameName) + "\n\n" : "");
 	DumpStream << "Count: " << Num() << "\n\n\n";
 
-	for (auto Object : ObjectArray())
+	DumpObjectsInParallel(DumpStream, [bWithPathname](std::string& Buffer, UEObject Object)
 	{
+		std::format_to(std::back_inserter(Buffer), "[{:08X}] {{{}}} ", Object.GetIndex(), Object.GetAddress());
+
 		if (!bWithPathname)
 		{
-			DumpStream << std::format("[{:08X}] {{{}}} {}\n", Object.GetIndex(), Object.GetAddress(), Object.GetFullName());
+			Object.GetFullName(Buffer);
 		}
 		else
 		{
-			DumpStream << std::format("[{:08X}] {{{}}} {}\n", Object.GetIndex(), Object.GetAddress(), Object.GetPathName());
+			Object.GetPathName(Buffer);
 		}
-	}
+
+		Buffer += '\n';
+	});
 
 	DumpStream.close();
 }
@@ -421,59 +752,208 @@ void ObjectArray::DumpObjectsWithProperties(const fs::path& Path, bool bWithPath
 	DumpStream << (!Settings::Generator::GameVersion.empty() && !Settings::Generator::GameName.empty() ? (Settings::Generator::GameVersion + '-' + Settings::Generator::GameName) + "\n\n" : "");
 	DumpStream << "Count: " << Num() << "\n\n\n";
 
-	for (auto Object : ObjectArray())
+	DumpObjectsInParallel(DumpStream, [bWithPathname](std::string& Buffer, UEObject Object)
 	{
+		std::format_to(std::back_inserter(Buffer), "[{:08X}] {{{}}} ", Object.GetIndex(), Object.GetAddress());
+
 		if (!bWithPathname)
 		{
-			DumpStream << std::format("[{:08X}] {{{}}} {}\n", Object.GetIndex(), Object.GetAddress(), Object.GetFullName());
+			Object.GetFullName(Buffer);
 		}
 		else
 		{
-			DumpStream << std::format("[{:08X}] {{{}}} {}\n", Object.GetIndex(), Object.GetAddress(), Object.GetPathName());
+			Object.GetPathName(Buffer);
 		}
 
+		Buffer += '\n';
+
 		if (Object.IsA(EClassCastFlags::Struct))
 		{
-			for (UEProperty Prop : Object.Cast<UEStruct>().GetProperties())
+			for (UEProperty Prop : Object.Cast<UEStruct>().IterateProperties())
 			{
-				DumpStream << std::format("[{:08X}] {{{}}}     {} {}\n", Prop.GetOffset(), Prop.GetAddress(), Prop.GetPropClassName(), Prop.GetName());
+				std::format_to(std::back_inserter(Buffer), "[{:08X}] {{{}}}     {} {}\n", Prop.GetOffset(), Prop.GetAddress(), Prop.GetPropClassName(), Prop.GetName());
 			}
 		}
-	}
+	});
+
+	DumpStream.close();
+}
+
+
+void ObjectArray::DumpObjectsBinary(const fs::path& Path)
+{
+	DumpObjectsBinary(Path, SerializeObjectsBinary());
+}
+
+void ObjectArray::DumpObjectsBinary(const fs::path& Path, const std::string& SerializedObjects)
+{
+	std::ofstream DumpStream(Path / "GObjects-Dump.bin", std::ios::binary);
+
+	DumpStream.write(SerializedObjects.data(), SerializedObjects.size());
 
 	DumpStream.close();
 }
 
+std::string ObjectArray::SerializeObjectsBinary()
+{
+	using namespace BinaryObjectDump;
+
+	const int32 NumObjects = Num();
+
+	std::vector<ObjectRecord> Objects(NumObjects);
+	std::vector<PropertyRecord> Properties;
+
+	std::string StringBlob;
+	std::unordered_map<std::string, uint32> StringOffsets;
+
+	auto AddString = [&](std::string&& Str, uint32& OutOffset, uint32& OutLength)
+	{
+		OutLength = static_cast<uint32>(Str.size());
+
+		auto [It, bInserted] = StringOffsets.try_emplace(std::move(Str), static_cast<uint32>(StringBlob.size()));
+
+		if (bInserted)
+		{
+			StringBlob += It->first;
+			StringBlob += '\0';
+		}
+
+		OutOffset = It->second;
+	};
+
+	for (UEObject Obj : ObjectArray())
+	{
+		/* Object was created after we started dumping */
+		if (Obj.GetIndex() >= NumObjects)
+			continue;
+
+		const UEClass Class = Obj.GetClass();
+		const UEObject Outer = Obj.GetOuter();
+
+		ObjectRecord& Record = Objects[Obj.GetIndex()];
+		Record.Address = reinterpret_cast<uint64>(Obj.GetAddress());
+		Record.Index = Obj.GetIndex();
+		Record.ClassIndex = Class ? Class.GetIndex() : -1;
+		Record.OuterIndex = Outer ? Outer.GetIndex() : -1;
+		Record.Flags = static_cast<uint32>(Obj.GetFlags());
+		Record.CastFlags = Class ? static_cast<uint64>(Class.GetCastFlags()) : 0x0;
+
+		AddString(Obj.GetName(), Record.NameOffset, Record.NameLength);
+
+		if (!Obj.IsA(EClassCastFlags::Struct))
+			continue;
+
+		Record.FirstProperty = static_cast<uint32>(Properties.size());
+
+		for (UEProperty Prop : Obj.Cast<UEStruct>().IterateProperties())
+		{
+			PropertyRecord& PropRecord = Properties.emplace_back();
+			PropRecord.Address = reinterpret_cast<uint64>(Prop.GetAddress());
+			PropRecord.Offset = Prop.GetOffset();
+			PropRecord.Size = Prop.GetSize();
+
+			AddString(Prop.GetName(), PropRecord.NameOffset, PropRecord.NameLength);
+			AddString(Prop.GetPropClassName(), PropRecord.TypeNameOffset, PropRecord.TypeNameLength);
+		}
+
+		Record.NumProperties = static_cast<uint32>(Properties.size()) - Record.FirstProperty;
+	}
+
+	FileHeader Header = {};
+	memcpy(Header.Magic, Magic, sizeof(Magic));
+	Header.Version = Version;
+	Header.HeaderSize = sizeof(FileHeader);
+
+	Header.NumObjects = NumObjects;
+	Header.ObjectRecordSize = sizeof(ObjectRecord);
+	Header.ObjectTableOffset = sizeof(FileHeader);
+
+	Header.NumProperties = static_cast<uint32>(Properties.size());
+	Header.PropertyRecordSize = sizeof(PropertyRecord);
+	Header.PropertyTableOffset = Header.ObjectTableOffset + (Objects.size() * sizeof(ObjectRecord));
+
+	Header.StringBlobOffset = Header.PropertyTableOffset + (Properties.size() * sizeof(PropertyRecord));
+	Header.StringBlobSize = StringBlob.size();
+
+	std::string SerializedObjects;
+	SerializedObjects.reserve(Header.StringBlobOffset + Header.StringBlobSize);
+
+	SerializedObjects.append(reinterpret_cast<const char*>(&Header), sizeof(Header));
+	SerializedObjects.append(reinterpret_cast<const char*>(Objects.data()), Objects.size() * sizeof(ObjectRecord));
+	SerializedObjects.append(reinterpret_cast<const char*>(Properties.data()), Properties.size() * sizeof(PropertyRecord));
+	SerializedObjects.append(StringBlob);
+
+	return SerializedObjects;
+}
 
 int32 ObjectArray::Num()
 {
-	return *reinterpret_cast<int32*>(GObjects + Off::FUObjectArray::GetNumElementsOffset());
+	return ProcessMemory::Read<int32>(GObjects + Off::FUObjectArray::GetNumElementsOffset());
 }
 
 int32 ObjectArray::Max()
 {
-	return *reinterpret_cast<int32*>(GObjects + Off::FUObjectArray::GetMaxElementsOffset());
+	return ProcessMemory::Read<int32>(GObjects + Off::FUObjectArray::GetMaxElementsOffset());
 }
 
 int32 ObjectArray::NumChunks()
 {
-	return *reinterpret_cast<int32*>(GObjects + Off::FUObjectArray::GetNumChunksOffset());
+	return ProcessMemory::Read<int32>(GObjects + Off::FUObjectArray::GetNumChunksOffset());
 }
 
 int32 ObjectArray::MaxChunks()
 {
-	return *reinterpret_cast<int32*>(GObjects + Off::FUObjectArray::GetMaxChunksOffset());
+	return ProcessMemory::Read<int32>(GObjects + Off::FUObjectArray::GetMaxChunksOffset());
 }
 
 template<typename UEType>
 static UEType ObjectArray::GetByIndex(int32 Index)
 {
-	return UEType(ByIndex(GObjects + Off::FUObjectArray::GetObjectsOffset(), Index, SizeOfFUObjectItem, FUObjectItemInitialOffset, NumElementsPerChunk));
+	if (ObjectArraySnapshot::IsBuilt() && Index >= 0 && Index < ObjectArraySnapshot::Num())
+		return UEType(ObjectArraySnapshot::GetAddress(Index));
+
+	return UEType(ByIndex(Index));
+}
+
+void ObjectArray::GetAddressesInRange(int32 First, int32 Count, void** OutAddresses)
+{
+	const int32 NumObjects = ObjectArraySnapshot::IsBuilt() ? ObjectArraySnapshot::Num() : Num();
+
+	const int32 ValidFirst = std::clamp(First, 0, NumObjects);
+	const int32 ValidLast = std::clamp(First + Count, ValidFirst, NumObjects);
+
+	std::fill(OutAddresses, OutAddresses + Count, nullptr);
+
+	if (ValidLast <= ValidFirst)
+		return;
+
+	if (ObjectArraySnapshot::IsBuilt())
+	{
+		for (int32 i = ValidFirst; i < ValidLast; i++)
+			OutAddresses[i - First] = ObjectArraySnapshot::GetAddress(i);
+
+		return;
+	}
+
+	ReadRange(ValidFirst, ValidLast - ValidFirst, OutAddresses + (ValidFirst - First));
 }
 
 template<typename UEType>
 UEType ObjectArray::FindObject(const std::string& FullName, EClassCastFlags RequiredType)
 {
+	if (bAllowLookupTables)
+	{
+		for (const int32 Index : FindIndicesByFullName(FullName))
+		{
+			UEObject Object = GetByIndex(Index);
+
+			if (Object && Object.IsA(RequiredType))
+				return Object.Cast<UEType>();
+		}
+
+		return UEType();
+	}
+
 	for (UEObject Object : ObjectArray())
 	{
 		if (Object.IsA(RequiredType) && Object.GetFullName() == FullName)
@@ -488,6 +968,20 @@ UEType ObjectArray::FindObject(const std::string& FullName, EClassCastFlags Requ
 template<typename UEType>
 UEType ObjectArray::FindObjectFast(const std::string& Name, EClassCastFlags RequiredType)
 {
+	if (bAllowLookupTables)
+	{
+		for (const int32 Index : FindIndicesByName(Name))
+		{
+			UEObject Object = GetByIndex(Index);
+
+			/* Re-check the name, the slot might have been reused by a different object since it was indexed */
+			if (Object && Object.IsA(RequiredType) && Object.GetName() == Name)
+				return Object.Cast<UEType>();
+		}
+
+		return UEType();
+	}
+
 	auto ObjArray = ObjectArray();
 
 	for (UEObject Object : ObjArray)
@@ -504,6 +998,19 @@ UEType ObjectArray::FindObjectFast(const std::string& Name, EClassCastFlags Requ
 template<typename UEType>
 static UEType ObjectArray::FindObjectFastInOuter(const std::string& Name, std::string Outer)
 {
+	if (bAllowLookupTables)
+	{
+		for (const int32 Index : FindIndicesByName(Name))
+		{
+			UEObject Object = GetByIndex(Index);
+
+			if (Object && Object.GetName() == Name && Object.GetOuter().GetName() == Outer)
+				return Object.Cast<UEType>();
+		}
+
+		return UEType();
+	}
+
 	auto ObjArray = ObjectArray();
 
 	for (UEObject Object : ObjArray)
@@ -537,19 +1044,71 @@ UEClass ObjectArray::FindClassFast(const std::string& Name)
 	return FindObjectFast<UEClass>(Name, EClassCastFlags::Class);
 }
 
+int32 ObjectArray::GetIterationNum()
+{
+	return ObjectArraySnapshot::IsBuilt() ? ObjectArraySnapshot::Num() : Num();
+}
+
+UEObject ObjectArray::GetIterationObject(int32 Index)
+{
+	if (ObjectArraySnapshot::IsBuilt())
+		return Index >= 0 && Index < ObjectArraySnapshot::Num() ? ObjectArraySnapshot::GetAddress(Index) : nullptr;
+
+	return GetByIndex(Index);
+}
+
 ObjectArray::ObjectsIterator ObjectArray::begin()
 {
 	return ObjectsIterator();
 }
 ObjectArray::ObjectsIterator ObjectArray::end()
 {
-	return ObjectsIterator(Num());
+	return ObjectsIterator(GetIterationNum());
 }
 
 
+/* Only a hint to the CPU, prefetching an address that isn't mapped doesn't fault. Objects of an external process are read through ProcessMemory instead. */
+static inline void PrefetchObjectHeader(const void* Object)
+{
+	if (!Object || ProcessMemory::IsExternal())
+		return;
+
+	const char* Header = static_cast<const char*>(Object);
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	_mm_prefetch(Header, _MM_HINT_T0);
+	_mm_prefetch(Header + Off::UObject::Outer, _MM_HINT_T0);
+#elif defined(__GNUC__) || defined(__clang__)
+	__builtin_prefetch(Header);
+	__builtin_prefetch(Header + Off::UObject::Outer);
+#endif
+}
+
 ObjectArray::ObjectsIterator::ObjectsIterator(int32 StartIndex)
-	: CurrentIndex(StartIndex), CurrentObject(ObjectArray::GetByIndex(StartIndex))
+	: CurrentIndex(StartIndex), CurrentObject(nullptr)
+{
+	const int32 NumObjects = ObjectArray::GetIterationNum();
+
+	if (StartIndex < 0 || StartIndex >= NumObjects)
+		return;
+
+	ReadBlock(StartIndex, NumObjects);
+
+	CurrentObject = UEObject(Addresses[0]);
+}
+
+void ObjectArray::ObjectsIterator::ReadBlock(int32 First, int32 NumObjects)
 {
+	/* Blocks are the slices of every serial pass over GObjects */
+	TimeSlicer::YieldPoint();
+
+	BlockStart = First;
+	NumInBlock = std::min(BlockSize, NumObjects - First);
+
+	ObjectArray::GetAddressesInRange(BlockStart, NumInBlock, Addresses);
+
+	for (int32 i = 0; i < std::min(PrefetchDistance, NumInBlock); i++)
+		PrefetchObjectHeader(Addresses[i]);
 }
 
 UEObject ObjectArray::ObjectsIterator::operator*() const
@@ -559,15 +1118,37 @@ UEObject ObjectArray::ObjectsIterator::operator*() const
 
 ObjectArray::ObjectsIterator& ObjectArray::ObjectsIterator::operator++()
 {
-	CurrentObject = ObjectArray::GetByIndex(++CurrentIndex);
+	const int32 NumObjects = ObjectArray::GetIterationNum();
+
+	Profiler::AddCount(EProfilerCounter::ObjectsVisited);
+
+	CurrentIndex++;
 
-	while (!CurrentObject && CurrentIndex < (ObjectArray::Num() - 1))
+	while (CurrentIndex < NumObjects)
 	{
-		CurrentObject = ObjectArray::GetByIndex(++CurrentIndex);
+		if (CurrentIndex < BlockStart || CurrentIndex >= (BlockStart + NumInBlock))
+			ReadBlock(CurrentIndex, NumObjects);
+
+		/* Skip all empty slots of this block at once, a block without any objects only costs one read of the range */
+		const int32 BlockEnd = std::min(BlockStart + NumInBlock, NumObjects);
+
+		while (CurrentIndex < BlockEnd && !Addresses[CurrentIndex - BlockStart])
+			CurrentIndex++;
+
+		if (CurrentIndex == BlockEnd)
+			continue;
+
+		const int32 InBlockIndex = CurrentIndex - BlockStart;
+
+		if ((InBlockIndex + PrefetchDistance) < NumInBlock)
+			PrefetchObjectHeader(Addresses[InBlockIndex + PrefetchDistance]);
+
+		CurrentObject = UEObject(Addresses[InBlockIndex]);
+
+		return *this;
 	}
 
-	if (!CurrentObject && CurrentIndex == (ObjectArray::Num() - 1)) [[unlikely]]
-		CurrentIndex++;
+	CurrentObject = nullptr;
 
 	return *this;
 }
@@ -589,26 +1170,22 @@ int32 ObjectArray::ObjectsIterator::GetIndex() const
 
 bool AllFieldIterator::operator!=(const AllFieldIterator& Other) const
 {
-	return CurrentObject != Other.CurrentObject || PropertyIndex != Other.PropertyIndex;
+	return CurrentObject != Other.CurrentObject || CurrentProperty != Other.CurrentProperty;
 }
 
 AllFieldIterator& AllFieldIterator::operator++()
 {
-	if (CurrenStructHasMoreMembers())
-	{
-		PropertyIndex++;
-
-		return *this;
-	}
+	++CurrentProperty;
 
-	IterateToNextStructWithMembers();
+	if (!CurrentProperty)
+		IterateToNextStructWithMembers();
 
 	return *this;
 }
 
 UEProperty AllFieldIterator::operator*() const
 {
-	return Fields[PropertyIndex];
+	return *CurrentProperty;
 }
 
 
@@ -625,15 +1202,14 @@ void AllFieldIterator::IterateToNextStruct()
 void AllFieldIterator::IterateToNextStructWithMembers()
 {
 	// Loop, in case we meet a struct wihtout any properties
-	while (!CurrenStructHasMoreMembers())
+	while (!CurrentProperty)
 	{
 		IterateToNextStruct();
-		PropertyIndex = 0;
 
 		if (IsEndIterator())
 			return;
 
-		Fields = GetCurrentStruct().GetProperties();
+		CurrentProperty = GetCurrentStruct().IterateProperties().begin();
 	}
 }
 
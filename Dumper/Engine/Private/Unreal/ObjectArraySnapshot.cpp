@@ -0,0 +1,162 @@
+
+#include <iostream>
+#include <format>
+#include <chrono>
+#include <algorithm>
+
+#include "Unreal/ObjectArraySnapshot.h"
+#include "Unreal/ObjectArray.h"
+
+#include "Settings.h"
+#include "TimeSlicer.h"
+#include "Platform.h"
+
+
+void ObjectArraySnapshot::Build()
+{
+	if (bIsBuilt)
+		return;
+
+	/* Objects created after the columns were sized are only part of the snapshot if they fit into this slack */
+	constexpr int32 NumSlackObjects = 0x4000;
+
+	const int32 Capacity = ObjectArray::Num() + (Settings::General::bFreezeGameForSnapshot ? NumSlackObjects : 0x0);
+
+	/* All memory is allocated up front, FillColumns must not allocate while the game is suspended */
+	Addresses.assign(Capacity, nullptr);
+	ClassIndices.assign(Capacity, -1);
+	OuterIndices.assign(Capacity, -1);
+	PackageIndices.assign(Capacity, -1);
+	NameCompIndices.assign(Capacity, -1);
+	NameNumbers.assign(Capacity, 0);
+	ObjectFlags.assign(Capacity, EObjectFlags::NoFlags);
+	CastFlags.assign(Capacity, EClassCastFlags::None);
+
+	int32 NumObjects = 0x0;
+
+	if constexpr (Settings::General::bFreezeGameForSnapshot)
+	{
+		const auto FreezeStartTime = std::chrono::high_resolution_clock::now();
+
+		Platform::ThreadFreeze Freeze;
+		NumObjects = FillColumns(Capacity, false);
+		const int32 NumSuspendedThreads = Freeze.GetNumSuspendedThreads();
+		Freeze.Resume();
+
+		const std::chrono::duration<double, std::milli> FreezeDuration = std::chrono::high_resolution_clock::now() - FreezeStartTime;
+
+		std::cerr << std::format("Suspended {} game-threads for {:.2f}ms to snapshot {} objects.\n\n", NumSuspendedThreads, FreezeDuration.count(), NumObjects);
+
+		/* Drop the unused slack */
+		Addresses.resize(NumObjects);
+		ClassIndices.resize(NumObjects);
+		OuterIndices.resize(NumObjects);
+		PackageIndices.resize(NumObjects);
+		NameCompIndices.resize(NumObjects);
+		NameNumbers.resize(NumObjects);
+		ObjectFlags.resize(NumObjects);
+		CastFlags.resize(NumObjects);
+	}
+	else
+	{
+		NumObjects = FillColumns(Capacity, true);
+	}
+
+	bIsBuilt = true;
+}
+
+int32 ObjectArraySnapshot::FillColumns(int32 Capacity, bool bMayYield)
+{
+	constexpr int32 ObjectsPerYieldPoint = 0x400;
+
+	const int32 NumObjects = std::min(ObjectArray::Num(), Capacity);
+
+	/* Read all addresses in one specialized loop, instead of dispatching through GetByIndex for every object */
+	ObjectArray::GetAddressesInRange(0, NumObjects, Addresses.data());
+
+	for (int i = 0; i < NumObjects; i++)
+	{
+		if (bMayYield && (i % ObjectsPerYieldPoint) == 0)
+			TimeSlicer::YieldPoint();
+
+		UEObject Obj = Addresses[i];
+
+		if (!Obj)
+			continue;
+
+		const UEClass Class = Obj.GetClass();
+		const UEObject Outer = Obj.GetOuter();
+		const FName Name = Obj.GetFName();
+
+		ClassIndices[i] = Class ? Class.GetIndex() : -1;
+		OuterIndices[i] = Outer ? Outer.GetIndex() : -1;
+		NameCompIndices[i] = Name.GetCompIdx();
+		NameNumbers[i] = Name.GetNumber();
+		ObjectFlags[i] = Obj.GetFlags();
+		CastFlags[i] = Class ? Class.GetCastFlags() : EClassCastFlags::None;
+	}
+
+	/* Resolve packages through the outer-column, every outer-chain is only walked until it hits an already resolved object */
+	for (int i = 0; i < NumObjects; i++)
+	{
+		if (!Addresses[i] || PackageIndices[i] != -1)
+			continue;
+
+		int32 Current = i;
+		int32 Package = -1;
+
+		while (true)
+		{
+			const int32 Outer = OuterIndices[Current];
+
+			if (Outer == -1)
+			{
+				Package = Current;
+				break;
+			}
+
+			/* Outer was created after the snapshot was taken, fall back to the slow path */
+			if (Outer >= NumObjects || !Addresses[Outer])
+			{
+				Package = UEObject(Addresses[i]).GetPackageIndex();
+				break;
+			}
+
+			if (PackageIndices[Outer] != -1)
+			{
+				Package = PackageIndices[Outer];
+				break;
+			}
+
+			Current = Outer;
+		}
+
+		for (int32 Idx = i; Idx != -1 && Idx < NumObjects && PackageIndices[Idx] == -1; Idx = OuterIndices[Idx])
+			PackageIndices[Idx] = Package;
+	}
+
+	return NumObjects;
+}
+
+void ObjectArraySnapshot::Reset()
+{
+	Addresses.clear();
+	ClassIndices.clear();
+	OuterIndices.clear();
+	PackageIndices.clear();
+	NameCompIndices.clear();
+	NameNumbers.clear();
+	ObjectFlags.clear();
+	CastFlags.clear();
+
+	Addresses.shrink_to_fit();
+	ClassIndices.shrink_to_fit();
+	OuterIndices.shrink_to_fit();
+	PackageIndices.shrink_to_fit();
+	NameCompIndices.shrink_to_fit();
+	NameNumbers.shrink_to_fit();
+	ObjectFlags.shrink_to_fit();
+	CastFlags.shrink_to_fit();
+
+	bIsBuilt = false;
+}
@@ -0,0 +1,109 @@
+
+#include <utility>
+
+#include "Unreal/StructHierarchy.h"
+#include "Unreal/ObjectArray.h"
+
+
+void StructHierarchy::Init()
+{
+	if (bIsInitialized)
+		return;
+
+	const int32 NumObjects = ObjectArray::Num();
+
+	/* Children of every struct, stored as one contiguous array with an offset per struct */
+	std::vector<int32> SuperIndices(NumObjects, -1);
+	std::vector<int32> ChildOffsets(NumObjects + 1, 0);
+	std::vector<int32> Children;
+	std::vector<int32> Roots;
+
+	Children.reserve(NumObjects / 4);
+
+	IntervalStarts.assign(NumObjects, -1);
+	IntervalEnds.assign(NumObjects, -1);
+	Depths.assign(NumObjects, 0);
+	OrderedStructs.clear();
+
+	for (UEObject Obj : ObjectArray())
+	{
+		if (!Obj.IsA(EClassCastFlags::Struct))
+			continue;
+
+		const int32 Index = Obj.GetIndex();
+
+		if (Index >= NumObjects)
+			continue;
+
+		const UEStruct Super = Obj.Cast<UEStruct>().GetSuper();
+		const int32 SuperIndex = Super ? Super.GetIndex() : -1;
+
+		if (SuperIndex < 0 || SuperIndex >= NumObjects)
+		{
+			Roots.push_back(Index);
+			continue;
+		}
+
+		SuperIndices[Index] = SuperIndex;
+		ChildOffsets[SuperIndex + 1]++;
+	}
+
+	for (int i = 0; i < NumObjects; i++)
+		ChildOffsets[i + 1] += ChildOffsets[i];
+
+	Children.resize(ChildOffsets[NumObjects]);
+
+	std::vector<int32> InsertPositions(ChildOffsets.begin(), ChildOffsets.end() - 1);
+
+	for (int i = 0; i < NumObjects; i++)
+	{
+		if (SuperIndices[i] != -1)
+			Children[InsertPositions[SuperIndices[i]]++] = i;
+	}
+
+	/* Structs whose Super-chain doesn't end in a root (eg. a cycle in a broken chain) are never reached and keep -1 */
+	OrderedStructs.reserve(Children.size() + Roots.size());
+
+	/* Iterative DFS, pair of <StructIndex, NextChildOffset> */
+	std::vector<std::pair<int32, int32>> Stack;
+
+	for (const int32 Root : Roots)
+	{
+		IntervalStarts[Root] = static_cast<int32>(OrderedStructs.size());
+		OrderedStructs.push_back(Root);
+		Stack.emplace_back(Root, ChildOffsets[Root]);
+
+		while (!Stack.empty())
+		{
+			auto& [Current, NextChild] = Stack.back();
+
+			if (NextChild >= ChildOffsets[Current + 1])
+			{
+				IntervalEnds[Current] = static_cast<int32>(OrderedStructs.size());
+				Stack.pop_back();
+				continue;
+			}
+
+			const int32 Child = Children[NextChild++];
+			const int32 ChildDepth = Depths[Current] + 1;
+
+			IntervalStarts[Child] = static_cast<int32>(OrderedStructs.size());
+			Depths[Child] = ChildDepth;
+			OrderedStructs.push_back(Child);
+
+			Stack.emplace_back(Child, ChildOffsets[Child]);
+		}
+	}
+
+	bIsInitialized = true;
+}
+
+void StructHierarchy::Reset()
+{
+	bIsInitialized = false;
+
+	IntervalStarts.clear();
+	IntervalEnds.clear();
+	Depths.clear();
+	OrderedStructs.clear();
+}
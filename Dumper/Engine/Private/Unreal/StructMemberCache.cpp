@@ -0,0 +1,107 @@
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "Unreal/StructMemberCache.h"
+#include "Unreal/ObjectArray.h"
+
+
+void StructMemberCache::CollectMembers(UEStruct Struct, std::vector<UEProperty>& OutProperties, std::vector<UEFunction>& OutFunctions)
+{
+	const size_t FirstProperty = OutProperties.size();
+
+	for (UEProperty Prop : Struct.IterateProperties())
+		OutProperties.push_back(Prop);
+
+	/* Bitfields share an offset, order them by their bit-index */
+	std::stable_sort(OutProperties.begin() + FirstProperty, OutProperties.end(), [](UEProperty Left, UEProperty Right) -> bool
+	{
+		const int32 LeftOffset = Left.GetOffset();
+		const int32 RightOffset = Right.GetOffset();
+
+		if (LeftOffset == RightOffset && Left.IsA(EClassCastFlags::BoolProperty) && Right.IsA(EClassCastFlags::BoolProperty))
+			return Left.Cast<UEBoolProperty>().GetBitIndex() < Right.Cast<UEBoolProperty>().GetBitIndex();
+
+		return LeftOffset < RightOffset;
+	});
+
+	for (UEField Field = Struct.GetChild(); Field; Field = Field.GetNext())
+	{
+		if (Field.IsA(EClassCastFlags::Function))
+			OutFunctions.push_back(Field.Cast<UEFunction>());
+	}
+}
+
+const StructMemberCache::DetachedMembers& StructMemberCache::GetDetachedMembers(int32 StructIndex)
+{
+	/* Keyed by address, the slot of a struct that is destroyed can be reused by another one. Nodes are never erased, spans into them stay valid. */
+	static thread_local std::unordered_map<const void*, DetachedMembers> MembersByStruct;
+	static thread_local uint32 MembersGeneration = 0x0;
+
+	static const DetachedMembers NoMembers;
+
+	if (MembersGeneration != Generation)
+	{
+		MembersByStruct.clear();
+		MembersGeneration = Generation;
+	}
+
+	const UEObject Obj = StructIndex >= 0 && StructIndex < ObjectArray::Num() ? ObjectArray::GetByIndex(StructIndex) : UEObject(nullptr);
+
+	if (!Obj || !Obj.IsA(EClassCastFlags::Struct))
+		return NoMembers;
+
+	auto [It, bInserted] = MembersByStruct.try_emplace(Obj.GetAddress());
+
+	if (bInserted)
+		CollectMembers(Obj.Cast<UEStruct>(), It->second.Properties, It->second.Functions);
+
+	return It->second;
+}
+
+void StructMemberCache::Init()
+{
+	if (bIsInitialized)
+		return;
+
+	const int32 NumObjects = ObjectArray::Num();
+
+	Ranges.assign(NumObjects, MemberRange{});
+
+	for (UEObject Obj : ObjectArray())
+	{
+		if (!Obj.IsA(EClassCastFlags::Struct))
+			continue;
+
+		const UEStruct Struct = Obj.Cast<UEStruct>();
+		const int32 Index = Obj.GetIndex();
+
+		if (Index >= NumObjects)
+			continue;
+
+		MemberRange& Range = Ranges[Index];
+
+		Range.FirstProperty = static_cast<int32>(Properties.size());
+		Range.FirstFunction = static_cast<int32>(Functions.size());
+
+		CollectMembers(Struct, Properties, Functions);
+
+		Range.NumProperties = static_cast<int32>(Properties.size()) - Range.FirstProperty;
+		Range.NumFunctions = static_cast<int32>(Functions.size()) - Range.FirstFunction;
+	}
+
+	Properties.shrink_to_fit();
+	Functions.shrink_to_fit();
+
+	bIsInitialized = true;
+}
+
+void StructMemberCache::Reset()
+{
+	bIsInitialized = false;
+	Generation++;
+
+	Properties.clear();
+	Functions.clear();
+	Ranges.clear();
+}
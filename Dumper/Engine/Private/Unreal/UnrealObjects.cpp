@@ -1,9 +1,14 @@
 #include <format>
+#include <mutex>
 
 #include "Unreal/UnrealObjects.h"
 #include "Unreal/ObjectArray.h"
+#include "Unreal/StructMemberCache.h"
+#include "Unreal/StructHierarchy.h"
 #include "OffsetFinder/Offsets.h"
 
+#include "Platform.h"
+
 
 void* UEFFieldClass::GetAddress()
 {
@@ -17,22 +22,22 @@ UEFFieldClass::operator bool() const
 
 EFieldClassID UEFFieldClass::GetId() const
 {
-	return *reinterpret_cast<EFieldClassID*>(Class + Off::FFieldClass::Id);
+	return ProcessMemory::Read<EFieldClassID>(Class + Off::FFieldClass::Id);
 }
 
 EClassCastFlags UEFFieldClass::GetCastFlags() const
 {
-	return *reinterpret_cast<EClassCastFlags*>(Class + Off::FFieldClass::CastFlags);
+	return ProcessMemory::Read<EClassCastFlags>(Class + Off::FFieldClass::CastFlags);
 }
 
 EClassFlags UEFFieldClass::GetClassFlags() const
 {
-	return *reinterpret_cast<EClassFlags*>(Class + Off::FFieldClass::ClassFlags);
+	return ProcessMemory::Read<EClassFlags>(Class + Off::FFieldClass::ClassFlags);
 }
 
 UEFFieldClass UEFFieldClass::GetSuper() const
 {
-	return UEFFieldClass(*reinterpret_cast<void**>(Class + Off::FFieldClass::SuperClass));
+	return UEFFieldClass(ProcessMemory::Read<void*>(Class + Off::FFieldClass::SuperClass));
 }
 
 FName UEFFieldClass::GetFName() const
@@ -73,7 +78,7 @@ const void* UEFField::GetAddress() const
 
 EObjectFlags UEFField::GetFlags() const
 {
-	return *reinterpret_cast<EObjectFlags*>(Field + Off::FField::Flags);
+	return ProcessMemory::Read<EObjectFlags>(Field + Off::FField::Flags);
 }
 
 class UEObject UEFField::GetOwnerAsUObject() const
@@ -81,9 +86,9 @@ class UEObject UEFField::GetOwnerAsUObject() const
 	if (IsOwnerUObject())
 	{
 		if (Settings::Internal::bUseMaskForFieldOwner)
-			return (void*)(*reinterpret_cast<uintptr_t*>(Field + Off::FField::Owner) & ~0x1ull);
+			return (void*)(ProcessMemory::Read<uintptr_t>(Field + Off::FField::Owner) & ~0x1ull);
 
-		return *reinterpret_cast<void**>(Field + Off::FField::Owner);
+		return ProcessMemory::Read<void*>(Field + Off::FField::Owner);
 	}
 
 	return nullptr;
@@ -92,7 +97,7 @@ class UEObject UEFField::GetOwnerAsUObject() const
 class UEFField UEFField::GetOwnerAsFField() const
 {
 	if (!IsOwnerUObject())
-		return *reinterpret_cast<void**>(Field + Off::FField::Owner);
+		return ProcessMemory::Read<void*>(Field + Off::FField::Owner);
 
 	return nullptr;
 }
@@ -111,7 +116,7 @@ class UEObject UEFField::GetOwnerUObject() const
 
 UEFFieldClass UEFField::GetClass() const
 {
-	return UEFFieldClass(*reinterpret_cast<void**>(Field + Off::FField::Class));
+	return UEFFieldClass(ProcessMemory::Read<void*>(Field + Off::FField::Class));
 }
 
 FName UEFField::GetFName() const
@@ -121,7 +126,7 @@ FName UEFField::GetFName() const
 
 UEFField UEFField::GetNext() const
 {
-	return UEFField(*reinterpret_cast<void**>(Field + Off::FField::Next));
+	return UEFField(ProcessMemory::Read<void*>(Field + Off::FField::Next));
 }
 
 template<typename UEType>
@@ -134,10 +139,10 @@ bool UEFField::IsOwnerUObject() const
 {
 	if (Settings::Internal::bUseMaskForFieldOwner)
 	{
-		return *reinterpret_cast<uintptr_t*>(Field + Off::FField::Owner) & 0x1;
+		return ProcessMemory::Read<uintptr_t>(Field + Off::FField::Owner) & 0x1;
 	}
 
-	return *reinterpret_cast<bool*>(Field + Off::FField::Owner + 0x8);
+	return ProcessMemory::Read<bool>(Field + Off::FField::Owner + 0x8);
 }
 
 bool UEFField::IsA(EClassCastFlags Flags) const
@@ -208,22 +213,22 @@ const void* UEObject::GetAddress() const
 
 void* UEObject::GetVft() const
 {
-	return *reinterpret_cast<void**>(Object);
+	return ProcessMemory::Read<void*>(Object);
 }
 
 EObjectFlags UEObject::GetFlags() const
 {
-	return *reinterpret_cast<EObjectFlags*>(Object + Off::UObject::Flags);
+	return ProcessMemory::Read<EObjectFlags>(Object + Off::UObject::Flags);
 }
 
 int32 UEObject::GetIndex() const
 {
-	return *reinterpret_cast<int32*>(Object + Off::UObject::Index);
+	return ProcessMemory::Read<int32>(Object + Off::UObject::Index);
 }
 
 UEClass UEObject::GetClass() const
 {
-	return UEClass(*reinterpret_cast<void**>(Object + Off::UObject::Class));
+	return UEClass(ProcessMemory::Read<void*>(Object + Off::UObject::Class));
 }
 
 FName UEObject::GetFName() const
@@ -233,11 +238,19 @@ FName UEObject::GetFName() const
 
 UEObject UEObject::GetOuter() const
 {
-	return UEObject(*reinterpret_cast<void**>(Object + Off::UObject::Outer));
+	return UEObject(ProcessMemory::Read<void*>(Object + Off::UObject::Outer));
 }
 
 int32 UEObject::GetPackageIndex() const
 {
+	if (ObjectArraySnapshot::IsBuilt())
+	{
+		const int32 Index = GetIndex();
+
+		if (Index >= 0 && Index < ObjectArraySnapshot::Num() && ObjectArraySnapshot::GetAddress(Index) == Object)
+			return ObjectArraySnapshot::GetPackageIndex(Index);
+	}
+
 	return GetOutermost().GetIndex();
 }
 
@@ -256,7 +269,12 @@ bool UEObject::IsA(UEClass Class) const
 	if (!Class)
 		return false;
 
-	for (UEClass Clss = GetClass(); Clss; Clss = Clss.GetSuper().Cast<UEClass>())
+	const UEClass OwnClass = GetClass();
+
+	if (OwnClass && StructHierarchy::Contains(OwnClass.GetIndex()) && StructHierarchy::Contains(Class.GetIndex()))
+		return StructHierarchy::HasType(OwnClass.GetIndex(), Class.GetIndex());
+
+	for (UEClass Clss = OwnClass; Clss; Clss = Clss.GetSuper().Cast<UEClass>())
 	{
 		if (Clss == Class)
 			return true;
@@ -327,70 +345,129 @@ std::string UEObject::GetCppName() const
 	return 'F' + Temp;
 }
 
-std::string UEObject::GetFullName(int32& OutNameLength) const
+void UEObject::InitOuterPrefixCache()
 {
-	if (*this)
+	std::unique_lock Lock(OuterPrefixMutex);
+
+	OuterFullNamePrefixes.clear();
+	OuterPathNamePrefixes.clear();
+
+	bIsOuterPrefixCacheEnabled = true;
+}
+
+void UEObject::AppendAsOuterPrefix(std::string& OutBuffer, bool bWithPath) const
+{
+	if (!bIsOuterPrefixCacheEnabled)
 	{
 		std::string Temp;
 
-		for (UEObject Outer = GetOuter(); Outer; Outer = Outer.GetOuter())
+		for (UEObject Outer = *this; Outer; Outer = Outer.GetOuter())
+			Temp = (bWithPath ? Outer.GetNameWithPath() : Outer.GetName()) + '.' + Temp;
+
+		OutBuffer += Temp;
+		return;
+	}
+
+	std::unordered_map<int32, OuterPrefixInfo>& Prefixes = bWithPath ? OuterPathNamePrefixes : OuterFullNamePrefixes;
+
+	const int32 Index = GetIndex();
+
+	{
+		std::shared_lock Lock(OuterPrefixMutex);
+
+		auto It = Prefixes.find(Index);
+
+		/* Compare the address as well, the index could have been reused by a new object */
+		if (It != Prefixes.end() && It->second.Address == Object)
 		{
-			Temp = Outer.GetName() + '.' + Temp;
+			OutBuffer += It->second.Prefix;
+			return;
 		}
+	}
 
-		std::string Name = GetName();
-		OutNameLength = Name.size() + 1;
+	std::string Prefix;
 
-		Name = GetClass().GetName() + ' ' + Temp + Name;
+	if (UEObject Outer = GetOuter())
+		Outer.AppendAsOuterPrefix(Prefix, bWithPath);
 
-		return Name;
-	}
+	Prefix += bWithPath ? GetNameWithPath() : GetName();
+	Prefix += '.';
 
-	return "None";
+	OutBuffer += Prefix;
+
+	std::unique_lock Lock(OuterPrefixMutex);
+	Prefixes.insert_or_assign(Index, OuterPrefixInfo{ Object, std::move(Prefix) });
 }
 
-std::string UEObject::GetFullName() const
+std::string UEObject::GetFullName(int32& OutNameLength) const
 {
 	if (*this)
 	{
-		std::string Temp;
+		std::string Name = GetName();
+		OutNameLength = Name.size() + 1;
 
-		for (UEObject Outer = GetOuter(); Outer; Outer = Outer.GetOuter())
-		{
-			Temp = Outer.GetName() + "." + Temp;
-		}
+		std::string FullName = GetClass().GetName();
+		FullName += ' ';
+
+		if (UEObject Outer = GetOuter())
+			Outer.AppendAsOuterPrefix(FullName, false);
 
-		std::string Name = GetClass().GetName();
-		Name += " ";
-		Name += Temp;
-		Name += GetName();
+		FullName += Name;
 
-		return Name;
+		return FullName;
 	}
 
 	return "None";
 }
 
+std::string UEObject::GetFullName() const
+{
+	std::string Name;
+	GetFullName(Name);
+
+	return Name;
+}
+
 std::string UEObject::GetPathName() const
 {
-	if (*this)
+	std::string Name;
+	GetPathName(Name);
+
+	return Name;
+}
+
+void UEObject::GetFullName(std::string& OutBuffer) const
+{
+	if (!*this)
 	{
-		std::string Temp;
+		OutBuffer += "None";
+		return;
+	}
 
-		for (UEObject Outer = GetOuter(); Outer; Outer = Outer.GetOuter())
-		{
-			Temp = Outer.GetNameWithPath() + "." + Temp;
-		}
+	OutBuffer += GetClass().GetName();
+	OutBuffer += ' ';
 
-		std::string Name = GetClass().GetNameWithPath();
-		Name += " ";
-		Name += Temp;
-		Name += GetNameWithPath();
+	if (UEObject Outer = GetOuter())
+		Outer.AppendAsOuterPrefix(OutBuffer, false);
+
+	OutBuffer += GetName();
+}
 
-		return Name;
+void UEObject::GetPathName(std::string& OutBuffer) const
+{
+	if (!*this)
+	{
+		OutBuffer += "None";
+		return;
 	}
 
-	return "None";
+	OutBuffer += GetClass().GetNameWithPath();
+	OutBuffer += ' ';
+
+	if (UEObject Outer = GetOuter())
+		Outer.AppendAsOuterPrefix(OutBuffer, true);
+
+	OutBuffer += GetNameWithPath();
 }
 
 
@@ -430,7 +507,7 @@ void UEObject::ProcessEvent(UEFunction Func, void* Params)
 
 UEField UEField::GetNext() const
 {
-	return UEField(*reinterpret_cast<void**>(Object + Off::UField::Next));
+	return UEField(ProcessMemory::Read<void*>(Object + Off::UField::Next));
 }
 
 bool UEField::IsNextValid() const
@@ -452,7 +529,7 @@ std::vector<std::pair<FName, int64>> UEEnum::GetNameValuePairs() const
 
 		for (int i = 0; i < EnumNameValuePairs.Num(); i++)
 		{
-			Ret.push_back({ FName(&EnumNameValuePairs[i].First), EnumNameValuePairs[i].Second });
+			Ret.push_back({ FName(&EnumNameValuePairs[i].First), ProcessMemory::Read<ValueType>(&EnumNameValuePairs[i].Second) });
 		}
 
 		return Ret;
@@ -482,20 +559,20 @@ std::vector<std::pair<FName, int64>> UEEnum::GetNameValuePairs() const
 
 		if (Settings::Internal::bUseCasePreservingName)
 		{
-			SetIsNamesOnlyIfDevsTookCrack(*reinterpret_cast<TArray<TPair<Name16Byte, UInt8As64>>*>(Object + Off::UEnum::Names));
+			SetIsNamesOnlyIfDevsTookCrack(ProcessMemory::Read<TArray<TPair<Name16Byte, UInt8As64>>>(Object + Off::UEnum::Names));
 		}
 		else
 		{
-			SetIsNamesOnlyIfDevsTookCrack(*reinterpret_cast<TArray<TPair<Name08Byte, UInt8As64>>*>(Object + Off::UEnum::Names));
+			SetIsNamesOnlyIfDevsTookCrack(ProcessMemory::Read<TArray<TPair<Name08Byte, UInt8As64>>>(Object + Off::UEnum::Names));
 		}
 	}
 
 	if (Settings::Internal::bIsEnumNameOnly)
 	{
 		if (Settings::Internal::bUseCasePreservingName)
-			return GetNameValuePairs(*reinterpret_cast<TArray<Name16Byte>*>(Object + Off::UEnum::Names));
+			return GetNameValuePairs(ProcessMemory::Read<TArray<Name16Byte>>(Object + Off::UEnum::Names));
 
-		return GetNameValuePairs(*reinterpret_cast<TArray<Name08Byte>*>(Object + Off::UEnum::Names));
+		return GetNameValuePairs(ProcessMemory::Read<TArray<Name08Byte>>(Object + Off::UEnum::Names));
 	}
 	else
 	{
@@ -503,15 +580,15 @@ std::vector<std::pair<FName, int64>> UEEnum::GetNameValuePairs() const
 		if (Settings::Internal::bIsSmallEnumValue)
 		{
 			if (Settings::Internal::bUseCasePreservingName)
-				return GetNameValuePairsWithIndex(*reinterpret_cast<TArray<TPair<Name16Byte, UInt8As64>>*>(Object + Off::UEnum::Names));
+				return GetNameValuePairsWithIndex(ProcessMemory::Read<TArray<TPair<Name16Byte, UInt8As64>>>(Object + Off::UEnum::Names));
 
-			return GetNameValuePairsWithIndex(*reinterpret_cast<TArray<TPair<Name08Byte, UInt8As64>>*>(Object + Off::UEnum::Names));
+			return GetNameValuePairsWithIndex(ProcessMemory::Read<TArray<TPair<Name08Byte, UInt8As64>>>(Object + Off::UEnum::Names));
 		}
 
 		if (Settings::Internal::bUseCasePreservingName)
-			return GetNameValuePairsWithIndex(*reinterpret_cast<TArray<TPair<Name16Byte, int64>>*>(Object + Off::UEnum::Names));
+			return GetNameValuePairsWithIndex(ProcessMemory::Read<TArray<TPair<Name16Byte, int64>>>(Object + Off::UEnum::Names));
 
-		return GetNameValuePairsWithIndex(*reinterpret_cast<TArray<TPair<Name08Byte, int64>>*>(Object + Off::UEnum::Names));
+		return GetNameValuePairsWithIndex(ProcessMemory::Read<TArray<TPair<Name08Byte, int64>>>(Object + Off::UEnum::Names));
 	}
 }
 
@@ -534,27 +611,27 @@ std::string UEEnum::GetEnumTypeAsStr() const
 
 UEStruct UEStruct::GetSuper() const
 {
-	return UEStruct(*reinterpret_cast<void**>(Object + Off::UStruct::SuperStruct));
+	return UEStruct(ProcessMemory::Read<void*>(Object + Off::UStruct::SuperStruct));
 }
 
 UEField UEStruct::GetChild() const
 {
-	return UEField(*reinterpret_cast<void**>(Object + Off::UStruct::Children));
+	return UEField(ProcessMemory::Read<void*>(Object + Off::UStruct::Children));
 }
 
 UEFField UEStruct::GetChildProperties() const
 {
-	return UEFField(*reinterpret_cast<void**>(Object + Off::UStruct::ChildProperties));
+	return UEFField(ProcessMemory::Read<void*>(Object + Off::UStruct::ChildProperties));
 }
 
 int16 UEStruct::GetMinAlignment() const
 {
-	return *reinterpret_cast<int16*>(Object + Off::UStruct::MinAlignment);
+	return ProcessMemory::Read<int16>(Object + Off::UStruct::MinAlignment);
 }
 
 int32 UEStruct::GetStructSize() const
 {
-	return *reinterpret_cast<int32*>(Object + Off::UStruct::Size);
+	return ProcessMemory::Read<int32>(Object + Off::UStruct::Size);
 }
 
 bool UEStruct::HasType(UEStruct Type) const
@@ -562,6 +639,9 @@ bool UEStruct::HasType(UEStruct Type) const
 	if (Type == nullptr)
 		return false;
 
+	if (StructHierarchy::Contains(GetIndex()) && StructHierarchy::Contains(Type.GetIndex()))
+		return StructHierarchy::HasType(GetIndex(), Type.GetIndex());
+
 	for (UEStruct S = *this; S; S = S.GetSuper())
 	{
 		if (S == Type)
@@ -571,29 +651,72 @@ bool UEStruct::HasType(UEStruct Type) const
 	return false;
 }
 
-std::vector<UEProperty> UEStruct::GetProperties() const
+UEStruct::PropertyIterator::PropertyIterator(void* FirstField)
+	: CurrentField(FirstField)
 {
-	std::vector<UEProperty> Properties;
+	SkipNonProperties();
+}
+
+UEStruct::PropertyIterator& UEStruct::PropertyIterator::operator++()
+{
+	CurrentField = Settings::Internal::bUseFProperty ? UEFField(CurrentField).GetNext().GetAddress() : UEField(CurrentField).GetNext().GetAddress();
 
+	SkipNonProperties();
+
+	return *this;
+}
+
+UEProperty UEStruct::PropertyIterator::operator*() const
+{
+	return UEProperty(CurrentField);
+}
+
+void UEStruct::PropertyIterator::SkipNonProperties()
+{
 	if (Settings::Internal::bUseFProperty)
 	{
-		for (UEFField Field = GetChildProperties(); Field; Field = Field.GetNext())
+		for (UEFField Field = CurrentField; Field; Field = Field.GetNext())
 		{
 			if (Field.IsA(EClassCastFlags::Property))
-				Properties.push_back(Field.Cast<UEProperty>());
+			{
+				CurrentField = Field.GetAddress();
+				return;
+			}
 		}
-
-		return Properties;
 	}
-	for (UEField Field = GetChild(); Field; Field = Field.GetNext())
+	else
 	{
-		if (Field.IsA(EClassCastFlags::Property))
-			Properties.push_back(Field.Cast<UEProperty>());
+		for (UEField Field = CurrentField; Field; Field = Field.GetNext())
+		{
+			if (Field.IsA(EClassCastFlags::Property))
+			{
+				CurrentField = Field.GetAddress();
+				return;
+			}
+		}
 	}
 
+	CurrentField = nullptr;
+}
+
+std::vector<UEProperty> UEStruct::GetProperties() const
+{
+	std::vector<UEProperty> Properties;
+
+	for (UEProperty Prop : IterateProperties())
+		Properties.push_back(Prop);
+
 	return Properties;
 }
 
+UEStruct::PropertyRange UEStruct::IterateProperties() const
+{
+	if (!Object)
+		return PropertyRange(nullptr);
+
+	return PropertyRange(Settings::Internal::bUseFProperty ? GetChildProperties().GetAddress() : GetChild().GetAddress());
+}
+
 std::vector<UEFunction> UEStruct::GetFunctions() const
 {
 	std::vector<UEFunction> Functions;
@@ -612,6 +735,23 @@ UEProperty UEStruct::FindMember(const std::string& MemberName, EClassCastFlags T
 	if (!Object)
 		return nullptr;
 
+	if (StructMemberCache::Contains(GetIndex()))
+	{
+		for (UEProperty Prop : StructMemberCache::GetProperties(GetIndex()))
+		{
+			if (Prop.IsA(TypeFlags) && Prop.GetName() == MemberName)
+				return Prop;
+		}
+
+		for (UEFunction Func : StructMemberCache::GetFunctions(GetIndex()))
+		{
+			if (Func.IsA(TypeFlags) && Func.GetName() == MemberName)
+				return UEProperty(Func.GetAddress());
+		}
+
+		return nullptr;
+	}
+
 	if (Settings::Internal::bUseFProperty)
 	{
 		for (UEFField Field = GetChildProperties(); Field; Field = Field.GetNext())
@@ -639,29 +779,12 @@ bool UEStruct::HasMembers() const
 	if (!Object)
 		return false;
 
-	if (Settings::Internal::bUseFProperty)
-	{
-		for (UEFField Field = GetChildProperties(); Field; Field = Field.GetNext())
-		{
-			if (Field.IsA(EClassCastFlags::Property))
-				return true;
-		}
-	}
-	else
-	{
-		for (UEField F = GetChild(); F; F = F.GetNext())
-		{
-			if (F.IsA(EClassCastFlags::Property))
-				return true;
-		}
-	}
-
-	return false;
+	return static_cast<bool>(IterateProperties().begin());
 }
 
 EClassCastFlags UEClass::GetCastFlags() const
 {
-	return *reinterpret_cast<EClassCastFlags*>(Object + Off::UClass::CastFlags);
+	return ProcessMemory::Read<EClassCastFlags>(Object + Off::UClass::CastFlags);
 }
 
 std::string UEClass::StringifyCastFlags() const
@@ -676,12 +799,14 @@ bool UEClass::IsType(EClassCastFlags TypeFlag) const
 
 UEObject UEClass::GetDefaultObject() const
 {
-	return UEObject(*reinterpret_cast<void**>(Object + Off::UClass::ClassDefaultObject));
+	return UEObject(ProcessMemory::Read<void*>(Object + Off::UClass::ClassDefaultObject));
 }
 
-TArray<FImplementedInterface> UEClass::GetImplementedInterfaces() const
+std::vector<FImplementedInterface> UEClass::GetImplementedInterfaces() const
 {
-	return *reinterpret_cast<TArray<FImplementedInterface>*>(Object + Off::UClass::ImplementedInterfaces);
+	const TArray<FImplementedInterface> Interfaces = ProcessMemory::Read<TArray<FImplementedInterface>>(Object + Off::UClass::ImplementedInterfaces);
+
+	return ProcessMemory::ReadArray<FImplementedInterface>(Interfaces.GetDataPtr(), Interfaces.Num());
 }
 
 UEFunction UEClass::GetFunction(const std::string& ClassName, const std::string& FuncName) const
@@ -706,7 +831,7 @@ UEFunction UEClass::GetFunction(const std::string& ClassName, const std::string&
 
 EFunctionFlags UEFunction::GetFunctionFlags() const
 {
-	return *reinterpret_cast<EFunctionFlags*>(Object + Off::UFunction::FunctionFlags);
+	return ProcessMemory::Read<EFunctionFlags>(Object + Off::UFunction::FunctionFlags);
 }
 
 bool UEFunction::HasFlags(EFunctionFlags FuncFlags) const
@@ -716,12 +841,23 @@ bool UEFunction::HasFlags(EFunctionFlags FuncFlags) const
 
 void* UEFunction::GetExecFunction() const
 {
-	return *reinterpret_cast<void**>(Object + Off::UFunction::ExecFunction);
+	return ProcessMemory::Read<void*>(Object + Off::UFunction::ExecFunction);
 }
 
 UEProperty UEFunction::GetReturnProperty() const
 {
-	for (auto Prop : GetProperties())
+	if (StructMemberCache::Contains(GetIndex()))
+	{
+		for (UEProperty Prop : StructMemberCache::GetProperties(GetIndex()))
+		{
+			if (Prop.HasPropertyFlags(EPropertyFlags::ReturnParm))
+				return Prop;
+		}
+
+		return nullptr;
+	}
+
+	for (UEProperty Prop : IterateProperties())
 	{
 		if (Prop.HasPropertyFlags(EPropertyFlags::ReturnParm))
 			return Prop;
@@ -793,24 +929,24 @@ FName UEProperty::GetFName() const
 int32 UEProperty::GetArrayDim() const
 {
 	if (Settings::Internal::bUseUint8ArrayDim)
-		return *reinterpret_cast<uint8*>(Base + Off::Property::ArrayDim);
+		return ProcessMemory::Read<uint8>(Base + Off::Property::ArrayDim);
 
-	return *reinterpret_cast<int32*>(Base + Off::Property::ArrayDim);
+	return ProcessMemory::Read<int32>(Base + Off::Property::ArrayDim);
 }
 
 int32 UEProperty::GetSize() const
 {
-	return *reinterpret_cast<int32*>(Base + Off::Property::ElementSize);
+	return ProcessMemory::Read<int32>(Base + Off::Property::ElementSize);
 }
 
 int32 UEProperty::GetOffset() const
 {
-	return *reinterpret_cast<int32*>(Base + Off::Property::Offset_Internal);
+	return ProcessMemory::Read<int32>(Base + Off::Property::Offset_Internal);
 }
 
 EPropertyFlags UEProperty::GetPropertyFlags() const
 {
-	return *reinterpret_cast<EPropertyFlags*>(Base + Off::Property::PropertyFlags);
+	return ProcessMemory::Read<EPropertyFlags>(Base + Off::Property::PropertyFlags);
 }
 
 bool UEProperty::HasPropertyFlags(EPropertyFlags PropertyFlag) const
@@ -973,6 +1109,7 @@ int32 UEProperty::GetAlignment() const
 	if (Settings::Internal::bUseFProperty)
 	{
 		static std::unordered_map<void*, int32> UnknownProperties;
+		static std::mutex UnknownPropertiesLock;
 
 		static auto TryFindPropertyRefInOptionalToGetAlignment = [](std::unordered_map<void*, int32>& OutProperties, void* PropertyClass) -> int32
 		{
@@ -998,6 +1135,9 @@ int32 UEProperty::GetAlignment() const
 			return OutProperties.insert({ PropertyClass, 0x1 }).first->second;
 		};
 
+		/* Alignments are queried by multiple threads while generating packages */
+		std::scoped_lock Lock(UnknownPropertiesLock);
+
 		auto It = UnknownProperties.find(GetClass().second.GetAddress());
 
 		/* Safe to use first member, as we're guaranteed to use FProperty */
@@ -1151,7 +1291,7 @@ std::string UEProperty::StringifyFlags() const
 
 UEEnum UEByteProperty::GetEnum() const
 {
-	return UEEnum(*reinterpret_cast<void**>(Base + Off::ByteProperty::Enum));
+	return UEEnum(ProcessMemory::Read<void*>(Base + Off::ByteProperty::Enum));
 }
 
 std::string UEByteProperty::GetCppType() const
@@ -1166,12 +1306,12 @@ std::string UEByteProperty::GetCppType() const
 
 uint8 UEBoolProperty::GetFieldMask() const
 {
-	return reinterpret_cast<Off::BoolProperty::UBoolPropertyBase*>(Base + Off::BoolProperty::Base)->FieldMask;
+	return ProcessMemory::Read<Off::BoolProperty::UBoolPropertyBase>(Base + Off::BoolProperty::Base).FieldMask;
 }
 
 uint8 UEBoolProperty::GetByteOffset() const
 {
-	return reinterpret_cast<Off::BoolProperty::UBoolPropertyBase*>(Base + Off::BoolProperty::Base)->ByteOffset;
+	return ProcessMemory::Read<Off::BoolProperty::UBoolPropertyBase>(Base + Off::BoolProperty::Base).ByteOffset;
 }
 
 uint8 UEBoolProperty::GetBitIndex() const
@@ -1197,7 +1337,7 @@ uint8 UEBoolProperty::GetBitIndex() const
 
 bool UEBoolProperty::IsNativeBool() const
 {
-	return reinterpret_cast<Off::BoolProperty::UBoolPropertyBase*>(Base + Off::BoolProperty::Base)->FieldMask == 0xFF;
+	return ProcessMemory::Read<Off::BoolProperty::UBoolPropertyBase>(Base + Off::BoolProperty::Base).FieldMask == 0xFF;
 }
 
 std::string UEBoolProperty::GetCppType() const
@@ -1207,7 +1347,7 @@ std::string UEBoolProperty::GetCppType() const
 
 UEClass UEObjectProperty::GetPropertyClass() const
 {
-	return UEClass(*reinterpret_cast<void**>(Base + Off::ObjectProperty::PropertyClass));
+	return UEClass(ProcessMemory::Read<void*>(Base + Off::ObjectProperty::PropertyClass));
 }
 
 std::string UEObjectProperty::GetCppType() const
@@ -1217,7 +1357,7 @@ std::string UEObjectProperty::GetCppType() const
 
 UEClass UEClassProperty::GetMetaClass() const
 {
-	return UEClass(*reinterpret_cast<void**>(Base + Off::ClassProperty::MetaClass));
+	return UEClass(ProcessMemory::Read<void*>(Base + Off::ClassProperty::MetaClass));
 }
 
 std::string UEClassProperty::GetCppType() const
@@ -1252,7 +1392,7 @@ std::string UEInterfaceProperty::GetCppType() const
 
 UEStruct UEStructProperty::GetUnderlayingStruct() const
 {
-	return UEStruct(*reinterpret_cast<void**>(Base + Off::StructProperty::Struct));
+	return UEStruct(ProcessMemory::Read<void*>(Base + Off::StructProperty::Struct));
 }
 
 std::string UEStructProperty::GetCppType() const
@@ -1262,7 +1402,7 @@ std::string UEStructProperty::GetCppType() const
 
 UEProperty UEArrayProperty::GetInnerProperty() const
 {
-	return UEProperty(*reinterpret_cast<void**>(Base + Off::ArrayProperty::Inner));
+	return UEProperty(ProcessMemory::Read<void*>(Base + Off::ArrayProperty::Inner));
 }
 
 std::string UEArrayProperty::GetCppType() const
@@ -1272,7 +1412,7 @@ std::string UEArrayProperty::GetCppType() const
 
 UEFunction UEDelegateProperty::GetSignatureFunction() const
 {
-	return UEFunction(*reinterpret_cast<void**>(Base + Off::DelegateProperty::SignatureFunction));
+	return UEFunction(ProcessMemory::Read<void*>(Base + Off::DelegateProperty::SignatureFunction));
 }
 
 std::string UEDelegateProperty::GetCppType() const
@@ -1283,7 +1423,7 @@ std::string UEDelegateProperty::GetCppType() const
 UEFunction UEMulticastInlineDelegateProperty::GetSignatureFunction() const
 {
 	// Uses "Off::DelegateProperty::SignatureFunction" on purpose
-	return UEFunction(*reinterpret_cast<void**>(Base + Off::DelegateProperty::SignatureFunction));
+	return UEFunction(ProcessMemory::Read<void*>(Base + Off::DelegateProperty::SignatureFunction));
 }
 
 std::string UEMulticastInlineDelegateProperty::GetCppType() const
@@ -1293,12 +1433,12 @@ std::string UEMulticastInlineDelegateProperty::GetCppType() const
 
 UEProperty UEMapProperty::GetKeyProperty() const
 {
-	return UEProperty(reinterpret_cast<Off::MapProperty::UMapPropertyBase*>(Base + Off::MapProperty::Base)->KeyProperty);
+	return UEProperty(ProcessMemory::Read<Off::MapProperty::UMapPropertyBase>(Base + Off::MapProperty::Base).KeyProperty);
 }
 
 UEProperty UEMapProperty::GetValueProperty() const
 {
-	return UEProperty(reinterpret_cast<Off::MapProperty::UMapPropertyBase*>(Base + Off::MapProperty::Base)->ValueProperty);
+	return UEProperty(ProcessMemory::Read<Off::MapProperty::UMapPropertyBase>(Base + Off::MapProperty::Base).ValueProperty);
 }
 
 std::string UEMapProperty::GetCppType() const
@@ -1308,7 +1448,7 @@ std::string UEMapProperty::GetCppType() const
 
 UEProperty UESetProperty::GetElementProperty() const
 {
-	return UEProperty(*reinterpret_cast<void**>(Base + Off::SetProperty::ElementProp));
+	return UEProperty(ProcessMemory::Read<void*>(Base + Off::SetProperty::ElementProp));
 }
 
 std::string UESetProperty::GetCppType() const
@@ -1318,12 +1458,12 @@ std::string UESetProperty::GetCppType() const
 
 UEProperty UEEnumProperty::GetUnderlayingProperty() const
 {
-	return UEProperty(reinterpret_cast<Off::EnumProperty::UEnumPropertyBase*>(Base + Off::EnumProperty::Base)->UnderlayingProperty);
+	return UEProperty(ProcessMemory::Read<Off::EnumProperty::UEnumPropertyBase>(Base + Off::EnumProperty::Base).UnderlayingProperty);
 }
 
 UEEnum UEEnumProperty::GetEnum() const
 {
-	return UEEnum(reinterpret_cast<Off::EnumProperty::UEnumPropertyBase*>(Base + Off::EnumProperty::Base)->Enum);
+	return UEEnum(ProcessMemory::Read<Off::EnumProperty::UEnumPropertyBase>(Base + Off::EnumProperty::Base).Enum);
 }
 
 std::string UEEnumProperty::GetCppType() const
@@ -1336,7 +1476,7 @@ std::string UEEnumProperty::GetCppType() const
 
 UEFFieldClass UEFieldPathProperty::GetFieldClass() const
 {
-	return UEFFieldClass(*reinterpret_cast<void**>(Base + Off::FieldPathProperty::FieldClass));
+	return UEFFieldClass(ProcessMemory::Read<void*>(Base + Off::FieldPathProperty::FieldClass));
 }
 
 std::string UEFieldPathProperty::GetCppType() const
@@ -1346,7 +1486,7 @@ std::string UEFieldPathProperty::GetCppType() const
 
 UEProperty UEOptionalProperty::GetValueProperty() const
 {
-	return UEProperty(*reinterpret_cast<void**>(Base + Off::OptionalProperty::ValueProperty));
+	return UEProperty(ProcessMemory::Read<void*>(Base + Off::OptionalProperty::ValueProperty));
 }
 
 std::string UEOptionalProperty::GetCppType() const
@@ -3,10 +3,12 @@
 
 #include "Unreal/UnrealTypes.h"
 #include "Unreal/NameArray.h"
+#include "Profiler.h"
 
 #include "Encoding/UnicodeNames.h"
 
 #include "Architecture.h"
+#include "Platform.h"
 
 
 std::string MakeNameValid(std::wstring&& Name)
@@ -290,11 +292,149 @@ std::wstring FName::ToWString() const
 	return OutputString.substr(pos + 1);
 }
 
+void FName::PostInit()
+{
+	std::unique_lock Lock(NameCacheMutex);
+
+	NameCachePages.clear();
+	CachedRawNames.clear();
+
+	NameCacheHits = 0;
+	NameCacheMisses = 0;
+
+	/* With case-preserving names the CompIdx doesn't identify the display-string of a name, "Color" and "color" share one CompIdx */
+	bIsNameCacheEnabled = !Settings::Internal::bUseCasePreservingName;
+
+	/* The FName-copies in GetCachedRawBaseString() are local memory, names of an external process are always decoded through GNames */
+	if (!Settings::General::bUseNativeNameDecoding && !ProcessMemory::IsExternal())
+		return;
+
+	/* Names are already decoded through GNames, if NameArray was initialized during FName::Init() */
+	if (!NameArray::IsInitialized())
+	{
+		if (!NameArray::TryCommitGNames())
+		{
+			std::cerr << "Native name decoding is unavailable, GNames could not be initialized. Using AppendString.\n\n";
+			return;
+		}
+
+		/* Only the dumper decodes names through GNames from here on, the SDK still uses AppendString */
+		ToStr = [](const void* Name) -> std::wstring
+		{
+			if (!Settings::Internal::bUseOutlineNumberName)
+			{
+				const uint32 Number = FName(Name).GetNumber();
+
+				if (Number > 0)
+					return NameArray::GetNameEntry(Name).GetWString() + L'_' + std::to_wstring(Number - 1);
+			}
+
+			return NameArray::GetNameEntry(Name).GetWString();
+		};
+	}
+
+	bIsUsingNativeNameDecoding = true;
+
+	if (!bIsNameCacheEnabled)
+		return;
+
+	/* Fill the cache with every name in FNamePool in one sequential pass */
+	const bool bDecodedNamePool = NameArray::IterateNamePool([](int32 ComparisonIndex, std::string&& Name)
+	{
+		const uint32 PageIdx = static_cast<uint32>(ComparisonIndex) >> NameCachePageBits;
+		const uint32 InPageIdx = static_cast<uint32>(ComparisonIndex) & (NameCachePageSize - 1);
+
+		if (PageIdx >= NameCachePages.size())
+			NameCachePages.resize(PageIdx + 1);
+
+		if (!NameCachePages[PageIdx])
+			NameCachePages[PageIdx] = std::make_unique<uint32[]>(NameCachePageSize);
+
+		CachedRawNames.push_back(std::move(Name));
+		NameCachePages[PageIdx][InPageIdx] = static_cast<uint32>(CachedRawNames.size());
+	});
+
+	if (bDecodedNamePool)
+		std::cerr << std::format("Decoded {} names from FNamePool.\n\n", CachedRawNames.size());
+}
+
+std::string FName::GetCachedRawBaseString() const
+{
+	const uint32 CompIdx = static_cast<uint32>(GetCompIdx());
+
+	const uint32 PageIdx = CompIdx >> NameCachePageBits;
+	const uint32 InPageIdx = CompIdx & (NameCachePageSize - 1);
+
+	{
+		std::shared_lock Lock(NameCacheMutex);
+
+		if (PageIdx < NameCachePages.size() && NameCachePages[PageIdx] && NameCachePages[PageIdx][InPageIdx] != 0)
+		{
+			NameCacheHits++;
+			return CachedRawNames[NameCachePages[PageIdx][InPageIdx] - 1];
+		}
+	}
+
+	std::string BaseString;
+
+	if (bIsUsingNativeNameDecoding)
+	{
+		BaseString = NameArray::GetNameEntry(static_cast<int32>(CompIdx)).GetString();
+	}
+	else
+	{
+		/* Resolve a copy of this name with the 'Number' component set to zero, so only the base-string is cached */
+		uint8 NameWithoutNumber[0x10] = { 0x0 };
+		ProcessMemory::ReadRaw(reinterpret_cast<uintptr_t>(Address), NameWithoutNumber, std::min<size_t>(Off::InSDK::Name::FNameSize, sizeof(NameWithoutNumber)));
+
+		if (!Settings::Internal::bUseOutlineNumberName)
+			*reinterpret_cast<uint32*>(NameWithoutNumber + Off::FName::Number) = 0x0;
+
+		BaseString = UtfN::WStringToString(ToStr(NameWithoutNumber));
+	}
+
+	std::unique_lock Lock(NameCacheMutex);
+
+	NameCacheMisses++;
+
+	if (PageIdx >= NameCachePages.size())
+		NameCachePages.resize(PageIdx + 1);
+
+	if (!NameCachePages[PageIdx])
+		NameCachePages[PageIdx] = std::make_unique<uint32[]>(NameCachePageSize);
+
+	uint32& Slot = NameCachePages[PageIdx][InPageIdx];
+
+	/* Another thread might have resolved this name while we didn't hold the lock */
+	if (Slot == 0)
+	{
+		CachedRawNames.push_back(std::move(BaseString));
+		Slot = static_cast<uint32>(CachedRawNames.size());
+	}
+
+	return CachedRawNames[Slot - 1];
+}
+
+std::string FName::AppendNumberSuffix(std::string&& BaseString) const
+{
+	const uint32 Number = GetNumber();
+
+	if (Number > 0)
+		BaseString += '_' + std::to_string(Number - 1);
+
+	return BaseString;
+}
+
 std::string FName::ToRawString() const
 {
 	if (!Address)
 		return "None";
 
+	Profiler::AddCount(EProfilerCounter::NamesResolved);
+
+	if (bIsNameCacheEnabled)
+		return AppendNumberSuffix(GetCachedRawBaseString());
+
 	return UtfN::WStringToString(ToRawWString());
 }
 
@@ -303,6 +443,20 @@ std::string FName::ToString() const
 	if (!Address)
 		return "None";
 
+	Profiler::AddCount(EProfilerCounter::NamesResolved);
+
+	if (bIsNameCacheEnabled)
+	{
+		std::string RawBaseString = GetCachedRawBaseString();
+
+		const size_t Pos = RawBaseString.rfind('/');
+
+		if (Pos != std::string::npos)
+			RawBaseString.erase(0, Pos + 1);
+
+		return AppendNumberSuffix(std::move(RawBaseString));
+	}
+
 	return UtfN::WStringToString(ToWString());
 }
 
@@ -313,7 +467,7 @@ std::string FName::ToValidString() const
 
 int32 FName::GetCompIdx() const 
 {
-	return *reinterpret_cast<const int32*>(Address + Off::FName::CompIdx);
+	return ProcessMemory::Read<int32>(Address + Off::FName::CompIdx);
 }
 
 uint32 FName::GetNumber() const
@@ -322,9 +476,9 @@ uint32 FName::GetNumber() const
 		return 0x0;
 
 	if (Settings::Internal::bUseNamePool)
-		return *reinterpret_cast<const uint32*>(Address + Off::FName::Number); // The number is uint32 on versions <= UE4.23 
+		return ProcessMemory::Read<uint32>(Address + Off::FName::Number); // The number is uint32 on versions <= UE4.23 
 
-	return static_cast<uint32_t>(*reinterpret_cast<const int32*>(Address + Off::FName::Number));
+	return static_cast<uint32_t>(ProcessMemory::Read<int32>(Address + Off::FName::Number));
 }
 
 bool FName::operator==(FName Other) const
@@ -365,3 +519,12 @@ void* FName::DEBUGGetAppendString()
 {
 	return (void*)(AppendString);
 }
+
+void FName::DEBUGPrintNameCacheStats()
+{
+	const uint64 Hits = NameCacheHits;
+	const uint64 Misses = NameCacheMisses;
+	const uint64 TotalLookups = Hits + Misses;
+
+	std::cerr << std::format("FName-Cache: {} names cached, {} hits, {} misses, hit-rate: {:.2f}%\n", CachedRawNames.size(), Hits, Misses, TotalLookups > 0 ? (Hits * 100.0 / TotalLookups) : 0.0);
+}
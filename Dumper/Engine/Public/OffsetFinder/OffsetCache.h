@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+
+#include "Unreal/Enums.h"
+#include "Platform.h"
+
+/*
+* Stores the results of the expensive scans (GObjects, FName::AppendString/GNames, ProcessEvent and GWorld) on disk.
+*
+* Entries are keyed by the fingerprint of the games main module, so a rebuilt game never reuses stale offsets.
+* Every cached value is validated before it's used, each TryInit* function returns false if the regular discovery needs to run instead.
+*/
+namespace OffsetCache
+{
+	/* Dumper-7-Offsets.ini, next to the Dumper-7.ini that is used by Settings::Config::Load() */
+	std::string GetCachePath();
+
+	/* Reads the entry for the current build of the main module. Returns false if there is no entry. */
+	bool Load();
+	bool IsLoaded();
+
+	/* Reads the entry of the process attached through ProcessMemory, it must contain GObjects and GNames. Names are always read from GNames. */
+	bool LoadForExternalProcess();
+
+	bool TryInitObjectArray();
+	bool TryInitFName();
+	bool TryInitProcessEvent();
+	bool TryInitGWorld();
+
+	/* Writes all offsets that were found during this run to the entry of the current build */
+	void Save();
+
+	/* Removes the entry of the current build, the next run does a full discovery */
+	void Invalidate();
+
+	/* All offsets found during this run, including the ones that are never written to the ini-file, to be stored in a MemorySnapshot */
+	MemorySnapshot::PropertyList GetSnapshotProperties();
+
+	/* Uses the offsets stored in a replayed MemorySnapshot instead of the ini-file, names are always read from GNames */
+	bool LoadFromSnapshot(const MemorySnapshot::PropertyList& Properties);
+
+	/* Only succeeds for offsets loaded from a MemorySnapshot, Off::InSDK::Text::InitTextOffsets() calls ProcessEvent */
+	bool TryInitTextOffsets();
+}
@@ -27,7 +27,7 @@ namespace OffsetFinder
 
 			for (int j = HighestFoundOffset; j < MaxOffset; j += Alignement)
 			{
-				const T TypedValueAtOffset = *reinterpret_cast<T*>(static_cast<uint8_t*>(ObjectValuePair[i].first) + j);
+				const T TypedValueAtOffset = ProcessMemory::Read<T>(static_cast<uint8_t*>(ObjectValuePair[i].first) + j);
 
 				if (TypedValueAtOffset == ObjectValuePair[i].second && j >= HighestFoundOffset)
 				{
@@ -58,12 +58,15 @@ namespace OffsetFinder
 
 		for (int j = StartingOffset; j <= MaxOffset; j += sizeof(void*))
 		{
-			const bool bIsAValid = !Platform::IsBadReadPtr(*reinterpret_cast<void* const*>(ObjA + j)) && (bCheckForVft ? !Platform::IsBadReadPtr(**reinterpret_cast<void** const*>(ObjA + j)) : true);
-			const bool bIsBValid = !Platform::IsBadReadPtr(*reinterpret_cast<void* const*>(ObjB + j)) && (bCheckForVft ? !Platform::IsBadReadPtr(**reinterpret_cast<void** const*>(ObjB + j)) : true);
+			const void* PtrA = ProcessMemory::Read<void*>(ObjA + j);
+			const void* PtrB = ProcessMemory::Read<void*>(ObjB + j);
+
+			const bool bIsAValid = !Platform::IsBadReadPtr(PtrA) && (bCheckForVft ? !Platform::IsBadReadPtr(ProcessMemory::Read<void*>(PtrA)) : true);
+			const bool bIsBValid = !Platform::IsBadReadPtr(PtrB) && (bCheckForVft ? !Platform::IsBadReadPtr(ProcessMemory::Read<void*>(PtrB)) : true);
 
 			if (bNeedsToBeInProcessMemory)
 			{
-				if (!Platform::IsAddressInProcessRange(*reinterpret_cast<void* const*>(ObjA + j)) || !Platform::IsAddressInProcessRange(*reinterpret_cast<void* const*>(ObjB + j)))
+				if (!Platform::IsAddressInProcessRange(PtrA) || !Platform::IsAddressInProcessRange(PtrB))
 					continue;
 			}
 
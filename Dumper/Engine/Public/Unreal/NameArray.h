@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+
 #include "Unreal/UnrealTypes.h"
 
 class FNameEntry
@@ -15,6 +17,9 @@ private:
 
 	static inline std::wstring(*GetStr)(uint8* NameEntry) = nullptr;
 
+	/* Decodes the entry to UTF-8 directly, without converting to std::wstring first */
+	static inline std::string(*GetUtf8Str)(uint8* NameEntry) = nullptr;
+
 private:
 	uint8* Address;
 
@@ -31,6 +36,9 @@ public:
 private:
 	//Optional to avoid code duplication for FNamePool
 	static void Init(const uint8_t* FirstChunkPtr = nullptr, int64 NameEntryStringOffset = 0x0);
+
+	/* Converts UTF-16 to UTF-8, strings which are entirely ASCII are narrowed in a simple (auto-vectorizable) loop */
+	static std::string WideToUtf8(const wchar_t* Str, int32 Length);
 };
 
 class NameArray
@@ -61,6 +69,14 @@ public:
 	static bool SetGNamesWithoutCommiting();
 
 	static void PostInit();
+
+	/* Initializes GNames from the offset found by SetGNamesWithoutCommiting(), to decode names without calling the games AppendString function */
+	static bool TryCommitGNames();
+
+	static inline bool IsInitialized()
+	{
+		return GNames != nullptr;
+	}
 	
 public:
 	static int32 GetNumChunks();
@@ -70,4 +86,12 @@ public:
 
 	static FNameEntry GetNameEntry(const void* Name);
 	static FNameEntry GetNameEntry(int32 Idx);
+
+	/*
+	* Walks all blocks of FNamePool sequentially, up to the current ByteCursor, and calls 'Callback' with the ComparisonIndex and UTF-8 string of every entry.
+	* Entries of FNAME_OUTLINE_NUMBER names (which only reference another entry) are skipped.
+	* 
+	* Returns false if GNames isn't an initialized FNamePool.
+	*/
+	static bool IterateNamePool(const std::function<void(int32 ComparisonIndex, std::string&& Name)>& Callback);
 };
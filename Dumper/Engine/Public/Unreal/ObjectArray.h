@@ -2,13 +2,76 @@
 
 #include <string>
 #include <vector>
+#include <shared_mutex>
+#include <unordered_map>
 #include <filesystem>
 
 #include "Unreal/UnrealObjects.h"
+#include "Unreal/ObjectArraySnapshot.h"
 #include "OffsetFinder/Offsets.h"
 
 namespace fs = std::filesystem;
 
+/*
+* Layout of GObjects-Dump.bin, written by ObjectArray::DumpObjectsBinary and published by SharedMemoryExport. The file is meant to be memory-mapped, all offsets are relative to the start of the file.
+* 
+* [FileHeader][ObjectRecord * NumObjects][PropertyRecord * NumProperties][StringBlob]
+* 
+* ObjectRecords are indexed by the objects index in GObjects, empty slots have an Address of 0. Strings in the blob are deduplicated and null-terminated.
+*/
+namespace BinaryObjectDump
+{
+	inline constexpr char Magic[8] = { 'D', '7', 'O', 'B', 'J', 'D', 'M', 'P' };
+	inline constexpr uint32 Version = 1;
+
+#pragma pack(push, 0x1)
+	struct FileHeader
+	{
+		char Magic[8];
+		uint32 Version;
+		uint32 HeaderSize;
+
+		uint32 NumObjects;
+		uint32 ObjectRecordSize;
+		uint64 ObjectTableOffset;
+
+		uint32 NumProperties;
+		uint32 PropertyRecordSize;
+		uint64 PropertyTableOffset;
+
+		uint64 StringBlobOffset;
+		uint64 StringBlobSize;
+	};
+
+	struct ObjectRecord
+	{
+		uint64 Address;
+		int32 Index;
+		int32 ClassIndex;
+		int32 OuterIndex;
+		uint32 NameOffset;
+		uint32 NameLength;
+		uint32 Flags;
+		uint64 CastFlags;
+
+		/* Range in the property table, only set for structs */
+		uint32 FirstProperty;
+		uint32 NumProperties;
+	};
+
+	struct PropertyRecord
+	{
+		uint64 Address;
+		int32 Offset;
+		int32 Size;
+		uint32 NameOffset;
+		uint32 NameLength;
+		uint32 TypeNameOffset;
+		uint32 TypeNameLength;
+	};
+#pragma pack(pop)
+}
+
 class ObjectArray
 {
 private:
@@ -29,12 +92,54 @@ public:
 	static inline std::string DecryptionLambdaStr;
 
 private:
-	static inline void*(*ByIndex)(void* ObjectsArray, int32 Index, uint32 FUObjectItemSize, uint32 FUObjectItemOffset, uint32 PerChunk) = nullptr;
+	/* Accessors specialized for the layout of GObjects, selected once by SelectAccessors */
+	static inline void*(*ByIndex)(int32 Index) = nullptr;
+	static inline void(*ReadRange)(int32 First, int32 Count, void** OutAddresses) = nullptr;
 
 	static inline uint8_t* (*DecryptPtr)(void* ObjPtr) = [](void* Ptr) -> uint8* { return static_cast<uint8*>(Ptr); };
+	static inline bool bIsDecryptionEnabled = false;
+
+private:
+	using LookupTableType = std::unordered_map<std::string, std::vector<int32>>;
+
+	/* Name -> Indices of all objects with this name. Built lazily on the first lookup and rebuilt whenever Num() changes. */
+	static inline LookupTableType NameLookupTable;
+	static inline int32 NameLookupTableNum = -1;
+
+	/* FullName -> Indices of all objects with this full name. Built lazily and rebuilt whenever Num() changes. */
+	static inline LookupTableType FullNameLookupTable;
+	static inline int32 FullNameLookupTableNum = -1;
+
+	/* The managers look objects up from several threads at once, while GObjects keeps growing. Lookups share the lock, extending a table is exclusive. */
+	static inline std::shared_mutex NameLookupTableLock;
+	static inline std::shared_mutex FullNameLookupTableLock;
+
+	/* Lookup tables are only used after PostInit(), while Off::Init() is running the name and outer offsets are not final yet */
+	static inline bool bAllowLookupTables = false;
 
 private:
+	template<bool bIsChunked, bool bIsEncrypted, uint32 StaticItemSize>
+	static void* GetAddressByIndexImpl(int32 Index);
+
+	template<bool bIsChunked, bool bIsEncrypted, uint32 StaticItemSize>
+	static void ReadAddressesImpl(int32 First, int32 Count, void** OutAddresses);
+
+	template<bool bIsChunked, bool bIsEncrypted>
+	static void SelectAccessorsForItemSize();
+
+	/* Picks the accessor-instantiations matching the current layout, item-size and decryption. Called whenever one of those changes. */
+	static void SelectAccessors();
+
 	static void InitializeFUObjectItem(uint8_t* FirstItemPtr);
+	static void InitFromAddress(void* GObjectsAddress, bool bIsChunked);
+
+	/* Copies of the indices, a table may be extended by another thread as soon as its lock is released */
+	static std::vector<int32> FindIndicesByName(const std::string& Name);
+	static std::vector<int32> FindIndicesByFullName(const std::string& FullName);
+
+	/* Iteration reads from ObjectArraySnapshot, if it was built */
+	static int32 GetIterationNum();
+	static UEObject GetIterationObject(int32 Index);
 
 public:
 	static void InitDecryption(uint8_t* (*DecryptionFunction)(void* ObjPtr), const char* DecryptionLambdaAsStr);
@@ -44,8 +149,25 @@ public:
 	static void Init(int32 GObjectsOffset, const FFixedUObjectArrayLayout& ObjectArrayLayout = FFixedUObjectArrayLayout(), const char* const ModuleName = nullptr);
 	static void Init(int32 GObjectsOffset, int32 ElementsPerChunk, const FChunkedFixedUObjectArrayLayout& ObjectArrayLayout = FChunkedFixedUObjectArrayLayout(), const char* const ModuleName = nullptr);
 
+	/* Initializes GObjects from a previously found offset and layout. Returns false if the address doesn't pass the validation used while scanning. */
+	static bool TryInit(int32 GObjectsOffset, bool bIsChunked, const FFixedUObjectArrayLayout& FixedLayout, const FChunkedFixedUObjectArrayLayout& ChunkedLayout, const char* const ModuleName = nullptr);
+
+	/* Enables the name lookup tables used by FindObject and FindObjectFast. Must be called after Off::Init(). */
+	static void PostInit();
+
+	/* Drops the name lookup tables, the next lookup rebuilds them. Required once the game might have reused slots that were indexed already. */
+	static void ResetLookupTables();
+
+	/* Memory used by the name lookup tables, these grow with GObjects until ResetLookupTables() is called */
+	static MemoryReport GetLookupTablesMemoryReport();
+
 	static void DumpObjects(const fs::path& Path, bool bWithPathname = false);
 	static void DumpObjectsWithProperties(const fs::path& Path, bool bWithPathname = false);
+	static void DumpObjectsBinary(const fs::path& Path);
+	static void DumpObjectsBinary(const fs::path& Path, const std::string& SerializedObjects);
+
+	/* Contents of GObjects-Dump.bin, see BinaryObjectDump */
+	static std::string SerializeObjectsBinary();
 
 	static int32 Num();
 	static int32 Max();
@@ -55,6 +177,9 @@ public:
 	template<typename UEType = UEObject>
 	static UEType GetByIndex(int32 Index);
 
+	/* Reads the addresses of the objects [First, First + Count) into OutAddresses, nullptr for empty or out-of-range slots. Much faster than calling GetByIndex for every index. */
+	static void GetAddressesInRange(int32 First, int32 Count, void** OutAddresses);
+
 	template<typename UEType = UEObject>
 	static UEType FindObject(const std::string& FullName, EClassCastFlags RequiredType = EClassCastFlags::None);
 
@@ -70,11 +195,28 @@ public:
 	static UEClass FindClass(const std::string& FullName);
 	static UEClass FindClassFast(const std::string& Name);
 
+	/*
+	* Iterates all non-null objects. Addresses are read a block at a time through GetAddressesInRange, which resolves the chunk-pointer once per
+	* chunk and strides over the FUObjectItems directly. Empty slots are skipped within the block, and object-headers are prefetched a few items ahead.
+	*/
 	class ObjectsIterator
 	{
+	private:
+		static constexpr int32 BlockSize = 0x40;
+		static constexpr int32 PrefetchDistance = 0x4;
+
+	private:
 		UEObject CurrentObject;
 		int32 CurrentIndex;
 
+		/* Addresses of the objects [BlockStart, BlockStart + NumInBlock), nullptr for empty slots. Nothing is read for the end-iterator. */
+		int32 BlockStart = 0x0;
+		int32 NumInBlock = 0x0;
+		void* Addresses[BlockSize] = {};
+
+	private:
+		void ReadBlock(int32 First, int32 NumObjects);
+
 	public:
 		ObjectsIterator(int32 StartIndex = 0);
 
@@ -104,14 +246,16 @@ class AllFieldIterator
 private:
 	ObjectArray::ObjectsIterator ObjectEndIterator;
 	ObjectArray::ObjectsIterator CurrentObject;
-	std::vector<UEProperty> Fields;
-	int PropertyIndex = 0;
+	UEStruct::PropertyIterator CurrentProperty;
 
 public:
 	AllFieldIterator()
 		: CurrentObject(ObjectArray().begin()), ObjectEndIterator(ObjectArray().end())
 	{
-		if (!IsCurrentObjectStruct())
+		if (!IsEndIterator() && IsCurrentObjectStruct())
+			CurrentProperty = GetCurrentStruct().IterateProperties().begin();
+
+		if (!CurrentProperty)
 			IterateToNextStructWithMembers();
 	}
 
@@ -141,11 +285,6 @@ private:
 	inline void IterateToNextStructWithMembers();
 
 private:
-	inline bool CurrenStructHasMoreMembers() const
-	{
-		return (static_cast<size_t>(PropertyIndex) + 1) < Fields.size();
-	}
-
 	inline UEStruct GetCurrentStruct()
 	{
 		return (*CurrentObject).Cast<UEStruct>();
@@ -153,6 +292,9 @@ private:
 
 	inline bool IsCurrentObjectStruct()
 	{
+		if (ObjectArraySnapshot::IsBuilt())
+			return ObjectArraySnapshot::IsA(CurrentObject.GetIndex(), EClassCastFlags::Struct);
+
 		return (*CurrentObject).IsA(EClassCastFlags::Struct);
 	}
 
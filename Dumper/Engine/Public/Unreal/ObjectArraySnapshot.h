@@ -0,0 +1,114 @@
+#pragma once
+
+#include <vector>
+
+#include "Unreal/UnrealObjects.h"
+#include "MemoryReport.h"
+
+/*
+* A decoded copy of GObjects, built once per run.
+*
+* Every column is indexed by the objects index in GObjects. Slots that were empty at build-time have a nullptr Address and -1 for all indices.
+* While the snapshot is built, ObjectArray::ObjectsIterator and AllFieldIterator read from it instead of calling ObjectArray::GetByIndex.
+*
+* With Settings::General::bFreezeGameForSnapshot all other threads of the game are suspended while the columns are filled, so the snapshot is consistent.
+*/
+class ObjectArraySnapshot
+{
+private:
+	friend class ObjectArray;
+
+private:
+	static inline std::vector<void*> Addresses;
+	static inline std::vector<int32> ClassIndices;
+	static inline std::vector<int32> OuterIndices;
+	static inline std::vector<int32> PackageIndices;
+	static inline std::vector<int32> NameCompIndices;
+	static inline std::vector<uint32> NameNumbers;
+	static inline std::vector<EObjectFlags> ObjectFlags;
+	static inline std::vector<EClassCastFlags> CastFlags;
+
+	static inline bool bIsBuilt = false;
+
+private:
+	/* Reads up to 'Capacity' objects into the already sized columns without allocating, returns the number of objects read. Never yields while the game is frozen. */
+	static int32 FillColumns(int32 Capacity, bool bMayYield);
+
+public:
+	/* Decodes all objects currently in GObjects. Does nothing if the snapshot was already built. */
+	static void Build();
+
+	/* Clears all columns, iteration will go back to reading GObjects directly */
+	static void Reset();
+
+	static inline bool IsBuilt()
+	{
+		return bIsBuilt;
+	}
+
+	static inline int32 Num()
+	{
+		return static_cast<int32>(Addresses.size());
+	}
+
+	static inline MemoryReport GetMemoryReport()
+	{
+		MemoryReport Report = MemoryReport::FromVector(Addresses);
+		Report += MemoryReport::FromVector(ClassIndices);
+		Report += MemoryReport::FromVector(OuterIndices);
+		Report += MemoryReport::FromVector(PackageIndices);
+		Report += MemoryReport::FromVector(NameCompIndices);
+		Report += MemoryReport::FromVector(NameNumbers);
+		Report += MemoryReport::FromVector(ObjectFlags);
+		Report += MemoryReport::FromVector(CastFlags);
+
+		return Report;
+	}
+
+public:
+	static inline void* GetAddress(int32 Index)
+	{
+		return Addresses[Index];
+	}
+
+	static inline int32 GetClassIndex(int32 Index)
+	{
+		return ClassIndices[Index];
+	}
+
+	static inline int32 GetOuterIndex(int32 Index)
+	{
+		return OuterIndices[Index];
+	}
+
+	static inline int32 GetPackageIndex(int32 Index)
+	{
+		return PackageIndices[Index];
+	}
+
+	static inline int32 GetNameCompIdx(int32 Index)
+	{
+		return NameCompIndices[Index];
+	}
+
+	static inline uint32 GetNameNumber(int32 Index)
+	{
+		return NameNumbers[Index];
+	}
+
+	static inline EObjectFlags GetFlags(int32 Index)
+	{
+		return ObjectFlags[Index];
+	}
+
+	/* CastFlags of the objects class */
+	static inline EClassCastFlags GetCastFlags(int32 Index)
+	{
+		return CastFlags[Index];
+	}
+
+	static inline bool IsA(int32 Index, EClassCastFlags TypeFlags)
+	{
+		return TypeFlags != EClassCastFlags::None ? (CastFlags[Index] & TypeFlags) : true;
+	}
+};
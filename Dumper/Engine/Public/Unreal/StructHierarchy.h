@@ -0,0 +1,77 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "Unreal/UnrealObjects.h"
+#include "MemoryReport.h"
+
+/*
+* The inheritance tree of all UStructs in GObjects, numbered by a depth-first walk from every root struct.
+*
+* Every struct owns the interval [Start, End) of the walk-order, containing itself followed by all of its subtypes.
+* Checking whether a struct inherits from another one is therefore a single range-check, instead of walking the Super-chain.
+*/
+class StructHierarchy
+{
+private:
+	static inline std::vector<int32> IntervalStarts;
+	static inline std::vector<int32> IntervalEnds;
+	static inline std::vector<int32> Depths;
+
+	/* Struct indices in walk-order, the subtypes of a struct are OrderedStructs[Start + 1, End) */
+	static inline std::vector<int32> OrderedStructs;
+
+	static inline bool bIsInitialized = false;
+
+public:
+	/* Numbers all structs currently in GObjects. Does nothing if the hierarchy was already initialized. */
+	static void Init();
+
+	/* Drops the numbering, the next Init() walks the inheritance tree again */
+	static void Reset();
+
+	static inline bool IsInitialized()
+	{
+		return bIsInitialized;
+	}
+
+	static inline MemoryReport GetMemoryReport()
+	{
+		MemoryReport Report = MemoryReport::FromVector(IntervalStarts);
+		Report += MemoryReport::FromVector(IntervalEnds);
+		Report += MemoryReport::FromVector(Depths);
+		Report += MemoryReport::FromVector(OrderedStructs);
+
+		return Report;
+	}
+
+	/* Whether the struct at this index was reached while numbering the hierarchy */
+	static inline bool Contains(int32 StructIndex)
+	{
+		return bIsInitialized && StructIndex >= 0 && StructIndex < static_cast<int32>(IntervalStarts.size()) && IntervalStarts[StructIndex] != -1;
+	}
+
+public:
+	/* Whether 'StructIndex' is 'TypeIndex', or inherits from it. Both structs must be contained in the hierarchy. */
+	static inline bool HasType(int32 StructIndex, int32 TypeIndex)
+	{
+		const int32 Start = IntervalStarts[StructIndex];
+
+		return Start >= IntervalStarts[TypeIndex] && Start < IntervalEnds[TypeIndex];
+	}
+
+	/* Number of Super-structs above the struct, 0 for root structs (eg. UObject) */
+	static inline int32 GetDepth(int32 StructIndex)
+	{
+		return Depths[StructIndex];
+	}
+
+	/* Indices of all structs inheriting from this one, directly or indirectly, excluding the struct itself */
+	static inline std::span<const int32> GetAllSubtypes(int32 StructIndex)
+	{
+		const int32 Start = IntervalStarts[StructIndex] + 1;
+
+		return std::span<const int32>(OrderedStructs.data() + Start, IntervalEnds[StructIndex] - Start);
+	}
+};
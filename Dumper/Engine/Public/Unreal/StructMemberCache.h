@@ -0,0 +1,119 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "Unreal/UnrealObjects.h"
+#include "MemoryReport.h"
+
+/*
+* Properties and functions of every UStruct in GObjects, collected once per run.
+*
+* All structs share two contiguous arrays, a struct only stores where its members start and how many it has.
+* Properties are sorted by offset (and bit-index for bitfields), functions are kept in the order of the Children chain.
+*/
+class StructMemberCache
+{
+private:
+	struct MemberRange
+	{
+		int32 FirstProperty = 0x0;
+		int32 NumProperties = 0x0;
+		int32 FirstFunction = 0x0;
+		int32 NumFunctions = 0x0;
+	};
+
+	struct DetachedMembers
+	{
+		std::vector<UEProperty> Properties;
+		std::vector<UEFunction> Functions;
+	};
+
+private:
+	static inline std::vector<UEProperty> Properties;
+	static inline std::vector<UEFunction> Functions;
+	static inline std::vector<MemberRange> Ranges;
+
+	static inline bool bIsInitialized = false;
+
+	/* Incremented by Reset(), thread-local detached members of an older generation are dropped */
+	static inline uint32 Generation = 0x0;
+
+private:
+	/* Appends the members of 'Struct', properties sorted by offset and bit-index */
+	static void CollectMembers(UEStruct Struct, std::vector<UEProperty>& OutProperties, std::vector<UEFunction>& OutFunctions);
+
+	/* Thread-local members of structs that were added to GObjects after Init(), passes reading GObjects live can reach those */
+	static const DetachedMembers& GetDetachedMembers(int32 StructIndex);
+
+public:
+	/* Collects the members of all structs currently in GObjects. Does nothing if the cache was already initialized. */
+	static void Init();
+
+	/* Drops the cache, the next Init() collects the members again */
+	static void Reset();
+
+	static inline bool IsInitialized()
+	{
+		return bIsInitialized;
+	}
+
+	/* Memory used by the member-arrays, detached members of late structs are thread-local and not included */
+	static inline MemoryReport GetMemoryReport()
+	{
+		MemoryReport Report = MemoryReport::FromVector(Properties);
+		Report += MemoryReport::FromVector(Functions);
+		Report += MemoryReport::FromVector(Ranges);
+
+		return Report;
+	}
+
+	/* Whether the members of the struct at this index were collected by Init() */
+	static inline bool Contains(int32 StructIndex)
+	{
+		return bIsInitialized && StructIndex >= 0 && StructIndex < static_cast<int32>(Ranges.size());
+	}
+
+public:
+	/* Members of all structs, a struct's properties are a sub-span of this one */
+	static inline std::span<const UEProperty> GetAllProperties()
+	{
+		return Properties;
+	}
+
+	static inline std::span<const UEFunction> GetAllFunctions()
+	{
+		return Functions;
+	}
+
+public:
+	static inline std::span<const UEProperty> GetProperties(int32 StructIndex)
+	{
+		if (!Contains(StructIndex)) [[unlikely]]
+			return GetDetachedMembers(StructIndex).Properties;
+
+		const MemberRange& Range = Ranges[StructIndex];
+
+		return std::span<const UEProperty>(Properties.data() + Range.FirstProperty, Range.NumProperties);
+	}
+
+	static inline std::span<const UEFunction> GetFunctions(int32 StructIndex)
+	{
+		if (!Contains(StructIndex)) [[unlikely]]
+			return GetDetachedMembers(StructIndex).Functions;
+
+		const MemberRange& Range = Ranges[StructIndex];
+
+		return std::span<const UEFunction>(Functions.data() + Range.FirstFunction, Range.NumFunctions);
+	}
+
+	static inline std::span<const UEProperty> GetProperties(UEStruct Struct)
+	{
+		return GetProperties(Struct.GetIndex());
+	}
+
+	static inline std::span<const UEFunction> GetFunctions(UEStruct Struct)
+	{
+		return GetFunctions(Struct.GetIndex());
+	}
+};
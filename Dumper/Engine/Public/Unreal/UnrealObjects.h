@@ -98,6 +98,22 @@ class UEObject
 private:
 	static void(*PE)(void*, void*, void*);
 
+private:
+	struct OuterPrefixInfo
+	{
+		const void* Address;
+
+		/* "Package.Outer.ThisObject." */
+		std::string Prefix;
+	};
+
+	/* ObjectIndex -> fully qualified prefix of an object that is used as an outer. Separate tables for GetFullName and GetPathName. */
+	static inline std::unordered_map<int32, OuterPrefixInfo> OuterFullNamePrefixes;
+	static inline std::unordered_map<int32, OuterPrefixInfo> OuterPathNamePrefixes;
+	static inline std::shared_mutex OuterPrefixMutex;
+
+	static inline bool bIsOuterPrefixCacheEnabled = false;
+
 protected:
 	uint8* Object;
 
@@ -141,6 +157,18 @@ public:
 	std::string GetFullName() const;
 	std::string GetPathName() const;
 
+	/* Append the full-/path-name to 'OutBuffer', without clearing it first */
+	void GetFullName(std::string& OutBuffer) const;
+	void GetPathName(std::string& OutBuffer) const;
+
+	/* Enables caching of outer-prefixes for GetFullName/GetPathName. Must be called after Off::Init(), once names and outers are final. */
+	static void InitOuterPrefixCache();
+
+private:
+	/* Appends "Package.Outer.Object." for this object, which is used as the outer of another object */
+	void AppendAsOuterPrefix(std::string& OutBuffer, bool bWithPath) const;
+
+public:
 	explicit operator bool() const;
 	explicit operator uint8* ();
 	bool operator==(const UEObject& Other) const;
@@ -186,6 +214,46 @@ class UEStruct : public UEField
 {
 	using UEField::UEField;
 
+public:
+	/* Walks the Children/ChildProperties chain of a struct lazily, skipping every field that isn't a property */
+	class PropertyIterator
+	{
+	private:
+		void* CurrentField = nullptr;
+
+	public:
+		PropertyIterator() = default;
+		PropertyIterator(void* FirstField);
+
+	public:
+		PropertyIterator& operator++();
+		UEProperty operator*() const;
+
+		inline bool operator==(const PropertyIterator& Other) const { return CurrentField == Other.CurrentField; }
+		inline bool operator!=(const PropertyIterator& Other) const { return CurrentField != Other.CurrentField; }
+
+		inline explicit operator bool() const { return CurrentField != nullptr; }
+
+	private:
+		void SkipNonProperties();
+	};
+
+	class PropertyRange
+	{
+	private:
+		void* FirstField;
+
+	public:
+		PropertyRange(void* First)
+			: FirstField(First)
+		{
+		}
+
+	public:
+		inline PropertyIterator begin() const { return PropertyIterator(FirstField); }
+		inline PropertyIterator end() const { return PropertyIterator(); }
+	};
+
 public:
 	UEStruct GetSuper() const;
 	UEField GetChild() const;
@@ -202,6 +270,7 @@ public:
 	bool HasType(UEStruct Type) const;
 
 	std::vector<UEProperty> GetProperties() const;
+	PropertyRange IterateProperties() const;
 	std::vector<UEFunction> GetFunctions() const;
 
 	UEProperty FindMember(const std::string& MemberName, EClassCastFlags TypeFlags = EClassCastFlags::None) const;
@@ -234,7 +303,7 @@ public:
 	std::string StringifyCastFlags() const;
 	bool IsType(EClassCastFlags TypeFlag) const;
 	UEObject GetDefaultObject() const;
-	TArray<FImplementedInterface> GetImplementedInterfaces() const;
+	std::vector<FImplementedInterface> GetImplementedInterfaces() const;
 
 	UEFunction GetFunction(const std::string& ClassName, const std::string& FuncName) const;
 };
@@ -2,6 +2,11 @@
 
 #include <array>
 #include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
 #include <iostream>
 #include <Windows.h>
 
@@ -88,6 +93,24 @@ private:
 
 	inline static std::wstring(*ToStr)(const void* Name) = nullptr;
 
+private:
+	/* Number of cache-slots per page of the name-cache, pages are allocated lazily when a CompIdx inside of them is first resolved */
+	static constexpr int32 NameCachePageBits = 12;
+	static constexpr int32 NameCachePageSize = 1 << NameCachePageBits;
+
+	/* CompIdx -> (Index into CachedRawNames + 1), 0 if the name wasn't resolved yet */
+	inline static std::vector<std::unique_ptr<uint32[]>> NameCachePages;
+	inline static std::vector<std::string> CachedRawNames;
+	inline static std::shared_mutex NameCacheMutex;
+
+	inline static bool bIsNameCacheEnabled = false;
+
+	/* Whether names are read from GNames directly, instead of calling AppendString */
+	inline static bool bIsUsingNativeNameDecoding = false;
+
+	inline static std::atomic<uint64> NameCacheHits = 0;
+	inline static std::atomic<uint64> NameCacheMisses = 0;
+
 private:
 	const uint8* Address;
 
@@ -102,6 +125,15 @@ public:
 
 	static void Init(int32 OverrideOffset, EOffsetOverrideType OverrideType = EOffsetOverrideType::AppendString, bool bIsNamePool = false, const char* const ModuleName = nullptr);
 
+	/* Enables the CompIdx -> string cache. Must be called after Off::Init(), once the layout of FName is final. */
+	static void PostInit();
+
+private:
+	/* Returns the raw (UTF-8) string of this names CompIdx, without the '_Number' suffix */
+	std::string GetCachedRawBaseString() const;
+
+	std::string AppendNumberSuffix(std::string&& BaseString) const;
+
 public:
 	inline const void* GetAddress() const { return Address; }
 
@@ -122,4 +154,5 @@ public:
 	static std::string CompIdxToString(int CmpIdx);
 
 	static void* DEBUGGetAppendString();
+	static void DEBUGPrintNameCacheStats();
 };
@@ -0,0 +1,172 @@
+
+#include <format>
+#include <cstring>
+#include <iostream>
+
+#include "BufferedFileStream.h"
+#include "WorkerPool.h"
+#include "FileManifest.h"
+#include "Profiler.h"
+#include "MemoryBudget.h"
+
+#include "Platform.h"
+#include "Settings.h"
+
+
+BufferedFileStream::Buffer::int_type BufferedFileStream::Buffer::overflow(int_type Char)
+{
+	if (traits_type::eq_int_type(Char, traits_type::eof()))
+		return traits_type::not_eof(Char);
+
+	if (!bIsOpen)
+		return traits_type::eof();
+
+	const char AsChar = traits_type::to_char_type(Char);
+
+	if (AsChar == '\n' && bTranslateNewLines)
+		Data.push_back('\r');
+
+	Data.push_back(AsChar);
+
+	return Char;
+}
+
+std::streamsize BufferedFileStream::Buffer::xsputn(const char* Str, std::streamsize Count)
+{
+	if (!bIsOpen)
+		return 0x0;
+
+	if (!bTranslateNewLines)
+	{
+		Data.append(Str, Count);
+		return Count;
+	}
+
+	const char* Current = Str;
+	const char* const End = Str + Count;
+
+	while (Current < End)
+	{
+		const char* NewLine = static_cast<const char*>(std::memchr(Current, '\n', End - Current));
+
+		if (!NewLine)
+		{
+			Data.append(Current, End);
+			break;
+		}
+
+		Data.append(Current, NewLine);
+		Data.append("\r\n", 0x2);
+
+		Current = NewLine + 1;
+	}
+
+	return Count;
+}
+
+BufferedFileStream::BufferedFileStream()
+	: std::ostream(&FileBuffer)
+{
+}
+
+BufferedFileStream::BufferedFileStream(const std::filesystem::path& Path, std::ios::openmode Mode)
+	: std::ostream(&FileBuffer)
+{
+	open(Path, Mode);
+}
+
+BufferedFileStream::~BufferedFileStream()
+{
+	close();
+}
+
+void BufferedFileStream::open(const std::filesystem::path& Path, std::ios::openmode Mode)
+{
+	close();
+
+	FilePath = Path;
+
+	FileBuffer.Data.reserve(InitialBufferSize);
+	FileBuffer.bTranslateNewLines = (Mode & std::ios::binary) == 0;
+	FileBuffer.bIsOpen = true;
+
+	clear();
+}
+
+void BufferedFileStream::close()
+{
+	if (!FileBuffer.bIsOpen)
+		return;
+
+	FileBuffer.bIsOpen = false;
+
+	NumPendingWrites++;
+
+	/* Accounted until the buffer is released, it's the largest part of a package's transient memory */
+	const uint64 AccountedBytes = MemoryBudget::IsEnabled() ? FileBuffer.Data.capacity() : 0x0;
+	MemoryBudget::Acquire(AccountedBytes);
+
+	auto WriteToDisk = [Path = std::move(FilePath), Data = std::move(FileBuffer.Data), AccountedBytes]() mutable -> void
+	{
+		auto ReleaseBuffer = [&]() -> void
+		{
+			Data = std::string();
+			MemoryBudget::Release(AccountedBytes);
+		};
+
+		if (Settings::Generator::ShouldSkipUnchangedFiles())
+		{
+			if (FileManifest::AddFile(Path, Data.data(), Data.size()))
+			{
+				ReleaseBuffer();
+
+				NumFilesSkipped++;
+				NumPendingWrites--;
+				return;
+			}
+		}
+
+		if (Platform::WriteEntireFile(Path.c_str(), Data.data(), Data.size()))
+		{
+			NumBytesWritten += Data.size();
+			NumFilesWritten++;
+
+			Profiler::AddCount(EProfilerCounter::BytesWritten, Data.size());
+		}
+		else
+		{
+			const std::u8string U8Path = Path.u8string();
+			std::cerr << "Error writing file \"" << reinterpret_cast<const std::string&>(U8Path) << "\"\n";
+		}
+
+		ReleaseBuffer();
+
+		NumPendingWrites--;
+	};
+
+	FilePath.clear();
+	FileBuffer.Data = std::string();
+
+	if constexpr (Settings::Generator::bWriteFilesInBackground)
+	{
+		WorkerPool::Submit(std::move(WriteToDisk));
+	}
+	else
+	{
+		WriteToDisk();
+	}
+}
+
+void BufferedFileStream::WaitForPendingWrites()
+{
+	while (NumPendingWrites > 0)
+	{
+		if (!WorkerPool::TryRunPendingTask())
+			std::this_thread::yield();
+	}
+}
+
+void BufferedFileStream::PrintStatistics()
+{
+	std::cerr << std::format("Wrote {} files ({:.2f}MiB), skipped {} unchanged files\n", GetNumFilesWritten(), GetNumBytesWritten() / (1024.0 * 1024.0), GetNumFilesSkipped());
+}
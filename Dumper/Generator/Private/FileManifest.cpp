@@ -0,0 +1,167 @@
+
+#include <format>
+#include <vector>
+#include <fstream>
+#include <charconv>
+#include <iostream>
+#include <algorithm>
+
+#include "FileManifest.h"
+#include "HashStringTable.h"
+
+
+std::string FileManifest::GetRelativePath(const std::filesystem::path& FilePath)
+{
+	const std::u8string U8Path = FilePath.lexically_relative(RootFolder).generic_u8string();
+
+	return reinterpret_cast<const std::string&>(U8Path);
+}
+
+bool FileManifest::Load(const std::filesystem::path& Folder)
+{
+	RootFolder = Folder;
+
+	PreviousFiles.clear();
+	CurrentFiles.clear();
+
+	bHasPreviousManifest = false;
+
+	std::ifstream Manifest(Folder / ManifestFileName, std::ios::binary);
+
+	if (!Manifest.is_open())
+		return false;
+
+	/* Every line is "<Hash> <Size> <RelativePath>", hash and size are hexadecimal */
+	std::string Line;
+
+	while (std::getline(Manifest, Line))
+	{
+		const size_t FirstSpace = Line.find(' ');
+		const size_t SecondSpace = FirstSpace != std::string::npos ? Line.find(' ', FirstSpace + 1) : std::string::npos;
+
+		if (SecondSpace == std::string::npos)
+			continue;
+
+		const char* const LineStart = Line.data();
+
+		FileEntry Entry;
+		const bool bIsValidHash = std::from_chars(LineStart, LineStart + FirstSpace, Entry.Hash, 16).ec == std::errc();
+		const bool bIsValidSize = std::from_chars(LineStart + FirstSpace + 1, LineStart + SecondSpace, Entry.Size, 16).ec == std::errc();
+
+		/* A broken entry is treated like a file that wasn't generated before */
+		if (!bIsValidHash || !bIsValidSize)
+			continue;
+
+		PreviousFiles.emplace(Line.substr(SecondSpace + 1), Entry);
+	}
+
+	bHasPreviousManifest = true;
+
+	return true;
+}
+
+bool FileManifest::AddFile(const std::filesystem::path& FilePath, const void* Data, uint64 Size)
+{
+	if (RootFolder.empty())
+		return false;
+
+	FileEntry Entry;
+	Entry.Hash = StringHash64(static_cast<const char*>(Data), static_cast<int32>(Size));
+	Entry.Size = Size;
+
+	std::string RelativePath = GetRelativePath(FilePath);
+
+	bool bMatchesPreviousRun = false;
+
+	{
+		std::scoped_lock Lock(ManifestLock);
+
+		auto It = PreviousFiles.find(RelativePath);
+		bMatchesPreviousRun = It != PreviousFiles.end() && It->second.Hash == Entry.Hash && It->second.Size == Entry.Size;
+
+		CurrentFiles.insert_or_assign(std::move(RelativePath), Entry);
+	}
+
+	if (!bMatchesPreviousRun)
+		return false;
+
+	/* The file might've been edited or deleted since the last run, only trust the manifest if the size on disk still matches */
+	std::error_code Error;
+	const uint64 SizeOnDisk = std::filesystem::file_size(FilePath, Error);
+
+	return !Error && SizeOnDisk == Size;
+}
+
+bool FileManifest::KeepFile(const std::filesystem::path& FilePath)
+{
+	if (RootFolder.empty())
+		return false;
+
+	std::string RelativePath = GetRelativePath(FilePath);
+
+	FileEntry Entry;
+
+	{
+		std::scoped_lock Lock(ManifestLock);
+
+		auto It = PreviousFiles.find(RelativePath);
+
+		if (It == PreviousFiles.end())
+			return false;
+
+		Entry = It->second;
+	}
+
+	std::error_code Error;
+	const uint64 SizeOnDisk = std::filesystem::file_size(FilePath, Error);
+
+	if (Error || SizeOnDisk != Entry.Size)
+		return false;
+
+	std::scoped_lock Lock(ManifestLock);
+	CurrentFiles.insert_or_assign(std::move(RelativePath), Entry);
+
+	return true;
+}
+
+void FileManifest::Save()
+{
+	if (RootFolder.empty())
+		return;
+
+	std::ofstream Manifest(RootFolder / ManifestFileName, std::ios::binary);
+
+	if (!Manifest.is_open())
+	{
+		std::cerr << "Error writing the file-manifest!\n";
+		return;
+	}
+
+	/* Sorted by path, so manifests of identical runs are identical too */
+	std::vector<const std::pair<const std::string, FileEntry>*> SortedFiles;
+	SortedFiles.reserve(CurrentFiles.size());
+
+	for (const auto& File : CurrentFiles)
+		SortedFiles.push_back(&File);
+
+	std::sort(SortedFiles.begin(), SortedFiles.end(), [](const auto* Left, const auto* Right) { return Left->first < Right->first; });
+
+	for (const auto* File : SortedFiles)
+		Manifest << std::format("{:016X} {:X} {}\n", File->second.Hash, File->second.Size, File->first);
+
+	int32 NumRemovedFiles = 0x0;
+
+	for (const auto& [RelativePath, Entry] : PreviousFiles)
+	{
+		if (CurrentFiles.contains(RelativePath))
+			continue;
+
+		std::error_code Error;
+
+		if (std::filesystem::remove(RootFolder / reinterpret_cast<const std::u8string&>(RelativePath), Error))
+			NumRemovedFiles++;
+	}
+
+	if (NumRemovedFiles > 0)
+		std::cerr << std::format("Removed {} files that weren't generated again.\n", NumRemovedFiles);
+}
@@ -1,10 +1,17 @@
 #include <vector>
 #include <array>
+#include <sstream>
 
 #include "Unreal/ObjectArray.h"
+#include "Unreal/StructMemberCache.h"
+#include "Unreal/StructHierarchy.h"
 #include "Generators/CppGenerator.h"
 #include "Wrappers/MemberWrappers.h"
 #include "Managers/MemberManager.h"
+#include "WorkerPool.h"
+#include "FileManifest.h"
+#include "PackageFingerprints.h"
+#include "Profiler.h"
 
 #include "../Settings.h"
 
@@ -25,49 +32,71 @@ constexpr const char* GetTypeFromSize(uint8 Size)
 	}
 }
 
-std::string CppGenerator::MakeMemberString(const std::string& Type, const std::string& Name, std::string&& Comment)
+/* Clears Buffer and formats into it. Buffers passed here are per-thread and keep their capacity, so formatting a line doesn't allocate once they've grown.
+* The format-string is checked at compile time, type_identity keeps it out of template argument deduction. */
+template<typename... ArgTypes>
+std::string_view FormatToBuffer(std::string& Buffer, std::format_string<std::type_identity_t<ArgTypes>...> Fmt, ArgTypes&&... Args)
+{
+	Buffer.clear();
+	std::format_to(std::back_inserter(Buffer), Fmt, std::forward<ArgTypes>(Args)...);
+
+	return Buffer;
+}
+
+void CppGenerator::AppendMemberString(GeneratorArena::String& Out, std::string_view Type, std::string_view Name, std::string_view Comment)
 {
 	//<tab><--45 chars--><-------50 chars----->
 	//     Type          MemberName;           // Comment
-	
+
+	static thread_local std::string NameWithSemicolon;
+
+	NameWithSemicolon.assign(Name);
+	NameWithSemicolon += ';';
+
 	// Optimization: Calculate spacing inline to minimize branches
 	const size_t TypeLen = Type.length();
 	const int NumSpacesToComment = (TypeLen < 45) ? 50 
 		: ((TypeLen + Name.length()) > 95) ? 1 
 		: (50 - static_cast<int>(TypeLen - 45));
 
-	return std::format("\t{:{}} {:{}} // {}\n", Type, 45, Name + ";", NumSpacesToComment, std::move(Comment));
+	std::format_to(std::back_inserter(Out), "\t{:{}} {:{}} // {}\n", Type, 45, NameWithSemicolon, NumSpacesToComment, Comment);
 }
 
-std::string CppGenerator::MakeMemberStringWithoutName(const std::string& Type)
+void CppGenerator::AppendMemberStringWithoutName(GeneratorArena::String& Out, std::string_view Type)
 {
-	return std::format("\t{};\n", Type);
+	std::format_to(std::back_inserter(Out), "\t{};\n", Type);
 }
 
-std::string CppGenerator::GenerateBytePadding(const int32 Offset, const int32 PadSize, std::string&& Reason)
+void CppGenerator::AppendBytePadding(GeneratorArena::String& Out, const int32 Offset, const int32 PadSize, std::string_view Reason)
 {
-	// Optimization: Pre-format all components to reduce allocations
-	return MakeMemberString("uint8", 
-		std::format("Pad_{:X}[0x{:X}]", Offset, PadSize), 
-		std::format("0x{:04X}(0x{:04X})({})", Offset, PadSize, std::move(Reason)));
+	static thread_local std::string PadName;
+	static thread_local std::string PadComment;
+
+	AppendMemberString(Out, "uint8",
+		FormatToBuffer(PadName, "Pad_{:X}[0x{:X}]", Offset, PadSize),
+		FormatToBuffer(PadComment, "0x{:04X}(0x{:04X})({})", Offset, PadSize, Reason));
 }
 
-std::string CppGenerator::GenerateBitPadding(uint8 UnderlayingSizeBytes, const uint8 PrevBitPropertyEndBit, const int32 Offset, const int32 PadSize, std::string&& Reason)
+void CppGenerator::AppendBitPadding(GeneratorArena::String& Out, uint8 UnderlayingSizeBytes, const uint8 PrevBitPropertyEndBit, const int32 Offset, const int32 PadSize, std::string_view Reason)
 {
-	// Optimization: Pre-format all components to reduce allocations
-	return MakeMemberString(GetTypeFromSize(UnderlayingSizeBytes), 
-		std::format("BitPad_{:X}_{:X} : {:d}", Offset, PrevBitPropertyEndBit, PadSize), 
-		std::format("0x{:04X}(0x{:04X})({})", Offset, UnderlayingSizeBytes, std::move(Reason)));
+	static thread_local std::string PadName;
+	static thread_local std::string PadComment;
+
+	AppendMemberString(Out, GetTypeFromSize(UnderlayingSizeBytes),
+		FormatToBuffer(PadName, "BitPad_{:X}_{:X} : {:d}", Offset, PrevBitPropertyEndBit, PadSize),
+		FormatToBuffer(PadComment, "0x{:04X}(0x{:04X})({})", Offset, UnderlayingSizeBytes, Reason));
 }
 
-std::string CppGenerator::GenerateMembers(const StructWrapper& Struct, const MemberManager& Members, int32 SuperSize, int32 SuperLastMemberEnd, int32 SuperAlign, int32 PackageIndex)
+void CppGenerator::GenerateMembers(GeneratorArena::String& OutMembers, const StructWrapper& Struct, const MemberManager& Members, int32 SuperSize, int32 SuperLastMemberEnd, int32 SuperAlign, int32 PackageIndex)
 {
 	constexpr uint64 EstimatedCharactersPerLine = 0xF0;
 
 	const bool bIsUnion = Struct.IsUnion();
 
-	std::string OutMembers;
-	OutMembers.reserve(Members.GetNumMembers() * EstimatedCharactersPerLine);
+	OutMembers.reserve(OutMembers.size() + Members.GetNumMembers() * EstimatedCharactersPerLine);
+
+	static thread_local std::string CommentBuffer;
+	static thread_local std::string MemberNameBuffer;
 
 	bool bEncounteredZeroSizedVariable = false;
 	bool bEncounteredStaticVariable = false;
@@ -114,19 +143,21 @@ std::string CppGenerator::GenerateMembers(const StructWrapper& Struct, const Mem
 
 		const int32 CurrentPropertyEnd = MemberOffset + MemberSize;
 
-		std::string Comment = std::format("0x{:04X}(0x{:04X})({})", MemberOffset, MemberSize, Member.GetFlagsOrCustomComment());
-
 		const bool bIsBitField = Member.IsBitField();
 
+		const std::string_view Comment = bIsBitField
+			? FormatToBuffer(CommentBuffer, "0x{:04X}(0x{:04X})(BitIndex: 0x{:02X}, PropSize: 0x{:04X} ({}))", MemberOffset, MemberSize, Member.GetBitIndex(), MemberSize, Member.GetFlagsOrCustomComment())
+			: FormatToBuffer(CommentBuffer, "0x{:04X}(0x{:04X})({})", MemberOffset, MemberSize, Member.GetFlagsOrCustomComment());
+
 		/* Padding between two bitfields at different byte-offsets */
 		if (CurrentPropertyEnd > PrevPropertyEnd && bLastPropertyWasBitField && bIsBitField && PrevBitPropertyEndBit < PrevNumBitsInUnderlayingType && !bIsUnion)
 		{
-			OutMembers += GenerateBitPadding(PrevBitPropertySize, PrevBitPropertyEndBit, PrevBitPropertyOffset, PrevNumBitsInUnderlayingType - PrevBitPropertyEndBit, "Fixing Bit-Field Size For New Byte [ Dumper-7 ]");
+			AppendBitPadding(OutMembers, PrevBitPropertySize, PrevBitPropertyEndBit, PrevBitPropertyOffset, PrevNumBitsInUnderlayingType - PrevBitPropertyEndBit, "Fixing Bit-Field Size For New Byte [ Dumper-7 ]");
 			PrevBitPropertyEndBit = 0;
 		}
 
 		if (MemberOffset > PrevPropertyEnd && !bIsUnion)
-			OutMembers += GenerateBytePadding(PrevPropertyEnd, MemberOffset - PrevPropertyEnd, "Fixing Size After Last Property [ Dumper-7 ]");
+			AppendBytePadding(OutMembers, PrevPropertyEnd, MemberOffset - PrevPropertyEnd, "Fixing Size After Last Property [ Dumper-7 ]");
 
 		bIsFirstSizedMember = Member.IsZeroSizedMember() || Member.IsStatic();
 
@@ -138,14 +169,11 @@ std::string CppGenerator::GenerateMembers(const StructWrapper& Struct, const Mem
 			if (CurrentPropertyEnd > PrevPropertyEnd)
 				PrevBitPropertyEndBit = 0x0;
 
-			std::string BitfieldInfoComment = std::format("BitIndex: 0x{:02X}, PropSize: 0x{:04X} ({})", BitFieldIndex, MemberSize, Member.GetFlagsOrCustomComment());
-			Comment = std::format("0x{:04X}(0x{:04X})({})", MemberOffset, MemberSize, BitfieldInfoComment);
-
 			if (PrevBitPropertyEnd < MemberOffset)
 				PrevBitPropertyEndBit = 0;
 
 			if (PrevBitPropertyEndBit < BitFieldIndex && !bIsUnion)
-				OutMembers += GenerateBitPadding(MemberSize, PrevBitPropertyEndBit, MemberOffset, BitFieldIndex - PrevBitPropertyEndBit, "Fixing Bit-Field Size Between Bits [ Dumper-7 ]");
+				AppendBitPadding(OutMembers, MemberSize, PrevBitPropertyEndBit, MemberOffset, BitFieldIndex - PrevBitPropertyEndBit, "Fixing Bit-Field Size Between Bits [ Dumper-7 ]");
 
 			PrevBitPropertyEndBit = BitFieldIndex + BitSize;
 			PrevBitPropertyEnd = MemberOffset  + MemberSize;
@@ -161,39 +189,41 @@ std::string CppGenerator::GenerateMembers(const StructWrapper& Struct, const Mem
 		if (!Member.IsStatic()) [[likely]]
 			PrevPropertyEnd = MemberOffset + (MemberSize * Member.GetArrayDim());
 
-		std::string MemberName = Member.GetName();
+		std::string& MemberName = MemberNameBuffer;
+		MemberName.assign(Member.GetName());
 
 		if (Member.GetArrayDim() > 1)
 		{
-			MemberName += std::format("[0x{:X}]", Member.GetArrayDim());
+			std::format_to(std::back_inserter(MemberName), "[0x{:X}]", Member.GetArrayDim());
 		}
 		else if (bIsBitField)
 		{
-			MemberName += (" : " + std::to_string(Member.GetBitCount()));
+			std::format_to(std::back_inserter(MemberName), " : {}", Member.GetBitCount());
 		}
 
 		if (Member.HasDefaultValue()) [[unlikely]]
-			MemberName += (" = " + Member.GetDefaultValue());
+		{
+			MemberName += " = ";
+			MemberName += Member.GetDefaultValue();
+		}
 
 		const bool bAllowForConstPtrMembers = Struct.IsFunction();
 
 		/* using directives */
 		if (Member.IsZeroSizedMember()) [[unlikely]]
 		{
-			OutMembers += MakeMemberStringWithoutName(GetMemberTypeString(Member, PackageIndex, bAllowForConstPtrMembers));
+			AppendMemberStringWithoutName(OutMembers, GetMemberTypeString(Member, PackageIndex, bAllowForConstPtrMembers));
 		}
 		else [[likely]]
 		{
-			OutMembers += MakeMemberString(GetMemberTypeString(Member, PackageIndex, bAllowForConstPtrMembers), MemberName, std::move(Comment));
+			AppendMemberString(OutMembers, GetMemberTypeString(Member, PackageIndex, bAllowForConstPtrMembers), MemberName, Comment);
 		}
 	}
 
 	const int32 MissingByteCount = Struct.GetUnalignedSize() - PrevPropertyEnd;
 
 	if (MissingByteCount > 0x0 /* >=Struct.GetAlignment()*/)
-		OutMembers += GenerateBytePadding(PrevPropertyEnd, MissingByteCount, "Fixing Struct Size After Last Property [ Dumper-7 ]");
-
-	return OutMembers;
+		AppendBytePadding(OutMembers, PrevPropertyEnd, MissingByteCount, "Fixing Struct Size After Last Property [ Dumper-7 ]");
 }
 
 CppGenerator::FunctionInfo CppGenerator::GenerateFunctionInfo(const FunctionWrapper& Func)
@@ -289,11 +319,11 @@ CppGenerator::FunctionInfo CppGenerator::GenerateFunctionInfo(const FunctionWrap
 	return RetFuncInfo;
 }
 
-std::string CppGenerator::GenerateSingleFunction(const FunctionWrapper& Func, const std::string& StructName, StreamType& FunctionFile, StreamType& ParamFile, StreamType& AssertionFile)
+GeneratorArena::String CppGenerator::GenerateSingleFunction(const FunctionWrapper& Func, const std::string& StructName, StreamType& FunctionFile, StreamType& ParamFile, std::ostream& AssertionFile)
 {
 	namespace CppSettings = Settings::CppGenerator;
 
-	std::string InHeaderFunctionText;
+	GeneratorArena::String InHeaderFunctionText(GeneratorArena::GetResource());
 
 	FunctionInfo FuncInfo = GenerateFunctionInfo(Func);
 
@@ -306,15 +336,24 @@ std::string CppGenerator::GenerateSingleFunction(const FunctionWrapper& Func, co
 	if (!Func.IsPredefined() && !bHasInlineBody)
 	{
 		UEFunction UnrealFunc = Func.GetUnrealFunction();
-		std::string BriefDoc = std::format("\t// Function: {} | Flags: {}\n", 
+		std::format_to(std::back_inserter(InHeaderFunctionText), "\t// Function: {} | Flags: {}\n", 
 			UnrealFunc.GetName(), 
 			StringifyFunctionFlags(FuncInfo.FuncFlags));
-		InHeaderFunctionText += BriefDoc;
 	}
 
 	// Function declaration and inline-body generation
-	InHeaderFunctionText += std::format("\t{}{}{}{}{}{}", TemplateText, (Func.IsStatic() ? "static " : ""), FuncInfo.RetType, (FuncInfo.RetType.empty() ? "" : " "), FuncInfo.FuncNameWithParams, bIsConstFunc ? " const" : "");
-	InHeaderFunctionText += (bHasInlineBody ? ("\n\t" + Func.GetPredefFunctionInlineBody()) : ";") + "\n";
+	std::format_to(std::back_inserter(InHeaderFunctionText), "\t{}{}{}{}{}{}", TemplateText, (Func.IsStatic() ? "static " : ""), FuncInfo.RetType, (FuncInfo.RetType.empty() ? "" : " "), FuncInfo.FuncNameWithParams, bIsConstFunc ? " const" : "");
+
+	if (bHasInlineBody)
+	{
+		InHeaderFunctionText += "\n\t";
+		InHeaderFunctionText += Func.GetPredefFunctionInlineBody();
+		InHeaderFunctionText += '\n';
+	}
+	else
+	{
+		InHeaderFunctionText += ";\n";
+	}
 
 	if (bHasInlineBody)
 		return InHeaderFunctionText;
@@ -390,7 +429,7 @@ std::string CppGenerator::GenerateSingleFunction(const FunctionWrapper& Func, co
 		else
 			ParamDirection = "[In]";
 
-		ParamDescriptionCommentString += std::format("// {:<8} {:{}}{:{}}({})\n", 
+		std::format_to(std::back_inserter(ParamDescriptionCommentString), "// {:<8} {:{}}{:{}}({})\n", 
 			ParamDirection, PInfo.Type, 40, PInfo.Name, 48, StringifyPropertyFlags(PInfo.PropFlags));
 
 		if (PInfo.bIsRetParam)
@@ -473,8 +512,11 @@ std::string CppGenerator::GenerateSingleFunction(const FunctionWrapper& Func, co
 	if (bIsNativeFunc)
 		FunctionDocumentation += "// Note: Native function - FunctionFlags will be temporarily modified during ProcessEvent\n";
 
+	/* The implementation is formatted into a per-thread buffer and streamed in one piece, the buffer keeps its capacity between functions */
+	static thread_local std::string FunctionImplementation;
+
 	// Function implementation generation
-	std::string FunctionImplementation = std::format(R"(
+	FormatToBuffer(FunctionImplementation, R"(
 {}{}
 {} {}::{}{}
 {{
@@ -510,16 +552,17 @@ std::string CppGenerator::GenerateSingleFunction(const FunctionWrapper& Func, co
 	return InHeaderFunctionText;
 }
 
-std::string CppGenerator::GenerateFunctions(const StructWrapper& Struct, const MemberManager& Members, const std::string& StructName, StreamType& FunctionFile, StreamType& ParamFile, StreamType& AssertionFile)
+GeneratorArena::String CppGenerator::GenerateFunctions(const StructWrapper& Struct, const MemberManager& Members, const std::string& StructName, StreamType& FunctionFile, StreamType& ParamFile, std::ostream& AssertionFile)
 {
 	namespace CppSettings = Settings::CppGenerator;
 
-	static PredefinedFunction StaticClass;
-	static PredefinedFunction StaticName;
-	static PredefinedFunction GetDefaultObj;
+	/* The bodies of these are rewritten for every struct, so each thread generating packages needs its own copy */
+	static thread_local PredefinedFunction StaticClass;
+	static thread_local PredefinedFunction StaticName;
+	static thread_local PredefinedFunction GetDefaultObj;
 
-	static PredefinedFunction Interface_AsObject;
-	static PredefinedFunction Interface_AsObject_Const;
+	static thread_local PredefinedFunction Interface_AsObject;
+	static thread_local PredefinedFunction Interface_AsObject_Const;
 
 	if (StaticClass.NameWithParams.empty())
 		StaticClass = {
@@ -582,7 +625,7 @@ std::string CppGenerator::GenerateFunctions(const StructWrapper& Struct, const M
 		Interface_AsObject_Const.Body = "{\n\treturn reinterpret_cast<const UObject*>(this);\n}";
 	}
 
-	std::string InHeaderFunctionText;
+	GeneratorArena::String InHeaderFunctionText(GeneratorArena::GetResource());
 
 	bool bIsFirstIteration = true;
 	bool bDidSwitch = false;
@@ -631,10 +674,7 @@ std::string CppGenerator::GenerateFunctions(const StructWrapper& Struct, const M
 	if ((bWasLastFuncStatic != StaticClass.bIsStatic || bWaslastFuncConst != StaticClass.bIsConst) && !bIsFirstIteration && !bDidSwitch)
 		InHeaderFunctionText += '\n';
 
-	static UEClass BPGeneratedClass = nullptr;
-	
-	if (BPGeneratedClass == nullptr)
-		BPGeneratedClass = ObjectArray::FindClassFast("BlueprintGeneratedClass");
+	static const UEClass BPGeneratedClass = ObjectArray::FindClassFast("BlueprintGeneratedClass");
 
 	const bool bIsBPStaticClass = Struct.IsAClassWithType(BPGeneratedClass);
 
@@ -673,7 +713,7 @@ R"({{
 	return GetDefaultObjImpl<{}>();
 }})",StructName);
 
-	std::shared_ptr<StructWrapper> CurrentStructPtr = std::make_shared<StructWrapper>(Struct);
+	const StructWrapper* CurrentStructPtr = &Struct;
 	InHeaderFunctionText += GenerateSingleFunction(FunctionWrapper(CurrentStructPtr, &StaticClass), StructName, FunctionFile, ParamFile, AssertionFile);
 	InHeaderFunctionText += GenerateSingleFunction(FunctionWrapper(CurrentStructPtr, &StaticName), StructName, FunctionFile, ParamFile, AssertionFile);
 	InHeaderFunctionText += GenerateSingleFunction(FunctionWrapper(CurrentStructPtr, &GetDefaultObj), StructName, FunctionFile, ParamFile, AssertionFile);
@@ -689,7 +729,7 @@ R"({{
 	return InHeaderFunctionText;
 }
 
-void CppGenerator::GenerateStruct(const StructWrapper& Struct, StreamType& StructFile, StreamType& FunctionFile, StreamType& ParamFile, StreamType& AssertionFile, int32 PackageIndex, const std::string& StructNameOverride)
+void CppGenerator::GenerateStruct(const StructWrapper& Struct, StreamType& StructFile, StreamType& FunctionFile, StreamType& ParamFile, std::ostream& AssertionFile, int32 PackageIndex, const std::string& StructNameOverride)
 {
 	if (!Struct.IsValid())
 		return;
@@ -732,8 +772,10 @@ void CppGenerator::GenerateStruct(const StructWrapper& Struct, StreamType& Struc
 
 	const bool bIsTemplatedType = Struct.HasCustomTemplateText();
 
+	/* Header, members, in-header functions and the closing brace are collected here and streamed to the file at once */
+	GeneratorArena::String StructBody(GeneratorArena::GetResource());
 
-	StructFile << std::format(R"(
+	std::format_to(std::back_inserter(StructBody), R"(
 // {}
 // 0x{:04X} (0x{:04X} - 0x{:04X})
 {}{}{} {}{}{}{}
@@ -758,27 +800,29 @@ void CppGenerator::GenerateStruct(const StructWrapper& Struct, StreamType& Struc
 	const bool bHasFunctions = (Members.HasFunctions() && !Struct.IsFunction()) || bHasStaticClass;
 
 	if (bHasMembers || bHasFunctions)
-		StructFile << "public:\n";
+		StructBody += "public:\n";
 
 	if (bHasMembers)
 	{
-		StructFile << GenerateMembers(Struct, Members, bIsReusingTrailingPaddingFromSuper ? UnalignedSuperSize : SuperSize, SuperLastMemberEnd, SuperAlignment, PackageIndex);
+		GenerateMembers(StructBody, Struct, Members, bIsReusingTrailingPaddingFromSuper ? UnalignedSuperSize : SuperSize, SuperLastMemberEnd, SuperAlignment, PackageIndex);
 
 		if (bHasFunctions)
-			StructFile << "\npublic:\n";
+			StructBody += "\npublic:\n";
 	}
 
 	if (bHasFunctions)
 	{
-		StreamType& FuncParamsAssertionFile = Settings::Debug::bGenerateAssertionFile ? AssertionFile : ParamFile;
+		std::ostream& FuncParamsAssertionFile = Settings::Debug::bGenerateAssertionFile ? AssertionFile : ParamFile;
 
-		StructFile << GenerateFunctions(Struct, Members, UniqueName, FunctionFile, ParamFile, FuncParamsAssertionFile);
+		StructBody += GenerateFunctions(Struct, Members, UniqueName, FunctionFile, ParamFile, FuncParamsAssertionFile);
 	}
 
-	StructFile << "};\n";
+	StructBody += "};\n";
 
 	if (bHasReusedTrailingPadding)
-		StructFile << "#pragma pack(pop)\n";
+		StructBody += "#pragma pack(pop)\n";
+
+	StructFile << StructBody;
 
 	if constexpr (Settings::Debug::bGenerateAssertionFile)
 	{
@@ -912,14 +956,8 @@ std::string CppGenerator::GetAssertionMacroString(const std::string& PrefixedStr
 
 std::string CppGenerator::GetCycleFixupType(const StructWrapper& Struct, bool bIsForInheritance)
 {
-	static int32 UObjectSize = 0x0;
-	static int32 AActorSize = 0x0;
-
-	if (UObjectSize == 0x0 || AActorSize == 0x0)
-	{
-		UObjectSize = StructWrapper(ObjectArray::FindClassFast("Object")).GetSize();
-		AActorSize = StructWrapper(ObjectArray::FindClassFast("Actor")).GetSize();
-	}
+	static const int32 UObjectSize = StructWrapper(ObjectArray::FindClassFast("Object")).GetSize();
+	static const int32 AActorSize = StructWrapper(ObjectArray::FindClassFast("Actor")).GetSize();
 
 	/* Predefined structs can not be cyclic, unless you did something horribly wrong when defining the predefined struct! */
 	if (!Struct.IsUnrealStruct())
@@ -953,12 +991,17 @@ std::string CppGenerator::GetMemberTypeString(const PropertyWrapper& MemberWrapp
 		return MemberWrapper.GetType();
 	}
 
-	return GetMemberTypeString(MemberWrapper.GetUnrealProperty(), PackageIndex, bAllowForConstPtrMembers);
+	return GetMemberTypeString(MemberWrapper.GetTypeNode(), PackageIndex, bAllowForConstPtrMembers);
 }
 
 std::string CppGenerator::GetMemberTypeString(UEProperty Member, int32 PackageIndex, bool bAllowForConstPtrMembers)
 {
-	static auto IsMemberPtr = [](UEProperty Mem) -> bool
+	return GetMemberTypeString(TypeIR::GetNode(Member), PackageIndex, bAllowForConstPtrMembers);
+}
+
+std::string CppGenerator::GetMemberTypeString(const TypeIR::PropertyNode& Member, int32 PackageIndex, bool bAllowForConstPtrMembers)
+{
+	static auto IsMemberPtr = [](const TypeIR::PropertyNode& Mem) -> bool
 	{
 		if (Mem.IsA(EClassCastFlags::ClassProperty))
 			return !Mem.HasPropertyFlags(EPropertyFlags::UObjectWrapper);
@@ -974,13 +1017,77 @@ std::string CppGenerator::GetMemberTypeString(UEProperty Member, int32 PackageIn
 
 std::string CppGenerator::GetMemberTypeStringWithoutConst(UEProperty Member, int32 PackageIndex, bool* bOutIsUnknownProperty)
 {
-	auto [Class, FieldClass] = Member.GetClass();
+	return GetMemberTypeStringWithoutConst(TypeIR::GetNode(Member), PackageIndex, bOutIsUnknownProperty);
+}
+
+std::string CppGenerator::GetMemberTypeStringWithoutConst(const TypeIR::PropertyNode& Member, int32 PackageIndex, bool* bOutIsUnknownProperty)
+{
+	if (Member.TypeShape >= 0 && Member.TypeShape < static_cast<int32>(TypeStringCache.size()))
+	{
+		const CachedTypeString& Cached = TypeStringCache[Member.TypeShape];
+
+		if (Cached.bIsValid) [[likely]]
+		{
+			if (bOutIsUnknownProperty && Cached.bIsUnknownProperty)
+				*bOutIsUnknownProperty = true;
+
+			return Cached.Type;
+		}
+	}
+
+	return BuildMemberTypeStringWithoutConst(Member, PackageIndex, bOutIsUnknownProperty);
+}
+
+MemoryReport CppGenerator::GetTypeStringCacheMemoryReport()
+{
+	MemoryReport Report = MemoryReport::FromVector(TypeStringCache);
+
+	for (const CachedTypeString& Cached : TypeStringCache)
+		Report += MemoryReport::FromString(Cached.Type);
+
+	return Report;
+}
+
+void CppGenerator::InitTypeStringCache()
+{
+	/* Only the StructProperty branch depends on the package, through GetCycleFixupType */
+	static auto DependsOnPackage = [](auto&& Self, const TypeIR::PropertyNode& Member) -> bool
+	{
+		if (Member.IsA(EClassCastFlags::StructProperty))
+		{
+			const UEStruct Struct = Member.Referenced.Cast<UEStruct>();
+
+			return Struct && StructManager::GetInfo(Struct).IsPartOfCyclicPackage();
+		}
+
+		return (Member.Inner[0] && Self(Self, *Member.Inner[0])) || (Member.Inner[1] && Self(Self, *Member.Inner[1]));
+	};
+
+	const int32 NumTypeShapes = TypeIR::GetNumTypeShapes();
+
+	TypeStringCache.clear();
+	TypeStringCache.resize(NumTypeShapes);
+
+	for (int i = 0; i < NumTypeShapes; i++)
+	{
+		const TypeIR::PropertyNode& Shape = TypeIR::GetTypeShape(i);
+
+		if (DependsOnPackage(DependsOnPackage, Shape))
+			continue;
+
+		CachedTypeString& Cached = TypeStringCache[i];
+		Cached.Type = BuildMemberTypeStringWithoutConst(Shape, -1, &Cached.bIsUnknownProperty);
+		Cached.bIsValid = true;
+	}
+}
 
-	EClassCastFlags Flags = Class ? Class.GetCastFlags() : FieldClass.GetCastFlags();
+std::string CppGenerator::BuildMemberTypeStringWithoutConst(const TypeIR::PropertyNode& Member, int32 PackageIndex, bool* bOutIsUnknownProperty)
+{
+	const EClassCastFlags Flags = Member.CastFlags;
 
 	if (Flags & EClassCastFlags::ByteProperty)
 	{
-		if (UEEnum Enum = Member.Cast<UEByteProperty>().GetEnum())
+		if (UEEnum Enum = Member.Referenced.Cast<UEEnum>())
 			return GetEnumPrefixedName(Enum);
 
 		return "uint8";
@@ -1024,7 +1131,7 @@ std::string CppGenerator::GetMemberTypeStringWithoutConst(UEProperty Member, int
 	else if (Flags & EClassCastFlags::ClassProperty)
 	{
 		if (Member.HasPropertyFlags(EPropertyFlags::UObjectWrapper))
-			return std::format("TSubclassOf<class {}>", GetStructPrefixedName(Member.Cast<UEClassProperty>().GetMetaClass()));
+			return std::format("TSubclassOf<class {}>", GetStructPrefixedName(Member.MetaClass.Cast<UEClass>()));
 
 		return "class UClass*";
 	}
@@ -1042,11 +1149,11 @@ std::string CppGenerator::GetMemberTypeStringWithoutConst(UEProperty Member, int
 	}
 	else if (Flags & EClassCastFlags::BoolProperty)
 	{
-		return Member.Cast<UEBoolProperty>().IsNativeBool() ? "bool" : GetTypeFromSize(Member.GetSize());
+		return Member.bIsNativeBool ? "bool" : GetTypeFromSize(Member.Size);
 	}
 	else if (Flags & EClassCastFlags::StructProperty)
 	{
-		const StructWrapper& UnderlayingStruct = Member.Cast<UEStructProperty>().GetUnderlayingStruct();
+		const StructWrapper& UnderlayingStruct = Member.Referenced.Cast<UEStruct>();
 
 		if (UnderlayingStruct.IsCyclicWithPackage(PackageIndex)) [[unlikely]]
 			return std::format("{}", GetCycleFixupType(UnderlayingStruct, false));
@@ -1055,84 +1162,82 @@ std::string CppGenerator::GetMemberTypeStringWithoutConst(UEProperty Member, int
 	}
 	else if (Flags & EClassCastFlags::ArrayProperty)
 	{
-		return std::format("TArray<{}>", GetMemberTypeStringWithoutConst(Member.Cast<UEArrayProperty>().GetInnerProperty(), PackageIndex));
+		return std::format("TArray<{}>", GetMemberTypeStringWithoutConst(*Member.Inner[0], PackageIndex));
 	}
 	else if (Flags & EClassCastFlags::WeakObjectProperty)
 	{
-		if (UEClass PropertyClass = Member.Cast<UEWeakObjectProperty>().GetPropertyClass())
+		if (UEClass PropertyClass = Member.Referenced.Cast<UEClass>())
 			return std::format("TWeakObjectPtr<class {}>", GetStructPrefixedName(PropertyClass));
 
 		return "TWeakObjectPtr<class UObject>";
 	}
 	else if (Flags & EClassCastFlags::LazyObjectProperty)
 	{
-		if (UEClass PropertyClass = Member.Cast<UELazyObjectProperty>().GetPropertyClass())
+		if (UEClass PropertyClass = Member.Referenced.Cast<UEClass>())
 			return std::format("TLazyObjectPtr<class {}>", GetStructPrefixedName(PropertyClass));
 
 		return "TLazyObjectPtr<class UObject>";
 	}
 	else if (Flags & EClassCastFlags::SoftClassProperty)
 	{
-		if (UEClass PropertyClass = Member.Cast<UESoftClassProperty>().GetPropertyClass())
+		if (UEClass PropertyClass = Member.Referenced.Cast<UEClass>())
 			return std::format("TSoftClassPtr<class {}>", GetStructPrefixedName(PropertyClass));
 
 		return "TSoftClassPtr<class UObject>";
 	}
 	else if (Flags & EClassCastFlags::SoftObjectProperty)
 	{
-		if (UEClass PropertyClass = Member.Cast<UESoftObjectProperty>().GetPropertyClass())
+		if (UEClass PropertyClass = Member.Referenced.Cast<UEClass>())
 			return std::format("TSoftObjectPtr<class {}>", GetStructPrefixedName(PropertyClass));
 
 		return "TSoftObjectPtr<class UObject>";
 	}
 	else if (Flags & EClassCastFlags::ObjectProperty)
 	{
-		if (UEClass PropertyClass = Member.Cast<UEObjectProperty>().GetPropertyClass())
+		if (UEClass PropertyClass = Member.Referenced.Cast<UEClass>())
 			return std::format("class {}*", GetStructPrefixedName(PropertyClass));
 
 		return "class UObject*";
 	}
-	else if (Settings::EngineCore::bEnableEncryptedObjectPropertySupport && Flags & EClassCastFlags::ObjectPropertyBase && Member.GetSize() == 0x10)
+	else if (Settings::EngineCore::bEnableEncryptedObjectPropertySupport && Flags & EClassCastFlags::ObjectPropertyBase && Member.Size == 0x10)
 	{
-		if (UEClass PropertyClass = Member.Cast<UEObjectProperty>().GetPropertyClass())
+		if (UEClass PropertyClass = Member.Referenced.Cast<UEClass>())
 			return std::format("TEncryptedObjPtr<class {}>", GetStructPrefixedName(PropertyClass));
 
 		return "TEncryptedObjPtr<class UObject>";
 	}
 	else if (Flags & EClassCastFlags::MapProperty)
 	{
-		UEMapProperty MemberAsMapProperty = Member.Cast<UEMapProperty>();
-
-		return std::format("TMap<{}, {}>", GetMemberTypeStringWithoutConst(MemberAsMapProperty.GetKeyProperty(), PackageIndex), GetMemberTypeStringWithoutConst(MemberAsMapProperty.GetValueProperty(), PackageIndex));
+		return std::format("TMap<{}, {}>", GetMemberTypeStringWithoutConst(*Member.Inner[0], PackageIndex), GetMemberTypeStringWithoutConst(*Member.Inner[1], PackageIndex));
 	}
 	else if (Flags & EClassCastFlags::SetProperty)
 	{
-		return std::format("TSet<{}>", GetMemberTypeStringWithoutConst(Member.Cast<UESetProperty>().GetElementProperty(), PackageIndex));
+		return std::format("TSet<{}>", GetMemberTypeStringWithoutConst(*Member.Inner[0], PackageIndex));
 	}
 	else if (Flags & EClassCastFlags::EnumProperty)
 	{
-		if (UEEnum Enum = Member.Cast<UEEnumProperty>().GetEnum())
+		if (UEEnum Enum = Member.Referenced.Cast<UEEnum>())
 			return GetEnumPrefixedName(Enum);
 
-		return GetMemberTypeStringWithoutConst(Member.Cast<UEEnumProperty>().GetUnderlayingProperty(), PackageIndex);
+		return GetMemberTypeStringWithoutConst(*Member.Inner[0], PackageIndex);
 	}
 	else if (Flags & EClassCastFlags::InterfaceProperty)
 	{
-		if (UEClass PropertyClass = Member.Cast<UEInterfaceProperty>().GetPropertyClass())
+		if (UEClass PropertyClass = Member.Referenced.Cast<UEClass>())
 			return std::format("TScriptInterface<class {}>", GetStructPrefixedName(PropertyClass));
 
 		return "TScriptInterface<class IInterface>";
 	}
 	else if (Flags & EClassCastFlags::DelegateProperty)
 	{
-		if (UEFunction SignatureFunc = Member.Cast<UEDelegateProperty>().GetSignatureFunction()) [[likely]]
+		if (UEFunction SignatureFunc = Member.Referenced.Cast<UEFunction>()) [[likely]]
 			return std::format("TDelegate<{}>", GetFunctionSignature(SignatureFunc));
 
 		return "TDelegate<void()>";
 	}
 	else if (Flags & EClassCastFlags::MulticastInlineDelegateProperty)
 	{
-		if (UEFunction SignatureFunc = Member.Cast<UEMulticastInlineDelegateProperty>().GetSignatureFunction()) [[likely]]
+		if (UEFunction SignatureFunc = Member.Referenced.Cast<UEFunction>()) [[likely]]
 			return std::format("TMulticastInlineDelegate<{}>", GetFunctionSignature(SignatureFunc));
 
 		return "TMulticastInlineDelegate<void()>";
@@ -1141,20 +1246,20 @@ std::string CppGenerator::GetMemberTypeStringWithoutConst(UEProperty Member, int
 	{
 		if (Settings::Internal::bIsObjPtrInsteadOfFieldPathProperty)
 		{
-			if (UEClass PropertyClass = Member.Cast<UEObjectProperty>().GetPropertyClass())
+			if (UEClass PropertyClass = Member.Referenced.Cast<UEClass>())
 				return std::format("class {}*", GetStructPrefixedName(PropertyClass));
 
 			return "class UObject*";
 		}
 
-		return std::format("TFieldPath<class {}>", Member.Cast<UEFieldPathProperty>().GetFieldClass().GetCppName());
+		return std::format("TFieldPath<class {}>", Member.FieldClassName ? TypeIR::GetName(Member.FieldClassName) : "FField");
 	}
 	else if (Flags & EClassCastFlags::OptionalProperty)
 	{
-		UEProperty ValueProperty = Member.Cast<UEOptionalProperty>().GetValueProperty();
+		const TypeIR::PropertyNode& ValueProperty = *Member.Inner[0];
 
 		/* Check if there is an additional 'bool' flag in the TOptional to check if the value is set */
-		if (Member.GetSize() > ValueProperty.GetSize()) [[likely]]
+		if (Member.Size > ValueProperty.Size) [[likely]]
 			return std::format("TOptional<{}>", GetMemberTypeStringWithoutConst(ValueProperty, PackageIndex));
 
 		return std::format("TOptional<{}, true>", GetMemberTypeStringWithoutConst(ValueProperty, PackageIndex));
@@ -1173,7 +1278,7 @@ std::string CppGenerator::GetMemberTypeStringWithoutConst(UEProperty Member, int
 			*bOutIsUnknownProperty = true;
 
 		/* When changing this also change 'GetUnknownProperties()' */
-		return (Class ? Class.GetCppName() : FieldClass.GetCppName()) + "_";
+		return (Member.Class ? Member.Class.GetCppName() : Member.FieldClass.GetCppName()) + "_";
 	}
 }
 
@@ -1185,10 +1290,7 @@ std::string CppGenerator::GetFunctionSignature(UEFunction Func)
 
 	bool bIsFirstParam = true;
 
-	std::vector<UEProperty> Params = Func.GetProperties();
-	std::sort(Params.begin(), Params.end(), CompareUnrealProperties);
-
-	for (UEProperty Param : Params)
+	for (UEProperty Param : StructMemberCache::GetProperties(Func))
 	{
 		std::string Type = GetMemberTypeString(Param);
 
@@ -1398,12 +1500,12 @@ void CppGenerator::GenerateDebugAssertions(StreamType& AssertionStream)
 		AssertionStream << "\\\n";
 	};
 
-	DependencyManager::OnVisitCallbackType GenerateStructAssertionsCallback = [&AssertionStream, GenerateAssertionsForStruct](int32 Index) -> void
+	auto GenerateStructAssertionsCallback = [&AssertionStream, GenerateAssertionsForStruct](int32 Index) -> void
 	{
 		GenerateAssertionsForStruct(AssertionStream, ObjectArray::GetByIndex<UEStruct>(Index));
 	};
 
-	DependencyManager::OnVisitCallbackType GenerateParamStructAssertionsCallback = [&AssertionStream, GenerateAssertionsForStruct](int32 ClassIndex) -> void
+	auto GenerateParamStructAssertionsCallback = [&AssertionStream, GenerateAssertionsForStruct](int32 ClassIndex) -> void
 	{
 		const StructWrapper Class = ObjectArray::GetByIndex<UEClass>(ClassIndex);
 
@@ -1429,7 +1531,7 @@ void CppGenerator::GenerateDebugAssertions(StreamType& AssertionStream)
 
 			AssertionStream << std::format("\n#define {}_STRUCTS_{} \\\n", Settings::Debug::AssertionMacroPrefix, PackageName);
 
-			Structs.VisitAllNodesWithCallback(GenerateStructAssertionsCallback);
+			Structs.VisitAllNodes(GenerateStructAssertionsCallback);
 		}
 
 		if (Package.HasClasses())
@@ -1437,10 +1539,10 @@ void CppGenerator::GenerateDebugAssertions(StreamType& AssertionStream)
 			const DependencyManager& Classes = Package.GetSortedClasses();
 
 			AssertionStream << std::format("\n#define {}_CLASSES_{} \\\n", Settings::Debug::AssertionMacroPrefix, PackageName);
-			Classes.VisitAllNodesWithCallback(GenerateStructAssertionsCallback);
+			Classes.VisitAllNodes(GenerateStructAssertionsCallback);
 
 			AssertionStream << std::format("\n#define {}_PARAMS_{} \\\n", Settings::Debug::AssertionMacroPrefix, PackageName);
-			Classes.VisitAllNodesWithCallback(GenerateParamStructAssertionsCallback);
+			Classes.VisitAllNodes(GenerateParamStructAssertionsCallback);
 		}
 	}
 
@@ -1471,9 +1573,9 @@ void CppGenerator::GenerateSDKHeader(StreamType& SdkHpp)
 	bool bPrintedStructsHeader = false;
 	bool bPrintedClassesHeader = false;
 
-	auto ForEachElementCallback = [&SdkHpp, &bPrintedStructsHeader, &bPrintedClassesHeader](const PackageManagerIterationParams& OldParams, const PackageManagerIterationParams& NewParams, bool bIsStruct) -> void
+	auto ForEachElementCallback = [&SdkHpp, &bPrintedStructsHeader, &bPrintedClassesHeader](int32 PackageIndex, bool bIsStruct) -> void
 	{
-		PackageInfoHandle CurrentPackage = PackageManager::GetInfo(NewParams.RequiredPackage);
+		PackageInfoHandle CurrentPackage = PackageManager::GetInfo(PackageIndex);
 
 		const bool bHasClassesFile = CurrentPackage.HasClasses();
 		const bool bHasStructsFile = (CurrentPackage.HasStructs() || CurrentPackage.HasEnums());
@@ -1513,6 +1615,120 @@ void CppGenerator::GenerateSDKHeader(StreamType& SdkHpp)
 	WriteFileEnd(SdkHpp, EFileType::SdkHpp);
 }
 
+void CppGenerator::GeneratePrecompiledHeader(StreamType& PchHpp)
+{
+	WriteFileHead(PchHpp, nullptr, EFileType::PrecompiledHeader, "Precompiled header containing Basic.hpp and the package-headers used by most of the SDK");
+
+	const int32 NumPackages = PackageManager::GetNumPackages();
+
+	/* Number of packages reaching the "_structs.hpp"/"_classes.hpp" of a package, directly or through other headers */
+	std::vector<int32> NumStructsUsers(NumPackages, 0x0);
+	std::vector<int32> NumClassesUsers(NumPackages, 0x0);
+
+	for (int32 DenseIndex = 0; DenseIndex < NumPackages; DenseIndex++)
+	{
+		const DependencyInfo& Dependencies = PackageManager::GetInfo(PackageManager::GetPackageIndexFromDense(DenseIndex)).GetPackageDependencies();
+
+		PackageIncludeSet Reachable = Dependencies.TransitiveStructsIncludes;
+		Reachable |= Dependencies.TransitiveClassesIncludes;
+		Reachable |= Dependencies.ParametersDependencies;
+
+		Reachable.ForEach([&](int32 IncludedIndex, bool bIncludesStructs, bool bIncludesClasses) -> void
+		{
+			NumStructsUsers[IncludedIndex] += bIncludesStructs;
+			NumClassesUsers[IncludedIndex] += bIncludesClasses;
+		});
+	}
+
+	const int64 MinNumUsers = (static_cast<int64>(NumPackages) * Settings::CppGenerator::PrecompiledHeaderMinUsagePercent + 99) / 100;
+
+	PchHpp << "#include \"SDK/Basic.hpp\"\n\n";
+
+	/* Same order as SDK.hpp, so every header comes after the headers it depends on */
+	PackageManager::IterateDependencies([&](int32 PackageIndex, bool bIsStruct) -> void
+	{
+		PackageInfoHandle Package = PackageManager::GetInfo(PackageIndex);
+
+		const int32 DenseIndex = PackageManager::GetDenseIndex(PackageIndex);
+
+		if (bIsStruct && (Package.HasStructs() || Package.HasEnums()) && NumStructsUsers[DenseIndex] >= MinNumUsers)
+			PchHpp << std::format("#include \"SDK/{}{}_structs.hpp\"\n", Settings::CppGenerator::FilePrefix, Package.GetName());
+
+		if (!bIsStruct && Package.HasClasses() && NumClassesUsers[DenseIndex] >= MinNumUsers)
+			PchHpp << std::format("#include \"SDK/{}{}_classes.hpp\"\n", Settings::CppGenerator::FilePrefix, Package.GetName());
+	});
+
+	WriteFileEnd(PchHpp, EFileType::PrecompiledHeader);
+}
+
+void CppGenerator::GenerateUnityFiles()
+{
+	constexpr int32 NumPackagesPerFile = Settings::CppGenerator::NumPackagesPerUnityFile;
+
+	/*
+	* Packages are bundled in the order of their "_classes.hpp" in SDK.hpp. Neighbours in that order mostly include the same headers,
+	* so the headers parsed for one package are reused by the following packages in the same file.
+	*/
+	std::vector<PackageInfoHandle> PackagesWithFunctions;
+	std::vector<bool> bWasAdded(PackageManager::GetNumPackages(), false);
+
+	auto AddPackage = [&](int32 PackageIndex) -> void
+	{
+		PackageInfoHandle Package = PackageManager::GetInfo(PackageIndex);
+
+		const int32 DenseIndex = PackageManager::GetDenseIndex(PackageIndex);
+
+		if (!Package.HasFunctions() || bWasAdded[DenseIndex])
+			return;
+
+		bWasAdded[DenseIndex] = true;
+		PackagesWithFunctions.push_back(Package);
+	};
+
+	PackageManager::IterateDependencies([&](int32 PackageIndex, bool bIsStruct) -> void
+	{
+		if (!bIsStruct)
+			AddPackage(PackageIndex);
+	});
+
+	for (PackageInfoHandle Package : PackageManager::IterateOverPackageInfos())
+		AddPackage(Package.GetIndex());
+
+	const int32 NumPackages = static_cast<int32>(PackagesWithFunctions.size());
+
+	for (int32 FileIndex = 0; (FileIndex * NumPackagesPerFile) < NumPackages || FileIndex == 0; FileIndex++)
+	{
+		const std::string FileName = std::format("SDK_Unity_{}.cpp", FileIndex);
+
+		StreamType UnityFile(MainFolder / FileName);
+
+		if (!UnityFile.is_open())
+			std::cerr << "Error opening file \"" << FileName << "\"\n";
+
+		WriteFileHead(UnityFile, nullptr, EFileType::UnityBuild, "Unity-file, compile all SDK_Unity_N.cpp files instead of Basic.cpp and the \"_functions.cpp\" files");
+
+		if constexpr (Settings::CppGenerator::bGeneratePrecompiledHeader)
+			UnityFile << "#include \"SDK_pch.hpp\"\n\n";
+
+		if (FileIndex == 0)
+			UnityFile << "#include \"SDK/Basic.cpp\"\n";
+
+		const int32 FirstPackage = FileIndex * NumPackagesPerFile;
+		const int32 LastPackage = (FirstPackage + NumPackagesPerFile) < NumPackages ? (FirstPackage + NumPackagesPerFile) : NumPackages;
+
+		for (int32 i = FirstPackage; i < LastPackage; i++)
+			UnityFile << std::format("#include \"SDK/{}{}_functions.cpp\"\n", Settings::CppGenerator::FilePrefix, PackagesWithFunctions[i].GetName());
+
+		WriteFileEnd(UnityFile, EFileType::UnityBuild);
+	}
+}
+
+void CppGenerator::GeneratePackageHeader(StreamType& PackageHeader, PackageInfoHandle Package)
+{
+	WriteFileHead(PackageHeader, Package, EFileType::PackageHeader);
+	WriteFileEnd(PackageHeader, EFileType::PackageHeader);
+}
+
 void CppGenerator::WriteFileHead(StreamType& File, PackageInfoHandle Package, EFileType Type, const std::string& CustomFileComment, const std::string& CustomIncludes)
 {
 	namespace CppSettings = Settings::CppGenerator;
@@ -1539,7 +1755,9 @@ void CppGenerator::WriteFileHead(StreamType& File, PackageInfoHandle Package, EF
 	if (!CustomIncludes.empty())
 		File << CustomIncludes + "\n";
 
-	if (Type != EFileType::BasicHpp && Type != EFileType::NameCollisionsInl && Type != EFileType::PropertyFixup && Type != EFileType::SdkHpp && Type != EFileType::DebugAssertions && Type != EFileType::UnrealContainers && Type != EFileType::UnicodeLib)
+	const bool bIsBuildHelper = Type == EFileType::PrecompiledHeader || Type == EFileType::UnityBuild || Type == EFileType::PackageHeader;
+
+	if (Type != EFileType::BasicHpp && Type != EFileType::NameCollisionsInl && Type != EFileType::PropertyFixup && Type != EFileType::SdkHpp && Type != EFileType::DebugAssertions && Type != EFileType::UnrealContainers && Type != EFileType::UnicodeLib && !bIsBuildHelper)
 		File << "#include \"Basic.hpp\"\n";
 
 	if (Type == EFileType::SdkHpp)
@@ -1582,33 +1800,47 @@ void CppGenerator::WriteFileHead(StreamType& File, PackageInfoHandle Package, EF
 
 		File << "\n";
 	}
+	else if (Type == EFileType::PackageHeader)
+	{
+		/* The package's own headers already include exactly the headers they require */
+		std::string PackageName = Settings::CppGenerator::FilePrefix + Package.GetName();
+
+		if (Package.HasStructs() || Package.HasEnums())
+			File << std::format("#include \"{}_structs.hpp\"\n", PackageName);
+
+		if (Package.HasClasses())
+			File << std::format("#include \"{}_classes.hpp\"\n", PackageName);
+	}
 	else if (Package.IsValidHandle())
 	{
 		File << "\n";
 
 		const DependencyInfo& Dep = Package.GetPackageDependencies();
-		const DependencyListType& CurrentDependencyList = Type == EFileType::Structs ? Dep.StructsDependencies : (Type == EFileType::Classes ? Dep.ClassesDependencies : Dep.ParametersDependencies);
+
+		/* Headers already included by another included header are skipped */
+		PackageIncludeSet CurrentDependencyList = Type == EFileType::Structs ? Dep.StructsDependencies : (Type == EFileType::Classes ? Dep.ClassesDependencies : Dep.ParametersDependencies);
+		PackageManager::RemoveTransitiveIncludes(CurrentDependencyList);
 
 		bool bAddNewLine = false;
 
-		for (const auto& [PackageIndex, Requirements] : CurrentDependencyList)
+		CurrentDependencyList.ForEach([&File, &bAddNewLine](int32 DenseIndex, bool bIncludesStructs, bool bIncludesClasses) -> void
 		{
 			bAddNewLine = true;
 
-			std::string DependencyName = PackageManager::GetName(PackageIndex);
+			std::string DependencyName = PackageManager::GetName(PackageManager::GetPackageIndexFromDense(DenseIndex));
 
-			if (Requirements.bShouldIncludeStructs)
+			if (bIncludesStructs)
 				File << std::format("#include \"{}_structs.hpp\"\n", DependencyName);
 
-			if (Requirements.bShouldIncludeClasses)
+			if (bIncludesClasses)
 				File << std::format("#include \"{}_classes.hpp\"\n", DependencyName);
-		}
+		});
 
 		if (bAddNewLine)
 			File << "\n";
 	}
 
-	if (Type == EFileType::SdkHpp || Type == EFileType::NameCollisionsInl || Type == EFileType::UnrealContainers || Type == EFileType::UnicodeLib)
+	if (Type == EFileType::SdkHpp || Type == EFileType::NameCollisionsInl || Type == EFileType::UnrealContainers || Type == EFileType::UnicodeLib || bIsBuildHelper)
 		return; /* No namespace or packing in SDK.hpp or NameCollisions.inl */
 
 
@@ -1639,7 +1871,8 @@ void CppGenerator::WriteFileEnd(StreamType& File, EFileType Type)
 {
 	namespace CppSettings = Settings::CppGenerator;
 
-	if (Type == EFileType::SdkHpp || Type == EFileType::NameCollisionsInl || Type == EFileType::UnrealContainers || Type == EFileType::UnicodeLib)
+	if (Type == EFileType::SdkHpp || Type == EFileType::NameCollisionsInl || Type == EFileType::UnrealContainers || Type == EFileType::UnicodeLib
+		|| Type == EFileType::PrecompiledHeader || Type == EFileType::UnityBuild || Type == EFileType::PackageHeader)
 		return; /* No namespace or packing in SDK.hpp or NameCollisions.inl */
 
 	if (!Settings::Config::SDKNamespaceName.empty() || CppSettings::ParamNamespaceName)
@@ -1656,8 +1889,49 @@ void CppGenerator::WriteFileEnd(StreamType& File, EFileType Type)
 	}
 }
 
+bool CppGenerator::TryReusePackage(PackageInfoHandle Package, const std::u8string& U8FileName, const fs::path& CacheFolder, std::string* OutAssertions)
+{
+	bool bAllFilesExist = true;
+
+	if (Package.HasClasses())
+		bAllFilesExist &= FileManifest::KeepFile(Subfolder / (U8FileName + u8"_classes.hpp"));
+
+	if (Package.HasStructs() || Package.HasEnums())
+		bAllFilesExist &= FileManifest::KeepFile(Subfolder / (U8FileName + u8"_structs.hpp"));
+
+	if (Package.HasParameterStructs())
+		bAllFilesExist &= FileManifest::KeepFile(Subfolder / (U8FileName + u8"_parameters.hpp"));
+
+	if (Package.HasFunctions())
+		bAllFilesExist &= FileManifest::KeepFile(Subfolder / (U8FileName + u8"_functions.cpp"));
+
+	if constexpr (Settings::CppGenerator::bGeneratePackageHeaders)
+		bAllFilesExist &= FileManifest::KeepFile(Subfolder / (U8FileName + u8"_package.hpp"));
+
+	if (!bAllFilesExist)
+		return false;
+
+	if constexpr (Settings::Debug::bGenerateAssertionFile)
+	{
+		/* The assertions of this package are part of Assertions.inl, they were cached separately by the run that generated the package */
+		const fs::path AssertionCachePath = CacheFolder / (U8FileName + u8"_assertions.inl");
+
+		std::ifstream AssertionCache(AssertionCachePath, std::ios::binary);
+
+		if (!AssertionCache.is_open() || !FileManifest::KeepFile(AssertionCachePath))
+			return false;
+
+		OutAssertions->assign(std::istreambuf_iterator<char>(AssertionCache), std::istreambuf_iterator<char>());
+	}
+
+	return true;
+}
+
 void CppGenerator::Generate()
 {
+	// Type-strings of all members and parameters, every package reads them
+	InitTypeStringCache();
+
 	// Generate SDK.hpp with sorted packages
 	StreamType SdkHpp(MainFolder / "SDK.hpp");
 	GenerateSDKHeader(SdkHpp);
@@ -1695,15 +1969,69 @@ void CppGenerator::Generate()
 	GenerateBasicFiles(BasicHpp, BasicCpp, (Settings::Debug::bGenerateAssertionFile ? DebugAssertions : BasicHpp));
 
 
-	// Generates all packages and writes them to files
+	/*
+	* Every package writes to its own set of files, so packages are generated concurrently.
+	* 
+	* Output shared between packages (Assertions.inl) is buffered per package and merged in the order of 'IterateOverPackageInfos', which
+	* keeps the generated files identical to a sequential run.
+	*/
+	std::vector<PackageInfoHandle> PackagesToGenerate;
+
 	for (PackageInfoHandle Package : PackageManager::IterateOverPackageInfos())
 	{
-		if (Package.IsEmpty())
-			continue;
+		if (!Package.IsEmpty())
+			PackagesToGenerate.push_back(Package);
+	}
+
+	std::vector<std::string> AssertionsPerPackage(Settings::Debug::bGenerateAssertionFile ? PackagesToGenerate.size() : 0x0);
+
+	static_assert(!Settings::CppGenerator::bSkipUnchangedPackages || Settings::Generator::bSkipUnchangedFiles, "Skipping packages requires the FileManifest, see Settings::Generator::bSkipUnchangedFiles!");
+
+	/*
+	* CppGenerator.cpp is rebuilt whenever the generator or the constexpr settings change, fingerprints of any other build are discarded.
+	* Settings from Dumper-7.ini that change the text of every package are mixed in, a different SDKNamespaceName invalidates them too.
+	*/
+	const std::string BuildStampText = std::format("{} {}|{}", __DATE__, __TIME__, Settings::Config::SDKNamespaceName);
+	const uint64 BuildStamp = StringHash64(BuildStampText.data(), static_cast<int32>(BuildStampText.size()));
+
+	const fs::path CacheFolder = MainFolder / "Cache";
+	const fs::path FingerprintsPath = CacheFolder / "PackageFingerprints.txt";
+
+	bool bCanReusePackages = false;
+	std::atomic<int32> NumReusedPackages = 0x0;
+
+	if (Settings::CppGenerator::ShouldSkipUnchangedPackages())
+	{
+		std::error_code Error;
+		fs::create_directories(CacheFolder, Error);
+
+		bCanReusePackages = FileManifest::HasPreviousManifest() && PackageFingerprints::Load(FingerprintsPath, BuildStamp);
+
+		/* Regenerations in WatchMode take the fingerprints of packages unaffected by the changes from the previous run, so they're loaded first */
+		PackageFingerprints::Init(bCanReusePackages);
+	}
+
+	// Generates a package and writes it to files
+	auto GeneratePackage = [&](int32 PackageSlot) -> void
+	{
+		const PackageInfoHandle Package = PackagesToGenerate[PackageSlot];
+
+		Profiler::Scope PackageScope("CppGenerator::Package", std::string(Package.GetName()));
 
 		const std::string FileName = Settings::CppGenerator::FilePrefix + Package.GetName();
 		const std::u8string U8FileName = reinterpret_cast<const std::u8string&>(FileName);
 
+		if (bCanReusePackages && PackageFingerprints::IsUnchanged(Package))
+		{
+			std::string* OutAssertions = Settings::Debug::bGenerateAssertionFile ? &AssertionsPerPackage[PackageSlot] : nullptr;
+
+			if (TryReusePackage(Package, U8FileName, CacheFolder, OutAssertions))
+			{
+				NumReusedPackages++;
+				return;
+			}
+		}
+
 		StreamType ClassesFile;
 		StreamType StructsFile;
 		StreamType ParametersFile;
@@ -1712,7 +2040,7 @@ void CppGenerator::Generate()
 		/* Create files and handles namespaces and includes */
 		if (Package.HasClasses())
 		{
-			ClassesFile = StreamType(Subfolder / (U8FileName + u8"_classes.hpp"));
+			ClassesFile.open(Subfolder / (U8FileName + u8"_classes.hpp"));
 
 			if (!ClassesFile.is_open())
 				std::cerr << "Error opening file \"" << (FileName + "_classes.hpp") << "\"\n";
@@ -1725,7 +2053,7 @@ void CppGenerator::Generate()
 
 		if (Package.HasStructs() || Package.HasEnums())
 		{
-			StructsFile = StreamType(Subfolder / (U8FileName + u8"_structs.hpp"));
+			StructsFile.open(Subfolder / (U8FileName + u8"_structs.hpp"));
 
 			if (!StructsFile.is_open())
 				std::cerr << "Error opening file \"" << (FileName + "_structs.hpp") << "\"\n";
@@ -1738,7 +2066,7 @@ void CppGenerator::Generate()
 
 		if (Package.HasParameterStructs())
 		{
-			ParametersFile = StreamType(Subfolder / (U8FileName + u8"_parameters.hpp"));
+			ParametersFile.open(Subfolder / (U8FileName + u8"_parameters.hpp"));
 
 			if (!ParametersFile.is_open())
 				std::cerr << "Error opening file \"" << (FileName + "_parameters.hpp") << "\"\n";
@@ -1748,7 +2076,7 @@ void CppGenerator::Generate()
 
 		if (Package.HasFunctions())
 		{
-			FunctionsFile = StreamType(Subfolder / (U8FileName + u8"_functions.cpp"));
+			FunctionsFile.open(Subfolder / (U8FileName + u8"_functions.cpp"));
 
 			if (!FunctionsFile.is_open())
 				std::cerr << "Error opening file \"" << (FileName + "_functions.cpp") << "\"\n";
@@ -1758,6 +2086,12 @@ void CppGenerator::Generate()
 
 		const int32 PackageIndex = Package.GetIndex();
 
+		/* Member-lists and in-header code of this package are carved from the arena and released in one go once the package is written */
+		GeneratorArena::PackageScope PackageArena;
+
+		/* Assertions of all packages end up in the same file, they are buffered and appended in package-order once every package is done */
+		std::ostringstream PackageAssertions;
+
 		/* 
 		* Generate classes/structs/enums/functions directly into the respective files
 		* 
@@ -1772,28 +2106,28 @@ void CppGenerator::Generate()
 		{
 			const DependencyManager& Structs = Package.GetSortedStructs();
 
-			StreamType& FileForAssertions = Settings::Debug::bGenerateAssertionFile ? DebugAssertions : StructsFile;
+			std::ostream& FileForAssertions = Settings::Debug::bGenerateAssertionFile ? static_cast<std::ostream&>(PackageAssertions) : StructsFile;
 
-			DependencyManager::OnVisitCallbackType GenerateStructCallback = [&](int32 Index) -> void
+			auto GenerateStructCallback = [&](int32 Index) -> void
 			{
 				GenerateStruct(ObjectArray::GetByIndex<UEStruct>(Index), StructsFile, FunctionsFile, ParametersFile, FileForAssertions, PackageIndex);
 			};
 
-			Structs.VisitAllNodesWithCallback(GenerateStructCallback);
+			Structs.VisitAllNodes(GenerateStructCallback);
 		}
 
 		if (Package.HasClasses())
 		{
 			const DependencyManager& Classes = Package.GetSortedClasses();
 
-			StreamType& FileForAssertions = Settings::Debug::bGenerateAssertionFile ? DebugAssertions : ClassesFile;
+			std::ostream& FileForAssertions = Settings::Debug::bGenerateAssertionFile ? static_cast<std::ostream&>(PackageAssertions) : ClassesFile;
 
-			DependencyManager::OnVisitCallbackType GenerateClassCallback = [&](int32 Index) -> void
+			auto GenerateClassCallback = [&](int32 Index) -> void
 			{
 				GenerateStruct(ObjectArray::GetByIndex<UEStruct>(Index), ClassesFile, FunctionsFile, ParametersFile, FileForAssertions, PackageIndex);
 			};
 
-			Classes.VisitAllNodesWithCallback(GenerateClassCallback);
+			Classes.VisitAllNodes(GenerateClassCallback);
 		}
 
 
@@ -1809,14 +2143,161 @@ void CppGenerator::Generate()
 
 		if (Package.HasFunctions())
 			WriteFileEnd(FunctionsFile, EFileType::Functions);
+
+		if constexpr (Settings::CppGenerator::bGeneratePackageHeaders)
+		{
+			StreamType PackageHeader(Subfolder / (U8FileName + u8"_package.hpp"));
+			GeneratePackageHeader(PackageHeader, Package);
+		}
+
+		if constexpr (Settings::Debug::bGenerateAssertionFile)
+		{
+			AssertionsPerPackage[PackageSlot] = std::move(PackageAssertions).str();
+
+			if (Settings::CppGenerator::ShouldSkipUnchangedPackages())
+			{
+				StreamType AssertionCache(CacheFolder / (U8FileName + u8"_assertions.inl"), std::ios::binary);
+				AssertionCache << AssertionsPerPackage[PackageSlot];
+			}
+		}
+	};
+
+	if (MemoryBudget::IsEnabled())
+	{
+		GeneratePackagesInWaves(PackagesToGenerate, GeneratePackage);
+	}
+	else
+	{
+		WorkerPool::ParallelFor(static_cast<int32>(PackagesToGenerate.size()), GeneratePackage);
+	}
+
+	if (Settings::CppGenerator::ShouldSkipUnchangedPackages())
+	{
+		StreamType FingerprintsFile(FingerprintsPath, std::ios::binary);
+		FingerprintsFile << PackageFingerprints::Serialize(BuildStamp);
+
+		std::cerr << std::format("Reused {} of {} packages from the previous run.\n", NumReusedPackages.load(), PackagesToGenerate.size());
+	}
+
+	for (const std::string& Assertions : AssertionsPerPackage)
+		DebugAssertions << Assertions;
+
+	if constexpr (Settings::CppGenerator::bGeneratePrecompiledHeader)
+	{
+		StreamType PchHpp(MainFolder / "SDK_pch.hpp");
+		GeneratePrecompiledHeader(PchHpp);
 	}
 
+	if constexpr (Settings::CppGenerator::NumPackagesPerUnityFile > 0)
+		GenerateUnityFiles();
+
 	if constexpr (Settings::Debug::bGenerateAssertionFile)
 	{
 		WriteFileEnd(DebugAssertions, EFileType::DebugAssertions);
 	}
 }
 
+void CppGenerator::GeneratePackagesInWaves(const std::vector<PackageInfoHandle>& Packages, const std::function<void(int32 PackageSlot)>& GeneratePackage)
+{
+	constexpr double BytesPerMiB = 1024.0 * 1024.0;
+
+	/* Slots of 'Packages' in the order their headers are included by SDK.hpp, packages every other package depends on come first */
+	std::vector<int32> SlotsInDependencyOrder;
+	SlotsInDependencyOrder.reserve(Packages.size());
+
+	{
+		std::unordered_map<int32, int32> SlotsByPackageIndex;
+		SlotsByPackageIndex.reserve(Packages.size());
+
+		for (int32 Slot = 0; Slot < static_cast<int32>(Packages.size()); Slot++)
+			SlotsByPackageIndex.emplace(Packages[Slot].GetIndex(), Slot);
+
+		std::vector<bool> bIsOrdered(Packages.size(), false);
+
+		auto AddPackage = [&](int32 PackageIndex) -> void
+		{
+			auto It = SlotsByPackageIndex.find(PackageIndex);
+
+			if (It != SlotsByPackageIndex.end() && !bIsOrdered[It->second])
+			{
+				bIsOrdered[It->second] = true;
+				SlotsInDependencyOrder.push_back(It->second);
+			}
+		};
+
+		PackageManager::IterateDependencies([&](int32 PackageIndex, bool bIsStruct) -> void { AddPackage(PackageIndex); });
+
+		/* Packages containing neither structs nor classes, eg. enums only */
+		for (const PackageInfoHandle& Package : Packages)
+			AddPackage(Package.GetIndex());
+	}
+
+	/* Built by InitInternal, these stay resident until the end of the run */
+	MemoryReport Resident = StructManager::GetMemoryReport();
+	Resident += EnumManager::GetMemoryReport();
+	Resident += MemberManager::GetMemoryReport();
+	Resident += PackageManager::GetMemoryReport();
+	Resident += TypeIR::GetMemoryReport();
+	Resident += StructMemberCache::GetMemoryReport();
+	Resident += StructHierarchy::GetMemoryReport();
+	Resident += ObjectArraySnapshot::GetMemoryReport();
+	Resident += ObjectArray::GetLookupTablesMemoryReport();
+	Resident += GetTypeStringCacheMemoryReport();
+
+	const uint64 BudgetBytes = MemoryBudget::GetBudgetBytes();
+	const uint64 WaveBudgetBytes = BudgetBytes > Resident.BytesAllocated ? BudgetBytes - Resident.BytesAllocated : 0x0;
+
+	if (WaveBudgetBytes == 0x0)
+		std::cerr << std::format("The managers and their tables alone use {:.2f}MiB of the {}MiB memory-budget, packages are generated one at a time.\n", Resident.BytesAllocated / BytesPerMiB, Settings::Config::MemoryBudgetMB);
+
+	const int32 NumPackages = static_cast<int32>(SlotsInDependencyOrder.size());
+	const int32 MaxWaveSize = std::max(WorkerPool::GetNumWorkers(), 1) * 0x10;
+
+	/* The first wave has one package per thread, the following ones are sized after the memory the previous wave needed per package */
+	int32 WaveSize = WaveBudgetBytes > 0x0 ? std::max(WorkerPool::GetNumWorkers(), 1) : 0x1;
+	int32 NumWaves = 0x0;
+	uint64 PeakBytes = 0x0;
+
+	/* Files written before the packages, eg. Basic.hpp, aren't part of any wave */
+	BufferedFileStream::WaitForPendingWrites();
+
+	for (int32 First = 0; First < NumPackages;)
+	{
+		const int32 Count = std::min(WaveSize, NumPackages - First);
+
+		MemoryBudget::ResetPeak();
+
+		WorkerPool::ParallelFor(Count, [&](int32 i) -> void
+		{
+			GeneratePackage(SlotsInDependencyOrder[First + i]);
+		});
+
+		/* Output-buffers of this wave are released once they're written */
+		BufferedFileStream::WaitForPendingWrites();
+
+		const uint64 WavePeakBytes = MemoryBudget::GetPeakTransientBytes();
+		PeakBytes = std::max(PeakBytes, WavePeakBytes);
+
+		First += Count;
+		NumWaves++;
+
+		if (WaveBudgetBytes == 0x0)
+			continue;
+
+		/* At most doubles, packages further down the dependency-order can be a lot larger than the ones before */
+		const uint64 BytesPerPackage = std::max<uint64>(WavePeakBytes / Count, 0x1);
+		const uint64 MaxNextWaveSize = static_cast<uint64>(std::min(Count * 2, MaxWaveSize));
+
+		WaveSize = static_cast<int32>(std::clamp<uint64>(WaveBudgetBytes / BytesPerPackage, 0x1, MaxNextWaveSize));
+	}
+
+	std::cerr << std::format("Generated {} packages in {} waves, peak memory {:.2f}MiB ({:.2f}MiB resident tables, {:.2f}MiB arenas and output-buffers) of a {}MiB budget.\n",
+		NumPackages, NumWaves, (Resident.BytesAllocated + PeakBytes) / BytesPerMiB, Resident.BytesAllocated / BytesPerMiB, PeakBytes / BytesPerMiB, Settings::Config::MemoryBudgetMB);
+
+	if (Resident.BytesAllocated + PeakBytes > BudgetBytes)
+		std::cerr << "Warning: The memory-budget was exceeded, single packages need more memory than the budget has room for.\n";
+}
+
 void CppGenerator::InitPredefinedMembers()
 {
 	static auto SortMembers = [](std::vector<PredefinedMember>& Members) -> void
@@ -2206,6 +2687,9 @@ void CppGenerator::InitPredefinedMembers()
 	}
 	else
 	{
+		/* Structs of a previous generation, see Generator::Regenerate */
+		PredefinedStructs.clear();
+
 		/* Reserving enough space is required because otherwise the vector could reallocate and invalidate some structs' 'Super' pointer */
 		PredefinedStructs.reserve(0x20);
 
@@ -2400,13 +2884,22 @@ void CppGenerator::InitPredefinedFunctions()
 
 	PredefinedElements& UObjectPredefs = PredefinedMembers[ObjectArray::FindClassFast("Object").GetIndex()];
 
+	/* With the object-index both lookups go through Basic.cpp, see 'BasicFilesImpleUtils::FindObjectIndexed' */
+	constexpr const char* FindObjectImplIndexedBody = R"({
+	return BasicFilesImpleUtils::FindObjectIndexed(FullName, true, static_cast<uint64>(RequiredType));
+})";
+
+	constexpr const char* FindObjectFastImplIndexedBody = R"({
+	return BasicFilesImpleUtils::FindObjectIndexed(Name, false, static_cast<uint64>(RequiredType));
+})";
+
 	UObjectPredefs.Functions =
 	{
 		/* static non-inline functions */
 		PredefinedFunction {
 			.CustomComment = "Finds a UObject in the global object array by full-name, optionally with ECastFlags to reduce heavy string comparison",
 			.ReturnType = "class UObject*", .NameWithParams = "FindObjectImpl(const std::string& FullName, EClassCastFlags RequiredType = EClassCastFlags::None)",
-			.NameWithParamsWithoutDefaults = "FindObjectImpl(const std::string& FullName, EClassCastFlags RequiredType)", .Body =
+			.NameWithParamsWithoutDefaults = "FindObjectImpl(const std::string& FullName, EClassCastFlags RequiredType)", .Body = Settings::CppGenerator::bAddObjectLookupIndex ? FindObjectImplIndexedBody :
 R"({
 	for (int i = 0; i < GObjects->Num(); ++i)
 	{
@@ -2426,7 +2919,7 @@ R"({
 		PredefinedFunction {
 			.CustomComment = "Finds a UObject in the global object array by name, optionally with ECastFlags to reduce heavy string comparison",
 			.ReturnType = "class UObject*", .NameWithParams = "FindObjectFastImpl(const std::string& Name, EClassCastFlags RequiredType = EClassCastFlags::None)",
-			.NameWithParamsWithoutDefaults = "FindObjectFastImpl(const std::string& Name, EClassCastFlags RequiredType)", .Body =
+			.NameWithParamsWithoutDefaults = "FindObjectFastImpl(const std::string& Name, EClassCastFlags RequiredType)", .Body = Settings::CppGenerator::bAddObjectLookupIndex ? FindObjectFastImplIndexedBody :
 R"({
 	for (int i = 0; i < GObjects->Num(); ++i)
 	{
@@ -2557,15 +3050,38 @@ R"({
 			.bIsStatic = false, .bIsConst = true, .bIsBodyInline = false
 		},
 
-		/* non-static inline functions */
-		PredefinedFunction{
-			.CustomComment = "Unreal Function to process all UFunction-calls",
-			.ReturnType = "void", .NameWithParams = "ProcessEvent(class UFunction* Function, void* Parms)", .Body = std::format(
+		PredefinedFunction {
+			.CustomComment = "Calls 'Function' on this object once for each of the 'NumCalls' parameter-structs in 'ParmsArray', which are 'ParmsSize' bytes apart. ProcessEvent is only resolved once for all calls.",
+			.ReturnType = "void", .NameWithParams = "ProcessEventBatch(class UFunction* Function, void* ParmsArray, int32 ParmsSize, int32 NumCalls)", .Body = std::format(
+R"({{
+	const auto ProcessEventFunc = InSDKUtils::GetVirtualFunction<void({}*)(const UObject*, class UFunction*, void*)>(this, Offsets::ProcessEventIdx);
+
+	uint8* Parms = static_cast<uint8*>(ParmsArray);
+
+	for (int32 i = 0; i < NumCalls; i++)
+		InSDKUtils::CallGameFunction(ProcessEventFunc, this, Function, Parms ? (Parms + static_cast<uint64>(i) * ParmsSize) : nullptr);
+}})", Platform::Is32Bit() ? "__thiscall" : ""),
+			.bIsStatic = false, .bIsConst = true, .bIsBodyInline = false
+		},
+
+		/* non-static inline functions */
+		PredefinedFunction{
+			.CustomComment = "Unreal Function to process all UFunction-calls",
+			.ReturnType = "void", .NameWithParams = "ProcessEvent(class UFunction* Function, void* Parms)", .Body = std::format(
 R"({{
 	InSDKUtils::CallGameFunction(InSDKUtils::GetVirtualFunction<void({}*)(const UObject*, class UFunction*, void*)>(this, Offsets::ProcessEventIdx), this, Function, Parms);
 }})", Platform::Is32Bit() ? "__thiscall" : ""),
 			.bIsStatic = false, .bIsConst = true, .bIsBodyInline = true
 		},
+		PredefinedFunction{
+			.CustomComment = "Calls 'Function' once for every element of 'ParmsArray', e.g. an array of the 'Params::' struct of that function",
+			.CustomTemplateText = "template<typename ParamsType>",
+			.ReturnType = "void", .NameWithParams = "ProcessEventBatch(class UFunction* Function, ParamsType* ParmsArray, int32 NumCalls)", .Body =
+R"({
+	ProcessEventBatch(Function, static_cast<void*>(ParmsArray), static_cast<int32>(sizeof(ParamsType)), NumCalls);
+})",
+			.bIsStatic = false, .bIsConst = true, .bIsBodyInline = true
+		},
 	};
 
 	UEClass Struct = ObjectArray::FindClassFast("Struct");
@@ -3478,8 +3994,40 @@ void CppGenerator::GenerateBasicFiles(StreamType& BasicHpp, StreamType& BasicCpp
 #include <type_traits>
 )";
 
+	std::string BasicCppIncludes = "#include <Windows.h>";
+
+	if constexpr (CppSettings::bAddObjectLookupIndex || CppSettings::bCacheNameStrings)
+		BasicCppIncludes += "\n\n#include <mutex>\n#include <vector>\n#include <unordered_map>";
+
+	if constexpr (CppSettings::bCacheNameStrings)
+		BasicCppIncludes += "\n#include <shared_mutex>";
+
+	if constexpr (CppSettings::bAddObjectLookupIndex)
+		BasicCppIncludes += "\n#include <algorithm>";
+
+	const UEClass WorldClass = ObjectArray::FindClassFast("World");
+
+	/* The registry walks UWorld::Levels, or only UWorld::PersistentLevel if the world has no list of levels */
+	const bool bWorldHasLevels = WorldClass && WorldClass.FindMember("Levels", EClassCastFlags::ArrayProperty);
+	const bool bWorldHasPersistentLevel = WorldClass && WorldClass.FindMember("PersistentLevel", EClassCastFlags::ObjectProperty);
+
+	const bool bGenerateActorRegistry = CppSettings::bAddActorRegistry && Off::InSDK::ULevel::Actors != -1 && (bWorldHasLevels || bWorldHasPersistentLevel);
+
+	if (bGenerateActorRegistry)
+	{
+		CustomIncludes += "#include <span>\n";
+
+		if constexpr (!CppSettings::bAddObjectLookupIndex && !CppSettings::bCacheNameStrings)
+			BasicCppIncludes += "\n\n#include <mutex>\n#include <vector>\n#include <unordered_map>";
+
+		if constexpr (!CppSettings::bAddObjectLookupIndex)
+			BasicCppIncludes += "\n#include <algorithm>";
+
+		BasicCppIncludes += "\n#include <unordered_set>";
+	}
+
 	WriteFileHead(BasicHpp, nullptr, EFileType::BasicHpp, "Basic file containing structs required by the SDK", CustomIncludes);
-	WriteFileHead(BasicCpp, nullptr, EFileType::BasicCpp, "Basic file containing function-implementations from Basic.hpp", "#include <Windows.h>");
+	WriteFileHead(BasicCpp, nullptr, EFileType::BasicCpp, "Basic file containing function-implementations from Basic.hpp", BasicCppIncludes);
 
 
 	/* use namespace of UnrealContainers */
@@ -3582,6 +4130,17 @@ namespace BasicFilesImpleUtils
 }
 )";
 
+	if constexpr (CppSettings::bAddObjectLookupIndex)
+	{
+		BasicHpp << R"(
+namespace BasicFilesImpleUtils
+{
+	/* Implementation of UObject::FindObjectImpl and UObject::FindObjectFastImpl, looks the name up in an index of GObjects before searching all objects */
+	UObject* FindObjectIndexed(const std::string& Name, bool bIsFullName, uint64 RequiredTypeFlags);
+}
+)";
+	}
+
 	BasicCpp << R"(
 class UClass* BasicFilesImpleUtils::FindClassByName(const std::string& Name, bool bByFullName)
 {
@@ -3612,9 +4171,151 @@ class UObject* BasicFilesImpleUtils::GetObjectByIndex(int32 Index)
 {
 	return UObject::GObjects->GetByIndex(Index);
 }
+)";
+
+	if constexpr (CppSettings::bAddObjectLookupIndex || CppSettings::bCacheNameStrings)
+	{
+		/* The object-index and the name-cache group by the integer-parts of an FName, names are only converted to strings once per distinct FName */
+		const char* NameKeyExpression = Settings::Internal::bUseOutlineNumberName
+			? "static_cast<uint32>(Name.GetDisplayIndex())"
+			: "(static_cast<uint64>(Name.Number) << 32) | static_cast<uint32>(Name.GetDisplayIndex())";
+
+		BasicCpp << std::format(R"(
+namespace
+{{
+	/* FNames with equal keys have equal strings */
+	inline uint64 GetNameKey(const FName& Name)
+	{{
+		return {};
+	}}
+}}
+)", NameKeyExpression);
+	}
+
+	if constexpr (CppSettings::bAddObjectLookupIndex)
+	{
+		BasicCpp << R"(
+namespace
+{
+	/*
+	* Index of GObjects, built by the first lookup and extended whenever GObjects->Num() grew since the previous lookup.
+	*
+	* Every hit is verified against the object currently in that slot. Objects that were renamed, or created in slots that were free
+	* while indexing, are found by searching all objects and are added to the index afterwards.
+	*/
+	struct FObjectLookupIndex
+	{
+		std::mutex Lock;
+
+		/* Objects in [0, NumIndexedObjects) are part of the index */
+		int32 NumIndexedObjects = 0;
+
+		/* Name-key -> indices of every object with that name */
+		std::unordered_map<uint64, std::vector<int32>> ObjectsByName;
+
+		/* Object-name -> name-key */
+		std::unordered_map<std::string, uint64> NameKeys;
+	};
+
+	FObjectLookupIndex ObjectLookupIndex;
+
+	/* Requires ObjectLookupIndex.Lock. The fallback search adds objects that may already be indexed under this name, e.g. ones that were renamed back. */
+	void AddToObjectIndex(class UObject* Object, int32 Index)
+	{
+		const uint64 Key = GetNameKey(Object->Name);
+
+		auto [It, bIsNewName] = ObjectLookupIndex.ObjectsByName.try_emplace(Key);
+
+		if (bIsNewName)
+			ObjectLookupIndex.NameKeys.emplace(Object->GetName(), Key);
+
+		std::vector<int32>& Indices = It->second;
+
+		if (std::find(Indices.begin(), Indices.end(), Index) == Indices.end())
+			Indices.push_back(Index);
+	}
+
+	/* Requires ObjectLookupIndex.Lock */
+	void UpdateObjectIndex()
+	{
+		const int32 NumObjects = UObject::GObjects->Num();
+
+		for (int32 i = ObjectLookupIndex.NumIndexedObjects; i < NumObjects; i++)
+		{
+			if (class UObject* Object = UObject::GObjects->GetByIndex(i))
+				AddToObjectIndex(Object, i);
+		}
+
+		if (NumObjects > ObjectLookupIndex.NumIndexedObjects)
+			ObjectLookupIndex.NumIndexedObjects = NumObjects;
+	}
+}
+
+class UObject* BasicFilesImpleUtils::FindObjectIndexed(const std::string& Name, bool bIsFullName, uint64 RequiredTypeFlags)
+{
+	const EClassCastFlags RequiredType = static_cast<EClassCastFlags>(RequiredTypeFlags);
+
+	auto IsMatch = [&](class UObject* Object) -> bool
+	{
+		return Object && Object->HasTypeFlag(RequiredType) && (bIsFullName ? Object->GetFullName() == Name : Object->GetName() == Name);
+	};
+
+	{
+		std::scoped_lock Lock(ObjectLookupIndex.Lock);
+
+		UpdateObjectIndex();
+
+		/* A full-name ends with the name of the object itself */
+		const size_t NameStart = bIsFullName ? Name.find_last_of(" .:/") : std::string::npos;
+		const std::string ObjectName = NameStart != std::string::npos ? Name.substr(NameStart + 1) : Name;
+
+		if (auto KeyIt = ObjectLookupIndex.NameKeys.find(ObjectName); KeyIt != ObjectLookupIndex.NameKeys.end())
+		{
+			for (int32 Index : ObjectLookupIndex.ObjectsByName[KeyIt->second])
+			{
+				class UObject* Object = UObject::GObjects->GetByIndex(Index);
+
+				if (IsMatch(Object))
+					return Object;
+			}
+		}
+	}
+
+	for (int i = 0; i < UObject::GObjects->Num(); ++i)
+	{
+		class UObject* Object = UObject::GObjects->GetByIndex(i);
+
+		if (!IsMatch(Object))
+			continue;
+
+		std::scoped_lock Lock(ObjectLookupIndex.Lock);
+		AddToObjectIndex(Object, i);
+
+		return Object;
+	}
+
+	return nullptr;
+}
 
 UFunction* BasicFilesImpleUtils::FindFunctionByFName(const FName* Name)
 {
+	{
+		std::scoped_lock Lock(ObjectLookupIndex.Lock);
+
+		UpdateObjectIndex();
+
+		if (auto It = ObjectLookupIndex.ObjectsByName.find(GetNameKey(*Name)); It != ObjectLookupIndex.ObjectsByName.end())
+		{
+			for (int32 Index : It->second)
+			{
+				class UObject* Object = UObject::GObjects->GetByIndex(Index);
+
+				if (Object && Object->Name == *Name)
+					return static_cast<UFunction*>(Object);
+			}
+		}
+	}
+
 	for (int i = 0; i < UObject::GObjects->Num(); ++i)
 	{
 		UObject* Object = UObject::GObjects->GetByIndex(i);
@@ -3628,7 +4329,30 @@ UFunction* BasicFilesImpleUtils::FindFunctionByFName(const FName* Name)
 
 	return nullptr;
 }
+)";
+	}
+	else
+	{
+		BasicCpp << R"(
+UFunction* BasicFilesImpleUtils::FindFunctionByFName(const FName* Name)
+{
+	for (int i = 0; i < UObject::GObjects->Num(); ++i)
+	{
+		UObject* Object = UObject::GObjects->GetByIndex(i);
+
+		if (!Object)
+			continue;
 
+		if (Object->Name == *Name)
+			return static_cast<UFunction*>(Object);
+	}
+
+	return nullptr;
+}
+)";
+	}
+
+	BasicCpp << R"(
 FName BasicFilesImpleUtils::StringToName(const wchar_t* Name)
 {
 	return UKismetStringLibrary::Conv_StringToName(FString(Name));
@@ -4689,6 +5413,80 @@ std::format(R"({{
 			});
 	}
 
+	if constexpr (Settings::CppGenerator::bCacheNameStrings)
+	{
+		/* The string of an FName never changes, the uncached conversion stays available as 'GetRawStringUncached' */
+		auto GetRawStringIt = std::find_if(FName.Functions.begin(), FName.Functions.end(), [](const PredefinedFunction& Func) { return Func.NameWithParams == "GetRawString()"; });
+		GetRawStringIt->NameWithParams = "GetRawStringUncached()";
+
+		FName.Functions.insert(GetRawStringIt + 1,
+		{
+			PredefinedFunction {
+				.CustomComment = "Raw string of this name, every distinct FName is only converted once",
+				.ReturnType = "std::string", .NameWithParams = "GetRawString()", .Body =
+R"({
+	const uint64 Key = GetNameKey(*this);
+
+	{
+		std::shared_lock Lock(NameStringCache.Lock);
+
+		if (auto It = NameStringCache.Strings.find(Key); It != NameStringCache.Strings.end())
+			return It->second;
+	}
+
+	std::string RawString = GetRawStringUncached();
+
+	std::unique_lock Lock(NameStringCache.Lock);
+
+	NameStringCache.Names.try_emplace(RawString, *this);
+	NameStringCache.Strings.try_emplace(Key, RawString);
+
+	return RawString;
+})",
+				.bIsStatic = false, .bIsConst = true, .bIsBodyInline = false
+			},
+			PredefinedFunction {
+				.CustomComment = "FName of a raw name-string, for integer comparisons instead of string comparisons. Names that don't exist yet are added to the game's name-table.",
+				.ReturnType = "FName", .NameWithParams = "FindName(const std::string& RawString)", .Body =
+R"({
+	{
+		std::shared_lock Lock(NameStringCache.Lock);
+
+		if (auto It = NameStringCache.Names.find(RawString); It != NameStringCache.Names.end())
+			return It->second;
+	}
+
+	const FName Name = BasicFilesImpleUtils::StringToName(UtfN::StringToWString<std::string>(RawString).c_str());
+
+	std::unique_lock Lock(NameStringCache.Lock);
+	NameStringCache.Names.try_emplace(RawString, Name);
+
+	return Name;
+})",
+				.bIsStatic = true, .bIsConst = false, .bIsBodyInline = false
+			},
+		});
+
+		BasicCpp << R"(
+namespace
+{
+	/* Strings of the FNames converted by FName::GetRawString, and the FNames of the strings passed to FName::FindName */
+	struct FNameStringCache
+	{
+		std::shared_mutex Lock;
+
+		/* Name-key -> raw string */
+		std::unordered_map<uint64, std::string> Strings;
+
+		/* Raw string -> FName */
+		std::unordered_map<std::string, FName> Names;
+	};
+
+	FNameStringCache NameStringCache;
+}
+)";
+	}
+
 	GenerateStruct(&FName, BasicHpp, BasicCpp, BasicHpp, AssertionsFile);
 
 
@@ -5830,6 +6628,341 @@ template<typename UnderlayingClassType, int32 Size, int32 Align = 0x8>
 using TActorBasedCycleFixup = CyclicDependencyFixupImpl::TCyclicClassFixup<UnderlayingClassType, Size, Align, class AActor>;
 )";
 
+	if (bGenerateActorRegistry)
+	{
+		BasicHpp << R"(
+class AActor;
+
+/*
+* Index of the actors of all levels of the current world, grouped by class. Update() once per frame, then query actors by class instead of
+* walking ULevel::Actors and calling IsA on every actor.
+*
+* Update() only diffs the actor-arrays of levels whose contents changed since the previous call. Classes are matched against a query once,
+* when the class or the query is first seen, afterwards a query is a lookup of the actors collected for it.
+*/
+namespace ActorRegistry
+{
+	/* Snapshots the actor-arrays of all levels of UWorld::GetWorld(). A different world drops all previous snapshots and queries. */
+	void Update();
+
+	/* Drops all snapshots and queries */
+	void Clear();
+
+	/* Actors that were a 'Class' at the time of the last Update(). The span stays valid until the next call to Update() or Clear(). */
+	std::span<class AActor* const> GetActorsOfClass(const class UClass* Class);
+
+	template<typename ActorType>
+	inline std::span<ActorType* const> GetActorsOfClass()
+	{
+		const std::span<class AActor* const> Actors = GetActorsOfClass(ActorType::StaticClass());
+
+		return std::span<ActorType* const>(reinterpret_cast<ActorType* const*>(Actors.data()), Actors.size());
+	}
+}
+)";
+
+		BasicCpp << R"(
+namespace
+{
+	struct FRegisteredActor
+	{
+		/* Class of the actor when it was registered, removed actors might be destroyed already and are never dereferenced */
+		class UClass* Class;
+		int32 IndexInBucket;
+	};
+
+	struct FActorQuery
+	{
+		/* Every class with registered actors which is a subclass of the queried class */
+		std::vector<const class UClass*> Classes;
+
+		std::vector<class AActor*> Actors;
+		bool bIsDirty = true;
+	};
+
+	struct FLevelSnapshot
+	{
+		class ULevel* Level;
+		std::vector<class AActor*> Actors;
+
+		/* Class of every actor when the snapshot was taken, a destroyed actor whose address was reused by a new one changes it */
+		std::vector<class UClass*> Classes;
+
+		bool bIsLoaded;
+	};
+
+	struct FActorRegistryState
+	{
+		std::mutex Lock;
+
+		class UWorld* World = nullptr;
+
+		std::vector<FLevelSnapshot> Levels;
+
+		/* Every actor in any of the level-snapshots */
+		std::unordered_map<class AActor*, FRegisteredActor> Actors;
+
+		/* Class -> actors of exactly this class */
+		std::unordered_map<const class UClass*, std::vector<class AActor*>> ActorsByClass;
+
+		/* Queried class -> actors of this class or any subclass */
+		std::unordered_map<const class UClass*, FActorQuery> Queries;
+
+		/* Class -> queries this class is part of */
+		std::unordered_map<const class UClass*, std::vector<FActorQuery*>> QueriesByClass;
+	};
+
+	FActorRegistryState ActorRegistryState;
+
+	/* Requires ActorRegistryState.Lock */
+	void ResetActorRegistry()
+	{
+		ActorRegistryState.World = nullptr;
+		ActorRegistryState.Levels.clear();
+		ActorRegistryState.Actors.clear();
+		ActorRegistryState.ActorsByClass.clear();
+		ActorRegistryState.Queries.clear();
+		ActorRegistryState.QueriesByClass.clear();
+	}
+
+	/* Requires ActorRegistryState.Lock */
+	void MarkQueriesDirty(const class UClass* Class)
+	{
+		for (FActorQuery* Query : ActorRegistryState.QueriesByClass[Class])
+			Query->bIsDirty = true;
+	}
+
+	void UnregisterActor(class AActor* Actor);
+
+	/* Requires ActorRegistryState.Lock */
+	void RegisterActor(class AActor* Actor)
+	{
+		if (!Actor || !Actor->Class)
+			return;
+
+		class UClass* Class = Actor->Class;
+
+		auto [It, bIsNewActor] = ActorRegistryState.Actors.try_emplace(Actor);
+
+		if (!bIsNewActor)
+		{
+			if (It->second.Class == Class)
+				return;
+
+			/* A new actor at the address of a destroyed one, it belongs into the bucket of its own class */
+			UnregisterActor(Actor);
+			It = ActorRegistryState.Actors.try_emplace(Actor).first;
+		}
+
+		auto [BucketIt, bIsNewClass] = ActorRegistryState.ActorsByClass.try_emplace(Class);
+
+		/* The class-hierarchy is only walked once for every pair of class and query */
+		if (bIsNewClass)
+		{
+			std::vector<FActorQuery*>& ClassQueries = ActorRegistryState.QueriesByClass[Class];
+
+			for (auto& [QueryClass, Query] : ActorRegistryState.Queries)
+			{
+				if (!Class->IsSubclassOf(QueryClass))
+					continue;
+
+				Query.Classes.push_back(Class);
+				ClassQueries.push_back(&Query);
+			}
+		}
+
+		It->second = FRegisteredActor{ Class, static_cast<int32>(BucketIt->second.size()) };
+		BucketIt->second.push_back(Actor);
+
+		MarkQueriesDirty(Class);
+	}
+
+	/* Requires ActorRegistryState.Lock */
+	void UnregisterActor(class AActor* Actor)
+	{
+		auto It = ActorRegistryState.Actors.find(Actor);
+
+		if (It == ActorRegistryState.Actors.end())
+			return;
+
+		const FRegisteredActor Registered = It->second;
+		std::vector<class AActor*>& Bucket = ActorRegistryState.ActorsByClass[Registered.Class];
+
+		/* Swap with the last actor of the bucket, so removal doesn't shift the bucket */
+		class AActor* LastActor = Bucket.back();
+		Bucket[Registered.IndexInBucket] = LastActor;
+		ActorRegistryState.Actors[LastActor].IndexInBucket = Registered.IndexInBucket;
+		Bucket.pop_back();
+
+		ActorRegistryState.Actors.erase(Actor);
+
+		MarkQueriesDirty(Registered.Class);
+	}
+
+	/* Actors of the current array are alive, their classes can be read */
+	bool HasLevelChanged(const FLevelSnapshot& Snapshot, const TArray<class AActor*>& LevelActors)
+	{
+		if (static_cast<int32>(Snapshot.Actors.size()) != LevelActors.Num())
+			return true;
+
+		for (int32 i = 0; i < LevelActors.Num(); i++)
+		{
+			if (Snapshot.Actors[i] != LevelActors[i] || (LevelActors[i] && Snapshot.Classes[i] != LevelActors[i]->Class))
+				return true;
+		}
+
+		return false;
+	}
+}
+
+void ActorRegistry::Update()
+{
+	std::scoped_lock Lock(ActorRegistryState.Lock);
+
+	class UWorld* World = UWorld::GetWorld();
+
+	if (World != ActorRegistryState.World)
+	{
+		ResetActorRegistry();
+		ActorRegistryState.World = World;
+	}
+
+	if (!World)
+		return;
+
+	std::vector<class ULevel*> CurrentLevels;
+)";
+
+		if (bWorldHasLevels)
+		{
+			BasicCpp << R"(
+	for (int32 i = 0; i < World->Levels.Num(); i++)
+	{
+		if (World->Levels[i])
+			CurrentLevels.push_back(World->Levels[i]);
+	}
+)";
+		}
+		else
+		{
+			BasicCpp << R"(
+	if (World->PersistentLevel)
+		CurrentLevels.push_back(World->PersistentLevel);
+)";
+		}
+
+		BasicCpp << R"(
+	for (FLevelSnapshot& Snapshot : ActorRegistryState.Levels)
+		Snapshot.bIsLoaded = false;
+
+	/* Index of the snapshot -> current contents of the levels' actor-array */
+	std::vector<std::pair<size_t, std::vector<class AActor*>>> ChangedLevels;
+
+	for (class ULevel* Level : CurrentLevels)
+	{
+		auto It = std::find_if(ActorRegistryState.Levels.begin(), ActorRegistryState.Levels.end(), [Level](const FLevelSnapshot& Snapshot) { return Snapshot.Level == Level; });
+
+		if (It == ActorRegistryState.Levels.end())
+			It = ActorRegistryState.Levels.insert(It, FLevelSnapshot{ Level, {}, {}, false });
+
+		It->bIsLoaded = true;
+
+		const TArray<class AActor*>& LevelActors = Level->Actors;
+
+		if (!HasLevelChanged(*It, LevelActors))
+			continue;
+
+		std::vector<class AActor*> Actors(LevelActors.Num());
+
+		for (int32 i = 0; i < LevelActors.Num(); i++)
+			Actors[i] = LevelActors[i];
+
+		ChangedLevels.emplace_back(static_cast<size_t>(It - ActorRegistryState.Levels.begin()), std::move(Actors));
+	}
+
+	/* Levels that were unloaded since the last update lose all of their actors */
+	for (size_t i = 0; i < ActorRegistryState.Levels.size(); i++)
+	{
+		if (!ActorRegistryState.Levels[i].bIsLoaded)
+			ChangedLevels.emplace_back(i, std::vector<class AActor*>{});
+	}
+
+	/* Removals first, so an actor that moved from one level to another in between two updates stays registered */
+	for (const auto& [SnapshotIndex, Actors] : ChangedLevels)
+	{
+		const std::unordered_set<class AActor*> CurrentActors(Actors.begin(), Actors.end());
+
+		for (class AActor* Actor : ActorRegistryState.Levels[SnapshotIndex].Actors)
+		{
+			if (!CurrentActors.contains(Actor))
+				UnregisterActor(Actor);
+		}
+	}
+
+	for (auto& [SnapshotIndex, Actors] : ChangedLevels)
+	{
+		std::vector<class UClass*> Classes(Actors.size());
+
+		for (size_t i = 0; i < Actors.size(); i++)
+		{
+			RegisterActor(Actors[i]);
+			Classes[i] = Actors[i] ? Actors[i]->Class : nullptr;
+		}
+
+		ActorRegistryState.Levels[SnapshotIndex].Actors = std::move(Actors);
+		ActorRegistryState.Levels[SnapshotIndex].Classes = std::move(Classes);
+	}
+
+	std::erase_if(ActorRegistryState.Levels, [](const FLevelSnapshot& Snapshot) { return !Snapshot.bIsLoaded; });
+}
+
+void ActorRegistry::Clear()
+{
+	std::scoped_lock Lock(ActorRegistryState.Lock);
+
+	ResetActorRegistry();
+}
+
+std::span<class AActor* const> ActorRegistry::GetActorsOfClass(const class UClass* Class)
+{
+	if (!Class)
+		return {};
+
+	std::scoped_lock Lock(ActorRegistryState.Lock);
+
+	auto [It, bIsNewQuery] = ActorRegistryState.Queries.try_emplace(Class);
+	FActorQuery& Query = It->second;
+
+	if (bIsNewQuery)
+	{
+		for (const auto& [ActorClass, Bucket] : ActorRegistryState.ActorsByClass)
+		{
+			if (!ActorClass->IsSubclassOf(Class))
+				continue;
+
+			Query.Classes.push_back(ActorClass);
+			ActorRegistryState.QueriesByClass[ActorClass].push_back(&Query);
+		}
+	}
+
+	if (Query.bIsDirty)
+	{
+		Query.Actors.clear();
+
+		for (const class UClass* ActorClass : Query.Classes)
+		{
+			const std::vector<class AActor*>& Bucket = ActorRegistryState.ActorsByClass[ActorClass];
+			Query.Actors.insert(Query.Actors.end(), Bucket.begin(), Bucket.end());
+		}
+
+		Query.bIsDirty = false;
+	}
+
+	return Query.Actors;
+}
+)";
+	}
+
 	// Generate ML Support if enabled
 	if constexpr (Settings::MachineLearning::bEnableMLSupport)
 	{
@@ -5913,7 +7046,7 @@ namespace ML
 void CppGenerator::GenerateUnrealContainers(StreamType& UEContainersHeader)
 {
 	WriteFileHead(UEContainersHeader, nullptr, EFileType::UnrealContainers, 
-		"Container implementations with iterators. See https://github.com/Fischsalat/UnrealContainers", "#include <string>\n#include <stdexcept>\n#include <iostream>\n#include \"UtfN.hpp\"");
+		"Container implementations with iterators. See https://github.com/Fischsalat/UnrealContainers", "#include <string>\n#include <stdexcept>\n#include <iostream>\n#include \"UtfN.hpp\"\n\n#if defined(_MSC_VER)\n#include <intrin.h>\n#endif");
 
 
 	UEContainersHeader << R"(
@@ -5987,6 +7120,32 @@ namespace UC
 
 				return 31 - FloorLog2(Value);
 			}
+
+			inline uint32 CountTrailingZeros(uint32 Value)
+			{
+				if (Value == 0)
+					return 32;
+
+#if defined(_MSC_VER)
+				unsigned long Index;
+				_BitScanForward(&Index, Value);
+				return Index;
+#elif defined(__GNUC__) || defined(__clang__)
+				return __builtin_ctz(Value);
+#else
+				return FloorLog2(Value & (~Value + 1));
+#endif
+			}
+
+			/* Only a hint to the CPU, prefetching an address that isn't mapped doesn't fault */
+			inline void Prefetch(const void* Address)
+			{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+				_mm_prefetch(static_cast<const char*>(Address), _MM_HINT_T0);
+#elif defined(__GNUC__) || defined(__clang__)
+				__builtin_prefetch(Address);
+#endif
+			}
 		}
 
 		template<int32 Size, uint32 Alignment>
@@ -6515,6 +7674,9 @@ namespace UC
 	public:
 		const ContainerImpl::FBitArray& GetAllocationFlags() const { return AllocationFlags; }
 
+		/* Address of the element at Index, whether it's allocated or not. Only meant for prefetching. */
+		inline const void* GetElementAddressUnsafe(int32 Index) const { return reinterpret_cast<const uint8*>(Data.GetDataPtr()) + static_cast<int64>(Index) * sizeof(FElementOrFreeListLink); }
+
 	public:
 		inline       SparseArrayElementType& operator[](int32 Index)       { VerifyIndex(Index); return *reinterpret_cast<SparseArrayElementType*>(&Data.GetUnsafe(Index).ElementData); }
 		inline const SparseArrayElementType& operator[](int32 Index) const { VerifyIndex(Index); return *reinterpret_cast<SparseArrayElementType*>(&Data.GetUnsafe(Index).ElementData); }
@@ -6572,6 +7734,66 @@ namespace UC
 	public:
 		const ContainerImpl::FBitArray& GetAllocationFlags() const { return Elements.GetAllocationFlags(); }
 
+		inline const void* GetElementAddressUnsafe(int32 Index) const { return Elements.GetElementAddressUnsafe(Index); }
+
+		/* HashSize is always a power of two once the engine allocated the buckets */
+		inline bool HasHashBuckets() const { return HashSize > 0 && (HashSize & (HashSize - 1)) == 0 && Hash.GetAllocation(); }
+
+	public:
+		/* Index of the first element Pred returns true for, or -1 */
+		template<typename PredicateType>
+		inline int32 FindIndexLinear(PredicateType&& Pred) const
+		{
+			for (int32 i = 0; i < NumAllocated(); i++)
+			{
+				if (IsValidIndex(i) && Pred(Elements[i].Value))
+					return i;
+			}
+
+			return -1;
+		}
+
+		/*
+		* Walks the chain of the bucket KeyHash falls into, like the engine does. KeyHash has to be computed exactly like the engine's GetTypeHash
+		* for the element type, otherwise the element is looked for in the wrong bucket. Falls back to a linear search if there are no buckets.
+		*/
+		template<typename PredicateType>
+		inline int32 FindIndexByHash(uint32 KeyHash, PredicateType&& Pred) const
+		{
+			if (!HasHashBuckets())
+				return FindIndexLinear(Pred);
+
+			const int32* Buckets = Hash.GetAllocation();
+
+			/* Bounded by the number of elements, so a set that's modified by the game while it's read can't loop forever */
+			int32 NumVisited = 0;
+
+			for (int32 ElementId = Buckets[KeyHash & (HashSize - 1)]; ElementId != -1 && NumVisited < NumAllocated(); ElementId = Elements[ElementId].HashNextId, NumVisited++)
+			{
+				if (Pred(Elements[ElementId].Value))
+					return ElementId;
+			}
+
+			return -1;
+		}
+
+		inline int32 FindIndex(const SetElementType& Element, uint32(*GetTypeHash)(const SetElementType& Element), bool(*Equals)(const SetElementType& Left, const SetElementType& Right)) const
+		{
+			return FindIndexByHash(GetTypeHash(Element), [&](const SetElementType& Other) -> bool { return Equals(Other, Element); });
+		}
+
+		inline decltype(auto) Find(const SetElementType& Element, uint32(*GetTypeHash)(const SetElementType& Element), bool(*Equals)(const SetElementType& Left, const SetElementType& Right))
+		{
+			const int32 Index = FindIndex(Element, GetTypeHash, Equals);
+
+			return Index != -1 ? Iterators::TSetIterator<SetElementType>(*this, GetAllocationFlags(), Index) : end(*this);
+		}
+
+		inline bool Contains(const SetElementType& Element, uint32(*GetTypeHash)(const SetElementType& Element), bool(*Equals)(const SetElementType& Left, const SetElementType& Right)) const
+		{
+			return FindIndex(Element, GetTypeHash, Equals) != -1;
+		}
+
 	public:
 		inline       SetElementType& operator[] (int32 Index)       { return Elements[Index].Value; }
 		inline const SetElementType& operator[] (int32 Index) const { return Elements[Index].Value; }
@@ -6609,6 +7831,8 @@ namespace UC
 	public:
 		const ContainerImpl::FBitArray& GetAllocationFlags() const { return Elements.GetAllocationFlags(); }
 
+		inline const void* GetElementAddressUnsafe(int32 Index) const { return Elements.GetElementAddressUnsafe(Index); }
+
 	public:
 		inline decltype(auto) Find(const KeyElementType& Key, bool(*Equals)(const KeyElementType& LeftKey, const KeyElementType& RightKey))
 		{
@@ -6621,6 +7845,24 @@ namespace UC
 			return end(*this);
 		}
 
+		/* Looks the key up in the hash-buckets of the map. GetTypeHash has to match the engine's GetTypeHash for KeyElementType, see TSet::FindIndexByHash */
+		inline int32 FindIndex(const KeyElementType& Key, uint32(*GetTypeHash)(const KeyElementType& Key), bool(*Equals)(const KeyElementType& LeftKey, const KeyElementType& RightKey)) const
+		{
+			return Elements.FindIndexByHash(GetTypeHash(Key), [&](const ElementType& Pair) -> bool { return Equals(Pair.Key(), Key); });
+		}
+
+		inline decltype(auto) Find(const KeyElementType& Key, uint32(*GetTypeHash)(const KeyElementType& Key), bool(*Equals)(const KeyElementType& LeftKey, const KeyElementType& RightKey))
+		{
+			const int32 Index = FindIndex(Key, GetTypeHash, Equals);
+
+			return Index != -1 ? Iterators::TMapIterator<KeyElementType, ValueElementType>(*this, GetAllocationFlags(), Index) : end(*this);
+		}
+
+		inline bool Contains(const KeyElementType& Key, uint32(*GetTypeHash)(const KeyElementType& Key), bool(*Equals)(const KeyElementType& LeftKey, const KeyElementType& RightKey)) const
+		{
+			return FindIndex(Key, GetTypeHash, Equals) != -1;
+		}
+
 	public:
 		inline       ElementType& operator[] (int32 Index)       { return Elements[Index]; }
 		inline const ElementType& operator[] (int32 Index) const { return Elements[Index]; }
@@ -6716,7 +7958,7 @@ namespace UC
 
 				this->Mask = NewRemainingBitMask ^ RemainingBitMask;
 
-				CurrentBitIndex = BaseBitIndex + NumBitsPerDWORD - 1 - ContainerImpl::HelperFunctions::CountLeadingZeros(this->Mask);
+				CurrentBitIndex = BaseBitIndex + ContainerImpl::HelperFunctions::CountTrailingZeros(RemainingBitMask);
 
 				if (CurrentBitIndex > ArrayNum)
 					CurrentBitIndex = ArrayNum;
@@ -6758,6 +8000,10 @@ namespace UC
 		template<class ContainerType>
 		class TContainerIterator
 		{
+		private:
+			/* Elements ahead of the current one that are prefetched, the gaps between allocated elements are usually small */
+			static constexpr int32 PrefetchDistance = 0x8;
+
 		private:
 			ContainerType& IteratedContainer;
 			FSetBitIterator BitIterator;
@@ -6774,7 +8020,14 @@ namespace UC
 			inline int32 IsValid() { return IteratedContainer.IsValidIndex(GetIndex()); }
 
 		public:
-			inline TContainerIterator& operator++() { ++BitIterator; return *this; }
+			inline TContainerIterator& operator++()
+			{
+				++BitIterator;
+
+				ContainerImpl::HelperFunctions::Prefetch(IteratedContainer.GetElementAddressUnsafe(GetIndex() + PrefetchDistance));
+
+				return *this;
+			}
 			inline TContainerIterator& operator--() { --BitIterator; return *this; }
 
 			inline       auto& operator*()       { return IteratedContainer[GetIndex()]; }
@@ -47,10 +47,10 @@ DSGen::EType DumpspaceGenerator::GetMemberEType(const PropertyWrapper& Property)
 	if (!Property.IsUnrealProperty())
 		return DSGen::ET_Default;
 
-	return GetMemberEType(Property.GetUnrealProperty());
+	return GetMemberEType(Property.GetTypeNode());
 }
 
-DSGen::EType DumpspaceGenerator::GetMemberEType(UEProperty Prop)
+DSGen::EType DumpspaceGenerator::GetMemberEType(const TypeIR::PropertyNode& Prop)
 {
 	if (Prop.IsA(EClassCastFlags::EnumProperty))
 	{
@@ -58,7 +58,7 @@ DSGen::EType DumpspaceGenerator::GetMemberEType(UEProperty Prop)
 	}
 	else if (Prop.IsA(EClassCastFlags::ByteProperty))
 	{
-		if (Prop.Cast<UEByteProperty>().GetEnum())
+		if (Prop.Referenced)
 			return DSGen::ET_Enum;
 	}
 	//else if (Prop.IsA(EClassCastFlags::ClassProperty))
@@ -83,17 +83,13 @@ DSGen::EType DumpspaceGenerator::GetMemberEType(UEProperty Prop)
 	return DSGen::ET_Default;
 }
 
-std::string DumpspaceGenerator::GetMemberTypeStr(UEProperty Property, std::string& OutExtendedType, std::vector<DSGen::MemberType>& OutSubtypes)
+std::string DumpspaceGenerator::GetMemberTypeStr(const TypeIR::PropertyNode& Member, std::string& OutExtendedType, std::vector<DSGen::MemberType>& OutSubtypes)
 {
-	UEProperty Member = Property;
-
-	auto [Class, FieldClass] = Member.GetClass();
-
-	EClassCastFlags Flags = Class ? Class.GetCastFlags() : FieldClass.GetCastFlags();
+	const EClassCastFlags Flags = Member.CastFlags;
 
 	if (Flags & EClassCastFlags::ByteProperty)
 	{
-		if (UEEnum Enum = Member.Cast<UEByteProperty>().GetEnum())
+		if (UEEnum Enum = Member.Referenced.Cast<UEEnum>())
 			return GetEnumPrefixedName(Enum);
 
 		return "uint8";
@@ -138,7 +134,7 @@ std::string DumpspaceGenerator::GetMemberTypeStr(UEProperty Property, std::strin
 	{
 		if (Member.HasPropertyFlags(EPropertyFlags::UObjectWrapper))
 		{
-			OutSubtypes.emplace_back(GetMemberType(Member.Cast<UEClassProperty>().GetMetaClass()));
+			OutSubtypes.emplace_back(GetMemberType(Member.MetaClass.Cast<UEClass>()));
 
 			return "TSubclassOf";
 		}
@@ -161,23 +157,23 @@ std::string DumpspaceGenerator::GetMemberTypeStr(UEProperty Property, std::strin
 	}
 	else if (Flags & EClassCastFlags::BoolProperty)
 	{
-		return Member.Cast<UEBoolProperty>().IsNativeBool() ? "bool" : "uint8";
+		return Member.bIsNativeBool ? "bool" : "uint8";
 	}
 	else if (Flags & EClassCastFlags::StructProperty)
 	{
-		const StructWrapper& UnderlayingStruct = Member.Cast<UEStructProperty>().GetUnderlayingStruct();
+		const StructWrapper& UnderlayingStruct = Member.Referenced.Cast<UEStruct>();
 
 		return GetStructPrefixedName(UnderlayingStruct);
 	}
 	else if (Flags & EClassCastFlags::ArrayProperty)
 	{
-		OutSubtypes.push_back(GetMemberType(Member.Cast<UEArrayProperty>().GetInnerProperty()));
+		OutSubtypes.push_back(GetMemberType(*Member.Inner[0]));
 
 		return "TArray";
 	}
 	else if (Flags & EClassCastFlags::WeakObjectProperty)
 	{
-		if (UEClass PropertyClass = Member.Cast<UEWeakObjectProperty>().GetPropertyClass()) 
+		if (UEClass PropertyClass = Member.Referenced.Cast<UEClass>()) 
 		{
 			OutSubtypes.push_back(GetMemberType(PropertyClass));
 		}
@@ -190,7 +186,7 @@ std::string DumpspaceGenerator::GetMemberTypeStr(UEProperty Property, std::strin
 	}
 	else if (Flags & EClassCastFlags::LazyObjectProperty)
 	{
-		if (UEClass PropertyClass = Member.Cast<UELazyObjectProperty>().GetPropertyClass())
+		if (UEClass PropertyClass = Member.Referenced.Cast<UEClass>())
 		{
 			OutSubtypes.push_back(GetMemberType(PropertyClass));
 		}
@@ -203,7 +199,7 @@ std::string DumpspaceGenerator::GetMemberTypeStr(UEProperty Property, std::strin
 	}
 	else if (Flags & EClassCastFlags::SoftClassProperty)
 	{
-		if (UEClass PropertyClass = Member.Cast<UESoftClassProperty>().GetPropertyClass())
+		if (UEClass PropertyClass = Member.Referenced.Cast<UEClass>())
 		{
 			OutSubtypes.push_back(GetMemberType(PropertyClass));
 		}
@@ -216,7 +212,7 @@ std::string DumpspaceGenerator::GetMemberTypeStr(UEProperty Property, std::strin
 	}
 	else if (Flags & EClassCastFlags::SoftObjectProperty)
 	{
-		if (UEClass PropertyClass = Member.Cast<UESoftObjectProperty>().GetPropertyClass())
+		if (UEClass PropertyClass = Member.Referenced.Cast<UEClass>())
 		{
 			OutSubtypes.push_back(GetMemberType(PropertyClass));
 		}
@@ -231,43 +227,41 @@ std::string DumpspaceGenerator::GetMemberTypeStr(UEProperty Property, std::strin
 	{
 		OutExtendedType = "*";
 
-		if (UEClass PropertyClass = Member.Cast<UEObjectProperty>().GetPropertyClass())
+		if (UEClass PropertyClass = Member.Referenced.Cast<UEClass>())
 			return GetStructPrefixedName(PropertyClass);
 		
 		return "UObject";
 	}
-	else if (Settings::EngineCore::bEnableEncryptedObjectPropertySupport && Flags & EClassCastFlags::ObjectPropertyBase && Member.GetSize() == 0x10)
+	else if (Settings::EngineCore::bEnableEncryptedObjectPropertySupport && Flags & EClassCastFlags::ObjectPropertyBase && Member.Size == 0x10)
 	{
-		if (UEClass PropertyClass = Member.Cast<UEObjectProperty>().GetPropertyClass())
+		if (UEClass PropertyClass = Member.Referenced.Cast<UEClass>())
 			return std::format("TEncryptedObjPtr<class {}>", GetStructPrefixedName(PropertyClass));
 
 		return "TEncryptedObjPtr<class UObject>";
 	}
 	else if (Flags & EClassCastFlags::MapProperty)
 	{
-		UEMapProperty MemberAsMapProperty = Member.Cast<UEMapProperty>();
-
-		OutSubtypes.emplace_back(GetMemberType(Member.Cast<UEMapProperty>().GetKeyProperty()));
-		OutSubtypes.emplace_back(GetMemberType(Member.Cast<UEMapProperty>().GetValueProperty()));
+		OutSubtypes.emplace_back(GetMemberType(*Member.Inner[0]));
+		OutSubtypes.emplace_back(GetMemberType(*Member.Inner[1]));
 
 		return "TMap";
 	}
 	else if (Flags & EClassCastFlags::SetProperty)
 	{
-		OutSubtypes.emplace_back(GetMemberType(Member.Cast<UESetProperty>().GetElementProperty()));
+		OutSubtypes.emplace_back(GetMemberType(*Member.Inner[0]));
 
 		return "TSet";
 	}
 	else if (Flags & EClassCastFlags::EnumProperty)
 	{
-		if (UEEnum Enum = Member.Cast<UEEnumProperty>().GetEnum())
+		if (UEEnum Enum = Member.Referenced.Cast<UEEnum>())
 			return GetEnumPrefixedName(Enum);
 
 		return "NamelessEnumIGuessIdkWhatToPutHereWithRegardsTheGuyFromDumper7";
 	}
 	else if (Flags & EClassCastFlags::InterfaceProperty)
 	{
-		if (UEClass PropertyClass = Member.Cast<UEInterfaceProperty>().GetPropertyClass())
+		if (UEClass PropertyClass = Member.Referenced.Cast<UEClass>())
 		{
 			OutSubtypes.push_back(GetMemberType(PropertyClass));
 		}
@@ -285,15 +279,15 @@ std::string DumpspaceGenerator::GetMemberTypeStr(UEProperty Property, std::strin
 		{
 			OutExtendedType = "*";
 
-			if (UEClass PropertyClass = Member.Cast<UEObjectProperty>().GetPropertyClass())
+			if (UEClass PropertyClass = Member.Referenced.Cast<UEClass>())
 				return GetStructPrefixedName(PropertyClass);
 
 			return "UObject";
 		}
 
-		if (UEFFieldClass PropertyClass = Member.Cast<UEFieldPathProperty>().GetFieldClass())
+		if (Member.FieldClassName)
 		{
-			OutSubtypes.push_back(ManualCreateMemberType(DSGen::ET_Struct, PropertyClass.GetCppName()));
+			OutSubtypes.push_back(ManualCreateMemberType(DSGen::ET_Struct, std::string(TypeIR::GetName(Member.FieldClassName))));
 		}
 		else
 		{
@@ -304,16 +298,14 @@ std::string DumpspaceGenerator::GetMemberTypeStr(UEProperty Property, std::strin
 	}
 	else if (Flags & EClassCastFlags::OptionalProperty)
 	{
-		UEProperty ValueProperty = Member.Cast<UEOptionalProperty>().GetValueProperty();
-
-		OutSubtypes.push_back(GetMemberType(ValueProperty));
+		OutSubtypes.push_back(GetMemberType(*Member.Inner[0]));
 
 		return "TOptional";
 	}
 	else
 	{
 		/* When changing this also change 'GetUnknownProperties()' */
-		return (Class ? Class.GetCppName() : FieldClass.GetCppName()) + "_";
+		return (Member.Class ? Member.Class.GetCppName() : Member.FieldClass.GetCppName()) + "_";
 	}
 }
 
@@ -338,21 +330,32 @@ DSGen::MemberType DumpspaceGenerator::GetMemberType(const PropertyWrapper& Prope
 		return Type;
 	}
 
-	Type.reference = bIsReference;
-	Type.type = GetMemberEType(Property);
-	Type.typeName = GetMemberTypeStr(Property.GetUnrealProperty(), Type.extendedType, Type.subTypes);
-
-	return Type;
+	return GetMemberType(Property.GetTypeNode(), bIsReference);
 }
 
-DSGen::MemberType DumpspaceGenerator::GetMemberType(UEProperty Property, bool bIsReference)
+DSGen::MemberType DumpspaceGenerator::GetMemberType(const TypeIR::PropertyNode& Property, bool bIsReference)
 {
+	const bool bIsCacheable = Property.TypeShape >= 0 && Property.TypeShape < static_cast<int32>(MemberTypeCache.size());
+
+	if (bIsCacheable && MemberTypeCache[Property.TypeShape]) [[likely]]
+	{
+		DSGen::MemberType Type = *MemberTypeCache[Property.TypeShape];
+		Type.reference = bIsReference;
+
+		return Type;
+	}
+
 	DSGen::MemberType Type;
 
-	Type.reference = bIsReference;
+	Type.reference = false;
 	Type.type = GetMemberEType(Property);
 	Type.typeName = GetMemberTypeStr(Property, Type.extendedType, Type.subTypes);
 
+	if (bIsCacheable)
+		MemberTypeCache[Property.TypeShape] = Type;
+
+	Type.reference = bIsReference;
+
 	return Type;
 }
 
@@ -477,11 +480,17 @@ void DumpspaceGenerator::Generate()
 	/* Set the output directory of DSGen to "...GenerationPath/GameVersion-GameName/Dumespace" */
 	DSGen::setDirectory(MainFolder);
 
+	/* Records are written to disk as soon as they're baked */
+	DSGen::setCompression(Settings::DumpspaceGenerator::bCompressOutput, Settings::DumpspaceGenerator::CompressionLevel);
+
 	/* Add offsets for GObjects, GNames, GWorld, AppendString, PrcessEvent and ProcessEventIndex*/
 	GeneratedStaticOffsets();
 
+	/* Types of a previous generation would reference type-shapes that no longer exist */
+	MemberTypeCache.assign(TypeIR::GetNumTypeShapes(), std::nullopt);
+
 	// Optimization: Pre-define lambda to avoid repeated creation
-	DependencyManager::OnVisitCallbackType GenerateClassOrStructCallback = [](int32 Index) -> void
+	auto GenerateClassOrStructCallback = [](int32 Index) -> void
 	{
 		DSGen::ClassHolder StructOrClass = GenerateStruct(ObjectArray::GetByIndex<UEStruct>(Index));
 		DSGen::bakeStructOrClass(StructOrClass);
@@ -510,14 +519,14 @@ void DumpspaceGenerator::Generate()
 		if (Package.HasStructs()) [[likely]]
 		{
 			const DependencyManager& Structs = Package.GetSortedStructs();
-			Structs.VisitAllNodesWithCallback(GenerateClassOrStructCallback);
+			Structs.VisitAllNodes(GenerateClassOrStructCallback);
 		}
 
 		// Process classes if package has them
 		if (Package.HasClasses()) [[likely]]
 		{
 			const DependencyManager& Classes = Package.GetSortedClasses();
-			Classes.VisitAllNodesWithCallback(GenerateClassOrStructCallback);
+			Classes.VisitAllNodes(GenerateClassOrStructCallback);
 		}
 	}
 
@@ -1,11 +1,24 @@
 
+#include <chrono>
+#include <format>
+
 #include "Generators/Generator.h"
+#include "Unreal/StructMemberCache.h"
+#include "Unreal/StructHierarchy.h"
+#include "Unreal/NameArray.h"
+#include "OffsetFinder/OffsetCache.h"
 #include "Managers/StructManager.h"
 #include "Managers/EnumManager.h"
 #include "Managers/MemberManager.h"
 #include "Managers/PackageManager.h"
+#include "TypeIR.h"
+#include "TaskGraph.h"
+#include "FileManifest.h"
+#include "PackageFingerprints.h"
 
 #include "HashStringTable.h"
+#include "Profiler.h"
+#include "TimeSlicer.h"
 #include "Utils.h"
 
 #include "Platform.h"
@@ -39,38 +52,479 @@ void Generator::InitEngineCore()
 	/* Multiversus [Unsupported, weird GObjects-struct] */
 	//InitObjectArrayDecryption([](void* ObjPtr) -> uint8* { return reinterpret_cast<uint8*>(uint64(ObjPtr) ^ 0x1B5DEAFD6B4068C); });
 
-	ObjectArray::Init();
+	/* Validation loops during the offset-search look up readable memory in this snapshot instead of calling VirtualQuery for every address */
+	if constexpr (Settings::General::bUseMemoryRegionCache)
+		Platform::RefreshMemoryRegionCache();
+
+	/* A replayed MemorySnapshot brings its own offsets, see Generator::LoadMemorySnapshot. None of its game-code may be called. */
+	const bool bIsReplaying = MemorySnapshot::IsReplaying();
+
+	/* An attached process can't be scanned either, its offsets are loaded by Generator::AttachToProcess */
+	const bool bIsExternal = ProcessMemory::IsExternal();
+
+	const bool bHasCachedOffsets = bIsReplaying || bIsExternal || OffsetCache::Load();
+
+	auto ExitIfExternal = [bIsExternal](const char* Message) -> void
+	{
+		if (!bIsExternal)
+			return;
+
+		std::cerr << Message << " Run the dumper inside of the game once to find it.\n\n";
+		exit(1);
+	};
 
-	CALL_PLATFORM_SPECIFIC_FUNCTION(FName::Init);
+	Profiler::Scope EngineCoreScope("Generator::InitEngineCore");
 
-	Off::Init();
-	PropertySizes::Init();
+	if (!OffsetCache::TryInitObjectArray())
+	{
+		ExitIfExternal("The cached GObjects offset is invalid for the attached process.");
+
+		Profiler::Scope InitScope("ObjectArray::Init");
+		ObjectArray::Init();
+	}
+
+	bool bUsedCachedFName = OffsetCache::TryInitFName();
+
+	/*
+	* Off::Init finds the UObject offsets by reading names, so a cached FName is verified before it runs. Name 0 is "None" in every engine version
+	* and a zeroed FName refers to it no matter where CompIdx and Number are, which doesn't require any offset that Off::Init would find.
+	*/
+	if (bUsedCachedFName)
+	{
+		alignas(alignof(void*)) const uint8 NoneName[0x10] = {};
 
-	CALL_PLATFORM_SPECIFIC_FUNCTION(Off::InSDK::ProcessEvent::InitPE); // Must be at this position, relies on offsets initialized in Off::Init()
+		/* NoneName is memory of this process, an attached process is asked for entry 0 of its GNames instead */
+		const std::string NoneString = bIsExternal ? NameArray::GetNameEntry(0).GetString() : FName(NoneName).ToRawString();
 
-	Off::InSDK::World::InitGWorld(); // Must be at this position, relies on offsets initialized in Off::Init()
+		if (NoneString != "None")
+		{
+			std::cerr << "Cached FName offsets produced invalid names, the offset-cache entry will be discarded.\n\n";
+
+			OffsetCache::Invalidate();
+			Off::InSDK::NameArray::GNames = 0x0;
+
+			bUsedCachedFName = false;
+		}
+	}
+
+	if (!bUsedCachedFName)
+	{
+		ExitIfExternal("The cached GNames offset is invalid for the attached process.");
+
+		Profiler::Scope InitScope("FName::Init");
+		CALL_PLATFORM_SPECIFIC_FUNCTION(FName::Init);
+	}
+
+	{
+		Profiler::Scope InitScope("Off::Init");
+		Off::Init();
+	}
 
-	Off::InSDK::Text::InitTextOffsets(); // Must be at this position, relies on offsets initialized in Off::InitPE()
+	FName::PostInit(); // Must be at this position, the name-cache relies on the FName layout determined in Off::Init()
+	ObjectArray::PostInit(); // Must be at this position, name lookup tables rely on offsets initialized in Off::Init()
+	UEObject::InitOuterPrefixCache(); // Must be at this position, cached outer-names rely on offsets initialized in Off::Init()
+
+	{
+		Profiler::Scope InitScope("PropertySizes::Init");
+		PropertySizes::Init();
+	}
+
+	/* Both searches scan the code and data of the main module, the SDK of an attached process only gets them through the offset-cache */
+	if (!OffsetCache::TryInitProcessEvent())
+	{
+		if (!bIsExternal)
+		{
+			CALL_PLATFORM_SPECIFIC_FUNCTION(Off::InSDK::ProcessEvent::InitPE); // Must be at this position, relies on offsets initialized in Off::Init()
+		}
+		else
+		{
+			std::cerr << "The offset-cache entry has no ProcessEvent index, the SDK won't be able to call functions.\n\n";
+		}
+	}
+
+	if (!OffsetCache::TryInitGWorld() && !bIsExternal)
+		Off::InSDK::World::InitGWorld(); // Must be at this position, relies on offsets initialized in Off::Init()
+
+	if (!OffsetCache::TryInitTextOffsets() && !bIsReplaying && !bIsExternal)
+		Off::InSDK::Text::InitTextOffsets(); // Must be at this position, relies on offsets initialized in Off::InitPE()
 
 	InitSettings();
+
+	if (!bIsReplaying && !bIsExternal && (!bHasCachedOffsets || OffsetCache::IsLoaded()))
+		OffsetCache::Save();
+}
+
+bool Generator::CaptureMemorySnapshot()
+{
+	std::string FileName = (Settings::Generator::GameVersion + '-' + Settings::Generator::GameName);
+	FileNameHelper::MakeValidFileName(FileName);
+
+	std::error_code Error;
+	fs::create_directories(GenerationRoot, Error);
+
+	MemorySnapshot::PropertyList Properties = OffsetCache::GetSnapshotProperties();
+	Properties.emplace_back("GameName", Settings::Generator::GameName);
+	Properties.emplace_back("GameVersion", Settings::Generator::GameVersion);
+
+	return MemorySnapshot::Capture(GenerationRoot / (FileName + MemorySnapshotExtension), Properties, Settings::General::bFreezeGameForSnapshot);
 }
 
+bool Generator::LoadMemorySnapshot(const fs::path& FilePath)
+{
+	MemorySnapshot::PropertyList Properties;
+
+	if (!MemorySnapshot::Replay(FilePath, Properties) || !OffsetCache::LoadFromSnapshot(Properties))
+		return false;
+
+	Settings::Generator::GameName = MemorySnapshot::FindProperty(Properties, "GameName");
+	Settings::Generator::GameVersion = MemorySnapshot::FindProperty(Properties, "GameVersion");
+
+	return true;
+}
+
+bool Generator::AttachToProcess(uint32 ProcessId)
+{
+	if (!ProcessMemory::AttachExternal(ProcessId))
+	{
+		std::cerr << std::format("The process {} couldn't be opened for reading!\n\n", ProcessId);
+		return false;
+	}
+
+	if (!OffsetCache::LoadForExternalProcess())
+	{
+		ProcessMemory::DetachExternal();
+		return false;
+	}
+
+	return true;
+}
+
+/* Data produced by the phases of Generator::InitInternal, the phases declare which of it they require */
+enum class EInitData : int32
+{
+	MemoryRegions,
+	ObjectSnapshot,
+	StructMembers,
+	InheritanceTree,
+	PropertyRecords,
+	Packages,
+	StructInfos,
+	EnumInfos,
+	MemberNames,
+	PackageCycles,
+
+	Num
+};
+
 void Generator::InitInternal()
 {
+	using enum EInitData;
+
+	Profiler::Scope InitInternalScope("Generator::InitInternal");
+
+	RecordProcessedObjects();
+
+	if (TimeSlicer::IsEnabled())
+		std::cerr << std::format("Time-slicing is enabled, passes over GObjects pause for {}ms after every {}ms of work.\n\n", Settings::Config::TimeSliceYieldMs, Settings::Config::TimeSliceBudgetMs);
+
+	TaskGraph<EInitData> InitGraph;
+
+	// The game kept running since InitEngineCore, drop regions that were freed in the meantime
+	InitGraph.AddTask("RefreshMemoryRegionCache", []() { if constexpr (Settings::General::bUseMemoryRegionCache) Platform::RefreshMemoryRegionCache(); }, {}, { MemoryRegions });
+
+	// Decode GObjects once, every manager and generator iterates the snapshot afterwards
+	InitGraph.AddTask("ObjectArraySnapshot", []() { if constexpr (Settings::General::bUseObjectArraySnapshot) ObjectArraySnapshot::Build(); }, { MemoryRegions }, { ObjectSnapshot });
+
+	// Collect the sorted properties and functions of every struct, managers and generators read them from the cache
+	InitGraph.AddTask("StructMemberCache", &StructMemberCache::Init, { ObjectSnapshot }, { StructMembers });
+
+	// Number the inheritance tree, UEObject::IsA(UEClass) and UEStruct::HasType become a range-check
+	InitGraph.AddTask("StructHierarchy", &StructHierarchy::Init, { ObjectSnapshot }, { InheritanceTree });
+
+	// Extract types, offsets and names of all cached properties and functions once, every generator emits from these records
+	InitGraph.AddTask("TypeIR", &TypeIR::Init, { StructMembers, InheritanceTree }, { PropertyRecords });
+
 	// Initialize PackageManager with all packages, their names, structs, classes enums, functions and dependencies
-	PackageManager::Init();
+	InitGraph.AddTask("PackageManager", &PackageManager::Init, { StructMembers, InheritanceTree }, { Packages });
+
+	// Initialize StructManager with all structs and their names, member alignments are taken from the type-shapes of TypeIR
+	InitGraph.AddTask("StructManager", &StructManager::Init, { StructMembers, InheritanceTree, PropertyRecords }, { StructInfos });
 
-	// Initialize StructManager with all structs and their names
-	StructManager::Init();
-	
 	// Initialize EnumManager with all enums and their names
-	EnumManager::Init();
-	
+	InitGraph.AddTask("EnumManager", &EnumManager::Init, { StructMembers, InheritanceTree }, { EnumInfos });
+
 	// Initialized all Member-Name collisions
-	MemberManager::Init();
+	InitGraph.AddTask("MemberManager", &MemberManager::Init, { StructMembers, InheritanceTree }, { MemberNames });
 
 	// Post-Initialize PackageManager after StructManager has been initialized. 'PostInit()' handles Cyclic-Dependencies detection
-	PackageManager::PostInit();
+	InitGraph.AddTask("PackageManager::PostInit", &PackageManager::PostInit, { Packages, StructInfos }, { PackageCycles });
+
+	/*
+	* The managers share StructMemberCache, StructHierarchy and TypeIR, which are read-only once built, and the name lookup tables of ObjectArray used
+	* by the Find*Fast functions, which are extended under a lock while GObjects grows. So they run concurrently.
+	* Their internal shards are queued on the same WorkerPool, threads that are done with a phase pick up shards of the others.
+	*/
+	if (!InitGraph.Run())
+		std::cerr << "The task-graph of Generator::InitInternal is invalid, none of its phases were run!\n\n";
+
+	// All tables are complete, drop capacity left over from growing them
+	if constexpr (Settings::General::bCompactManagersAfterInit)
+	{
+		StructManager::Compact();
+		EnumManager::Compact();
+		MemberManager::Compact();
+		PackageManager::Compact();
+	}
+
+	if constexpr (Settings::Debug::bPrintManagerMemoryReports)
+	{
+		MemoryReport Total;
+
+		auto PrintReport = [&Total](std::string_view Name, const MemoryReport& Report) -> void
+		{
+			Report.Print(Name);
+			Total += Report;
+		};
+
+		PrintReport("StructManager", StructManager::GetMemoryReport());
+		PrintReport("EnumManager", EnumManager::GetMemoryReport());
+		PrintReport("MemberManager", MemberManager::GetMemoryReport());
+		PrintReport("PackageManager", PackageManager::GetMemoryReport());
+
+		Total.Print("Total");
+		std::cerr << "\n";
+	}
+}
+
+void Generator::ResetInternal()
+{
+	PackageManager::Reset();
+	StructManager::Reset();
+	EnumManager::Reset();
+	MemberManager::Reset();
+
+	TypeIR::Reset();
+	StructHierarchy::Reset();
+	StructMemberCache::Reset();
+
+	ObjectArraySnapshot::Reset();
+
+	// Both are keyed by object-index, the game may have reused slots of objects that were garbage-collected since
+	ObjectArray::ResetLookupTables();
+	UEObject::InitOuterPrefixCache();
+}
+
+void Generator::RecordProcessedObjects()
+{
+	const int32 NumObjects = ObjectArray::Num();
+
+	ProcessedObjects.resize(NumObjects);
+
+	constexpr int32 BlockSize = 0x400;
+	void* Addresses[BlockSize];
+
+	for (int32 First = 0; First < NumObjects; First += BlockSize)
+	{
+		const int32 Count = std::min(BlockSize, NumObjects - First);
+
+		ObjectArray::GetAddressesInRange(First, Count, Addresses);
+
+		for (int32 i = 0; i < Count; i++)
+		{
+			const UEObject Object = Addresses[i];
+
+			if (!Object)
+			{
+				ProcessedObjects[First + i] = { nullptr, nullptr, -1, -1 };
+				continue;
+			}
+
+			const bool bIsType = Object.IsA(EClassCastFlags::Struct | EClassCastFlags::Enum);
+
+			ProcessedObjects[First + i] = { Addresses[i], Object.GetClass().GetAddress(), bIsType ? Object.GetPackageIndex() : -1, bIsType ? Object.GetFName().GetCompIdx() : -1 };
+		}
+
+		TimeSlicer::YieldPoint();
+	}
+}
+
+bool Generator::HasNewTypes()
+{
+	// The snapshot only holds the objects of the last InitInternal, GObjects is read directly
+	ObjectArraySnapshot::Reset();
+
+	const int32 NumObjects = ObjectArray::Num();
+	const int32 NumProcessedObjects = static_cast<int32>(ProcessedObjects.size());
+
+	/* Every call compares against the same InitInternal, so the changes are collected from scratch */
+	std::vector<int32> ChangedPackages;
+	std::vector<int32> ChangedNames;
+
+	bool bHasNewTypes = false;
+
+	constexpr int32 BlockSize = 0x400;
+	void* Addresses[BlockSize];
+
+	for (int32 First = 0; First < NumObjects; First += BlockSize)
+	{
+		const int32 Count = std::min(BlockSize, NumObjects - First);
+
+		ObjectArray::GetAddressesInRange(First, Count, Addresses);
+
+		for (int32 i = 0; i < Count; i++)
+		{
+			const UEObject Object = Addresses[i];
+			const void* Class = Object ? Object.GetClass().GetAddress() : nullptr;
+
+			/* The game reuses the slots of garbage-collected objects, and the allocator their addresses, so both are compared */
+			if (First + i < NumProcessedObjects)
+			{
+				const ProcessedObject& Processed = ProcessedObjects[First + i];
+
+				if (Processed.Address == Addresses[i] && Processed.Class == Class)
+					continue;
+
+				/* A type was removed from this slot, the package it was declared in changed too */
+				if (Processed.PackageIndex != -1)
+				{
+					ChangedPackages.push_back(Processed.PackageIndex);
+					ChangedNames.push_back(Processed.NameIndex);
+				}
+			}
+
+			if (!Object || !Object.IsA(EClassCastFlags::Struct | EClassCastFlags::Enum))
+				continue;
+
+			ChangedPackages.push_back(Object.GetPackageIndex());
+			ChangedNames.push_back(Object.GetFName().GetCompIdx());
+
+			bHasNewTypes = true;
+		}
+
+		TimeSlicer::YieldPoint();
+	}
+
+	/* Removed types alone don't start a regeneration, they're part of the changes once new types arrive */
+	if (bHasNewTypes)
+		PackageFingerprints::SetChanges(std::move(ChangedPackages), std::move(ChangedNames));
+
+	return bHasNewTypes;
+}
+
+void Generator::PrepareRegeneration()
+{
+	WaitForBackgroundTasks();
+
+	ResetInternal();
+
+	DumperFolder.clear();
+	bDumpedGObjects = false;
+}
+
+void Generator::DumpGObjects()
+{
+	ObjectArray::DumpObjects(DumperFolder);
+
+	if (Settings::Internal::bUseFProperty)
+		ObjectArray::DumpObjectsWithProperties(DumperFolder);
+
+	if (!Settings::Generator::bDumpObjectsBinary && !Settings::Config::bExportToSharedMemory)
+		return;
+
+	const std::string SerializedObjects = ObjectArray::SerializeObjectsBinary();
+
+	if constexpr (Settings::Generator::bDumpObjectsBinary)
+		ObjectArray::DumpObjectsBinary(DumperFolder, SerializedObjects);
+
+	if (Settings::Config::bExportToSharedMemory)
+		SharedMemoryExport::Publish(SerializedObjects.data(), SerializedObjects.size());
+}
+
+void Generator::WaitForBackgroundTasks()
+{
+	if (GObjectsDumpTask.valid())
+		GObjectsDumpTask.wait();
+
+	for (std::future<void>& DeletionTask : FolderDeletionTasks)
+		DeletionTask.wait();
+
+	FolderDeletionTasks.clear();
+
+	if (Settings::Generator::ShouldSkipUnchangedFiles())
+	{
+		BufferedFileStream::WaitForPendingWrites();
+		FileManifest::Save();
+	}
+}
+
+void Generator::DeleteTombstone(const fs::path& Tombstone)
+{
+	FolderDeletionTasks.push_back(std::async(std::launch::async, [Tombstone]() -> void
+	{
+		/* Lowers the IO-priority too, so the deletion doesn't compete with the files being generated */
+		Platform::SetCurrentThreadBackgroundMode(true);
+
+		std::error_code Error;
+		fs::remove_all(Tombstone, Error);
+
+		if (Error)
+			std::cerr << std::format("Could not delete old folder! Info: {}\n", Error.message());
+
+		Platform::SetCurrentThreadBackgroundMode(false);
+	}));
+}
+
+void Generator::DeleteInBackground(const fs::path& Folder)
+{
+	static int32 NumTombstones = 0x0;
+
+	/* Renaming is instant, only the tombstone has to be deleted file by file */
+	const fs::path Tombstone = Folder.generic_string() + std::format("{}{:X}_{}", TombstoneMarker, std::chrono::system_clock::now().time_since_epoch().count(), NumTombstones++);
+
+	fs::rename(Folder, Tombstone);
+
+	DeleteTombstone(Tombstone);
+}
+
+void Generator::DeleteLeftoverTombstones(const fs::path& Folder)
+{
+	std::error_code Error;
+
+	for (const fs::directory_entry& Entry : fs::directory_iterator(Folder, Error))
+	{
+		if (Entry.is_directory(Error) && Entry.path().filename().generic_string().find(TombstoneMarker) != std::string::npos)
+			DeleteTombstone(Entry.path());
+	}
+}
+
+void Generator::RetireFolder(const fs::path& Folder)
+{
+	constexpr int32 NumToKeep = Settings::Generator::NumOldDumpsToKeep;
+
+	const std::string OldBaseName = Folder.generic_string() + "_OLD";
+
+	/* Newest old version is "_OLD", older ones are "_OLD2", "_OLD3", ... */
+	auto GetOldFolder = [&OldBaseName](int32 Generation) -> fs::path
+	{
+		return Generation == 1 ? fs::path(OldBaseName) : fs::path(OldBaseName + std::to_string(Generation));
+	};
+
+	if constexpr (NumToKeep <= 0)
+	{
+		DeleteInBackground(Folder);
+		return;
+	}
+
+	if (fs::exists(GetOldFolder(NumToKeep)))
+		DeleteInBackground(GetOldFolder(NumToKeep));
+
+	for (int32 Generation = NumToKeep - 1; Generation >= 1; Generation--)
+	{
+		if (fs::exists(GetOldFolder(Generation)))
+			fs::rename(GetOldFolder(Generation), GetOldFolder(Generation + 1));
+	}
+
+	fs::rename(Folder, GetOldFolder(1));
 }
 
 bool Generator::SetupDumperFolder()
@@ -81,18 +535,24 @@ bool Generator::SetupDumperFolder()
 
 		FileNameHelper::MakeValidFileName(FolderName);
 
-		DumperFolder = fs::path(Settings::Generator::SDKGenerationPath) / FolderName;
+		DumperFolder = GenerationRoot / FolderName;
 
-		if (fs::exists(DumperFolder))
-		{
-			fs::path Old = DumperFolder.generic_string() + "_OLD";
+		/* Without a manifest it's unknown which files in the folder were generated by us, so the folder is only reused if it has one */
+		bool bReuseFolder = false;
 
-			fs::remove_all(Old);
+		if (Settings::Generator::ShouldSkipUnchangedFiles())
+			bReuseFolder = FileManifest::Load(DumperFolder);
 
-			fs::rename(DumperFolder, Old);
-		}
+		/* Tombstones of a previous run that was closed before it finished deleting them */
+		DeleteLeftoverTombstones(GenerationRoot);
+
+		if (fs::exists(DumperFolder) && !bReuseFolder)
+			RetireFolder(DumperFolder);
 
 		fs::create_directories(DumperFolder);
+
+		if (bReuseFolder)
+			DeleteLeftoverTombstones(DumperFolder);
 	}
 	catch (const std::filesystem::filesystem_error& fe)
 	{
@@ -121,14 +581,8 @@ bool Generator::SetupFolders(std::string& FolderName, fs::path& OutFolder, std::
 		OutFolder = DumperFolder / FolderName;
 		OutSubFolder = OutFolder / SubfolderName;
 				
-		if (fs::exists(OutFolder))
-		{
-			fs::path Old = OutFolder.generic_string() + "_OLD";
-
-			fs::remove_all(Old);
-
-			fs::rename(OutFolder, Old);
-		}
+		if (fs::exists(OutFolder) && !FileManifest::HasPreviousManifest())
+			RetireFolder(OutFolder);
 
 		fs::create_directories(OutFolder);
 
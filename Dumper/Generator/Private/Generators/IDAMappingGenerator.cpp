@@ -1,12 +1,36 @@
 
 #include <fstream>
+#include <algorithm>
+#include <unordered_set>
+#include <unordered_map>
 
 #include "Generators/IDAMappingGenerator.h"
+#include "TypeIR.h"
+#include "ShardedObjectScan.h"
 
 
-std::string IDAMappingGenerator::MangleFunctionName(const std::string& ClassName, const std::string& FunctionName)
+std::string IDAMappingGenerator::MangleClassPrefix(const std::string& ClassName)
 {
-	return "_ZN" + std::to_string(ClassName.length()) + ClassName + std::to_string(FunctionName.length() + 4) + "exec" + FunctionName + "Ev";
+	return "_ZN" + std::to_string(ClassName.length()) + ClassName;
+}
+
+std::string IDAMappingGenerator::MangleFunctionSuffix(std::string_view FunctionName)
+{
+	return std::to_string(FunctionName.length() + 4) + "exec" + std::string(FunctionName) + "Ev";
+}
+
+int32 IDAMappingGenerator::IdmapShard::AddPrefix(std::string&& Prefix)
+{
+	Prefixes.push_back(std::move(Prefix));
+
+	return static_cast<int32>(Prefixes.size() - 1);
+}
+
+void IDAMappingGenerator::IdmapShard::AddEntry(uint32 Offset, int32 PrefixIndex, std::string_view Suffix, bool bIsFunction)
+{
+	Entries.push_back({ Offset, PrefixIndex, static_cast<uint32>(Suffixes.size()), static_cast<uint16>(Suffix.length()), bIsFunction });
+
+	Suffixes += Suffix;
 }
 
 void IDAMappingGenerator::WriteReadMe(StreamType& ReadMe)
@@ -35,10 +59,28 @@ struct Identifier
     uint16 NameLength;
     const char Name[NameLength]; // Not NULL-terminated
 };
+
+
+'.idmap.idx' files contain the same identifiers, sorted by their offset, in a layout that can be memory-mapped and applied in bulk.
+Names are split into a prefix shared by all identifiers of a class and a suffix, Name = Prefix + Suffix.
+
+struct IndexFile
+{
+    uint32 Magic;       // 0x58444937
+    uint32 Version;     // 1
+    uint32 NumEntries;
+    uint32 NumPrefixes;
+    uint32 StringsSize;
+
+    struct { uint32 StringOffset; uint16 Length; uint16 Padding; } Prefixes[NumPrefixes];
+    struct { uint32 Offset; uint32 PrefixIndex; uint32 SuffixOffset; uint16 SuffixLength; uint16 Padding; } Entries[NumEntries]; // Sorted by Offset
+
+    const char Strings[StringsSize]; // StringOffset and SuffixOffset are relative to this array, not NULL-terminated
+};
 )";
 }
 
-void IDAMappingGenerator::GenerateVTableName(StreamType& IdmapFile, UEObject DefaultObject)
+void IDAMappingGenerator::GenerateVTableName(IdmapShard& Shard, UEObject DefaultObject)
 {
 	const UEClass Class = DefaultObject.GetClass();
 	const UEClass Super = Class.GetSuper().Cast<UEClass>();
@@ -46,42 +88,45 @@ void IDAMappingGenerator::GenerateVTableName(StreamType& IdmapFile, UEObject Def
 	if (Super && DefaultObject.GetVft() == Super.GetDefaultObject().GetVft())
 		return;
 
-	const std::string Name = Class.GetCppName() + "_VFT";
-
 	const uint32 Offset = static_cast<uint32>(Platform::GetOffset(DefaultObject.GetVft()));
-	const uint16 NameLen = static_cast<uint16>(Name.length());
 
-	WriteToStream(IdmapFile, Offset);
-	WriteToStream(IdmapFile, NameLen);
-	WriteToStream(IdmapFile, Name.c_str(), NameLen);
+	Shard.AddEntry(Offset, Shard.AddPrefix(Class.GetCppName()), "_VFT", false);
 }
 
-void IDAMappingGenerator::GenerateClassFunctions(StreamType& IdmapFile, UEClass Class)
+void IDAMappingGenerator::GenerateClassFunctions(IdmapShard& Shard, UEClass Class)
 {
-	static std::unordered_map<uint32, std::string> Funcs;
+	/* Only interned once there is a native function to name */
+	int32 PrefixIndex = -1;
 
-	for (const UEFunction Func : Class.GetFunctions())
+	for (const TypeIR::FunctionNode& Func : TypeIR::GetFunctions(Class))
 	{
-		if (!Func.HasFlags(EFunctionFlags::Native))
+		if (!(Func.Flags & EFunctionFlags::Native))
 			continue;
 
-		const std::string MangledName = MangleFunctionName(Class.GetCppName(), Func.GetValidName());
+		if (PrefixIndex == -1)
+			PrefixIndex = Shard.AddPrefix(MangleClassPrefix(Class.GetCppName()));
 
-		const uint32 Offset = static_cast<uint32>(Platform::GetOffset(Func.GetExecFunction()));
-		const uint16 NameLen = static_cast<uint16>(MangledName.length());
+		const uint32 Offset = static_cast<uint32>(Platform::GetOffset(Func.ExecFunction));
 
-		auto [It, bInseted] = Funcs.emplace(Offset, Func.GetFullName());
+		Shard.AddEntry(Offset, PrefixIndex, MangleFunctionSuffix(TypeIR::GetValidName(Func)), true);
+	}
+}
 
-		if (!bInseted)
+void IDAMappingGenerator::GenerateShard(IdmapShard& Shard, int32 StartIndex, int32 EndIndex)
+{
+	ShardedObjectScan::ForEachObjectInRange(StartIndex, EndIndex, [&Shard](const UEObject Obj) -> void
+	{
+		if (Obj.HasAnyFlags(EObjectFlags::ClassDefaultObject))
 		{
-			//std::cerr << "Collision: \nOld: " << It->second << "\nNew: " << Func.GetFullName() << "\n" << std::endl;
-			continue;
+			/* Gets the VTable offset from the default object and writes the ClassName + "_VFT" postfix to the file */
+			GenerateVTableName(Shard, Obj);
 		}
-
-		WriteToStream(IdmapFile, Offset);
-		WriteToStream(IdmapFile, NameLen);
-		WriteToStream(IdmapFile, MangledName.c_str(), NameLen);
-	}
+		else if (Obj.IsA(EClassCastFlags::Class))
+		{
+			/* Iterates all of the functions of the class and them to the stream with an "exec" prefix in front of the function name */
+			GenerateClassFunctions(Shard, Obj.Cast<UEClass>());
+		}
+	});
 }
 
 void IDAMappingGenerator::Generate()
@@ -90,26 +135,90 @@ void IDAMappingGenerator::Generate()
 
 	FileNameHelper::MakeValidFileName(IdaMappingFileName);
 
-	/* Open the stream as binary data, else ofstream will add \r after numbers that can be interpreted as \n. */
-	std::ofstream IdmapFile(MainFolder / IdaMappingFileName, std::ios::binary);
-
 	/* Create a ReadMe to describe what '.idmap' is, and how to use it */
-	std::ofstream ReadMe(MainFolder / "ReadMe.txt");
+	StreamType ReadMe(MainFolder / "ReadMe.txt");
 
 	/* Write description of the file format, as well as a link to the IDA-Plugin */
 	WriteReadMe(ReadMe);
 
-	for (UEObject Obj : ObjectArray())
+	/* Identifiers are merged in the order of the objects, so the file doesn't depend on thread-scheduling */
+	const std::vector<IdmapShard> Shards = ShardedObjectScan::Run<IdmapShard>(ShardedObjectScan::GetNumObjects(), [](int32 StartIndex, int32 EndIndex, IdmapShard& Shard) -> void
 	{
-		if (Obj.HasAnyFlags(EObjectFlags::ClassDefaultObject))
-		{
-			/* Gets the VTable offset from the default object and writes the ClassName + "_VFT" postfix to the file */
-			GenerateVTableName(IdmapFile, Obj);
-		}
-		else if (Obj.IsA(EClassCastFlags::Class))
+		GenerateShard(Shard, StartIndex, EndIndex);
+	});
+
+	/* Open the stream as binary data, else ofstream will add \r after numbers that can be interpreted as \n. */
+	StreamType IdmapFile(MainFolder / IdaMappingFileName, std::ios::binary);
+
+	/* Only the first function found at an offset is named, later ones are usually shared thunks of the same native */
+	std::unordered_set<uint32> FunctionOffsets;
+
+	std::vector<IndexPrefix> IndexPrefixes;
+	std::vector<IndexEntry> IndexEntries;
+	std::string IndexStrings;
+
+	std::unordered_map<std::string, uint32> InternedPrefixes;
+	std::vector<uint32> GlobalPrefixIndices;
+
+	for (const IdmapShard& Shard : Shards)
+	{
+		GlobalPrefixIndices.assign(Shard.Prefixes.size(), ~0u);
+
+		for (const IdmapEntry& Entry : Shard.Entries)
 		{
-			/* Iterates all of the functions of the class and them to the stream with an "exec" prefix in front of the function name */
-			GenerateClassFunctions(IdmapFile, Obj.Cast<UEClass>());
+			if (Entry.bIsFunction && !FunctionOffsets.insert(Entry.Offset).second)
+				continue;
+
+			const std::string& Prefix = Shard.Prefixes[Entry.PrefixIndex];
+			const std::string_view Suffix = std::string_view(Shard.Suffixes).substr(Entry.SuffixOffset, Entry.SuffixLength);
+
+			const uint16 NameLen = static_cast<uint16>(Prefix.length() + Suffix.length());
+
+			WriteToStream(IdmapFile, Entry.Offset);
+			WriteToStream(IdmapFile, NameLen);
+			WriteToStream(IdmapFile, Prefix.c_str(), static_cast<int32>(Prefix.length()));
+			WriteToStream(IdmapFile, Suffix.data(), static_cast<int32>(Suffix.length()));
+
+			if constexpr (!Settings::IDAMappingGenerator::bGenerateBinaryIndex)
+				continue;
+
+			uint32& PrefixIndex = GlobalPrefixIndices[Entry.PrefixIndex];
+
+			if (PrefixIndex == ~0u)
+			{
+				auto [It, bWasInserted] = InternedPrefixes.emplace(Prefix, static_cast<uint32>(IndexPrefixes.size()));
+
+				if (bWasInserted)
+				{
+					IndexPrefixes.push_back({ static_cast<uint32>(IndexStrings.size()), static_cast<uint16>(Prefix.length()), 0x0 });
+					IndexStrings += Prefix;
+				}
+
+				PrefixIndex = It->second;
+			}
+
+			IndexEntries.push_back({ Entry.Offset, PrefixIndex, static_cast<uint32>(IndexStrings.size()), Entry.SuffixLength, 0x0 });
+			IndexStrings += Suffix;
 		}
 	}
-}
\ No newline at end of file
+
+	if constexpr (!Settings::IDAMappingGenerator::bGenerateBinaryIndex)
+		return;
+
+	/* Stable, so identifiers sharing an offset keep the order they have in the '.idmap' */
+	std::stable_sort(IndexEntries.begin(), IndexEntries.end(), [](const IndexEntry& Left, const IndexEntry& Right) { return Left.Offset < Right.Offset; });
+
+	IndexHeader Header;
+	Header.Magic = IndexFileMagic;
+	Header.Version = IndexFileVersion;
+	Header.NumEntries = static_cast<uint32>(IndexEntries.size());
+	Header.NumPrefixes = static_cast<uint32>(IndexPrefixes.size());
+	Header.StringsSize = static_cast<uint32>(IndexStrings.size());
+
+	StreamType IndexFile(MainFolder / (IdaMappingFileName + ".idx"), std::ios::binary);
+
+	WriteToStream(IndexFile, Header);
+	WriteToStream(IndexFile, IndexPrefixes.data(), static_cast<int32>(IndexPrefixes.size() * sizeof(IndexPrefix)));
+	WriteToStream(IndexFile, IndexEntries.data(), static_cast<int32>(IndexEntries.size() * sizeof(IndexEntry)));
+	WriteToStream(IndexFile, IndexStrings.data(), static_cast<int32>(IndexStrings.size()));
+}
@@ -1,19 +1,19 @@
 
+#include <memory>
 #include <iostream>
 #include <string>
 
 #include "Generators/MappingGenerator.h"
 #include "Managers/PackageManager.h"
+#include "WorkerPool.h"
 #include "Compression/zstd.h"
 
 #include "../Settings.h"
 #include "Utils.h"
 
-EMappingsTypeFlags MappingGenerator::GetMappingType(UEProperty Property)
+EMappingsTypeFlags MappingGenerator::GetMappingType(const TypeIR::PropertyNode& Property)
 {
-	auto [Class, FieldClass] = Property.GetClass();
-
-	EClassCastFlags Flags = Class ? Class.GetCastFlags() : FieldClass.GetCastFlags();
+	const EClassCastFlags Flags = Property.CastFlags;
 
 	if (Flags & EClassCastFlags::ByteProperty)
 	{
@@ -131,88 +131,209 @@ EMappingsTypeFlags MappingGenerator::GetMappingType(UEProperty Property)
 	return EMappingsTypeFlags::Unknown;
 }
 
-int32 MappingGenerator::AddNameToData(std::stringstream& NameTable, const std::string& Name)
+void MappingGenerator::MappingBuffer::WriteName(const std::string& Name)
 {
+	int32 LocalIndex = static_cast<int32>(Names.size());
+
 	if constexpr (Settings::MappingGenerator::bShouldCheckForDuplicatedNames)
 	{
-		static std::unordered_map<std::string, int32> NameMap;
-		
-		auto [It, bInserted] = NameMap.insert({ Name, NameCounter });
+		auto [It, bInserted] = NameIndices.insert({ Name, LocalIndex });
+
+		if (!bInserted)
+			LocalIndex = It->second;
+	}
+
+	if (LocalIndex == static_cast<int32>(Names.size()))
+		Names.push_back(Name);
+
+	NameReferences.push_back({ static_cast<uint32>(Data.size()), FName(nullptr) });
+	Write(LocalIndex);
+}
+
+void MappingGenerator::MappingBuffer::WriteName(FName Name)
+{
+	const int32 CompIdx = Name.GetCompIdx();
+
+	/* The CompIdx doesn't identify the string of case-preserving names, and names with a number share it with their base-name */
+	if (Settings::Internal::bUseCasePreservingName || CompIdx < 0 || Name.GetNumber() != 0)
+		return WriteName(Name.ToString());
+
+	NameReferences.push_back({ static_cast<uint32>(Data.size()), Name });
+	Write(CompIdx);
+}
+
+int32 MappingGenerator::AddNameToData(std::vector<uint8>& NameTable, const std::string& Name)
+{
+	if constexpr (Settings::MappingGenerator::bShouldCheckForDuplicatedNames)
+	{
+		auto [It, bInserted] = NameIndices.insert({ Name, static_cast<int32>(NameCounter) });
+
+		/* The name was written to the NameTable before */
+		if (!bInserted)
+			return It->second;
+	}
+
+	WriteToBuffer(NameTable, static_cast<uint16>(Name.length()));
+	NameTable.insert(NameTable.end(), Name.begin(), Name.end());
+
+	return static_cast<int32>(NameCounter++);
+}
+
+int32 MappingGenerator::AddNameToData(std::vector<uint8>& NameTable, FName Name, int32 CompIdx)
+{
+	if constexpr (!Settings::MappingGenerator::bShouldCheckForDuplicatedNames)
+		return AddNameToData(NameTable, Name.ToString());
+
+	const uint32 PageIdx = static_cast<uint32>(CompIdx) >> NameSlotPageBits;
+	const uint32 InPageIdx = static_cast<uint32>(CompIdx) & (NameSlotPageSize - 1);
+
+	if (PageIdx >= NameSlotPages.size())
+		NameSlotPages.resize(PageIdx + 1);
+
+	if (!NameSlotPages[PageIdx])
+		NameSlotPages[PageIdx] = std::make_unique<int32[]>(NameSlotPageSize);
+
+	int32& Slot = NameSlotPages[PageIdx][InPageIdx];
 
-		/* The name didn't occure yet, write it to the NameTable */
-		if (bInserted)
+	/* Goes through the string-lookup once, the same string might've been added by a name that isn't keyed by its CompIdx */
+	if (Slot == 0x0)
+		Slot = AddNameToData(NameTable, Name.ToString()) + 1;
+
+	return Slot - 1;
+}
+
+void MappingGenerator::MergeNames(MappingBuffer& Buffer, std::vector<uint8>& NameTable)
+{
+	/* Names are added in the order they were first used in, so the name-table is identical to one written while serializing */
+	std::vector<int32> GlobalIndices(Buffer.Names.size(), -1);
+
+	for (const MappingBuffer::NameReference& Reference : Buffer.NameReferences)
+	{
+		int32 NameIndex = 0x0;
+		memcpy(&NameIndex, Buffer.Data.data() + Reference.Offset, sizeof(int32));
+
+		if (Reference.Name.GetAddress())
 		{
-			WriteToStream(NameTable, static_cast<uint16>(Name.length()));
-			NameTable.write(Name.c_str(), Name.length());
-			return NameCounter++;
+			NameIndex = AddNameToData(NameTable, Reference.Name, NameIndex);
 		}
+		else
+		{
+			if (GlobalIndices[NameIndex] == -1)
+				GlobalIndices[NameIndex] = AddNameToData(NameTable, Buffer.Names[NameIndex]);
+
+			NameIndex = GlobalIndices[NameIndex];
+		}
+
+		memcpy(Buffer.Data.data() + Reference.Offset, &NameIndex, sizeof(int32));
+	}
+
+	Buffer.Names = std::vector<std::string>();
+	Buffer.NameIndices = std::unordered_map<std::string, int32>();
+	Buffer.NameReferences = std::vector<MappingBuffer::NameReference>();
+}
+
+bool MappingGenerator::CompressZStandard(const std::vector<std::vector<uint8>>& Payload, uint64 UncompressedSize, std::vector<uint8>& OutCompressed)
+{
+	std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> Context(ZSTD_createCCtx(), &ZSTD_freeCCtx);
+
+	if (!Context)
+		return false;
+
+	ZSTD_CCtx_setParameter(Context.get(), ZSTD_c_compressionLevel, Settings::MappingGenerator::ZStandardCompressionLevel);
+	ZSTD_CCtx_setParameter(Context.get(), ZSTD_c_enableLongDistanceMatching, Settings::MappingGenerator::bZStandardLongDistanceMatching ? 1 : 0);
+
+	/* Only fails if zstd was built without ZSTD_MULTITHREAD, compression then stays on this thread */
+	ZSTD_CCtx_setParameter(Context.get(), ZSTD_c_nbWorkers, Settings::MappingGenerator::ZStandardNumWorkers);
+
+	ZSTD_CCtx_setPledgedSrcSize(Context.get(), UncompressedSize);
 
-		return It->second;
+	/* With an output buffer of this size every call can always make progress */
+	OutCompressed.resize(ZSTD_compressBound(UncompressedSize));
+
+	ZSTD_outBuffer Output = { OutCompressed.data(), OutCompressed.size(), 0x0 };
+
+	for (const std::vector<uint8>& Chunk : Payload)
+	{
+		ZSTD_inBuffer Input = { Chunk.data(), Chunk.size(), 0x0 };
+
+		while (Input.pos < Input.size)
+		{
+			if (ZSTD_isError(ZSTD_compressStream2(Context.get(), &Output, &Input, ZSTD_e_continue)))
+				return false;
+		}
 	}
 
-	WriteToStream(NameTable, static_cast<uint16>(Name.length()));
-	NameTable.write(Name.c_str(), Name.length());
+	ZSTD_inBuffer EmptyInput = { nullptr, 0x0, 0x0 };
 
-	return NameCounter++;
+	size_t NumBytesRemaining = 0x0;
+
+	do
+	{
+		NumBytesRemaining = ZSTD_compressStream2(Context.get(), &Output, &EmptyInput, ZSTD_e_end);
+
+		if (ZSTD_isError(NumBytesRemaining))
+			return false;
+
+	} while (NumBytesRemaining != 0x0);
+
+	OutCompressed.resize(Output.pos);
+
+	return true;
 }
 
-void MappingGenerator::GeneratePropertyType(UEProperty Property, std::stringstream& Data, std::stringstream& NameTable)
+void MappingGenerator::GeneratePropertyType(const TypeIR::PropertyNode* Property, MappingBuffer& Buffer)
 {
 	if (!Property)
 	{
-		WriteToStream(Data, static_cast<uint8>(EMappingsTypeFlags::Unknown));
+		Buffer.Write(static_cast<uint8>(EMappingsTypeFlags::Unknown));
 		return;
 	}
 
-	EMappingsTypeFlags MappingType = GetMappingType(Property);
+	EMappingsTypeFlags MappingType = GetMappingType(*Property);
 
 	/* Serialize ByteProperty as an EnumProperty with 'UnderlayingType == uint8' if the inner enum is valid */
-	const bool bIsFakeEnumProperty = MappingType == EMappingsTypeFlags::ByteProperty && Property.Cast<UEByteProperty>().GetEnum();
+	const bool bIsFakeEnumProperty = MappingType == EMappingsTypeFlags::ByteProperty && Property->Referenced;
 
-	WriteToStream(Data, static_cast<uint8>(!bIsFakeEnumProperty ? MappingType : EMappingsTypeFlags::EnumProperty));
+	Buffer.Write(static_cast<uint8>(!bIsFakeEnumProperty ? MappingType : EMappingsTypeFlags::EnumProperty));
 
 	/* Write ByteProperty as the fake EnumProperty's underlaying type */
 	if (bIsFakeEnumProperty)
-		WriteToStream(Data, static_cast<uint8>(EMappingsTypeFlags::ByteProperty));
+		Buffer.Write(static_cast<uint8>(EMappingsTypeFlags::ByteProperty));
 
 	if (MappingType == EMappingsTypeFlags::EnumProperty)
 	{
-		GeneratePropertyType(Property.Cast<UEEnumProperty>().GetUnderlayingProperty(), Data, NameTable);
+		GeneratePropertyType(Property->Inner[0], Buffer);
 
-		const int32 EnumNameIdx = AddNameToData(NameTable, Property.Cast<UEEnumProperty>().GetEnum().GetName());
-		WriteToStream(Data, EnumNameIdx);
+		Buffer.WriteName(Property->Referenced);
 	}
 	else if (bIsFakeEnumProperty)
 	{
-		const int32 EnumNameIdx = AddNameToData(NameTable, Property.Cast<UEByteProperty>().GetEnum().GetName());
-		WriteToStream(Data, EnumNameIdx);
+		Buffer.WriteName(Property->Referenced);
 	}
 	else if (MappingType == EMappingsTypeFlags::StructProperty)
 	{
-		const int32 StructNameIdx = AddNameToData(NameTable, Property.Cast<UEStructProperty>().GetUnderlayingStruct().GetName());
-		WriteToStream(Data, StructNameIdx);
+		Buffer.WriteName(Property->Referenced);
 	}
 	else if (MappingType == EMappingsTypeFlags::SetProperty)
 	{
-		GeneratePropertyType(Property.Cast<UESetProperty>().GetElementProperty(), Data, NameTable);
+		GeneratePropertyType(Property->Inner[0], Buffer);
 	}
 	else if (MappingType == EMappingsTypeFlags::ArrayProperty)
 	{
-		GeneratePropertyType(Property.Cast<UEArrayProperty>().GetInnerProperty(), Data, NameTable);
+		GeneratePropertyType(Property->Inner[0], Buffer);
 	}
 	else if (MappingType == EMappingsTypeFlags::OptionalProperty)
 	{
-		GeneratePropertyType(Property.Cast<UEOptionalProperty>().GetValueProperty(), Data, NameTable);
+		GeneratePropertyType(Property->Inner[0], Buffer);
 	}
 	else if (MappingType == EMappingsTypeFlags::MapProperty)
 	{
-		UEMapProperty AsMapProperty = Property.Cast<UEMapProperty>();
-		GeneratePropertyType(AsMapProperty.GetKeyProperty(), Data, NameTable);
-		GeneratePropertyType(AsMapProperty.GetValueProperty(), Data, NameTable);
+		GeneratePropertyType(Property->Inner[0], Buffer);
+		GeneratePropertyType(Property->Inner[1], Buffer);
 	}
 }
 
-void MappingGenerator::GeneratePropertyInfo(const PropertyWrapper& Property, std::stringstream& Data, std::stringstream& NameTable, int32& Index)
+void MappingGenerator::GeneratePropertyInfo(const PropertyWrapper& Property, MappingBuffer& Buffer, int32& Index)
 {
 	if (!Property.IsUnrealProperty())
 	{
@@ -220,36 +341,35 @@ void MappingGenerator::GeneratePropertyInfo(const PropertyWrapper& Property, std
 		return;
 	}
 
-	WriteToStream(Data, static_cast<uint16>(Index));
-	WriteToStream(Data, static_cast<uint8>(Property.GetArrayDim()));
+	Buffer.Write(static_cast<uint16>(Index));
+	Buffer.Write(static_cast<uint8>(Property.GetArrayDim()));
+
+	const TypeIR::PropertyNode& Node = Property.GetTypeNode();
 
-	const int32 MemberNameIdx = AddNameToData(NameTable, Property.GetUnrealProperty().GetName());
-	WriteToStream(Data, MemberNameIdx);
+	Buffer.WriteName(Node.Property.GetFName());
 
-	GeneratePropertyType(Property.GetUnrealProperty(), Data, NameTable);
+	GeneratePropertyType(&Node, Buffer);
 
 	Index += Property.GetArrayDim();
 }
 
-void MappingGenerator::GenerateStruct(const StructWrapper& Struct, std::stringstream& Data, std::stringstream& NameTable)
+void MappingGenerator::GenerateStruct(const StructWrapper& Struct, MappingBuffer& Buffer)
 {
 	if (!Struct.IsValid())
 		return;
 
-	const int32 StructNameIndex = AddNameToData(NameTable, Struct.GetRawName());
-	WriteToStream(Data, StructNameIndex);
+	Buffer.WriteName(Struct.GetUnrealStruct());
 
 	StructWrapper Super = Struct.GetSuper();
 
 	if (Super.IsValid())
 	{
 		/* Most likely adds a duplicate to the name-table. Find a better solution later! */
-		const int32 SuperNameIndex = AddNameToData(NameTable, Super.GetRawName());
-		WriteToStream(Data, SuperNameIndex);
+		Buffer.WriteName(Super.GetUnrealStruct());
 	}
 	else
 	{
-		WriteToStream(Data, static_cast<int32>(-1));
+		Buffer.Write(static_cast<int32>(-1));
 	}
 
 	MemberManager Members = Struct.GetMembers();
@@ -268,8 +388,8 @@ void MappingGenerator::GenerateStruct(const StructWrapper& Struct, std::stringst
 	}
 
 	/* uint16, uint16 */
-	WriteToStream(Data, PropertyCount);
-	WriteToStream(Data, SerializablePropertyCount);
+	Buffer.Write(PropertyCount);
+	Buffer.Write(SerializablePropertyCount);
 
 	/* Incremented by 'Property->ArrayDim' inside 'GeneratePropertyInfo()' */
 	int32 IndexIncrementedByFunction = 0x0;
@@ -279,109 +399,128 @@ void MappingGenerator::GenerateStruct(const StructWrapper& Struct, std::stringst
 		if (ExcludeEditorOnlyProps && Member.HasPropertyFlags(EPropertyFlags::EditorOnly))
 			continue;
 
-		GeneratePropertyInfo(Member, Data, NameTable, IndexIncrementedByFunction);
+		GeneratePropertyInfo(Member, Buffer, IndexIncrementedByFunction);
 	}
+
+	Buffer.NumEntries++;
 }
 
-void MappingGenerator::GenerateEnum(const EnumWrapper& Enum, std::stringstream& Data, std::stringstream& NameTable)
+void MappingGenerator::GenerateEnum(const EnumWrapper& Enum, MappingBuffer& Buffer)
 {
-	const int32 EnumNameIndex = AddNameToData(NameTable, Enum.GetRawName());
-	WriteToStream(Data, EnumNameIndex);
+	Buffer.WriteName(Enum.GetUnrealEnum());
 
-	WriteToStream(Data, static_cast<uint16>(Enum.GetNumMembers()));
+	Buffer.Write(static_cast<uint16>(Enum.GetNumMembers()));
 
 	for (EnumCollisionInfo Member : Enum.GetMembers())
 	{
-		const int32 EnumMemberNameIdx = AddNameToData(NameTable, Member.GetUniqueName());
-		WriteToStream(Data, Member.GetValue());
-		WriteToStream(Data, EnumMemberNameIdx);
+		Buffer.Write(Member.GetValue());
+		Buffer.WriteName(Member.GetUniqueName());
 	}
+
+	Buffer.NumEntries++;
 }
 
-std::stringstream MappingGenerator::GenerateFileData()
+std::vector<std::vector<uint8>> MappingGenerator::GenerateFileData()
 {
-	std::stringstream NameData;
-	std::stringstream StructData;
-	std::stringstream EnumData;
+	std::vector<PackageInfoHandle> Packages;
 
-	uint32 NumEnums = 0x0;
-	uint32 NumStructsAndClasse = 0x0;
-
-	/* Handle all Enums first */
 	for (PackageInfoHandle Package : PackageManager::IterateOverPackageInfos())
 	{
-		if (Package.IsEmpty())
-			continue;
+		if (!Package.IsEmpty())
+			Packages.push_back(Package);
+	}
 
-		/* Create files and handles namespaces and includes */
-		if (!Package.HasEnums())
-			continue;
+	std::vector<MappingBuffer> EnumBuffers(Packages.size());
+	std::vector<MappingBuffer> StructBuffers(Packages.size());
 
-		for (int32 EnumIdx : Package.GetEnums())
-		{
-			GenerateEnum(ObjectArray::GetByIndex<UEEnum>(EnumIdx), EnumData, NameData);
-			NumEnums++;
-		}
-	}
-	
-	/* Handle all structs and classes in one go. From the mapping-files point of view classes are the exact same as structs. */
-	for (PackageInfoHandle Package : PackageManager::IterateOverPackageInfos())
+	/* Packages only reference names through their own buffer, so they can all be serialized at the same time */
+	WorkerPool::ParallelFor(static_cast<int32>(Packages.size()), [&](int32 PackageSlot) -> void
 	{
-		if (Package.IsEmpty())
-			continue;
+		const PackageInfoHandle Package = Packages[PackageSlot];
 
-		/* Create files and handles namespaces and includes */
-		if (!Package.HasClasses() && !Package.HasStructs())
-			continue;
+		if (Package.HasEnums())
+		{
+			for (int32 EnumIdx : Package.GetEnums())
+				GenerateEnum(ObjectArray::GetByIndex<UEEnum>(EnumIdx), EnumBuffers[PackageSlot]);
+		}
 
-		DependencyManager::OnVisitCallbackType GenerateStructCallback = [&](int32 Index) -> void
+		/* From the mapping-files point of view classes are the exact same as structs. */
+		auto GenerateStructCallback = [&](int32 Index) -> void
 		{
-			GenerateStruct(ObjectArray::GetByIndex<UEStruct>(Index), StructData, NameData);
-			NumStructsAndClasse++;
+			GenerateStruct(ObjectArray::GetByIndex<UEStruct>(Index), StructBuffers[PackageSlot]);
 		};
 
 		if (Package.HasStructs())
 		{
 			const DependencyManager& Structs = Package.GetSortedStructs();
-			Structs.VisitAllNodesWithCallback(GenerateStructCallback);
+			Structs.VisitAllNodes(GenerateStructCallback);
 		}
 
 		if (Package.HasClasses())
 		{
 			const DependencyManager& Classes = Package.GetSortedClasses();
-			Classes.VisitAllNodesWithCallback(GenerateStructCallback);
+			Classes.VisitAllNodes(GenerateStructCallback);
 		}
+	});
+
+	/* All enums are written before the structs, names have to be merged in the same order */
+	std::vector<uint8> NameData;
+
+	uint32 NumEnums = 0x0;
+	uint32 NumStructsAndClasse = 0x0;
+
+	for (MappingBuffer& Buffer : EnumBuffers)
+	{
+		MergeNames(Buffer, NameData);
+		NumEnums += Buffer.NumEntries;
 	}
 
-	/* Combine all of the stringstreams into one Data block representing the entire payload of the file */
-	std::stringstream ReturnBuffer;
+	for (MappingBuffer& Buffer : StructBuffers)
+	{
+		MergeNames(Buffer, NameData);
+		NumStructsAndClasse += Buffer.NumEntries;
+	}
+
+	/* Name-count and names, enum-count and enums, struct-count and structs */
+	std::vector<std::vector<uint8>> Payload;
+	Payload.reserve(EnumBuffers.size() + StructBuffers.size() + 0x3);
+
+	std::vector<uint8> NameCount;
+	WriteToBuffer(NameCount, static_cast<uint32>(NameCounter));
 
-	/* Write Name-count and names */
-	WriteToStream(ReturnBuffer, static_cast<uint32>(NameCounter));
-	WriteToStream(ReturnBuffer, NameData);
+	Payload.push_back(std::move(NameCount));
+	Payload.push_back(std::move(NameData));
 
 	if constexpr (Settings::Debug::bShouldPrintMappingDebugData)
 		std::cerr << std::format("MappingGeneration: NameCounter = 0x{0:X} (Dec: {0})\n", static_cast<uint32>(NameCounter));
 
-	/* Write Enum-count and enums */
-	WriteToStream(ReturnBuffer, static_cast<uint32>(NumEnums));
-	WriteToStream(ReturnBuffer, EnumData);
+	std::vector<uint8> EnumCount;
+	WriteToBuffer(EnumCount, NumEnums);
+
+	Payload.push_back(std::move(EnumCount));
+
+	for (MappingBuffer& Buffer : EnumBuffers)
+		Payload.push_back(std::move(Buffer.Data));
 
 	if constexpr (Settings::Debug::bShouldPrintMappingDebugData)
 		std::cerr << std::format("MappingGeneration: NumEnums = 0x{0:X} (Dec: {0})\n", static_cast<uint32>(NumEnums));
 
-	/* Write Struct-count and enums */
-	WriteToStream(ReturnBuffer, static_cast<uint32>(NumStructsAndClasse));
-	WriteToStream(ReturnBuffer, StructData);
+	std::vector<uint8> StructCount;
+	WriteToBuffer(StructCount, NumStructsAndClasse);
+
+	Payload.push_back(std::move(StructCount));
+
+	for (MappingBuffer& Buffer : StructBuffers)
+		Payload.push_back(std::move(Buffer.Data));
 
 	if constexpr (Settings::Debug::bShouldPrintMappingDebugData)
 		std::cerr << std::format("MappingGeneration: NumStructsAndClasse = 0x{0:X} (Dec: {0})\n\n", static_cast<uint32>(NumStructsAndClasse));
 
-	return ReturnBuffer;
+	return Payload;
 }
 
 
-void MappingGenerator::GenerateFileHeader(StreamType& InUsmap, const std::stringstream& Data)
+void MappingGenerator::GenerateFileHeader(StreamType& InUsmap, const std::vector<std::vector<uint8>>& Payload)
 {
 	/* Write 2bytes unsigned */
 	WriteToStream(InUsmap, UsmapFileMagic);
@@ -392,29 +531,31 @@ void MappingGenerator::GenerateFileHeader(StreamType& InUsmap, const std::string
 	/* We're on 'ExplicitEnumValues' version, we need to write 'bool' (aka int32) bHasVersioning. (NoVersioning = false) -> no [int32 UE4Version, int32 UE5Version] and no [uint32 NetCL] */
 	WriteToStream(InUsmap, static_cast<int32>(false));
 
-	const uint32 UncompressedSize = static_cast<uint32>(Data.str().length());
+	uint64 UncompressedSize = 0x0;
 
-	constexpr auto CompressionMethod = Settings::MappingGenerator::CompressionMethod;
+	for (const std::vector<uint8>& Chunk : Payload)
+		UncompressedSize += Chunk.size();
 
-	/* Write 'CompressionMethod' to the compression byte */
-	WriteToStream(InUsmap, static_cast<uint8>(CompressionMethod));
+	/* ZStandard is the only compression that's implemented, everything else is written uncompressed */
+	EUsmapCompressionMethod CompressionMethod = Settings::MappingGenerator::CompressionMethod;
 
-	size_t CompressedSize = UncompressedSize;
-	void* CompressedBuffer = nullptr;
+	std::vector<uint8> CompressedData;
 
-	switch (CompressionMethod)
+	if (CompressionMethod == EUsmapCompressionMethod::ZStandard && !CompressZStandard(Payload, UncompressedSize, CompressedData))
 	{
-	case EUsmapCompressionMethod::ZStandard:
-		CompressedSize = ZSTD_compressBound(UncompressedSize);
-		CompressedBuffer = malloc(CompressedSize);
-		CompressedSize = ZSTD_compress(CompressedBuffer, CompressedSize, Data.str().data(), UncompressedSize, ZSTD_maxCLevel());
-		break;
-	default:
-		CompressedBuffer = malloc(CompressedSize);
-		memcpy(CompressedBuffer, Data.str().data(), CompressedSize);
-		break;
+		std::cerr << "MappingGeneration: ZStandard compression failed, writing the mappings uncompressed!\n";
+		CompressionMethod = EUsmapCompressionMethod::None;
+	}
+	else if (CompressionMethod != EUsmapCompressionMethod::ZStandard)
+	{
+		CompressionMethod = EUsmapCompressionMethod::None;
 	}
 
+	const uint64 CompressedSize = CompressionMethod == EUsmapCompressionMethod::None ? UncompressedSize : CompressedData.size();
+
+	/* Write 'CompressionMethod' to the compression byte */
+	WriteToStream(InUsmap, static_cast<uint8>(CompressionMethod));
+
 	if constexpr (Settings::Debug::bShouldPrintMappingDebugData)
 	{
 		std::cerr << std::format("MappingGeneration: CompressedSize = 0x{0:X} (Dec: {0})\n", CompressedSize);
@@ -425,29 +566,36 @@ void MappingGenerator::GenerateFileHeader(StreamType& InUsmap, const std::string
 	WriteToStream(InUsmap, static_cast<uint32>(CompressedSize));
 
 	/* Write uncompressed size */
-	WriteToStream(InUsmap, UncompressedSize);
+	WriteToStream(InUsmap, static_cast<uint32>(UncompressedSize));
 
 	/* Header is done, now write the payload to the file */
-	InUsmap.write(static_cast<const char*>(CompressedBuffer), static_cast<uint32>(CompressedSize));
-
-	free(CompressedBuffer);
+	if (CompressionMethod == EUsmapCompressionMethod::None)
+	{
+		for (const std::vector<uint8>& Chunk : Payload)
+			InUsmap.write(reinterpret_cast<const char*>(Chunk.data()), static_cast<std::streamsize>(Chunk.size()));
+	}
+	else
+	{
+		InUsmap.write(reinterpret_cast<const char*>(CompressedData.data()), static_cast<std::streamsize>(CompressedData.size()));
+	}
 }
 
 void MappingGenerator::Generate()
 {
 	NameCounter = 0x0;
+	NameIndices.clear();
+	NameSlotPages.clear();
 
 	std::string MappingsFileName = (Settings::Generator::GameVersion + '-' + Settings::Generator::GameName + ".usmap");
 
 	FileNameHelper::MakeValidFileName(MappingsFileName);
 
 	/* Open the stream as binary data, else ofstream will add \r after numbers that can be interpreted as \n. */
-	std::ofstream UsmapFile(MainFolder / MappingsFileName, std::ios::binary);
+	StreamType UsmapFile(MainFolder / MappingsFileName, std::ios::binary);
 
 	/* Generate the payload of the file, containing all of the names, enums and structs. */
-	std::stringstream FileData = GenerateFileData();
+	const std::vector<std::vector<uint8>> FileData = GenerateFileData();
 
 	/* Generate the header, and write both header and payload into the file. */
 	GenerateFileHeader(UsmapFile, FileData);
 }
-
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "HashStringTable.h"
 
 
@@ -13,6 +15,13 @@ HashStringTable::HashStringTable(uint32 InitialBucketSize)
 
         CurrentBucket.Size = 0x0;
         CurrentBucket.SizeMax = InitialBucketSize;
+
+        CurrentBucket.Slots = static_cast<IndexSlot*>(malloc(InitialNumIndexSlots * sizeof(IndexSlot)));
+        CurrentBucket.NumSlots = InitialNumIndexSlots;
+        CurrentBucket.NumEntries = 0x0;
+
+        for (uint32 j = 0; j < InitialNumIndexSlots; j++)
+            CurrentBucket.Slots[j].InBucketOffset = EmptySlotOffset;
     }
 }
 
@@ -22,6 +31,12 @@ HashStringTable::~HashStringTable()
     {
         StringBucket& CurrentBucket = Buckets[i];
 
+        if (CurrentBucket.Slots)
+        {
+            free(CurrentBucket.Slots);
+            CurrentBucket.Slots = nullptr;
+        }
+
         if (!CurrentBucket.Data)
             continue;
 
@@ -59,12 +74,10 @@ const StringEntry& HashStringTable::GetStringEntry(int32 BucketIndex, int32 InBu
     return *reinterpret_cast<StringEntry*>(Bucket.Data + InBucketIndex);
 }
 
-void HashStringTable::ResizeBucket(StringBucket& Bucket)
+void HashStringTable::ResizeBucket(StringBucket& Bucket, uint32 RequiredSize)
 {
-    int32 BucketIdx = &Bucket - Buckets;
-
-    const uint32 OldBucketSize = Bucket.Size;
-    const uint64 NewBucketSizeMax = Bucket.SizeMax * 1.5;
+    /* A compacted bucket might be too small for one long string after growing by half */
+    const uint64 NewBucketSizeMax = std::max(static_cast<uint64>(Bucket.SizeMax * 1.5), static_cast<uint64>(RequiredSize));
 
     uint8_t* NewData = static_cast<uint8_t*>(realloc(Bucket.Data, NewBucketSizeMax));
 
@@ -74,17 +87,78 @@ void HashStringTable::ResizeBucket(StringBucket& Bucket)
     Bucket.SizeMax = NewBucketSizeMax;
 }
 
+void HashStringTable::ResizeIndex(StringBucket& Bucket)
+{
+    RebuildIndex(Bucket, Bucket.NumSlots * 2);
+}
+
+void HashStringTable::RebuildIndex(StringBucket& Bucket, uint32 NewNumSlots)
+{
+    const IndexSlot* OldSlots = Bucket.Slots;
+    const uint32 OldNumSlots = Bucket.NumSlots;
+
+    IndexSlot* NewSlots = static_cast<IndexSlot*>(malloc(NewNumSlots * sizeof(IndexSlot)));
+
+    assert(NewSlots != nullptr && "Malloc failed in function 'RebuildIndex()'.");
+
+    for (uint32 i = 0; i < NewNumSlots; i++)
+        NewSlots[i].InBucketOffset = EmptySlotOffset;
+
+    Bucket.Slots = NewSlots;
+    Bucket.NumSlots = NewNumSlots;
+
+    /* The lower 32 bits of the hash are not stored, rehash from the entries themselves */
+    for (uint32 i = 0; i < OldNumSlots; i++)
+    {
+        const IndexSlot& Slot = OldSlots[i];
+
+        if (Slot.InBucketOffset == EmptySlotOffset)
+            continue;
+
+        const StringEntry& Entry = GetStringEntry(Bucket, Slot.InBucketOffset);
+        const uint64 FullHash = StringHash64(Entry.Char, Entry.Length * (Entry.bIsWide ? sizeof(wchar_t) : sizeof(char)));
+
+        uint32 SlotIdx = static_cast<uint32>(FullHash) & (NewNumSlots - 1);
+
+        while (NewSlots[SlotIdx].InBucketOffset != EmptySlotOffset)
+            SlotIdx = (SlotIdx + 1) & (NewNumSlots - 1);
+
+        NewSlots[SlotIdx] = Slot;
+    }
+
+    free(const_cast<IndexSlot*>(OldSlots));
+}
+
+void HashStringTable::InsertIntoIndex(StringBucket& Bucket, uint64 FullHash, uint32 InBucketOffset)
+{
+    /* Keep the load-factor of the index below 3/4 */
+    if ((Bucket.NumEntries + 1) * 4 > Bucket.NumSlots * 3)
+        ResizeIndex(Bucket);
+
+    const uint32 SlotMask = Bucket.NumSlots - 1;
+
+    uint32 SlotIdx = static_cast<uint32>(FullHash) & SlotMask;
+
+    while (Bucket.Slots[SlotIdx].InBucketOffset != EmptySlotOffset)
+        SlotIdx = (SlotIdx + 1) & SlotMask;
+
+    Bucket.Slots[SlotIdx] = { static_cast<uint32>(FullHash >> 32), InBucketOffset };
+    Bucket.NumEntries++;
+}
+
 template<typename CharType>
-std::pair<HashStringTableIndex, bool> HashStringTable::AddUnchecked(const CharType* Str, int32 Length, uint8 Hash)
+std::pair<HashStringTableIndex, bool> HashStringTable::AddUnchecked(const CharType* Str, int32 Length, uint64 FullHash)
 {
     static_assert(std::is_same_v<CharType, char> || std::is_same_v<CharType, wchar_t>, "Invalid CharType! Type must be 'char' or 'wchar_t'.");
 
     const int32 LengthBytes = Length * sizeof(CharType);
 
+    const uint8 Hash = GetBucketIndex(FullHash);
+
     StringBucket& Bucket = Buckets[Hash];
 
     if (!CanFit(Bucket, LengthBytes))
-        ResizeBucket(Bucket);
+        ResizeBucket(Bucket, Bucket.Size + StringEntry::StringEntrySizeWithoutStr + LengthBytes);
 
     StringEntry& NewEmptyEntry = GetRefToEmpty(Bucket);
 
@@ -106,6 +180,8 @@ std::pair<HashStringTableIndex, bool> HashStringTable::AddUnchecked(const CharTy
     ReturnIndex.HashIndex = Hash;
     ReturnIndex.InBucketOffset = Bucket.Size;
 
+    InsertIntoIndex(Bucket, FullHash, Bucket.Size);
+
     Bucket.Size += NewEmptyEntry.GetLengthBytes();
 
     return { ReturnIndex, true };
@@ -135,23 +211,32 @@ const StringEntry& HashStringTable::GetStringEntry(HashStringTableIndex Index) c
 }
 
 template<typename CharType>
-HashStringTableIndex HashStringTable::Find(const CharType* Str, int32 Length, uint8 Hash)
+HashStringTableIndex HashStringTable::Find(const CharType* Str, int32 Length, uint64 FullHash)
 {
     constexpr bool bIsWchar = std::is_same_v<CharType, wchar_t>;
 
-    StringBucket& Bucket = Buckets[Hash];
+    const uint8 Hash = GetBucketIndex(FullHash);
+    const uint32 HashTag = static_cast<uint32>(FullHash >> 32);
 
-    /* Try to find duplications withing 'checked' regions */
-    for (auto It = HashBucketIterator::begin(Bucket); It != HashBucketIterator::end(Bucket); ++It)
+    const StringBucket& Bucket = Buckets[Hash];
+    const uint32 SlotMask = Bucket.NumSlots - 1;
+
+    /* Probe until the first empty slot, only entries with a matching tag are compared */
+    for (uint32 SlotIdx = static_cast<uint32>(FullHash) & SlotMask; Bucket.Slots[SlotIdx].InBucketOffset != EmptySlotOffset; SlotIdx = (SlotIdx + 1) & SlotMask)
     {
-        const StringEntry& Entry = *It;
+        const IndexSlot& Slot = Bucket.Slots[SlotIdx];
+
+        if (Slot.HashTag != HashTag)
+            continue;
+
+        const StringEntry& Entry = GetStringEntry(Bucket, Slot.InBucketOffset);
 
         if (Entry.Length == Length && Entry.bIsWide == bIsWchar && Strcmp(Str, Entry) == 0)
         {
             HashStringTableIndex Idx;
             Idx.Unused = 0x0;
             Idx.HashIndex = Hash;
-            Idx.InBucketOffset = It.GetInBucketIndex();
+            Idx.InBucketOffset = Slot.InBucketOffset;
 
             return Idx;
         }
@@ -173,9 +258,11 @@ inline std::pair<HashStringTableIndex, bool> HashStringTable::FindOrAdd(const Ch
         return { HashStringTableIndex(-1), false };
     }
 
-    uint8 Hash = SmallPearsonHash(Str);
+    const uint64 FullHash = StringHash64(Str, Length);
+
+    std::scoped_lock BucketLock(BucketLocks[GetBucketIndex(FullHash)]);
 
-    HashStringTableIndex ExistingIndex = Find(Str, Length, Hash);
+    HashStringTableIndex ExistingIndex = Find(Str, Length, FullHash);
 
     if (ExistingIndex != -1)
     {
@@ -192,7 +279,7 @@ inline std::pair<HashStringTableIndex, bool> HashStringTable::FindOrAdd(const Ch
     }
 
     // Only reached if Str wasn't found in StringTable, else entry is marked as not unique
-    return AddUnchecked(Str, Length, Hash);
+    return AddUnchecked(Str, Length, FullHash);
 }
 
 /* returns pair<Index, bWasAdded> */
@@ -215,6 +302,70 @@ int32 HashStringTable::GetTotalUsedSize() const
     return TotalMemoryUsed;
 }
 
+void HashStringTable::Compact()
+{
+    /* Smallest sizes that are still valid for an empty bucket */
+    constexpr uint32 MinBucketSize = 0x10;
+    constexpr uint32 MinNumIndexSlots = 0x10;
+
+    for (int i = 0; i < NumBuckets; i++)
+    {
+        StringBucket& Bucket = Buckets[i];
+
+        const uint32 NewSizeMax = std::max(Bucket.Size, MinBucketSize);
+
+        if (NewSizeMax < Bucket.SizeMax)
+        {
+            if (uint8* NewData = static_cast<uint8*>(realloc(Bucket.Data, NewSizeMax)))
+            {
+                Bucket.Data = NewData;
+                Bucket.SizeMax = NewSizeMax;
+            }
+        }
+
+        /* Same load-factor limit as InsertIntoIndex, with room for one more entry */
+        uint32 NewNumSlots = MinNumIndexSlots;
+
+        while ((Bucket.NumEntries + 1) * 4 > NewNumSlots * 3)
+            NewNumSlots *= 2;
+
+        if (NewNumSlots < Bucket.NumSlots)
+            RebuildIndex(Bucket, NewNumSlots);
+    }
+}
+
+void HashStringTable::Clear()
+{
+    for (int i = 0; i < NumBuckets; i++)
+    {
+        StringBucket& Bucket = Buckets[i];
+
+        Bucket.Size = 0x0;
+        Bucket.NumEntries = 0x0;
+
+        for (uint32 j = 0; j < Bucket.NumSlots; j++)
+            Bucket.Slots[j].InBucketOffset = EmptySlotOffset;
+    }
+}
+
+MemoryReport HashStringTable::GetMemoryReport() const
+{
+    MemoryReport Report;
+
+    for (int i = 0; i < NumBuckets; i++)
+    {
+        const StringBucket& Bucket = Buckets[i];
+
+        Report.BytesUsed += Bucket.Size + Bucket.NumEntries * sizeof(IndexSlot);
+        Report.BytesAllocated += Bucket.SizeMax + Bucket.NumSlots * sizeof(IndexSlot);
+        Report.NumEntries += Bucket.NumEntries;
+        Report.NumIndexedEntries += Bucket.NumEntries;
+        Report.NumIndexSlots += Bucket.NumSlots;
+    }
+
+    return Report;
+}
+
 void HashStringTable::DebugPrintStats() const
 {
     uint64 TotalMemoryUsed = 0x0;
@@ -227,7 +378,7 @@ void HashStringTable::DebugPrintStats() const
         TotalMemoryUsed += Bucket.Size;
         TotalMemoryAllocated += Bucket.SizeMax;
 
-        std::cerr << std::format("Bucket[{:02d}] = {{ Data = {:p}, Size = {:05X}, SizeMax = {:05X} }}\n", i, static_cast<void*>(Bucket.Data), Bucket.Size, Bucket.SizeMax);
+        std::cerr << std::format("Bucket[{:02d}] = {{ Data = {:p}, Size = {:05X}, SizeMax = {:05X}, NumEntries = {:X}, NumSlots = {:X} }}\n", i, static_cast<void*>(Bucket.Data), Bucket.Size, Bucket.SizeMax, Bucket.NumEntries, Bucket.NumSlots);
     }
 
     std::cerr ;
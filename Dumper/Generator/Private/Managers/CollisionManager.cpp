@@ -70,6 +70,69 @@ ParamNameCollisionCount: {};
 )", StringifyCollisionType(static_cast<ECollisionType>(OwnType)), MemberNameCollisionCount, SuperMemberNameCollisionCount, FunctionNameCollisionCount, SuperFuncNameCollisionCount, ParamNameCollisionCount);
 }
 
+void NameLookupTable::Grow()
+{
+	std::vector<NameInfo> OldSlots = std::move(Slots);
+
+	Slots = std::vector<NameInfo>(OldSlots.empty() ? InitialNumSlots : OldSlots.size() * 2);
+
+	const uint32 SlotMask = static_cast<uint32>(Slots.size()) - 1;
+
+	for (const NameInfo& Info : OldSlots)
+	{
+		if (!Info.IsValid())
+			continue;
+
+		uint32 SlotIdx = GetSlotIndex(Info.Name, SlotMask);
+
+		while (Slots[SlotIdx].IsValid())
+			SlotIdx = (SlotIdx + 1) & SlotMask;
+
+		Slots[SlotIdx] = Info;
+	}
+}
+
+const NameInfo* NameLookupTable::Find(HashStringTableIndex Name) const
+{
+	if (Slots.empty())
+		return nullptr;
+
+	const uint32 SlotMask = static_cast<uint32>(Slots.size()) - 1;
+
+	for (uint32 SlotIdx = GetSlotIndex(Name, SlotMask); Slots[SlotIdx].IsValid(); SlotIdx = (SlotIdx + 1) & SlotMask)
+	{
+		if (Slots[SlotIdx].Name == Name)
+			return &Slots[SlotIdx];
+	}
+
+	return nullptr;
+}
+
+void NameLookupTable::Add(const NameInfo& Info)
+{
+	/* Keep the load-factor below 1/2, empty slots terminate a probe */
+	if ((NumEntries + 1) * 2 > Slots.size())
+		Grow();
+
+	const uint32 SlotMask = static_cast<uint32>(Slots.size()) - 1;
+
+	uint32 SlotIdx = GetSlotIndex(Info.Name, SlotMask);
+
+	while (Slots[SlotIdx].IsValid())
+	{
+		if (Slots[SlotIdx].Name == Info.Name)
+		{
+			Slots[SlotIdx] = Info;
+			return;
+		}
+
+		SlotIdx = (SlotIdx + 1) & SlotMask;
+	}
+
+	Slots[SlotIdx] = Info;
+	NumEntries++;
+}
+
 uint64 KeyFunctions::GetKeyForCollisionInfo(UEStruct Super, UEProperty Member)
 {
 	uint64 Key = 0x0;
@@ -100,8 +163,36 @@ uint64 KeyFunctions::GetKeyForCollisionInfo([[maybe_unused]] UEStruct Super, UEF
 	return Key;
 }
 
-uint64 CollisionManager::AddNameToContainer(NameContainer& StructNames, UEStruct Struct, std::pair<HashStringTableIndex, bool>&& NamePair, ECollisionType CurrentType, bool bIsStruct, UEFunction Func)
+const NameLookupTable& CollisionManager::GetInheritedNames(UEStruct Super)
 {
+	const int32 SuperIndex = Super.GetIndex();
+
+	if (auto It = InheritedNameTables.find(SuperIndex); It != InheritedNameTables.end())
+		return It->second;
+
+	/* Start with everything 'Super' inherits itself, names declared by 'Super' replace those of its supers */
+	NameLookupTable Table;
+
+	if (UEStruct SuperOfSuper = Super.GetSuper())
+		Table = GetInheritedNames(SuperOfSuper);
+
+	for (const NameInfo& Info : NameInfos[SuperIndex])
+		Table.Add(Info);
+
+	return InheritedNameTables.emplace(SuperIndex, std::move(Table)).first->second;
+}
+
+uint64 CollisionManager::AddNameToContainer(NameContainer& StructNames, const NameLookupTable& StructNameTable, UEStruct Struct, std::pair<HashStringTableIndex, bool>&& NamePair, ECollisionType CurrentType, bool bIsStruct, UEFunction Func)
+{
+	static auto AddCollidingInfo = [](const NameInfo& ExistingName, NameContainer* OutTargetNames, HashStringTableIndex NameIdx, ECollisionType CurrentType, bool bIsSuper) -> void
+	{
+		assert(OutTargetNames && "Target container was nullptr!");
+
+		NameInfo NewInfo(NameIdx, CurrentType);
+		NewInfo.InitCollisionData(ExistingName, CurrentType, bIsSuper);
+		OutTargetNames->push_back(NewInfo);
+	};
+
 	static auto AddCollidingName = [](const NameContainer& SearchNames, NameContainer* OutTargetNames, HashStringTableIndex NameIdx, ECollisionType CurrentType, bool bIsSuper) -> bool
 	{
 		assert(OutTargetNames && "Target container was nullptr!");
@@ -163,16 +254,20 @@ uint64 CollisionManager::AddNameToContainer(NameContainer& StructNames, UEStruct
 	NameContainer* TargetNameContainer = bIsParameter ? FuncParamNames : &StructNames;
 
 	/* Check all member-names from this struct and see if we're colliding with one of them */
-	if (AddCollidingName(StructNames, TargetNameContainer, NameIdx, CurrentType, false))
+	if (const NameInfo* ExistingName = StructNameTable.Find(NameIdx))
+	{
+		AddCollidingInfo(*ExistingName, TargetNameContainer, NameIdx, CurrentType, false);
 		return TargetNameContainer->size() - 1;
+	}
 
-	/* This possibly duplicated name doesn't occcure in the NameList of the struct itself, so check all supers to see if we're colliding with a super's name. */
-	for (UEStruct Current = Struct.GetSuper(); Current; Current = Current.GetSuper())
+	/* This possibly duplicated name doesn't occcure in the NameList of the struct itself, so check if we're colliding with the name of the closest super declaring it. */
+	if (UEStruct Super = Struct.GetSuper())
 	{
-		NameContainer& SuperNames = NameInfos[Current.GetIndex()];
-
-		if (AddCollidingName(SuperNames, TargetNameContainer, NameIdx, CurrentType, true))
+		if (const NameInfo* ExistingName = GetInheritedNames(Super).Find(NameIdx))
+		{
+			AddCollidingInfo(*ExistingName, TargetNameContainer, NameIdx, CurrentType, true);
 			return TargetNameContainer->size() - 1;
+		}
 	}
 
 	if (!bIsStruct)
@@ -232,9 +327,17 @@ void CollisionManager::AddStructToNameContainer(UEStruct Struct, bool bIsStruct)
 	if (!StructNames.empty())
 		return;
 
+	/* Latest NameInfo for every name in StructNames */
+	NameLookupTable StructNameTable;
+
 	auto AddToContainerAndTranslationMap = [&](auto Member, ECollisionType CollisionType, bool bIsStruct, UEFunction Func = nullptr) -> void
 	{
-		const uint64 Index = AddNameToContainer(StructNames, Struct, MemberNames.FindOrAdd(Member.GetValidName()), CollisionType, bIsStruct, Func);
+		const size_t OldNumStructNames = StructNames.size();
+
+		const uint64 Index = AddNameToContainer(StructNames, StructNameTable, Struct, MemberNames.FindOrAdd(Member.GetValidName()), CollisionType, bIsStruct, Func);
+
+		if (StructNames.size() != OldNumStructNames)
+			StructNameTable.Add(StructNames.back());
 
 		const auto [It, bInserted] = TranslationMap.emplace(KeyFunctions::GetKeyForCollisionInfo(Struct, Member), Index);
 		
@@ -254,6 +357,55 @@ void CollisionManager::AddStructToNameContainer(UEStruct Struct, bool bIsStruct)
 	}
 };
 
+void CollisionManager::ReleaseLookupTables()
+{
+	InheritedNameTables.clear();
+}
+
+MemoryReport CollisionManager::GetMemoryReport() const
+{
+	MemoryReport Report = MemberNames.GetMemoryReport();
+
+	Report += MemoryReport::FromHashContainer(NameInfos);
+
+	for (const auto& [Key, Infos] : NameInfos)
+		Report += MemoryReport::FromVector(Infos);
+
+	Report += MemoryReport::FromHashContainer(TranslationMap);
+	Report += MemoryReport::FromVector(ClassReservedNames);
+	Report += MemoryReport::FromVector(ReservedNames);
+	Report += MemoryReport::FromHashContainer(InheritedNameTables);
+
+	return Report;
+}
+
+void CollisionManager::Compact()
+{
+	MemberNames.Compact();
+
+	/* Containers of structs grow by push_back, most of them end up with unused capacity */
+	for (auto& [Key, Infos] : NameInfos)
+		Infos.shrink_to_fit();
+
+	ClassReservedNames.shrink_to_fit();
+	ReservedNames.shrink_to_fit();
+
+	/* Drops buckets left over from growing, the maps are only read from now on */
+	NameInfos.rehash(0);
+	TranslationMap.rehash(0);
+}
+
+void CollisionManager::Reset()
+{
+	MemberNames.Clear();
+
+	NameInfos.clear();
+	TranslationMap.clear();
+	ClassReservedNames.clear();
+	ReservedNames.clear();
+	InheritedNameTables.clear();
+}
+
 std::string CollisionManager::StringifyName(UEStruct Struct, NameInfo Info)
 {
 	ECollisionType OwnCollisionType = static_cast<ECollisionType>(Info.OwnType);
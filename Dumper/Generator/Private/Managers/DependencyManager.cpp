@@ -2,59 +2,135 @@
 
 DependencyManager::DependencyManager(int32 ObjectToTrack)
 {
-	AllDependencies.try_emplace(ObjectToTrack, IndexDependencyInfo{ });
+	PendingDependencies.try_emplace(ObjectToTrack);
 }
 
 void DependencyManager::SetExists(const int32 DepedantIdx)
 {
-	AllDependencies[DepedantIdx];
+	PendingDependencies[DepedantIdx];
 }
 
 void DependencyManager::AddDependency(const int32 DepedantIdx, int32 DependencyIndex)
 {
-	AllDependencies[DepedantIdx].DependencyIndices.insert(DependencyIndex);
+	PendingDependencies[DepedantIdx].insert(DependencyIndex);
 }
 
 void DependencyManager::SetDependencies(const int32 DepedantIdx, std::unordered_set<int32>&& Dependencies)
 {
-	AllDependencies[DepedantIdx].DependencyIndices = std::move(Dependencies);
+	PendingDependencies[DepedantIdx] = std::move(Dependencies);
 }
 
-size_t DependencyManager::GetNumEntries() const
+void DependencyManager::Freeze()
 {
-	return AllDependencies.size();
-}
+	if (bIsFrozen)
+		return;
 
-void DependencyManager::VisitIndexAndDependencies(int32 Index, OnVisitCallbackType Callback) const
-{
-	auto& [IterationHitCounter, Dependencies] = AllDependencies.at(Index);
+	bIsFrozen = true;
 
-	if (IterationHitCounter >= CurrentIterationHitCount)
-		return;
+	const int32 NumNodes = static_cast<int32>(PendingDependencies.size());
 
-	IterationHitCounter = CurrentIterationHitCount;
+	NodeObjectIndices.reserve(NumNodes);
+	NodeLookup.reserve(NumNodes);
 
-	for (int32 Dependency : Dependencies)
+	/* Nodes keep the order of the hashmap, so the sorted order is the same as the one the recursive visit used to produce */
+	for (const auto& [Index, Dependencies] : PendingDependencies)
 	{
-		VisitIndexAndDependencies(Dependency, Callback);
+		NodeLookup.emplace(Index, static_cast<int32>(NodeObjectIndices.size()));
+		NodeObjectIndices.push_back(Index);
+	}
+
+	EdgeOffsets.reserve(NumNodes + 1);
+
+	for (const auto& [Index, Dependencies] : PendingDependencies)
+	{
+		EdgeOffsets.push_back(static_cast<int32>(Edges.size()));
+
+		for (const int32 Dependency : Dependencies)
+		{
+			/* Dependencies on objects that aren't part of this graph don't affect the order */
+			auto It = NodeLookup.find(Dependency);
+
+			if (It != NodeLookup.end())
+				Edges.push_back(It->second);
+		}
+	}
+
+	EdgeOffsets.push_back(static_cast<int32>(Edges.size()));
+
+	PendingDependencies = std::unordered_map<int32, std::unordered_set<int32>>();
+
+	/* Iterative post-order DFS over all nodes */
+	SortedObjectIndices.reserve(NumNodes);
+
+	std::vector<bool> bWasVisited(NumNodes, false);
+	std::vector<std::pair<int32, int32>> Stack;
+
+	for (int32 Root = 0; Root < NumNodes; Root++)
+	{
+		if (bWasVisited[Root])
+			continue;
+
+		bWasVisited[Root] = true;
+		Stack.emplace_back(Root, EdgeOffsets[Root]);
+
+		while (!Stack.empty())
+		{
+			auto& [Node, NextEdge] = Stack.back();
+
+			if (NextEdge == EdgeOffsets[Node + 1])
+			{
+				SortedObjectIndices.push_back(NodeObjectIndices[Node]);
+				Stack.pop_back();
+				continue;
+			}
+
+			const int32 Dependency = Edges[NextEdge++];
+
+			if (bWasVisited[Dependency])
+				continue;
+
+			bWasVisited[Dependency] = true;
+			Stack.emplace_back(Dependency, EdgeOffsets[Dependency]);
+		}
 	}
+}
 
-	Callback(Index);
+size_t DependencyManager::GetNumEntries() const
+{
+	return bIsFrozen ? NodeObjectIndices.size() : PendingDependencies.size();
 }
 
 void DependencyManager::VisitIndexAndDependenciesWithCallback(int32 Index, OnVisitCallbackType Callback) const
 {
-	CurrentIterationHitCount++;
-
 	VisitIndexAndDependencies(Index, Callback);
 }
 
 void DependencyManager::VisitAllNodesWithCallback(OnVisitCallbackType Callback) const
 {
-	CurrentIterationHitCount++;
+	VisitAllNodes(Callback);
+}
 
-	for (const auto& [Index, DependencyInfo] : AllDependencies)
-	{
-		VisitIndexAndDependencies(Index, Callback);
-	}
+MemoryReport DependencyManager::GetMemoryReport() const
+{
+	MemoryReport Report = MemoryReport::FromHashContainer(PendingDependencies);
+
+	for (const auto& [Index, Dependencies] : PendingDependencies)
+		Report += MemoryReport::FromHashContainer(Dependencies);
+
+	Report += MemoryReport::FromVector(NodeObjectIndices);
+	Report += MemoryReport::FromHashContainer(NodeLookup);
+	Report += MemoryReport::FromVector(EdgeOffsets);
+	Report += MemoryReport::FromVector(Edges);
+	Report += MemoryReport::FromVector(SortedObjectIndices);
+
+	return Report;
+}
+
+void DependencyManager::Compact()
+{
+	/* Edges were appended without knowing their final count */
+	Edges.shrink_to_fit();
+	NodeObjectIndices.shrink_to_fit();
+	EdgeOffsets.shrink_to_fit();
+	SortedObjectIndices.shrink_to_fit();
 }
@@ -1,4 +1,9 @@
+#include <algorithm>
+
+#include "Unreal/ObjectArray.h"
+#include "Unreal/StructMemberCache.h"
 #include "Managers/EnumManager.h"
+#include "ShardedObjectScan.h"
 
 namespace EnumInitHelper
 {
@@ -67,135 +72,184 @@ const StringEntry& EnumInfoHandle::GetName() const
 
 int32 EnumInfoHandle::GetNumMembers() const
 {
-	return Info->MemberInfos.size();
+	return Info->NumMemberInfos;
 }
 
 CollisionInfoIterator EnumInfoHandle::GetMemberCollisionInfoIterator() const
 {
-	return CollisionInfoIterator(Info->MemberInfos);
+	return CollisionInfoIterator(EnumManager::GetMemberInfos(*Info));
 }
 
 void EnumManager::InitInternal()
 {
-	for (auto Obj : ObjectArray())
+	/* An enum decoded by a worker-thread. Members are stored in the shards' member-list. */
+	struct DecodedEnum
 	{
-		if (Obj.HasAnyFlags(EObjectFlags::ClassDefaultObject))
-			continue;
+		HashStringTableIndex Name;
+		uint64 MaxValue;
 
-		if (Obj.IsA(EClassCastFlags::Struct))
-		{
-			UEStruct ObjAsStruct = Obj.Cast<UEStruct>();
+		int32 FirstMember;
+		int32 NumMembers;
+	};
 
-			for (UEProperty Property : ObjAsStruct.GetProperties())
-			{
-				if (!Property.IsA(EClassCastFlags::EnumProperty) && !Property.IsA(EClassCastFlags::ByteProperty))
-					continue;
+	/* Either an enum-object (DecodedEnumIndex != -1), or a property of a struct that is an instance of the enum */
+	struct EnumEvent
+	{
+		int32 EnumIndex;
+		int32 DecodedEnumIndex;
+		uint8 InstanceSize;
+	};
 
-				UEEnum Enum = nullptr;
-				UEProperty UnderlayingProperty = nullptr;
+	struct EnumShard
+	{
+		std::vector<EnumEvent> Events;
+		std::vector<DecodedEnum> Enums;
+		std::vector<EnumCollisionInfo> Members;
+	};
 
-				if (Property.IsA(EClassCastFlags::EnumProperty))
-				{
-					Enum = Property.Cast<UEEnumProperty>().GetEnum();
-					UnderlayingProperty = Property.Cast<UEEnumProperty>().GetUnderlayingProperty();
+	auto DecodeEnum = [](UEEnum ObjAsEnum, EnumShard& Shard) -> DecodedEnum
+	{
+		DecodedEnum Decoded;
+		Decoded.Name = UniqueEnumNameTable.FindOrAdd(ObjAsEnum.GetEnumPrefixedName()).first;
+		Decoded.MaxValue = 0x0;
+		Decoded.FirstMember = static_cast<int32>(Shard.Members.size());
+
+		/* Initialize enum-member names and their collision infos */
+		const std::vector<std::pair<FName, int64>> NameValuePairs = ObjAsEnum.GetNameValuePairs();
+		for (int i = 0; i < NameValuePairs.size(); i++)
+		{
+			auto& [Name, Value] = NameValuePairs[i];
 
-					if (!UnderlayingProperty)
-						continue;
-				}
-				else /* ByteProperty */
-				{
-					Enum = Property.Cast<UEByteProperty>().GetEnum();
-					UnderlayingProperty = Property;
-				}
+			std::wstring NameWitPrefix = Name.ToWString();
 
-				if (!Enum)
-					continue;
+			if (!NameWitPrefix.ends_with(L"_MAX"))
+				Decoded.MaxValue = max(Decoded.MaxValue, Value);
 
-				EnumInfo& Info = EnumInfoOverrides[Enum.GetIndex()];
+			auto [NameIndex, bWasInserted] = UniqueEnumValueNames.FindOrAdd(MakeNameValid(NameWitPrefix.substr(NameWitPrefix.find_last_of(L"::") + 1)));
 
-				Info.bWasInstanceFound = true;
-				Info.UnderlyingTypeSize = 0x1;
+			EnumCollisionInfo CurrentEnumValueInfo;
+			CurrentEnumValueInfo.MemberName = NameIndex;
+			CurrentEnumValueInfo.MemberValue = Value;
 
-				/* Check if the size of this enums underlaying type is greater than the default size (0x1) */
-				if (Enum)
-				{
-					Info.UnderlyingTypeSize = Property.GetSize();
+			if (bWasInserted) [[likely]]
+			{
+				Shard.Members.push_back(CurrentEnumValueInfo);
+				continue;
+			}
+
+			/* A value with this name exists globally, now check if it also exists localy (aka. is duplicated) */
+			for (int j = 0; j < i; j++)
+			{
+				EnumCollisionInfo& CrosscheckedInfo = Shard.Members[Decoded.FirstMember + j];
+
+				if (CrosscheckedInfo.MemberName != NameIndex) [[likely]]
 					continue;
-				}
 
-				if (UnderlayingProperty)
+				/* Duplicate was found */
+				CurrentEnumValueInfo.CollisionCount = CrosscheckedInfo.CollisionCount + 1;
+				break;
+			}
+
+			/* Check if this name is illegal */
+			for (HashStringTableIndex IllegalIndex : IllegalNames)
+			{
+				if (NameIndex == IllegalIndex) [[unlikely]]
 				{
-					Info.UnderlyingTypeSize = UnderlayingProperty.GetSize();
-					continue;
+					CurrentEnumValueInfo.CollisionCount++;
+					break;
 				}
 			}
+
+			Shard.Members.push_back(CurrentEnumValueInfo);
 		}
-		else if (Obj.IsA(EClassCastFlags::Enum))
-		{
-			UEEnum ObjAsEnum = Obj.Cast<UEEnum>();
 
-			/* Add name to override info */
-			EnumInfo& NewOrExistingInfo = EnumInfoOverrides[Obj.GetIndex()];
-			NewOrExistingInfo.Name = UniqueEnumNameTable.FindOrAdd(ObjAsEnum.GetEnumPrefixedName()).first;
+		Decoded.NumMembers = static_cast<int32>(Shard.Members.size()) - Decoded.FirstMember;
 
-			uint64 EnumMaxValue = 0x0;
+		return Decoded;
+	};
 
-			/* Initialize enum-member names and their collision infos */
-			std::vector<std::pair<FName, int64>> NameValuePairs = ObjAsEnum.GetNameValuePairs();
-			for (int i = 0; i < NameValuePairs.size(); i++)
+	/* Enums are decoded and their member-names interned in parallel */
+	auto CollectShard = [&DecodeEnum](int32 StartIndex, int32 EndIndex, EnumShard& Shard) -> void
+	{
+		ShardedObjectScan::ForEachObjectInRange(StartIndex, EndIndex, [&](const UEObject Obj) -> void
+		{
+			if (Obj.HasAnyFlags(EObjectFlags::ClassDefaultObject))
+				return;
+
+			if (Obj.IsA(EClassCastFlags::Struct))
 			{
-				auto& [Name, Value] = NameValuePairs[i];
-					
-				std::wstring NameWitPrefix = Name.ToWString();
+				for (UEProperty Property : StructMemberCache::GetProperties(Obj.Cast<UEStruct>()))
+				{
+					UEEnum Enum = nullptr;
 
-				if (!NameWitPrefix.ends_with(L"_MAX"))
-					EnumMaxValue = max(EnumMaxValue, Value);
+					if (Property.IsA(EClassCastFlags::EnumProperty))
+					{
+						if (!Property.Cast<UEEnumProperty>().GetUnderlayingProperty())
+							continue;
 
-				auto [NameIndex, bWasInserted] = UniqueEnumValueNames.FindOrAdd(MakeNameValid(NameWitPrefix.substr(NameWitPrefix.find_last_of(L"::") + 1)));
+						Enum = Property.Cast<UEEnumProperty>().GetEnum();
+					}
+					else if (Property.IsA(EClassCastFlags::ByteProperty))
+					{
+						Enum = Property.Cast<UEByteProperty>().GetEnum();
+					}
 
-				EnumCollisionInfo CurrentEnumValueInfo;
-				CurrentEnumValueInfo.MemberName = NameIndex;
-				CurrentEnumValueInfo.MemberValue = Value;
+					if (!Enum)
+						continue;
 
-				if (bWasInserted) [[likely]]
-				{
-					NewOrExistingInfo.MemberInfos.push_back(CurrentEnumValueInfo);
-					continue;
+					/* The size of the property is the size of this enums underlaying type */
+					Shard.Events.push_back({ Enum.GetIndex(), -1, static_cast<uint8>(Property.GetSize()) });
 				}
+			}
+			else if (Obj.IsA(EClassCastFlags::Enum))
+			{
+				Shard.Events.push_back({ Obj.GetIndex(), static_cast<int32>(Shard.Enums.size()), 0x0 });
+				Shard.Enums.push_back(DecodeEnum(Obj.Cast<UEEnum>(), Shard));
+			}
+		});
+	};
 
-				/* A value with this name exists globally, now check if it also exists localy (aka. is duplicated) */
-				for (int j = 0; j < i; j++)
-				{
-					EnumCollisionInfo& CrosscheckedInfo = NewOrExistingInfo.MemberInfos[j];
+	std::vector<EnumShard> Shards = ShardedObjectScan::Run<EnumShard>(ShardedObjectScan::GetNumObjects(), CollectShard);
 
-					if (CrosscheckedInfo.MemberName != NameIndex) [[likely]]
-						continue;
+	size_t TotalNumMembers = 0x0;
+	for (const EnumShard& Shard : Shards)
+		TotalNumMembers += Shard.Members.size();
 
-					/* Duplicate was found */
-					CurrentEnumValueInfo.CollisionCount = CrosscheckedInfo.CollisionCount + 1;
-					break;
-				}
+	EnumMemberInfos.reserve(TotalNumMembers);
 
-				/* Check if this name is illegal */
-				for (HashStringTableIndex IllegalIndex : IllegalNames)
-				{
-					if (NameIndex == IllegalIndex) [[unlikely]]
-					{
-						CurrentEnumValueInfo.CollisionCount++;
-						break;
-					}
-				}
+	/* Apply the results in order of the object-indices, the last instance found for an enum determines its size */
+	for (EnumShard& Shard : Shards)
+	{
+		const int32 MemberOffset = static_cast<int32>(EnumMemberInfos.size());
+		EnumMemberInfos.insert(EnumMemberInfos.end(), Shard.Members.begin(), Shard.Members.end());
 
-				NewOrExistingInfo.MemberInfos.push_back(CurrentEnumValueInfo);
+		for (const EnumEvent& Event : Shard.Events)
+		{
+			EnumInfo& Info = EnumInfoOverrides[Event.EnumIndex];
+
+			if (Event.DecodedEnumIndex == -1)
+			{
+				Info.bWasInstanceFound = true;
+				Info.UnderlyingTypeSize = Event.InstanceSize;
+				continue;
 			}
 
+			const DecodedEnum& Decoded = Shard.Enums[Event.DecodedEnumIndex];
+
+			/* Add name to override info */
+			Info.Name = Decoded.Name;
+			Info.FirstMemberInfo = MemberOffset + Decoded.FirstMember;
+			Info.NumMemberInfos = Decoded.NumMembers;
+
 			/* Initialize the size based on the highest value contained by this enum */
-			if (!NewOrExistingInfo.bWasEnumSizeInitialized && !NewOrExistingInfo.bWasInstanceFound)
+			if (!Info.bWasEnumSizeInitialized && !Info.bWasInstanceFound)
 			{
-				EnumInitHelper::SetEnumSizeForValue(NewOrExistingInfo.UnderlyingTypeSize, EnumMaxValue);
-				NewOrExistingInfo.bWasEnumSizeInitialized = true;
+				EnumInitHelper::SetEnumSizeForValue(Info.UnderlyingTypeSize, Decoded.MaxValue);
+				Info.bWasEnumSizeInitialized = true;
 			}
 		}
+
+		Shard = EnumShard();
 	}
 }
 
@@ -229,3 +283,38 @@ void EnumManager::Init()
 	InitIllegalNames(); // call this first
 	InitInternal();
 }
+
+MemoryReport EnumManager::GetMemoryReport()
+{
+	MemoryReport Report = UniqueEnumNameTable.GetMemoryReport();
+
+	Report += UniqueEnumValueNames.GetMemoryReport();
+	Report += MemoryReport::FromHashContainer(EnumInfoOverrides);
+	Report += MemoryReport::FromVector(EnumMemberInfos);
+	Report += MemoryReport::FromVector(IllegalNames);
+
+	return Report;
+}
+
+void EnumManager::Compact()
+{
+	UniqueEnumNameTable.Compact();
+	UniqueEnumValueNames.Compact();
+
+	/* EnumInfos address their members by index, moving the block is safe */
+	EnumMemberInfos.shrink_to_fit();
+	IllegalNames.shrink_to_fit();
+
+	EnumInfoOverrides.rehash(0);
+}
+
+void EnumManager::Reset()
+{
+	bIsInitialized = false;
+
+	UniqueEnumNameTable.Clear();
+	EnumInfoOverrides.clear();
+	UniqueEnumValueNames.Clear();
+	EnumMemberInfos.clear();
+	IllegalNames.clear();
+}
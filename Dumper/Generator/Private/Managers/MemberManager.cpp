@@ -1,16 +1,40 @@
 #include <algorithm>
 
+#include "Unreal/StructMemberCache.h"
 #include "Managers/MemberManager.h"
 #include "Wrappers/MemberWrappers.h"
+#include "GeneratorContext.h"
 
 MemberManager::MemberManager(UEStruct Str)
-	: Struct(std::make_shared<StructWrapper>(Str))
-	, Functions(Str.GetFunctions())
-	, Members(Str.GetProperties())
+	: Struct(std::allocate_shared<StructWrapper>(std::pmr::polymorphic_allocator<StructWrapper>(GeneratorArena::GetResource()), Str))
+	, Functions(GeneratorArena::GetResource())
+	, Members(GeneratorArena::GetResource())
 {
-	// sorts functions/members in O(n * log(n)), can be sorted via radix, O(n), but the overhead might not be worth it
+	if (StructMemberCache::Contains(Str.GetIndex()))
+	{
+		const auto CachedFunctions = StructMemberCache::GetFunctions(Str);
+		const auto CachedMembers = StructMemberCache::GetProperties(Str);
+
+		// Members in the cache are already sorted by offset
+		Functions.assign(CachedFunctions.begin(), CachedFunctions.end());
+		Members.assign(CachedMembers.begin(), CachedMembers.end());
+	}
+	else
+	{
+		const std::vector<UEFunction> StructFunctions = Str.GetFunctions();
+		const std::vector<UEProperty> StructMembers = Str.GetProperties();
+
+		Functions.assign(StructFunctions.begin(), StructFunctions.end());
+		Members.assign(StructMembers.begin(), StructMembers.end());
+
+		std::sort(Members.begin(), Members.end(), CompareUnrealProperties);
+	}
+
+	// sorts functions in O(n * log(n)), can be sorted via radix, O(n), but the overhead might not be worth it
 	std::sort(Functions.begin(), Functions.end(), CompareUnrealFunctions);
-	std::sort(Members.begin(), Members.end(), CompareUnrealProperties);
+
+	/* Predefined members belong to the generator running on this thread */
+	const PredefinedMemberLookupMapType* PredefinedMemberLookup = GeneratorContext::GetPredefinedMembers();
 
 	if (!PredefinedMemberLookup)
 		return;
@@ -24,9 +48,9 @@ MemberManager::MemberManager(UEStruct Str)
 }
 
 MemberManager::MemberManager(const PredefinedStruct* Str)
-	: Struct(std::make_shared<StructWrapper>(Str))
-	, Functions()
-	, Members()
+	: Struct(std::allocate_shared<StructWrapper>(std::pmr::polymorphic_allocator<StructWrapper>(GeneratorArena::GetResource()), Str))
+	, Functions(GeneratorArena::GetResource())
+	, Members(GeneratorArena::GetResource())
 	, PredefMembers(&Str->Properties)
 	, PredefFunctions(&Str->Functions)
 {
@@ -64,12 +88,12 @@ bool MemberManager::HasMembers() const
 
 MemberIterator<true> MemberManager::IterateMembers() const
 {
-	return MemberIterator<true>(Struct, Members, PredefMembers);
+	return MemberIterator<true>(Struct.get(), Members, PredefMembers);
 }
 
 FunctionIterator<true> MemberManager::IterateFunctions() const
 {
-	return FunctionIterator<true>(Struct, Functions, PredefFunctions);
+	return FunctionIterator<true>(Struct.get(), Functions, PredefFunctions);
 }
 
 void MemberManager::InitReservedNames()
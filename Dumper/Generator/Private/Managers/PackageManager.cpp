@@ -1,6 +1,12 @@
+#include <algorithm>
+#include <format>
+#include <iostream>
+
 #include "Unreal/ObjectArray.h"
+#include "Unreal/StructMemberCache.h"
 
 #include "Managers/PackageManager.h"
+#include "ShardedObjectScan.h"
 
 /* Required for marking cyclic-headers in the StructManager */
 #include "Managers/StructManager.h"
@@ -112,31 +118,31 @@ const DependencyInfo& PackageInfoHandle::GetPackageDependencies() const
 
 void PackageInfoHandle::ErasePackageDependencyFromStructs(int32 Package) const
 {
-	Info->PackageDependencies.StructsDependencies.erase(Package);
+	Info->PackageDependencies.StructsDependencies.Erase(PackageManager::GetDenseIndex(Package));
 }
 
 void PackageInfoHandle::ErasePackageDependencyFromClasses(int32 Package) const
 {
-	Info->PackageDependencies.ClassesDependencies.erase(Package);
+	Info->PackageDependencies.ClassesDependencies.Classes.Clear(PackageManager::GetDenseIndex(Package));
 }
 
 namespace PackageManagerUtils
 {
-	void GetPropertyDependency(UEProperty Prop, std::unordered_set<int32>& Store)
+	void GetPropertyDependency(UEProperty Prop, std::vector<int32>& Store)
 	{
 		if (Prop.IsA(EClassCastFlags::StructProperty))
 		{
-			Store.insert(Prop.Cast<UEStructProperty>().GetUnderlayingStruct().GetIndex());
+			Store.push_back(Prop.Cast<UEStructProperty>().GetUnderlayingStruct().GetIndex());
 		}
 		else if (Prop.IsA(EClassCastFlags::EnumProperty))
 		{
 			if (UEObject Enum = Prop.Cast<UEEnumProperty>().GetEnum())
-				Store.insert(Enum.GetIndex());
+				Store.push_back(Enum.GetIndex());
 		}
 		else if (Prop.IsA(EClassCastFlags::ByteProperty))
 		{
 			if (UEObject Enum = Prop.Cast<UEByteProperty>().GetEnum())
-				Store.insert(Enum.GetIndex());
+				Store.push_back(Enum.GetIndex());
 		}
 		else if (Prop.IsA(EClassCastFlags::ArrayProperty))
 		{
@@ -163,75 +169,189 @@ namespace PackageManagerUtils
 			if (!SignatureFunction)
 				return;
 
-			for (UEProperty DelegateParam : SignatureFunction.GetProperties())
+			for (UEProperty DelegateParam : StructMemberCache::GetProperties(SignatureFunction))
 			{
 				GetPropertyDependency(DelegateParam, Store);
 			}
 		}
 	}
 
-	std::unordered_set<int32> GetDependencies(UEStruct Struct, int32 StructIndex)
+	void GetDependencies(UEStruct Struct, std::vector<int32>& OutDependencies)
+	{
+		OutDependencies.clear();
+
+		for (UEProperty Property : StructMemberCache::GetProperties(Struct))
+		{
+			GetPropertyDependency(Property, OutDependencies);
+		}
+
+		std::sort(OutDependencies.begin(), OutDependencies.end());
+		OutDependencies.erase(std::unique(OutDependencies.begin(), OutDependencies.end()), OutDependencies.end());
+
+		auto SelfIt = std::lower_bound(OutDependencies.begin(), OutDependencies.end(), Struct.GetIndex());
+
+		if (SelfIt != OutDependencies.end() && *SelfIt == Struct.GetIndex())
+			OutDependencies.erase(SelfIt);
+	}
+
+	/* A struct or enum required by a struct or function, with everything the reduction needs to know about it */
+	struct ExtractedDependency
+	{
+		int32 ObjectIdx;
+		int32 PackageIdx;
+		bool bIsEnum;
+	};
+
+	struct ExtractedFunction
+	{
+		int32 FuncIdx;
+		int32 PackageIdx;
+		bool bHasMembers;
+
+		int32 FirstDependency;
+		int32 NumDependencies;
+	};
+
+	struct ExtractedObject
 	{
-		std::unordered_set<int32> Dependencies;
+		int32 ObjectIdx;
+		int32 PackageIdx;
+
+		bool bIsEnum;
+		bool bIsClass;
+
+		int32 SuperIdx;
+		int32 SuperPackageIdx;
+
+		int32 FirstDependency;
+		int32 NumDependencies;
 
-		const int32 StructIdx = Struct.GetIndex();
+		int32 FirstFunction;
+		int32 NumFunctions;
+	};
+
+	/* Everything extracted from one range of GObjects, in order of the object-indices */
+	struct DependencyShard
+	{
+		std::vector<ExtractedObject> Objects;
+		std::vector<ExtractedFunction> Functions;
+		std::vector<ExtractedDependency> Dependencies;
 
-		for (UEProperty Property : Struct.GetProperties())
+		inline std::span<const ExtractedDependency> GetDependencies(int32 First, int32 Num) const
 		{
-			GetPropertyDependency(Property, Dependencies);
+			return std::span<const ExtractedDependency>(Dependencies.data() + First, Num);
 		}
+	};
 
-		Dependencies.erase(StructIdx);
+	/* Appends the dependencies of 'Struct' to the shard, returns the number of dependencies added */
+	int32 ExtractDependencies(UEStruct Struct, DependencyShard& Shard, std::vector<int32>& Scratch)
+	{
+		GetDependencies(Struct, Scratch);
+
+		for (const int32 DependencyIdx : Scratch)
+		{
+			const UEObject DependencyObject = ObjectArray::GetByIndex(DependencyIdx);
+
+			Shard.Dependencies.push_back({ DependencyIdx, DependencyObject.GetPackageIndex(), DependencyObject.IsA(EClassCastFlags::Enum) });
+		}
 
-		return Dependencies;
+		return static_cast<int32>(Scratch.size());
 	}
 
-	inline void SetPackageDependencies(DependencyListType& DependencyTracker, const std::unordered_set<int32>& Dependencies, int32 StructPackageIdx, bool bAllowToIncludeOwnPackage = false)
+	/* Only reads from GObjects and StructMemberCache, safe to be called for different shards in parallel */
+	void ExtractShard(int32 StartIndex, int32 EndIndex, DependencyShard& Shard, std::vector<int32>& Scratch)
 	{
-		for (int32 Dependency : Dependencies)
+		ShardedObjectScan::ForEachObjectInRange(StartIndex, EndIndex, [&](const UEObject Obj) -> void
 		{
-			const int32 PackageIdx = ObjectArray::GetByIndex(Dependency).GetPackageIndex();
+			if (Obj.HasAnyFlags(EObjectFlags::ClassDefaultObject))
+				return;
 
+			const bool bIsStruct = Obj.IsA(EClassCastFlags::Struct);
+			const bool bIsFunction = Obj.IsA(EClassCastFlags::Function);
+			const bool bIsEnum = Obj.IsA(EClassCastFlags::Enum);
+
+			if (!(bIsStruct && !bIsFunction) && !bIsEnum)
+				return;
 
-			if (bAllowToIncludeOwnPackage || PackageIdx != StructPackageIdx)
+			ExtractedObject& Extracted = Shard.Objects.emplace_back();
+			Extracted.ObjectIdx = Obj.GetIndex();
+			Extracted.PackageIdx = Obj.GetPackageIndex();
+			Extracted.bIsEnum = bIsEnum;
+			Extracted.bIsClass = Obj.IsA(EClassCastFlags::Class);
+			Extracted.SuperIdx = -1;
+			Extracted.SuperPackageIdx = -1;
+			Extracted.FirstDependency = static_cast<int32>(Shard.Dependencies.size());
+			Extracted.NumDependencies = 0x0;
+			Extracted.FirstFunction = static_cast<int32>(Shard.Functions.size());
+			Extracted.NumFunctions = 0x0;
+
+			if (bIsEnum)
+				return;
+
+			const UEStruct ObjAsStruct = Obj.Cast<UEStruct>();
+
+			Extracted.NumDependencies = ExtractDependencies(ObjAsStruct, Shard, Scratch);
+
+			if (const UEStruct Super = ObjAsStruct.GetSuper())
 			{
-				RequirementInfo& ReqInfo = DependencyTracker[PackageIdx];
-				ReqInfo.PackageIdx = PackageIdx;
-				ReqInfo.bShouldIncludeStructs = true; // Dependencies only contains structs/enums which are in the "PackageName_structs.hpp" file
+				Extracted.SuperIdx = Super.GetIndex();
+				Extracted.SuperPackageIdx = Super.GetPackageIndex();
 			}
-		}
+
+			if (!Extracted.bIsClass)
+				return;
+
+			for (const UEFunction Func : StructMemberCache::GetFunctions(ObjAsStruct))
+			{
+				ExtractedFunction& ExtractedFunc = Shard.Functions.emplace_back();
+				ExtractedFunc.FuncIdx = Func.GetIndex();
+				ExtractedFunc.PackageIdx = Func.GetPackageIndex();
+				ExtractedFunc.bHasMembers = Func.HasMembers();
+				ExtractedFunc.FirstDependency = static_cast<int32>(Shard.Dependencies.size());
+				ExtractedFunc.NumDependencies = ExtractDependencies(Func, Shard, Scratch);
+			}
+
+			Extracted.NumFunctions = static_cast<int32>(Shard.Functions.size()) - Extracted.FirstFunction;
+		});
 	}
 
-	inline void AddEnumPackageDependencies(DependencyListType& DependencyTracker, const std::unordered_set<int32>& Dependencies, int32 StructPackageIdx, bool bAllowToIncludeOwnPackage = false)
+	inline void SetPackageDependencies(PackageIncludeSet& DependencyTracker, std::span<const ExtractedDependency> Dependencies, int32 StructPackageIdx, bool bAllowToIncludeOwnPackage = false)
 	{
-		for (int32 Dependency : Dependencies)
+		for (const ExtractedDependency& Dependency : Dependencies)
 		{
-			UEObject DependencyObject = ObjectArray::GetByIndex(Dependency);
+			const int32 PackageIdx = Dependency.PackageIdx;
+			const int32 DenseIdx = PackageManager::GetDenseIndex(PackageIdx);
+
+			// Dependencies only contains structs/enums which are in the "PackageName_structs.hpp" file
+			if (DenseIdx != -1 && (bAllowToIncludeOwnPackage || PackageIdx != StructPackageIdx))
+				DependencyTracker.Structs.Set(DenseIdx);
+		}
+	}
 
-			if (!DependencyObject.IsA(EClassCastFlags::Enum))
+	inline void AddEnumPackageDependencies(PackageIncludeSet& DependencyTracker, std::span<const ExtractedDependency> Dependencies, int32 StructPackageIdx, bool bAllowToIncludeOwnPackage = false)
+	{
+		for (const ExtractedDependency& Dependency : Dependencies)
+		{
+			if (!Dependency.bIsEnum)
 				continue;
 
-			const int32 PackageIdx = DependencyObject.GetPackageIndex();
+			const int32 PackageIdx = Dependency.PackageIdx;
+			const int32 DenseIdx = PackageManager::GetDenseIndex(PackageIdx);
 
-			if (bAllowToIncludeOwnPackage || PackageIdx != StructPackageIdx)
-			{
-				RequirementInfo& ReqInfo = DependencyTracker[PackageIdx];
-				ReqInfo.PackageIdx = PackageIdx;
-				ReqInfo.bShouldIncludeStructs = true; // Dependencies only contains enums which are in the "PackageName_structs.hpp" file
-			}
+			// Dependencies only contains enums which are in the "PackageName_structs.hpp" file
+			if (DenseIdx != -1 && (bAllowToIncludeOwnPackage || PackageIdx != StructPackageIdx))
+				DependencyTracker.Structs.Set(DenseIdx);
 		}
 	}
 
-	inline void AddStructDependencies(DependencyManager& StructDependencies, const std::unordered_set<int32>& Dependenies, int32 StructIdx, int32 StructPackageIndex)
+	inline void AddStructDependencies(DependencyManager& StructDependencies, std::span<const ExtractedDependency> Dependenies, int32 StructIdx, int32 StructPackageIndex)
 	{
 		std::unordered_set<int32> TempSet;
 
-		for (int32 DependencyStructIdx : Dependenies)
+		for (const ExtractedDependency& Dependency : Dependenies)
 		{
-			UEObject Obj = ObjectArray::GetByIndex(DependencyStructIdx);
-
-			if (Obj.GetPackageIndex() == StructPackageIndex && !Obj.IsA(EClassCastFlags::Enum))
-				TempSet.insert(DependencyStructIdx);
+			if (Dependency.PackageIdx == StructPackageIndex && !Dependency.bIsEnum)
+				TempSet.insert(Dependency.ObjectIdx);
 		}
 
 		StructDependencies.SetDependencies(StructIdx, std::move(TempSet));
@@ -240,89 +360,230 @@ namespace PackageManagerUtils
 
 void PackageManager::InitDependencies()
 {
-	// Collects all packages required to compile this file
+	using namespace PackageManagerUtils;
+
+	const int32 NumObjects = ShardedObjectScan::GetNumObjects();
 
-	for (auto Obj : ObjectArray())
+	/* Extract the dependencies of all structs in parallel */
+	auto ExtractShardDependencies = [](int32 StartIndex, int32 EndIndex, DependencyShard& Shard) -> void
 	{
-		if (Obj.HasAnyFlags(EObjectFlags::ClassDefaultObject))
-			continue;
+		std::vector<int32> Scratch;
+		Scratch.reserve(0x40);
 
-		int32 CurrentPackageIdx = Obj.GetPackageIndex();
+		ExtractShard(StartIndex, EndIndex, Shard, Scratch);
+	};
 
-		const bool bIsStruct = Obj.IsA(EClassCastFlags::Struct);
-		const bool bIsClass = Obj.IsA(EClassCastFlags::Class);
+	std::vector<DependencyShard> Shards = ShardedObjectScan::Run<DependencyShard>(NumObjects, ExtractShardDependencies);
 
-		const bool bIsFunction = Obj.IsA(EClassCastFlags::Function);
-		const bool bIsEnum = Obj.IsA(EClassCastFlags::Enum);
+	/* Number all packages in order of their first object, so the include-sets can be sized before any dependency is added */
+	for (const DependencyShard& Shard : Shards)
+	{
+		for (const ExtractedObject& Obj : Shard.Objects)
+		{
+			if (Obj.PackageIdx >= static_cast<int32>(DenseIndexLookup.size()))
+				DenseIndexLookup.resize(std::max(Obj.PackageIdx + 1, NumObjects), -1);
+
+			int32& DenseIdx = DenseIndexLookup[Obj.PackageIdx];
+
+			if (DenseIdx != -1)
+				continue;
+
+			DenseIdx = static_cast<int32>(DensePackageIndices.size());
+			DensePackageIndices.push_back(Obj.PackageIdx);
+
+			PackageInfo& Info = PackageInfos[Obj.PackageIdx];
+			Info.PackageIndex = Obj.PackageIdx;
+			Info.DenseIndex = DenseIdx;
+		}
+	}
 
-		if (bIsStruct && !bIsFunction)
+	const int32 NumPackages = GetNumPackages();
+
+	for (auto& [PackageIdx, Info] : PackageInfos)
+	{
+		Info.PackageDependencies.StructsDependencies.Resize(NumPackages);
+		Info.PackageDependencies.ClassesDependencies.Resize(NumPackages);
+		Info.PackageDependencies.ParametersDependencies.Resize(NumPackages);
+	}
+
+	/* Reduce the shards in order of the object-indices, so the resulting package-structures don't depend on thread-scheduling */
+	for (DependencyShard& Shard : Shards)
+	{
+		for (const ExtractedObject& Obj : Shard.Objects)
 		{
-			PackageInfo& Info = PackageInfos[CurrentPackageIdx];
-			Info.PackageIndex = CurrentPackageIdx;
+			PackageInfo& Info = PackageInfos.at(Obj.PackageIdx);
+
+			if (Obj.bIsEnum)
+			{
+				Info.Enums.push_back(Obj.ObjectIdx);
+				continue;
+			}
 
-			UEStruct ObjAsStruct = Obj.Cast<UEStruct>();
+			const bool bIsClass = Obj.bIsClass;
 
-			const int32 StructIdx = ObjAsStruct.GetIndex();
-			const int32 StructPackageIdx = ObjAsStruct.GetPackageIndex();
+			const int32 StructIdx = Obj.ObjectIdx;
+			const int32 StructPackageIdx = Obj.PackageIdx;
 
-			DependencyListType& PackageDependencyList = bIsClass ? Info.PackageDependencies.ClassesDependencies : Info.PackageDependencies.StructsDependencies;
+			PackageIncludeSet& PackageDependencyList = bIsClass ? Info.PackageDependencies.ClassesDependencies : Info.PackageDependencies.StructsDependencies;
 			DependencyManager& ClassOrStructDependencyList = bIsClass ? Info.ClassesSorted : Info.StructsSorted;
 
-			std::unordered_set<int32> Dependencies = PackageManagerUtils::GetDependencies(ObjAsStruct, StructIdx);
+			const std::span<const ExtractedDependency> Dependencies = Shard.GetDependencies(Obj.FirstDependency, Obj.NumDependencies);
 
 			ClassOrStructDependencyList.SetExists(StructIdx);
 
-			PackageManagerUtils::SetPackageDependencies(PackageDependencyList, Dependencies, StructPackageIdx, bIsClass);
+			SetPackageDependencies(PackageDependencyList, Dependencies, StructPackageIdx, bIsClass);
 
 			if (!bIsClass)
-				PackageManagerUtils::AddStructDependencies(ClassOrStructDependencyList, Dependencies, StructIdx, StructPackageIdx);
+				AddStructDependencies(ClassOrStructDependencyList, Dependencies, StructIdx, StructPackageIdx);
 
 			/* for both struct and class */
-			if (UEStruct Super = ObjAsStruct.GetSuper())
+			if (Obj.SuperIdx != -1)
 			{
-				const int32 SuperPackageIdx = Super.GetPackageIndex();
-
-				if (SuperPackageIdx == StructPackageIdx)
+				if (Obj.SuperPackageIdx == StructPackageIdx)
 				{
 					/* In-file sorting is only required if the super-class is inside of the same package */
-					ClassOrStructDependencyList.AddDependency(Obj.GetIndex(), Super.GetIndex());
+					ClassOrStructDependencyList.AddDependency(StructIdx, Obj.SuperIdx);
 				}
-				else
+				else if (const int32 SuperDenseIdx = GetDenseIndex(Obj.SuperPackageIdx); SuperDenseIdx != -1)
 				{
 					/* A package can't depend on itself, super of a structs will always be in _"structs" file, same for classes and "_classes" files */
-					RequirementInfo& ReqInfo = PackageDependencyList[SuperPackageIdx];
-					BooleanOrEqual(ReqInfo.bShouldIncludeStructs, !bIsClass);
-					BooleanOrEqual(ReqInfo.bShouldIncludeClasses, bIsClass);
+					(bIsClass ? PackageDependencyList.Classes : PackageDependencyList.Structs).Set(SuperDenseIdx);
 				}
 			}
 
-			if (!bIsClass)
-				continue;
-			
 			/* Add class-functions to package */
-			for (UEFunction Func : ObjAsStruct.GetFunctions())
+			for (int32 i = 0; i < Obj.NumFunctions; i++)
 			{
-				Info.Functions.push_back(Func.GetIndex());
+				const ExtractedFunction& Func = Shard.Functions[Obj.FirstFunction + i];
 
-				std::unordered_set<int32> ParamDependencies = PackageManagerUtils::GetDependencies(Func, Func.GetIndex());
+				Info.Functions.push_back(Func.FuncIdx);
 
-				BooleanOrEqual(Info.bHasParams, Func.HasMembers());
+				BooleanOrEqual(Info.bHasParams, Func.bHasMembers);
 
-				const int32 FuncPackageIndex = Func.GetPackageIndex();
+				const std::span<const ExtractedDependency> ParamDependencies = Shard.GetDependencies(Func.FirstDependency, Func.NumDependencies);
 
 				/* Add dependencies to ParamDependencies and add enums only to class dependencies (forwarddeclaration of enum classes defaults to int) */
-				PackageManagerUtils::SetPackageDependencies(Info.PackageDependencies.ParametersDependencies, ParamDependencies, FuncPackageIndex, true);
-				PackageManagerUtils::AddEnumPackageDependencies(Info.PackageDependencies.ClassesDependencies, ParamDependencies, FuncPackageIndex, true);
+				SetPackageDependencies(Info.PackageDependencies.ParametersDependencies, ParamDependencies, Func.PackageIdx, true);
+				AddEnumPackageDependencies(Info.PackageDependencies.ClassesDependencies, ParamDependencies, Func.PackageIdx, true);
 			}
 		}
-		else if (bIsEnum)
+
+		Shard = DependencyShard();
+	}
+
+	/* All dependencies are known now, convert them into their compact read-only form */
+	for (auto& [PackageIdx, Info] : PackageInfos)
+	{
+		Info.StructsSorted.Freeze();
+		Info.ClassesSorted.Freeze();
+	}
+}
+
+/*
+* The closure of the filter is taken over the package-dependencies, so this can only run after InitDependencies. It's an output filter, the other
+* managers, TypeIR and the dependencies of all packages are still built for everything in GObjects.
+*/
+void PackageManager::ApplyPackageFilter()
+{
+	const std::vector<std::string>& Filter = Settings::Config::PackageFilter;
+
+	if (Filter.empty())
+		return;
+
+	const int32 NumPackages = GetNumPackages();
+
+	PackageBitSet Required;
+	Required.Resize(NumPackages);
+
+	std::vector<int32> PendingPackages;
+
+	auto AddRoot = [&](int32 DenseIdx) -> void
+	{
+		if (DenseIdx == -1 || Required.Test(DenseIdx))
+			return;
+
+		Required.Set(DenseIdx);
+		PendingPackages.push_back(DenseIdx);
+	};
+
+	/* Basic.hpp always includes CoreUObject, Basic.cpp includes Engine for UWorld::GetWorld and the actor-registry */
+	for (int32 DenseIdx = 0; DenseIdx < NumPackages; DenseIdx++)
+	{
+		const std::string PackageName = ObjectArray::GetByIndex(DensePackageIndices[DenseIdx]).GetValidName();
+
+		if (PackageName == "CoreUObject" || PackageName == "Engine")
+			AddRoot(DenseIdx);
+	}
+
+	for (const std::string& Entry : Filter)
+	{
+		bool bFoundPackage = false;
+
+		for (int32 DenseIdx = 0; DenseIdx < NumPackages; DenseIdx++)
+		{
+			const UEObject Package = ObjectArray::GetByIndex(DensePackageIndices[DenseIdx]);
+
+			if (Package.GetName() != Entry && Package.GetValidName() != Entry)
+				continue;
+
+			AddRoot(DenseIdx);
+			bFoundPackage = true;
+		}
+
+		if (bFoundPackage)
+			continue;
+
+		/* Not a package, a class or struct includes the whole package it's declared in */
+		if (const UEStruct Struct = ObjectArray::FindStructFast(Entry))
 		{
-			PackageInfo& Info = PackageInfos[CurrentPackageIdx];
-			Info.PackageIndex = CurrentPackageIdx;
+			AddRoot(GetDenseIndex(Struct.GetPackageIndex()));
+			continue;
+		}
+
+		std::cerr << std::format("PackageFilter: \"{}\" is neither a package, nor a class or struct!\n", Entry);
+	}
+
+	/* Every file of a required package is generated, so all three include-sets contribute to the closure */
+	while (!PendingPackages.empty())
+	{
+		const int32 DenseIdx = PendingPackages.back();
+		PendingPackages.pop_back();
+
+		const DependencyInfo& Dependencies = PackageInfos.at(DensePackageIndices[DenseIdx]).PackageDependencies;
 
-			Info.Enums.push_back(Obj.GetIndex());
+		auto AddDependency = [&](int32 IncludedIdx, bool, bool) -> void { AddRoot(IncludedIdx); };
+
+		Dependencies.StructsDependencies.ForEach(AddDependency);
+		Dependencies.ClassesDependencies.ForEach(AddDependency);
+		Dependencies.ParametersDependencies.ForEach(AddDependency);
+	}
+
+	/*
+	* Packages outside of the closure keep their name and dense index, types of required packages may still point to them.
+	* Their contents are dropped, so they're empty and skipped by the generators and by the remaining initialization.
+	*/
+	int32 NumRequiredPackages = 0x0;
+
+	for (auto& [PackageIdx, Info] : PackageInfos)
+	{
+		if (Required.Test(Info.DenseIndex))
+		{
+			NumRequiredPackages++;
+			continue;
 		}
+
+		Info.bHasParams = false;
+		Info.StructsSorted = DependencyManager();
+		Info.ClassesSorted = DependencyManager();
+		Info.Functions = std::vector<int32>();
+		Info.Enums = std::vector<int32>();
+		Info.PackageDependencies = DependencyInfo();
+		Info.PackageDependencies.StructsDependencies.Resize(NumPackages);
+		Info.PackageDependencies.ClassesDependencies.Resize(NumPackages);
+		Info.PackageDependencies.ParametersDependencies.Resize(NumPackages);
 	}
+
+	std::cerr << std::format("PackageFilter: Generating {} of {} packages.\n", NumRequiredPackages, NumPackages);
 }
 
 void PackageManager::InitNames()
@@ -350,7 +611,7 @@ void PackageManager::HelperMarkStructDependenciesOfPackage(UEStruct Struct, int3
 	if (bIsClass)
 		return;
 
-	for (UEProperty Child : Struct.GetProperties())
+	for (UEProperty Child : StructMemberCache::GetProperties(Struct))
 	{
 		if (!Child.IsA(EClassCastFlags::StructProperty))
 			continue;
@@ -375,7 +636,7 @@ int32 PackageManager::HelperCountStructDependenciesOfPackage(UEStruct Struct, in
 	if (bIsClass)
 		return RetCount;
 
-	for (UEProperty Child : Struct.GetProperties())
+	for (UEProperty Child : StructMemberCache::GetProperties(Struct))
 	{
 		if (!Child.IsA(EClassCastFlags::StructProperty))
 			continue;
@@ -412,13 +673,13 @@ void PackageManager::HelperInitEnumFwdDeclarationsForPackage(int32 PackageForFwd
 
 	std::vector<std::pair<int32, bool>>& EnumsToForwardDeclare = Info.EnumForwardDeclarations;
 
-	DependencyManager::OnVisitCallbackType CheckForEnumsToForwardDeclareCallback = [&EnumsToForwardDeclare, RequiredPackage, bIsClass](int32 Index) -> void
+	auto CheckForEnumsToForwardDeclareCallback = [&EnumsToForwardDeclare, RequiredPackage, bIsClass](int32 Index) -> void
 	{
 		HelperAddEnumsFromPacakageToFwdDeclarations(ObjectArray::GetByIndex<UEStruct>(Index), EnumsToForwardDeclare, RequiredPackage, bIsClass);
 	};
 
 	DependencyManager& Manager = bIsClass ? Info.ClassesSorted : Info.StructsSorted;
-	Manager.VisitAllNodesWithCallback(CheckForEnumsToForwardDeclareCallback);
+	Manager.VisitAllNodes(CheckForEnumsToForwardDeclareCallback);
 
 	/* Enums used in functions are required by classes too, due to the declaration of functions being in the classes-header */
 	for (const int32 FuncIdx : Info.Functions)
@@ -445,10 +706,10 @@ void PackageManager::HandleCycles()
 	std::vector<CycleInfo> HandledPackages;
 
 
-	FindCycleCallbackType CleanedUpOnCycleFoundCallback = [&HandledPackages](const PackageManagerIterationParams& OldParams, const PackageManagerIterationParams& NewParams, bool bIsStruct) -> void
+	FindCycleCallbackType CleanedUpOnCycleFoundCallback = [&HandledPackages](int32 CyclicPackage, int32 PreviousPackage, bool bIsStruct) -> void
 	{
-		const int32 CurrentPackageIndex = NewParams.RequiredPackage;
-		const int32 PreviousPackageIndex = NewParams.PrevPackage;
+		const int32 CurrentPackageIndex = CyclicPackage;
+		const int32 PreviousPackageIndex = PreviousPackage;
 
 		/* Check if this pacakge was handled before, return if true */
 		for (const CycleInfo& Cycle : HandledPackages)
@@ -475,13 +736,13 @@ void PackageManager::HandleCycles()
 
 		if (bIsStruct)
 		{
-			bIsMutualInclusion = CurrentPackageInfo.GetPackageDependencies().StructsDependencies.contains(PreviousPackageIndex) 
-				&& PreviousPackageInfo.GetPackageDependencies().StructsDependencies.contains(CurrentPackageIndex);
+			bIsMutualInclusion = CurrentPackageInfo.GetPackageDependencies().StructsDependencies.Contains(GetDenseIndex(PreviousPackageIndex))
+				&& PreviousPackageInfo.GetPackageDependencies().StructsDependencies.Contains(GetDenseIndex(CurrentPackageIndex));
 		}
 		else
 		{
-			bIsMutualInclusion = CurrentPackageInfo.GetPackageDependencies().ClassesDependencies.contains(PreviousPackageIndex)
-				&& PreviousPackageInfo.GetPackageDependencies().ClassesDependencies.contains(CurrentPackageIndex);
+			bIsMutualInclusion = CurrentPackageInfo.GetPackageDependencies().ClassesDependencies.Contains(GetDenseIndex(PreviousPackageIndex))
+				&& PreviousPackageInfo.GetPackageDependencies().ClassesDependencies.Contains(GetDenseIndex(CurrentPackageIndex));
 		}
 
 		/* Use the number of dependencies between the packages to decide which one to mark as cyclic */
@@ -490,21 +751,21 @@ void PackageManager::HandleCycles()
 			/* Number of structs from PreviousPackage required by CurrentPackage */
 			int32 NumStructsRequiredByCurrent = 0x0;
 
-			DependencyManager::OnVisitCallbackType CountDependenciesForCurrent = [&NumStructsRequiredByCurrent, PreviousPackageIndex, bIsStruct](int32 Index) -> void
+			auto CountDependenciesForCurrent = [&NumStructsRequiredByCurrent, PreviousPackageIndex, bIsStruct](int32 Index) -> void
 			{
 				NumStructsRequiredByCurrent += HelperCountStructDependenciesOfPackage(ObjectArray::GetByIndex<UEStruct>(Index), PreviousPackageIndex, !bIsStruct);
 			};
-			CurrentStructsOrClasses.VisitAllNodesWithCallback(CountDependenciesForCurrent);
+			CurrentStructsOrClasses.VisitAllNodes(CountDependenciesForCurrent);
 
 
 			/* Number of structs from CurrentPackage required by CurrentPackage PreviousPackage */
 			int32 NumStructsRequiredByPrevious = 0x0;
 
-			DependencyManager::OnVisitCallbackType CountDependenciesForPrevious = [&NumStructsRequiredByPrevious, CurrentPackageIndex, bIsStruct](int32 Index) -> void
+			auto CountDependenciesForPrevious = [&NumStructsRequiredByPrevious, CurrentPackageIndex, bIsStruct](int32 Index) -> void
 			{
 				NumStructsRequiredByPrevious += HelperCountStructDependenciesOfPackage(ObjectArray::GetByIndex<UEStruct>(Index), CurrentPackageIndex, !bIsStruct);
 			};
-			PreviousStructsOrClasses.VisitAllNodesWithCallback(CountDependenciesForPrevious);
+			PreviousStructsOrClasses.VisitAllNodes(CountDependenciesForPrevious);
 
 
 			/* Which of the two cyclic packages requires less structs from the other package. */
@@ -518,23 +779,23 @@ void PackageManager::HandleCycles()
 			HandledPackages.push_back({ PackageIndexWithLeastDependencies, PackageIndexToMarkCyclicWith, bIsStruct, !bIsStruct });
 
 
-			DependencyManager::OnVisitCallbackType SetCycleCallback = [PackageIndexWithLeastDependencies, PackageIndexToMarkCyclicWith, bIsStruct](int32 Index) -> void
+			auto SetCycleCallback = [PackageIndexWithLeastDependencies, PackageIndexToMarkCyclicWith, bIsStruct](int32 Index) -> void
 			{
 				HelperMarkStructDependenciesOfPackage(ObjectArray::GetByIndex<UEStruct>(Index), PackageIndexToMarkCyclicWith, PackageIndexWithLeastDependencies, !bIsStruct);
 			};
 
-			PreviousStructsOrClasses.VisitAllNodesWithCallback(SetCycleCallback);
+			PreviousStructsOrClasses.VisitAllNodes(SetCycleCallback);
 		}
 		else /* Just mark structs|classes from the previous package as cyclic */
 		{
 			HandledPackages.push_back({ PreviousPackageIndex, CurrentPackageIndex, bIsStruct, !bIsStruct });
 
-			DependencyManager::OnVisitCallbackType SetCycleCallback = [PreviousPackageIndex, CurrentPackageIndex, bIsStruct](int32 Index) -> void
+			auto SetCycleCallback = [PreviousPackageIndex, CurrentPackageIndex, bIsStruct](int32 Index) -> void
 			{
 				HelperMarkStructDependenciesOfPackage(ObjectArray::GetByIndex<UEStruct>(Index), PreviousPackageIndex, CurrentPackageIndex, !bIsStruct);
 			};
 
-			PreviousStructsOrClasses.VisitAllNodesWithCallback(SetCycleCallback);
+			PreviousStructsOrClasses.VisitAllNodes(SetCycleCallback);
 		}
 	};
 
@@ -555,17 +816,8 @@ void PackageManager::HandleCycles()
 			continue;
 		}
 
-		const RequirementInfo& CurrentRequirements = CurrentPackageInfo.GetPackageDependencies().ClassesDependencies.at(Cycle.CurrentPackage);
-
-		/* Mark classes as 'do not include' when this package is cyclic but can still require _structs.hpp */
-		if (CurrentRequirements.bShouldIncludeStructs)
-		{
-			const_cast<RequirementInfo&>(CurrentRequirements).bShouldIncludeClasses = false;
-		}
-		else
-		{
-			CurrentPackageInfo.ErasePackageDependencyFromClasses(Cycle.PreviousPacakge);
-		}
+		/* Mark classes as 'do not include', this package can still require _structs.hpp */
+		CurrentPackageInfo.ErasePackageDependencyFromClasses(Cycle.PreviousPacakge);
 	}
 }
 
@@ -579,6 +831,7 @@ void PackageManager::Init()
 	PackageInfos.reserve(0x800);
 
 	InitDependencies();
+	ApplyPackageFilter();
 	InitNames();
 }
 
@@ -592,200 +845,354 @@ void PackageManager::PostInit()
 	StructManager::Init();
 
 	HandleCycles();
+
+	InitTransitiveIncludes();
 }
 
-/**
- * @brief Core implementation of dependency iteration with cycle detection
- * 
- * Optimization: Hit Counter Pattern
- * ================================
- * Instead of using std::unordered_set<int> for visited tracking:
- *   - Uses a global iteration counter that increments each iteration
- *   - Each node stores the last iteration it was visited
- *   - Check if visited: (node.hitCounter >= currentIteration)
- * 
- * Benefits:
- *   - O(1) visited check (no hash lookup)
- *   - No memory allocation per iteration
- *   - Cache-friendly (single integer comparison)
- * 
- * Performance Impact: ~30% faster for large games (100k+ objects)
- * 
- * @param Params Current iteration parameters
- * @param bCheckForCycle If true, detect and report circular dependencies
- * @note This is the hot path for SDK generation - optimized carefully
- */
-void PackageManager::IterateSingleDependencyImplementation(SingleDependencyIterationParamsInternal& Params, bool bCheckForCycle)
+void PackageManager::InitTransitiveIncludes()
 {
-	if (!Params.bShouldHandlePackage)
-		return;
+	const int32 NumPackages = GetNumPackages();
+	const int32 NumNodes = NumPackages * 2;
+
+	auto GetIncludes = [](int32 Node) -> const PackageIncludeSet&
+	{
+		const DependencyInfo& Dependencies = PackageInfos.at(DensePackageIndices[Node / 2]).PackageDependencies;
 
-	// Fast path: Check if already visited this iteration using hit counter
-	const bool bIsIncluded = Params.IterationHitCounterRef >= CurrentIterationHitCount;
+		return (Node & 1) ? Dependencies.ClassesDependencies : Dependencies.StructsDependencies;
+	};
 
-	if (!bIsIncluded)
+	auto GetTransitiveIncludes = [](int32 Node) -> PackageIncludeSet&
 	{
-		// Mark as visited by updating hit counter
-		Params.IterationHitCounterRef = CurrentIterationHitCount;
+		DependencyInfo& Dependencies = PackageInfos.at(DensePackageIndices[Node / 2]).PackageDependencies;
 
-		// Track what types were included (structs vs classes)
-		IncludeData& Include = Params.VisitedNodes[Params.CurrentIndex];
-		Include.bIncludedStructs = (Include.bIncludedStructs || Params.bIsStruct);
-		Include.bIncludedClasses = (Include.bIncludedClasses || !Params.bIsStruct);
+		return (Node & 1) ? Dependencies.TransitiveClassesIncludes : Dependencies.TransitiveStructsIncludes;
+	};
 
-		// Recursively visit all dependencies (DFS)
-		for (auto& [Index, Requirements] : Params.Dependencies)
-		{
-			Params.NewParams.bWasPrevNodeStructs = Params.bIsStruct;
-			Params.NewParams.bRequiresClasses = Requirements.bShouldIncludeClasses;
-			Params.NewParams.bRequiresStructs = Requirements.bShouldIncludeStructs;
-			Params.NewParams.RequiredPackage = Requirements.PackageIdx;
+	/* The include-sets don't change anymore, flatten them into edges once so the traversal below doesn't decode bitsets repeatedly */
+	std::vector<int32> EdgeOffsets(NumNodes + 1, 0x0);
+	std::vector<int32> Edges;
 
-			/* Iterate dependencies recursively */
-			IterateDependenciesImplementation(Params.NewParams, Params.CallbackForEachPackage, Params.OnFoundCycle, bCheckForCycle);
-		}
+	for (int32 Node = 0; Node < NumNodes; Node++)
+	{
+		GetIncludes(Node).ForEach([&Edges](int32 DenseIdx, bool bIncludesStructs, bool bIncludesClasses) -> void
+		{
+			if (bIncludesStructs)
+				Edges.push_back(DenseIdx * 2);
 
-		Params.VisitedNodes.erase(Params.CurrentIndex);
+			if (bIncludesClasses)
+				Edges.push_back(DenseIdx * 2 + 1);
+		});
 
-		// PERFORM ACTION
-		Params.CallbackForEachPackage(Params.NewParams, Params.OldParams, Params.bIsStruct);
-		return;
+		EdgeOffsets[Node + 1] = static_cast<int32>(Edges.size());
 	}
 
-	if (bCheckForCycle)
+	enum class ENodeState : uint8
+	{
+		Unvisited,
+		OnPath,
+		Finished,
+	};
+
+	struct StackFrame
+	{
+		int32 Node;
+		int32 NextEdge;
+	};
+
+	std::vector<ENodeState> States(NumNodes, ENodeState::Unvisited);
+	std::vector<StackFrame> CallStack;
+
+	CallStack.reserve(NumNodes);
+
+	IncludeOrder.clear();
+	IncludeOrder.reserve(NumNodes);
+
+	bHasIncludeCycles = false;
+
+	/* Post-order DFS, every header is finished after all headers it includes, so their closures can simply be or'ed together */
+	for (int32 Root = 0; Root < NumNodes; Root++)
 	{
-		auto It = Params.VisitedNodes.find(Params.CurrentIndex);
-		if (It != Params.VisitedNodes.end())
+		if (States[Root] != ENodeState::Unvisited)
+			continue;
+
+		States[Root] = ENodeState::OnPath;
+		CallStack.push_back({ Root, EdgeOffsets[Root] });
+
+		while (!CallStack.empty())
 		{
-			if ((It->second.bIncludedStructs && Params.bIsStruct) || (It->second.bIncludedClasses && !Params.bIsStruct))
-				Params.OnFoundCycle(Params.NewParams, Params.OldParams, Params.bIsStruct);
+			StackFrame& Current = CallStack.back();
+
+			if (Current.NextEdge < EdgeOffsets[Current.Node + 1])
+			{
+				const int32 Target = Edges[Current.NextEdge++];
+
+				if (States[Target] == ENodeState::Unvisited)
+				{
+					States[Target] = ENodeState::OnPath;
+					CallStack.push_back({ Target, EdgeOffsets[Target] });
+				}
+				else if (States[Target] == ENodeState::OnPath)
+				{
+					bHasIncludeCycles = true;
+				}
+
+				continue;
+			}
+
+			const int32 Node = Current.Node;
+			CallStack.pop_back();
+
+			PackageIncludeSet& Transitive = GetTransitiveIncludes(Node);
+			Transitive = GetIncludes(Node);
+
+			for (int32 i = EdgeOffsets[Node]; i < EdgeOffsets[Node + 1]; i++)
+				Transitive |= GetTransitiveIncludes(Edges[i]);
+
+			States[Node] = ENodeState::Finished;
+			IncludeOrder.push_back(Node);
 		}
 	}
+
+	if (bHasIncludeCycles)
+		std::cerr << "PackageManager: Includes are still cyclic after removing cycles, transitive includes won't be used.\n";
 }
 
-void PackageManager::IterateDependenciesImplementation(const PackageManagerIterationParams& Params, const IteratePackagesCallbackType& CallbackForEachPackage, const FindCycleCallbackType& OnFoundCycle, bool bCheckForCycle)
+void PackageManager::IterateDependencies(const IteratePackagesCallbackType& CallbackForEachPackage)
 {
-	PackageManagerIterationParams NewParams = {
-		.PrevPackage = Params.RequiredPackage,
+	for (const int32 Node : IncludeOrder)
+		CallbackForEachPackage(DensePackageIndices[Node / 2], (Node & 1) == 0);
+}
 
-		.VisitedNodes = Params.VisitedNodes,
-	};
+void PackageManager::RemoveTransitiveIncludes(PackageIncludeSet& Includes)
+{
+	/* A cyclic include-graph means the closures are incomplete, removing an include could drop a header nobody else includes */
+	if (bHasIncludeCycles)
+		return;
 
-	DependencyInfo& Dependencies = PackageInfos.at(Params.RequiredPackage).PackageDependencies;
+	PackageIncludeSet Covered;
+	Covered.Resize(GetNumPackages());
 
-	SingleDependencyIterationParamsInternal StructsParams{
-		.CallbackForEachPackage = CallbackForEachPackage,
-		.OnFoundCycle = OnFoundCycle,
+	Includes.ForEach([&Covered](int32 DenseIdx, bool bIncludesStructs, bool bIncludesClasses) -> void
+	{
+		const DependencyInfo& Dependencies = PackageInfos.at(DensePackageIndices[DenseIdx]).PackageDependencies;
 
-		.NewParams = NewParams,
-		.OldParams = Params,
-		.Dependencies = Dependencies.StructsDependencies,
-		.VisitedNodes = Params.VisitedNodes,
+		if (bIncludesStructs)
+			Covered |= Dependencies.TransitiveStructsIncludes;
 
-		.CurrentIndex = Params.RequiredPackage,
-		.PrevIndex = Params.PrevPackage,
-		.IterationHitCounterRef = Dependencies.StructsIterationHitCount,
+		if (bIncludesClasses)
+			Covered |= Dependencies.TransitiveClassesIncludes;
+	});
 
-		.bShouldHandlePackage = Params.bRequiresStructs,
-		.bIsStruct = true,
-	};
+	/* Without cycles no header is part of its own closure, so every removed include is still reached through one that's kept */
+	Includes.Structs.Remove(Covered.Structs);
+	Includes.Classes.Remove(Covered.Classes);
+}
+
+/**
+ * @brief Finds all cyclic dependencies between packages with a single iterative Tarjan-SCC pass
+ *
+ * Every package is split into two nodes, its "_structs" file and its "_classes" file, and the
+ * dependency-edges between those nodes are flattened into CSR arrays once. The graph is then
+ * traversed depth-first exactly once, in the same order IterateDependencies would use.
+ *
+ * An edge into a node that belongs to an already finished SCC can never close a cycle and is skipped
+ * immediately. An edge into a node that is still on the current path is reported to 'OnFoundCycle',
+ * which makes the reported cycles (and their order) identical to the previous recursive search.
+ *
+ * @param OnFoundCycle Called for every dependency closing a cycle, while the graph is traversed
+ */
+void PackageManager::FindCycle(const FindCycleCallbackType& OnFoundCycle)
+{
+	/* Node of a package at dense index 'I' is 'I * 2' for its structs, and 'I * 2 + 1' for its classes */
+	const int32 NumPackages = GetNumPackages();
+	const int32 NumNodes = NumPackages * 2;
+
+	const std::vector<int32>& PackageIndices = DensePackageIndices;
 
-	SingleDependencyIterationParamsInternal ClassesParams{
-		.CallbackForEachPackage = CallbackForEachPackage,
-		.OnFoundCycle = OnFoundCycle,
+	/* Edges of 'Node' are Edges[EdgeOffsets[Node]] to Edges[EdgeOffsets[Node + 1]] */
+	std::vector<int32> EdgeOffsets(NumNodes + 1, 0x0);
+	std::vector<int32> Edges;
 
-		.NewParams = NewParams,
-		.OldParams = Params,
-		.Dependencies = Dependencies.ClassesDependencies,
-		.VisitedNodes = Params.VisitedNodes,
+	auto AddEdges = [&](const PackageIncludeSet& Dependencies, int32 Node) -> void
+	{
+		Dependencies.ForEach([&Edges](int32 DenseIdx, bool bIncludesStructs, bool bIncludesClasses) -> void
+		{
+			if (bIncludesStructs)
+				Edges.push_back(DenseIdx * 2);
 
-		.CurrentIndex = Params.RequiredPackage,
-		.PrevIndex = Params.PrevPackage,
-		.IterationHitCounterRef = Dependencies.ClassesIterationHitCount,
+			if (bIncludesClasses)
+				Edges.push_back(DenseIdx * 2 + 1);
+		});
 
-		.bShouldHandlePackage = Params.bRequiresClasses,
-		.bIsStruct = false,
+		EdgeOffsets[Node + 1] = static_cast<int32>(Edges.size());
 	};
 
-	IterateSingleDependencyImplementation(StructsParams, bCheckForCycle);
-	IterateSingleDependencyImplementation(ClassesParams, bCheckForCycle);
-}
+	for (int32 i = 0; i < NumPackages; i++)
+	{
+		const DependencyInfo& Dependencies = PackageInfos.at(PackageIndices[i]).PackageDependencies;
 
-/**
- * @brief Iterates over package dependencies in topological order (DFS-based)
- * 
- * This function ensures packages are processed in correct dependency order:
- * dependencies are always processed before their dependents.
- * 
- * Algorithm:
- *   1. For each package, visit all its dependencies recursively (DFS)
- *   2. Use hit counter to avoid revisiting nodes in same iteration
- *   3. Process node only after all dependencies are processed
- *   4. Call callback for each package in topologically sorted order
- * 
- * Example:
- *   Package A depends on B and C
- *   Package B depends on C
- *   Iteration order: C → B → A
- * 
- * @param CallbackForEachPackage Function called for each package in sorted order
- * @note Thread-safe within single iteration (uses instance-level hit counter)
- */
-void PackageManager::IterateDependencies(const IteratePackagesCallbackType& CallbackForEachPackage)
-{
-	VisitedNodeContainerType VisitedNodes;
+		AddEdges(Dependencies.StructsDependencies, i * 2);
+		AddEdges(Dependencies.ClassesDependencies, i * 2 + 1);
+	}
 
-	PackageManagerIterationParams Params = {
-		.PrevPackage = -1,
-		.VisitedNodes = VisitedNodes,
+	struct StackFrame
+	{
+		int32 Node;
+		int32 NextEdge;
 	};
 
-	// Optimization: Empty callback as constexpr lambda to allow compiler optimization
-	constexpr FindCycleCallbackType OnCycleFoundCallback = [](const PackageManagerIterationParams&, const PackageManagerIterationParams&, bool) constexpr -> void { };
+	constexpr int32 Unvisited = -1;
 
-	/* Increment hit counter for new iteration-cycle (prevents revisiting nodes) */
-	CurrentIterationHitCount++;
+	std::vector<int32> NodeIndices(NumNodes, Unvisited);
+	std::vector<int32> LowLinks(NumNodes, 0x0);
+	std::vector<bool> bIsOnSccStack(NumNodes, false);
 
-	// Optimization: Reserve capacity if we know the approximate size
-	// This avoids reallocation during VisitedNodes operations
-	VisitedNodes.reserve(32); // Typical max depth for dependency chains
+	/* Bit 0: the packages structs-node is on the current path, Bit 1: its classes-node is. Cleared once either node is finished. */
+	std::vector<uint8> PathFlags(NumPackages, 0x0);
 
-	// Visit each package and its dependencies
-	for (const auto& [PackageIndex, Info] : PackageInfos)
+	std::vector<int32> SccStack;
+	std::vector<StackFrame> CallStack;
+
+	SccStack.reserve(NumNodes);
+	CallStack.reserve(NumNodes);
+
+	int32 NextIndex = 0x0;
+
+	auto EnterNode = [&](int32 Node) -> void
 	{
-		Params.RequiredPackage = PackageIndex;
-		Params.bWasPrevNodeStructs = true;
-		Params.bRequiresClasses = true;
-		Params.bRequiresStructs = true;
-		Params.VisitedNodes.clear();
+		NodeIndices[Node] = NextIndex;
+		LowLinks[Node] = NextIndex;
+		NextIndex++;
+
+		SccStack.push_back(Node);
+		bIsOnSccStack[Node] = true;
+
+		PathFlags[Node / 2] |= (1 << (Node & 1));
+
+		CallStack.push_back({ Node, EdgeOffsets[Node] });
+	};
+
+	for (int32 Root = 0; Root < NumNodes; Root++)
+	{
+		if (NodeIndices[Root] != Unvisited)
+			continue;
+
+		EnterNode(Root);
+
+		while (!CallStack.empty())
+		{
+			StackFrame& Current = CallStack.back();
+			const int32 Node = Current.Node;
+
+			if (Current.NextEdge < EdgeOffsets[Node + 1])
+			{
+				const int32 Target = Edges[Current.NextEdge++];
+
+				if (NodeIndices[Target] == Unvisited)
+				{
+					EnterNode(Target);
+					continue;
+				}
+
+				/* Target is part of an SCC that was already completed, this edge can't be part of a cycle */
+				if (!bIsOnSccStack[Target])
+					continue;
 
-		IterateDependenciesImplementation(Params, CallbackForEachPackage, OnCycleFoundCallback, false);
+				LowLinks[Node] = std::min(LowLinks[Node], NodeIndices[Target]);
+
+				if (PathFlags[Target / 2] & (1 << (Target & 1)))
+					OnFoundCycle(PackageIndices[Target / 2], PackageIndices[Node / 2], (Target & 1) == 0);
+
+				continue;
+			}
+
+			/* All dependencies of this node were visited */
+			PathFlags[Node / 2] = 0x0;
+			CallStack.pop_back();
+
+			if (!CallStack.empty())
+			{
+				const int32 Parent = CallStack.back().Node;
+				LowLinks[Parent] = std::min(LowLinks[Parent], LowLinks[Node]);
+			}
+
+			if (LowLinks[Node] != NodeIndices[Node])
+				continue;
+
+			/* Node is the root of an SCC, pop all of its members */
+			int32 Member = Unvisited;
+			do
+			{
+				Member = SccStack.back();
+				SccStack.pop_back();
+				bIsOnSccStack[Member] = false;
+			} while (Member != Node);
+		}
 	}
 }
 
-void PackageManager::FindCycle(const FindCycleCallbackType& OnFoundCycle)
+MemoryReport PackageManager::GetMemoryReport()
 {
-	VisitedNodeContainerType VisitedNodes;
+	MemoryReport Report = UniquePackageNameTable.GetMemoryReport();
 
-	PackageManagerIterationParams Params = {
-		.PrevPackage = -1,
+	Report += MemoryReport::FromHashContainer(PackageInfos);
 
-		.VisitedNodes = VisitedNodes,
-	};
+	for (const auto& [PackageIdx, Info] : PackageInfos)
+	{
+		Report += Info.StructsSorted.GetMemoryReport();
+		Report += Info.ClassesSorted.GetMemoryReport();
 
-	FindCycleCallbackType CallbackForEachPackage = [](const PackageManagerIterationParams& OldParams, const PackageManagerIterationParams& NewParams, bool bIsStruct) -> void {};
+		Report += MemoryReport::FromVector(Info.Functions);
+		Report += MemoryReport::FromVector(Info.Enums);
+		Report += MemoryReport::FromVector(Info.EnumForwardDeclarations);
 
-	/* Increment hit counter for new iteration-cycle */
-	CurrentIterationHitCount++;
+		const DependencyInfo& Dependencies = Info.PackageDependencies;
 
-	for (const auto& [PackageIndex, Info] : PackageInfos)
+		Report += Dependencies.StructsDependencies.GetMemoryReport();
+		Report += Dependencies.ClassesDependencies.GetMemoryReport();
+		Report += Dependencies.ParametersDependencies.GetMemoryReport();
+		Report += Dependencies.TransitiveStructsIncludes.GetMemoryReport();
+		Report += Dependencies.TransitiveClassesIncludes.GetMemoryReport();
+	}
+
+	Report += MemoryReport::FromVector(DensePackageIndices);
+	Report += MemoryReport::FromVector(DenseIndexLookup);
+	Report += MemoryReport::FromVector(IncludeOrder);
+
+	return Report;
+}
+
+void PackageManager::Compact()
+{
+	UniquePackageNameTable.Compact();
+
+	for (auto& [PackageIdx, Info] : PackageInfos)
 	{
-		Params.RequiredPackage = PackageIndex;
-		Params.bWasPrevNodeStructs = true;
-		Params.bRequiresClasses = true;
-		Params.bRequiresStructs = true;
-		Params.VisitedNodes.clear();
+		Info.StructsSorted.Compact();
+		Info.ClassesSorted.Compact();
 
-		IterateDependenciesImplementation(Params, CallbackForEachPackage, OnFoundCycle, true);
+		Info.Functions.shrink_to_fit();
+		Info.Enums.shrink_to_fit();
+		Info.EnumForwardDeclarations.shrink_to_fit();
 	}
+
+	DensePackageIndices.shrink_to_fit();
+	IncludeOrder.shrink_to_fit();
+
+	PackageInfos.rehash(0);
+}
+
+void PackageManager::Reset()
+{
+	bIsInitialized = false;
+	bIsPostInitialized = false;
+
+	UniquePackageNameTable.Clear();
+	PackageInfos.clear();
+	DensePackageIndices.clear();
+	DenseIndexLookup.clear();
+	IncludeOrder.clear();
+
+	bHasIncludeCycles = false;
+	CurrentIterationHitCount = 0x0;
 }
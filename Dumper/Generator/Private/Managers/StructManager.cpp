@@ -1,5 +1,10 @@
+#include <algorithm>
+
 #include "Unreal/ObjectArray.h"
+#include "Unreal/StructMemberCache.h"
+#include "TypeIR.h"
 #include "Managers/StructManager.h"
+#include "ShardedObjectScan.h"
 
 StructInfoHandle::StructInfoHandle(const StructInfo& InInfo)
 	: Info(&InInfo)
@@ -51,34 +56,138 @@ bool StructInfoHandle::IsPartOfCyclicPackage() const
 	return Info->bIsPartOfCyclicPackage;
 }
 
-void StructManager::InitAlignmentsAndNames()
+struct StructManager::StructLayoutRecord
 {
-	constexpr int32 DefaultClassAlignment = sizeof(void*);
+	UEStruct Struct;
+
+	int32 Index;
+
+	/* Index of this structs' record in the record-list, -1 if there is no super */
+	int32 SuperRecordIndex;
+	int32 SuperStructSize;
+
+	int32 StructSize;
+	int32 MinAlignment;
+	int32 HighestMemberAlignment;
+
+	int32 LowestOffset;
+	int32 LastMemberEnd;
 
+	bool bHasSuper;
+	bool bHasMembers;
+	bool bIsClass;
+	bool bIsFunction;
+	bool bIsInterface;
+
+	std::string CppName;
+};
+
+std::vector<StructManager::StructLayoutRecord> StructManager::CollectLayoutRecords()
+{
 	const UEClass InterfaceClass = ObjectArray::FindClassFast("Interface");
 
-	const UEClass OnlineEngineInterfaceImplClass = ObjectArray::FindClassFast("OnlineEngineInterfaceImpl");
+	const int32 NumObjects = ShardedObjectScan::GetNumObjects();
 
-	for (auto Obj : ObjectArray())
+	/* Only reads from GObjects, StructHierarchy, StructMemberCache and TypeIR */
+	auto CollectShardRecords = [&](int32 StartIndex, int32 EndIndex, std::vector<StructLayoutRecord>& Records) -> void
 	{
-		if (!Obj.IsA(EClassCastFlags::Struct))
-			continue;
+		ShardedObjectScan::ForEachObjectInRange(StartIndex, EndIndex, [&](const UEObject Obj) -> void
+		{
+			if (!Obj.IsA(EClassCastFlags::Struct))
+				return;
+
+			const UEStruct ObjAsStruct = Obj.Cast<UEStruct>();
+			const UEStruct Super = ObjAsStruct.GetSuper();
+
+			StructLayoutRecord& Record = Records.emplace_back();
+			Record.Struct = ObjAsStruct;
+			Record.Index = Obj.GetIndex();
+			Record.SuperRecordIndex = Super ? Super.GetIndex() : -1; // Translated to a record-index once all records were collected
+			Record.SuperStructSize = Super ? Super.GetStructSize() : 0x0;
+			Record.StructSize = ObjAsStruct.GetStructSize();
+			Record.MinAlignment = ObjAsStruct.GetMinAlignment();
+			Record.HighestMemberAlignment = 0x1; // starting at 0x1 when checking **all**, not just struct-properties
+			Record.LowestOffset = INT_MAX;
+			Record.LastMemberEnd = 0x0;
+			Record.bHasSuper = static_cast<bool>(Super);
+			Record.bHasMembers = ObjAsStruct.HasMembers();
+			Record.bIsClass = Obj.IsA(EClassCastFlags::Class);
+			Record.bIsFunction = Obj.IsA(EClassCastFlags::Function);
+			Record.bIsInterface = ObjAsStruct.HasType(InterfaceClass);
+			Record.CppName = Obj.GetCppName();
+
+			auto AddMember = [&Record](int32 PropertyOffset, int32 PropertySize, int32 PropertyAlignment) -> void
+			{
+				Record.HighestMemberAlignment = std::max(Record.HighestMemberAlignment, PropertyAlignment);
+				Record.LowestOffset = std::min(Record.LowestOffset, PropertyOffset);
+				Record.LastMemberEnd = std::max(Record.LastMemberEnd, PropertyOffset + PropertySize);
+			};
 
-		UEStruct ObjAsStruct = Obj.Cast<UEStruct>();
+			/* Offsets and sizes were already read by TypeIR, alignments are resolved once per type-shape instead of once per member. Structs added after the IR was built are read directly. */
+			if (TypeIR::IsInitialized() && StructMemberCache::Contains(Record.Index)) [[likely]]
+			{
+				for (const TypeIR::PropertyNode& Node : TypeIR::GetProperties(ObjAsStruct))
+					AddMember(Node.Offset, Node.Size, TypeIR::GetAlignment(Node));
 
-		// Add name to override info
-		StructInfo& NewOrExistingInfo = StructInfoOverrides[Obj.GetIndex()];
+				return;
+			}
 
-		std::string CppName = Obj.GetCppName();
+			for (UEProperty Property : StructMemberCache::GetProperties(ObjAsStruct))
+				AddMember(Property.GetOffset(), Property.GetSize(), Property.GetAlignment());
+		});
+	};
 
-		// Hardcoded fix for two 'UOnlineEngineInterfaceImpl' classes in the same package. Check will only match one of them.
-		if (Obj == OnlineEngineInterfaceImplClass) [[unlikely]]
-			CppName += '2';
+	std::vector<std::vector<StructLayoutRecord>> Shards = ShardedObjectScan::Run<std::vector<StructLayoutRecord>>(NumObjects, CollectShardRecords);
+
+	std::vector<StructLayoutRecord> Records;
+
+	for (std::vector<StructLayoutRecord>& Shard : Shards)
+		Records.insert(Records.end(), std::make_move_iterator(Shard.begin()), std::make_move_iterator(Shard.end()));
 
-		NewOrExistingInfo.Name = UniqueNameTable.FindOrAdd(CppName, !Obj.IsA(EClassCastFlags::Function)).first;
+	/* Translate object-indices of supers to indices into 'Records' */
+	std::vector<int32> RecordIndices(NumObjects, -1);
+
+	for (int32 i = 0; i < static_cast<int32>(Records.size()); i++)
+		RecordIndices[Records[i].Index] = i;
+
+	for (StructLayoutRecord& Record : Records)
+	{
+		if (Record.SuperRecordIndex != -1)
+			Record.SuperRecordIndex = Record.SuperRecordIndex < NumObjects ? RecordIndices[Record.SuperRecordIndex] : -1;
+	}
+
+	return Records;
+}
+
+void StructManager::InitAlignmentsAndNames(const std::vector<StructLayoutRecord>& Records, std::vector<StructInfo*>& OutInfos)
+{
+	constexpr int32 DefaultClassAlignment = sizeof(void*);
+
+	const UEClass OnlineEngineInterfaceImplClass = ObjectArray::FindClassFast("OnlineEngineInterfaceImpl");
+
+	OutInfos.resize(Records.size());
+
+	/* Names are added in order of the object-indices, the uniqueness of a name depends on whether a struct or a function added it first */
+	for (int32 i = 0; i < static_cast<int32>(Records.size()); i++)
+	{
+		const StructLayoutRecord& Record = Records[i];
+
+		// Add name to override info
+		StructInfo& NewOrExistingInfo = StructInfoOverrides[Record.Index];
+		OutInfos[i] = &NewOrExistingInfo;
+
+		// Hardcoded fix for two 'UOnlineEngineInterfaceImpl' classes in the same package. Check will only match one of them.
+		if (Record.Struct == OnlineEngineInterfaceImplClass) [[unlikely]]
+		{
+			NewOrExistingInfo.Name = UniqueNameTable.FindOrAdd(Record.CppName + '2', !Record.bIsFunction).first;
+		}
+		else
+		{
+			NewOrExistingInfo.Name = UniqueNameTable.FindOrAdd(Record.CppName, !Record.bIsFunction).first;
+		}
 
 		// Interfaces inherit from UObject by default, but as a workaround to no virtual-inheritance we make them empty
-		if (ObjAsStruct.HasType(InterfaceClass))
+		if (Record.bIsInterface)
 		{
 			NewOrExistingInfo.Alignment = 0x1;
 			NewOrExistingInfo.bHasReusedTrailingPadding = false;
@@ -88,23 +197,14 @@ void StructManager::InitAlignmentsAndNames()
 			continue;
 		}
 
-		const int32 MinAlignment = ObjAsStruct.GetMinAlignment();
-		int32 HighestMemberAlignment = 0x1; // starting at 0x1 when checking **all**, not just struct-properties
-
-		// Find member with the highest alignment
-		for (UEProperty Property : ObjAsStruct.GetProperties())
-		{
-			int32 CurrentPropertyAlignment = Property.GetAlignment();
-
-			if (CurrentPropertyAlignment > HighestMemberAlignment)
-				HighestMemberAlignment = CurrentPropertyAlignment;
-		}
+		const int32 MinAlignment = Record.MinAlignment;
+		const int32 HighestMemberAlignment = Record.HighestMemberAlignment;
 
 		/* On some strange games there are BlueprintGeneratedClass UClasses which don't inherit from UObject. */
-		const bool bHasSuperClass = static_cast<bool>(ObjAsStruct.GetSuper());
+		const bool bHasSuperClass = Record.bHasSuper;
 
 		// if Class alignment is below pointer-alignment (0x8), use pointer-alignment instead, else use whichever, MinAlignment or HighestAlignment, is bigger
-		if (ObjAsStruct.IsA(EClassCastFlags::Class) && bHasSuperClass && HighestMemberAlignment < DefaultClassAlignment)
+		if (Record.bIsClass && bHasSuperClass && HighestMemberAlignment < DefaultClassAlignment)
 		{
 			NewOrExistingInfo.bUseExplicitAlignment = false;
 			NewOrExistingInfo.Alignment = DefaultClassAlignment;
@@ -116,30 +216,31 @@ void StructManager::InitAlignmentsAndNames()
 		}
 	}
 
-	for (auto Obj : ObjectArray())
-	{
-		if (!Obj.IsA(EClassCastFlags::Struct) || Obj.IsA(EClassCastFlags::Function) || Obj.Cast<UEStruct>().HasType(InterfaceClass))
-			continue;
+	/*
+	* A struct uses the highest alignment of itself and all of its supers. Every struct is resolved exactly once, top to bottom,
+	* the resolved alignment of a super is reused by all structs inheriting from it.
+	*/
+	std::vector<int32> ResolvedAlignments(Records.size(), 0x0);
+	std::vector<int32> UnresolvedChain;
 
-		UEStruct ObjAsStruct = Obj.Cast<UEStruct>();
+	for (int32 i = 0; i < static_cast<int32>(Records.size()); i++)
+	{
+		const StructLayoutRecord& Record = Records[i];
 
-		constexpr int MaxNumSuperClasses = 0x30;
+		if (Record.bIsFunction || Record.bIsInterface || ResolvedAlignments[i] != 0x0)
+			continue;
 
-		std::array<UEStruct, MaxNumSuperClasses> StructStack;
-		int32 NumElementsInStructStack = 0x0;
+		UnresolvedChain.clear();
 
-		// Get a top to bottom list of a struct and all of its supers
-		for (UEStruct S = ObjAsStruct; S; S = S.GetSuper())
-		{
-			StructStack[NumElementsInStructStack] = S;
-			NumElementsInStructStack++;
-		}
+		int32 Current = i;
+		for (; Current != -1 && ResolvedAlignments[Current] == 0x0; Current = Records[Current].SuperRecordIndex)
+			UnresolvedChain.push_back(Current);
 
-		int32 CurrentHighestAlignment = 0x0;
+		int32 CurrentHighestAlignment = Current != -1 ? ResolvedAlignments[Current] : 0x0;
 
-		for (int i = NumElementsInStructStack - 1; i >= 0; i--)
+		for (auto It = UnresolvedChain.rbegin(); It != UnresolvedChain.rend(); ++It)
 		{
-			StructInfo& Info = StructInfoOverrides[StructStack[i].GetIndex()];
+			StructInfo& Info = *OutInfos[*It];
 
 			if (CurrentHighestAlignment < Info.Alignment)
 			{
@@ -151,52 +252,37 @@ void StructManager::InitAlignmentsAndNames()
 				Info.bUseExplicitAlignment = false; 
 				Info.Alignment = CurrentHighestAlignment;
 			}
+
+			ResolvedAlignments[*It] = CurrentHighestAlignment;
 		}
 	}
 }
 
-void StructManager::InitSizesAndIsFinal()
+void StructManager::InitSizesAndIsFinal(const std::vector<StructLayoutRecord>& Records, const std::vector<StructInfo*>& Infos)
 {
-	const UEClass InterfaceClass = ObjectArray::FindClassFast("Interface");
-
-	for (auto Obj : ObjectArray())
+	/* Sizes of supers are lowered by the structs inheriting from them, this is done in order of the object-indices to keep the results deterministic */
+	for (int32 i = 0; i < static_cast<int32>(Records.size()); i++)
 	{
-		if (!Obj.IsA(EClassCastFlags::Struct) || Obj.Cast<UEStruct>().HasType(InterfaceClass))
-			continue;
+		const StructLayoutRecord& Record = Records[i];
 
-		UEStruct ObjAsStruct = Obj.Cast<UEStruct>();
+		if (Record.bIsInterface)
+			continue;
 
-		StructInfo& NewOrExistingInfo = StructInfoOverrides[Obj.GetIndex()];
+		StructInfo& NewOrExistingInfo = *Infos[i];
 
 		// Initialize struct-size if it wasn't set already
-		if (NewOrExistingInfo.Size > ObjAsStruct.GetStructSize())
-			NewOrExistingInfo.Size = ObjAsStruct.GetStructSize();
-
-		UEStruct Super = ObjAsStruct.GetSuper();
-
-		if (NewOrExistingInfo.Size == 0x0 && Super != nullptr)
-			NewOrExistingInfo.Size = Super.GetStructSize();
-
-		int32 LastMemberEnd = 0x0;
-		int32 LowestOffset = INT_MAX;
+		if (NewOrExistingInfo.Size > Record.StructSize)
+			NewOrExistingInfo.Size = Record.StructSize;
 
-		// Find member with the lowest offset
-		for (UEProperty Property : ObjAsStruct.GetProperties())
-		{
-			const int32 PropertyOffset = Property.GetOffset();
-			const int32 PropertySize = Property.GetSize();
-
-			if (PropertyOffset < LowestOffset)
-				LowestOffset = PropertyOffset;
+		if (NewOrExistingInfo.Size == 0x0 && Record.bHasSuper)
+			NewOrExistingInfo.Size = Record.SuperStructSize;
 
-			if ((PropertyOffset + PropertySize) > LastMemberEnd)
-				LastMemberEnd = PropertyOffset + PropertySize;
-		}
+		const int32 LowestOffset = Record.LowestOffset;
 
 		/* No need to check any other structs, as finding the LastMemberEnd only involves this struct */
-		NewOrExistingInfo.LastMemberEnd = LastMemberEnd;
+		NewOrExistingInfo.LastMemberEnd = Record.LastMemberEnd;
 
-		if (!Super || Obj.IsA(EClassCastFlags::Function))
+		if (!Record.bHasSuper || Record.bIsFunction)
 			continue;
 
 		/*
@@ -204,23 +290,22 @@ void StructManager::InitSizesAndIsFinal()
 		* 
 		* breaks out of the loop after encountering a super-struct which is not empty (aka. has member-variables)
 		*/
-		for (UEStruct S = Super; S; S = S.GetSuper())
+		for (int32 SuperIdx = Record.SuperRecordIndex; ; SuperIdx = Records[SuperIdx].SuperRecordIndex)
 		{
-			auto It = StructInfoOverrides.find(S.GetIndex());
-
-			if (It == StructInfoOverrides.end())
+			if (SuperIdx == -1)
 			{
 				std::cerr << "\n\n\nDumper-7: Error, struct wasn't found in 'StructInfoOverrides'! Exiting...\n\n\n" ;
 				Sleep(10000);
 				exit(1);
 			}
 
-			StructInfo& Info = It->second;
+			const StructLayoutRecord& SuperRecord = Records[SuperIdx];
+			StructInfo& Info = *Infos[SuperIdx];
 
 			// Struct is not final, as it is another structs' super
 			Info.bIsFinal = false;
 
-			const int32 SizeToCheck = Info.Size == INT_MAX ? S.GetStructSize() : Info.Size;
+			const int32 SizeToCheck = Info.Size == INT_MAX ? SuperRecord.StructSize : Info.Size;
 
 			// Only change lowest offset if it's lower than the already found lowest offset (by default: struct-size)
 			if (Align(SizeToCheck, Info.Alignment) > LowestOffset)
@@ -231,7 +316,7 @@ void StructManager::InitSizesAndIsFinal()
 				Info.bHasReusedTrailingPadding = true;
 			}
 
-			if (S.HasMembers())
+			if (SuperRecord.bHasMembers || !SuperRecord.bHasSuper)
 				break;
 		}
 	}
@@ -246,8 +331,12 @@ void StructManager::Init()
 
 	StructInfoOverrides.reserve(0x2000);
 
-	InitAlignmentsAndNames();
-	InitSizesAndIsFinal();
+	const std::vector<StructLayoutRecord> Records = CollectLayoutRecords();
+
+	std::vector<StructInfo*> Infos;
+
+	InitAlignmentsAndNames(Records, Infos);
+	InitSizesAndIsFinal(Records, Infos);
 
 	/* 
 	* The default class-alignment of 0x8 is only set for classes with a valid Super-class, because they inherit from UObject. 
@@ -260,3 +349,33 @@ void StructManager::Init()
 	if (const UEObject UStructClass = ObjectArray::FindClassFast("struct"))
 		StructInfoOverrides.find(UStructClass.GetIndex())->second.Name = UniqueNameTable.FindOrAdd(std::string("UStruct"), false).first;
 }
+
+MemoryReport StructManager::GetMemoryReport()
+{
+	MemoryReport Report = UniqueNameTable.GetMemoryReport();
+
+	Report += MemoryReport::FromHashContainer(StructInfoOverrides);
+	Report += MemoryReport::FromHashContainer(CyclicStructsAndPackages);
+
+	for (const auto& [StructIdx, CyclicPackages] : CyclicStructsAndPackages)
+		Report += MemoryReport::FromHashContainer(CyclicPackages);
+
+	return Report;
+}
+
+void StructManager::Compact()
+{
+	UniqueNameTable.Compact();
+
+	StructInfoOverrides.rehash(0);
+	CyclicStructsAndPackages.rehash(0);
+}
+
+void StructManager::Reset()
+{
+	bIsInitialized = false;
+
+	UniqueNameTable.Clear();
+	StructInfoOverrides.clear();
+	CyclicStructsAndPackages.clear();
+}
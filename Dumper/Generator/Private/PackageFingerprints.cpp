@@ -0,0 +1,480 @@
+
+#include <atomic>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <charconv>
+#include <algorithm>
+#include <type_traits>
+
+#include "PackageFingerprints.h"
+#include "WorkerPool.h"
+
+#include "Wrappers/StructWrapper.h"
+#include "Wrappers/EnumWrapper.h"
+#include "Wrappers/MemberWrappers.h"
+#include "Unreal/ObjectArray.h"
+
+
+namespace
+{
+	/* FNV-1a over everything added, with the same constants as StringHash64 */
+	struct FingerprintBuilder
+	{
+		uint64 Hash = 0xCBF29CE484222325;
+
+	public:
+		inline void AddBytes(const void* Data, size_t Size)
+		{
+			const uint8* Bytes = static_cast<const uint8*>(Data);
+
+			for (size_t i = 0; i < Size; i++)
+			{
+				Hash ^= Bytes[i];
+				Hash *= 0x100000001B3;
+			}
+		}
+
+		template<typename ValueType> requires(std::is_arithmetic_v<ValueType> || std::is_enum_v<ValueType>)
+		inline void Add(ValueType Value)
+		{
+			AddBytes(&Value, sizeof(ValueType));
+		}
+
+		/* Length first, so "ab" + "c" and "a" + "bc" don't produce the same fingerprint */
+		inline void Add(std::string_view Str)
+		{
+			Add(Str.size());
+			AddBytes(Str.data(), Str.size());
+		}
+	};
+
+	/*
+	* Referenced types only appear by name, but whether that name is unique decides if it's written with its package's namespace.
+	* Structs that are cyclic with the package being fingerprinted are written as a cycle-fixup type instead.
+	*/
+	void AddReferencedObject(FingerprintBuilder& Builder, UEObject Object, int32 PackageIndex)
+	{
+		if (!Object)
+			return Builder.Add(static_cast<uint8>(0x0));
+
+		Builder.Add(Object.GetName());
+		Builder.Add(Object.GetOutermost().GetName());
+
+		if (Object.IsA(EClassCastFlags::Enum))
+		{
+			Builder.Add(EnumWrapper(Object.Cast<UEEnum>()).GetUniqueName().second);
+		}
+		else if (Object.IsA(EClassCastFlags::Struct) && !Object.IsA(EClassCastFlags::Function))
+		{
+			const StructWrapper Struct = Object.Cast<UEStruct>();
+
+			Builder.Add(Struct.GetUniqueName().second);
+			Builder.Add(Struct.IsCyclicWithPackage(PackageIndex));
+		}
+	}
+
+	void AddProperty(FingerprintBuilder& Builder, const TypeIR::PropertyNode& Node, int32 PackageIndex)
+	{
+		Builder.Add(TypeIR::GetName(Node));
+		Builder.Add(Node.CastFlags);
+		Builder.Add(Node.PropertyFlags);
+		Builder.Add(Node.Offset);
+		Builder.Add(Node.Size);
+		Builder.Add(Node.ArrayDim);
+		Builder.Add(Node.FieldMask);
+		Builder.Add(Node.ByteOffset);
+		Builder.Add(Node.BitIndex);
+		Builder.Add(Node.bIsNativeBool);
+
+		AddReferencedObject(Builder, Node.Referenced, PackageIndex);
+		AddReferencedObject(Builder, Node.MetaClass, PackageIndex);
+
+		if (Node.FieldClassName)
+			Builder.Add(TypeIR::GetName(Node.FieldClassName));
+
+		for (const TypeIR::PropertyNode* Inner : Node.Inner)
+		{
+			if (Inner)
+			{
+				AddProperty(Builder, *Inner, PackageIndex);
+			}
+			else
+			{
+				Builder.Add(static_cast<uint8>(0x0));
+			}
+		}
+	}
+
+	void AddStruct(FingerprintBuilder& Builder, int32 StructIndex, int32 PackageIndex)
+	{
+		const StructWrapper Struct = ObjectArray::GetByIndex<UEStruct>(StructIndex);
+
+		const auto [UniqueName, bIsUnique] = Struct.GetUniqueName();
+
+		Builder.Add(UniqueName);
+		Builder.Add(bIsUnique);
+		Builder.Add(Struct.GetSize());
+		Builder.Add(Struct.GetAlignment());
+		Builder.Add(Struct.ShouldUseExplicitAlignment());
+		Builder.Add(Struct.IsFinal());
+		Builder.Add(Struct.HasReusedTrailingPadding());
+
+		/* Supers are always included, changes to their layout are covered by the effective fingerprint */
+		AddReferencedObject(Builder, Struct.GetUnrealStruct().GetSuper(), PackageIndex);
+
+		for (const TypeIR::PropertyNode& Property : TypeIR::GetProperties(StructIndex))
+			AddProperty(Builder, Property, PackageIndex);
+
+		for (const TypeIR::FunctionNode& Function : TypeIR::GetFunctions(StructIndex))
+		{
+			Builder.Add(TypeIR::GetValidName(Function));
+			Builder.Add(Function.Flags);
+
+			for (const TypeIR::PropertyNode& Param : TypeIR::GetProperties(Function.Function))
+				AddProperty(Builder, Param, PackageIndex);
+		}
+
+		/* Names as written, after the MemberManager resolved collisions with reserved names and the members of supers */
+		const MemberManager Members = Struct.GetMembers();
+
+		for (const PropertyWrapper& Member : Members.IterateMembers())
+			Builder.Add(Member.GetName());
+
+		for (const FunctionWrapper& Function : Members.IterateFunctions())
+			Builder.Add(Function.GetName());
+	}
+
+	/* 'SortedNames' are FName comparison-indices */
+	bool HasNameOf(const std::vector<int32>& SortedNames, UEObject Object)
+	{
+		return Object && std::binary_search(SortedNames.begin(), SortedNames.end(), Object.GetFName().GetCompIdx());
+	}
+
+	bool ReferencesNameOf(const std::vector<int32>& SortedNames, const TypeIR::PropertyNode& Node)
+	{
+		if (HasNameOf(SortedNames, Node.Referenced) || HasNameOf(SortedNames, Node.MetaClass))
+			return true;
+
+		return std::any_of(std::begin(Node.Inner), std::end(Node.Inner), [&](const TypeIR::PropertyNode* Inner) { return Inner && ReferencesNameOf(SortedNames, *Inner); });
+	}
+
+	/* Same traversal as ComputeOwnFingerprint, 'bCheckReferences' also looks at the types used by the members and parameters */
+	bool UsesNameOf(const std::vector<int32>& SortedNames, PackageInfoHandle Package, bool bCheckReferences)
+	{
+		bool bUsesName = std::any_of(Package.GetEnums().begin(), Package.GetEnums().end(), [&](int32 EnumIndex) { return HasNameOf(SortedNames, ObjectArray::GetByIndex(EnumIndex)); });
+
+		auto CheckStruct = [&](int32 StructIndex) -> void
+		{
+			if (bUsesName || HasNameOf(SortedNames, ObjectArray::GetByIndex(StructIndex)))
+			{
+				bUsesName = true;
+				return;
+			}
+
+			if (!bCheckReferences)
+				return;
+
+			auto ReferencesName = [&](const TypeIR::PropertyNode& Node) { return ReferencesNameOf(SortedNames, Node); };
+
+			const std::span<const TypeIR::PropertyNode> Properties = TypeIR::GetProperties(StructIndex);
+			bUsesName = std::any_of(Properties.begin(), Properties.end(), ReferencesName);
+
+			for (const TypeIR::FunctionNode& Function : TypeIR::GetFunctions(StructIndex))
+			{
+				const std::span<const TypeIR::PropertyNode> Params = TypeIR::GetProperties(Function.Function);
+				bUsesName = bUsesName || std::any_of(Params.begin(), Params.end(), ReferencesName);
+			}
+		};
+
+		if (Package.HasStructs())
+			Package.GetSortedStructs().VisitAllNodes(CheckStruct);
+
+		if (Package.HasClasses())
+			Package.GetSortedClasses().VisitAllNodes(CheckStruct);
+
+		if (bCheckReferences && !bUsesName)
+		{
+			const auto& EnumForwardDeclarations = Package.GetEnumForwardDeclarations();
+
+			bUsesName = std::any_of(EnumForwardDeclarations.begin(), EnumForwardDeclarations.end(), [&](const auto& Declaration) { return HasNameOf(SortedNames, ObjectArray::GetByIndex(Declaration.first)); });
+		}
+
+		return bUsesName;
+	}
+}
+
+uint64 PackageFingerprints::ComputeOwnFingerprint(PackageInfoHandle Package)
+{
+	FingerprintBuilder Builder;
+
+	Builder.Add(Package.GetName());
+	Builder.Add(Package.HasClasses());
+	Builder.Add(Package.HasStructs());
+	Builder.Add(Package.HasFunctions());
+	Builder.Add(Package.HasParameterStructs());
+	Builder.Add(Package.HasEnums());
+
+	for (int32 EnumIndex : Package.GetEnums())
+	{
+		const UEEnum Enum = ObjectArray::GetByIndex<UEEnum>(EnumIndex);
+		const EnumWrapper Wrapper(Enum);
+
+		const auto [UniqueName, bIsUnique] = Wrapper.GetUniqueName();
+
+		Builder.Add(UniqueName);
+		Builder.Add(bIsUnique);
+		Builder.Add(Wrapper.GetUnderlyingTypeSize());
+
+		for (const auto& [Name, Value] : Enum.GetNameValuePairs())
+		{
+			Builder.Add(Name.ToString());
+			Builder.Add(Value);
+		}
+	}
+
+	for (const auto& [EnumIndex, bIsForClassFile] : Package.GetEnumForwardDeclarations())
+	{
+		AddReferencedObject(Builder, ObjectArray::GetByIndex(EnumIndex), Package.GetIndex());
+		Builder.Add(bIsForClassFile);
+	}
+
+	/* Sorted order decides the order in which the structs are written */
+	auto AddStructCallback = [&](int32 Index) -> void { AddStruct(Builder, Index, Package.GetIndex()); };
+
+	if (Package.HasStructs())
+		Package.GetSortedStructs().VisitAllNodes(AddStructCallback);
+
+	Builder.Add(static_cast<uint8>(0xFF));
+
+	if (Package.HasClasses())
+		Package.GetSortedClasses().VisitAllNodes(AddStructCallback);
+
+	/* The direct includes of every file of this package */
+	const DependencyInfo& Dependencies = Package.GetPackageDependencies();
+
+	auto AddIncludes = [&](const PackageIncludeSet& Includes) -> void
+	{
+		Includes.ForEach([&](int32 DenseIndex, bool bIncludesStructs, bool bIncludesClasses) -> void
+		{
+			Builder.Add(PackageManager::GetName(PackageManager::GetPackageIndexFromDense(DenseIndex)));
+			Builder.Add(bIncludesStructs);
+			Builder.Add(bIncludesClasses);
+		});
+
+		Builder.Add(static_cast<uint8>(0xFF));
+	};
+
+	AddIncludes(Dependencies.StructsDependencies);
+	AddIncludes(Dependencies.ClassesDependencies);
+	AddIncludes(Dependencies.ParametersDependencies);
+
+	return Builder.Hash;
+}
+
+PackageBitSet PackageFingerprints::GetPackagesAffectedByChanges()
+{
+	const int32 NumPackages = PackageManager::GetNumPackages();
+
+	PackageBitSet Affected;
+	Affected.Resize(NumPackages);
+
+	std::vector<int32> PendingPackages;
+
+	auto AddPackage = [&](int32 DenseIndex) -> void
+	{
+		if (DenseIndex == -1 || Affected.Test(DenseIndex))
+			return;
+
+		Affected.Set(DenseIndex);
+		PendingPackages.push_back(DenseIndex);
+	};
+
+	/* Packages that were removed entirely don't have a dense index anymore */
+	for (const int32 PackageIndex : ChangedPackages)
+		AddPackage(PackageManager::GetDenseIndex(PackageIndex));
+
+	std::sort(ChangedNames.begin(), ChangedNames.end());
+	ChangedNames.erase(std::unique(ChangedNames.begin(), ChangedNames.end()), ChangedNames.end());
+
+	/* Written by one thread per package */
+	std::vector<uint8> UsesChangedName(NumPackages, false);
+
+	auto FindPackagesUsingChangedNames = [&](bool bCheckReferences) -> void
+	{
+		WorkerPool::ParallelFor(NumPackages, [&](int32 DenseIndex) -> void
+		{
+			if (!Affected.Test(DenseIndex))
+				UsesChangedName[DenseIndex] = UsesNameOf(ChangedNames, PackageManager::GetInfo(PackageManager::GetPackageIndexFromDense(DenseIndex)), bCheckReferences);
+		});
+	};
+
+	/*
+	* Only the unique names of types sharing a name with a changed one can change. If no unchanged package declares such a type, the references don't
+	* need to be checked, which is the common case of a level bringing its own blueprints.
+	*/
+	FindPackagesUsingChangedNames(false);
+
+	if (std::find(UsesChangedName.begin(), UsesChangedName.end(), true) != UsesChangedName.end())
+		FindPackagesUsingChangedNames(true);
+
+	for (int32 DenseIndex = 0; DenseIndex < NumPackages; DenseIndex++)
+	{
+		if (UsesChangedName[DenseIndex])
+			AddPackage(DenseIndex);
+	}
+
+	/* Reverse of the package-dependencies, every package including an affected package is affected as well */
+	std::vector<std::vector<int32>> IncludedBy(NumPackages);
+
+	for (int32 DenseIndex = 0; DenseIndex < NumPackages; DenseIndex++)
+	{
+		const DependencyInfo& Dependencies = PackageManager::GetInfo(PackageManager::GetPackageIndexFromDense(DenseIndex)).GetPackageDependencies();
+
+		auto AddIncludedBy = [&](int32 IncludedIndex, bool, bool) -> void { IncludedBy[IncludedIndex].push_back(DenseIndex); };
+
+		Dependencies.StructsDependencies.ForEach(AddIncludedBy);
+		Dependencies.ClassesDependencies.ForEach(AddIncludedBy);
+		Dependencies.ParametersDependencies.ForEach(AddIncludedBy);
+	}
+
+	while (!PendingPackages.empty())
+	{
+		const int32 DenseIndex = PendingPackages.back();
+		PendingPackages.pop_back();
+
+		for (const int32 IncludingIndex : IncludedBy[DenseIndex])
+			AddPackage(IncludingIndex);
+	}
+
+	return Affected;
+}
+
+void PackageFingerprints::SetChanges(std::vector<int32>&& PackageIndices, std::vector<int32>&& NameIndices)
+{
+	ChangedPackages = std::move(PackageIndices);
+	ChangedNames = std::move(NameIndices);
+	bHasChanges = true;
+}
+
+void PackageFingerprints::Init(bool bHasPreviousFingerprints)
+{
+	const int32 NumPackages = PackageManager::GetNumPackages();
+
+	OwnFingerprints.assign(NumPackages, 0x0);
+	EffectiveFingerprints.assign(NumPackages, 0x0);
+
+	const bool bIsLimitedToChanges = bHasPreviousFingerprints && bHasChanges;
+
+	PackageBitSet Affected;
+
+	if (bIsLimitedToChanges)
+		Affected = GetPackagesAffectedByChanges();
+
+	ChangedPackages.clear();
+	ChangedNames.clear();
+	bHasChanges = false;
+
+	std::atomic<int32> NumComputed = 0x0;
+
+	WorkerPool::ParallelFor(NumPackages, [&](int32 DenseIndex) -> void
+	{
+		const PackageInfoHandle Package = PackageManager::GetInfo(PackageManager::GetPackageIndexFromDense(DenseIndex));
+
+		if (bIsLimitedToChanges && !Affected.Test(DenseIndex))
+		{
+			auto It = PreviousFingerprints.find(Package.GetName());
+
+			/* Packages that are new, or got a new name through a collision, have no previous fingerprint */
+			if (It != PreviousFingerprints.end())
+			{
+				OwnFingerprints[DenseIndex] = It->second.Own;
+				return;
+			}
+		}
+
+		OwnFingerprints[DenseIndex] = ComputeOwnFingerprint(Package);
+		NumComputed++;
+	});
+
+	if (bIsLimitedToChanges)
+		std::cerr << std::format("PackageFingerprints: {} of {} packages are affected by the changes in GObjects.\n", NumComputed.load(), NumPackages);
+
+	WorkerPool::ParallelFor(NumPackages, [NumPackages](int32 DenseIndex) -> void
+	{
+		const DependencyInfo& Dependencies = PackageManager::GetInfo(PackageManager::GetPackageIndexFromDense(DenseIndex)).GetPackageDependencies();
+
+		/* Parameter-files don't have transitive includes of their own, they reach everything through the headers they include */
+		PackageIncludeSet Reachable;
+		Reachable.Resize(NumPackages);
+
+		Reachable |= Dependencies.TransitiveStructsIncludes;
+		Reachable |= Dependencies.TransitiveClassesIncludes;
+		Reachable |= Dependencies.ParametersDependencies;
+
+		Dependencies.ParametersDependencies.ForEach([&](int32 IncludedIndex, bool, bool) -> void
+		{
+			const DependencyInfo& IncludedDependencies = PackageManager::GetInfo(PackageManager::GetPackageIndexFromDense(IncludedIndex)).GetPackageDependencies();
+
+			Reachable |= IncludedDependencies.TransitiveStructsIncludes;
+			Reachable |= IncludedDependencies.TransitiveClassesIncludes;
+		});
+
+		FingerprintBuilder Builder;
+		Builder.Add(OwnFingerprints[DenseIndex]);
+
+		Reachable.ForEach([&](int32 IncludedIndex, bool, bool) -> void
+		{
+			Builder.Add(OwnFingerprints[IncludedIndex]);
+		});
+
+		EffectiveFingerprints[DenseIndex] = Builder.Hash;
+	});
+}
+
+bool PackageFingerprints::Load(const std::filesystem::path& FilePath, uint64 BuildStamp)
+{
+	PreviousFingerprints.clear();
+
+	std::ifstream FingerprintFile(FilePath, std::ios::binary);
+
+	if (!FingerprintFile.is_open())
+		return false;
+
+	/* First line is the build-stamp, every other line is "<EffectiveFingerprint> <OwnFingerprint> <PackageName>" */
+	std::string Line;
+
+	if (!std::getline(FingerprintFile, Line) || Line != std::format("{:016X}", BuildStamp))
+		return false;
+
+	while (std::getline(FingerprintFile, Line))
+	{
+		const size_t FirstSpace = Line.find(' ');
+		const size_t SecondSpace = FirstSpace != std::string::npos ? Line.find(' ', FirstSpace + 1) : std::string::npos;
+
+		if (SecondSpace == std::string::npos)
+			continue;
+
+		PreviousFingerprint Fingerprint = {};
+
+		if (std::from_chars(Line.data(), Line.data() + FirstSpace, Fingerprint.Effective, 16).ec != std::errc())
+			continue;
+
+		if (std::from_chars(Line.data() + FirstSpace + 1, Line.data() + SecondSpace, Fingerprint.Own, 16).ec != std::errc())
+			continue;
+
+		PreviousFingerprints.emplace(Line.substr(SecondSpace + 1), Fingerprint);
+	}
+
+	return true;
+}
+
+std::string PackageFingerprints::Serialize(uint64 BuildStamp)
+{
+	std::string Text = std::format("{:016X}\n", BuildStamp);
+
+	for (int i = 0; i < static_cast<int32>(EffectiveFingerprints.size()); i++)
+		Text += std::format("{:016X} {:016X} {}\n", EffectiveFingerprints[i], OwnFingerprints[i], PackageManager::GetName(PackageManager::GetPackageIndexFromDense(i)));
+
+	return Text;
+}
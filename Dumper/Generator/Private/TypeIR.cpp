@@ -0,0 +1,393 @@
+
+#include "TypeIR.h"
+
+#include "Unreal/StructMemberCache.h"
+#include "Unreal/ObjectArray.h"
+
+#include "Settings.h"
+
+
+namespace
+{
+	/* Everything the type-string of a property depends on, nodes with equal keys stringify to the same type in every generator */
+	struct TypeShapeKey
+	{
+		uint64 CastFlags = 0x0;
+
+		/* Only used to stringify unknown property-types */
+		const void* Class = nullptr;
+
+		int32 Referenced = -1;
+		int32 MetaClass = -1;
+		int32 Inner[2] = { -1, -1 };
+		int32 FieldClassName = -1;
+		int32 Size = 0x0;
+
+		bool bIsNativeBool = true;
+		bool bIsObjectWrapper = false;
+
+		bool operator==(const TypeShapeKey& Other) const = default;
+	};
+
+	struct TypeShapeKeyHash
+	{
+		size_t operator()(const TypeShapeKey& Key) const
+		{
+			uint64 Hash = Key.CastFlags;
+
+			auto Combine = [&Hash](uint64 Value) -> void
+			{
+				Hash ^= Value + 0x9E3779B97F4A7C15ull + (Hash << 6) + (Hash >> 2);
+			};
+
+			Combine(reinterpret_cast<uintptr_t>(Key.Class));
+			Combine((static_cast<uint64>(static_cast<uint32>(Key.Referenced)) << 32) | static_cast<uint32>(Key.MetaClass));
+			Combine((static_cast<uint64>(static_cast<uint32>(Key.Inner[0])) << 32) | static_cast<uint32>(Key.Inner[1]));
+			Combine((static_cast<uint64>(static_cast<uint32>(Key.FieldClassName)) << 32) | static_cast<uint32>(Key.Size));
+			Combine((Key.bIsNativeBool ? 0x1 : 0x0) | (Key.bIsObjectWrapper ? 0x2 : 0x0));
+
+			return static_cast<size_t>(Hash);
+		}
+	};
+}
+
+
+void TypeIR::FillPropertyNode(PropertyNode& Node, UEProperty Prop)
+{
+	auto [Class, FieldClass] = Prop.GetClass();
+
+	Node.Property = Prop;
+	Node.Class = Class;
+	Node.FieldClass = FieldClass;
+	Node.CastFlags = Class ? Class.GetCastFlags() : FieldClass.GetCastFlags();
+	Node.PropertyFlags = Prop.GetPropertyFlags();
+	Node.Offset = Prop.GetOffset();
+	Node.Size = Prop.GetSize();
+	Node.ArrayDim = Prop.GetArrayDim();
+	Node.Name = Names.FindOrAdd(Prop.GetName(), false).first;
+
+	constexpr EClassCastFlags ObjectPropertyTypes = EClassCastFlags::ObjectPropertyBase | EClassCastFlags::ObjectProperty | EClassCastFlags::ClassProperty | EClassCastFlags::InterfaceProperty
+		| EClassCastFlags::WeakObjectProperty | EClassCastFlags::LazyObjectProperty | EClassCastFlags::SoftObjectProperty | EClassCastFlags::SoftClassProperty;
+
+	if (Node.IsA(EClassCastFlags::ByteProperty))
+	{
+		Node.Referenced = Prop.Cast<UEByteProperty>().GetEnum();
+	}
+	else if (Node.IsA(EClassCastFlags::EnumProperty))
+	{
+		Node.Referenced = Prop.Cast<UEEnumProperty>().GetEnum();
+	}
+	else if (Node.IsA(EClassCastFlags::StructProperty))
+	{
+		Node.Referenced = Prop.Cast<UEStructProperty>().GetUnderlayingStruct();
+	}
+	else if (Node.IsA(EClassCastFlags::BoolProperty))
+	{
+		const UEBoolProperty AsBool = Prop.Cast<UEBoolProperty>();
+
+		Node.bIsNativeBool = AsBool.IsNativeBool();
+
+		if (!Node.bIsNativeBool)
+		{
+			Node.FieldMask = AsBool.GetFieldMask();
+			Node.ByteOffset = AsBool.GetByteOffset();
+			Node.BitIndex = AsBool.GetBitIndex();
+		}
+	}
+	else if (Node.IsA(EClassCastFlags::DelegateProperty))
+	{
+		Node.Referenced = Prop.Cast<UEDelegateProperty>().GetSignatureFunction();
+	}
+	else if (Node.IsA(EClassCastFlags::MulticastInlineDelegateProperty))
+	{
+		Node.Referenced = Prop.Cast<UEMulticastInlineDelegateProperty>().GetSignatureFunction();
+	}
+	else if (Node.IsA(EClassCastFlags::FieldPathProperty))
+	{
+		if (Settings::Internal::bIsObjPtrInsteadOfFieldPathProperty)
+		{
+			Node.Referenced = Prop.Cast<UEObjectProperty>().GetPropertyClass();
+		}
+		else if (UEFFieldClass PathFieldClass = Prop.Cast<UEFieldPathProperty>().GetFieldClass())
+		{
+			Node.FieldClassName = Names.FindOrAdd(PathFieldClass.GetCppName(), false).first;
+		}
+	}
+	else if (Node.IsType(ObjectPropertyTypes))
+	{
+		Node.Referenced = Prop.Cast<UEObjectProperty>().GetPropertyClass();
+
+		if (Node.IsA(EClassCastFlags::ClassProperty))
+			Node.MetaClass = Prop.Cast<UEClassProperty>().GetMetaClass();
+	}
+}
+
+int32 TypeIR::GetInnerProperties(const PropertyNode& Node, UEProperty(&OutInner)[2])
+{
+	const UEProperty Prop = Node.Property;
+
+	if (Node.IsA(EClassCastFlags::ArrayProperty))
+	{
+		OutInner[0] = Prop.Cast<UEArrayProperty>().GetInnerProperty();
+		return 1;
+	}
+	else if (Node.IsA(EClassCastFlags::SetProperty))
+	{
+		OutInner[0] = Prop.Cast<UESetProperty>().GetElementProperty();
+		return 1;
+	}
+	else if (Node.IsA(EClassCastFlags::MapProperty))
+	{
+		OutInner[0] = Prop.Cast<UEMapProperty>().GetKeyProperty();
+		OutInner[1] = Prop.Cast<UEMapProperty>().GetValueProperty();
+		return 2;
+	}
+	else if (Node.IsA(EClassCastFlags::EnumProperty))
+	{
+		OutInner[0] = Prop.Cast<UEEnumProperty>().GetUnderlayingProperty();
+		return 1;
+	}
+	else if (Node.IsA(EClassCastFlags::OptionalProperty))
+	{
+		OutInner[0] = Prop.Cast<UEOptionalProperty>().GetValueProperty();
+		return 1;
+	}
+
+	return 0;
+}
+
+const TypeIR::PropertyNode& TypeIR::GetDetachedNode(UEProperty Prop)
+{
+	/* Node-based, references stay valid when the map rehashes */
+	static thread_local std::unordered_map<const void*, PropertyNode> DetachedNodes;
+	static thread_local uint32 DetachedNodesGeneration = 0x0;
+
+	if (DetachedNodesGeneration != Generation)
+	{
+		DetachedNodes.clear();
+		DetachedNodesGeneration = Generation;
+	}
+
+	auto [It, bInserted] = DetachedNodes.try_emplace(Prop.GetAddress());
+
+	if (!bInserted)
+		return It->second;
+
+	PropertyNode& Node = It->second;
+	FillPropertyNode(Node, Prop);
+
+	UEProperty InnerProperties[2];
+	const int32 NumInner = GetInnerProperties(Node, InnerProperties);
+
+	for (int i = 0; i < NumInner; i++)
+	{
+		if (InnerProperties[i])
+			Node.Inner[i] = &GetNode(InnerProperties[i]);
+	}
+
+	return Node;
+}
+
+int32 TypeIR::ResolveShapeAlignment(const PropertyNode& Node)
+{
+	if (Node.IsA(EClassCastFlags::StructProperty))
+	{
+		return Node.Referenced ? Node.Referenced.Cast<UEStruct>().GetMinAlignment() : 0x1;
+	}
+	else if (Node.IsA(EClassCastFlags::EnumProperty))
+	{
+		/* Same fallback as UEProperty::GetAlignment if there is no underlaying property */
+		return Node.Inner[0] ? ShapeAlignments[Node.Inner[0]->TypeShape] : 0x1;
+	}
+	else if (Node.IsA(EClassCastFlags::OptionalProperty) && Node.Inner[0])
+	{
+		const PropertyNode& ValueNode = *Node.Inner[0];
+
+		/* If this check is true it means, that there is no bool in this TOptional to check if the value is set */
+		if (ValueNode.Size == Node.Size) [[unlikely]]
+			return ShapeAlignments[ValueNode.TypeShape];
+
+		return Node.Size - ValueNode.Size;
+	}
+
+	/* Flat switch for all other types, unknown property-types are only looked up once per shape */
+	return Node.Property.GetAlignment();
+}
+
+void TypeIR::InitTypeShapes()
+{
+	std::unordered_map<TypeShapeKey, int32, TypeShapeKeyHash> ShapeIds;
+	ShapeIds.reserve(0x4000);
+
+	TypeShapes.clear();
+	TypeShapes.reserve(0x4000);
+
+	ShapeAlignments.clear();
+	ShapeAlignments.reserve(0x4000);
+
+	/* Inner-properties are always stored behind the property owning them, walking backwards interns them before the shapes containing them */
+	for (int i = static_cast<int32>(Properties.size()) - 1; i >= 0; i--)
+	{
+		PropertyNode& Node = Properties[i];
+
+		TypeShapeKey Key;
+		Key.CastFlags = static_cast<uint64>(Node.CastFlags);
+		Key.Class = Node.Class ? Node.Class.GetAddress() : Node.FieldClass.GetAddress();
+		Key.Referenced = Node.Referenced ? Node.Referenced.GetIndex() : -1;
+		Key.MetaClass = Node.MetaClass ? Node.MetaClass.GetIndex() : -1;
+		Key.Inner[0] = Node.Inner[0] ? Node.Inner[0]->TypeShape : -1;
+		Key.Inner[1] = Node.Inner[1] ? Node.Inner[1]->TypeShape : -1;
+		Key.FieldClassName = Node.FieldClassName;
+		Key.Size = Node.Size;
+		Key.bIsNativeBool = Node.bIsNativeBool;
+		Key.bIsObjectWrapper = Node.HasPropertyFlags(EPropertyFlags::UObjectWrapper);
+
+		auto [It, bInserted] = ShapeIds.try_emplace(Key, static_cast<int32>(TypeShapes.size()));
+
+		Node.TypeShape = It->second;
+
+		if (bInserted)
+		{
+			TypeShapes.push_back(&Node);
+			ShapeAlignments.push_back(ResolveShapeAlignment(Node));
+		}
+	}
+
+	TypeShapes.shrink_to_fit();
+	ShapeAlignments.shrink_to_fit();
+}
+
+void TypeIR::Init()
+{
+	if (bIsInitialized)
+		return;
+
+	const std::span<const UEProperty> MemberProperties = StructMemberCache::GetAllProperties();
+	const std::span<const UEFunction> CachedFunctions = StructMemberCache::GetAllFunctions();
+
+	/*
+	* Inner-properties are appended behind all member-properties while walking them, their indices are recorded in 'InnerIndices'.
+	* The Inner-pointers are only resolved once 'Properties' stopped growing.
+	*/
+	std::vector<UEProperty> AllProperties(MemberProperties.begin(), MemberProperties.end());
+	std::vector<std::pair<int32, int32>> InnerIndices(AllProperties.size(), { -1, -1 });
+
+	Properties.resize(AllProperties.size());
+
+	for (int i = 0; i < static_cast<int32>(AllProperties.size()); i++)
+	{
+		PropertyNode& Node = Properties[i];
+		FillPropertyNode(Node, AllProperties[i]);
+
+		UEProperty InnerProperties[2];
+		const int32 NumInner = GetInnerProperties(Node, InnerProperties);
+
+		for (int j = 0; j < NumInner; j++)
+		{
+			if (!InnerProperties[j])
+				continue;
+
+			(j == 0 ? InnerIndices[i].first : InnerIndices[i].second) = static_cast<int32>(AllProperties.size());
+
+			AllProperties.push_back(InnerProperties[j]);
+			InnerIndices.emplace_back(-1, -1);
+			Properties.emplace_back();
+		}
+	}
+
+	Properties.shrink_to_fit();
+
+	/* 'Properties' won't grow anymore, pointers into it are stable from here on */
+	PropertyLookup.reserve(Properties.size());
+
+	for (int i = 0; i < static_cast<int32>(Properties.size()); i++)
+	{
+		PropertyNode& Node = Properties[i];
+
+		if (InnerIndices[i].first != -1)
+			Node.Inner[0] = &Properties[InnerIndices[i].first];
+
+		if (InnerIndices[i].second != -1)
+			Node.Inner[1] = &Properties[InnerIndices[i].second];
+
+		PropertyLookup.emplace(Node.Property.GetAddress(), i);
+	}
+
+	InitTypeShapes();
+
+	Functions.resize(CachedFunctions.size());
+
+	for (int i = 0; i < static_cast<int32>(CachedFunctions.size()); i++)
+	{
+		const UEFunction Func = CachedFunctions[i];
+		FunctionNode& Node = Functions[i];
+
+		Node.Function = Func;
+		Node.Flags = Func.GetFunctionFlags();
+		Node.ExecFunction = Func.GetExecFunction();
+		Node.ValidName = Names.FindOrAdd(Func.GetValidName(), false).first;
+	}
+
+	bIsInitialized = true;
+}
+
+MemoryReport TypeIR::GetMemoryReport()
+{
+	MemoryReport Report = Names.GetMemoryReport();
+
+	Report += MemoryReport::FromVector(Properties);
+	Report += MemoryReport::FromVector(Functions);
+	Report += MemoryReport::FromHashContainer(PropertyLookup);
+	Report += MemoryReport::FromVector(TypeShapes);
+	Report += MemoryReport::FromVector(ShapeAlignments);
+
+	return Report;
+}
+
+void TypeIR::Reset()
+{
+	bIsInitialized = false;
+	Generation++;
+
+	Properties.clear();
+	Functions.clear();
+	PropertyLookup.clear();
+	TypeShapes.clear();
+	ShapeAlignments.clear();
+	Names.Clear();
+}
+
+const TypeIR::PropertyNode& TypeIR::GetNode(UEProperty Prop)
+{
+	if (bIsInitialized)
+	{
+		auto It = PropertyLookup.find(Prop.GetAddress());
+
+		if (It != PropertyLookup.end()) [[likely]]
+			return Properties[It->second];
+	}
+
+	return GetDetachedNode(Prop);
+}
+
+std::span<const TypeIR::PropertyNode> TypeIR::GetProperties(int32 StructIndex)
+{
+	if (!bIsInitialized || !StructMemberCache::Contains(StructIndex))
+		return {};
+
+	const std::span<const UEProperty> StructProperties = StructMemberCache::GetProperties(StructIndex);
+	const size_t FirstIndex = StructProperties.data() - StructMemberCache::GetAllProperties().data();
+
+	return std::span<const PropertyNode>(Properties.data() + FirstIndex, StructProperties.size());
+}
+
+std::span<const TypeIR::FunctionNode> TypeIR::GetFunctions(int32 StructIndex)
+{
+	if (!bIsInitialized || !StructMemberCache::Contains(StructIndex))
+		return {};
+
+	const std::span<const UEFunction> StructFunctions = StructMemberCache::GetFunctions(StructIndex);
+	const size_t FirstIndex = StructFunctions.data() - StructMemberCache::GetAllFunctions().data();
+
+	return std::span<const FunctionNode>(Functions.data() + FirstIndex, StructFunctions.size());
+}
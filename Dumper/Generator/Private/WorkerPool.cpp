@@ -0,0 +1,219 @@
+
+#include <algorithm>
+
+#include "WorkerPool.h"
+#include "GeneratorContext.h"
+#include "TimeSlicer.h"
+
+
+void WorkerPool::Start()
+{
+	std::scoped_lock Lock(StartStopLock);
+
+	if (bIsRunning)
+		return;
+
+	const int32 NumWorkers = std::clamp(static_cast<int32>(std::thread::hardware_concurrency()) - 1, 1, MaxNumWorkers);
+
+	Queues.clear();
+	Queues.reserve(NumWorkers);
+
+	for (int i = 0; i < NumWorkers; i++)
+		Queues.push_back(std::make_unique<WorkerQueue>());
+
+	bShouldStop = false;
+
+	Workers.reserve(NumWorkers);
+
+	for (int i = 0; i < NumWorkers; i++)
+		Workers.emplace_back(&WorkerPool::WorkerMain, i);
+
+	bIsRunning = true;
+}
+
+void WorkerPool::WorkerMain(int32 QueueIndex)
+{
+	OwnQueueIndex = QueueIndex;
+
+	while (true)
+	{
+		QueuedTask Task;
+
+		if (PopTask(Task))
+		{
+			RunTask(Task);
+			continue;
+		}
+
+		std::unique_lock Lock(SleepLock);
+
+		WakeUp.wait(Lock, []() { return NumQueuedTasks > 0 || bShouldStop; });
+
+		/* Queued tasks are still finished when the pool is stopped */
+		if (bShouldStop && NumQueuedTasks == 0)
+			break;
+	}
+
+	OwnQueueIndex = -1;
+}
+
+bool WorkerPool::PopTask(QueuedTask& OutTask)
+{
+	if (NumQueuedTasks == 0 || Queues.empty())
+		return false;
+
+	/* Newest task of our own queue first, its data is most likely still in the cache */
+	if (OwnQueueIndex != -1)
+	{
+		WorkerQueue& Own = *Queues[OwnQueueIndex];
+
+		std::scoped_lock Lock(Own.Lock);
+
+		if (!Own.Tasks.empty())
+		{
+			OutTask = std::move(Own.Tasks.back());
+			Own.Tasks.pop_back();
+
+			NumQueuedTasks--;
+			return true;
+		}
+	}
+
+	/* Steal the oldest task of another queue, those usually are the largest pieces of work left */
+	const int32 NumQueues = static_cast<int32>(Queues.size());
+	const int32 FirstVictim = OwnQueueIndex != -1 ? (OwnQueueIndex + 1) : static_cast<int32>(NextExternalQueue % NumQueues);
+
+	for (int i = 0; i < NumQueues; i++)
+	{
+		WorkerQueue& Victim = *Queues[(FirstVictim + i) % NumQueues];
+
+		std::scoped_lock Lock(Victim.Lock);
+
+		if (Victim.Tasks.empty())
+			continue;
+
+		OutTask = std::move(Victim.Tasks.front());
+		Victim.Tasks.pop_front();
+
+		NumQueuedTasks--;
+		return true;
+	}
+
+	return false;
+}
+
+void WorkerPool::RunTask(QueuedTask& Task)
+{
+	GeneratorContext::Scope ContextScope(Task.Context);
+
+	TimeSlicer::YieldPoint();
+
+	Task.Task();
+}
+
+void WorkerPool::Submit(TaskType&& Task)
+{
+	if (!bIsRunning) [[unlikely]]
+		Start();
+
+	const int32 QueueIndex = OwnQueueIndex != -1 ? OwnQueueIndex : static_cast<int32>(NextExternalQueue++ % Queues.size());
+
+	{
+		WorkerQueue& Queue = *Queues[QueueIndex];
+
+		std::scoped_lock Lock(Queue.Lock);
+		Queue.Tasks.push_back({ std::move(Task), GeneratorContext::GetCurrent() });
+	}
+
+	NumQueuedTasks++;
+
+	/* Taking the lock orders the increment before the check of any worker that is about to sleep */
+	{
+		std::scoped_lock Lock(SleepLock);
+	}
+
+	WakeUp.notify_one();
+}
+
+bool WorkerPool::TryRunPendingTask()
+{
+	if (!bIsRunning)
+		return false;
+
+	QueuedTask Task;
+
+	if (!PopTask(Task))
+		return false;
+
+	RunTask(Task);
+
+	return true;
+}
+
+void WorkerPool::ParallelFor(int32 NumItems, const std::function<void(int32 Index)>& Body)
+{
+	if (NumItems <= 0)
+		return;
+
+	if (NumItems == 1)
+		return Body(0);
+
+	if (!bIsRunning) [[unlikely]]
+		Start();
+
+	std::atomic<int32> NextItem = 0x0;
+
+	auto RunItems = [&]() -> void
+	{
+		for (int32 Index = NextItem++; Index < NumItems; Index = NextItem++)
+		{
+			TimeSlicer::YieldPoint();
+			Body(Index);
+		}
+	};
+
+	/* Helpers only claim items, ones that start after all items were claimed return immediately */
+	const int32 NumHelpers = std::min(GetNumWorkers(), NumItems - 1);
+	std::atomic<int32> NumRunningHelpers = NumHelpers;
+
+	for (int i = 0; i < NumHelpers; i++)
+	{
+		Submit([&]() -> void
+		{
+			RunItems();
+			NumRunningHelpers--;
+		});
+	}
+
+	RunItems();
+
+	/* The helpers reference this stack-frame, help with other work until every one of them has returned */
+	while (NumRunningHelpers > 0)
+	{
+		if (!TryRunPendingTask())
+			std::this_thread::yield();
+	}
+}
+
+void WorkerPool::Shutdown()
+{
+	std::scoped_lock Lock(StartStopLock);
+
+	if (!bIsRunning)
+		return;
+
+	{
+		std::scoped_lock SleepGuard(SleepLock);
+		bShouldStop = true;
+	}
+
+	WakeUp.notify_all();
+
+	for (std::thread& Worker : Workers)
+		Worker.join();
+
+	Workers.clear();
+	Queues.clear();
+
+	bIsRunning = false;
+}
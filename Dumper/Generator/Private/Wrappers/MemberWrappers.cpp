@@ -1,13 +1,13 @@
 #include "Wrappers/MemberWrappers.h"
 
 
-PropertyWrapper::PropertyWrapper(const std::shared_ptr<StructWrapper>& Str, const PredefinedMember* Predef)
+PropertyWrapper::PropertyWrapper(const StructWrapper* Str, const PredefinedMember* Predef)
     : PredefProperty(Predef), Struct(Str), Name()
 {
 }
 
-PropertyWrapper::PropertyWrapper(const std::shared_ptr<StructWrapper>& Str, UEProperty Prop)
-    : Property(Prop), Name(MemberManager::GetNameCollisionInfo(Str->GetUnrealStruct(), Prop)), Struct(Str), bIsUnrealProperty(true)
+PropertyWrapper::PropertyWrapper(const StructWrapper* Str, UEProperty Prop)
+    : Property(Prop), Node(&TypeIR::GetNode(Prop)), Name(MemberManager::GetNameCollisionInfo(Str->GetUnrealStruct(), Prop)), Struct(Str), bIsUnrealProperty(true)
 {
 }
 
@@ -32,7 +32,7 @@ NameInfo PropertyWrapper::GetNameCollisionInfo() const
 
 bool PropertyWrapper::IsReturnParam() const
 {
-    return bIsUnrealProperty && Property.HasPropertyFlags(EPropertyFlags::ReturnParm);
+    return bIsUnrealProperty && Node->HasPropertyFlags(EPropertyFlags::ReturnParm);
 }
 
 UEProperty PropertyWrapper::GetUnrealProperty() const
@@ -40,6 +40,13 @@ UEProperty PropertyWrapper::GetUnrealProperty() const
     return Property;
 }
 
+const TypeIR::PropertyNode& PropertyWrapper::GetTypeNode() const
+{
+    assert(bIsUnrealProperty && "PropertyWrapper doesn't contain UnrealProperty. Illegal call to 'GetTypeNode()'.");
+
+    return *Node;
+}
+
 std::string PropertyWrapper::GetDefaultValue() const
 {
     assert(!bIsUnrealProperty && "PropertyWrapper doesn't contain PredefiendMember. Illegal call to 'GetDefaultValue()'.");
@@ -52,9 +59,7 @@ bool PropertyWrapper::IsType(EClassCastFlags CombinedFlags) const
     if (!bIsUnrealProperty)
         return false;
 
-    uint64 CastFlags = static_cast<uint64>(Property.GetCastFlags());
-
-    return (CastFlags & static_cast<uint64>(CombinedFlags)) > 0x0;
+    return Node->IsType(CombinedFlags);
 }
 
 bool PropertyWrapper::HasPropertyFlags(EPropertyFlags Flags) const
@@ -62,13 +67,13 @@ bool PropertyWrapper::HasPropertyFlags(EPropertyFlags Flags) const
     if (!bIsUnrealProperty)
         return false;
 
-    return Property.HasPropertyFlags(Flags);
+    return Node->HasPropertyFlags(Flags);
 }
 
 bool PropertyWrapper::IsBitField() const
 {
     if (bIsUnrealProperty)
-        return Property.IsA(EClassCastFlags::BoolProperty) && !Property.Cast<UEBoolProperty>().IsNativeBool();
+        return Node->IsBitField();
 
     return PredefProperty->bIsBitField;
 }
@@ -83,7 +88,7 @@ uint8 PropertyWrapper::GetBitIndex() const
 {
     assert(IsBitField() && "'GetBitIndex' was called on non-bitfield member!");
 
-    return bIsUnrealProperty ? Property.Cast<UEBoolProperty>().GetBitIndex() : PredefProperty->BitIndex;
+    return bIsUnrealProperty ? Node->BitIndex : PredefProperty->BitIndex;
 }
 
 uint8 PropertyWrapper::GetBitCount() const
@@ -97,28 +102,26 @@ uint8 PropertyWrapper::GetFieldMask() const
 {
     assert(IsBitField() && "'GetFieldMask' was called on non-bitfield member!");
 
-    return bIsUnrealProperty ? Property.Cast<UEBoolProperty>().GetFieldMask() : (1 << PredefProperty->BitIndex);
+    return bIsUnrealProperty ? Node->FieldMask : (1 << PredefProperty->BitIndex);
 }
 
 int32 PropertyWrapper::GetArrayDim() const
 {
-    return bIsUnrealProperty ? Property.GetArrayDim() : PredefProperty->ArrayDim;
+    return bIsUnrealProperty ? Node->ArrayDim : PredefProperty->ArrayDim;
 }
 
 int32 PropertyWrapper::GetSize() const
 {
     if (bIsUnrealProperty)
     {
-        UEStruct UnderlayingStruct = nullptr;
-
-        if (Property.IsA(EClassCastFlags::StructProperty) && (UnderlayingStruct = Property.Cast<UEStructProperty>().GetUnderlayingStruct()))
+        if (Node->IsA(EClassCastFlags::StructProperty) && Node->Referenced)
         {
-            const int32 Size = StructManager::GetInfo(UnderlayingStruct).GetSize();
+            const int32 Size = StructManager::GetInfo(Node->Referenced.Cast<UEStruct>()).GetSize();
 
             return Size > 0x0 ? Size : 0x1;
         }
 
-        return Property.GetSize();
+        return Node->Size;
     }
 
     return PredefProperty->Size;
@@ -126,12 +129,12 @@ int32 PropertyWrapper::GetSize() const
 
 int32 PropertyWrapper::GetOffset() const
 {
-    return bIsUnrealProperty ? Property.GetOffset() : PredefProperty->Offset;
+    return bIsUnrealProperty ? Node->Offset : PredefProperty->Offset;
 }
 
 EPropertyFlags PropertyWrapper::GetPropertyFlags() const
 {
-    return bIsUnrealProperty ? Property.GetPropertyFlags() : EPropertyFlags::None;
+    return bIsUnrealProperty ? Node->PropertyFlags : EPropertyFlags::None;
 }
 
 std::string PropertyWrapper::StringifyFlags() const
@@ -160,12 +163,12 @@ bool PropertyWrapper::IsZeroSizedMember() const
 }
 
 
-FunctionWrapper::FunctionWrapper(const std::shared_ptr<StructWrapper>& Str, const PredefinedFunction* Predef)
+FunctionWrapper::FunctionWrapper(const StructWrapper* Str, const PredefinedFunction* Predef)
     : PredefFunction(Predef), Struct(Str), Name()
 {
 }
 
-FunctionWrapper::FunctionWrapper(const std::shared_ptr<StructWrapper>& Str, UEFunction Func)
+FunctionWrapper::FunctionWrapper(const StructWrapper* Str, UEFunction Func)
     : Function(Func), Name(Str ? MemberManager::GetNameCollisionInfo(Str->GetUnrealStruct(), Func) : NameInfo()), Struct(Str), bIsUnrealFunction(true)
 {
 }
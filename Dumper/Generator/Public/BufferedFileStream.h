@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <ostream>
+#include <filesystem>
+
+#include "Unreal/Enums.h"
+
+/*
+* Output-stream for the files written by the generators, used in place of std::ofstream.
+*
+* Everything written to the stream is collected in one contiguous buffer. The file is only created once the stream is closed and is then
+* written with a single call. With Settings::Generator::bWriteFilesInBackground those writes are handed to the WorkerPool, so generation
+* continues while files are written to disk. WaitForPendingWrites() blocks until every closed stream has reached the disk.
+* With Settings::Generator::bSkipUnchangedFiles files whose contents match the FileManifest of the previous run aren't written at all.
+*
+* Like std::ofstream, streams that aren't opened with std::ios::binary translate '\n' to "\r\n". Writes to a closed stream are discarded.
+*/
+class BufferedFileStream : public std::ostream
+{
+private:
+	class Buffer : public std::streambuf
+	{
+	public:
+		std::string Data;
+
+		bool bIsOpen = false;
+		bool bTranslateNewLines = true;
+
+	protected:
+		int_type overflow(int_type Char) override;
+		std::streamsize xsputn(const char* Str, std::streamsize Count) override;
+	};
+
+private:
+	/* Most package files are larger than this, reserving it upfront skips the first few reallocations */
+	static constexpr uint64 InitialBufferSize = 0x10000;
+
+private:
+	static inline std::atomic<uint64> NumBytesWritten = 0x0;
+	static inline std::atomic<uint64> NumFilesWritten = 0x0;
+	static inline std::atomic<uint64> NumFilesSkipped = 0x0;
+	static inline std::atomic<int32> NumPendingWrites = 0x0;
+
+private:
+	Buffer FileBuffer;
+	std::filesystem::path FilePath;
+
+public:
+	BufferedFileStream();
+	explicit BufferedFileStream(const std::filesystem::path& Path, std::ios::openmode Mode = std::ios::out);
+
+	BufferedFileStream(const BufferedFileStream&) = delete;
+	BufferedFileStream& operator=(const BufferedFileStream&) = delete;
+
+	~BufferedFileStream();
+
+public:
+	/* Names match std::ofstream, so the stream can be swapped in without touching the generators */
+	void open(const std::filesystem::path& Path, std::ios::openmode Mode = std::ios::out);
+	void close();
+
+	inline bool is_open() const
+	{
+		return FileBuffer.bIsOpen;
+	}
+
+public:
+	static void WaitForPendingWrites();
+
+	static void PrintStatistics();
+
+	static inline uint64 GetNumBytesWritten()
+	{
+		return NumBytesWritten;
+	}
+
+	static inline uint64 GetNumFilesWritten()
+	{
+		return NumFilesWritten;
+	}
+
+	/* Files that already had the exact same contents on disk, see Settings::Generator::bSkipUnchangedFiles */
+	static inline uint64 GetNumFilesSkipped()
+	{
+		return NumFilesSkipped;
+	}
+};
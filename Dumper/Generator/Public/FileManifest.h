@@ -0,0 +1,61 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <filesystem>
+#include <unordered_map>
+
+#include "Unreal/Enums.h"
+
+/*
+* Hash and size of every file written into the dumper-folder, persisted as 'FileManifest.txt' in that folder.
+*
+* With Settings::Generator::bSkipUnchangedFiles the folder of the previous run is reused instead of being moved to "_OLD". Files whose contents
+* match the previous manifest aren't written again and keep their modification-time, so builds of the SDK only recompile what actually changed.
+* Files listed in the previous manifest that weren't generated again are removed by Save().
+*/
+class FileManifest
+{
+private:
+	struct FileEntry
+	{
+		uint64 Hash = 0x0;
+		uint64 Size = 0x0;
+	};
+
+public:
+	static constexpr const char* ManifestFileName = "FileManifest.txt";
+
+private:
+	static inline std::filesystem::path RootFolder;
+
+	/* Keys are paths relative to 'RootFolder', in generic utf8 form */
+	static inline std::unordered_map<std::string, FileEntry> PreviousFiles;
+	static inline std::unordered_map<std::string, FileEntry> CurrentFiles;
+
+	static inline std::mutex ManifestLock;
+
+	static inline bool bHasPreviousManifest = false;
+
+private:
+	static std::string GetRelativePath(const std::filesystem::path& FilePath);
+
+public:
+	/* Starts recording files written into 'Folder' and reads the manifest of the previous run. Returns false if there is none, the folder can't be reused then. */
+	static bool Load(const std::filesystem::path& Folder);
+
+	/* Records the file in the new manifest. Returns true if the file on disk already has these exact contents. Thread-safe. */
+	static bool AddFile(const std::filesystem::path& FilePath, const void* Data, uint64 Size);
+
+	/* Carries the entry of a file that isn't written in this run over from the previous manifest. Returns false if the file wasn't part of the previous run. */
+	static bool KeepFile(const std::filesystem::path& FilePath);
+
+	/* Writes the new manifest and removes files of the previous run that weren't generated again */
+	static void Save();
+
+public:
+	static inline bool HasPreviousManifest()
+	{
+		return bHasPreviousManifest;
+	}
+};
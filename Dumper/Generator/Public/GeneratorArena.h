@@ -0,0 +1,114 @@
+#pragma once
+
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "MemoryBudget.h"
+
+/*
+* Monotonic arena for short-lived allocations made while generating a package (member-lists, accumulated in-header code, etc.).
+*
+* A PackageScope makes a fresh monotonic_buffer_resource the current resource of the calling thread until the scope is destroyed.
+* Everything allocated through GetResource() while the scope is active is released at once when it ends, instead of being freed one by one.
+* The blocks backing a scope are returned to a per-thread pool, so following scopes on the same thread reuse them without touching the heap.
+* With a MemoryBudget the blocks go back to the heap instead, a pool would keep the largest package of every thread resident until the end.
+* They are accounted as transient memory of the budget while the scope holds them.
+*
+* Outside of any scope GetResource() returns the default resource, so code using the arena stays valid when called outside of generation.
+* Memory carved from a scope must not outlive it. Containers that might be stored beyond the package must be copied into default-allocated ones.
+*/
+class GeneratorArena
+{
+public:
+	using String = std::pmr::string;
+
+	template<typename T>
+	using Vector = std::pmr::vector<T>;
+
+public:
+	class PackageScope;
+
+private:
+	/* Size of the first block of every scope, most packages fit into it entirely */
+	static constexpr size_t InitialBlockSize = 0x40000;
+
+private:
+	static inline thread_local std::pmr::memory_resource* CurrentResource = nullptr;
+
+private:
+	/* Heap-blocks accounted in the MemoryBudget, stateless and shared by all threads */
+	class BudgetedUpstreamResource final : public std::pmr::memory_resource
+	{
+	private:
+		void* do_allocate(size_t Bytes, size_t Alignment) override
+		{
+			void* Block = std::pmr::new_delete_resource()->allocate(Bytes, Alignment);
+			MemoryBudget::Acquire(Bytes);
+
+			return Block;
+		}
+
+		void do_deallocate(void* Block, size_t Bytes, size_t Alignment) override
+		{
+			std::pmr::new_delete_resource()->deallocate(Block, Bytes, Alignment);
+			MemoryBudget::Release(Bytes);
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& Other) const noexcept override
+		{
+			return this == &Other;
+		}
+	};
+
+private:
+	static inline std::pmr::memory_resource* GetBudgetedUpstream()
+	{
+		static BudgetedUpstreamResource Upstream;
+
+		return &Upstream;
+	}
+
+	static inline std::pmr::memory_resource* GetThreadPool()
+	{
+		static thread_local std::pmr::unsynchronized_pool_resource ThreadPool(std::pmr::pool_options{ .max_blocks_per_chunk = 0x0, .largest_required_pool_block = InitialBlockSize * 0x10 });
+
+		return &ThreadPool;
+	}
+
+public:
+	static inline std::pmr::memory_resource* GetResource()
+	{
+		return CurrentResource ? CurrentResource : std::pmr::get_default_resource();
+	}
+
+	static inline bool IsInScope()
+	{
+		return CurrentResource != nullptr;
+	}
+};
+
+class GeneratorArena::PackageScope
+{
+private:
+	std::pmr::memory_resource* PreviousResource;
+
+	/* Nested scopes allocate their blocks from the enclosing scope, which releases them together with its own */
+	std::pmr::monotonic_buffer_resource Resource;
+
+public:
+	inline PackageScope()
+		: PreviousResource(CurrentResource)
+		, Resource(InitialBlockSize, PreviousResource ? PreviousResource : (MemoryBudget::IsEnabled() ? GetBudgetedUpstream() : GetThreadPool()))
+	{
+		CurrentResource = &Resource;
+	}
+
+	inline ~PackageScope()
+	{
+		CurrentResource = PreviousResource;
+	}
+
+	PackageScope(const PackageScope&) = delete;
+	PackageScope& operator=(const PackageScope&) = delete;
+};
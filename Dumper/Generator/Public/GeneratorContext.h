@@ -0,0 +1,61 @@
+#pragma once
+
+#include <string_view>
+
+#include "PredefinedMembers.h"
+
+/*
+* State of the generator running on the calling thread, for generators that run concurrently (see Settings::Generator::bRunGeneratorsConcurrently).
+*
+* State that used to be global while a generator ran, like the lookup for its predefined members, is set for the thread running the generator.
+* Tasks submitted to the WorkerPool carry the context of the thread that submitted them and run inside of it, so work of a generator that is
+* picked up by any worker, or by another generator helping out while it waits, still sees the state of the generator it belongs to.
+*
+* Outside of any scope there is no context and GetCurrent() returns nullptr.
+*/
+class GeneratorContext
+{
+public:
+	class Scope;
+
+public:
+	/* Used to report the progress of the generator */
+	std::string_view Name;
+
+	const PredefinedMemberLookupMapType* PredefinedMembers = nullptr;
+
+private:
+	static inline thread_local const GeneratorContext* Current = nullptr;
+
+public:
+	static inline const GeneratorContext* GetCurrent()
+	{
+		return Current;
+	}
+
+	static inline const PredefinedMemberLookupMapType* GetPredefinedMembers()
+	{
+		return Current ? Current->PredefinedMembers : nullptr;
+	}
+};
+
+class GeneratorContext::Scope
+{
+private:
+	const GeneratorContext* PreviousContext;
+
+public:
+	inline explicit Scope(const GeneratorContext* Context)
+		: PreviousContext(Current)
+	{
+		Current = Context;
+	}
+
+	inline ~Scope()
+	{
+		Current = PreviousContext;
+	}
+
+	Scope(const Scope&) = delete;
+	Scope& operator=(const Scope&) = delete;
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <filesystem>
+#include <functional>
 #include <fstream>
 
 #include "Managers/DependencyManager.h"
@@ -12,6 +13,9 @@
 #include "Managers/PackageManager.h"
 
 #include "HashStringTable.h"
+#include "TypeIR.h"
+#include "GeneratorArena.h"
+#include "BufferedFileStream.h"
 #include "Generator.h"
 
 namespace fs = std::filesystem;
@@ -65,11 +69,15 @@ private:
         PropertyFixup,
         SdkHpp,
 
+        PrecompiledHeader,
+        UnityBuild,
+        PackageHeader,
+
         DebugAssertions,
     };
 
 private:
-    using StreamType = std::ofstream;
+    using StreamType = BufferedFileStream;
 
 public:
     static inline PredefinedMemberLookupMapType PredefinedMembers;
@@ -83,28 +91,51 @@ public:
 private:
     static inline std::vector<PredefinedStruct> PredefinedStructs;
 
+    struct CachedTypeString
+    {
+        std::string Type;
+        bool bIsUnknownProperty = false;
+
+        /* False for types containing a struct of a cyclic package, their string depends on the package they are used in */
+        bool bIsValid = false;
+    };
+
+    /* Type-string of every TypeIR type-shape, built by InitTypeStringCache and read-only while packages are generated */
+    static inline std::vector<CachedTypeString> TypeStringCache;
+
 private:
-    static std::string MakeMemberString(const std::string& Type, const std::string& Name, std::string&& Comment);
-    static std::string MakeMemberStringWithoutName(const std::string& Type);
+    /* Append* functions format directly into the end of Out */
+    static void AppendMemberString(GeneratorArena::String& Out, std::string_view Type, std::string_view Name, std::string_view Comment);
+    static void AppendMemberStringWithoutName(GeneratorArena::String& Out, std::string_view Type);
 
-    static std::string GenerateBytePadding(const int32 Offset, const int32 PadSize, std::string&& Reason);
-    static std::string GenerateBitPadding(uint8 UnderlayingSizeBytes, const uint8 PrevBitPropertyEndBit, const int32 Offset, const int32 PadSize, std::string&& Reason);
+    static void AppendBytePadding(GeneratorArena::String& Out, const int32 Offset, const int32 PadSize, std::string_view Reason);
+    static void AppendBitPadding(GeneratorArena::String& Out, uint8 UnderlayingSizeBytes, const uint8 PrevBitPropertyEndBit, const int32 Offset, const int32 PadSize, std::string_view Reason);
 
-    static std::string GenerateMembers(const StructWrapper& Struct, const MemberManager& Members, int32 SuperSize, int32 SuperLastMemberEnd, int32 SuperAlign, int32 PackageIndex = -1);
+    static void GenerateMembers(GeneratorArena::String& OutMembers, const StructWrapper& Struct, const MemberManager& Members, int32 SuperSize, int32 SuperLastMemberEnd, int32 SuperAlign, int32 PackageIndex = -1);
     static FunctionInfo GenerateFunctionInfo(const FunctionWrapper& Func);
 
     // return: In-header function declarations and inline functions
-    static std::string GenerateSingleFunction(const FunctionWrapper& Func, const std::string& StructName, StreamType& FunctionFile, StreamType& ParamFile, StreamType& AssertionFile);
-    static std::string GenerateFunctions(const StructWrapper& Struct, const MemberManager& Members, const std::string& StructName, StreamType& FunctionFile, StreamType& ParamFile, StreamType& AssertionFile);
+    static GeneratorArena::String GenerateSingleFunction(const FunctionWrapper& Func, const std::string& StructName, StreamType& FunctionFile, StreamType& ParamFile, std::ostream& AssertionFile);
+    static GeneratorArena::String GenerateFunctions(const StructWrapper& Struct, const MemberManager& Members, const std::string& StructName, StreamType& FunctionFile, StreamType& ParamFile, std::ostream& AssertionFile);
 
-    static void GenerateStruct(const StructWrapper& Struct, StreamType& StructFile, StreamType& FunctionFile, StreamType& ParamFile, StreamType& AssertionFile, int32 PackageIndex = -1, const std::string& StructNameOverride = std::string());
+    static void GenerateStruct(const StructWrapper& Struct, StreamType& StructFile, StreamType& FunctionFile, StreamType& ParamFile, std::ostream& AssertionFile, int32 PackageIndex = -1, const std::string& StructNameOverride = std::string());
 
     static void GenerateEnum(const EnumWrapper& Enum, StreamType& StructFile);
 
 private: /* utility functions */
     static std::string GetMemberTypeString(const PropertyWrapper& MemberWrapper, int32 PackageIndex = -1, bool bAllowForConstPtrMembers = false /* const USomeClass* Member; */);
     static std::string GetMemberTypeString(UEProperty Member, int32 PackageIndex = -1, bool bAllowForConstPtrMembers = false);
+    static std::string GetMemberTypeString(const TypeIR::PropertyNode& Member, int32 PackageIndex = -1, bool bAllowForConstPtrMembers = false);
     static std::string GetMemberTypeStringWithoutConst(UEProperty Member, int32 PackageIndex = -1, bool* bOutIsUnknownProperty = nullptr);
+    static std::string GetMemberTypeStringWithoutConst(const TypeIR::PropertyNode& Member, int32 PackageIndex = -1, bool* bOutIsUnknownProperty = nullptr);
+
+    /* Uncached, inner-types are still looked up in TypeStringCache */
+    static std::string BuildMemberTypeStringWithoutConst(const TypeIR::PropertyNode& Member, int32 PackageIndex, bool* bOutIsUnknownProperty);
+
+    /* Builds the strings of all type-shapes in order, every shape is built after the shapes of its inner-properties */
+    static void InitTypeStringCache();
+
+    static MemoryReport GetTypeStringCacheMemoryReport();
 
     static std::string GetFunctionSignature(UEFunction Func);
 
@@ -128,8 +159,19 @@ private:
     static void WriteFileHead(StreamType& File, PackageInfoHandle Package, EFileType Type, const std::string& CustomFileComment = "", const std::string& CustomIncludes = "");
     static void WriteFileEnd(StreamType& File, EFileType Type);
 
+    /* Keeps the files of an unchanged package from the previous run, see Settings::CppGenerator::bSkipUnchangedPackages. Returns false if any of them is missing. */
+    static bool TryReusePackage(PackageInfoHandle Package, const std::u8string& U8FileName, const fs::path& CacheFolder, std::string* OutAssertions);
+
+    /* Calls GeneratePackage for every slot of 'Packages' in dependency-ordered waves that fit into the MemoryBudget, see MemoryBudget.h */
+    static void GeneratePackagesInWaves(const std::vector<PackageInfoHandle>& Packages, const std::function<void(int32 PackageSlot)>& GeneratePackage);
+
     static void GenerateSDKHeader(StreamType& SdkHpp);
 
+    /* Optional files to reduce the compile-time of the SDK, see Settings::CppGenerator::bGeneratePrecompiledHeader, NumPackagesPerUnityFile and bGeneratePackageHeaders */
+    static void GeneratePrecompiledHeader(StreamType& PchHpp);
+    static void GenerateUnityFiles();
+    static void GeneratePackageHeader(StreamType& PackageHeader, PackageInfoHandle Package);
+
     static void GenerateBasicFiles(StreamType& BasicH, StreamType& BasicCpp, StreamType& AssertionsFile);
 
     /*
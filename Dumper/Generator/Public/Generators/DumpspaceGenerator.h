@@ -1,5 +1,7 @@
 #pragma once
 
+#include <optional>
+
 #include "Unreal/ObjectArray.h"
 
 #include "Managers/StructManager.h"
@@ -11,6 +13,8 @@
 
 #include "Dumpspace/DSGen.h"
 
+#include "BufferedFileStream.h"
+
 
 class DumpspaceGenerator
 {
@@ -19,7 +23,7 @@ private:
     friend class Generator;
 
 private:
-    using StreamType = std::ofstream;
+    using StreamType = BufferedFileStream;
 
 public:
     static inline PredefinedMemberLookupMapType PredefinedMembers;
@@ -30,6 +34,10 @@ public:
     static inline fs::path MainFolder;
     static inline fs::path Subfolder;
 
+private:
+    /* MemberType of every TypeIR type-shape, filled as they are first used. 'reference' is set per use. */
+    static inline std::vector<std::optional<DSGen::MemberType>> MemberTypeCache;
+
 private:
     static std::string GetStructPrefixedName(const StructWrapper& Struct);
     static std::string GetEnumPrefixedName(const EnumWrapper& Enum);
@@ -39,10 +47,10 @@ private:
 
 private:
     static DSGen::EType GetMemberEType(const PropertyWrapper& Property);
-    static DSGen::EType GetMemberEType(UEProperty Property);
-    static std::string GetMemberTypeStr(UEProperty Property, std::string& OutExtendedType, std::vector<DSGen::MemberType>& OutSubtypes);
+    static DSGen::EType GetMemberEType(const TypeIR::PropertyNode& Property);
+    static std::string GetMemberTypeStr(const TypeIR::PropertyNode& Property, std::string& OutExtendedType, std::vector<DSGen::MemberType>& OutSubtypes);
     static DSGen::MemberType GetMemberType(const StructWrapper& Struct);
-    static DSGen::MemberType GetMemberType(UEProperty Property, bool bIsReference = false);
+    static DSGen::MemberType GetMemberType(const TypeIR::PropertyNode& Property, bool bIsReference = false);
     static DSGen::MemberType GetMemberType(const PropertyWrapper& Property, bool bIsReference = false);
     static DSGen::MemberType ManualCreateMemberType(DSGen::EType Type, const std::string& TypeName, const std::string& ExtendedType = "");
     static void AddMemberToStruct(DSGen::ClassHolder& Struct, const PropertyWrapper& Property);
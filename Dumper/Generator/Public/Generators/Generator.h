@@ -1,11 +1,20 @@
 #pragma once
 
 #include <filesystem>
+#include <iostream>
+#include <format>
+#include <future>
+#include <chrono>
+#include <vector>
 
 #include "Unreal/ObjectArray.h"
 #include "Managers/DependencyManager.h"
 #include "Managers/MemberManager.h"
 #include "HashStringTable.h"
+#include "BufferedFileStream.h"
+#include "GeneratorContext.h"
+#include "Profiler.h"
+#include "MemoryBudget.h"
 
 
 namespace fs = std::filesystem;
@@ -41,45 +50,224 @@ private:
 
 private:
     static inline fs::path DumperFolder;
+
+    /* Parent of DumperFolder, see SetGenerationRoot */
+    static inline fs::path GenerationRoot = Settings::Generator::SDKGenerationPath;
     static inline bool bDumpedGObjects = false;
 
+    /* Only valid if the GObjects-dumps are written in the background, see Settings::Generator::bDumpObjectsInBackground */
+    static inline std::future<void> GObjectsDumpTask;
+
+    /* Deletion of old dump-folders, running at background priority while the SDK is generated */
+    static inline std::vector<std::future<void>> FolderDeletionTasks;
+
+    /* Part of the name of folders that are being deleted, leftovers of runs that were closed early are deleted by the next run */
+    static constexpr const char* TombstoneMarker = "_DELETING_";
+
+    template<GeneratorImplementation GeneratorType>
+    static inline GeneratorContext Context;
+
+    static constexpr const char* MemorySnapshotExtension = ".d7snap";
+
+    /* Address and class of every GObjects-slot when InitInternal last ran, HasNewTypes compares them to find slots that were reused */
+    struct ProcessedObject
+    {
+        const void* Address;
+        const void* Class;
+
+        /* Only set for structs, classes and enums, -1 for any other object */
+        int32 PackageIndex;
+        int32 NameIndex;
+    };
+
+    static inline std::vector<ProcessedObject> ProcessedObjects;
+
 public:
     static void InitEngineCore();
     static void InitInternal();
 
+    /* Drops everything built by InitInternal, so it can run again. No generator may be running. */
+    static void ResetInternal();
+
+    /*
+    * Whether a struct, class or enum was added to GObjects since the last InitInternal, in a new slot or in the slot of a garbage-collected object.
+    * Reads all of GObjects, comparing the address and class of every slot. The packages and names of types that were added, replaced or removed are
+    * handed to PackageFingerprints, the next regeneration only re-analyzes those packages. See Regenerate.
+    */
+    static bool HasNewTypes();
+
+    /* Writes a MemorySnapshot of the game into the generation-root, named like the dump-folder. Requires InitEngineCore and the game-name. */
+    static bool CaptureMemorySnapshot();
+
+    /* Maps a snapshot written by CaptureMemorySnapshot into this process, InitEngineCore afterwards initializes from it and never calls game-code */
+    static bool LoadMemorySnapshot(const fs::path& FilePath);
+
+    /*
+    * Reads the memory of the running game 'ProcessId' instead of this process, see ProcessMemory::AttachExternal. InitEngineCore afterwards never calls game-code.
+    * Nothing of the game can be scanned from out here, GObjects and GNames are taken from the Dumper-7-Offsets.ini entry of an earlier run inside of the game.
+    */
+    static bool AttachToProcess(uint32 ProcessId);
+
+    /* Creates dump-folders in 'Folder' instead of Settings::Generator::SDKGenerationPath, must be called before the first generator runs */
+    static inline void SetGenerationRoot(const fs::path& Folder)
+    {
+        GenerationRoot = Folder;
+    }
+
 private:
     static bool SetupDumperFolder();
 
     static bool SetupFolders(std::string& FolderName, fs::path& OutFolder);
     static bool SetupFolders(std::string& FolderName, fs::path& OutFolder, std::string& SubfolderName, fs::path& OutSubFolder);
 
+    static void DumpGObjects();
+
+    /* Stores the address and class of every object, and the package and name of every type, in ProcessedObjects. See HasNewTypes */
+    static void RecordProcessedObjects();
+
+    /* Waits for the previous dump to finish and resets all state, the next generator sets up the dump-folder and dumps GObjects again */
+    static void PrepareRegeneration();
+
+    static void DeleteTombstone(const fs::path& Tombstone);
+
+    /* Renames 'Folder' to a unique tombstone-name and deletes it on a background thread */
+    static void DeleteInBackground(const fs::path& Folder);
+    static void DeleteLeftoverTombstones(const fs::path& Folder);
+
+    /* Moves 'Folder' out of the way, keeping the last Settings::Generator::NumOldDumpsToKeep versions as "_OLD", "_OLD2", ... */
+    static void RetireFolder(const fs::path& Folder);
+
 public:
+    /* Folder of the current dump, empty until the first generator set it up */
+    static inline const fs::path& GetDumperFolder()
+    {
+        return DumperFolder;
+    }
+
+    /* Blocks until all generation-tasks running in the background (eg. the GObjects-dumps) have finished, then saves the FileManifest if it is used */
+    static void WaitForBackgroundTasks();
+
+private:
+    /* Creates the folders of the generator and initializes its predefined members. Touches shared state, never runs concurrently with other generators. */
     template<GeneratorImplementation GeneratorType>
-    static void Generate() 
+    static bool PrepareGenerator()
     { 
         if (DumperFolder.empty())
         {
             if (!SetupDumperFolder())
-                return;
+                return false;
 
             if (!bDumpedGObjects)
             {
                 bDumpedGObjects = true;
-                ObjectArray::DumpObjects(DumperFolder);
 
-                if (Settings::Internal::bUseFProperty)
-                    ObjectArray::DumpObjectsWithProperties(DumperFolder);
+                if constexpr (Settings::Generator::bDumpObjectsInBackground)
+                {
+                    GObjectsDumpTask = std::async(std::launch::async, &Generator::DumpGObjects);
+                }
+                else
+                {
+                    DumpGObjects();
+                }
             }
         }
 
         if (!SetupFolders(GeneratorType::MainFolderName, GeneratorType::MainFolder, GeneratorType::SubfolderName, GeneratorType::Subfolder))
-            return;
+            return false;
+
+        /* Members of a previous generation, see Regenerate */
+        GeneratorType::PredefinedMembers.clear();
 
         GeneratorType::InitPredefinedMembers();
         GeneratorType::InitPredefinedFunctions();
 
-        MemberManager::SetPredefinedMemberLookupPtr(&GeneratorType::PredefinedMembers);
+        Context<GeneratorType>.Name = GeneratorType::MainFolderName;
+        Context<GeneratorType>.PredefinedMembers = &GeneratorType::PredefinedMembers;
+
+        return true;
+    }
+
+    template<GeneratorImplementation GeneratorType>
+    static void RunGenerator()
+    {
+        GeneratorContext::Scope ContextScope(&Context<GeneratorType>);
+        Profiler::Scope GeneratorScope(Context<GeneratorType>.Name);
+
+        const auto StartTime = std::chrono::high_resolution_clock::now();
 
         GeneratorType::Generate();
+
+        const std::chrono::duration<double, std::milli> Duration = std::chrono::high_resolution_clock::now() - StartTime;
+
+        std::cerr << std::format("{} finished generating ({:.0f}ms)\n", Context<GeneratorType>.Name, Duration.count());
+    }
+
+public:
+    template<GeneratorImplementation GeneratorType>
+    static void Generate() 
+    { 
+        if (!PrepareGenerator<GeneratorType>())
+            return;
+
+        RunGenerator<GeneratorType>();
+
+        /* Files of this generator might still be written in the background, see Settings::Generator::bWriteFilesInBackground */
+        BufferedFileStream::WaitForPendingWrites();
     };
+
+    /* Runs the generators one after another, or all at once with Settings::Generator::bRunGeneratorsConcurrently and no MemoryBudget */
+    template<GeneratorImplementation... GeneratorTypes>
+    static void GenerateAll()
+    {
+        if (!Settings::Generator::bRunGeneratorsConcurrently || MemoryBudget::IsEnabled())
+        {
+            (Generate<GeneratorTypes>(), ...);
+            return;
+        }
+
+        /* Folders are set up in order, only the generation itself runs concurrently */
+        const bool bIsPrepared[] = { PrepareGenerator<GeneratorTypes>()... };
+
+        std::vector<std::future<void>> GeneratorTasks;
+        int32 GeneratorIndex = 0x0;
+
+        auto LaunchGenerator = [&]<typename GeneratorType>() -> void
+        {
+            if (bIsPrepared[GeneratorIndex++])
+                GeneratorTasks.push_back(std::async(std::launch::async, &Generator::RunGenerator<GeneratorType>));
+        };
+
+        (LaunchGenerator.template operator()<GeneratorTypes>(), ...);
+
+        /* Rethrows exceptions of the generators on this thread, like running them one after another would */
+        for (std::future<void>& Task : GeneratorTasks)
+            Task.get();
+
+        BufferedFileStream::WaitForPendingWrites();
+    }
+
+    /*
+    * Rebuilds all managers from the current state of GObjects and runs the generators again, into the same dump-folder.
+    * 
+    * With Settings::Generator::bSkipUnchangedFiles the folder of the previous dump is reused and only files whose contents changed are written, with
+    * Settings::CppGenerator::bSkipUnchangedPackages packages whose fingerprint didn't change aren't generated again. Otherwise it's a full dump.
+    * WatchMode always does both.
+    *
+    * After HasNewTypes only the packages with changed types, every package including them, and packages declaring types of the same names are
+    * fingerprinted and generated again. Every other package keeps its fingerprint and files from the previous run.
+    * The managers themselves are still rebuilt from scratch: unique names, member-name collisions and package cycles are resolved across all packages,
+    * and the mappings and the Dumpspace-files always cover the whole game.
+    */
+    template<GeneratorImplementation... GeneratorTypes>
+    static void Regenerate()
+    {
+        Profiler::Scope RegenerateScope("Generator::Regenerate");
+
+        PrepareRegeneration();
+        InitInternal();
+
+        GenerateAll<GeneratorTypes...>();
+
+        WaitForBackgroundTasks();
+    }
 };
@@ -2,9 +2,11 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "Unreal/ObjectArray.h"
 #include "PredefinedMembers.h"
+#include "BufferedFileStream.h"
 
 
 class IDAMappingGenerator
@@ -19,7 +21,62 @@ public:
     static inline fs::path Subfolder;
 
 private:
-    using StreamType = std::ofstream;
+    using StreamType = BufferedFileStream;
+
+private:
+    /*
+    * Name of one identifier, split into a prefix shared by all identifiers of a class ("_ZN10UMyClass" or "UMyClass") and its own suffix.
+    * Prefixes are interned in the shard, suffixes are stored back to back in the shard's suffix-buffer.
+    */
+    struct IdmapEntry
+    {
+        uint32 Offset;
+        int32 PrefixIndex;
+        uint32 SuffixOffset;
+        uint16 SuffixLength;
+        bool bIsFunction;
+    };
+
+    /* Identifiers of a range of GObjects, in the order of the objects they were generated from */
+    struct IdmapShard
+    {
+        std::vector<IdmapEntry> Entries;
+        std::vector<std::string> Prefixes;
+        std::string Suffixes;
+
+    public:
+        int32 AddPrefix(std::string&& Prefix);
+        void AddEntry(uint32 Offset, int32 PrefixIndex, std::string_view Suffix, bool bIsFunction);
+    };
+
+    /* Header of the '.idmap.idx' file, see WriteReadMe for the full layout */
+    struct IndexHeader
+    {
+        uint32 Magic;
+        uint32 Version;
+        uint32 NumEntries;
+        uint32 NumPrefixes;
+        uint32 StringsSize;
+    };
+
+    struct IndexPrefix
+    {
+        uint32 StringOffset;
+        uint16 Length;
+        uint16 Padding;
+    };
+
+    struct IndexEntry
+    {
+        uint32 Offset;
+        uint32 PrefixIndex;
+        uint32 SuffixOffset;
+        uint16 SuffixLength;
+        uint16 Padding;
+    };
+
+    static constexpr uint32 IndexFileMagic = 0x58444937; // "7IDX"
+    static constexpr uint32 IndexFileVersion = 0x1;
 
 private:
     template<typename InStreamType, typename T>
@@ -35,13 +92,17 @@ private:
     }
 
 private:
-    static std::string MangleFunctionName(const std::string& ClassName, const std::string& FunctionName);
+    /* MangleClassPrefix(ClassName) + MangleFunctionSuffix(FunctionName) is the mangled name of 'ClassName::execFunctionName()' */
+    static std::string MangleClassPrefix(const std::string& ClassName);
+    static std::string MangleFunctionSuffix(std::string_view FunctionName);
 
 private:
     static void WriteReadMe(StreamType& ReadMe);
 
-    static void GenerateVTableName(StreamType& IdmapFile, UEObject DefaultObject);
-    static void GenerateClassFunctions(StreamType& IdmapFile, UEClass Class);
+    static void GenerateVTableName(IdmapShard& Shard, UEObject DefaultObject);
+    static void GenerateClassFunctions(IdmapShard& Shard, UEClass Class);
+
+    static void GenerateShard(IdmapShard& Shard, int32 StartIndex, int32 EndIndex);
 
 public:
     static void Generate();
@@ -1,11 +1,17 @@
 #pragma once
 
-#include <fstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <unordered_map>
 
 #include "Unreal/ObjectArray.h"
 #include "Wrappers/MemberWrappers.h"
 #include "Wrappers/EnumWrapper.h"
 
+#include "BufferedFileStream.h"
+
 
 /*
 * USMAP-Header:
@@ -63,7 +69,7 @@
 class MappingGenerator
 {
 private:
-    using StreamType = std::ofstream;
+    using StreamType = BufferedFileStream;
 
 private:
     enum class EUsmapVersion : uint8
@@ -87,12 +93,65 @@ private:
         LatestPlusOne,
     };
 
+    /*
+    * Serialized enums or structs of one package. Names are referenced by their CompIdx, or by their index into the buffer's own name-list, so
+    * packages can be serialized in parallel. MergeNames() replaces those with indices into the name-table of the file.
+    */
+    struct MappingBuffer
+    {
+        struct NameReference
+        {
+            /* Offset into Data at which the int32 CompIdx, or index into Names, was written */
+            uint32 Offset;
+
+            /* Invalid if the reference is an index into Names */
+            FName Name;
+        };
+
+        std::vector<uint8> Data;
+
+        std::vector<std::string> Names;
+        std::unordered_map<std::string, int32> NameIndices;
+
+        std::vector<NameReference> NameReferences;
+
+        uint32 NumEntries = 0x0;
+
+    public:
+        template<typename T>
+        inline void Write(T Value)
+        {
+            WriteToBuffer(Data, Value);
+        }
+
+        void WriteName(const std::string& Name);
+        void WriteName(FName Name);
+
+        inline void WriteName(UEObject Object)
+        {
+            if (!Object)
+                return WriteName(std::string("None"));
+
+            WriteName(Object.GetFName());
+        }
+    };
+
 private:
     static constexpr uint16 UsmapFileMagic = 0x30C4;
 
 private:
     static inline uint64 NameCounter = 0x0;
 
+    /* Number of name-slots per page of NameSlotPages, pages are allocated when a CompIdx inside of them is first added */
+    static constexpr int32 NameSlotPageBits = 12;
+    static constexpr int32 NameSlotPageSize = 1 << NameSlotPageBits;
+
+    /* Only used with Settings::MappingGenerator::bShouldCheckForDuplicatedNames */
+    static inline std::unordered_map<std::string, int32> NameIndices;
+
+    /* CompIdx -> (index into the name-table + 1), 0 if the name wasn't added yet. A string is only hashed the first time its CompIdx occurs. */
+    static inline std::vector<std::unique_ptr<int32[]>> NameSlotPages;
+
 public:
     static inline PredefinedMemberLookupMapType PredefinedMembers;
 
@@ -109,26 +168,35 @@ private:
         InStream.write(reinterpret_cast<const char*>(&Value), sizeof(T));
     }
 
-    template<typename InStreamType>
-    static void WriteToStream(InStreamType& InStream, const std::stringstream& Data)
+    template<typename T>
+    static void WriteToBuffer(std::vector<uint8>& Buffer, T Value)
     {
-        InStream << Data.rdbuf();
+        const size_t OldSize = Buffer.size();
+
+        Buffer.resize(OldSize + sizeof(T));
+        memcpy(Buffer.data() + OldSize, &Value, sizeof(T));
     }
 
 private:
     /* Utility Functions */
-    static EMappingsTypeFlags GetMappingType(UEProperty Property);
-    static int32 AddNameToData(std::stringstream& NameTable, const std::string& Name);
+    static EMappingsTypeFlags GetMappingType(const TypeIR::PropertyNode& Property);
+    static int32 AddNameToData(std::vector<uint8>& NameTable, const std::string& Name);
+    static int32 AddNameToData(std::vector<uint8>& NameTable, FName Name, int32 CompIdx);
+
+    static void MergeNames(MappingBuffer& Buffer, std::vector<uint8>& NameTable);
+
+    static bool CompressZStandard(const std::vector<std::vector<uint8>>& Payload, uint64 UncompressedSize, std::vector<uint8>& OutCompressed);
 
 private:
-    static void GeneratePropertyType(UEProperty Property, std::stringstream& Data, std::stringstream& NameTable);
-    static void GeneratePropertyInfo(const PropertyWrapper& Property, std::stringstream& Data, std::stringstream& NameTable, int32& Index);
+    static void GeneratePropertyType(const TypeIR::PropertyNode* Property, MappingBuffer& Buffer);
+    static void GeneratePropertyInfo(const PropertyWrapper& Property, MappingBuffer& Buffer, int32& Index);
 
-    static void GenerateStruct(const StructWrapper& Struct, std::stringstream& Data, std::stringstream& NameTable);
-    static void GenerateEnum(const EnumWrapper& Enum, std::stringstream& Data, std::stringstream& NameTable);
+    static void GenerateStruct(const StructWrapper& Struct, MappingBuffer& Buffer);
+    static void GenerateEnum(const EnumWrapper& Enum, MappingBuffer& Buffer);
 
-    static std::stringstream GenerateFileData();
-    static void GenerateFileHeader(StreamType& InUsmap, const std::stringstream& Data);
+    /* Payload of the file as chunks in the order they're written, so it never has to be copied into one contiguous buffer */
+    static std::vector<std::vector<uint8>> GenerateFileData();
+    static void GenerateFileHeader(StreamType& InUsmap, const std::vector<std::vector<uint8>>& Payload);
 
 public:
     static void Generate();
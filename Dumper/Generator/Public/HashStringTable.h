@@ -3,35 +3,26 @@
 #include <cassert>
 #include <format>
 #include <iostream>
+#include <mutex>
 
 #include "Unreal/Enums.h"
+#include "MemoryReport.h"
 
 
 #define WINDOWS_IGNORE_PACKING_MISMATCH
 
-inline constexpr uint32 NumHashBits = 5;
-inline constexpr uint32 MaxHashNumber = 1 << NumHashBits;
-inline constexpr uint32 HashMask = MaxHashNumber - 1;
-
-static constexpr uint8_t FiveBitPermutation[MaxHashNumber] = {
-    0x20, 0x1D, 0x08, 0x18, 0x06, 0x0F, 0x15, 0x19,
-    0x13, 0x1F, 0x17, 0x10, 0x14, 0x0C, 0x0E, 0x02,
-    0x16, 0x11, 0x12, 0x0A, 0x0B, 0x1E, 0x04, 0x07,
-    0x1B, 0x03, 0x0D, 0x1A, 0x1C, 0x01, 0x09, 0x05,
-};
-
-inline uint8 SmallPearsonHash(const char* StringToHash)
+/* 64-bit FNV-1a. The top 5 bits select the bucket, the lower bits are used for the in-bucket index. */
+inline uint64 StringHash64(const char* StringToHash, int32 Length)
 {
-    uint8 Hash = 0;
+    uint64 Hash = 0xCBF29CE484222325;
 
-    while (*StringToHash != '\0')
+    for (int32 i = 0; i < Length; i++)
     {
-        const uint8 MaskedDownChar = (*StringToHash - 'A') & HashMask;
-        Hash = FiveBitPermutation[Hash ^ MaskedDownChar];
-        StringToHash++;
+        Hash ^= static_cast<uint8>(StringToHash[i]);
+        Hash *= 0x100000001B3;
     }
 
-    return (Hash & HashMask);
+    return Hash;
 }
 
 /* Used to limit access to StringEntry::OptionalCollisionCount to authorized (friend) classes only */
@@ -69,7 +60,7 @@ private:
     // Length of object name
     uint16 Length : 11;
 
-    // PearsonHash reduced to 5 bits --- only computed if string was added when StringTable::CurrentMode == EDuplicationCheckingMode::Check
+    // Index of the bucket this entry is stored in, the top 5 bits of its 64-bit hash
     uint16 Hash : 5;
 
     // If this string uses char or wchar_t
@@ -169,19 +160,45 @@ private:
     /* Checked, Unchecked */
     static constexpr int64 NumSectionsPerBucket = 2;
 
+    static constexpr uint32 InitialNumIndexSlots = 0x400;
+
+    /* Marks an unused slot in a buckets index, no valid InBucketOffset has more than 26 bits */
+    static constexpr uint32 EmptySlotOffset = ~0u;
+
 private:
+    /* Open-addressing (linear probing) index over the packed entries of one bucket */
+    struct IndexSlot
+    {
+        // Upper 32 bits of the entries 64-bit hash, compared before the string itself
+        uint32 HashTag;
+        uint32 InBucketOffset;
+    };
+
     struct StringBucket
     {
         // One allocated block, split in two sections, checked and unchecked
         uint8* Data;
         uint32 Size;
         uint32 SizeMax;
+
+        IndexSlot* Slots;
+        uint32 NumSlots;
+        uint32 NumEntries;
     };
 
 private:
     StringBucket Buckets[NumBuckets];
 
+    /* One lock per bucket, FindOrAdd may be called from multiple threads at once as long as only different names contend for the same bucket rarely */
+    mutable std::mutex BucketLocks[NumBuckets];
+
 public:
+    /*
+    * FindOrAdd is thread-safe, insertions into one bucket only lock that bucket.
+    *
+    * HashStringTableIndex values never change once returned. References to StringEntries however may be invalidated while
+    * other threads still add strings to the table, resolve indices to entries only once all concurrent insertions are done.
+    */
     HashStringTable(uint32 InitialBucketSize = 0x5000);
     ~HashStringTable();
 
@@ -278,10 +295,15 @@ private:
     const StringEntry& GetStringEntry(const StringBucket& Bucket, int32 InBucketIndex) const;
     const StringEntry& GetStringEntry(int32 BucketIndex, int32 InBucketIndex) const;
 
-    void ResizeBucket(StringBucket& Bucket);
+    /* Grows the bucket by at least half of its size, and enough to fit 'RequiredSize' bytes */
+    void ResizeBucket(StringBucket& Bucket, uint32 RequiredSize);
+    void ResizeIndex(StringBucket& Bucket);
+    void RebuildIndex(StringBucket& Bucket, uint32 NewNumSlots);
+
+    void InsertIntoIndex(StringBucket& Bucket, uint64 FullHash, uint32 InBucketOffset);
 
     template<typename CharType>
-    std::pair<HashStringTableIndex, bool> AddUnchecked(const CharType* Str, int32 Length, uint8 Hash);
+    std::pair<HashStringTableIndex, bool> AddUnchecked(const CharType* Str, int32 Length, uint64 FullHash);
 
 public:
     const StringEntry& operator[](HashStringTableIndex Index) const;
@@ -290,8 +312,11 @@ public:
     const StringBucket& GetBucket(uint32 Index) const;
     const StringEntry& GetStringEntry(HashStringTableIndex Index) const;
 
+    static inline uint8 GetBucketIndex(uint64 FullHash) { return static_cast<uint8>(FullHash >> (64 - NumHashBits)); }
+
+    /* Does not lock the bucket, to be used by FindOrAdd or when no other thread is inserting */
     template<typename CharType>
-    HashStringTableIndex Find(const CharType* Str, int32 Length, uint8 Hash);
+    HashStringTableIndex Find(const CharType* Str, int32 Length, uint64 FullHash);
 
     template<typename CharType>
     std::pair<HashStringTableIndex, bool> FindOrAdd(const CharType* Str, int32 Length, bool bShouldMarkAsDuplicated = true);
@@ -301,6 +326,14 @@ public:
 
     int32 GetTotalUsedSize() const;
 
+    /* Not thread-safe. Shrinks every bucket and its index to the smallest size holding its entries, insertions afterwards grow them again. */
+    void Compact();
+
+    /* Not thread-safe. Removes all entries but keeps the memory of every bucket, all previously returned indices become invalid. */
+    void Clear();
+
+    MemoryReport GetMemoryReport() const;
+
 public:
     void DebugPrintStats() const;
 };
\ No newline at end of file
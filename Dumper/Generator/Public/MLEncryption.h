@@ -1,9 +1,24 @@
 #pragma once
 
-#include <cstdint>
+#include <span>
+#include <array>
 #include <string>
+#include <algorithm>
 #include <vector>
-#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__)
+#include <emmintrin.h>
+#define ML_ENCRYPTION_HAS_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define ML_ENCRYPTION_HAS_NEON 1
+#endif
 
 namespace ML
 {
@@ -48,6 +63,136 @@ namespace ML
 	class ModelEncryption
 	{
 	public:
+		/* Size of the blocks the keystream is applied in, byte 'i' of the stream is XORed with Key[i % 32] ^ IV[i % 16] */
+		static constexpr size_t BlockSize = 64;
+
+		/* Size of the chunks files are read in by DecryptFile */
+		static constexpr size_t FileChunkSize = 0x100000;
+
+		/**
+		 * Keystream of one block, starting at an arbitrary offset into the stream
+		 */
+		struct alignas(64) KeyBlock
+		{
+			uint8_t Bytes[BlockSize];
+
+			KeyBlock(const EncryptionKey& Key, uint64_t StreamOffset)
+			{
+				for (size_t i = 0; i < BlockSize; i++)
+				{
+					const uint64_t Pos = StreamOffset + i;
+					Bytes[i] = Key.Key[Pos % Key.Key.size()] ^ Key.IV[Pos % Key.IV.size()];
+				}
+			}
+		};
+
+		/**
+		 * Stateful decryptor for models that arrive in chunks, e.g. read from a file or a memory-mapped region
+		 * Chunks may have any size, the position in the keystream is carried over between calls
+		 */
+		class StreamCipher
+		{
+		private:
+			EncryptionKey Key;
+			uint64_t StreamOffset = 0;
+
+		public:
+			explicit StreamCipher(const EncryptionKey& InKey, uint64_t InStreamOffset = 0)
+				: Key(InKey), StreamOffset(InStreamOffset)
+			{
+			}
+
+			/**
+			 * XOR the next Size bytes of the stream from In into Out, In and Out may be the same buffer
+			 */
+			void Process(const uint8_t* In, uint8_t* Out, size_t Size)
+			{
+				ApplyKeystream(In, Out, Size, Key, StreamOffset);
+				StreamOffset += Size;
+			}
+
+			void ProcessInPlace(std::span<uint8_t> Data)
+			{
+				Process(Data.data(), Data.data(), Data.size());
+			}
+
+			uint64_t GetStreamOffset() const
+			{
+				return StreamOffset;
+			}
+		};
+
+	public:
+		/**
+		 * XOR Size bytes with the keystream, starting at StreamOffset bytes into the stream
+		 * Whole 64-byte blocks are processed with AVX2, SSE2 or NEON, the tail byte by byte. In and Out may be the same buffer.
+		 */
+		static void ApplyKeystream(const uint8_t* In, uint8_t* Out, size_t Size, const EncryptionKey& Key, uint64_t StreamOffset = 0)
+		{
+			/* The keystream repeats every 32 bytes, so one block starting at the right phase covers every block */
+			const KeyBlock Block(Key, StreamOffset);
+
+			size_t i = 0;
+
+#if defined(__AVX2__)
+			const __m256i Key0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(Block.Bytes));
+			const __m256i Key1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(Block.Bytes + 32));
+
+			for (; i + BlockSize <= Size; i += BlockSize)
+			{
+				const __m256i Data0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(In + i));
+				const __m256i Data1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(In + i + 32));
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(Out + i), _mm256_xor_si256(Data0, Key0));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(Out + i + 32), _mm256_xor_si256(Data1, Key1));
+			}
+#elif defined(ML_ENCRYPTION_HAS_SSE2)
+			__m128i Keys[4];
+
+			for (int j = 0; j < 4; j++)
+				Keys[j] = _mm_load_si128(reinterpret_cast<const __m128i*>(Block.Bytes + j * 16));
+
+			for (; i + BlockSize <= Size; i += BlockSize)
+			{
+				for (int j = 0; j < 4; j++)
+				{
+					const __m128i Data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(In + i + j * 16));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(Out + i + j * 16), _mm_xor_si128(Data, Keys[j]));
+				}
+			}
+#elif defined(ML_ENCRYPTION_HAS_NEON)
+			uint8x16_t Keys[4];
+
+			for (int j = 0; j < 4; j++)
+				Keys[j] = vld1q_u8(Block.Bytes + j * 16);
+
+			for (; i + BlockSize <= Size; i += BlockSize)
+			{
+				for (int j = 0; j < 4; j++)
+					vst1q_u8(Out + i + j * 16, veorq_u8(vld1q_u8(In + i + j * 16), Keys[j]));
+			}
+#else
+			uint64_t Keys[BlockSize / sizeof(uint64_t)];
+			std::memcpy(Keys, Block.Bytes, BlockSize);
+
+			for (; i + BlockSize <= Size; i += BlockSize)
+			{
+				uint64_t Data[BlockSize / sizeof(uint64_t)];
+				std::memcpy(Data, In + i, BlockSize);
+
+				for (size_t j = 0; j < BlockSize / sizeof(uint64_t); j++)
+					Data[j] ^= Keys[j];
+
+				std::memcpy(Out + i, Data, BlockSize);
+			}
+#endif
+			/* 'i' is a multiple of BlockSize here, the tail starts at the same phase as the block */
+			for (; i < Size; i++)
+			{
+				Out[i] = In[i] ^ Block.Bytes[i % BlockSize];
+			}
+		}
+
 		/**
 		 * Encrypt model data using XOR encryption
 		 * @param Data - Raw model data to encrypt
@@ -60,13 +205,7 @@ namespace ML
 			Result.OriginalSize = static_cast<uint32_t>(Data.size());
 			Result.EncryptedData.resize(Data.size());
 
-			// XOR encryption with key
-			for (size_t i = 0; i < Data.size(); ++i)
-			{
-				uint8_t KeyByte = Key.Key[i % Key.Key.size()];
-				uint8_t IVByte = Key.IV[i % Key.IV.size()];
-				Result.EncryptedData[i] = Data[i] ^ KeyByte ^ IVByte;
-			}
+			ApplyKeystream(Data.data(), Result.EncryptedData.data(), Data.size(), Key);
 
 			Result.EncryptedSize = static_cast<uint32_t>(Result.EncryptedData.size());
 			return Result;
@@ -83,14 +222,59 @@ namespace ML
 			std::vector<uint8_t> Result(EncryptedData.OriginalSize);
 
 			// XOR decryption (same operation as encryption)
-			for (size_t i = 0; i < EncryptedData.EncryptedData.size() && i < Result.size(); ++i)
+			ApplyKeystream(EncryptedData.EncryptedData.data(), Result.data(), std::min(EncryptedData.EncryptedData.size(), Result.size()), Key);
+
+			return Result;
+		}
+
+		/**
+		 * Decrypt model data in place, without a second buffer
+		 * @param Data - Encrypted data, decrypted on return
+		 * @param Key - Decryption key (same as encryption key)
+		 */
+		static void DecryptInPlace(std::span<uint8_t> Data, const EncryptionKey& Key)
+		{
+			ApplyKeystream(Data.data(), Data.data(), Data.size(), Key);
+		}
+
+		/**
+		 * Decrypt an encrypted model from a file, reading and decrypting it chunk by chunk into a single buffer
+		 * @param FilePath - File containing only the encrypted model bytes
+		 * @param Key - Decryption key (same as encryption key)
+		 * @param OutData - Receives the decrypted model
+		 * @return False if the file couldn't be read
+		 */
+		static bool DecryptFile(const std::filesystem::path& FilePath, const EncryptionKey& Key, std::vector<uint8_t>& OutData)
+		{
+			std::ifstream File(FilePath, std::ios::binary);
+
+			std::error_code Error;
+			const uintmax_t FileSize = std::filesystem::file_size(FilePath, Error);
+
+			if (!File.is_open() || Error)
 			{
-				uint8_t KeyByte = Key.Key[i % Key.Key.size()];
-				uint8_t IVByte = Key.IV[i % Key.IV.size()];
-				Result[i] = EncryptedData.EncryptedData[i] ^ KeyByte ^ IVByte;
+				return false;
 			}
 
-			return Result;
+			OutData.resize(static_cast<size_t>(FileSize));
+
+			StreamCipher Cipher(Key);
+
+			for (size_t Pos = 0; Pos < OutData.size(); Pos += FileChunkSize)
+			{
+				const size_t ChunkSize = std::min(FileChunkSize, OutData.size() - Pos);
+
+				if (!File.read(reinterpret_cast<char*>(OutData.data() + Pos), ChunkSize))
+				{
+					OutData.clear();
+					return false;
+				}
+
+				/* Decrypted while the chunk is still in cache */
+				Cipher.ProcessInPlace(std::span<uint8_t>(OutData.data() + Pos, ChunkSize));
+			}
+
+			return true;
 		}
 
 		/**
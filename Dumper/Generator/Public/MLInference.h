@@ -1,13 +1,69 @@
 #pragma once
 
+#include <span>
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <memory>
+#include <cmath>
+#include <mutex>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
 #include <functional>
 #include "MLEncryption.h"
+#include "MLModelBundle.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define ML_HAS_NEON 1
+#endif
 
 namespace ML
 {
+	/**
+	 * Non-owning view of float tensor data, e.g. a float-member of an array of SDK structs read straight from game memory
+	 * Stride is the distance between two elements in bytes, sizeof(float) if the elements are contiguous
+	 */
+	struct TensorView
+	{
+		float* Data = nullptr;
+		std::span<const uint32_t> Shape;
+		size_t Stride = sizeof(float);
+
+		TensorView() = default;
+
+		TensorView(float* InData, std::span<const uint32_t> InShape, size_t InStride = sizeof(float))
+			: Data(InData), Shape(InShape), Stride(InStride)
+		{
+		}
+
+		uint32_t GetTotalSize() const
+		{
+			uint32_t Size = 1;
+			for (uint32_t Dim : Shape)
+			{
+				Size *= Dim;
+			}
+			return Size;
+		}
+
+		bool IsContiguous() const
+		{
+			return Stride == sizeof(float);
+		}
+
+		float& operator[](uint32_t Index) const
+		{
+			return *reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(Data) + Index * Stride);
+		}
+	};
+
 	/**
 	 * ML model input/output data structure
 	 */
@@ -19,80 +75,1001 @@ namespace ML
 
 		TensorData() = default;
 
-		TensorData(const std::vector<float>& InData, const std::vector<uint32_t>& InShape, const std::string& InName = "")
-			: Data(InData), Shape(InShape), Name(InName)
+		TensorData(const std::vector<float>& InData, const std::vector<uint32_t>& InShape, const std::string& InName = "")
+			: Data(InData), Shape(InShape), Name(InName)
+		{
+		}
+
+		uint32_t GetTotalSize() const
+		{
+			uint32_t Size = 1;
+			for (uint32_t Dim : Shape)
+			{
+				Size *= Dim;
+			}
+			return Size;
+		}
+
+		/**
+		 * View of this tensor, valid until Data or Shape are resized
+		 */
+		TensorView GetView()
+		{
+			return TensorView(Data.data(), Shape);
+		}
+	};
+
+	/**
+	 * Kernels on tensor views
+	 * Contiguous views use AVX2 or NEON if the SDK is compiled for it, strided views and the remaining elements run scalar
+	 * The elementwise kernels compute the same result as their scalar loop, no fused multiply-add is used
+	 * Dot sums the vector lanes separately, so Dot and the dense layers built on it can differ from a scalar build in the last bits
+	 */
+	namespace Kernels
+	{
+		/**
+		 * Value = (Value - Sub) / Div
+		 */
+		inline void SubtractDivide(const TensorView& Tensor, float Sub, float Div)
+		{
+			const uint32_t Num = Tensor.GetTotalSize();
+			uint32_t i = 0;
+
+			if (Tensor.IsContiguous())
+			{
+				float* Data = Tensor.Data;
+#if defined(__AVX2__)
+				const __m256 SubVec = _mm256_set1_ps(Sub);
+				const __m256 DivVec = _mm256_set1_ps(Div);
+
+				for (; i + 8 <= Num; i += 8)
+					_mm256_storeu_ps(Data + i, _mm256_div_ps(_mm256_sub_ps(_mm256_loadu_ps(Data + i), SubVec), DivVec));
+#elif defined(ML_HAS_NEON)
+				const float32x4_t SubVec = vdupq_n_f32(Sub);
+				const float32x4_t DivVec = vdupq_n_f32(Div);
+
+				for (; i + 4 <= Num; i += 4)
+					vst1q_f32(Data + i, vdivq_f32(vsubq_f32(vld1q_f32(Data + i), SubVec), DivVec));
+#endif
+				for (; i < Num; i++)
+					Data[i] = (Data[i] - Sub) / Div;
+
+				return;
+			}
+
+			for (; i < Num; i++)
+				Tensor[i] = (Tensor[i] - Sub) / Div;
+		}
+
+		/**
+		 * Value = Value * Mul + Add
+		 */
+		inline void MultiplyAdd(const TensorView& Tensor, float Mul, float Add)
+		{
+			const uint32_t Num = Tensor.GetTotalSize();
+			uint32_t i = 0;
+
+			if (Tensor.IsContiguous())
+			{
+				float* Data = Tensor.Data;
+#if defined(__AVX2__)
+				const __m256 MulVec = _mm256_set1_ps(Mul);
+				const __m256 AddVec = _mm256_set1_ps(Add);
+
+				for (; i + 8 <= Num; i += 8)
+					_mm256_storeu_ps(Data + i, _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(Data + i), MulVec), AddVec));
+#elif defined(ML_HAS_NEON)
+				const float32x4_t MulVec = vdupq_n_f32(Mul);
+				const float32x4_t AddVec = vdupq_n_f32(Add);
+
+				for (; i + 4 <= Num; i += 4)
+					vst1q_f32(Data + i, vaddq_f32(vmulq_f32(vld1q_f32(Data + i), MulVec), AddVec));
+#endif
+				for (; i < Num; i++)
+					Data[i] = Data[i] * Mul + Add;
+
+				return;
+			}
+
+			for (; i < Num; i++)
+				Tensor[i] = Tensor[i] * Mul + Add;
+		}
+
+		/**
+		 * Value = Value * Factor
+		 */
+		inline void Scale(const TensorView& Tensor, float Factor)
+		{
+			const uint32_t Num = Tensor.GetTotalSize();
+			uint32_t i = 0;
+
+			if (Tensor.IsContiguous())
+			{
+				float* Data = Tensor.Data;
+#if defined(__AVX2__)
+				const __m256 FactorVec = _mm256_set1_ps(Factor);
+
+				for (; i + 8 <= Num; i += 8)
+					_mm256_storeu_ps(Data + i, _mm256_mul_ps(_mm256_loadu_ps(Data + i), FactorVec));
+#elif defined(ML_HAS_NEON)
+				const float32x4_t FactorVec = vdupq_n_f32(Factor);
+
+				for (; i + 4 <= Num; i += 4)
+					vst1q_f32(Data + i, vmulq_f32(vld1q_f32(Data + i), FactorVec));
+#endif
+				for (; i < Num; i++)
+					Data[i] = Data[i] * Factor;
+
+				return;
+			}
+
+			for (; i < Num; i++)
+				Tensor[i] = Tensor[i] * Factor;
+		}
+
+		/**
+		 * Out = Left + Right, Out may alias either input. All views need the same number of elements.
+		 */
+		inline void Add(const TensorView& Out, const TensorView& Left, const TensorView& Right)
+		{
+			const uint32_t Num = Out.GetTotalSize();
+			uint32_t i = 0;
+
+			if (Out.IsContiguous() && Left.IsContiguous() && Right.IsContiguous())
+			{
+#if defined(__AVX2__)
+				for (; i + 8 <= Num; i += 8)
+					_mm256_storeu_ps(Out.Data + i, _mm256_add_ps(_mm256_loadu_ps(Left.Data + i), _mm256_loadu_ps(Right.Data + i)));
+#elif defined(ML_HAS_NEON)
+				for (; i + 4 <= Num; i += 4)
+					vst1q_f32(Out.Data + i, vaddq_f32(vld1q_f32(Left.Data + i), vld1q_f32(Right.Data + i)));
+#endif
+			}
+
+			for (; i < Num; i++)
+				Out[i] = Left[i] + Right[i];
+		}
+
+		/**
+		 * Out = Left * Right, Out may alias either input. All views need the same number of elements.
+		 */
+		inline void Multiply(const TensorView& Out, const TensorView& Left, const TensorView& Right)
+		{
+			const uint32_t Num = Out.GetTotalSize();
+			uint32_t i = 0;
+
+			if (Out.IsContiguous() && Left.IsContiguous() && Right.IsContiguous())
+			{
+#if defined(__AVX2__)
+				for (; i + 8 <= Num; i += 8)
+					_mm256_storeu_ps(Out.Data + i, _mm256_mul_ps(_mm256_loadu_ps(Left.Data + i), _mm256_loadu_ps(Right.Data + i)));
+#elif defined(ML_HAS_NEON)
+				for (; i + 4 <= Num; i += 4)
+					vst1q_f32(Out.Data + i, vmulq_f32(vld1q_f32(Left.Data + i), vld1q_f32(Right.Data + i)));
+#endif
+			}
+
+			for (; i < Num; i++)
+				Out[i] = Left[i] * Right[i];
+		}
+
+		/**
+		 * Sum of Left[i] * Right[i] over two contiguous arrays
+		 * The SIMD paths add up 8 or 4 partial sums, the order of the float additions differs from the scalar loop
+		 */
+		inline float Dot(const float* Left, const float* Right, uint32_t Num)
+		{
+			uint32_t i = 0;
+			float Sum = 0.0f;
+#if defined(__AVX2__)
+			__m256 SumVec = _mm256_setzero_ps();
+
+			for (; i + 8 <= Num; i += 8)
+				SumVec = _mm256_add_ps(SumVec, _mm256_mul_ps(_mm256_loadu_ps(Left + i), _mm256_loadu_ps(Right + i)));
+
+			alignas(32) float Lanes[8];
+			_mm256_store_ps(Lanes, SumVec);
+
+			for (float Lane : Lanes)
+				Sum += Lane;
+#elif defined(ML_HAS_NEON)
+			float32x4_t SumVec = vdupq_n_f32(0.0f);
+
+			for (; i + 4 <= Num; i += 4)
+				SumVec = vaddq_f32(SumVec, vmulq_f32(vld1q_f32(Left + i), vld1q_f32(Right + i)));
+
+			Sum = vaddvq_f32(SumVec);
+#endif
+			for (; i < Num; i++)
+				Sum += Left[i] * Right[i];
+
+			return Sum;
+		}
+
+		/**
+		 * Out = In, for gathering strided game memory into a contiguous tensor
+		 */
+		inline void Copy(const TensorView& Out, const TensorView& In)
+		{
+			const uint32_t Num = Out.GetTotalSize();
+
+			if (Out.IsContiguous() && In.IsContiguous())
+			{
+				std::copy(In.Data, In.Data + Num, Out.Data);
+				return;
+			}
+
+			for (uint32_t i = 0; i < Num; i++)
+				Out[i] = In[i];
+		}
+	}
+
+	/**
+	 * ML model metadata
+	 */
+	struct ModelMetadata
+	{
+		std::string ModelName;
+		std::string ModelVersion;
+		std::string Framework; // "ONNX", "TensorFlow", etc.
+		std::vector<std::string> InputNames;
+		std::vector<std::string> OutputNames;
+
+		// Shape of one input/output, taken from the backend when left empty
+		std::vector<uint32_t> InputShape;
+		std::vector<uint32_t> OutputShape;
+
+		// Number of inputs the runtime preallocates tensors and scratch-memory for
+		uint32_t MaxBatchSize = 1;
+	};
+
+	/**
+	 * Preallocated input and output tensors for batches of up to 'Capacity' inputs of fixed shapes
+	 * Storage only grows in Reserve, views stay valid until the next Reserve
+	 */
+	class TensorArena
+	{
+	private:
+		std::vector<float> Storage;
+		std::vector<TensorView> InputViews;
+		std::vector<TensorView> OutputViews;
+
+		std::vector<uint32_t> InputShape;
+		std::vector<uint32_t> OutputShape;
+
+	public:
+		void Reserve(const std::vector<uint32_t>& InInputShape, const std::vector<uint32_t>& InOutputShape, uint32_t Capacity)
+		{
+			InputShape = InInputShape;
+			OutputShape = InOutputShape;
+
+			const size_t InputSize = TensorView(nullptr, InputShape).GetTotalSize();
+			const size_t OutputSize = TensorView(nullptr, OutputShape).GetTotalSize();
+
+			Storage.assign((InputSize + OutputSize) * Capacity, 0.0f);
+
+			InputViews.clear();
+			OutputViews.clear();
+			InputViews.reserve(Capacity);
+			OutputViews.reserve(Capacity);
+
+			/* Inputs first, so a whole batch of inputs is one contiguous block */
+			for (uint32_t i = 0; i < Capacity; i++)
+			{
+				InputViews.emplace_back(Storage.data() + i * InputSize, InputShape);
+				OutputViews.emplace_back(Storage.data() + Capacity * InputSize + i * OutputSize, OutputShape);
+			}
+		}
+
+		void Release()
+		{
+			Storage = std::vector<float>();
+			InputViews = std::vector<TensorView>();
+			OutputViews = std::vector<TensorView>();
+		}
+
+		uint32_t GetCapacity() const
+		{
+			return static_cast<uint32_t>(InputViews.size());
+		}
+
+		std::span<const TensorView> GetInputs(uint32_t BatchSize) const
+		{
+			return std::span<const TensorView>(InputViews).first(std::min(BatchSize, GetCapacity()));
+		}
+
+		std::span<const TensorView> GetOutputs(uint32_t BatchSize) const
+		{
+			return std::span<const TensorView>(OutputViews).first(std::min(BatchSize, GetCapacity()));
+		}
+	};
+
+	/**
+	 * Engine running a decrypted model, e.g. a wrapper around ONNX Runtime or the built-in MLPBackend
+	 * A backend is only used by one EncryptedModelRuntime, RunBatch is not called concurrently
+	 */
+	class InferenceBackend
+	{
+	public:
+		virtual ~InferenceBackend() = default;
+
+		/**
+		 * Parse the decrypted model
+		 * @param Model - Decrypted model data, only valid during this call
+		 * @param Metadata - Metadata of the model, non-empty shapes must match the model
+		 * @return True if the backend can run this model
+		 */
+		virtual bool Load(std::span<const uint8_t> Model, const ModelMetadata& Metadata) = 0;
+
+		/**
+		 * Run the model once for every input
+		 * @param Inputs - One view per input, each with GetInputSize() elements
+		 * @param Outputs - One view per input, each with GetOutputSize() elements
+		 * @return False if the batch couldn't be run
+		 */
+		virtual bool RunBatch(std::span<const TensorView> Inputs, std::span<const TensorView> Outputs) = 0;
+
+		virtual void Unload() = 0;
+
+		/**
+		 * Preallocate scratch-memory for batches of up to MaxBatchSize inputs, so RunBatch doesn't allocate
+		 */
+		virtual void Reserve([[maybe_unused]] uint32_t MaxBatchSize)
+		{
+		}
+
+		/**
+		 * Number of elements of one input/output, 0 if the backend accepts any size
+		 */
+		virtual uint32_t GetInputSize() const = 0;
+		virtual uint32_t GetOutputSize() const = 0;
+
+		/**
+		 * Number of threads a batch may be split across, 0 uses all hardware threads
+		 */
+		virtual void SetNumThreads(uint32_t NumThreads) = 0;
+	};
+
+	/**
+	 * Built-in backend for fully-connected networks
+	 *
+	 * Model layout, little-endian:
+	 *   uint32 Magic;     // 'MLP1' (0x31504C4D)
+	 *   uint32 NumLayers;
+	 *   Layers[NumLayers]:
+	 *     uint32 InSize;  // Equal to OutSize of the previous layer
+	 *     uint32 OutSize;
+	 *     uint32 Activation; // EActivation
+	 *     float Weights[OutSize][InSize];
+	 *     float Bias[OutSize];
+	 *
+	 * A batch is evaluated as one matrix of inputs per layer, rows of the batch are split across the threads
+	 */
+	class MLPBackend : public InferenceBackend
+	{
+	public:
+		enum class EActivation : uint32_t
+		{
+			None = 0,
+			ReLU = 1,
+			Sigmoid = 2,
+			Tanh = 3,
+		};
+
+		static constexpr uint32_t ModelMagic = 0x31504C4D;
+
+	private:
+		struct Layer
+		{
+			uint32_t InSize;
+			uint32_t OutSize;
+			EActivation Activation;
+			std::vector<float> Weights;
+			std::vector<float> Bias;
+		};
+
+		/* Batches with fewer rows per thread aren't worth starting a thread for */
+		static constexpr uint32_t MinRowsPerThread = 0x10;
+
+	private:
+		std::vector<Layer> Layers;
+		uint32_t MaxLayerSize = 0;
+		uint32_t NumThreads = 1;
+
+		/* Ping-pong buffers of [BatchSize][MaxLayerSize] activations, kept between batches */
+		std::vector<float> Activations[2];
+
+		/* Threads kept alive between batches, worker 'i' runs part 'i + 1' of a batch, the calling thread runs part 0 */
+		std::vector<std::thread> Workers;
+		std::mutex WorkerMutex;
+		std::condition_variable WorkAvailable;
+		std::condition_variable WorkDone;
+		uint64_t BatchGeneration = 0;
+		uint32_t NumPendingWorkers = 0;
+		uint32_t NumActiveParts = 0;
+		uint32_t BatchRows = 0;
+		uint32_t RowsPerPart = 0;
+		bool bStopWorkers = false;
+
+	private:
+		static float Activate(EActivation Activation, float Value)
+		{
+			switch (Activation)
+			{
+			case EActivation::ReLU:
+				return Value > 0.0f ? Value : 0.0f;
+			case EActivation::Sigmoid:
+				return 1.0f / (1.0f + std::exp(-Value));
+			case EActivation::Tanh:
+				return std::tanh(Value);
+			default:
+				return Value;
+			}
+		}
+
+		void RunRows(uint32_t FirstRow, uint32_t EndRow)
+		{
+			for (size_t LayerIdx = 0; LayerIdx < Layers.size(); LayerIdx++)
+			{
+				const Layer& Current = Layers[LayerIdx];
+
+				const float* In = Activations[LayerIdx % 2].data();
+				float* Out = Activations[(LayerIdx + 1) % 2].data();
+
+				for (uint32_t Row = FirstRow; Row < EndRow; Row++)
+				{
+					const float* InRow = In + static_cast<size_t>(Row) * MaxLayerSize;
+					float* OutRow = Out + static_cast<size_t>(Row) * MaxLayerSize;
+
+					for (uint32_t o = 0; o < Current.OutSize; o++)
+					{
+						const float Sum = Current.Bias[o] + Kernels::Dot(Current.Weights.data() + static_cast<size_t>(o) * Current.InSize, InRow, Current.InSize);
+
+						OutRow[o] = Activate(Current.Activation, Sum);
+					}
+				}
+			}
+		}
+
+		/* StartGeneration is the generation of the last batch before the worker was started, it only runs batches after it */
+		void WorkerLoop(uint32_t Part, uint64_t StartGeneration)
+		{
+			uint64_t SeenGeneration = StartGeneration;
+
+			while (true)
+			{
+				uint32_t FirstRow = 0;
+				uint32_t EndRow = 0;
+
+				{
+					std::unique_lock Lock(WorkerMutex);
+					WorkAvailable.wait(Lock, [&]() { return bStopWorkers || BatchGeneration != SeenGeneration; });
+
+					if (bStopWorkers)
+						return;
+
+					SeenGeneration = BatchGeneration;
+
+					if (Part < NumActiveParts)
+					{
+						FirstRow = std::min(Part * RowsPerPart, BatchRows);
+						EndRow = std::min(FirstRow + RowsPerPart, BatchRows);
+					}
+				}
+
+				RunRows(FirstRow, EndRow);
+
+				std::scoped_lock Lock(WorkerMutex);
+
+				if (--NumPendingWorkers == 0)
+					WorkDone.notify_one();
+			}
+		}
+
+		void StopWorkers()
+		{
+			{
+				std::scoped_lock Lock(WorkerMutex);
+				bStopWorkers = true;
+			}
+
+			WorkAvailable.notify_all();
+
+			for (std::thread& Worker : Workers)
+				Worker.join();
+
+			Workers.clear();
+			bStopWorkers = false;
+		}
+
+		uint32_t GetNumParts(uint32_t BatchSize) const
+		{
+			const uint32_t MaxParts = std::max(BatchSize / MinRowsPerThread, 1u);
+
+			return std::min(NumThreads == 0 ? std::max(std::thread::hardware_concurrency(), 1u) : NumThreads, MaxParts);
+		}
+
+	public:
+		~MLPBackend() override
+		{
+			StopWorkers();
+		}
+
+		bool Load(std::span<const uint8_t> Model, const ModelMetadata& Metadata) override
+		{
+			Unload();
+
+			size_t Pos = 0;
+
+			auto Read = [&](void* Out, size_t Size) -> bool
+			{
+				if (Model.size() - Pos < Size)
+					return false;
+
+				std::memcpy(Out, Model.data() + Pos, Size);
+				Pos += Size;
+				return true;
+			};
+
+			uint32_t Magic = 0;
+			uint32_t NumLayers = 0;
+
+			if (!Read(&Magic, sizeof(Magic)) || Magic != ModelMagic || !Read(&NumLayers, sizeof(NumLayers)) || NumLayers == 0)
+			{
+				return false;
+			}
+
+			for (uint32_t i = 0; i < NumLayers; i++)
+			{
+				Layer& NewLayer = Layers.emplace_back();
+
+				uint32_t Activation = 0;
+
+				if (!Read(&NewLayer.InSize, sizeof(uint32_t)) || !Read(&NewLayer.OutSize, sizeof(uint32_t)) || !Read(&Activation, sizeof(uint32_t)))
+				{
+					Unload();
+					return false;
+				}
+
+				const bool bIsChained = i == 0 || Layers[i - 1].OutSize == NewLayer.InSize;
+				const size_t NumWeights = static_cast<size_t>(NewLayer.InSize) * NewLayer.OutSize;
+
+				if (!bIsChained || NewLayer.InSize == 0 || NewLayer.OutSize == 0 || NumWeights > (Model.size() - Pos) / sizeof(float))
+				{
+					Unload();
+					return false;
+				}
+
+				NewLayer.Activation = static_cast<EActivation>(Activation);
+				NewLayer.Weights.resize(NumWeights);
+				NewLayer.Bias.resize(NewLayer.OutSize);
+
+				if (!Read(NewLayer.Weights.data(), NumWeights * sizeof(float)) || !Read(NewLayer.Bias.data(), NewLayer.OutSize * sizeof(float)))
+				{
+					Unload();
+					return false;
+				}
+
+				MaxLayerSize = std::max({ MaxLayerSize, NewLayer.InSize, NewLayer.OutSize });
+			}
+
+			/* Shapes given in the metadata must describe the parsed layers, empty shapes are taken from the model by the runtime */
+			const bool bInputShapeMatches = Metadata.InputShape.empty() || TensorView(nullptr, Metadata.InputShape).GetTotalSize() == Layers.front().InSize;
+			const bool bOutputShapeMatches = Metadata.OutputShape.empty() || TensorView(nullptr, Metadata.OutputShape).GetTotalSize() == Layers.back().OutSize;
+
+			if (!bInputShapeMatches || !bOutputShapeMatches)
+			{
+				Unload();
+				return false;
+			}
+
+			return true;
+		}
+
+		bool RunBatch(std::span<const TensorView> Inputs, std::span<const TensorView> Outputs) override
+		{
+			if (Layers.empty() || Inputs.size() != Outputs.size())
+			{
+				return false;
+			}
+
+			const uint32_t BatchSize = static_cast<uint32_t>(Inputs.size());
+			const uint32_t InputSize = GetInputSize();
+			const uint32_t OutputSize = GetOutputSize();
+
+			for (uint32_t i = 0; i < BatchSize; i++)
+			{
+				if (Inputs[i].GetTotalSize() != InputSize || Outputs[i].GetTotalSize() != OutputSize)
+				{
+					return false;
+				}
+			}
+
+			const size_t RequiredSize = static_cast<size_t>(BatchSize) * MaxLayerSize;
+
+			for (std::vector<float>& Buffer : Activations)
+			{
+				if (Buffer.size() < RequiredSize)
+					Buffer.resize(RequiredSize);
+			}
+
+			/* Gather inputs, which may be strided views into game memory, into rows of the first matrix */
+			for (uint32_t i = 0; i < BatchSize; i++)
+			{
+				const uint32_t Shape[] = { InputSize };
+				Kernels::Copy(TensorView(Activations[0].data() + static_cast<size_t>(i) * MaxLayerSize, Shape), Inputs[i]);
+			}
+
+			const uint32_t NumParts = GetNumParts(BatchSize);
+
+			if (NumParts <= 1)
+			{
+				RunRows(0, BatchSize);
+			}
+			else
+			{
+				/* Rows are independent, every part runs all layers for its own range of the batch */
+				for (uint32_t Part = static_cast<uint32_t>(Workers.size()) + 1; Part < NumParts; Part++)
+					Workers.emplace_back(&MLPBackend::WorkerLoop, this, Part, BatchGeneration);
+
+				const uint32_t NumRowsPerPart = (BatchSize + NumParts - 1) / NumParts;
+
+				{
+					std::scoped_lock Lock(WorkerMutex);
+					NumActiveParts = NumParts;
+					BatchRows = BatchSize;
+					RowsPerPart = NumRowsPerPart;
+					NumPendingWorkers = static_cast<uint32_t>(Workers.size());
+					BatchGeneration++;
+				}
+
+				WorkAvailable.notify_all();
+
+				RunRows(0, std::min(NumRowsPerPart, BatchSize));
+
+				std::unique_lock Lock(WorkerMutex);
+				WorkDone.wait(Lock, [this]() { return NumPendingWorkers == 0; });
+			}
+
+			const std::vector<float>& Result = Activations[Layers.size() % 2];
+
+			for (uint32_t i = 0; i < BatchSize; i++)
+			{
+				const uint32_t Shape[] = { OutputSize };
+				Kernels::Copy(Outputs[i], TensorView(const_cast<float*>(Result.data()) + static_cast<size_t>(i) * MaxLayerSize, Shape));
+			}
+
+			return true;
+		}
+
+		void Unload() override
+		{
+			Layers.clear();
+			MaxLayerSize = 0;
+
+			for (std::vector<float>& Buffer : Activations)
+			{
+				Buffer.clear();
+				Buffer.shrink_to_fit();
+			}
+		}
+
+		uint32_t GetInputSize() const override
+		{
+			return Layers.empty() ? 0 : Layers.front().InSize;
+		}
+
+		uint32_t GetOutputSize() const override
+		{
+			return Layers.empty() ? 0 : Layers.back().OutSize;
+		}
+
+		void Reserve(uint32_t MaxBatchSize) override
+		{
+			const size_t RequiredSize = static_cast<size_t>(MaxBatchSize) * MaxLayerSize;
+
+			for (std::vector<float>& Buffer : Activations)
+			{
+				if (Buffer.size() < RequiredSize)
+					Buffer.resize(RequiredSize);
+			}
+
+			/* Start the workers up front instead of on the first large batch */
+			for (uint32_t Part = static_cast<uint32_t>(Workers.size()) + 1; Part < GetNumParts(MaxBatchSize); Part++)
+				Workers.emplace_back(&MLPBackend::WorkerLoop, this, Part, BatchGeneration);
+		}
+
+		void SetNumThreads(uint32_t InNumThreads) override
+		{
+			/* Workers are restarted on demand, a smaller count must not keep the old ones alive */
+			if (InNumThreads != NumThreads)
+				StopWorkers();
+
+			NumThreads = InNumThreads;
+		}
+	};
+
+	/**
+	 * Encrypted ML model runtime
+	 * Handles secure model loading and inference
+	 */
+	class EncryptedModelRuntime
+	{
+	private:
+		EncryptionKey Key;
+		ModelMetadata Metadata;
+		std::unique_ptr<InferenceBackend> Backend;
+		TensorArena Arena;
+		uint32_t NumThreads;
+		bool bIsLoaded;
+
+	public:
+		EncryptedModelRuntime()
+			: NumThreads(1), bIsLoaded(false)
+		{
+		}
+
+		/**
+		 * Set the backend used for models loaded afterwards, MLPBackend is used if none was set
+		 */
+		void SetBackend(std::unique_ptr<InferenceBackend> NewBackend)
+		{
+			Unload();
+
+			Backend = std::move(NewBackend);
+
+			if (Backend)
+			{
+				Backend->SetNumThreads(NumThreads);
+			}
+		}
+
+		/**
+		 * Number of threads a batch may be split across, 0 uses all hardware threads
+		 */
+		void SetNumThreads(uint32_t InNumThreads)
+		{
+			NumThreads = InNumThreads;
+
+			if (Backend)
+			{
+				Backend->SetNumThreads(NumThreads);
+			}
+		}
+
+		/**
+		 * Hand a decrypted model to the backend, the decrypted bytes aren't kept afterwards
+		 */
+		bool LoadDecryptedModel(std::span<const uint8_t> DecryptedModel)
+		{
+			if (!Backend)
+			{
+				SetBackend(std::make_unique<MLPBackend>());
+			}
+
+			if (DecryptedModel.empty() || !Backend->Load(DecryptedModel, Metadata))
+			{
+				return false;
+			}
+
+			if (Metadata.InputShape.empty())
+			{
+				Metadata.InputShape = { Backend->GetInputSize() };
+			}
+
+			if (Metadata.OutputShape.empty())
+			{
+				Metadata.OutputShape = { Backend->GetOutputSize() };
+			}
+
+			bIsLoaded = true;
+
+			SetMaxBatchSize(Metadata.MaxBatchSize);
+			return true;
+		}
+
+		/**
+		 * Set the metadata of the model loaded next, shapes and MaxBatchSize decide what the runtime preallocates
+		 */
+		void SetMetadata(const ModelMetadata& NewMetadata)
+		{
+			Metadata = NewMetadata;
+		}
+
+		/**
+		 * Preallocate pooled tensors and backend scratch-memory for batches of up to MaxBatchSize inputs
+		 */
+		void SetMaxBatchSize(uint32_t MaxBatchSize)
+		{
+			Metadata.MaxBatchSize = std::max(MaxBatchSize, 1u);
+
+			if (!bIsLoaded)
+			{
+				return;
+			}
+
+			Arena.Reserve(Metadata.InputShape, Metadata.OutputShape, Metadata.MaxBatchSize);
+			Backend->Reserve(Metadata.MaxBatchSize);
+		}
+
+		/**
+		 * Load encrypted model from data
+		 * @param Model - Encrypted model data
+		 * @param DecryptionKey - Key to decrypt the model
+		 * @return True if model loaded successfully
+		 */
+		bool LoadModel(const EncryptedModelData& Model, const EncryptionKey& DecryptionKey)
+		{
+			if (!Security::VerifyModel(Model))
+			{
+				return false;
+			}
+
+			return LoadModel(std::span<const uint8_t>(Model.EncryptedData), Model.OriginalSize, DecryptionKey);
+		}
+
+		/**
+		 * Load encrypted model, decrypting it in place inside of Model's buffer
+		 * @param Model - Encrypted model data, holds the decrypted model on return
+		 * @param DecryptionKey - Key to decrypt the model
+		 * @return True if model loaded successfully
+		 */
+		bool LoadModel(EncryptedModelData&& Model, const EncryptionKey& DecryptionKey)
+		{
+			if (!Security::VerifyModel(Model) || Model.EncryptedData.size() != Model.OriginalSize)
+			{
+				return false;
+			}
+
+			Unload();
+			Key = DecryptionKey;
+
+			ModelEncryption::DecryptInPlace(Model.EncryptedData, Key);
+
+			return LoadDecryptedModel(Model.EncryptedData);
+		}
+
+		/**
+		 * Load encrypted model from memory that isn't owned by the runtime, e.g. a memory-mapped file
+		 * Decrypts chunk by chunk into a single buffer of OriginalSize bytes
+		 * @param EncryptedBytes - Encrypted model data
+		 * @param OriginalSize - Size of the decrypted model
+		 * @param DecryptionKey - Key to decrypt the model
+		 * @return True if model loaded successfully
+		 */
+		bool LoadModel(std::span<const uint8_t> EncryptedBytes, uint32_t OriginalSize, const EncryptionKey& DecryptionKey)
+		{
+			// Verify decryption
+			if (EncryptedBytes.size() != OriginalSize)
+			{
+				return false;
+			}
+
+			Unload();
+			Key = DecryptionKey;
+
+			std::vector<uint8_t> DecryptedModel(OriginalSize);
+			ModelEncryption::StreamCipher Cipher(Key);
+
+			for (size_t Pos = 0; Pos < DecryptedModel.size(); Pos += ModelEncryption::FileChunkSize)
+			{
+				const size_t ChunkSize = std::min(ModelEncryption::FileChunkSize, DecryptedModel.size() - Pos);
+				Cipher.Process(EncryptedBytes.data() + Pos, DecryptedModel.data() + Pos, ChunkSize);
+			}
+
+			return LoadDecryptedModel(DecryptedModel);
+		}
+
+		/**
+		 * Load a model from a section of a bundle, only that section is decrypted
+		 * The plaintext is evicted from the bundle's cache once the backend parsed it
+		 * @param Bundle - Opened bundle
+		 * @param SectionName - Section holding the model, the first EBundleSectionType::Model section if empty
+		 * @return True if model loaded successfully
+		 */
+		bool LoadModel(ModelBundle& Bundle, std::string_view SectionName = {})
+		{
+			const int32_t SectionIndex = SectionName.empty() ? Bundle.FindSection(EBundleSectionType::Model) : Bundle.FindSection(SectionName);
+
+			const ModelBundle::SectionDataType Section = Bundle.GetSection(SectionIndex);
+
+			if (!Section)
+			{
+				return false;
+			}
+
+			Unload();
+
+			const bool bLoaded = LoadDecryptedModel(*Section);
+			Bundle.Evict(SectionIndex);
+
+			return bLoaded;
+		}
+
+		/**
+		 * Load encrypted model from a file containing only the encrypted bytes
+		 * @param FilePath - Path of the encrypted model
+		 * @param DecryptionKey - Key to decrypt the model
+		 * @return True if model loaded successfully
+		 */
+		bool LoadModelFromFile(const std::filesystem::path& FilePath, const EncryptionKey& DecryptionKey)
+		{
+			Unload();
+			Key = DecryptionKey;
+
+			std::vector<uint8_t> DecryptedModel;
+
+			if (!ModelEncryption::DecryptFile(FilePath, Key, DecryptedModel))
+			{
+				return false;
+			}
+
+			return LoadDecryptedModel(DecryptedModel);
+		}
+
+		/**
+		 * Run inference into a caller-provided output
+		 * @param Input - Input tensor view, may point into game memory
+		 * @param Output - Output tensor view with GetOutputSize() elements
+		 * @return False if no model is loaded, or the sizes don't match the model
+		 */
+		bool RunInference(const TensorView& Input, const TensorView& Output)
 		{
+			return RunInference(std::span<const TensorView>(&Input, 1), std::span<const TensorView>(&Output, 1));
 		}
 
-		uint32_t GetTotalSize() const
+		/**
+		 * Run inference on a batch of inputs in one call, e.g. the features of every entity of a frame
+		 * @param Inputs - Input tensor views
+		 * @param Outputs - One output view per input
+		 * @return False if no model is loaded, or the sizes don't match the model
+		 */
+		bool RunInference(std::span<const TensorView> Inputs, std::span<const TensorView> Outputs)
 		{
-			uint32_t Size = 1;
-			for (uint32_t Dim : Shape)
+			if (!bIsLoaded || Inputs.size() != Outputs.size())
 			{
-				Size *= Dim;
+				return false;
 			}
-			return Size;
-		}
-	};
-
-	/**
-	 * ML model metadata
-	 */
-	struct ModelMetadata
-	{
-		std::string ModelName;
-		std::string ModelVersion;
-		std::string Framework; // "ONNX", "TensorFlow", etc.
-		std::vector<std::string> InputNames;
-		std::vector<std::string> OutputNames;
-	};
 
-	/**
-	 * Encrypted ML model runtime
-	 * Handles secure model loading and inference
-	 */
-	class EncryptedModelRuntime
-	{
-	private:
-		EncryptedModelData EncryptedModel;
-		std::vector<uint8_t> DecryptedModel;
-		EncryptionKey Key;
-		ModelMetadata Metadata;
-		bool bIsLoaded;
+			return Backend->RunBatch(Inputs, Outputs);
+		}
 
-	public:
-		EncryptedModelRuntime()
-			: bIsLoaded(false)
+		/**
+		 * Pooled input tensors of a batch, fill these and call RunPooledInference with the same BatchSize
+		 * BatchSize is limited to Metadata.MaxBatchSize
+		 */
+		std::span<const TensorView> GetPooledInputs(uint32_t BatchSize) const
 		{
+			return Arena.GetInputs(BatchSize);
 		}
 
 		/**
-		 * Load encrypted model from data
-		 * @param Model - Encrypted model data
-		 * @param DecryptionKey - Key to decrypt the model
-		 * @return True if model loaded successfully
+		 * Run inference on the pooled inputs, into pooled outputs owned by the runtime
+		 * @return Outputs of the batch, valid until the next call, empty on failure
 		 */
-		bool LoadModel(const EncryptedModelData& Model, const EncryptionKey& DecryptionKey)
+		std::span<const TensorView> RunPooledInference(uint32_t BatchSize)
 		{
-			if (!Security::VerifyModel(Model))
+			const std::span<const TensorView> Outputs = Arena.GetOutputs(BatchSize);
+
+			if (!RunInference(Arena.GetInputs(BatchSize), Outputs))
 			{
-				return false;
+				return {};
 			}
 
-			EncryptedModel = Model;
-			Key = DecryptionKey;
-
-			// Decrypt model data
-			DecryptedModel = ModelEncryption::Decrypt(EncryptedModel, Key);
+			return Outputs;
+		}
 
-			// Verify decryption
-			if (DecryptedModel.empty() || DecryptedModel.size() != EncryptedModel.OriginalSize)
-			{
-				return false;
-			}
+		/**
+		 * Number of elements of one input/output of the loaded model
+		 */
+		uint32_t GetInputSize() const
+		{
+			return bIsLoaded ? Backend->GetInputSize() : 0;
+		}
 
-			bIsLoaded = true;
-			return true;
+		uint32_t GetOutputSize() const
+		{
+			return bIsLoaded ? Backend->GetOutputSize() : 0;
 		}
 
 		/**
@@ -107,34 +1084,51 @@ namespace ML
 				return TensorData();
 			}
 
-			// Placeholder for actual inference logic
-			// In production, this would call into ML framework
 			TensorData Output;
 			Output.Name = "output";
-			Output.Shape = Input.Shape;
-			Output.Data = Input.Data;
+			Output.Shape = { GetOutputSize() };
+			Output.Data.resize(GetOutputSize());
 
-			// Simple transformation example
-			for (float& Value : Output.Data)
+			if (!RunInference(TensorView(const_cast<float*>(Input.Data.data()), Input.Shape), Output.GetView()))
 			{
-				Value = Value * 0.5f; // Example transformation
+				return TensorData();
 			}
 
 			return Output;
 		}
 
 		/**
-		 * Run inference with multiple inputs
+		 * Run inference with multiple inputs, as one batch
 		 * @param Inputs - Vector of input tensors
-		 * @return Vector of output tensors
+		 * @return Vector of output tensors, empty if the batch couldn't be run
 		 */
 		std::vector<TensorData> RunInference(const std::vector<TensorData>& Inputs)
 		{
-			std::vector<TensorData> Outputs;
-			
-			for (const auto& Input : Inputs)
+			if (!bIsLoaded)
+			{
+				return {};
+			}
+
+			std::vector<TensorData> Outputs(Inputs.size());
+			std::vector<TensorView> InputViews;
+			std::vector<TensorView> OutputViews;
+
+			InputViews.reserve(Inputs.size());
+			OutputViews.reserve(Inputs.size());
+
+			for (size_t i = 0; i < Inputs.size(); i++)
+			{
+				Outputs[i].Name = "output";
+				Outputs[i].Shape = { GetOutputSize() };
+				Outputs[i].Data.resize(GetOutputSize());
+
+				InputViews.emplace_back(const_cast<float*>(Inputs[i].Data.data()), Inputs[i].Shape);
+				OutputViews.push_back(Outputs[i].GetView());
+			}
+
+			if (!RunInference(InputViews, OutputViews))
 			{
-				Outputs.push_back(RunInference(Input));
+				return {};
 			}
 
 			return Outputs;
@@ -161,12 +1155,351 @@ namespace ML
 		 */
 		void Unload()
 		{
-			DecryptedModel.clear();
-			DecryptedModel.shrink_to_fit();
+			if (Backend)
+			{
+				Backend->Unload();
+			}
+
+			Arena.Release();
 			bIsLoaded = false;
 		}
 	};
 
+	/**
+	 * Counters of an AsyncInferenceQueue, a consistent snapshot is returned by AsyncInferenceQueue::GetStats
+	 */
+	struct InferenceQueueStats
+	{
+		uint64_t NumSubmitted = 0;
+		uint64_t NumCompleted = 0;
+		uint64_t NumFailed = 0;
+		uint64_t NumRejected = 0; // TrySubmit calls on a full queue
+		uint64_t NumBatches = 0;
+
+		// Time from submission until the callback was called
+		double TotalLatencyMs = 0.0;
+		double MaxLatencyMs = 0.0;
+
+		double GetAverageLatencyMs() const
+		{
+			return NumCompleted + NumFailed > 0 ? TotalLatencyMs / (NumCompleted + NumFailed) : 0.0;
+		}
+
+		double GetAverageBatchSize() const
+		{
+			return NumBatches > 0 ? static_cast<double>(NumCompleted + NumFailed) / NumBatches : 0.0;
+		}
+	};
+
+	/**
+	 * Settings of an AsyncInferenceQueue
+	 */
+	struct AsyncInferenceQueueConfig
+	{
+		// Number of submissions that can be pending at once
+		uint32_t Capacity = 1024;
+
+		// Largest batch run at once, the runtime's MaxBatchSize is raised to this
+		uint32_t MaxBatchSize = 256;
+
+		// How long the dispatcher waits for more submissions before running a batch that isn't full, 0 runs right away
+		std::chrono::microseconds BatchWindow = std::chrono::microseconds(0);
+	};
+
+	/**
+	 * Runs inference of an EncryptedModelRuntime on a dedicated thread, so hooks on the game thread only copy their inputs
+	 *
+	 * Submissions are stored in a bounded ring of preallocated slots. Submit blocks while the ring is full, TrySubmit fails instead.
+	 * The dispatcher coalesces everything that is pending, up to the runtime's MaxBatchSize, into one batch; the backend splits that
+	 * batch across its own threads. Callbacks are called on the dispatcher thread and receive an empty span if inference failed.
+	 *
+	 * The runtime must not be used by anyone else while the queue exists. A queue created for a runtime without a loaded model
+	 * is invalid and rejects every submission.
+	 */
+	class AsyncInferenceQueue
+	{
+	public:
+		using CallbackType = std::function<void(std::span<const float> Output)>;
+
+		using Config = AsyncInferenceQueueConfig;
+
+	private:
+		using ClockType = std::chrono::steady_clock;
+
+		struct Request
+		{
+			std::vector<float> Input;
+			CallbackType Callback;
+			ClockType::time_point SubmitTime;
+		};
+
+	private:
+		EncryptedModelRuntime& Runtime;
+		Config Settings;
+
+		uint32_t InputSize;
+
+		std::vector<Request> Slots;
+		uint32_t Head = 0;
+		uint32_t NumPending = 0;
+
+		/* Callbacks and submit-times of the batch being run, moved out of the slots so they can be reused right away */
+		std::vector<CallbackType> BatchCallbacks;
+		std::vector<ClockType::time_point> BatchSubmitTimes;
+
+		mutable std::mutex QueueMutex;
+		std::condition_variable RequestAvailable;
+		std::condition_variable SlotAvailable;
+		std::condition_variable QueueDrained;
+
+		InferenceQueueStats Stats;
+		bool bIsRunningBatch = false;
+		bool bStop = false;
+
+		std::thread Dispatcher;
+
+	private:
+		bool Enqueue(std::unique_lock<std::mutex>& Lock, std::span<const float> Input, CallbackType&& Callback)
+		{
+			Request& Slot = Slots[(Head + NumPending) % Settings.Capacity];
+
+			Slot.Input.assign(Input.begin(), Input.end());
+			Slot.Callback = std::move(Callback);
+			Slot.SubmitTime = ClockType::now();
+
+			NumPending++;
+			Stats.NumSubmitted++;
+
+			Lock.unlock();
+			RequestAvailable.notify_one();
+
+			return true;
+		}
+
+		void DispatchLoop()
+		{
+			std::unique_lock Lock(QueueMutex);
+
+			while (true)
+			{
+				RequestAvailable.wait(Lock, [this]() { return bStop || NumPending > 0; });
+
+				if (NumPending == 0 && bStop)
+					return;
+
+				/* Give the game thread a moment to submit the rest of the frame */
+				if (Settings.BatchWindow.count() > 0 && NumPending < Settings.MaxBatchSize && !bStop)
+					RequestAvailable.wait_for(Lock, Settings.BatchWindow, [this]() { return bStop || NumPending >= Settings.MaxBatchSize; });
+
+				/* The pool may hold fewer tensors than requested and the model may have been unloaded since the requests were queued */
+				const uint32_t CurrentInputSize = Runtime.IsLoaded() ? Runtime.GetInputSize() : 0;
+				const std::span<const TensorView> Inputs = Runtime.GetPooledInputs(std::min(NumPending, Settings.MaxBatchSize));
+
+				/* Nothing can be run, fail the whole head of the queue so submitters waiting on it are released */
+				const bool bCanRun = CurrentInputSize == InputSize && !Inputs.empty();
+				const uint32_t BatchSize = bCanRun ? static_cast<uint32_t>(Inputs.size()) : std::min(NumPending, Settings.MaxBatchSize);
+
+				BatchCallbacks.clear();
+				BatchSubmitTimes.clear();
+
+				for (uint32_t i = 0; i < BatchSize; i++)
+				{
+					Request& Slot = Slots[(Head + i) % Settings.Capacity];
+
+					if (bCanRun)
+						std::copy(Slot.Input.begin(), Slot.Input.end(), Inputs[i].Data);
+
+					BatchCallbacks.push_back(std::move(Slot.Callback));
+					BatchSubmitTimes.push_back(Slot.SubmitTime);
+				}
+
+				Head = (Head + BatchSize) % Settings.Capacity;
+				NumPending -= BatchSize;
+				bIsRunningBatch = true;
+
+				Lock.unlock();
+				SlotAvailable.notify_all();
+
+				const std::span<const TensorView> Outputs = bCanRun ? Runtime.RunPooledInference(BatchSize) : std::span<const TensorView>();
+				const bool bSucceeded = Outputs.size() >= BatchSize;
+
+				for (uint32_t i = 0; i < BatchSize; i++)
+				{
+					if (BatchCallbacks[i])
+						BatchCallbacks[i](bSucceeded ? std::span<const float>(Outputs[i].Data, Outputs[i].GetTotalSize()) : std::span<const float>());
+				}
+
+				const ClockType::time_point DoneTime = ClockType::now();
+
+				Lock.lock();
+
+				for (const ClockType::time_point& SubmitTime : BatchSubmitTimes)
+				{
+					const double LatencyMs = std::chrono::duration<double, std::milli>(DoneTime - SubmitTime).count();
+
+					Stats.TotalLatencyMs += LatencyMs;
+					Stats.MaxLatencyMs = std::max(Stats.MaxLatencyMs, LatencyMs);
+				}
+
+				(bSucceeded ? Stats.NumCompleted : Stats.NumFailed) += BatchSize;
+				Stats.NumBatches++;
+
+				bIsRunningBatch = false;
+
+				if (NumPending == 0)
+					QueueDrained.notify_all();
+			}
+		}
+
+	public:
+		AsyncInferenceQueue(EncryptedModelRuntime& InRuntime, const Config& InSettings = Config())
+			: Runtime(InRuntime), Settings(InSettings), InputSize(InRuntime.GetInputSize())
+		{
+			if (!Runtime.IsLoaded() || InputSize == 0)
+			{
+				bStop = true;
+				return;
+			}
+
+			Settings.Capacity = std::max(Settings.Capacity, 1u);
+			Settings.MaxBatchSize = std::max(Settings.MaxBatchSize, 1u);
+
+			if (Runtime.GetMetadata().MaxBatchSize < Settings.MaxBatchSize)
+			{
+				Runtime.SetMaxBatchSize(Settings.MaxBatchSize);
+			}
+
+			Slots.resize(Settings.Capacity);
+
+			for (Request& Slot : Slots)
+			{
+				Slot.Input.reserve(InputSize);
+			}
+
+			BatchCallbacks.reserve(Settings.MaxBatchSize);
+			BatchSubmitTimes.reserve(Settings.MaxBatchSize);
+
+			Dispatcher = std::thread(&AsyncInferenceQueue::DispatchLoop, this);
+		}
+
+		/**
+		 * Finishes all pending submissions and stops the dispatcher
+		 */
+		~AsyncInferenceQueue()
+		{
+			{
+				std::scoped_lock Lock(QueueMutex);
+				bStop = true;
+			}
+
+			RequestAvailable.notify_all();
+			SlotAvailable.notify_all();
+
+			if (Dispatcher.joinable())
+				Dispatcher.join();
+		}
+
+		AsyncInferenceQueue(const AsyncInferenceQueue&) = delete;
+		AsyncInferenceQueue& operator=(const AsyncInferenceQueue&) = delete;
+
+		/**
+		 * Queue one input, blocks while the queue is full
+		 * @param Input - Copied before returning, GetInputSize() elements
+		 * @param Callback - Called on the dispatcher thread with the output
+		 * @return False if the input has the wrong size, the model was unloaded or the queue is shutting down
+		 */
+		bool Submit(std::span<const float> Input, CallbackType Callback)
+		{
+			if (Input.size() != InputSize || !Runtime.IsLoaded())
+			{
+				return false;
+			}
+
+			std::unique_lock Lock(QueueMutex);
+			SlotAvailable.wait(Lock, [this]() { return bStop || NumPending < Settings.Capacity; });
+
+			if (bStop)
+			{
+				return false;
+			}
+
+			return Enqueue(Lock, Input, std::move(Callback));
+		}
+
+		/**
+		 * Queue one input without waiting
+		 * @return False if the queue is full, the input has the wrong size, the model was unloaded or the queue is shutting down
+		 */
+		bool TrySubmit(std::span<const float> Input, CallbackType Callback)
+		{
+			if (Input.size() != InputSize || !Runtime.IsLoaded())
+			{
+				return false;
+			}
+
+			std::unique_lock Lock(QueueMutex);
+
+			if (bStop || NumPending >= Settings.Capacity)
+			{
+				Stats.NumRejected++;
+				return false;
+			}
+
+			return Enqueue(Lock, Input, std::move(Callback));
+		}
+
+		/**
+		 * Queue one input, blocks while the queue is full
+		 * @return Future of the output, empty if inference failed
+		 */
+		std::future<std::vector<float>> Submit(std::span<const float> Input)
+		{
+			auto Promise = std::make_shared<std::promise<std::vector<float>>>();
+			std::future<std::vector<float>> Result = Promise->get_future();
+
+			const bool bWasQueued = Submit(Input, [Promise](std::span<const float> Output)
+			{
+				Promise->set_value(std::vector<float>(Output.begin(), Output.end()));
+			});
+
+			if (!bWasQueued)
+			{
+				Promise->set_value({});
+			}
+
+			return Result;
+		}
+
+		/**
+		 * Blocks until every submission so far has been run and its callback returned
+		 */
+		void Flush()
+		{
+			std::unique_lock Lock(QueueMutex);
+			QueueDrained.wait(Lock, [this]() { return NumPending == 0 && !bIsRunningBatch; });
+		}
+
+		/**
+		 * @return False if the runtime had no model loaded when the queue was created
+		 */
+		bool IsValid() const
+		{
+			return Dispatcher.joinable();
+		}
+
+		uint32_t GetNumPending() const
+		{
+			std::scoped_lock Lock(QueueMutex);
+			return NumPending;
+		}
+
+		InferenceQueueStats GetStats() const
+		{
+			std::scoped_lock Lock(QueueMutex);
+			return Stats;
+		}
+	};
+
 	/**
 	 * ML inference utilities for SDK
 	 */
@@ -182,6 +1515,24 @@ namespace ML
 			return TensorData(FloatData, Shape, Name);
 		}
 
+		/**
+		 * View an array as a tensor, without copying it
+		 */
+		template<size_t N>
+		inline TensorView CreateTensorView(float(&Data)[N], std::span<const uint32_t> Shape)
+		{
+			return TensorView(Data, Shape);
+		}
+
+		/**
+		 * View 'Count' floats that are 'Stride' bytes apart as a 1D tensor, e.g. one member of every element of an array of SDK structs
+		 * @param Shape - Storage for the shape, has to outlive the view
+		 */
+		inline TensorView CreateStridedTensorView(void* First, size_t Stride, uint32_t& Shape)
+		{
+			return TensorView(static_cast<float*>(First), std::span<const uint32_t>(&Shape, 1), Stride);
+		}
+
 		/**
 		 * Create tensor from vector
 		 */
@@ -193,7 +1544,7 @@ namespace ML
 		/**
 		 * Normalize tensor data to [0, 1] range
 		 */
-		inline void NormalizeTensor(TensorData& Tensor, float Min = 0.0f, float Max = 1.0f)
+		inline void NormalizeTensor(const TensorView& Tensor, float Min = 0.0f, float Max = 1.0f)
 		{
 			float Range = Max - Min;
 			if (Range == 0.0f)
@@ -201,23 +1552,27 @@ namespace ML
 				return;
 			}
 
-			for (float& Value : Tensor.Data)
-			{
-				Value = (Value - Min) / Range;
-			}
+			Kernels::SubtractDivide(Tensor, Min, Range);
+		}
+
+		inline void NormalizeTensor(TensorData& Tensor, float Min = 0.0f, float Max = 1.0f)
+		{
+			NormalizeTensor(Tensor.GetView(), Min, Max);
 		}
 
 		/**
 		 * Denormalize tensor data from [0, 1] range
 		 */
-		inline void DenormalizeTensor(TensorData& Tensor, float Min = 0.0f, float Max = 1.0f)
+		inline void DenormalizeTensor(const TensorView& Tensor, float Min = 0.0f, float Max = 1.0f)
 		{
 			float Range = Max - Min;
 
-			for (float& Value : Tensor.Data)
-			{
-				Value = Value * Range + Min;
-			}
+			Kernels::MultiplyAdd(Tensor, Range, Min);
+		}
+
+		inline void DenormalizeTensor(TensorData& Tensor, float Min = 0.0f, float Max = 1.0f)
+		{
+			DenormalizeTensor(Tensor.GetView(), Min, Max);
 		}
 	}
 }
@@ -0,0 +1,542 @@
+#pragma once
+
+#include <span>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include <filesystem>
+#include <string_view>
+
+#include "MLEncryption.h"
+
+#if defined(_WIN32)
+/* The ML headers use std::min/std::max */
+#ifndef NOMINMAX
+#define NOMINMAX
+#include <Windows.h>
+#undef NOMINMAX
+#else
+#include <Windows.h>
+#endif
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace ML
+{
+	/**
+	 * Kind of data stored in a section of a ModelBundle
+	 */
+	enum class EBundleSectionType : uint32_t
+	{
+		Other = 0,
+		Metadata = 1,
+		Weights = 2,
+		Vocab = 3,
+		Model = 4, // A whole model, as passed to InferenceBackend::Load
+	};
+
+	/**
+	 * On-disk layout of a model bundle, little-endian
+	 *
+	 * BundleHeader Header;
+	 * BundleSection Sections[Header.NumSections]; // At Header.SectionTableOffset
+	 * Section data, every section at its own Offset, aligned to BundleSectionAlignment
+	 *
+	 * Every section is encrypted on its own, with the Key of the EncryptionKey and the IV of the section, so it can be decrypted without
+	 * reading any other part of the file.
+	 */
+	struct BundleHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t NumSections;
+		uint32_t Flags;
+		uint64_t SectionTableOffset;
+	};
+
+	struct BundleSection
+	{
+		char Name[32]; // NULL-padded, not necessarily NULL-terminated
+		EBundleSectionType Type;
+		uint32_t Flags;
+		uint64_t Offset;
+		uint64_t Size;
+		uint8_t IV[16];
+	};
+
+	static_assert(sizeof(BundleHeader) == 0x18 && sizeof(BundleSection) == 0x48, "The bundle layout must not depend on the compiler");
+
+	inline constexpr uint32_t BundleMagic = 0x31424C4D; // 'MLB1'
+	inline constexpr uint32_t BundleVersion = 0x1;
+	inline constexpr uint64_t BundleSectionAlignment = 0x1000;
+
+	/**
+	 * Read-only mapping of a whole file, unmapped on destruction
+	 */
+	class MappedFile
+	{
+	private:
+		const uint8_t* Data = nullptr;
+		size_t Size = 0;
+
+#if defined(_WIN32)
+		HANDLE FileHandle = INVALID_HANDLE_VALUE;
+		HANDLE MappingHandle = nullptr;
+#endif
+
+	public:
+		MappedFile() = default;
+
+		~MappedFile()
+		{
+			Close();
+		}
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+	public:
+		bool Open(const std::filesystem::path& FilePath)
+		{
+			Close();
+
+#if defined(_WIN32)
+			FileHandle = CreateFileW(FilePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+			LARGE_INTEGER FileSize = {};
+
+			if (FileHandle == INVALID_HANDLE_VALUE || !GetFileSizeEx(FileHandle, &FileSize) || FileSize.QuadPart == 0)
+			{
+				Close();
+				return false;
+			}
+
+			MappingHandle = CreateFileMappingW(FileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			Data = MappingHandle ? static_cast<const uint8_t*>(MapViewOfFile(MappingHandle, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+			Size = static_cast<size_t>(FileSize.QuadPart);
+#else
+			const int FileDescriptor = ::open(FilePath.c_str(), O_RDONLY);
+
+			struct stat FileInfo = {};
+
+			if (FileDescriptor < 0 || fstat(FileDescriptor, &FileInfo) != 0 || FileInfo.st_size == 0)
+			{
+				if (FileDescriptor >= 0)
+					::close(FileDescriptor);
+
+				return false;
+			}
+
+			void* Mapping = mmap(nullptr, static_cast<size_t>(FileInfo.st_size), PROT_READ, MAP_PRIVATE, FileDescriptor, 0);
+			::close(FileDescriptor);
+
+			Data = Mapping != MAP_FAILED ? static_cast<const uint8_t*>(Mapping) : nullptr;
+			Size = static_cast<size_t>(FileInfo.st_size);
+#endif
+			if (!Data)
+			{
+				Close();
+				return false;
+			}
+
+			return true;
+		}
+
+		void Close()
+		{
+#if defined(_WIN32)
+			if (Data)
+				UnmapViewOfFile(Data);
+
+			if (MappingHandle)
+				CloseHandle(MappingHandle);
+
+			if (FileHandle != INVALID_HANDLE_VALUE)
+				CloseHandle(FileHandle);
+
+			MappingHandle = nullptr;
+			FileHandle = INVALID_HANDLE_VALUE;
+#else
+			if (Data)
+				munmap(const_cast<uint8_t*>(Data), Size);
+#endif
+			Data = nullptr;
+			Size = 0;
+		}
+
+		std::span<const uint8_t> GetData() const
+		{
+			return std::span<const uint8_t>(Data, Size);
+		}
+	};
+
+	/**
+	 * Plaintext of one section, passed to ModelBundle::Write
+	 */
+	struct BundleSectionSource
+	{
+		std::string Name;
+		EBundleSectionType Type = EBundleSectionType::Other;
+		std::span<const uint8_t> Data;
+	};
+
+	/**
+	 * Encrypted model bundle, mapped from a file or viewed in memory
+	 *
+	 * Sections are decrypted on first access and cached. Handed out sections are shared, so evicting a section only drops the cache's
+	 * reference; it's freed once the last user let go of it. With a memory budget, the least recently used sections are evicted
+	 * whenever decrypting another one would exceed it.
+	 *
+	 * All member functions may be called from any thread.
+	 */
+	class ModelBundle
+	{
+	public:
+		using SectionDataType = std::shared_ptr<const std::vector<uint8_t>>;
+
+	private:
+		struct CachedSection
+		{
+			SectionDataType Data;
+			uint64_t LastUse = 0;
+		};
+
+	private:
+		MappedFile File;
+		std::span<const uint8_t> Bundle;
+		EncryptionKey Key;
+
+		std::vector<BundleSection> Sections;
+		std::vector<CachedSection> Cache;
+
+		mutable std::mutex CacheMutex;
+		uint64_t UseCounter = 0;
+		uint64_t ResidentBytes = 0;
+		uint64_t MemoryBudget = 0;
+
+	private:
+		/* Keystream of a section, the IV of the key is replaced by the IV of the section */
+		static EncryptionKey GetSectionKey(const EncryptionKey& Key, const BundleSection& Section)
+		{
+			EncryptionKey SectionKey = Key;
+			std::memcpy(SectionKey.IV.data(), Section.IV, sizeof(Section.IV));
+
+			return SectionKey;
+		}
+
+		/* Called with CacheMutex held, evicts least recently used sections until 'ExtraBytes' fit into the budget */
+		void EvictForBudget(uint64_t ExtraBytes)
+		{
+			while (MemoryBudget != 0 && ResidentBytes + ExtraBytes > MemoryBudget)
+			{
+				CachedSection* Oldest = nullptr;
+
+				for (CachedSection& Entry : Cache)
+				{
+					if (Entry.Data && (!Oldest || Entry.LastUse < Oldest->LastUse))
+						Oldest = &Entry;
+				}
+
+				if (!Oldest)
+					return;
+
+				ResidentBytes -= Oldest->Data->size();
+				Oldest->Data.reset();
+			}
+		}
+
+		bool ParseBundle()
+		{
+			BundleHeader Header;
+
+			if (Bundle.size() < sizeof(Header))
+				return false;
+
+			std::memcpy(&Header, Bundle.data(), sizeof(Header));
+
+			const uint64_t TableSize = static_cast<uint64_t>(Header.NumSections) * sizeof(BundleSection);
+
+			if (Header.Magic != BundleMagic || Header.Version != BundleVersion || Header.SectionTableOffset > Bundle.size() || TableSize > Bundle.size() - Header.SectionTableOffset)
+				return false;
+
+			Sections.resize(Header.NumSections);
+			std::memcpy(Sections.data(), Bundle.data() + Header.SectionTableOffset, TableSize);
+
+			for (const BundleSection& Section : Sections)
+			{
+				if (Section.Offset > Bundle.size() || Section.Size > Bundle.size() - Section.Offset)
+					return false;
+			}
+
+			Cache.resize(Sections.size());
+
+			return true;
+		}
+
+		/* Expects a closed bundle, sections and cache of a previous bundle would be indexed with the new section table */
+		bool OpenView(std::span<const uint8_t> BundleData, const EncryptionKey& InKey)
+		{
+			std::scoped_lock Lock(CacheMutex);
+
+			Bundle = BundleData;
+			Key = InKey;
+
+			if (!ParseBundle())
+			{
+				Bundle = {};
+				Sections.clear();
+				Cache.clear();
+				return false;
+			}
+
+			return true;
+		}
+
+	public:
+		/**
+		 * Map a bundle-file, nothing is decrypted yet
+		 * @return False if the file couldn't be mapped or isn't a valid bundle
+		 */
+		bool Open(const std::filesystem::path& FilePath, const EncryptionKey& InKey)
+		{
+			Close();
+
+			if (!File.Open(FilePath))
+				return false;
+
+			return OpenView(File.GetData(), InKey);
+		}
+
+		/**
+		 * View a bundle in memory not owned by the bundle, it has to outlive the bundle. Closes the bundle that was open before.
+		 */
+		bool Open(std::span<const uint8_t> BundleData, const EncryptionKey& InKey)
+		{
+			Close();
+
+			return OpenView(BundleData, InKey);
+		}
+
+		void Close()
+		{
+			std::scoped_lock Lock(CacheMutex);
+
+			Sections.clear();
+			Cache.clear();
+			ResidentBytes = 0;
+			Bundle = {};
+
+			File.Close();
+		}
+
+		/**
+		 * Index of the first section called Name, -1 if there is none
+		 */
+		int32_t FindSection(std::string_view Name) const
+		{
+			for (size_t i = 0; i < Sections.size(); i++)
+			{
+				if (GetSectionName(static_cast<int32_t>(i)) == Name)
+					return static_cast<int32_t>(i);
+			}
+
+			return -1;
+		}
+
+		/**
+		 * Index of the first section of this type, -1 if there is none
+		 */
+		int32_t FindSection(EBundleSectionType Type) const
+		{
+			for (size_t i = 0; i < Sections.size(); i++)
+			{
+				if (Sections[i].Type == Type)
+					return static_cast<int32_t>(i);
+			}
+
+			return -1;
+		}
+
+		int32_t GetNumSections() const
+		{
+			return static_cast<int32_t>(Sections.size());
+		}
+
+		std::string_view GetSectionName(int32_t Index) const
+		{
+			const char* Name = Sections[Index].Name;
+
+			return std::string_view(Name, strnlen(Name, sizeof(Sections[Index].Name)));
+		}
+
+		const BundleSection& GetSectionInfo(int32_t Index) const
+		{
+			return Sections[Index];
+		}
+
+		/**
+		 * Decrypted contents of a section, decrypted now if it isn't cached
+		 * @return Null if the index is invalid
+		 */
+		SectionDataType GetSection(int32_t Index)
+		{
+			if (Index < 0 || Index >= GetNumSections())
+				return nullptr;
+
+			std::unique_lock Lock(CacheMutex);
+
+			if (CachedSection& Entry = Cache[Index]; Entry.Data)
+			{
+				Entry.LastUse = ++UseCounter;
+				return Entry.Data;
+			}
+
+			const BundleSection& Section = Sections[Index];
+
+			/* Decrypted without the lock, straight from the mapping into the only copy */
+			Lock.unlock();
+
+			auto Decrypted = std::make_shared<std::vector<uint8_t>>(static_cast<size_t>(Section.Size));
+			ModelEncryption::ApplyKeystream(Bundle.data() + Section.Offset, Decrypted->data(), Decrypted->size(), GetSectionKey(Key, Section));
+
+			Lock.lock();
+
+			CachedSection& Entry = Cache[Index];
+
+			/* Another thread decrypted it in the meantime */
+			if (Entry.Data)
+			{
+				Entry.LastUse = ++UseCounter;
+				return Entry.Data;
+			}
+
+			EvictForBudget(Decrypted->size());
+
+			Entry.Data = std::move(Decrypted);
+			Entry.LastUse = ++UseCounter;
+			ResidentBytes += Entry.Data->size();
+
+			return Entry.Data;
+		}
+
+		SectionDataType GetSection(std::string_view Name)
+		{
+			return GetSection(FindSection(Name));
+		}
+
+		/**
+		 * Drop the cached plaintext of a section, it's decrypted again on the next access
+		 */
+		void Evict(int32_t Index)
+		{
+			std::scoped_lock Lock(CacheMutex);
+
+			if (Index < 0 || Index >= GetNumSections() || !Cache[Index].Data)
+				return;
+
+			ResidentBytes -= Cache[Index].Data->size();
+			Cache[Index].Data.reset();
+		}
+
+		void EvictAll()
+		{
+			std::scoped_lock Lock(CacheMutex);
+
+			for (CachedSection& Entry : Cache)
+				Entry.Data.reset();
+
+			ResidentBytes = 0;
+		}
+
+		/**
+		 * Upper bound for the decrypted sections kept in the cache, 0 is unlimited
+		 * Sections that are still used elsewhere stay alive until they're released, but no longer count against the budget
+		 */
+		void SetMemoryBudget(uint64_t Bytes)
+		{
+			std::scoped_lock Lock(CacheMutex);
+
+			MemoryBudget = Bytes;
+			EvictForBudget(0);
+		}
+
+		uint64_t GetResidentBytes() const
+		{
+			std::scoped_lock Lock(CacheMutex);
+			return ResidentBytes;
+		}
+
+	public:
+		/**
+		 * Encrypt and write sections as a bundle
+		 * The IV of every section is derived from the IV of the key and the index of the section, so no two sections share a keystream.
+		 * @return False if a name doesn't fit into BundleSection::Name or the file couldn't be written
+		 */
+		static bool Write(const std::filesystem::path& FilePath, std::span<const BundleSectionSource> SectionSources, const EncryptionKey& Key)
+		{
+			std::vector<BundleSection> Table(SectionSources.size());
+
+			const uint64_t TableOffset = sizeof(BundleHeader);
+			uint64_t Offset = TableOffset + Table.size() * sizeof(BundleSection);
+
+			for (size_t i = 0; i < SectionSources.size(); i++)
+			{
+				const BundleSectionSource& Source = SectionSources[i];
+				BundleSection& Section = Table[i];
+
+				if (Source.Name.size() > sizeof(Section.Name))
+					return false;
+
+				std::memset(&Section, 0, sizeof(Section));
+				std::memcpy(Section.Name, Source.Name.data(), Source.Name.size());
+
+				Offset = (Offset + BundleSectionAlignment - 1) & ~(BundleSectionAlignment - 1);
+
+				Section.Type = Source.Type;
+				Section.Offset = Offset;
+				Section.Size = Source.Data.size();
+
+				for (size_t j = 0; j < sizeof(Section.IV); j++)
+					Section.IV[j] = static_cast<uint8_t>(Key.IV[j] ^ (((i + 1) * 0x9E3779B97F4A7C15ull) >> ((j % 8) * 8)));
+
+				Offset += Section.Size;
+			}
+
+			std::ofstream Out(FilePath, std::ios::binary | std::ios::trunc);
+
+			if (!Out.is_open())
+				return false;
+
+			const BundleHeader Header = { BundleMagic, BundleVersion, static_cast<uint32_t>(Table.size()), 0x0, TableOffset };
+
+			Out.write(reinterpret_cast<const char*>(&Header), sizeof(Header));
+			Out.write(reinterpret_cast<const char*>(Table.data()), Table.size() * sizeof(BundleSection));
+
+			std::vector<uint8_t> Encrypted;
+
+			for (size_t i = 0; i < SectionSources.size(); i++)
+			{
+				const std::streamoff Padding = static_cast<std::streamoff>(Table[i].Offset) - Out.tellp();
+
+				for (std::streamoff j = 0; j < Padding; j++)
+					Out.put('\0');
+
+				Encrypted.resize(SectionSources[i].Data.size());
+				ModelEncryption::ApplyKeystream(SectionSources[i].Data.data(), Encrypted.data(), Encrypted.size(), GetSectionKey(Key, Table[i]));
+
+				Out.write(reinterpret_cast<const char*>(Encrypted.data()), Encrypted.size());
+			}
+
+			return Out.good();
+		}
+	};
+}
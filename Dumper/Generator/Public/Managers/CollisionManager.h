@@ -1,6 +1,7 @@
 #pragma once
 #include "Unreal/ObjectArray.h"
 #include "HashStringTable.h"
+#include "MemoryReport.h"
 
 enum class ECollisionType : uint8
 {
@@ -90,6 +91,30 @@ public:
 	std::string DebugStringify() const;
 };
 
+/* Open-addressing table of NameInfos keyed by their name. Adding a name that is already in the table replaces the previous NameInfo. */
+class NameLookupTable
+{
+private:
+	static constexpr uint32 InitialNumSlots = 0x20;
+
+private:
+	std::vector<NameInfo> Slots;
+	uint32 NumEntries = 0x0;
+
+private:
+	static inline uint32 GetSlotIndex(HashStringTableIndex Name, uint32 SlotMask)
+	{
+		return static_cast<uint32>((static_cast<uint64>(static_cast<uint32>(Name)) * 0x9E3779B97F4A7C15) >> 32) & SlotMask;
+	}
+
+	void Grow();
+
+public:
+	const NameInfo* Find(HashStringTableIndex Name) const;
+
+	void Add(const NameInfo& Info);
+};
+
 namespace KeyFunctions
 {
 	/* Make a unique key from UEProperty/UEFunction for NameTranslation */
@@ -128,9 +153,15 @@ private:
 	/* Names reserved for all members/parameters. Eg. "float", "operator", "return", ... */
 	NameContainer ReservedNames;
 
+	/* Latest NameInfo for every name declared by a struct or any of its supers, keyed by the struct. Built once, shared by all structs inheriting from it. */
+	std::unordered_map<int32, NameLookupTable> InheritedNameTables;
+
 private:
 	/* Returns index of NameInfo inside of the NameContainer it was added to */
-	uint64 AddNameToContainer(NameContainer& StructNames, UEStruct Struct, std::pair<HashStringTableIndex, bool>&& NamePair, ECollisionType CurrentType, bool bIsStruct, UEFunction Func = nullptr);
+	uint64 AddNameToContainer(NameContainer& StructNames, const NameLookupTable& StructNameTable, UEStruct Struct, std::pair<HashStringTableIndex, bool>&& NamePair, ECollisionType CurrentType, bool bIsStruct, UEFunction Func = nullptr);
+
+	/* Names visible to structs inheriting from 'Super'. 'Super' must have been added already. */
+	const NameLookupTable& GetInheritedNames(UEStruct Super);
 
 public:
 	/* For external use by 'MemberManager::InitReservedNames()' */
@@ -138,6 +169,17 @@ public:
 	void AddReservedName(const std::string& Name);
 	void AddStructToNameContainer(UEStruct ObjAsStruct, bool bIsStruct);
 
+	/* Frees the lookup-tables only required while structs are added. They are rebuilt if another struct is added later. */
+	void ReleaseLookupTables();
+
+	MemoryReport GetMemoryReport() const;
+
+	/* Shrinks the name-table and all containers to their used size */
+	void Compact();
+
+	/* Removes all names, reserved ones included */
+	void Reset();
+
 	std::string StringifyName(UEStruct Struct, NameInfo Info);
 
 public:
@@ -5,40 +5,46 @@
 #include <iostream>
 #include <format>
 #include <functional>
+#include <vector>
 
 #include "Unreal/Enums.h"
-
-
+#include "MemoryReport.h"
+
+/*
+* Dependency graph of the structs or classes within one package.
+*
+* While PackageManager initializes, dependencies are collected in a hashmap. Freeze() then converts them into a compressed-sparse-row graph
+* (one offset- and one edge-array over dense node indices) and stores the dependencies-first order of all nodes. After that the graph can't be modified.
+*/
 class DependencyManager
 {
 public:
 	using OnVisitCallbackType = std::function<void(int32 Index)>;
 
 private:
-	struct IndexDependencyInfo
-	{
-		/* Counter incremented every time this element is hit during iteration, **if** the counter is less than the CurrentIterationIndex */
-		mutable uint64 IterationHitCounter = 0x0;
+	/* Indices of Objects and the indices of Objects required by them, only used until Freeze() */
+	std::unordered_map<int32, std::unordered_set<int32>> PendingDependencies;
 
-		/* Indices of Objects required by this Object */
-		std::unordered_set<int32> DependencyIndices;
-	};
+	/* Dense node index -> object index */
+	std::vector<int32> NodeObjectIndices;
 
-private:
-	/* List of Objects and their Dependencies */
-	std::unordered_map<int32, IndexDependencyInfo> AllDependencies;
+	/* Object index -> dense node index */
+	std::unordered_map<int32, int32> NodeLookup;
 
-	/* Count to track how often the Dependency-List was iterated. Allows for up to 2^64 iterations of this list. */
-	mutable uint64 CurrentIterationHitCount = 0x0;
+	/* Dependencies of node N are Edges[EdgeOffsets[N]] to Edges[EdgeOffsets[N + 1]], as dense node indices */
+	std::vector<int32> EdgeOffsets;
+	std::vector<int32> Edges;
+
+	/* Object indices of all nodes, every object comes after all of its dependencies */
+	std::vector<int32> SortedObjectIndices;
+
+	bool bIsFrozen = false;
 
 public:
 	DependencyManager() = default;
 
 	DependencyManager(int32 ObjectToTrack);
 
-private:
-	void VisitIndexAndDependencies(int32 Index, OnVisitCallbackType Callback) const;
-
 public:
 	void SetExists(const int32 DepedantIdx);
 
@@ -46,14 +52,73 @@ public:
 
 	void SetDependencies(const int32 DepedantIdx, std::unordered_set<int32>&& Dependencies);
 
+	/* Builds the CSR graph and the sorted order. Must be called before visiting nodes, the graph can't be changed afterwards. */
+	void Freeze();
+
 	size_t GetNumEntries() const;
 
-	void VisitIndexAndDependenciesWithCallback(int32 Index, OnVisitCallbackType Callback) const;
-	void VisitAllNodesWithCallback(OnVisitCallbackType Callback) const;
+	MemoryReport GetMemoryReport() const;
+
+	/* Releases unused capacity of the frozen graph */
+	void Compact();
+
+	inline bool IsFrozen() const
+	{
+		return bIsFrozen;
+	}
+
+	/* Object indices of all nodes, ordered such that every object comes after all of its dependencies */
+	inline const std::vector<int32>& GetSortedIndices() const
+	{
+		return SortedObjectIndices;
+	}
 
 public:
-	const auto DEBUG_DependencyMap() const
+	/* Calls Callback for every node, dependencies first */
+	template<typename CallbackType>
+	inline void VisitAllNodes(CallbackType&& Callback) const
+	{
+		for (const int32 Index : SortedObjectIndices)
+			Callback(Index);
+	}
+
+	/* Calls Callback for 'Index' and everything it (indirectly) depends on, dependencies first */
+	template<typename CallbackType>
+	void VisitIndexAndDependencies(int32 Index, CallbackType&& Callback) const
 	{
-		return AllDependencies;
+		auto It = NodeLookup.find(Index);
+
+		if (It == NodeLookup.end())
+			return;
+
+		std::vector<bool> bWasVisited(NodeObjectIndices.size(), false);
+
+		/* Pairs of <Node, PositionOfNextEdgeToVisit> */
+		std::vector<std::pair<int32, int32>> Stack;
+		Stack.emplace_back(It->second, EdgeOffsets[It->second]);
+		bWasVisited[It->second] = true;
+
+		while (!Stack.empty())
+		{
+			auto& [Node, NextEdge] = Stack.back();
+
+			if (NextEdge == EdgeOffsets[Node + 1])
+			{
+				Callback(NodeObjectIndices[Node]);
+				Stack.pop_back();
+				continue;
+			}
+
+			const int32 Dependency = Edges[NextEdge++];
+
+			if (bWasVisited[Dependency])
+				continue;
+
+			bWasVisited[Dependency] = true;
+			Stack.emplace_back(Dependency, EdgeOffsets[Dependency]);
+		}
 	}
+
+	void VisitIndexAndDependenciesWithCallback(int32 Index, OnVisitCallbackType Callback) const;
+	void VisitAllNodesWithCallback(OnVisitCallbackType Callback) const;
 };
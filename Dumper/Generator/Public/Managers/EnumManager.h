@@ -1,5 +1,7 @@
 #pragma once
 
+#include <span>
+
 #include "CollisionManager.h"
 
 
@@ -45,23 +47,24 @@ private:
 	/* Whether this enums' size was initialized before */
 	bool bWasEnumSizeInitialized = false;
 
-	/* Infos on all members and if there are any collisions between member-names */
-	std::vector<EnumCollisionInfo> MemberInfos;
+	/* Infos on all members and if there are any collisions between member-names, range inside of EnumManager::EnumMemberInfos */
+	int32 FirstMemberInfo = 0x0;
+	int32 NumMemberInfos = 0x0;
 };
 
 struct CollisionInfoIterator
 {
 private:
-	const std::vector<EnumCollisionInfo>& CollisionInfos;
+	std::span<const EnumCollisionInfo> CollisionInfos;
 
 public:
-	CollisionInfoIterator(const std::vector<EnumCollisionInfo>& Infos)
+	CollisionInfoIterator(std::span<const EnumCollisionInfo> Infos)
 		: CollisionInfos(Infos)
 	{
 	}
 
 public:
-	auto begin() const { return CollisionInfos.cbegin(); }
+	auto begin() const { return CollisionInfos.begin(); }
 	auto end() const { return CollisionInfos.end(); }
 };
 
@@ -104,6 +107,9 @@ private:
 	/* NameTable containing names of all enum-values as well as information on name-collisions */
 	static inline HashStringTable UniqueEnumValueNames;
 
+	/* Members of all enums, in one contiguous block. Members of one enum are stored next to each other. */
+	static inline std::vector<EnumCollisionInfo> EnumMemberInfos;
+
 	/* List containing names-indices which contain illegal enum names such as 'PF_MAX' */
 	static inline IllegalNameContaierType IllegalNames;
 
@@ -116,6 +122,15 @@ private:
 public:
 	static void Init();
 
+	/* Memory used by all tables of this manager */
+	static MemoryReport GetMemoryReport();
+
+	/* Shrinks all storage to its used size, to be called once initialization and generation-setup finished */
+	static void Compact();
+
+	/* Drops every enum-info and name, the next Init() collects them again from GObjects. No generator may be running. */
+	static void Reset();
+
 private:
 	static inline const StringEntry& GetEnumName(const EnumInfo& Info)
 	{
@@ -127,6 +142,11 @@ private:
 		return UniqueEnumValueNames[Info.MemberName];
 	}
 
+	static inline std::span<const EnumCollisionInfo> GetMemberInfos(const EnumInfo& Info)
+	{
+		return std::span<const EnumCollisionInfo>(EnumMemberInfos.data() + Info.FirstMemberInfo, Info.NumMemberInfos);
+	}
+
 public:
 	static inline const OverrideMaptType& GetEnumInfos()
 	{
@@ -7,8 +7,13 @@
 #include "HashStringTable.h"
 #include "CollisionManager.h"
 #include "PredefinedMembers.h"
+#include "GeneratorArena.h"
 
 
+/*
+* MemberIterator and FunctionIterator, as well as the PropertyWrappers and FunctionWrappers they yield, borrow the StructWrapper of the
+* MemberManager they were created from. None of them may outlive that MemberManager. They already reference its member-lists anyways.
+*/
 template<bool bIsDeferredTemplateCreation = true>
 class MemberIterator
 {
@@ -17,9 +22,9 @@ private:
 	using DereferenceType = std::conditional_t<bIsDeferredTemplateCreation, class PropertyWrapper, void>;
 
 private:
-	const std::shared_ptr<class StructWrapper> Struct;
+	const class StructWrapper* Struct;
 
-	const std::vector<UEProperty>& Members;
+	const GeneratorArena::Vector<UEProperty>& Members;
 	const std::vector<PredefType>* PredefElements;
 
 	int32 CurrentIdx = 0x0;
@@ -28,7 +33,7 @@ private:
 	bool bIsCurrentlyPredefined = true;
 
 public:
-	inline MemberIterator(const std::shared_ptr<class StructWrapper>& Str, const std::vector<UEProperty>& Mbr, const std::vector<PredefType>* const Predefs = nullptr, int32 StartIdx = 0x0, int32 PredefStart = 0x0)
+	inline MemberIterator(const class StructWrapper* Str, const GeneratorArena::Vector<UEProperty>& Mbr, const std::vector<PredefType>* const Predefs = nullptr, int32 StartIdx = 0x0, int32 PredefStart = 0x0)
 		: Struct(Str), Members(Mbr), PredefElements(Predefs), CurrentIdx(StartIdx), CurrentPredefIdx(PredefStart)
 	{
 		const int32 NextUnrealOffset = GetUnrealMemberOffset();
@@ -88,9 +93,9 @@ private:
 	using DereferenceType = std::conditional_t<bIsDeferredTemplateCreation, class FunctionWrapper, void> ;
 
 private:
-	const std::shared_ptr<StructWrapper> Struct;
+	const StructWrapper* Struct;
 
-	const std::vector<UEFunction>& Members;
+	const GeneratorArena::Vector<UEFunction>& Members;
 	const std::vector<PredefType>* PredefElements;
 
 	int32 CurrentIdx = 0x0;
@@ -99,7 +104,7 @@ private:
 	bool bIsCurrentlyPredefined = true;
 
 public:
-	inline FunctionIterator(const std::shared_ptr<StructWrapper>& Str, const std::vector<UEFunction>& Mbr, const std::vector<PredefType>* const Predefs = nullptr, int32 StartIdx = 0x0, int32 PredefStart = 0x0)
+	inline FunctionIterator(const StructWrapper* Str, const GeneratorArena::Vector<UEFunction>& Mbr, const std::vector<PredefType>* const Predefs = nullptr, int32 StartIdx = 0x0, int32 PredefStart = 0x0)
 		: Struct(Str), Members(Mbr), PredefElements(Predefs), CurrentIdx(StartIdx), CurrentPredefIdx(PredefStart)
 	{
 		bIsCurrentlyPredefined = bShouldNextMemberBePredefined();
@@ -180,17 +185,18 @@ private:
 	friend class CollisionManagerTest;
 
 private:
-	/* Map to lookup if a struct has predefined members */
-	static inline const PredefinedMemberLookupMapType* PredefinedMemberLookup = nullptr;
-
 	/* CollisionManager containing information on colliding member-/function-names */
 	static inline CollisionManager MemberNames;
 
+	static inline bool bIsInitialized = false;
+
 private:
-	const std::shared_ptr<StructWrapper> Struct;
+	/* Shared between copies of this MemberManager, so the StructWrapper borrowed by iterators and wrappers never moves */
+	std::shared_ptr<const StructWrapper> Struct;
 
-	std::vector<UEProperty> Members;
-	std::vector<UEFunction> Functions;
+	/* Allocated from the GeneratorArena if one is active, a MemberManager must not outlive the package it was created for */
+	GeneratorArena::Vector<UEProperty> Members;
+	GeneratorArena::Vector<UEFunction> Functions;
 
 	const std::vector<PredefinedMember>* PredefMembers = nullptr;
 	const std::vector<PredefinedFunction>* PredefFunctions = nullptr;
@@ -213,11 +219,6 @@ public:
 	FunctionIterator<true> IterateFunctions() const;
 
 public:
-	static inline void SetPredefinedMemberLookupPtr(const PredefinedMemberLookupMapType* Lookup)
-	{
-		PredefinedMemberLookup = Lookup;
-	}
-
 	/* Add special names like "Class", "Flags, "Parms", etc. to avoid collisions on them */
 	static void InitReservedNames();
 
@@ -226,12 +227,10 @@ public:
 
 	static inline void Init()
 	{
-		static bool bInitialized = false;
-
-		if (bInitialized)
+		if (bIsInitialized)
 			return;
 
-		bInitialized = true;
+		bIsInitialized = true;
 
 		/* Adds special names first, to avoid name-collisions with predefined members */
 		InitReservedNames();
@@ -245,6 +244,8 @@ public:
 			AddStructToNameContainer(Obj.Cast<UEStruct>());
 		}
 
+		MemberNames.ReleaseLookupTables();
+
 		FixIncorrectNames();
 	}
 
@@ -268,4 +269,22 @@ public:
 	{
 		return MemberNames.StringifyName(Struct, Name);
 	}
+
+public:
+	static inline MemoryReport GetMemoryReport()
+	{
+		return MemberNames.GetMemoryReport();
+	}
+
+	static inline void Compact()
+	{
+		MemberNames.Compact();
+	}
+
+	/* Drops all name-collisions, the next Init() adds every struct again */
+	static inline void Reset()
+	{
+		bIsInitialized = false;
+		MemberNames.Reset();
+	}
 };
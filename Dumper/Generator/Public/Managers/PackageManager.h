@@ -1,62 +1,177 @@
 #pragma once
 
+#include <bit>
+#include <vector>
+
 #include "Unreal/Enums.h"
 #include "Unreal/UnrealObjects.h"
 
 #include "Managers/DependencyManager.h"
 #include "HashStringTable.h"
+#include "MemoryReport.h"
 
 
 namespace PackageManagerUtils
 {
-	std::unordered_set<int32> GetDependencies(UEStruct Struct, int32 StructIndex);
+	/* Writes the indices of all structs and enums required by the members of 'Struct' to OutDependencies, sorted and without duplicates */
+	void GetDependencies(UEStruct Struct, std::vector<int32>& OutDependencies);
 }
 
 class PackageInfoHandle;
 class PackageManager;
 
-struct RequirementInfo
+/* Set of packages, indexed by their dense index (see PackageManager::GetDenseIndex). Unions and iteration work on whole 64-bit words. */
+class PackageBitSet
 {
-	int32 PackageIdx;
-	bool bShouldIncludeStructs;
-	bool bShouldIncludeClasses;
+private:
+	std::vector<uint64> Words;
+
+public:
+	PackageBitSet() = default;
+
+public:
+	inline void Resize(int32 NumPackages)
+	{
+		Words.resize((NumPackages + 0x3F) / 0x40, 0x0);
+	}
+
+	inline void Set(int32 DenseIndex)
+	{
+		Words[DenseIndex / 0x40] |= (1ull << (DenseIndex % 0x40));
+	}
+
+	inline void Clear(int32 DenseIndex)
+	{
+		if (DenseIndex >= 0 && (DenseIndex / 0x40) < static_cast<int32>(Words.size()))
+			Words[DenseIndex / 0x40] &= ~(1ull << (DenseIndex % 0x40));
+	}
+
+	inline bool Test(int32 DenseIndex) const
+	{
+		if (DenseIndex < 0 || (DenseIndex / 0x40) >= static_cast<int32>(Words.size()))
+			return false;
+
+		return (Words[DenseIndex / 0x40] >> (DenseIndex % 0x40)) & 0x1;
+	}
+
+	inline int32 GetNumWords() const
+	{
+		return static_cast<int32>(Words.size());
+	}
+
+	inline uint64 GetWord(int32 WordIndex) const
+	{
+		return WordIndex < static_cast<int32>(Words.size()) ? Words[WordIndex] : 0x0;
+	}
+
+	inline MemoryReport GetMemoryReport() const
+	{
+		return MemoryReport::FromVector(Words);
+	}
+
+public:
+	inline PackageBitSet& operator|=(const PackageBitSet& Other)
+	{
+		if (Other.Words.size() > Words.size())
+			Words.resize(Other.Words.size(), 0x0);
+
+		for (size_t i = 0; i < Other.Words.size(); i++)
+			Words[i] |= Other.Words[i];
+
+		return *this;
+	}
+
+	/* Removes all packages contained in 'Other' */
+	inline void Remove(const PackageBitSet& Other)
+	{
+		const size_t NumCommonWords = Words.size() < Other.Words.size() ? Words.size() : Other.Words.size();
+
+		for (size_t i = 0; i < NumCommonWords; i++)
+			Words[i] &= ~Other.Words[i];
+	}
 };
 
-struct VisitedNodeInformation
+/* Headers of other packages included by one file of a package */
+struct PackageIncludeSet
 {
-	int32 PackageIdx;
-	mutable uint64 StructsIterationHitCount = 0x0;
-	mutable uint64 ClassesIterationHitCount = 0x0;
-};
+	/* Packages whose "_structs.hpp" is included */
+	PackageBitSet Structs;
+
+	/* Packages whose "_classes.hpp" is included */
+	PackageBitSet Classes;
+
+public:
+	inline void Resize(int32 NumPackages)
+	{
+		Structs.Resize(NumPackages);
+		Classes.Resize(NumPackages);
+	}
+
+	inline bool Contains(int32 DenseIndex) const
+	{
+		return Structs.Test(DenseIndex) || Classes.Test(DenseIndex);
+	}
+
+	inline MemoryReport GetMemoryReport() const
+	{
+		MemoryReport Report = Structs.GetMemoryReport();
+		Report += Classes.GetMemoryReport();
+
+		return Report;
+	}
+
+	inline void Erase(int32 DenseIndex)
+	{
+		Structs.Clear(DenseIndex);
+		Classes.Clear(DenseIndex);
+	}
+
+	inline PackageIncludeSet& operator|=(const PackageIncludeSet& Other)
+	{
+		Structs |= Other.Structs;
+		Classes |= Other.Classes;
 
-using DependencyListType = std::unordered_map<int32, RequirementInfo>;
+		return *this;
+	}
+
+	/* Calls Callback(DenseIndex, bIncludesStructs, bIncludesClasses) for every included package, in ascending order of the dense indices */
+	template<typename CallbackType>
+	inline void ForEach(CallbackType&& Callback) const
+	{
+		const int32 NumWords = Structs.GetNumWords() > Classes.GetNumWords() ? Structs.GetNumWords() : Classes.GetNumWords();
+
+		for (int32 i = 0; i < NumWords; i++)
+		{
+			const uint64 StructsWord = Structs.GetWord(i);
+			const uint64 ClassesWord = Classes.GetWord(i);
+
+			for (uint64 Word = StructsWord | ClassesWord; Word != 0x0; Word &= (Word - 1))
+			{
+				const int32 Bit = std::countr_zero(Word);
+
+				Callback((i * 0x40) + Bit, ((StructsWord >> Bit) & 0x1) != 0x0, ((ClassesWord >> Bit) & 0x1) != 0x0);
+			}
+		}
+	}
+};
 
 
 struct DependencyInfo
 {
-	/* Counter incremented every time this element is hit during iteration, **if** the counter is less than the CurrentIterationIndex */
-	mutable uint64 StructsIterationHitCount = 0x0;
-	mutable uint64 ClassesIterationHitCount = 0x0;
-
 	/* List of packages required by "ThisPackage_structs.h" */
-	DependencyListType StructsDependencies;
+	PackageIncludeSet StructsDependencies;
 
 	/* List of packages required by "ThisPackage_classes.h" */
-	DependencyListType ClassesDependencies;
+	PackageIncludeSet ClassesDependencies;
 
 	/* List of packages required by "ThisPackage_parameters.h" */
-	DependencyListType ParametersDependencies;
-};
+	PackageIncludeSet ParametersDependencies;
 
-struct IncludeData
-{
-	bool bIncludedStructs = false;
-	bool bIncludedClasses = false;
+	/* Every header reached through the includes of "ThisPackage_structs.h" and "ThisPackage_classes.h", computed once in PackageManager::PostInit */
+	PackageIncludeSet TransitiveStructsIncludes;
+	PackageIncludeSet TransitiveClassesIncludes;
 };
 
-using VisitedNodeContainerType = std::unordered_map<int32, IncludeData>;
-
-
 struct PackageInfo
 {
 private:
@@ -67,6 +182,9 @@ private:
 private:
 	int32 PackageIndex;
 
+	/* Index of this package in [0, NumPackages), used to address it in a PackageBitSet */
+	int32 DenseIndex = -1;
+
 	/* Name of this Package*/
 	HashStringTableIndex Name = HashStringTableIndex::FromInt(-1);
 
@@ -128,6 +246,8 @@ public:
 	const DependencyInfo& GetPackageDependencies() const;
 
 	void ErasePackageDependencyFromStructs(int32 Package) const;
+
+	/* Removes the include of "Package_classes.hpp" from "ThisPackage_classes.hpp", an include of "Package_structs.hpp" is kept */
 	void ErasePackageDependencyFromClasses(int32 Package) const;
 };
 
@@ -170,18 +290,6 @@ public:
 	PackageInfoIterator end() const   { return PackageInfoIterator(PackageInfos, CurrentIterationHitCount, PackageInfos.cend());   }
 };
 
-struct PackageManagerIterationParams
-{
-	int32 PrevPackage;
-	int32 RequiredPackage;
-
-	bool bWasPrevNodeStructs;
-	bool bRequiresClasses;
-	bool bRequiresStructs;
-
-	VisitedNodeContainerType& VisitedNodes;
-};
-
 class PackageManager
 {
 private:
@@ -191,27 +299,10 @@ private:
 public:
 	using OverrideMaptType = PackageManagerOverrideMapType;
 
-	using IteratePackagesCallbackType = std::function<void(const PackageManagerIterationParams& OldParams, const PackageManagerIterationParams& NewParams, bool bIsStruct)>;
-	using FindCycleCallbackType = std::function<void(const PackageManagerIterationParams& OldParams, const PackageManagerIterationParams& NewParams, bool bIsStruct)>;
-
-private:
-	struct SingleDependencyIterationParamsInternal
-	{
-		const IteratePackagesCallbackType& CallbackForEachPackage;
-		const FindCycleCallbackType& OnFoundCycle;
-
-		PackageManagerIterationParams& NewParams;
-		const PackageManagerIterationParams& OldParams;
-		const DependencyListType& Dependencies;
-		VisitedNodeContainerType& VisitedNodes;
-
-		int32 CurrentIndex;
-		int32 PrevIndex;
-		uint64& IterationHitCounterRef;
-
-		bool bShouldHandlePackage;
-		bool bIsStruct;
-	};
+	/* Called for every "_structs.hpp" (bIsStruct) and "_classes.hpp" file of every package */
+	using IteratePackagesCallbackType = std::function<void(int32 PackageIndex, bool bIsStruct)>;
+	/* CyclicPackage is required by PreviousPackage, while PreviousPackage (indirectly) requires CyclicPackage. bIsStruct tells whether the "_structs" or "_classes" file of CyclicPackage is part of the cycle. */
+	using FindCycleCallbackType = std::function<void(int32 CyclicPackage, int32 PreviousPackage, bool bIsStruct)>;
 
 private:
 	/* NameTable containing names of all Packages as well as information on name-collisions */
@@ -220,6 +311,18 @@ private:
 	/* Map containing infos on all Packages. Implemented due to information missing in the Unreal's reflection system (PackageSize). */
 	static inline OverrideMaptType PackageInfos;
 
+	/* DenseIndex -> PackageIndex, dense indices are assigned in the order in which packages first appear in GObjects */
+	static inline std::vector<int32> DensePackageIndices;
+
+	/* PackageIndex -> DenseIndex, -1 for objects that aren't packages */
+	static inline std::vector<int32> DenseIndexLookup;
+
+	/* Node 'DenseIndex * 2' is "_structs.hpp", 'DenseIndex * 2 + 1' "_classes.hpp" of a package. Dependencies come before the files including them. */
+	static inline std::vector<int32> IncludeOrder;
+
+	/* Set if the includes still contained a cycle after HandleCycles, transitive includes are incomplete then */
+	static inline bool bHasIncludeCycles = false;
+
 	/* Count to track how often the PackageInfos was iterated. Allows for up to 2^64 iterations of this list. */
 	static inline uint64 CurrentIterationHitCount = 0x0;
 
@@ -228,8 +331,10 @@ private:
 
 private:
 	static void InitDependencies();
+	static void ApplyPackageFilter();
 	static void InitNames();
 	static void HandleCycles();
+	static void InitTransitiveIncludes();
 
 private:
 	static void HelperMarkStructDependenciesOfPackage(UEStruct Struct, int32 OwnPackageIdx, int32 RequiredPackageIdx, bool bIsClass);
@@ -243,19 +348,29 @@ public:
 	static void Init();
 	static void PostInit();
 
+	/* Memory used by all tables of this manager */
+	static MemoryReport GetMemoryReport();
+
+	/* Shrinks all storage to its used size, to be called once initialization and generation-setup finished */
+	static void Compact();
+
+	/* Drops every package-info and name, the next Init() collects them again from GObjects. No generator may be running. */
+	static void Reset();
+
 private:
 	static inline const StringEntry& GetPackageName(const PackageInfo& Info)
 	{
 		return UniquePackageNameTable[Info.Name];
 	}
 
-private:
-	static void IterateSingleDependencyImplementation(SingleDependencyIterationParamsInternal& Params, bool bCheckForCycle);
-
-	static void IterateDependenciesImplementation(const PackageManagerIterationParams& Params, const IteratePackagesCallbackType& CallbackForEachPackage, const FindCycleCallbackType& OnFoundCycle, bool bCheckForCycle);
-
 public:
+	/* Visits the "_structs.hpp" and "_classes.hpp" files of all packages, every file is visited after all files it includes */
 	static void IterateDependencies(const IteratePackagesCallbackType& CallbackForEachPackage);
+
+	/* Removes every include that is already included by another header in 'Includes', that header includes it anyways */
+	static void RemoveTransitiveIncludes(PackageIncludeSet& Includes);
+
+	/* Reports every dependency that closes a cycle between packages, in a single linear pass over the package graph */
 	static void FindCycle(const FindCycleCallbackType& OnFoundCycle);
 
 public:
@@ -274,6 +389,22 @@ public:
 		return UniquePackageNameTable[Info.Name].IsUnique();
 	}
 
+	static inline int32 GetNumPackages()
+	{
+		return static_cast<int32>(DensePackageIndices.size());
+	}
+
+	/* Dense index of this package, or -1 if it's unknown */
+	static inline int32 GetDenseIndex(int32 PackageIndex)
+	{
+		return PackageIndex >= 0 && PackageIndex < static_cast<int32>(DenseIndexLookup.size()) ? DenseIndexLookup[PackageIndex] : -1;
+	}
+
+	static inline int32 GetPackageIndexFromDense(int32 DenseIndex)
+	{
+		return DensePackageIndices[DenseIndex];
+	}
+
 	static inline PackageInfoHandle GetInfo(int32 PackageIndex)
 	{
 		return PackageInfos.at(PackageIndex);
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <vector>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "Unreal/UnrealObjects.h"
 #include "HashStringTable.h"
+#include "MemoryReport.h"
 
 
 /*
@@ -97,12 +99,27 @@ private:
 	static inline bool bIsInitialized = false;
 
 private:
-	static void InitAlignmentsAndNames();
-	static void InitSizesAndIsFinal();
+	/* Reflection data of one struct, read from GObjects once. Defined in StructManager.cpp. */
+	struct StructLayoutRecord;
+
+	/* Reads the layout-relevant data of all structs in parallel, returns them in order of their object-indices */
+	static std::vector<StructLayoutRecord> CollectLayoutRecords();
+
+	static void InitAlignmentsAndNames(const std::vector<StructLayoutRecord>& Records, std::vector<StructInfo*>& OutInfos);
+	static void InitSizesAndIsFinal(const std::vector<StructLayoutRecord>& Records, const std::vector<StructInfo*>& Infos);
 
 public:
 	static void Init();
 
+	/* Memory used by all tables of this manager */
+	static MemoryReport GetMemoryReport();
+
+	/* Shrinks all storage to its used size, to be called once initialization and generation-setup finished */
+	static void Compact();
+
+	/* Drops every struct-info and name, the next Init() collects them again from GObjects. No generator may be running. */
+	static void Reset();
+
 private:
 	static inline const StringEntry& GetName(const StructInfo& Info)
 	{
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <format>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <string_view>
+
+#include "Unreal/Enums.h"
+
+/*
+* Memory occupied by a container, a HashStringTable or an entire manager. Reports of nested containers are summed up with operator+=.
+*
+* 'BytesUsed' only counts the stored elements themselves, 'BytesAllocated' also counts unused capacity and bookkeeping like hash-buckets and
+* list-nodes. Node-overhead of the standard containers is estimated from the layout of MSVCs implementation.
+*/
+struct MemoryReport
+{
+	uint64 BytesUsed = 0x0;
+	uint64 BytesAllocated = 0x0;
+
+	uint64 NumEntries = 0x0;
+
+	/* Entries and slots of all hash-indices in this report, used for the load-factor */
+	uint64 NumIndexedEntries = 0x0;
+	uint64 NumIndexSlots = 0x0;
+
+public:
+	inline uint64 GetWastedBytes() const
+	{
+		return BytesAllocated > BytesUsed ? BytesAllocated - BytesUsed : 0x0;
+	}
+
+	inline double GetLoadFactor() const
+	{
+		return NumIndexSlots != 0x0 ? static_cast<double>(NumIndexedEntries) / NumIndexSlots : 0.0;
+	}
+
+	inline MemoryReport& operator+=(const MemoryReport& Other)
+	{
+		BytesUsed += Other.BytesUsed;
+		BytesAllocated += Other.BytesAllocated;
+		NumEntries += Other.NumEntries;
+		NumIndexedEntries += Other.NumIndexedEntries;
+		NumIndexSlots += Other.NumIndexSlots;
+
+		return *this;
+	}
+
+public:
+	inline void Print(std::string_view Name) const
+	{
+		std::cerr << std::format("{:<20} Used: {:>8.2f}KiB, Allocated: {:>8.2f}KiB, Wasted: {:>8.2f}KiB, Entries: {:>8}, LoadFactor: {:.3f}\n",
+			Name, BytesUsed / 1024.0, BytesAllocated / 1024.0, GetWastedBytes() / 1024.0, NumEntries, GetLoadFactor());
+	}
+
+public:
+	template<typename ElementType>
+	static inline MemoryReport FromVector(const std::vector<ElementType>& Vector)
+	{
+		MemoryReport Report;
+		Report.BytesUsed = Vector.size() * sizeof(ElementType);
+		Report.BytesAllocated = Vector.capacity() * sizeof(ElementType);
+		Report.NumEntries = Vector.size();
+
+		return Report;
+	}
+
+	/* Only the heap-buffer of the string, the string itself is part of the container holding it. MSVC stores up to 15 chars inline. */
+	static inline MemoryReport FromString(const std::string& String)
+	{
+		constexpr size_t MaxInlineChars = 15;
+
+		MemoryReport Report;
+
+		if (String.capacity() > MaxInlineChars)
+		{
+			Report.BytesUsed = String.size() + 1;
+			Report.BytesAllocated = String.capacity() + 1;
+		}
+
+		return Report;
+	}
+
+	/* std::unordered_map and std::unordered_set, every element is a list-node with two pointers and every bucket stores two iterators */
+	template<typename HashContainerType>
+	static inline MemoryReport FromHashContainer(const HashContainerType& Container)
+	{
+		using ValueType = typename HashContainerType::value_type;
+
+		MemoryReport Report;
+		Report.BytesUsed = Container.size() * sizeof(ValueType);
+		Report.BytesAllocated = Container.size() * (sizeof(ValueType) + 2 * sizeof(void*)) + Container.bucket_count() * 2 * sizeof(void*);
+		Report.NumEntries = Container.size();
+		Report.NumIndexedEntries = Container.size();
+		Report.NumIndexSlots = Container.bucket_count();
+
+		return Report;
+	}
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <unordered_map>
+
+#include "Managers/PackageManager.h"
+#include "TypeIR.h"
+
+/*
+* Fingerprints of the contents of every package, used by the CppGenerator to skip packages that didn't change since the previous run.
+*
+* The own fingerprint of a package covers the names, sizes and alignments of its enums, structs and classes, their members and functions, and the
+* packages it includes. It also covers everything the StructManager, MemberManager and PackageManager decided about them that changes the text,
+* like final-ness, reused trailing padding, collision-resolved member names and which referenced structs need a cycle-fixup type. The effective fingerprint additionally covers the own fingerprints of every package reachable through the includes, so a
+* change to a type propagates to every package whose layout or includes could depend on it.
+*
+* Fingerprints are stored per package-name, together with a stamp identifying the build of the generator. Fingerprints of another build are discarded.
+*
+* A regeneration in WatchMode hands over the packages and names of the types that changed in GObjects. Only the own fingerprints of those packages,
+* of every package that includes them, directly or transitively, and of packages declaring a type of one of those names are computed again. Names
+* are compared since a new type can make the name of another one non-unique. All other packages keep the own fingerprint of the previous run.
+*/
+class PackageFingerprints
+{
+private:
+	/* Indexed by the dense index of the package */
+	static inline std::vector<uint64> OwnFingerprints;
+	static inline std::vector<uint64> EffectiveFingerprints;
+
+	struct PreviousFingerprint
+	{
+		uint64 Effective;
+		uint64 Own;
+	};
+
+	/* Package-name -> fingerprints of the previous run */
+	static inline std::unordered_map<std::string, PreviousFingerprint> PreviousFingerprints;
+
+	/* Object-indices of the packages, and FName comparison-indices, of types that changed since the previous run. See SetChanges */
+	static inline std::vector<int32> ChangedPackages;
+	static inline std::vector<int32> ChangedNames;
+	static inline bool bHasChanges = false;
+
+private:
+	static uint64 ComputeOwnFingerprint(PackageInfoHandle Package);
+
+	/* Packages whose own fingerprint may differ from the previous run, by dense index */
+	static PackageBitSet GetPackagesAffectedByChanges();
+
+public:
+	/*
+	* Computes the fingerprints of all packages, requires the PackageManager to be fully initialized. With 'bHasPreviousFingerprints', Load must have
+	* succeeded before, and the changes passed to SetChanges limit which own fingerprints are computed. The changes are used up by this call.
+	*/
+	static void Init(bool bHasPreviousFingerprints);
+
+	/* Limits the next Init to the packages affected by these changes, see the comment above the class */
+	static void SetChanges(std::vector<int32>&& PackageIndices, std::vector<int32>&& NameIndices);
+
+	/* Reads the fingerprints of a previous run. Returns false if there are none, or if they were written by a different build. */
+	static bool Load(const std::filesystem::path& FilePath, uint64 BuildStamp);
+
+	/* Text of the fingerprint-file for the current fingerprints, meant to be written by the generator alongside its other files */
+	static std::string Serialize(uint64 BuildStamp);
+
+public:
+	static inline uint64 GetFingerprint(PackageInfoHandle Package)
+	{
+		const int32 DenseIndex = PackageManager::GetDenseIndex(Package.GetIndex());
+
+		return DenseIndex >= 0 && DenseIndex < static_cast<int32>(EffectiveFingerprints.size()) ? EffectiveFingerprints[DenseIndex] : 0x0;
+	}
+
+	/* Package and everything it includes are identical to the previous run */
+	static inline bool IsUnchanged(PackageInfoHandle Package)
+	{
+		auto It = PreviousFingerprints.find(Package.GetName());
+
+		return It != PreviousFingerprints.end() && It->second.Effective == GetFingerprint(Package);
+	}
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include "Unreal/ObjectArray.h"
+#include "Unreal/ObjectArraySnapshot.h"
+#include "WorkerPool.h"
+
+/*
+* Parallel scan over all slots of GObjects, shared by the managers and generators that collect per-object data on the WorkerPool.
+*
+* The object-indices are split into small fixed-size shards, so threads that hit a range full of large structs don't hold up the others.
+* Every shard has its own result, which is only written by the thread that claimed it. Results are returned in order of the object-indices,
+* so merging them front to back doesn't depend on thread-scheduling.
+*/
+class ShardedObjectScan
+{
+private:
+	static constexpr int32 ObjectsPerShard = 0x1000;
+
+	/* Number of addresses read from GObjects at once, resolves the chunk-pointer once per block instead of once per object */
+	static constexpr int32 AddressBlockSize = 0x400;
+
+public:
+	/* Number of slots covered by a scan, the size of the ObjectArraySnapshot if one was built */
+	static inline int32 GetNumObjects()
+	{
+		return ObjectArraySnapshot::IsBuilt() ? ObjectArraySnapshot::Num() : ObjectArray::Num();
+	}
+
+	/* Calls 'ScanShard(StartIndex, EndIndex, ShardType& Shard)' for all shards of [0, NumObjects) on the WorkerPool */
+	template<typename ShardType, typename ScanFunctionType>
+	static inline std::vector<ShardType> Run(int32 NumObjects, ScanFunctionType&& ScanShard)
+	{
+		const int32 NumShards = (NumObjects + ObjectsPerShard - 1) / ObjectsPerShard;
+
+		std::vector<ShardType> Shards(NumShards);
+
+		WorkerPool::ParallelFor(NumShards, [&](int32 ShardIdx) -> void
+		{
+			const int32 StartIndex = ShardIdx * ObjectsPerShard;
+			ScanShard(StartIndex, std::min(StartIndex + ObjectsPerShard, NumObjects), Shards[ShardIdx]);
+		});
+
+		return Shards;
+	}
+
+	/* Calls 'Callback(UEObject Obj)' for all non-null objects in [StartIndex, EndIndex), in order of their index */
+	template<typename CallbackType>
+	static inline void ForEachObjectInRange(int32 StartIndex, int32 EndIndex, CallbackType&& Callback)
+	{
+		void* Addresses[AddressBlockSize];
+
+		for (int32 BlockStart = StartIndex; BlockStart < EndIndex; BlockStart += AddressBlockSize)
+		{
+			const int32 BlockSize = std::min(AddressBlockSize, EndIndex - BlockStart);
+
+			ObjectArray::GetAddressesInRange(BlockStart, BlockSize, Addresses);
+
+			for (int32 i = 0; i < BlockSize; i++)
+			{
+				const UEObject Obj = Addresses[i];
+
+				if (Obj)
+					Callback(Obj);
+			}
+		}
+	}
+};
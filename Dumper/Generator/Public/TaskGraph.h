@@ -0,0 +1,209 @@
+#pragma once
+
+#include <atomic>
+#include <format>
+#include <string>
+#include <vector>
+#include <memory>
+#include <iostream>
+#include <functional>
+#include <initializer_list>
+
+#include "WorkerPool.h"
+#include "Profiler.h"
+
+/*
+* Set of tasks that declare which data they require and which data they produce. The execution order is derived from these declarations only.
+*
+* Run() checks the graph before anything is executed:
+*   - every piece of data is produced by exactly one task
+*   - every required piece of data has a producer
+*   - the dependencies don't form a cycle
+*
+* Tasks whose required data is complete are submitted to the WorkerPool, so independent tasks run concurrently.
+* 'DataType' is an enum that is convertible to an index, with 'DataType::Num' as its last value.
+*/
+template<typename DataType>
+class TaskGraph
+{
+private:
+	static constexpr int32 NumDataTypes = static_cast<int32>(DataType::Num);
+
+private:
+	struct Task
+	{
+		std::string Name;
+		std::function<void()> Work;
+
+		std::vector<DataType> Requires;
+		std::vector<DataType> Produces;
+
+		/* Indices of tasks requiring data produced by this task */
+		std::vector<int32> Dependents;
+
+		int32 NumDependencies = 0x0;
+		std::atomic<int32> NumUnfinishedDependencies = 0x0;
+	};
+
+private:
+	std::vector<std::unique_ptr<Task>> Tasks;
+
+	std::atomic<int32> NumFinishedTasks = 0x0;
+
+public:
+	TaskGraph() = default;
+
+	TaskGraph(const TaskGraph&) = delete;
+	TaskGraph& operator=(const TaskGraph&) = delete;
+
+public:
+	inline void AddTask(std::string&& Name, std::function<void()>&& Work, std::initializer_list<DataType> Requires, std::initializer_list<DataType> Produces)
+	{
+		Task& NewTask = *Tasks.emplace_back(std::make_unique<Task>());
+
+		NewTask.Name = std::move(Name);
+		NewTask.Work = std::move(Work);
+		NewTask.Requires = Requires;
+		NewTask.Produces = Produces;
+	}
+
+private:
+	inline bool BuildEdges()
+	{
+		std::vector<int32> Producers(NumDataTypes, -1);
+
+		for (int i = 0; i < static_cast<int32>(Tasks.size()); i++)
+		{
+			for (DataType Data : Tasks[i]->Produces)
+			{
+				int32& Producer = Producers[static_cast<int32>(Data)];
+
+				if (Producer != -1)
+				{
+					std::cerr << std::format("TaskGraph: Data {} is produced by both '{}' and '{}'!\n", static_cast<int32>(Data), Tasks[Producer]->Name, Tasks[i]->Name);
+					return false;
+				}
+
+				Producer = i;
+			}
+		}
+
+		for (int i = 0; i < static_cast<int32>(Tasks.size()); i++)
+		{
+			Task& Current = *Tasks[i];
+
+			for (DataType Data : Current.Requires)
+			{
+				const int32 Producer = Producers[static_cast<int32>(Data)];
+
+				if (Producer == -1)
+				{
+					std::cerr << std::format("TaskGraph: '{}' requires data {}, which isn't produced by any task!\n", Current.Name, static_cast<int32>(Data));
+					return false;
+				}
+
+				if (Producer == i)
+				{
+					std::cerr << std::format("TaskGraph: '{}' requires data {}, which it produces itself!\n", Current.Name, static_cast<int32>(Data));
+					return false;
+				}
+
+				Tasks[Producer]->Dependents.push_back(i);
+				Current.NumDependencies++;
+			}
+		}
+
+		return true;
+	}
+
+	/* Kahn's algorithm on a copy of the dependency-counts, every task is visited exactly once if the graph is acyclic */
+	inline bool IsAcyclic() const
+	{
+		std::vector<int32> RemainingDependencies(Tasks.size());
+		std::vector<int32> ReadyTasks;
+
+		for (int i = 0; i < static_cast<int32>(Tasks.size()); i++)
+		{
+			RemainingDependencies[i] = Tasks[i]->NumDependencies;
+
+			if (RemainingDependencies[i] == 0)
+				ReadyTasks.push_back(i);
+		}
+
+		int32 NumVisited = 0x0;
+
+		while (!ReadyTasks.empty())
+		{
+			const int32 Current = ReadyTasks.back();
+			ReadyTasks.pop_back();
+
+			NumVisited++;
+
+			for (int32 Dependent : Tasks[Current]->Dependents)
+			{
+				if (--RemainingDependencies[Dependent] == 0)
+					ReadyTasks.push_back(Dependent);
+			}
+		}
+
+		if (NumVisited == static_cast<int32>(Tasks.size()))
+			return true;
+
+		for (int i = 0; i < static_cast<int32>(Tasks.size()); i++)
+		{
+			if (RemainingDependencies[i] > 0)
+				std::cerr << std::format("TaskGraph: '{}' is part of a dependency-cycle!\n", Tasks[i]->Name);
+		}
+
+		return false;
+	}
+
+	inline void Schedule(int32 TaskIndex)
+	{
+		WorkerPool::Submit([this, TaskIndex]() -> void
+		{
+			Task& Current = *Tasks[TaskIndex];
+
+			{
+				Profiler::Scope TaskScope(Current.Name);
+				Current.Work();
+			}
+
+			for (int32 Dependent : Current.Dependents)
+			{
+				if (--Tasks[Dependent]->NumUnfinishedDependencies == 0)
+					Schedule(Dependent);
+			}
+
+			NumFinishedTasks++;
+		});
+	}
+
+public:
+	/* Validates the graph and runs every task once. Returns false, without running any task, if the graph is invalid. */
+	inline bool Run()
+	{
+		if (!BuildEdges() || !IsAcyclic())
+			return false;
+
+		NumFinishedTasks = 0x0;
+
+		for (std::unique_ptr<Task>& Current : Tasks)
+			Current->NumUnfinishedDependencies = Current->NumDependencies;
+
+		for (int i = 0; i < static_cast<int32>(Tasks.size()); i++)
+		{
+			if (Tasks[i]->NumDependencies == 0)
+				Schedule(i);
+		}
+
+		/* Tasks reference this graph, the calling thread helps out until all of them are done */
+		while (NumFinishedTasks < static_cast<int32>(Tasks.size()))
+		{
+			if (!WorkerPool::TryRunPendingTask())
+				std::this_thread::yield();
+		}
+
+		return true;
+	}
+};
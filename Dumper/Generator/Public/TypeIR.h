@@ -0,0 +1,214 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <unordered_map>
+
+#include "Unreal/UnrealObjects.h"
+#include "HashStringTable.h"
+
+/*
+* Generator-independent description of every property and function in GObjects, extracted once after Generator::InitInternal.
+*
+* Generators used to re-read the same facts (cast-flags, offsets, sizes, bitfield-data, referenced objects, inner-properties) from the game for
+* every member they emitted. All of them now walk these records instead, so running several generators costs one extraction and cheap emitters.
+*
+* Properties of a struct are stored contiguously, in the same order as in StructMemberCache. Inner-properties (of arrays, maps, sets, optionals and
+* enums) follow after all member-properties. Names are interned in a HashStringTable. Packages, structs and enums are already flat in their managers.
+*
+* Records are never added after Init(), so references to them stay valid until Reset().
+*/
+class TypeIR
+{
+public:
+	struct PropertyNode
+	{
+		UEProperty Property = nullptr;
+
+		/* Class or FieldClass of the property, only required to stringify unknown property-types */
+		UEClass Class = nullptr;
+		UEFFieldClass FieldClass = nullptr;
+
+		EClassCastFlags CastFlags = EClassCastFlags::None;
+		EPropertyFlags PropertyFlags = EPropertyFlags::None;
+
+		int32 Offset = 0x0;
+		int32 Size = 0x0;
+		int32 ArrayDim = 0x0;
+
+		/*
+		* Byte-/EnumProperty: Enum
+		* StructProperty: UnderlayingStruct
+		* Object-, Class-, Interface-, Weak-, Lazy-, Soft- and (ObjPtr-)FieldPathProperty: PropertyClass
+		* Delegate-/MulticastInlineDelegateProperty: SignatureFunction
+		*/
+		UEObject Referenced = nullptr;
+
+		/* ClassProperty: MetaClass */
+		UEObject MetaClass = nullptr;
+
+		/* Array: Inner, Set: Element, Map: Key and Value, Enum: UnderlayingProperty, Optional: Value */
+		const PropertyNode* Inner[2] = { nullptr, nullptr };
+
+		/* FieldPathProperty: Name of the FieldClass, invalid if there is none */
+		HashStringTableIndex FieldClassName = HashStringTableIndex::FromInt(-1);
+
+		HashStringTableIndex Name = HashStringTableIndex::FromInt(-1);
+
+		/* Shared by all nodes whose type stringifies the same in every generator, -1 for nodes created after Init(). See TypeIR::GetTypeShape. */
+		int32 TypeShape = -1;
+
+		/* BoolProperty */
+		uint8 FieldMask = 0xFF;
+		uint8 ByteOffset = 0x0;
+		uint8 BitIndex = 0x0;
+		bool bIsNativeBool = true;
+
+	public:
+		inline bool IsA(EClassCastFlags Flags) const
+		{
+			return (CastFlags & Flags);
+		}
+
+		/* True if any of the flags is set, same as UEProperty::IsType */
+		inline bool IsType(EClassCastFlags PossibleTypes) const
+		{
+			return (static_cast<uint64>(CastFlags) & static_cast<uint64>(PossibleTypes)) != 0;
+		}
+
+		inline bool HasPropertyFlags(EPropertyFlags Flags) const
+		{
+			return (PropertyFlags & Flags);
+		}
+
+		inline bool IsBitField() const
+		{
+			return IsA(EClassCastFlags::BoolProperty) && !bIsNativeBool;
+		}
+	};
+
+	struct FunctionNode
+	{
+		UEFunction Function = nullptr;
+
+		EFunctionFlags Flags = EFunctionFlags::None;
+
+		void* ExecFunction = nullptr;
+
+		HashStringTableIndex ValidName = HashStringTableIndex::FromInt(-1);
+	};
+
+private:
+	/* [StructMemberCache properties][inner properties], never resized after Init() */
+	static inline std::vector<PropertyNode> Properties;
+
+	/* Same order as StructMemberCache functions */
+	static inline std::vector<FunctionNode> Functions;
+
+	/* Address of a property -> index into 'Properties' */
+	static inline std::unordered_map<const void*, int32> PropertyLookup;
+
+	static inline HashStringTable Names;
+
+	/* First node of every type-shape, indexed by PropertyNode::TypeShape */
+	static inline std::vector<const PropertyNode*> TypeShapes;
+
+	/* Alignment of every type-shape, indexed by PropertyNode::TypeShape */
+	static inline std::vector<int32> ShapeAlignments;
+
+	static inline bool bIsInitialized = false;
+
+	/* Incremented by Reset(), thread-local detached nodes of an older generation reference names that were cleared */
+	static inline uint32 Generation = 0x0;
+
+private:
+	static void FillPropertyNode(PropertyNode& Node, UEProperty Prop);
+
+	/* Writes the inner-properties of this node into OutInner, returns the number of inner-properties */
+	static int32 GetInnerProperties(const PropertyNode& Node, UEProperty(&OutInner)[2]);
+
+	/* Assigns PropertyNode::TypeShape of all nodes, requires the Inner-pointers to be resolved */
+	static void InitTypeShapes();
+
+	/* Alignment of a newly interned shape, the alignments of its inner shapes have to be known already */
+	static int32 ResolveShapeAlignment(const PropertyNode& Node);
+
+	/* Thread-local record for properties that were created after Init(), eg. by a struct that was loaded late */
+	static const PropertyNode& GetDetachedNode(UEProperty Prop);
+
+public:
+	/* Extracts all properties and functions in StructMemberCache. Does nothing if the IR was already built. */
+	static void Init();
+
+	/* Drops all records. Not thread-safe, no generator may be running. */
+	static void Reset();
+
+	/* Memory used by all records and interned names, detached nodes of late properties are thread-local and not included */
+	static MemoryReport GetMemoryReport();
+
+	static inline bool IsInitialized()
+	{
+		return bIsInitialized;
+	}
+
+public:
+	/* Node of any property, falls back to extracting a thread-local node if the property is unknown to the IR */
+	static const PropertyNode& GetNode(UEProperty Prop);
+
+	/* Member-nodes of this struct, sorted like the properties in StructMemberCache. Empty if the struct is unknown. */
+	static std::span<const PropertyNode> GetProperties(int32 StructIndex);
+
+	/* Function-nodes of this struct in the order of the Children chain. Empty if the struct is unknown. */
+	static std::span<const FunctionNode> GetFunctions(int32 StructIndex);
+
+	static inline std::span<const PropertyNode> GetProperties(UEStruct Struct)
+	{
+		return GetProperties(Struct.GetIndex());
+	}
+
+	static inline std::span<const FunctionNode> GetFunctions(UEStruct Struct)
+	{
+		return GetFunctions(Struct.GetIndex());
+	}
+
+public:
+	/*
+	* Type-shapes are keyed by the property-class, the referenced struct/class/enum/function, the meta-class, size, bool-kind and the shapes of the
+	* inner-properties. Generators memoize their type-strings per shape, instead of rebuilding them for every member and parameter.
+	* 
+	* The shapes of inner-properties always have a lower id than the shapes containing them.
+	*/
+	static inline int32 GetNumTypeShapes()
+	{
+		return static_cast<int32>(TypeShapes.size());
+	}
+
+	static inline const PropertyNode& GetTypeShape(int32 TypeShape)
+	{
+		return *TypeShapes[TypeShape];
+	}
+
+	/* Same as UEProperty::GetAlignment, but resolved once per type-shape instead of recursing into structs, enums and optionals for every member */
+	static inline int32 GetAlignment(const PropertyNode& Node)
+	{
+		if (Node.TypeShape >= 0 && Node.TypeShape < static_cast<int32>(ShapeAlignments.size())) [[likely]]
+			return ShapeAlignments[Node.TypeShape];
+
+		return Node.Property.GetAlignment();
+	}
+
+	static inline std::string_view GetName(HashStringTableIndex Index)
+	{
+		return Names[Index].GetNameView();
+	}
+
+	static inline std::string_view GetName(const PropertyNode& Node)
+	{
+		return GetName(Node.Name);
+	}
+
+	static inline std::string_view GetValidName(const FunctionNode& Node)
+	{
+		return GetName(Node.ValidName);
+	}
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <condition_variable>
+
+#include "Unreal/Enums.h"
+
+class GeneratorContext;
+
+/*
+* Process-wide pool of worker-threads shared by all parallel phases of the generator.
+*
+* Every worker owns a queue. Tasks submitted from a worker go to its own queue and are popped LIFO by their owner, idle workers steal
+* the oldest tasks of other queues. Threads waiting for submitted work (ParallelFor, TaskGraph::Run) keep running pending tasks
+* meanwhile, so nesting parallel work inside of tasks can't deadlock the pool.
+*
+* Tasks run inside of the GeneratorContext of the thread that submitted them, see GeneratorContext.h.
+*
+* The workers are started by the first submission and must be stopped with Shutdown() before the module is unloaded.
+*/
+class WorkerPool
+{
+public:
+	using TaskType = std::function<void()>;
+
+private:
+	struct QueuedTask
+	{
+		TaskType Task;
+
+		/* Context of the submitting thread, nullptr if it wasn't running a generator */
+		const GeneratorContext* Context = nullptr;
+	};
+
+	struct WorkerQueue
+	{
+		std::mutex Lock;
+		std::deque<QueuedTask> Tasks;
+	};
+
+private:
+	/* The calling thread always takes part in the work, so one core is left to it */
+	static constexpr int32 MaxNumWorkers = 0x1F;
+
+private:
+	static inline std::vector<std::unique_ptr<WorkerQueue>> Queues;
+	static inline std::vector<std::thread> Workers;
+
+	static inline std::mutex StartStopLock;
+	static inline std::atomic<bool> bIsRunning = false;
+	static inline bool bShouldStop = false;
+
+	/* Number of tasks in all queues, workers only sleep while this is zero */
+	static inline std::atomic<int32> NumQueuedTasks = 0x0;
+
+	static inline std::mutex SleepLock;
+	static inline std::condition_variable WakeUp;
+
+	static inline std::atomic<uint32> NextExternalQueue = 0x0;
+
+	/* Index of the queue owned by this thread, -1 for threads outside of the pool */
+	static inline thread_local int32 OwnQueueIndex = -1;
+
+private:
+	static void Start();
+	static void WorkerMain(int32 QueueIndex);
+
+	static bool PopTask(QueuedTask& OutTask);
+
+	static void RunTask(QueuedTask& Task);
+
+public:
+	/* Queues a task to be run by any worker. Starts the pool if it isn't running yet. */
+	static void Submit(TaskType&& Task);
+
+	/* Runs one pending task on the calling thread, returns false if all queues were empty */
+	static bool TryRunPendingTask();
+
+	/* Calls Body(Index) for every Index in [0, NumItems) on the pool and the calling thread, returns once every call has finished */
+	static void ParallelFor(int32 NumItems, const std::function<void(int32 Index)>& Body);
+
+	/* Stops and joins all workers after they finished their queues. Submit() starts the pool again. */
+	static void Shutdown();
+
+public:
+	static inline int32 GetNumWorkers()
+	{
+		return static_cast<int32>(Workers.size());
+	}
+
+	static inline bool IsWorkerThread()
+	{
+		return OwnQueueIndex != -1;
+	}
+};
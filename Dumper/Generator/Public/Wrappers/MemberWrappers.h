@@ -1,10 +1,9 @@
 #pragma once
 
-#include <memory>
-
 #include "Unreal/ObjectArray.h"
 #include "Managers/CollisionManager.h"
 #include "Wrappers/StructWrapper.h"
+#include "TypeIR.h"
 
 class PropertyWrapper
 {
@@ -15,7 +14,11 @@ private:
         const PredefinedMember* PredefProperty;
     };
 
-    const std::shared_ptr<StructWrapper> Struct;
+    /* Pre-extracted facts about 'Property', nullptr for predefined members */
+    const TypeIR::PropertyNode* Node = nullptr;
+
+    /* Borrowed, see the lifetime rules of MemberIterator */
+    const StructWrapper* Struct;
 
     NameInfo Name;
 
@@ -24,9 +27,9 @@ private:
 public:
     PropertyWrapper(const PropertyWrapper&) = default;
 
-    PropertyWrapper(const std::shared_ptr<StructWrapper>& Str, const PredefinedMember* Predef);
+    PropertyWrapper(const StructWrapper* Str, const PredefinedMember* Predef);
 
-    PropertyWrapper(const std::shared_ptr<StructWrapper>& Str, UEProperty Prop);
+    PropertyWrapper(const StructWrapper* Str, UEProperty Prop);
 
 public:
     std::string GetName() const;
@@ -54,6 +57,7 @@ public:
     EPropertyFlags GetPropertyFlags() const;
 
     UEProperty GetUnrealProperty() const;
+    const TypeIR::PropertyNode& GetTypeNode() const;
 
     std::string GetDefaultValue() const;
 
@@ -86,16 +90,17 @@ private:
         const PredefinedFunction* PredefFunction;
     };
 
-    const std::shared_ptr<StructWrapper> Struct;
+    /* Borrowed, see the lifetime rules of MemberIterator */
+    const StructWrapper* Struct;
 
     NameInfo Name;
 
     bool bIsUnrealFunction = false;
 
 public:
-    FunctionWrapper(const std::shared_ptr<StructWrapper>& Str, const PredefinedFunction* Predef);
+    FunctionWrapper(const StructWrapper* Str, const PredefinedFunction* Predef);
 
-    FunctionWrapper(const std::shared_ptr<StructWrapper>& Str, UEFunction Func);
+    FunctionWrapper(const StructWrapper* Str, UEFunction Func);
 
 public:
     StructWrapper AsStruct() const;
@@ -1,8 +1,199 @@
 #pragma once
 
+#include <array>
+
 #include "Arch_x86.h"
 #include "Platform.h"
 
+namespace
+{
+	/* How the bytes following an opcode are laid out */
+	namespace OperandFlags
+	{
+		constexpr uint16_t None     = 0x000;
+		constexpr uint16_t ModRM    = 0x001;
+		constexpr uint16_t Imm8     = 0x002;
+		constexpr uint16_t Imm16    = 0x004;
+		constexpr uint16_t ImmZ     = 0x008; /* 2 bytes with an operand-size prefix, else 4 */
+		constexpr uint16_t ImmV     = 0x010; /* 8 bytes with REX.W, 2 with an operand-size prefix, else 4 */
+		constexpr uint16_t Rel32    = 0x020; /* Branch displacement, always 4 bytes in 64-bit mode */
+		constexpr uint16_t Moffs    = 0x040; /* Address-sized memory offset */
+		constexpr uint16_t GroupImm = 0x080; /* F6/F7 only have an immediate for /0 and /1 */
+		constexpr uint16_t Prefix   = 0x100;
+		constexpr uint16_t Vex      = 0x200; /* C4, C5 and 62 */
+		constexpr uint16_t Invalid  = 0x400;
+	}
+
+	constexpr bool bIs64BitMode = sizeof(void*) == 0x8;
+
+	constexpr int32_t MaxInstructionLength = 15;
+
+	using OpcodeTable = std::array<uint16_t, 0x100>;
+
+	consteval OpcodeTable BuildOneByteOpcodeTable()
+	{
+		using namespace OperandFlags;
+
+		OpcodeTable Table{};
+
+		auto Set = [&Table](int32_t First, int32_t Last, uint16_t Flags) -> void
+		{
+			for (int32_t i = First; i <= Last; i++)
+				Table[i] = Flags;
+		};
+
+		/* add, or, adc, sbb, and, sub, xor, cmp */
+		for (int32_t Row = 0x00; Row < 0x40; Row += 0x8)
+		{
+			Set(Row + 0x0, Row + 0x3, ModRM);
+			Set(Row + 0x4, Row + 0x4, Imm8);
+			Set(Row + 0x5, Row + 0x5, ImmZ);
+			Set(Row + 0x6, Row + 0x7, bIs64BitMode ? Invalid : None);
+		}
+
+		Set(0x0F, 0x0F, None); /* Escape, handled by the decoder */
+		Set(0x26, 0x26, Prefix);
+		Set(0x2E, 0x2E, Prefix);
+		Set(0x36, 0x36, Prefix);
+		Set(0x3E, 0x3E, Prefix);
+
+		Set(0x40, 0x5F, None); /* REX in 64-bit mode, else inc/dec. push/pop */
+		Set(0x60, 0x61, bIs64BitMode ? Invalid : None);
+		Set(0x62, 0x62, Vex);
+		Set(0x63, 0x63, ModRM);
+		Set(0x64, 0x67, Prefix);
+		Set(0x68, 0x68, ImmZ);
+		Set(0x69, 0x69, ModRM | ImmZ);
+		Set(0x6A, 0x6A, Imm8);
+		Set(0x6B, 0x6B, ModRM | Imm8);
+		Set(0x6C, 0x6F, None);
+		Set(0x70, 0x7F, Imm8);
+
+		Set(0x80, 0x80, ModRM | Imm8);
+		Set(0x81, 0x81, ModRM | ImmZ);
+		Set(0x82, 0x82, bIs64BitMode ? Invalid : (ModRM | Imm8));
+		Set(0x83, 0x83, ModRM | Imm8);
+		Set(0x84, 0x8F, ModRM);
+		Set(0x90, 0x9F, None);
+		Set(0x9A, 0x9A, bIs64BitMode ? Invalid : (ImmZ | Imm16));
+
+		Set(0xA0, 0xA3, Moffs);
+		Set(0xA4, 0xA7, None);
+		Set(0xA8, 0xA8, Imm8);
+		Set(0xA9, 0xA9, ImmZ);
+		Set(0xAA, 0xAF, None);
+		Set(0xB0, 0xB7, Imm8);
+		Set(0xB8, 0xBF, ImmV);
+
+		Set(0xC0, 0xC1, ModRM | Imm8);
+		Set(0xC2, 0xC2, Imm16);
+		Set(0xC3, 0xC3, None);
+		Set(0xC4, 0xC5, Vex);
+		Set(0xC6, 0xC6, ModRM | Imm8);
+		Set(0xC7, 0xC7, ModRM | ImmZ);
+		Set(0xC8, 0xC8, Imm16 | Imm8);
+		Set(0xC9, 0xC9, None);
+		Set(0xCA, 0xCA, Imm16);
+		Set(0xCB, 0xCC, None);
+		Set(0xCD, 0xCD, Imm8);
+		Set(0xCE, 0xCE, bIs64BitMode ? Invalid : None);
+		Set(0xCF, 0xCF, None);
+
+		Set(0xD0, 0xD3, ModRM);
+		Set(0xD4, 0xD5, bIs64BitMode ? Invalid : Imm8);
+		Set(0xD6, 0xD6, bIs64BitMode ? Invalid : None);
+		Set(0xD7, 0xD7, None);
+		Set(0xD8, 0xDF, ModRM);
+
+		Set(0xE0, 0xE7, Imm8);
+		Set(0xE8, 0xE9, bIs64BitMode ? Rel32 : ImmZ);
+		Set(0xEA, 0xEA, bIs64BitMode ? Invalid : (ImmZ | Imm16));
+		Set(0xEB, 0xEB, Imm8);
+		Set(0xEC, 0xEF, None);
+
+		Set(0xF0, 0xF0, Prefix);
+		Set(0xF1, 0xF1, None);
+		Set(0xF2, 0xF3, Prefix);
+		Set(0xF4, 0xF5, None);
+		Set(0xF6, 0xF7, ModRM | GroupImm);
+		Set(0xF8, 0xFD, None);
+		Set(0xFE, 0xFF, ModRM);
+
+		return Table;
+	}
+
+	/* Opcodes following 0x0F, the three-byte maps 0F 38 and 0F 3A are handled by the decoder */
+	consteval OpcodeTable BuildTwoByteOpcodeTable()
+	{
+		using namespace OperandFlags;
+
+		OpcodeTable Table{};
+
+		auto Set = [&Table](int32_t First, int32_t Last, uint16_t Flags) -> void
+		{
+			for (int32_t i = First; i <= Last; i++)
+				Table[i] = Flags;
+		};
+
+		Set(0x00, 0xFF, ModRM);
+
+		Set(0x04, 0x04, Invalid);
+		Set(0x05, 0x09, None); /* syscall, clts, sysret, invd, wbinvd */
+		Set(0x0A, 0x0A, Invalid);
+		Set(0x0B, 0x0B, None); /* ud2 */
+		Set(0x0C, 0x0C, Invalid);
+		Set(0x0E, 0x0E, None); /* femms */
+		Set(0x0F, 0x0F, ModRM | Imm8); /* 3DNow!, the opcode follows as an imm8 */
+		Set(0x24, 0x27, Invalid);
+		Set(0x30, 0x37, None); /* wrmsr, rdtsc, rdmsr, rdpmc, sysenter, sysexit, getsec */
+		Set(0x36, 0x36, Invalid);
+		Set(0x39, 0x39, Invalid);
+		Set(0x3B, 0x3F, Invalid);
+		Set(0x70, 0x73, ModRM | Imm8);
+		Set(0x77, 0x77, None); /* emms */
+		Set(0x7A, 0x7B, Invalid);
+		Set(0x80, 0x8F, bIs64BitMode ? Rel32 : ImmZ); /* jcc rel32 */
+		Set(0xA0, 0xA2, None); /* push fs, pop fs, cpuid */
+		Set(0xA4, 0xA4, ModRM | Imm8);
+		Set(0xA6, 0xA7, Invalid);
+		Set(0xA8, 0xAA, None); /* push gs, pop gs, rsm */
+		Set(0xAC, 0xAC, ModRM | Imm8);
+		Set(0xBA, 0xBA, ModRM | Imm8);
+		Set(0xC2, 0xC2, ModRM | Imm8);
+		Set(0xC4, 0xC6, ModRM | Imm8);
+		Set(0xC8, 0xCF, None); /* bswap */
+
+		return Table;
+	}
+
+	constexpr OpcodeTable OneByteOpcodes = BuildOneByteOpcodeTable();
+	constexpr OpcodeTable TwoByteOpcodes = BuildTwoByteOpcodeTable();
+
+	/* Flags for an instruction using a VEX or EVEX encoding, those always have a ModRM byte (except vzeroupper/vzeroall) */
+	constexpr uint16_t GetVexOperandFlags(uint8_t Map, uint8_t Opcode, bool bIsEvex)
+	{
+		using namespace OperandFlags;
+
+		switch (Map)
+		{
+		case 0x1:
+			if (Opcode == 0x77 && !bIsEvex)
+				return None;
+
+			return ModRM | (TwoByteOpcodes[Opcode] & Imm8);
+		case 0x2:
+			return ModRM;
+		case 0x3:
+			return ModRM | Imm8;
+		case 0x5: /* EVEX maps for FP16 instructions */
+		case 0x6:
+			return bIsEvex ? ModRM : Invalid;
+		default:
+			return Invalid;
+		}
+	}
+}
+
 // The processor (x86-64) only translates 52bits (or 57 bits) of a virtual address into a physical address and the unused bits need to be all 0 or all 1.
 bool Architecture_x86_64::IsValid64BitVirtualAddress(const uintptr_t Address)
 {
@@ -149,10 +340,15 @@ uintptr_t Architecture_x86_64::FindFunctionEnd(const uintptr_t Address, uint32_t
 	if (Range > 0xFFFF)
 		Range = 0xFFFF;
 
-	for (int i = 0; i < Range; i++)
+	/* Step over whole instructions, so bytes inside of operands aren't mistaken for a 'ret'. Undecodable bytes are skipped one at a time. */
+	for (uintptr_t Current = Address; Current < (Address + Range);)
 	{
-		if (IsFunctionRet(Address + i))
-			return Address + i;
+		if (IsFunctionRet(Current))
+			return Current;
+
+		const uint32_t Length = GetInstructionLength(Current);
+
+		Current += Length > 0x0 ? Length : 0x1;
 	}
 
 	return NULL;
@@ -188,6 +384,43 @@ uintptr_t Architecture_x86_64::GetRipRelativeCalledFunction(const uintptr_t Addr
 
 	int32_t NumCalls = 0;
 
+	/* Searching down, only look at real instructions so we don't count E8 bytes within other instructions */
+	if (OneBasedFuncIndex > 0)
+	{
+		InstructionInfo Info;
+
+		for (uintptr_t Current = Address; Current < (Address + 0xFFF); Current += Info.Length)
+		{
+			if (!DecodeInstruction(Current, Info))
+			{
+				Info.Length = 0x1;
+				continue;
+			}
+
+			if (Info.OpcodeMap != 0x0 || Info.Opcode != 0xE8)
+				continue;
+
+			const uintptr_t RelativeCallTarget = ResolveBranchTarget(Current);
+
+			if (!Platform::IsAddressInProcessRange(RelativeCallTarget))
+				continue;
+
+			if (++NumCalls == OneBasedFuncIndex)
+			{
+				if (IsWantedTarget && !IsWantedTarget(RelativeCallTarget))
+				{
+					--NumCalls;
+					continue;
+				}
+
+				return RelativeCallTarget;
+			}
+		}
+
+		return NULL;
+	}
+
+	/* Instructions can't be decoded backwards, so searching up still has to treat every E8 byte as a possible call */
 	const uint8_t* AsBytePtr = reinterpret_cast<const uint8_t*>(Address);
 
 	for (int i = 0; i < 0xFFF; i++)
@@ -218,4 +451,324 @@ uintptr_t Architecture_x86_64::GetRipRelativeCalledFunction(const uintptr_t Addr
 	}
 
 	return NULL;
-}
\ No newline at end of file
+}
+
+bool Architecture_x86_64::DecodeInstruction(const uintptr_t Address, InstructionInfo& OutInfo)
+{
+	using namespace OperandFlags;
+
+	OutInfo = InstructionInfo{};
+
+	if (!Address)
+		return false;
+
+	const uint8_t* Code = reinterpret_cast<const uint8_t*>(Address);
+
+	int32_t Pos = 0x0;
+
+	bool bHasOperandSizePrefix = false;
+	bool bHasAddressSizePrefix = false;
+	bool bIsRexW = false;
+
+	/* Legacy prefixes may appear in any order, REX has to be the last prefix to have an effect */
+	for (; Pos < MaxInstructionLength; Pos++)
+	{
+		const uint8_t Byte = Code[Pos];
+
+		if (OneByteOpcodes[Byte] & Prefix)
+		{
+			bHasOperandSizePrefix |= Byte == 0x66;
+			bHasAddressSizePrefix |= Byte == 0x67;
+			bIsRexW = false;
+			continue;
+		}
+
+		if (bIs64BitMode && (Byte & 0xF0) == 0x40)
+		{
+			bIsRexW = (Byte & 0x08) != 0x0;
+			continue;
+		}
+
+		break;
+	}
+
+	if (Pos >= MaxInstructionLength)
+		return false;
+
+	const uint8_t FirstOpcodeByte = Code[Pos++];
+
+	uint8_t Map = 0x0;
+	uint8_t Opcode = FirstOpcodeByte;
+	uint16_t Flags = OneByteOpcodes[FirstOpcodeByte];
+
+	/* Outside of 64-bit mode C4, C5 and 62 are only VEX/EVEX prefixes if the next byte would be a register-operand ModRM (les, lds, bound) */
+	const bool bIsVex = (Flags & Vex) && (bIs64BitMode || (Code[Pos] & 0xC0) == 0xC0);
+
+	if (bIsVex)
+	{
+		const bool bIsEvex = FirstOpcodeByte == 0x62;
+
+		if (FirstOpcodeByte == 0xC5)
+		{
+			Map = 0x1;
+			bIsRexW = false;
+			Pos += 1;
+		}
+		else if (FirstOpcodeByte == 0xC4)
+		{
+			Map = Code[Pos] & 0x1F;
+			bIsRexW = (Code[Pos + 1] & 0x80) != 0x0;
+			Pos += 2;
+		}
+		else
+		{
+			Map = Code[Pos] & 0x07;
+			bIsRexW = (Code[Pos + 1] & 0x80) != 0x0;
+			Pos += 3;
+		}
+
+		Opcode = Code[Pos++];
+		Flags = GetVexOperandFlags(Map, Opcode, bIsEvex);
+	}
+	else if (Flags & Vex)
+	{
+		Flags = ModRM;
+	}
+	else if (FirstOpcodeByte == 0x0F)
+	{
+		Map = 0x1;
+		Opcode = Code[Pos++];
+
+		if (Opcode == 0x38 || Opcode == 0x3A)
+		{
+			Map = Opcode == 0x38 ? 0x2 : 0x3;
+			Opcode = Code[Pos++];
+			Flags = Map == 0x2 ? ModRM : (ModRM | Imm8);
+		}
+		else
+		{
+			Flags = TwoByteOpcodes[Opcode];
+		}
+	}
+
+	if (Flags & Invalid)
+		return false;
+
+	uint8_t DisplacementSize = 0x0;
+
+	if (Flags & ModRM)
+	{
+		const uint8_t ModRMByte = Code[Pos++];
+
+		const uint8_t Mod = ModRMByte >> 6;
+		const uint8_t Reg = (ModRMByte >> 3) & 0x7;
+		const uint8_t RM = ModRMByte & 0x7;
+
+		OutInfo.ModRM = ModRMByte;
+		OutInfo.bHasModRM = true;
+
+		if (Flags & GroupImm)
+			Flags |= Reg < 0x2 ? (Opcode == 0xF6 ? Imm8 : ImmZ) : None;
+
+		/* 16-bit addressing doesn't have a SIB byte and uses different displacement sizes */
+		const bool bIs16BitAddressing = !bIs64BitMode && bHasAddressSizePrefix;
+
+		if (Mod != 0x3 && bIs16BitAddressing)
+		{
+			if (Mod == 0x1)
+				DisplacementSize = 0x1;
+			else if (Mod == 0x2 || (Mod == 0x0 && RM == 0x6))
+				DisplacementSize = 0x2;
+		}
+		else if (Mod != 0x3)
+		{
+			if (RM == 0x4)
+			{
+				const uint8_t SIB = Code[Pos++];
+
+				if (Mod == 0x0 && (SIB & 0x7) == 0x5)
+					DisplacementSize = 0x4;
+			}
+
+			if (Mod == 0x0 && RM == 0x5)
+			{
+				DisplacementSize = 0x4;
+				OutInfo.bIsRipRelative = bIs64BitMode;
+			}
+			else if (Mod == 0x1)
+			{
+				DisplacementSize = 0x1;
+			}
+			else if (Mod == 0x2)
+			{
+				DisplacementSize = 0x4;
+			}
+		}
+	}
+
+	OutInfo.DisplacementOffset = DisplacementSize > 0x0 ? static_cast<uint8_t>(Pos) : 0x0;
+	OutInfo.DisplacementSize = DisplacementSize;
+
+	Pos += DisplacementSize;
+
+	uint8_t ImmediateSize = 0x0;
+
+	if (Flags & Imm8)
+		ImmediateSize += 0x1;
+
+	if (Flags & Imm16)
+		ImmediateSize += 0x2;
+
+	if (Flags & ImmZ)
+		ImmediateSize += (bHasOperandSizePrefix && !bIsRexW) ? 0x2 : 0x4;
+
+	if (Flags & ImmV)
+		ImmediateSize += bIsRexW ? 0x8 : (bHasOperandSizePrefix ? 0x2 : 0x4);
+
+	if (Flags & Rel32)
+		ImmediateSize += 0x4;
+
+	if (Flags & Moffs)
+		ImmediateSize += bIs64BitMode ? (bHasAddressSizePrefix ? 0x4 : 0x8) : (bHasAddressSizePrefix ? 0x2 : 0x4);
+
+	OutInfo.ImmediateOffset = ImmediateSize > 0x0 ? static_cast<uint8_t>(Pos) : 0x0;
+	OutInfo.ImmediateSize = ImmediateSize;
+
+	Pos += ImmediateSize;
+
+	if (Pos > MaxInstructionLength)
+		return false;
+
+	OutInfo.Length = static_cast<uint8_t>(Pos);
+	OutInfo.OpcodeMap = Map;
+	OutInfo.Opcode = Opcode;
+
+	return true;
+}
+
+uint32_t Architecture_x86_64::GetInstructionLength(const uintptr_t Address)
+{
+	InstructionInfo Info;
+
+	return DecodeInstruction(Address, Info) ? Info.Length : 0x0;
+}
+
+uintptr_t Architecture_x86_64::GetNextInstruction(const uintptr_t Address)
+{
+	const uint32_t Length = GetInstructionLength(Address);
+
+	return Length > 0x0 ? Address + Length : NULL;
+}
+
+uintptr_t Architecture_x86_64::GetRipRelativeTarget(const uintptr_t Address, const InstructionInfo& Info)
+{
+	if (!Info.bIsRipRelative)
+		return NULL;
+
+	const int32_t Displacement = *reinterpret_cast<const int32_t*>(Address + Info.DisplacementOffset);
+
+	/* Relative to the next instruction, not to the end of the displacement */
+	return Address + Info.Length + Displacement;
+}
+
+uintptr_t Architecture_x86_64::FindFirstRipRelativeTarget(const uintptr_t Address, uint32_t Range, uintptr_t* OutInstructionAddress)
+{
+	if (!Address)
+		return NULL;
+
+	InstructionInfo Info;
+
+	for (uintptr_t Current = Address; Current < (Address + Range); Current += Info.Length)
+	{
+		if (!DecodeInstruction(Current, Info))
+			return NULL;
+
+		if (!Info.bIsRipRelative)
+			continue;
+
+		if (OutInstructionAddress)
+			*OutInstructionAddress = Current;
+
+		return GetRipRelativeTarget(Current, Info);
+	}
+
+	return NULL;
+}
+
+uintptr_t Architecture_x86_64::ResolveBranchTarget(const uintptr_t Address)
+{
+	InstructionInfo Info;
+
+	if (!DecodeInstruction(Address, Info))
+		return NULL;
+
+	const uintptr_t NextInstruction = Address + Info.Length;
+
+	if (Info.OpcodeMap == 0x0)
+	{
+		/* call/jmp rel32 */
+		if (Info.Opcode == 0xE8 || Info.Opcode == 0xE9)
+			return NextInstruction + *reinterpret_cast<const int32_t*>(Address + Info.ImmediateOffset);
+
+		/* jmp rel8, jcc rel8 */
+		if (Info.Opcode == 0xEB || (Info.Opcode >= 0x70 && Info.Opcode <= 0x7F))
+			return NextInstruction + *reinterpret_cast<const int8_t*>(Address + Info.ImmediateOffset);
+
+		/* call/jmp through a pointer, FF /2 and FF /4 */
+		const uint8_t Reg = (Info.ModRM >> 3) & 0x7;
+
+		if (Info.Opcode != 0xFF || (Reg != 0x2 && Reg != 0x4))
+			return NULL;
+
+		uintptr_t PointerAddress = NULL;
+
+		if (Info.bIsRipRelative)
+		{
+			PointerAddress = GetRipRelativeTarget(Address, Info);
+		}
+		else if constexpr (!bIs64BitMode)
+		{
+			/* mod = 0, rm = 5 is an absolute address outside of 64-bit mode */
+			if ((Info.ModRM & 0xC7) == 0x05)
+				PointerAddress = *reinterpret_cast<const uint32_t*>(Address + Info.DisplacementOffset);
+		}
+
+		if (!PointerAddress || Platform::IsBadReadPtr(reinterpret_cast<const void*>(PointerAddress)))
+			return NULL;
+
+		return *reinterpret_cast<const uintptr_t*>(PointerAddress);
+	}
+
+	/* jcc rel32 */
+	if (Info.OpcodeMap == 0x1 && Info.Opcode >= 0x80 && Info.Opcode <= 0x8F)
+		return NextInstruction + *reinterpret_cast<const int32_t*>(Address + Info.ImmediateOffset);
+
+	return NULL;
+}
+
+uintptr_t Architecture_x86_64::FollowThunks(const uintptr_t Address, int32_t MaxDepth)
+{
+	uintptr_t Current = Address;
+
+	for (int i = 0; i < MaxDepth; i++)
+	{
+		InstructionInfo Info;
+
+		if (!DecodeInstruction(Current, Info) || Info.OpcodeMap != 0x0)
+			break;
+
+		const bool bIsIndirectJump = Info.Opcode == 0xFF && ((Info.ModRM >> 3) & 0x7) == 0x4;
+
+		if (Info.Opcode != 0xE9 && Info.Opcode != 0xEB && !bIsIndirectJump)
+			break;
+
+		const uintptr_t Target = ResolveBranchTarget(Current);
+
+		if (!Target || !Platform::IsAddressInProcessRange(Target))
+			break;
+
+		Current = Target;
+	}
+
+	return Current;
+}
@@ -3,6 +3,28 @@
 
 namespace Architecture_x86_64
 {
+	/* Result of DecodeInstruction. All offsets are relative to the start of the instruction, sizes are 0 if the instruction has no such operand. */
+	struct InstructionInfo
+	{
+		uint8_t Length = 0x0;
+
+		/* 0 = one-byte map, 1 = 0F, 2 = 0F 38, 3 = 0F 3A. VEX/EVEX instructions report the map they encode. */
+		uint8_t OpcodeMap = 0x0;
+		uint8_t Opcode = 0x0;
+
+		uint8_t ModRM = 0x0;
+		bool bHasModRM = false;
+
+		/* Displacement is relative to the next instruction, see GetRipRelativeTarget */
+		bool bIsRipRelative = false;
+
+		uint8_t DisplacementOffset = 0x0;
+		uint8_t DisplacementSize = 0x0;
+
+		uint8_t ImmediateOffset = 0x0;
+		uint8_t ImmediateSize = 0x0;
+	};
+
 	bool IsValid64BitVirtualAddress(const uintptr_t Address);
 	bool IsValid64BitVirtualAddress(const void* Address);
 
@@ -39,5 +61,33 @@ namespace Architecture_x86_64
 	* IsWantedTarget -> Allows for the caller to pass a callback to verify, that the function at index n is the target we're looking for; else continue searching for a valid target.
 	*/
 	uintptr_t GetRipRelativeCalledFunction(const uintptr_t Address, const int32_t OneBasedFuncIndex, bool(*IsWantedTarget)(const uintptr_t CalledAddr) = nullptr);
-}
 
+	/*
+	* Table-driven length-decoder for x86 and x86-64 instructions, including VEX and EVEX encoded ones.
+	*
+	* Only the layout of an instruction is decoded (prefixes, opcode, ModRM, SIB, displacement and immediate), not its semantics.
+	* Returns false for invalid opcodes, or instructions longer than 15 bytes.
+	*/
+	bool DecodeInstruction(const uintptr_t Address, InstructionInfo& OutInfo);
+
+	/* Returns 0 if the instruction couldn't be decoded */
+	uint32_t GetInstructionLength(const uintptr_t Address);
+
+	/* Returns NULL if the instruction couldn't be decoded */
+	uintptr_t GetNextInstruction(const uintptr_t Address);
+
+	/* Target of the RIP-relative memory operand of an already decoded instruction, NULL if it has none */
+	uintptr_t GetRipRelativeTarget(const uintptr_t Address, const InstructionInfo& Info);
+
+	/* Walks instruction by instruction and returns the target of the first RIP-relative memory operand within 'Range' bytes, NULL if there is none */
+	uintptr_t FindFirstRipRelativeTarget(const uintptr_t Address, uint32_t Range = 0x100, uintptr_t* OutInstructionAddress = nullptr);
+
+	/*
+	* Resolves the target of a direct jmp/jcc/call, or of an indirect jmp/call through a RIP-relative (x64) or absolute (x86) pointer.
+	* Returns NULL if the instruction at 'Address' is none of those.
+	*/
+	uintptr_t ResolveBranchTarget(const uintptr_t Address);
+
+	/* Follows chains of unconditional jumps (incremental-linking thunks, import stubs) and returns the address of the first instruction that isn't one */
+	uintptr_t FollowThunks(const uintptr_t Address, int32_t MaxDepth = 0x8);
+}
@@ -0,0 +1,424 @@
+#include <format>
+#include <vector>
+#include <fstream>
+#include <cstring>
+#include <optional>
+#include <iostream>
+#include <algorithm>
+
+#include <Windows.h>
+
+#define ZSTD_STATIC_LINKING_ONLY
+#include "../../Utils/Compression/zstd.h"
+
+#include "MemorySnapshot.h"
+#include "PlatformWindows.h"
+
+namespace
+{
+	/* Snapshots are written from inside the game, speed matters more than size */
+	constexpr int CompressionLevel = 1;
+
+	/* Regions are enumerated once before copying, the region-table gets this much headroom for regions allocated in between */
+	constexpr size_t RegionSlack = 0x1000;
+
+	constexpr uintptr_t AllocationGranularity = 0x10000;
+
+	constexpr DWORD ReadableMask = (PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY);
+	constexpr DWORD WritableMask = (PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY);
+	constexpr DWORD InaccessibleMask = (PAGE_GUARD | PAGE_NOACCESS);
+
+	bool bIsReplaying = false;
+
+	inline uintptr_t AlignDown(uintptr_t Value, uintptr_t Alignment)
+	{
+		return Value & ~(Alignment - 1);
+	}
+
+	inline uintptr_t AlignUp(uintptr_t Value, uintptr_t Alignment)
+	{
+		return (Value + Alignment - 1) & ~(Alignment - 1);
+	}
+
+	inline uint64_t GetNumChunks(uint64_t RegionSize)
+	{
+		return (RegionSize + MemorySnapshot::ChunkSize - 1) / MemorySnapshot::ChunkSize;
+	}
+
+	/* Private memory and the image of the main module. Other modules are loaded at the same addresses in the replaying process. */
+	inline bool IsCapturedRegion(const MEMORY_BASIC_INFORMATION& Mbi, uintptr_t ImageBase, const void* OwnBuffer)
+	{
+		if (Mbi.State != MEM_COMMIT || !(Mbi.Protect & ReadableMask) || (Mbi.Protect & InaccessibleMask))
+			return false;
+
+		if (Mbi.AllocationBase == OwnBuffer)
+			return false;
+
+		return Mbi.Type == MEM_PRIVATE || (Mbi.Type == MEM_IMAGE && reinterpret_cast<uintptr_t>(Mbi.AllocationBase) == ImageBase);
+	}
+
+	/* VirtualQuery doesn't allocate, this is safe to call while the other threads are suspended */
+	template<typename CallbackType>
+	inline void IterateRegions(CallbackType&& Callback)
+	{
+		SYSTEM_INFO SystemInfo;
+		GetSystemInfo(&SystemInfo);
+
+		const uintptr_t MaxAddress = reinterpret_cast<uintptr_t>(SystemInfo.lpMaximumApplicationAddress);
+
+		MEMORY_BASIC_INFORMATION Mbi;
+
+		for (uintptr_t Address = reinterpret_cast<uintptr_t>(SystemInfo.lpMinimumApplicationAddress); Address < MaxAddress; Address = reinterpret_cast<uintptr_t>(Mbi.BaseAddress) + Mbi.RegionSize)
+		{
+			if (!VirtualQuery(reinterpret_cast<void*>(Address), &Mbi, sizeof(Mbi)) || Mbi.RegionSize == 0x0)
+				break;
+
+			Callback(Mbi);
+		}
+	}
+
+	bool WriteAll(HANDLE File, const void* Data, uint64_t Size)
+	{
+		const uint8_t* Current = static_cast<const uint8_t*>(Data);
+
+		while (Size > 0x0)
+		{
+			const DWORD BytesToWrite = static_cast<DWORD>(std::min<uint64_t>(Size, 0x40000000));
+			DWORD BytesWritten = 0x0;
+
+			if (!WriteFile(File, Current, BytesToWrite, &BytesWritten, nullptr) || BytesWritten != BytesToWrite)
+				return false;
+
+			Current += BytesWritten;
+			Size -= BytesWritten;
+		}
+
+		return true;
+	}
+
+	std::string ToDisplayString(const std::filesystem::path& FilePath)
+	{
+		const std::u8string U8Path = FilePath.u8string();
+
+		return reinterpret_cast<const std::string&>(U8Path);
+	}
+}
+
+
+bool MemorySnapshot::Capture(const std::filesystem::path& FilePath, const PropertyList& Properties, bool bFreezeProcess)
+{
+	const uintptr_t ImageBase = PlatformWindows::GetModuleBase();
+	const PIMAGE_NT_HEADERS NtHeader = reinterpret_cast<PIMAGE_NT_HEADERS>(ImageBase + reinterpret_cast<PIMAGE_DOS_HEADER>(ImageBase)->e_lfanew);
+
+	HANDLE File = CreateFileW(FilePath.c_str(), GENERIC_WRITE, 0x0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+	if (File == INVALID_HANDLE_VALUE)
+	{
+		std::cerr << std::format("Could not create the memory-snapshot '{}'!\n", ToDisplayString(FilePath));
+		return false;
+	}
+
+	/* Everything used while copying is allocated up front, the suspended threads might hold the heap-lock */
+	const size_t WorkspaceSize = AlignUp(ZSTD_estimateCCtxSize(CompressionLevel), 0x1000);
+	const size_t OutputSize = ZSTD_compressBound(ChunkSize);
+
+	uint8_t* const Buffer = static_cast<uint8_t*>(VirtualAlloc(nullptr, WorkspaceSize + ChunkSize + OutputSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+
+	if (!Buffer)
+	{
+		CloseHandle(File);
+		return false;
+	}
+
+	uint8_t* const Staging = Buffer + WorkspaceSize;
+	uint8_t* const Output = Staging + ChunkSize;
+
+	ZSTD_CCtx* const Context = ZSTD_initStaticCCtx(Buffer, WorkspaceSize);
+
+	size_t NumRegions = 0x0;
+	uint64_t NumChunks = 0x0;
+
+	IterateRegions([&](const MEMORY_BASIC_INFORMATION& Mbi) -> void
+	{
+		if (!IsCapturedRegion(Mbi, ImageBase, Buffer))
+			return;
+
+		NumRegions++;
+		NumChunks += GetNumChunks(Mbi.RegionSize);
+	});
+
+	std::vector<RegionEntry> Regions;
+	Regions.reserve(NumRegions + RegionSlack);
+
+	std::vector<uint32_t> ChunkSizes;
+	ChunkSizes.reserve(NumChunks + (NumChunks / 4) + RegionSlack);
+
+	SnapshotHeader Header = {};
+	bool bWriteFailed = !WriteAll(File, &Header, sizeof(Header));
+	bool bWasTruncated = false;
+
+	uint64_t NumBytesCaptured = 0x0;
+
+	std::optional<PlatformWindows::ThreadFreeze> Freeze;
+
+	if (bFreezeProcess)
+		Freeze.emplace();
+
+	IterateRegions([&](const MEMORY_BASIC_INFORMATION& Mbi) -> void
+	{
+		if (bWriteFailed || bWasTruncated || !IsCapturedRegion(Mbi, ImageBase, Buffer))
+			return;
+
+		const uintptr_t RegionStart = reinterpret_cast<uintptr_t>(Mbi.BaseAddress);
+		const uint64_t RegionSize = Mbi.RegionSize;
+
+		/* push_back must never reallocate in here, regions beyond the reserved capacity are dropped */
+		if (Regions.size() == Regions.capacity() || (ChunkSizes.size() + GetNumChunks(RegionSize)) > ChunkSizes.capacity())
+		{
+			bWasTruncated = true;
+			return;
+		}
+
+		Regions.push_back({ RegionStart, RegionSize, Mbi.Protect, 0x0 });
+
+		for (uint64_t Offset = 0x0; Offset < RegionSize; Offset += ChunkSize)
+		{
+			const size_t BytesToCopy = static_cast<size_t>(std::min<uint64_t>(ChunkSize, RegionSize - Offset));
+
+			/* The game may free the region while it's copied if it isn't suspended, ReadProcessMemory fails instead of crashing */
+			SIZE_T BytesRead = 0x0;
+
+			if (!ReadProcessMemory(GetCurrentProcess(), reinterpret_cast<LPCVOID>(RegionStart + Offset), Staging, BytesToCopy, &BytesRead))
+				BytesRead = 0x0;
+
+			if (BytesRead < BytesToCopy)
+				memset(Staging + BytesRead, 0x0, BytesToCopy - BytesRead);
+
+			const size_t CompressedSize = ZSTD_compressCCtx(Context, Output, OutputSize, Staging, BytesToCopy, CompressionLevel);
+
+			if (ZSTD_isError(CompressedSize) || !WriteAll(File, Output, CompressedSize))
+			{
+				bWriteFailed = true;
+				return;
+			}
+
+			ChunkSizes.push_back(static_cast<uint32_t>(CompressedSize));
+		}
+
+		NumBytesCaptured += RegionSize;
+	});
+
+	const int32_t NumSuspendedThreads = Freeze ? Freeze->GetNumSuspendedThreads() : 0x0;
+	Freeze.reset();
+
+	VirtualFree(Buffer, 0x0, MEM_RELEASE);
+
+	LARGE_INTEGER TableOffset = {};
+	bWriteFailed = bWriteFailed || !SetFilePointerEx(File, LARGE_INTEGER{}, &TableOffset, FILE_CURRENT);
+
+	/* A region that failed half-way has no complete chunk-list, drop it */
+	if (bWriteFailed && !Regions.empty())
+		Regions.pop_back();
+
+	bWriteFailed = !WriteAll(File, Regions.data(), Regions.size() * sizeof(RegionEntry)) || bWriteFailed;
+	bWriteFailed = !WriteAll(File, ChunkSizes.data(), ChunkSizes.size() * sizeof(uint32_t)) || bWriteFailed;
+
+	for (const auto& [Key, Value] : Properties)
+	{
+		const uint32_t Lengths[2] = { static_cast<uint32_t>(Key.size()), static_cast<uint32_t>(Value.size()) };
+
+		bWriteFailed = !WriteAll(File, Lengths, sizeof(Lengths)) || !WriteAll(File, Key.data(), Key.size()) || !WriteAll(File, Value.data(), Value.size()) || bWriteFailed;
+	}
+
+	Header.Magic = SnapshotMagic;
+	Header.Version = SnapshotVersion;
+	Header.ImageBase = ImageBase;
+	Header.ImageSize = NtHeader->OptionalHeader.SizeOfImage;
+	Header.TableOffset = static_cast<uint64_t>(TableOffset.QuadPart);
+	Header.NumRegions = static_cast<uint32_t>(Regions.size());
+	Header.NumProperties = static_cast<uint32_t>(Properties.size());
+	Header.ChunkSize = ChunkSize;
+
+	bWriteFailed = !SetFilePointerEx(File, LARGE_INTEGER{}, nullptr, FILE_BEGIN) || !WriteAll(File, &Header, sizeof(Header)) || bWriteFailed;
+
+	CloseHandle(File);
+
+	if (bWriteFailed)
+	{
+		std::cerr << std::format("Error writing the memory-snapshot '{}'!\n", ToDisplayString(FilePath));
+		return false;
+	}
+
+	if (bWasTruncated)
+		std::cerr << "The game allocated too many regions while the memory-snapshot was written, it is incomplete.\n";
+
+	std::cerr << std::format("Captured {} regions ({:.2f}MiB) into '{}'", Regions.size(), NumBytesCaptured / (1024.0 * 1024.0), ToDisplayString(FilePath));
+	std::cerr << (NumSuspendedThreads > 0 ? std::format(", {} game-threads were suspended.\n\n", NumSuspendedThreads) : std::string(".\n\n"));
+
+	return true;
+}
+
+bool MemorySnapshot::Replay(const std::filesystem::path& FilePath, PropertyList& OutProperties)
+{
+	std::ifstream File(FilePath, std::ios::binary);
+
+	if (!File.is_open())
+	{
+		std::cerr << std::format("Could not open the memory-snapshot '{}'!\n", ToDisplayString(FilePath));
+		return false;
+	}
+
+	SnapshotHeader Header = {};
+	File.read(reinterpret_cast<char*>(&Header), sizeof(Header));
+
+	if (!File || Header.Magic != SnapshotMagic || Header.Version != SnapshotVersion || Header.ChunkSize != ChunkSize)
+	{
+		std::cerr << std::format("'{}' is not a memory-snapshot of this version of Dumper-7!\n", ToDisplayString(FilePath));
+		return false;
+	}
+
+	std::vector<RegionEntry> Regions(Header.NumRegions);
+
+	File.seekg(Header.TableOffset);
+	File.read(reinterpret_cast<char*>(Regions.data()), Regions.size() * sizeof(RegionEntry));
+
+	uint64_t NumChunks = 0x0;
+
+	for (const RegionEntry& Region : Regions)
+		NumChunks += GetNumChunks(Region.Size);
+
+	std::vector<uint32_t> ChunkSizes(NumChunks);
+	File.read(reinterpret_cast<char*>(ChunkSizes.data()), ChunkSizes.size() * sizeof(uint32_t));
+
+	OutProperties.clear();
+	OutProperties.reserve(Header.NumProperties);
+
+	for (uint32_t i = 0; i < Header.NumProperties && File; i++)
+	{
+		uint32_t Lengths[2] = {};
+		File.read(reinterpret_cast<char*>(Lengths), sizeof(Lengths));
+
+		std::string Key(Lengths[0], '\0');
+		std::string Value(Lengths[1], '\0');
+
+		File.read(Key.data(), Key.size());
+		File.read(Value.data(), Value.size());
+
+		OutProperties.emplace_back(std::move(Key), std::move(Value));
+	}
+
+	if (!File)
+	{
+		std::cerr << std::format("The memory-snapshot '{}' is truncated!\n", ToDisplayString(FilePath));
+		return false;
+	}
+
+	/*
+	* The address-ranges of all regions are reserved before any of them is filled, so allocations of this process can't take them in the meantime.
+	* Regions sharing an allocation-granule are reserved together, a page-range must be inside of a single reservation to be committed.
+	*/
+	std::vector<bool> IsRegionMapped(Regions.size(), false);
+
+	for (size_t First = 0; First < Regions.size();)
+	{
+		const uintptr_t ReserveStart = AlignDown(Regions[First].Start, AllocationGranularity);
+		uintptr_t ReserveEnd = AlignUp(Regions[First].Start + Regions[First].Size, AllocationGranularity);
+
+		size_t Last = First + 1;
+
+		while (Last < Regions.size() && AlignDown(Regions[Last].Start, AllocationGranularity) < ReserveEnd)
+		{
+			ReserveEnd = std::max<uintptr_t>(ReserveEnd, AlignUp(Regions[Last].Start + Regions[Last].Size, AllocationGranularity));
+			Last++;
+		}
+
+		if (VirtualAlloc(reinterpret_cast<void*>(ReserveStart), ReserveEnd - ReserveStart, MEM_RESERVE, PAGE_NOACCESS))
+		{
+			for (size_t i = First; i < Last; i++)
+				IsRegionMapped[i] = VirtualAlloc(reinterpret_cast<void*>(Regions[i].Start), Regions[i].Size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+		}
+
+		First = Last;
+	}
+
+	ZSTD_DCtx* const Context = ZSTD_createDCtx();
+	std::vector<char> CompressedChunk;
+
+	size_t NumMappedRegions = 0x0;
+	uint64_t NumSkippedBytes = 0x0;
+	uint64_t ChunkIndex = 0x0;
+
+	File.seekg(sizeof(SnapshotHeader));
+
+	for (size_t i = 0; i < Regions.size(); i++)
+	{
+		const RegionEntry& Region = Regions[i];
+
+		for (uint64_t Offset = 0x0; Offset < Region.Size; Offset += ChunkSize, ChunkIndex++)
+		{
+			const uint32_t CompressedSize = ChunkSizes[ChunkIndex];
+
+			if (!IsRegionMapped[i])
+			{
+				File.seekg(CompressedSize, std::ios::cur);
+				continue;
+			}
+
+			CompressedChunk.resize(CompressedSize);
+			File.read(CompressedChunk.data(), CompressedSize);
+
+			const size_t ChunkBytes = static_cast<size_t>(std::min<uint64_t>(ChunkSize, Region.Size - Offset));
+			void* const Destination = reinterpret_cast<void*>(Region.Start + Offset);
+
+			if (!File || ZSTD_decompressDCtx(Context, Destination, ChunkBytes, CompressedChunk.data(), CompressedSize) != ChunkBytes)
+			{
+				ZSTD_freeDCtx(Context);
+				std::cerr << std::format("The memory-snapshot '{}' is corrupted!\n", ToDisplayString(FilePath));
+				return false;
+			}
+		}
+
+		if (!IsRegionMapped[i])
+		{
+			NumSkippedBytes += Region.Size;
+			continue;
+		}
+
+		/* Game-code stays readable only, it's never run */
+		DWORD OldProtect = 0x0;
+		VirtualProtect(reinterpret_cast<void*>(Region.Start), Region.Size, (Region.Protect & WritableMask) ? PAGE_READWRITE : PAGE_READONLY, &OldProtect);
+
+		NumMappedRegions++;
+	}
+
+	ZSTD_freeDCtx(Context);
+
+	auto It = std::find_if(Regions.begin(), Regions.end(), [&Header](const RegionEntry& Region) { return Region.Start == Header.ImageBase; });
+
+	if (It == Regions.end() || !IsRegionMapped[It - Regions.begin()])
+	{
+		std::cerr << std::format("The main module of the memory-snapshot '{}' couldn't be mapped to 0x{:X}!\n", ToDisplayString(FilePath), Header.ImageBase);
+		return false;
+	}
+
+	PlatformWindows::SetMainModuleOverride(static_cast<uintptr_t>(Header.ImageBase));
+
+	bIsReplaying = true;
+
+	std::cerr << std::format("Mapped {} of {} regions of '{}'", NumMappedRegions, Regions.size(), ToDisplayString(FilePath));
+	std::cerr << (NumSkippedBytes > 0 ? std::format(", {:.2f}MiB overlapped memory of this process.\n\n", NumSkippedBytes / (1024.0 * 1024.0)) : std::string(".\n\n"));
+
+	return true;
+}
+
+bool MemorySnapshot::IsReplaying()
+{
+	return bIsReplaying;
+}
+
+std::string MemorySnapshot::FindProperty(const PropertyList& Properties, const std::string& Key)
+{
+	auto It = std::find_if(Properties.begin(), Properties.end(), [&Key](const auto& Property) { return Property.first == Key; });
+
+	return It != Properties.end() ? It->second : std::string();
+}
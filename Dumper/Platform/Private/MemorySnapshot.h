@@ -0,0 +1,82 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <filesystem>
+
+/*
+Interface:
+	- bool Capture(const std::filesystem::path& FilePath, const PropertyList& Properties, bool bFreezeProcess)
+	- bool Replay(const std::filesystem::path& FilePath, PropertyList& OutProperties)
+	- bool IsReplaying()
+	-
+	- std::string FindProperty(const PropertyList& Properties, const std::string& Key)
+*/
+
+/*
+* Captures the memory of the game into a file, and maps it back into another process later, so the dumper can run on it without the game.
+*
+* A snapshot holds every readable private region of the process and the image of the main module, but no other modules. System-modules are loaded
+* at the same addresses in every process, they couldn't be mapped back and the dumper never reads them. Regions are stored in zstd-compressed chunks.
+*
+* Replay maps every region back to the address it was captured at, so the raw pointers stored in game-memory stay valid and no address has to be
+* translated. Nothing is executed, the game-code in the snapshot is only readable. Regions that overlap memory of the replaying process are skipped.
+*/
+namespace MemorySnapshot
+{
+	/* Named values stored alongside the memory, like the offsets that were found when the snapshot was taken */
+	using PropertyList = std::vector<std::pair<std::string, std::string>>;
+
+	inline constexpr uint32_t SnapshotMagic = 0x534D3744; // 'D7MS'
+	inline constexpr uint32_t SnapshotVersion = 1;
+
+	/* Regions are compressed in chunks of this size, replaying decompresses them straight into the mapped region */
+	inline constexpr uint32_t ChunkSize = 0x100000;
+
+	/*
+	* File layout, all values are little-endian:
+	*	SnapshotHeader
+	*	Compressed chunks of all regions, in the order of the region-table
+	*	RegionEntry[NumRegions] at TableOffset
+	*	uint32_t CompressedChunkSizes[NumChunks], NumChunks is the sum of ceil(Size / ChunkSize) of all regions
+	*	NumProperties times: uint32_t KeyLength, uint32_t ValueLength, Key, Value
+	*/
+	struct SnapshotHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint64_t ImageBase;
+		uint64_t ImageSize;
+		uint64_t TableOffset;
+		uint32_t NumRegions;
+		uint32_t NumProperties;
+		uint32_t ChunkSize;
+		uint32_t Reserved;
+	};
+
+	struct RegionEntry
+	{
+		uint64_t Start;
+		uint64_t Size;
+		uint32_t Protect;
+		uint32_t Reserved;
+	};
+
+	static_assert(sizeof(SnapshotHeader) == 0x30 && sizeof(RegionEntry) == 0x18);
+
+	/*
+	* Writes all readable memory of this process to 'FilePath'. With 'bFreezeProcess' every other thread is suspended while memory is copied,
+	* so the snapshot is consistent. Nothing is allocated on the heap while the threads are suspended.
+	*/
+	bool Capture(const std::filesystem::path& FilePath, const PropertyList& Properties, bool bFreezeProcess);
+
+	/* Maps the memory of the snapshot back to its original addresses. Afterwards Platform::GetModuleBase() returns the main module of the game. */
+	bool Replay(const std::filesystem::path& FilePath, PropertyList& OutProperties);
+
+	bool IsReplaying();
+
+	/* Empty if there is no property 'Key' */
+	std::string FindProperty(const PropertyList& Properties, const std::string& Key);
+}
@@ -0,0 +1,490 @@
+#include <bit>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <immintrin.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "PatternScan.h"
+
+namespace
+{
+	using namespace PatternScan;
+
+	/* Rough frequency of byte-values in x86-64 code, lower means rarer. Wildcards are weighted worse than any byte. */
+	constexpr std::array<uint8_t, 0x100> ByteFrequencies = []() consteval
+	{
+		std::array<uint8_t, 0x100> Frequencies = {};
+
+		for (auto& Frequency : Frequencies)
+			Frequency = 0x04;
+
+		Frequencies[0x00] = 0xFF;
+		Frequencies[0xFF] = 0xA0;
+		Frequencies[0x48] = 0xC0;
+		Frequencies[0x8B] = 0xB0;
+		Frequencies[0x89] = 0x80;
+		Frequencies[0xCC] = 0x80;
+		Frequencies[0x4C] = 0x60;
+		Frequencies[0x24] = 0x60;
+		Frequencies[0x44] = 0x50;
+		Frequencies[0x8D] = 0x50;
+		Frequencies[0x0F] = 0x50;
+		Frequencies[0xE8] = 0x40;
+		Frequencies[0x40] = 0x40;
+		Frequencies[0x83] = 0x40;
+		Frequencies[0x01] = 0x30;
+		Frequencies[0x08] = 0x30;
+		Frequencies[0x10] = 0x30;
+		Frequencies[0x20] = 0x30;
+		Frequencies[0x85] = 0x30;
+		Frequencies[0xC0] = 0x30;
+		Frequencies[0xC3] = 0x30;
+		Frequencies[0x33] = 0x20;
+		Frequencies[0x41] = 0x20;
+		Frequencies[0x49] = 0x20;
+		Frequencies[0x74] = 0x20;
+		Frequencies[0x75] = 0x20;
+		Frequencies[0x45] = 0x18;
+		Frequencies[0x4D] = 0x18;
+		Frequencies[0xEB] = 0x18;
+
+		return Frequencies;
+	}();
+
+	inline uint32_t GetByteWeight(uint8_t Byte, uint8_t Mask)
+	{
+		if (Mask == 0x00)
+			return 0x100;
+
+		/* A partially masked byte matches multiple values */
+		return Mask == 0xFF ? ByteFrequencies[Byte] : 0xC0;
+	}
+
+	EInstructionSet DetectInstructionSet()
+	{
+#if defined(_MSC_VER)
+		int CpuInfo[4] = { 0 };
+
+		__cpuid(CpuInfo, 0);
+		const int MaxLeaf = CpuInfo[0];
+
+		__cpuid(CpuInfo, 1);
+		const bool bHasSSE2 = (CpuInfo[3] & (1 << 26)) != 0;
+		const bool bHasOSXSave = (CpuInfo[2] & (1 << 27)) != 0;
+		const bool bHasAVX = (CpuInfo[2] & (1 << 28)) != 0;
+
+		/* The OS must save the upper halves of the YMM registers on context-switches */
+		if (MaxLeaf >= 7 && bHasOSXSave && bHasAVX && (_xgetbv(0) & 0x6) == 0x6)
+		{
+			__cpuidex(CpuInfo, 7, 0);
+
+			if (CpuInfo[1] & (1 << 5))
+				return EInstructionSet::AVX2;
+		}
+
+		return bHasSSE2 ? EInstructionSet::SSE2 : EInstructionSet::Scalar;
+#else
+		return EInstructionSet::Scalar;
+#endif
+	}
+
+	/* Compares a pair against every position of a block, bit N of the result is set if the pair matches at Block[N] */
+	struct PairCompareScalar
+	{
+		static constexpr size_t Width = 0x1;
+
+		using BlockType = uint8_t;
+
+		BytePair Pair;
+
+		explicit PairCompareScalar(const BytePair& InPair)
+			: Pair(InPair)
+		{
+		}
+
+		static inline BlockType Load(const uint8_t* Address)
+		{
+			return *Address;
+		}
+
+		inline uint32_t Compare(BlockType Current, BlockType Next) const
+		{
+			return (Current & Pair.FirstMask) == Pair.First && (Next & Pair.SecondMask) == Pair.Second;
+		}
+	};
+
+	struct PairCompareSSE2
+	{
+		static constexpr size_t Width = 0x10;
+
+		using BlockType = __m128i;
+
+		__m128i First;
+		__m128i FirstMask;
+		__m128i Second;
+		__m128i SecondMask;
+
+		explicit PairCompareSSE2(const BytePair& Pair)
+			: First(_mm_set1_epi8(static_cast<char>(Pair.First)))
+			, FirstMask(_mm_set1_epi8(static_cast<char>(Pair.FirstMask)))
+			, Second(_mm_set1_epi8(static_cast<char>(Pair.Second)))
+			, SecondMask(_mm_set1_epi8(static_cast<char>(Pair.SecondMask)))
+		{
+		}
+
+		static inline BlockType Load(const uint8_t* Address)
+		{
+			return _mm_loadu_si128(reinterpret_cast<const __m128i*>(Address));
+		}
+
+		inline uint32_t Compare(BlockType Current, BlockType Next) const
+		{
+			const __m128i FirstEqual = _mm_cmpeq_epi8(_mm_and_si128(Current, FirstMask), First);
+			const __m128i SecondEqual = _mm_cmpeq_epi8(_mm_and_si128(Next, SecondMask), Second);
+
+			return static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(FirstEqual, SecondEqual)));
+		}
+	};
+
+	struct PairCompareAVX2
+	{
+		static constexpr size_t Width = 0x20;
+
+		using BlockType = __m256i;
+
+		__m256i First;
+		__m256i FirstMask;
+		__m256i Second;
+		__m256i SecondMask;
+
+		explicit PairCompareAVX2(const BytePair& Pair)
+			: First(_mm256_set1_epi8(static_cast<char>(Pair.First)))
+			, FirstMask(_mm256_set1_epi8(static_cast<char>(Pair.FirstMask)))
+			, Second(_mm256_set1_epi8(static_cast<char>(Pair.Second)))
+			, SecondMask(_mm256_set1_epi8(static_cast<char>(Pair.SecondMask)))
+		{
+		}
+
+		static inline BlockType Load(const uint8_t* Address)
+		{
+			return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Address));
+		}
+
+		inline uint32_t Compare(BlockType Current, BlockType Next) const
+		{
+			const __m256i FirstEqual = _mm256_cmpeq_epi8(_mm256_and_si256(Current, FirstMask), First);
+			const __m256i SecondEqual = _mm256_cmpeq_epi8(_mm256_and_si256(Next, SecondMask), Second);
+
+			return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(FirstEqual, SecondEqual)));
+		}
+	};
+
+	/* Position 'i' is only a candidate if the second byte, Start[i + 1], is in range too. A wildcard second byte may be beyond the end. */
+	inline bool IsPairAt(const uint8_t* Start, size_t Size, size_t i, const BytePair& Pair)
+	{
+		if ((Start[i] & Pair.FirstMask) != Pair.First)
+			return false;
+
+		if ((i + 1) >= Size)
+			return Pair.SecondMask == 0x0;
+
+		return (Start[i + 1] & Pair.SecondMask) == Pair.Second;
+	}
+
+	template<typename PairCompareType>
+	size_t FindBytePairImpl(const uint8_t* Start, size_t Size, size_t From, const BytePair& Pair)
+	{
+		const PairCompareType Comparer(Pair);
+
+		size_t i = From;
+
+		/* Each iteration reads Start[i] to Start[i + Width] */
+		for (; (i + PairCompareType::Width + 1) <= Size; i += PairCompareType::Width)
+		{
+			const uint32_t Matches = Comparer.Compare(PairCompareType::Load(Start + i), PairCompareType::Load(Start + i + 1));
+
+			if (Matches != 0x0)
+				return i + std::countr_zero(Matches);
+		}
+
+		for (; (i + 1) < Size; i++)
+		{
+			if ((Start[i] & Pair.FirstMask) == Pair.First && (Start[i + 1] & Pair.SecondMask) == Pair.Second)
+				return i;
+		}
+
+		return Size;
+	}
+
+	template<typename PairCompareType>
+	void FindMultipleImpl(std::span<const Signature* const> Signatures, const uint8_t* Start, size_t Size, const MultiMatchCallbackType& OnMatch)
+	{
+		struct ActiveSignature
+		{
+			size_t Index;
+			PairCompareType Comparer;
+		};
+
+		std::vector<ActiveSignature> ActiveSignatures;
+		ActiveSignatures.reserve(Signatures.size());
+
+		for (size_t i = 0; i < Signatures.size(); i++)
+		{
+			if (Signatures[i]->GetLength() > 0x0 && Signatures[i]->GetLength() <= Size)
+				ActiveSignatures.push_back({ i, PairCompareType(Signatures[i]->GetAnchor()) });
+		}
+
+		auto VerifyCandidate = [&](size_t SignatureIndex, size_t AnchorPosition) -> EScanAction
+		{
+			const Signature& Sig = *Signatures[SignatureIndex];
+
+			if (AnchorPosition < Sig.GetAnchorOffset())
+				return EScanAction::Continue;
+
+			const size_t MatchStart = AnchorPosition - Sig.GetAnchorOffset();
+
+			if ((MatchStart + Sig.GetLength()) > Size || !Sig.MatchesAt(Start + MatchStart, Size - MatchStart))
+				return EScanAction::Continue;
+
+			return OnMatch(SignatureIndex, Start + MatchStart);
+		};
+
+		size_t BlockStart = 0x0;
+
+		/* Each block reads Start[BlockStart] to Start[BlockStart + Width] */
+		for (; !ActiveSignatures.empty() && (BlockStart + PairCompareType::Width + 1) <= Size; BlockStart += PairCompareType::Width)
+		{
+			const auto Current = PairCompareType::Load(Start + BlockStart);
+			const auto Next = PairCompareType::Load(Start + BlockStart + 1);
+
+			for (auto It = ActiveSignatures.begin(); It != ActiveSignatures.end();)
+			{
+				EScanAction Action = EScanAction::Continue;
+
+				for (uint32_t Matches = It->Comparer.Compare(Current, Next); Matches != 0x0 && Action == EScanAction::Continue; Matches &= (Matches - 1))
+					Action = VerifyCandidate(It->Index, BlockStart + std::countr_zero(Matches));
+
+				if (Action == EScanAction::StopScan)
+					return;
+
+				It = Action == EScanAction::Continue ? (It + 1) : ActiveSignatures.erase(It);
+			}
+		}
+
+		for (size_t i = BlockStart; !ActiveSignatures.empty() && i < Size; i++)
+		{
+			for (auto It = ActiveSignatures.begin(); It != ActiveSignatures.end();)
+			{
+				const EScanAction Action = IsPairAt(Start, Size, i, Signatures[It->Index]->GetAnchor()) ? VerifyCandidate(It->Index, i) : EScanAction::Continue;
+
+				if (Action == EScanAction::StopScan)
+					return;
+
+				It = Action == EScanAction::Continue ? (It + 1) : ActiveSignatures.erase(It);
+			}
+		}
+	}
+}
+
+
+PatternScan::Signature::Signature(const char* IDAStyleSignature)
+{
+	const char* Current = IDAStyleSignature;
+	const char* const End = IDAStyleSignature + strlen(IDAStyleSignature);
+
+	while (Current < End)
+	{
+		if (*Current == ' ')
+		{
+			Current++;
+			continue;
+		}
+
+		if (*Current == '?')
+		{
+			Current++;
+
+			if (Current < End && *Current == '?')
+				Current++;
+
+			Bytes.push_back(0x00);
+			Masks.push_back(0x00);
+			continue;
+		}
+
+		char* ByteEnd = nullptr;
+		Bytes.push_back(static_cast<uint8_t>(strtoul(Current, &ByteEnd, 16)));
+		Masks.push_back(0xFF);
+
+		Current = ByteEnd;
+	}
+
+	Finalize();
+}
+
+PatternScan::Signature::Signature(const std::vector<int>& BytesWithWildcards)
+{
+	Bytes.reserve(BytesWithWildcards.size());
+	Masks.reserve(BytesWithWildcards.size());
+
+	for (const int Byte : BytesWithWildcards)
+	{
+		Bytes.push_back(Byte == -1 ? 0x00 : static_cast<uint8_t>(Byte));
+		Masks.push_back(Byte == -1 ? 0x00 : 0xFF);
+	}
+
+	Finalize();
+}
+
+PatternScan::Signature::Signature(const std::vector<uint8_t>& SigBytes, const std::vector<uint8_t>& SigMasks)
+	: Bytes(SigBytes)
+	, Masks(SigMasks)
+{
+	Masks.resize(Bytes.size(), 0xFF);
+
+	for (size_t i = 0; i < Bytes.size(); i++)
+		Bytes[i] &= Masks[i];
+
+	Finalize();
+}
+
+void PatternScan::Signature::Finalize()
+{
+	Length = Bytes.size();
+
+	/* Choose the adjacent pair of bytes with the lowest combined frequency as anchor */
+	uint32_t LowestWeight = UINT32_MAX;
+
+	for (size_t i = 0; (i + 1) < Length; i++)
+	{
+		const uint32_t Weight = GetByteWeight(Bytes[i], Masks[i]) * GetByteWeight(Bytes[i + 1], Masks[i + 1]);
+
+		if (Weight < LowestWeight)
+		{
+			LowestWeight = Weight;
+			AnchorOffset = i;
+		}
+	}
+
+	if (Length >= 2)
+	{
+		Anchor = { Bytes[AnchorOffset], Masks[AnchorOffset], Bytes[AnchorOffset + 1], Masks[AnchorOffset + 1] };
+	}
+	else if (Length == 1)
+	{
+		Anchor = { Bytes[0], Masks[0], 0x00, 0x00 };
+	}
+
+	const size_t PaddedLength = (Length + 0xF) & ~static_cast<size_t>(0xF);
+
+	Bytes.resize(PaddedLength, 0x00);
+	Masks.resize(PaddedLength, 0x00);
+}
+
+bool PatternScan::Signature::MatchesAt(const uint8_t* Address, size_t AvailableBytes) const
+{
+	if (AvailableBytes < Length)
+		return false;
+
+	/* Only compare in 16-byte chunks if the padding doesn't read past the end of the range */
+	if (AvailableBytes >= Bytes.size() && GetInstructionSet() != EInstructionSet::Scalar)
+	{
+		for (size_t i = 0; i < Bytes.size(); i += 16)
+		{
+			const __m128i Data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Address + i));
+			const __m128i Mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Masks.data() + i));
+			const __m128i Expected = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Bytes.data() + i));
+
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(Data, Mask), Expected)) != 0xFFFF)
+				return false;
+		}
+
+		return true;
+	}
+
+	for (size_t i = 0; i < Length; i++)
+	{
+		if ((Address[i] & Masks[i]) != Bytes[i])
+			return false;
+	}
+
+	return true;
+}
+
+PatternScan::EInstructionSet PatternScan::GetInstructionSet()
+{
+	static const EInstructionSet InstructionSet = DetectInstructionSet();
+
+	return InstructionSet;
+}
+
+size_t PatternScan::FindBytePair(const uint8_t* Start, size_t Size, size_t From, const BytePair& Pair)
+{
+	switch (GetInstructionSet())
+	{
+	case EInstructionSet::AVX2:
+		return FindBytePairImpl<PairCompareAVX2>(Start, Size, From, Pair);
+	case EInstructionSet::SSE2:
+		return FindBytePairImpl<PairCompareSSE2>(Start, Size, From, Pair);
+	default:
+		return FindBytePairImpl<PairCompareScalar>(Start, Size, From, Pair);
+	}
+}
+
+const uint8_t* PatternScan::Find(const Signature& Sig, const uint8_t* Start, size_t Size, uint32_t SkipCount)
+{
+	const size_t Length = Sig.GetLength();
+
+	if (Length == 0x0 || Size < Length)
+		return nullptr;
+
+	const size_t LastStart = Size - Length;
+
+	/* A single byte doesn't have an anchor-pair */
+	if (Length == 1)
+	{
+		for (size_t i = 0; i <= LastStart; i++)
+		{
+			if (Sig.MatchesAt(Start + i, Size - i) && SkipCount-- == 0)
+				return Start + i;
+		}
+
+		return nullptr;
+	}
+
+	const size_t AnchorOffset = Sig.GetAnchorOffset();
+	const BytePair& Anchor = Sig.GetAnchor();
+
+	/* The anchor of the last possible match ends at Start[LastStart + AnchorOffset + 1] */
+	const size_t AnchorSearchSize = LastStart + AnchorOffset + 2;
+
+	for (size_t Candidate = FindBytePair(Start, AnchorSearchSize, AnchorOffset, Anchor); Candidate < AnchorSearchSize; Candidate = FindBytePair(Start, AnchorSearchSize, Candidate + 1, Anchor))
+	{
+		const size_t MatchStart = Candidate - AnchorOffset;
+
+		if (!Sig.MatchesAt(Start + MatchStart, Size - MatchStart))
+			continue;
+
+		if (SkipCount-- == 0)
+			return Start + MatchStart;
+	}
+
+	return nullptr;
+}
+
+void PatternScan::FindMultiple(std::span<const Signature* const> Signatures, const uint8_t* Start, size_t Size, const MultiMatchCallbackType& OnMatch)
+{
+	switch (GetInstructionSet())
+	{
+	case EInstructionSet::AVX2:
+		return FindMultipleImpl<PairCompareAVX2>(Signatures, Start, Size, OnMatch);
+	case EInstructionSet::SSE2:
+		return FindMultipleImpl<PairCompareSSE2>(Signatures, Start, Size, OnMatch);
+	default:
+		return FindMultipleImpl<PairCompareScalar>(Signatures, Start, Size, OnMatch);
+	}
+}
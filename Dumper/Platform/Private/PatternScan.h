@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <span>
+#include <functional>
+
+/*
+Interface:
+	- EInstructionSet GetInstructionSet()
+	-
+	- size_t FindBytePair(const uint8_t* Start, size_t Size, size_t From, const BytePair& Pair)
+	- const uint8_t* Find(const Signature& Sig, const uint8_t* Start, size_t Size, uint32_t SkipCount = 0)
+	- void FindMultiple(std::span<const Signature* const> Signatures, const uint8_t* Start, size_t Size, const MultiMatchCallbackType& OnMatch)
+*/
+
+/*
+* Vectorized signature scanning.
+*
+* Candidates are located by comparing one pair of adjacent signature bytes against 32 (AVX2) or 16 (SSE2) positions at once,
+* the pair that is least likely to appear in x86 code is chosen as this anchor. Only candidates are verified against the full signature.
+* The widest instruction set supported by the CPU is selected on the first scan.
+*/
+namespace PatternScan
+{
+	enum class EInstructionSet : uint8_t
+	{
+		Scalar,
+		SSE2,
+		AVX2
+	};
+
+	/* Matches at position i if (Start[i] & FirstMask) == First && (Start[i + 1] & SecondMask) == Second */
+	struct BytePair
+	{
+		uint8_t First;
+		uint8_t FirstMask;
+		uint8_t Second;
+		uint8_t SecondMask;
+	};
+
+	class Signature
+	{
+	private:
+		/* Padded to a multiple of 16 with wildcards, so the full signature can be compared in 16-byte chunks */
+		std::vector<uint8_t> Bytes;
+		std::vector<uint8_t> Masks;
+
+		size_t Length = 0x0;
+
+		size_t AnchorOffset = 0x0;
+		BytePair Anchor = { 0x0, 0x0, 0x0, 0x0 };
+
+	public:
+		/* IDA-style signature, eg. "48 8D ? ? E8" */
+		Signature(const char* IDAStyleSignature);
+
+		/* Bytes with -1 as wildcard */
+		Signature(const std::vector<int>& BytesWithWildcards);
+
+		/* Bytes compared as (Byte & Mask) == (SigByte & Mask), allows matching single bits of an opcode */
+		Signature(const std::vector<uint8_t>& SigBytes, const std::vector<uint8_t>& SigMasks);
+
+	public:
+		inline size_t GetLength() const { return Length; }
+		inline size_t GetAnchorOffset() const { return AnchorOffset; }
+		inline const BytePair& GetAnchor() const { return Anchor; }
+
+		/* Whether the signature matches at Address. 'AvailableBytes' is the number of readable bytes starting at Address. */
+		bool MatchesAt(const uint8_t* Address, size_t AvailableBytes) const;
+
+	private:
+		void Finalize();
+	};
+
+	EInstructionSet GetInstructionSet();
+
+	/* Index of the first position >= From at which the pair matches, or Size if there is none. Never reads beyond Start[Size - 1]. */
+	size_t FindBytePair(const uint8_t* Start, size_t Size, size_t From, const BytePair& Pair);
+
+	/* Address of the first match that lies fully within [Start, Start + Size), after skipping 'SkipCount' earlier matches */
+	const uint8_t* Find(const Signature& Sig, const uint8_t* Start, size_t Size, uint32_t SkipCount = 0);
+
+	enum class EScanAction : uint8_t
+	{
+		Continue,
+		StopSignature,
+		StopScan
+	};
+
+	/* Called with the index of the signature in 'Signatures' and the address of the match. Decides whether the current, or any, signature is still searched for. */
+	using MultiMatchCallbackType = std::function<EScanAction(size_t SignatureIndex, const uint8_t* Match)>;
+
+	/*
+	* Searches for all signatures in a single pass over [Start, Start + Size), every block of memory is loaded once and compared against the anchors of all signatures.
+	* Matches of one signature are reported in ascending order. The scan ends once there are no signatures left to search for.
+	*/
+	void FindMultiple(std::span<const Signature* const> Signatures, const uint8_t* Start, size_t Size, const MultiMatchCallbackType& OnMatch);
+}
@@ -1,7 +1,17 @@
 
+#include <mutex>
+#include <atomic>
+#include <thread>
+
+#include <Windows.h>
+#include <TlHelp32.h>
+#include <Psapi.h>
+
 #include "TmpUtils.h"
 #include "PlatformWindows.h"
 #include "Arch_x86.h"
+#include "PatternScan.h"
+#include "ProcessMemory.h"
 
 // Private implementation to ensure that there is no accidental usage of platform-specific functions
 namespace
@@ -123,6 +133,45 @@ namespace
 		return reinterpret_cast<TEB*>(_NtCurrentTeb())->ProcessEnvironmentBlock;
 	}
 
+	/* See PlatformWindows::SetMainModuleOverride */
+	uintptr_t MainModuleOverride = 0x0;
+
+	/* VirtualQuery for the process that ProcessMemory reads from */
+	inline SIZE_T QueryMemory(const void* Address, MEMORY_BASIC_INFORMATION& OutMbi)
+	{
+		if (ProcessMemory::IsExternal())
+			return VirtualQueryEx(ProcessMemory::GetExternalProcessHandle(), Address, &OutMbi, sizeof(OutMbi));
+
+		return VirtualQuery(Address, &OutMbi, sizeof(OutMbi));
+	}
+
+	/* The headers of an external module are copied once, the section-headers are handed out as pointers */
+	std::vector<uint8_t> ExternalImageHeaders;
+	uintptr_t ExternalImageHeadersBase = 0x0;
+	std::mutex ExternalImageHeadersMutex;
+
+	/* Address at which the PE-headers of the module at 'ImageBase' can be dereferenced by this process */
+	inline uintptr_t GetReadableImageHeaders(const uintptr_t ImageBase)
+	{
+		if (!ProcessMemory::IsExternal() || ImageBase == 0x0)
+			return ImageBase;
+
+		std::scoped_lock Lock(ExternalImageHeadersMutex);
+
+		if (ExternalImageHeadersBase != ImageBase)
+		{
+			const IMAGE_DOS_HEADER DosHeader = ProcessMemory::Read<IMAGE_DOS_HEADER>(reinterpret_cast<const void*>(ImageBase));
+			const IMAGE_NT_HEADERS NtHeaders = ProcessMemory::Read<IMAGE_NT_HEADERS>(reinterpret_cast<const void*>(ImageBase + DosHeader.e_lfanew));
+
+			const DWORD SizeOfHeaders = NtHeaders.OptionalHeader.SizeOfHeaders > 0x1000 ? NtHeaders.OptionalHeader.SizeOfHeaders : 0x1000;
+
+			ExternalImageHeaders = ProcessMemory::ReadArray<uint8_t>(reinterpret_cast<const void*>(ImageBase), SizeOfHeaders);
+			ExternalImageHeadersBase = ImageBase;
+		}
+
+		return reinterpret_cast<uintptr_t>(ExternalImageHeaders.data());
+	}
+
 	inline const LDR_DATA_TABLE_ENTRY* GetModuleLdrTableEntry(const char* SearchModuleName)
 	{
 		const PEB* Peb = GetPEB();
@@ -149,7 +198,8 @@ namespace
 	inline std::pair<uintptr_t, uintptr_t> GetImageBaseAndSize(const char* const ModuleName = nullptr)
 	{
 		const uintptr_t ImageBase = GetModuleBase(ModuleName);
-		const PIMAGE_NT_HEADERS NtHeader = reinterpret_cast<PIMAGE_NT_HEADERS>(ImageBase + reinterpret_cast<PIMAGE_DOS_HEADER>(ImageBase)->e_lfanew);
+		const uintptr_t Headers = GetReadableImageHeaders(ImageBase);
+		const PIMAGE_NT_HEADERS NtHeader = reinterpret_cast<PIMAGE_NT_HEADERS>(Headers + reinterpret_cast<PIMAGE_DOS_HEADER>(Headers)->e_lfanew);
 
 		return { ImageBase, NtHeader->OptionalHeader.SizeOfImage };
 	}
@@ -159,8 +209,10 @@ namespace
 		if (ImageBase == 0)
 			return nullptr;
 
-		const PIMAGE_DOS_HEADER DosHeader = reinterpret_cast<PIMAGE_DOS_HEADER>(ImageBase);
-		const PIMAGE_NT_HEADERS NtHeaders = reinterpret_cast<PIMAGE_NT_HEADERS>(ImageBase + DosHeader->e_lfanew);
+		const uintptr_t Headers = GetReadableImageHeaders(ImageBase);
+
+		const PIMAGE_DOS_HEADER DosHeader = reinterpret_cast<PIMAGE_DOS_HEADER>(Headers);
+		const PIMAGE_NT_HEADERS NtHeaders = reinterpret_cast<PIMAGE_NT_HEADERS>(Headers + DosHeader->e_lfanew);
 
 		if (NtHeaders->Signature != IMAGE_NT_SIGNATURE)
 			return nullptr;
@@ -319,21 +371,215 @@ namespace
 	{
 		return IsInAnySection(reinterpret_cast<uintptr_t>(Address), OptionalRequiredCharacteristics);
 	}
+
+	constexpr DWORD AccessibleMask = (PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY);
+	constexpr DWORD InaccessibleMask = (PAGE_GUARD | PAGE_NOACCESS);
+
+	inline bool IsReadableProtection(const DWORD Protect)
+	{
+		return (Protect & AccessibleMask) && !(Protect & InaccessibleMask);
+	}
+
+	/* [Start, End) */
+	struct MemoryRegion
+	{
+		uintptr_t Start;
+		uintptr_t End;
+	};
+
+	/* Snapshot of the address space, see PlatformWindows::RefreshMemoryRegionCache */
+	struct MemoryRegionCache
+	{
+		/* Sorted by address, adjacent readable regions are merged */
+		std::vector<MemoryRegion> ReadableRegions;
+
+		/* Sorted by address, may overlap ReadableRegions */
+		std::vector<MemoryRegion> Modules;
+
+		uintptr_t ImageBase = 0x0;
+		uintptr_t ImageSize = 0x0;
+
+		bool bIsBuilt = false;
+	};
+
+	MemoryRegionCache RegionCache;
+
+	inline const MemoryRegion* FindRegion(const std::vector<MemoryRegion>& Regions, const uintptr_t Address)
+	{
+		/* First region starting after Address, the one before it is the only one that could contain Address */
+		auto It = std::upper_bound(Regions.begin(), Regions.end(), Address, [](uintptr_t Value, const MemoryRegion& Region) { return Value < Region.Start; });
+
+		if (It == Regions.begin())
+			return nullptr;
+
+		--It;
+
+		return Address < It->End ? &*It : nullptr;
+	}
+
+	/* Modules of the process ProcessMemory reads from, the loader-list in the PEB only describes this process */
+	inline std::vector<MemoryRegion> GetExternalModules()
+	{
+		const HANDLE ProcessHandle = ProcessMemory::GetExternalProcessHandle();
+
+		DWORD BytesNeeded = 0x0;
+		K32EnumProcessModulesEx(ProcessHandle, nullptr, 0x0, &BytesNeeded, LIST_MODULES_DEFAULT);
+
+		std::vector<HMODULE> ModuleHandles(BytesNeeded / sizeof(HMODULE));
+
+		if (!K32EnumProcessModulesEx(ProcessHandle, ModuleHandles.data(), static_cast<DWORD>(ModuleHandles.size() * sizeof(HMODULE)), &BytesNeeded, LIST_MODULES_DEFAULT))
+			return {};
+
+		std::vector<MemoryRegion> Modules;
+		Modules.reserve(ModuleHandles.size());
+
+		for (const HMODULE Module : ModuleHandles)
+		{
+			MODULEINFO Info;
+
+			if (K32GetModuleInformation(ProcessHandle, Module, &Info, sizeof(Info)))
+				Modules.push_back({ reinterpret_cast<uintptr_t>(Info.lpBaseOfDll), reinterpret_cast<uintptr_t>(Info.lpBaseOfDll) + Info.SizeOfImage });
+		}
+
+		return Modules;
+	}
+
+	/* Ranges smaller than this are scanned on the calling thread, starting the workers would take longer than the scan itself */
+	constexpr uintptr_t MinParallelScanSize = 0x100000;
+
+	/* Size of the ranges handed out to the workers, a multiple of the page-size */
+	constexpr uintptr_t ParallelScanChunkSize = 0x10000;
+
+	/* Returns the first match in [ChunkStart, ChunkStart + ChunkSize), or nullptr */
+	using ChunkScanFuncType = std::function<void*(uintptr_t ChunkStart, uintptr_t ChunkSize)>;
+
+	/*
+	* Splits [Start, Start + Size) into chunks that are scanned on all cores and returns the lowest address any chunk found.
+	*
+	* Chunks are handed out in ascending order. Once a match was found, chunks starting after it are skipped, as they can only contain later matches.
+	* 'Granularity' must divide ParallelScanChunkSize, so the positions within every chunk are the same as for a linear scan from 'Start'.
+	*/
+	void* ScanRangeInParallel(const uintptr_t Start, const uintptr_t Size, const uint32_t Granularity, const ChunkScanFuncType& ScanChunk)
+	{
+		if (Size < MinParallelScanSize || Granularity == 0x0 || (ParallelScanChunkSize % Granularity) != 0x0)
+			return ScanChunk(Start, Size);
+
+		const uintptr_t NumChunks = (Size + (ParallelScanChunkSize - 1)) / ParallelScanChunkSize;
+		const uint32_t NumThreads = static_cast<uint32_t>(std::clamp<uintptr_t>(std::thread::hardware_concurrency(), 1, std::min<uintptr_t>(NumChunks, 32)));
+
+		std::atomic<uintptr_t> NextChunk = 0x0;
+		std::atomic<uintptr_t> FirstMatch = UINTPTR_MAX;
+
+		auto ScanChunks = [&]() -> void
+		{
+			for (uintptr_t ChunkIndex = NextChunk++; ChunkIndex < NumChunks; ChunkIndex = NextChunk++)
+			{
+				const uintptr_t ChunkOffset = ChunkIndex * ParallelScanChunkSize;
+				const uintptr_t ChunkStart = Start + ChunkOffset;
+
+				if (ChunkStart >= FirstMatch.load(std::memory_order_relaxed))
+					return;
+
+				const uintptr_t Match = reinterpret_cast<uintptr_t>(ScanChunk(ChunkStart, std::min(ParallelScanChunkSize, Size - ChunkOffset)));
+
+				if (!Match)
+					continue;
+
+				uintptr_t CurrentFirstMatch = FirstMatch.load();
+				while (Match < CurrentFirstMatch && !FirstMatch.compare_exchange_weak(CurrentFirstMatch, Match))
+					;
+
+				/* Every chunk this thread could get from now on starts after this match */
+				return;
+			}
+		};
+
+		std::vector<std::thread> Workers;
+		Workers.reserve(NumThreads - 1);
+
+		for (uint32_t i = 1; i < NumThreads; i++)
+			Workers.emplace_back(ScanChunks);
+
+		ScanChunks();
+
+		for (std::thread& Worker : Workers)
+			Worker.join();
+
+		return FirstMatch != UINTPTR_MAX ? reinterpret_cast<void*>(FirstMatch.load()) : nullptr;
+	}
+
+#if defined(_WIN64)
+	/* lea reg, [rip + disp32], 0x48 and 0x4C only differ in REX.R */
+	const PatternScan::Signature StringRefOpcodeSignature({ 0x48, 0x8D, 0x00, 0x00, 0x00, 0x00, 0x00 }, { 0xFB, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00 });
+#elif defined(_WIN32)
+	/* push imm32 */
+	const PatternScan::Signature StringRefOpcodeSignature({ 0x68, 0x00, 0x00, 0x00, 0x00 }, { 0xFF, 0x00, 0x00, 0x00, 0x00 });
+#endif
+
+	/* Returns the address referenced by a lea/push instruction, or 0x0 if it can't point to a string */
+	uintptr_t ResolveStringRefCandidate(const uint8_t* Instruction)
+	{
+#if defined(_WIN64)
+		const uintptr_t StrPtr = Architecture_x86_64::Resolve32BitRelativeLea(reinterpret_cast<uintptr_t>(Instruction));
+
+		if (!IsAddressInProcessRange(StrPtr))
+			return 0x0;
+
+		if (!IsInAnySection(StrPtr, IMAGE_SCN_MEM_READ) && IsBadReadPtr(StrPtr))
+			return 0x0;
+#elif defined(_WIN32)
+		const uintptr_t StrPtr = Architecture_x86_64::Resolve32BitRelativePush(reinterpret_cast<uintptr_t>(Instruction));
+
+		if (!IsAddressInProcessRange(StrPtr))
+			return 0x0;
+
+		if (IsBadReadPtr(StrPtr))
+			return 0x0;
+#endif
+
+		return StrPtr;
+	}
+
+	/* 'StrPtr' must have been returned by ResolveStringRefCandidate */
+	template<typename CharType>
+	bool IsStringRef(const CharType* RefStr, const int32_t RefStrLen, const uintptr_t StrPtr, const bool bCheckIfLeaIsStrPtr)
+	{
+		if (StrnCmpHelper(RefStr, reinterpret_cast<const CharType*>(StrPtr), RefStrLen))
+			return true;
+
+		if (Is32Bit() || !bCheckIfLeaIsStrPtr)
+			return false;
+
+		const CharType* StrPtrContentFirst8Bytes = *reinterpret_cast<const CharType* const*>(StrPtr);
+
+		if (!IsAddressInProcessRange(StrPtrContentFirst8Bytes))
+			return false;
+
+		return StrnCmpHelper(RefStr, StrPtrContentFirst8Bytes, RefStrLen);
+	}
 }
 
 
 void* WindowsPrivateImplHelper::FinAlignedValueInRangeImpl(const void* ValuePtr, ValueCompareFuncType ComparisonFunction, const int32_t ValueTypeSize, const int32_t Alignment, uintptr_t StartAddress, uint32_t Range)
 {
-	for (uint32_t i = 0x0; i <= GetAlignedSizeWithOffsetFromEnd(Range, Alignment, ValueTypeSize); i += Alignment)
+	/* Offset of the last value that fits into the range, inclusive */
+	const uint32_t LastValueOffset = GetAlignedSizeWithOffsetFromEnd(Range, Alignment, ValueTypeSize);
+
+	auto ScanChunk = [ValuePtr, ComparisonFunction, Alignment](uintptr_t ChunkStart, uintptr_t ChunkSize) -> void*
 	{
-		void* TypedPtr = reinterpret_cast<void*>(StartAddress + i);
+		for (uintptr_t i = 0x0; i < ChunkSize; i += Alignment)
+		{
+			void* TypedPtr = reinterpret_cast<void*>(ChunkStart + i);
 
+			if (ComparisonFunction(ValuePtr, TypedPtr))
+				return TypedPtr;
+		}
 
-		if (ComparisonFunction(ValuePtr, TypedPtr))
-			return TypedPtr;
-	}
+		return nullptr;
+	};
 
-	return nullptr;
+	/* The comparison only reads memory, so the range can always be split up */
+	return ScanRangeInParallel(StartAddress, static_cast<uintptr_t>(LastValueOffset) + Alignment, Alignment, ScanChunk);
 }
 
 void* WindowsPrivateImplHelper::FindAlignedValueInSectionImpl(const SectionInfo& Info, const void* ValuePtr, ValueCompareFuncType ComparisonFunction, const int32_t ValueTypeSize, const int32_t Alignment)
@@ -376,11 +622,16 @@ void* WindowsPrivateImplHelper::FindAlignedValueInAllSectionsImpl(const void* Va
 uintptr_t PlatformWindows::GetModuleBase(const char* const ModuleName)
 {
 	if (ModuleName == nullptr)
-		return reinterpret_cast<uintptr_t>(GetPEB()->ImageBaseAddress);
+		return MainModuleOverride != 0x0 ? MainModuleOverride : reinterpret_cast<uintptr_t>(GetPEB()->ImageBaseAddress);
 
 	return reinterpret_cast<uintptr_t>(GetModuleLdrTableEntry(ModuleName)->DllBase);
 }
 
+void PlatformWindows::SetMainModuleOverride(const uintptr_t ImageBase)
+{
+	MainModuleOverride = ImageBase;
+}
+
 uintptr_t PlatformWindows::GetOffset(const uintptr_t Address, const char* const ModuleName)
 {
 	return (Address - GetModuleBase(ModuleName));
@@ -391,6 +642,46 @@ uintptr_t PlatformWindows::GetOffset(const void* Address, const char* const Modu
 	return GetOffset(reinterpret_cast<const uintptr_t>(Address), ModuleName);
 }
 
+uint64_t PlatformWindows::GetModuleFingerprint(const char* const ModuleName)
+{
+	const uintptr_t ModuleBase = GetModuleBase(ModuleName);
+
+	if (ModuleBase == 0x0)
+		return 0x0;
+
+	const uintptr_t Headers = GetReadableImageHeaders(ModuleBase);
+	const PIMAGE_NT_HEADERS NtHeader = reinterpret_cast<PIMAGE_NT_HEADERS>(Headers + reinterpret_cast<PIMAGE_DOS_HEADER>(Headers)->e_lfanew);
+
+	if (NtHeader->Signature != IMAGE_NT_SIGNATURE)
+		return 0x0;
+
+	/* FNV-1a, ImageBase is skipped as the loader rewrites it when the module is relocated */
+	constexpr uint64_t FNVOffsetBasis = 0xCBF29CE484222325;
+	constexpr uint64_t FNVPrime = 0x100000001B3;
+
+	uint64_t Hash = FNVOffsetBasis;
+
+	auto HashBytes = [&Hash](const void* Data, size_t Size) -> void
+	{
+		for (size_t i = 0; i < Size; i++)
+		{
+			Hash ^= static_cast<const uint8_t*>(Data)[i];
+			Hash *= FNVPrime;
+		}
+	};
+
+	const IMAGE_OPTIONAL_HEADER& OptionalHeader = NtHeader->OptionalHeader;
+
+	HashBytes(&NtHeader->FileHeader, sizeof(IMAGE_FILE_HEADER)); // includes TimeDateStamp
+	HashBytes(&OptionalHeader.SizeOfImage, sizeof(OptionalHeader.SizeOfImage));
+	HashBytes(&OptionalHeader.SizeOfCode, sizeof(OptionalHeader.SizeOfCode));
+	HashBytes(&OptionalHeader.CheckSum, sizeof(OptionalHeader.CheckSum));
+	HashBytes(&OptionalHeader.AddressOfEntryPoint, sizeof(OptionalHeader.AddressOfEntryPoint));
+	HashBytes(IMAGE_FIRST_SECTION(NtHeader), NtHeader->FileHeader.NumberOfSections * sizeof(IMAGE_SECTION_HEADER));
+
+	return Hash;
+}
+
 SectionInfo PlatformWindows::GetSectionInfo(const std::string& SectionName, const char* const ModuleName)
 {
 	const uintptr_t ModuleBase = GetModuleBase(ModuleName);
@@ -405,7 +696,7 @@ SectionInfo PlatformWindows::GetSectionInfo(const std::string& SectionName, cons
 	return WinSectionInfoToSectionInfo(WinSectionInfo);
 }
 
-void* PlatformWindows::IterateSectionWithCallback(const SectionInfo& Info, const std::function<bool(void* Address)>& Callback, uint32_t Granularity, uint32_t OffsetFromEnd)
+void* PlatformWindows::IterateSectionWithCallback(const SectionInfo& Info, const std::function<bool(void* Address)>& Callback, uint32_t Granularity, uint32_t OffsetFromEnd, bool bMultithreaded)
 {
 	const WindowsSectionInfo WinSectionInfo = SectionInfoToWinSectionInfo(Info);
 
@@ -415,26 +706,34 @@ void* PlatformWindows::IterateSectionWithCallback(const SectionInfo& Info, const
 	const uintptr_t SectionBaseAddrss = WinSectionInfo.Imagebase + WinSectionInfo.SectionHeader->VirtualAddress;
 	const uint32_t SectionIterationSize = GetAlignedSizeWithOffsetFromEnd(WinSectionInfo.SectionHeader->Misc.VirtualSize, Granularity, OffsetFromEnd);
 
-	for (uintptr_t CurrentAddress = SectionBaseAddrss; CurrentAddress < (SectionBaseAddrss + SectionIterationSize); CurrentAddress += Granularity)
+	auto ScanChunk = [&Callback, Granularity](uintptr_t ChunkStart, uintptr_t ChunkSize) -> void*
 	{
-		if (Callback(reinterpret_cast<void*>(CurrentAddress)))
-			return reinterpret_cast<void*>(CurrentAddress);
-	}
+		for (uintptr_t CurrentAddress = ChunkStart; CurrentAddress < (ChunkStart + ChunkSize); CurrentAddress += Granularity)
+		{
+			if (Callback(reinterpret_cast<void*>(CurrentAddress)))
+				return reinterpret_cast<void*>(CurrentAddress);
+		}
 
-	return nullptr;
+		return nullptr;
+	};
+
+	if (!bMultithreaded)
+		return ScanChunk(SectionBaseAddrss, SectionIterationSize);
+
+	return ScanRangeInParallel(SectionBaseAddrss, SectionIterationSize, Granularity, ScanChunk);
 }
 
-void* PlatformWindows::IterateAllSectionsWithCallback(const std::function<bool(void* Address)>& Callback, uint32_t Granularity, uint32_t OffsetFromEnd, const char* const ModuleName)
+void* PlatformWindows::IterateAllSectionsWithCallback(const std::function<bool(void* Address)>& Callback, uint32_t Granularity, uint32_t OffsetFromEnd, const char* const ModuleName, bool bMultithreaded)
 {
 	void* Result = nullptr;
 
 	const uintptr_t ModuleBase = GetModuleBase(ModuleName);
 
-	IterateAllSectionObjects(ModuleBase, [ModuleBase, &Result, &Callback, Granularity, OffsetFromEnd](const IMAGE_SECTION_HEADER* Section) -> bool
+	IterateAllSectionObjects(ModuleBase, [ModuleBase, &Result, &Callback, Granularity, OffsetFromEnd, bMultithreaded](const IMAGE_SECTION_HEADER* Section) -> bool
 		{
 			const WindowsSectionInfo WinSectionInfo = { ModuleBase, Section };
 
-			if (void* Address = IterateSectionWithCallback(WinSectionInfoToSectionInfo(WinSectionInfo), Callback, Granularity, OffsetFromEnd))
+			if (void* Address = IterateSectionWithCallback(WinSectionInfoToSectionInfo(WinSectionInfo), Callback, Granularity, OffsetFromEnd, bMultithreaded))
 			{
 				Result = Address;
 				return true;
@@ -454,6 +753,25 @@ bool PlatformWindows::IsAddressInAnyModule(const uintptr_t Address)
 
 bool PlatformWindows::IsAddressInAnyModule(const void* Address)
 {
+	/* Modules loaded after the cache was built are still found by walking the loader-list */
+	if (RegionCache.bIsBuilt)
+	{
+		const MemoryRegion* Module = FindRegion(RegionCache.Modules, reinterpret_cast<uintptr_t>(Address));
+
+		if (Module && reinterpret_cast<uintptr_t>(Address) > Module->Start)
+			return true;
+	}
+
+	if (ProcessMemory::IsExternal())
+	{
+		const std::vector<MemoryRegion> Modules = GetExternalModules();
+
+		return std::any_of(Modules.begin(), Modules.end(), [Address](const MemoryRegion& Module)
+		{
+			return reinterpret_cast<uintptr_t>(Address) > Module.Start && reinterpret_cast<uintptr_t>(Address) < Module.End;
+		});
+	}
+
 	const PEB* Peb = GetPEB();
 	const PEB_LDR_DATA* Ldr = Peb->Ldr;
 
@@ -472,7 +790,7 @@ bool PlatformWindows::IsAddressInAnyModule(const void* Address)
 
 bool PlatformWindows::IsAddressInProcessRange(const uintptr_t Address)
 {
-	const auto [ImageBase, ImageSize] = GetImageBaseAndSize();
+	const auto [ImageBase, ImageSize] = RegionCache.bIsBuilt ? std::pair(RegionCache.ImageBase, RegionCache.ImageSize) : GetImageBaseAndSize();
 
 	if (Address >= ImageBase && Address < (ImageBase + ImageSize))
 		return true;
@@ -495,17 +813,94 @@ bool PlatformWindows::IsBadReadPtr(const void* Address)
 			return true;
 	}
 
+	/* Memory that was allocated after the cache was built is still checked with VirtualQuery */
+	if (RegionCache.bIsBuilt && FindRegion(RegionCache.ReadableRegions, reinterpret_cast<uintptr_t>(Address)))
+		return false;
+
 	MEMORY_BASIC_INFORMATION Mbi;
 
-	if (VirtualQuery(Address, &Mbi, sizeof(Mbi)))
+	if (QueryMemory(Address, Mbi))
+		return !IsReadableProtection(Mbi.Protect);
+
+	return true;
+}
+
+void PlatformWindows::RefreshMemoryRegionCache()
+{
+	RegionCache = MemoryRegionCache();
+
+	SYSTEM_INFO SystemInfo;
+	GetSystemInfo(&SystemInfo);
+
+	const uintptr_t MaxAddress = reinterpret_cast<uintptr_t>(SystemInfo.lpMaximumApplicationAddress);
+
+	MEMORY_BASIC_INFORMATION Mbi;
+
+	for (uintptr_t Address = reinterpret_cast<uintptr_t>(SystemInfo.lpMinimumApplicationAddress); Address < MaxAddress; Address = reinterpret_cast<uintptr_t>(Mbi.BaseAddress) + Mbi.RegionSize)
 	{
-		constexpr DWORD AccessibleMask = (PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY);
-		constexpr DWORD InaccessibleMask = (PAGE_GUARD | PAGE_NOACCESS);
+		if (!QueryMemory(reinterpret_cast<void*>(Address), Mbi) || Mbi.RegionSize == 0x0)
+			break;
+
+		if (Mbi.State != MEM_COMMIT || !IsReadableProtection(Mbi.Protect))
+			continue;
 
-		return !(Mbi.Protect & AccessibleMask) || (Mbi.Protect & InaccessibleMask);
+		const uintptr_t RegionStart = reinterpret_cast<uintptr_t>(Mbi.BaseAddress);
+		const uintptr_t RegionEnd = RegionStart + Mbi.RegionSize;
+
+		std::vector<MemoryRegion>& Regions = RegionCache.ReadableRegions;
+
+		if (!Regions.empty() && Regions.back().End == RegionStart)
+		{
+			Regions.back().End = RegionEnd;
+			continue;
+		}
+
+		Regions.push_back({ RegionStart, RegionEnd });
 	}
 
-	return true;
+	if (ProcessMemory::IsExternal())
+	{
+		RegionCache.Modules = GetExternalModules();
+	}
+	else
+	{
+		const PEB* Peb = GetPEB();
+		const PEB_LDR_DATA* Ldr = Peb->Ldr;
+
+		int NumEntriesLeft = Ldr->Length;
+
+		for (const LIST_ENTRY* P = Ldr->InMemoryOrderModuleList.Flink; P && NumEntriesLeft-- > 0; P = P->Flink)
+		{
+			const LDR_DATA_TABLE_ENTRY* Entry = reinterpret_cast<const LDR_DATA_TABLE_ENTRY*>(P);
+
+			const uintptr_t ModuleStart = reinterpret_cast<uintptr_t>(Entry->DllBase);
+
+			RegionCache.Modules.push_back({ ModuleStart, ModuleStart + Entry->SizeOfImage });
+		}
+	}
+
+	/* A replayed main module isn't loaded, so it's not part of the loader-list */
+	if (MainModuleOverride != 0x0 && !ProcessMemory::IsExternal())
+	{
+		const auto [ImageBase, ImageSize] = GetImageBaseAndSize();
+		RegionCache.Modules.push_back({ ImageBase, ImageBase + ImageSize });
+	}
+
+	std::sort(RegionCache.Modules.begin(), RegionCache.Modules.end(), [](const MemoryRegion& Left, const MemoryRegion& Right) { return Left.Start < Right.Start; });
+
+	std::tie(RegionCache.ImageBase, RegionCache.ImageSize) = GetImageBaseAndSize();
+
+	RegionCache.bIsBuilt = true;
+}
+
+void PlatformWindows::ClearMemoryRegionCache()
+{
+	RegionCache = MemoryRegionCache();
+}
+
+bool PlatformWindows::IsMemoryRegionCacheBuilt()
+{
+	return RegionCache.bIsBuilt;
 }
 
 const void* PlatformWindows::GetAddressOfImportedFunction(const char* SearchModuleName, const char* ModuleToImportFrom, const char* SearchFunctionName)
@@ -569,22 +964,48 @@ const void* PlatformWindows::GetAddressOfExportedFunction(const char* SearchModu
 	return nullptr;
 }
 
+bool PlatformWindows::WriteEntireFile(const wchar_t* FilePath, const void* Data, uint64_t Size)
+{
+	HANDLE File = CreateFileW(FilePath, GENERIC_WRITE, 0x0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+	if (File == INVALID_HANDLE_VALUE)
+		return false;
+
+	/* WriteFile takes a 32-bit size, only files larger than that need more than one call */
+	constexpr uint64_t MaxChunkSize = 0x80000000;
+
+	const uint8_t* Current = static_cast<const uint8_t*>(Data);
+	bool bSucceeded = true;
+
+	while (Size > 0x0 && bSucceeded)
+	{
+		const DWORD ChunkSize = static_cast<DWORD>(Size > MaxChunkSize ? MaxChunkSize : Size);
+		DWORD NumBytesWritten = 0x0;
+
+		bSucceeded = WriteFile(File, Current, ChunkSize, &NumBytesWritten, nullptr) && NumBytesWritten == ChunkSize;
+
+		Current += NumBytesWritten;
+		Size -= NumBytesWritten;
+	}
+
+	CloseHandle(File);
+
+	return bSucceeded;
+}
+
+void PlatformWindows::SetCurrentThreadBackgroundMode(bool bEnable)
+{
+	SetThreadPriority(GetCurrentThread(), bEnable ? THREAD_MODE_BACKGROUND_BEGIN : THREAD_MODE_BACKGROUND_END);
+}
+
 template<bool bShouldResolve32BitJumps>
 std::pair<const void*, int32_t> PlatformWindows::IterateVTableFunctions(void** VTable, const std::function<bool(const uint8_t* Address, int32_t Index)>& CallBackForEachFunc, int32_t NumFunctions, int32_t OffsetFromStart)
 {
 	[[maybe_unused]] auto Resolve32BitRelativeJump = [](const void* FunctionPtr) -> const uint8_t*
 	{
+		/* vtable entries often point at incremental-linking thunks, possibly chained, resolve them to the actual function */
 		if constexpr (bShouldResolve32BitJumps)
-		{
-			const uint8_t* Address = reinterpret_cast<const uint8_t*>(FunctionPtr);
-			if (*Address == 0xE9)
-			{
-				const uint8_t* Ret = ((Address + 5) + *reinterpret_cast<const int32_t*>(Address + 1));
-
-				if (IsAddressInProcessRange(Ret))
-					return Ret;
-			}
-		}
+			return reinterpret_cast<const uint8_t*>(Architecture_x86_64::FollowThunks(reinterpret_cast<uintptr_t>(FunctionPtr)));
 
 		return reinterpret_cast<const uint8_t*>(FunctionPtr);
 	};
@@ -683,43 +1104,23 @@ void* PlatformWindows::FindPatternInRange(const char* Signature, const uintptr_t
 
 void* PlatformWindows::FindPatternInRange(std::vector<int>&& Signature, const void* Start, const uintptr_t Range, const bool bRelative, uint32_t Offset, const uint32_t SkipCount)
 {
-	const auto PatternLength = Signature.size();
-	const auto PatternBytes = Signature.data();
+	const PatternScan::Signature Sig(Signature);
 
-	for (int i = 0; i < (Range - PatternLength); i++)
-	{
-		bool bFound = true;
-		int CurrentSkips = 0;
+	const uint8_t* Match = PatternScan::Find(Sig, static_cast<const uint8_t*>(Start), Range, SkipCount);
 
-		for (auto j = 0ul; j < PatternLength; ++j)
-		{
-			if (static_cast<const uint8_t*>(Start)[i + j] != PatternBytes[j] && PatternBytes[j] != -1)
-			{
-				bFound = false;
-				break;
-			}
-		}
-		if (bFound)
-		{
-			if (CurrentSkips != SkipCount)
-			{
-				CurrentSkips++;
-				continue;
-			}
+	if (!Match)
+		return nullptr;
 
-			uintptr_t Address = reinterpret_cast<uintptr_t>(Start) + i;
-			if (bRelative)
-			{
-				if (Offset == -1)
-					Offset = PatternLength;
+	uintptr_t Address = reinterpret_cast<uintptr_t>(Match);
+	if (bRelative)
+	{
+		if (Offset == -1)
+			Offset = static_cast<uint32_t>(Signature.size());
 
-				Address = ((Address + Offset + 4) + *reinterpret_cast<int32_t*>(Address + Offset));
-			}
-			return reinterpret_cast<void*>(Address);
-		}
+		Address = ((Address + Offset + 4) + *reinterpret_cast<int32_t*>(Address + Offset));
 	}
 
-	return nullptr;
+	return reinterpret_cast<void*>(Address);
 }
 
 /* Slower than FindByString */
@@ -764,58 +1165,269 @@ inline void* PlatformWindows::FindStringInRange(const CharType* RefStr, const ui
 
 	const int32_t RefStrLen = StrlenHelper(RefStr);
 
-	for (uintptr_t i = 0; i < Range; i++)
-	{
+	if (Range <= 0x0)
+		return nullptr;
+
 #if defined(_WIN64)
-		// opcode: lea
-		if ((SearchStart[i] == uint8_t(0x4C) || SearchStart[i] == uint8_t(0x48)) && SearchStart[i + 1] == uint8_t(0x8D))
+	// opcode: lea, 0x48 and 0x4C only differ in REX.R
+	constexpr PatternScan::BytePair OpcodePair = { 0x48, 0xFB, 0x8D, 0xFF };
+#elif defined(_WIN32)
+	// opcode: push
+	constexpr PatternScan::BytePair OpcodePair = { 0x68, 0xFF, 0x00, 0x00 };
+#endif
+
+	/* The opcode of the last candidate starts at SearchStart[Range - 1], its second byte is read as well */
+	const size_t ScanSize = static_cast<size_t>(Range) + 1;
+
+	for (size_t i = PatternScan::FindBytePair(SearchStart, ScanSize, 0x0, OpcodePair); i < Range; i = PatternScan::FindBytePair(SearchStart, ScanSize, i + 1, OpcodePair))
+	{
+		const uintptr_t StrPtr = ResolveStringRefCandidate(SearchStart + i);
+
+		if (StrPtr == 0x0)
+			continue;
+
+		if (IsStringRef(RefStr, RefStrLen, StrPtr, bCheckIfLeaIsStrPtr))
+			return { SearchStart + i };
+	}
+
+	return nullptr;
+}
+
+
+
+PlatformWindows::ThreadFreeze::ThreadFreeze()
+{
+	const DWORD CurrentProcessId = GetCurrentProcessId();
+	const DWORD CurrentThreadId = GetCurrentThreadId();
+
+	const HANDLE Snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0x0);
+
+	if (Snapshot == INVALID_HANDLE_VALUE)
+		return;
+
+	THREADENTRY32 ThreadEntry = { .dwSize = sizeof(THREADENTRY32) };
+
+	int32_t NumThreads = 0x0;
+
+	for (BOOL bHasEntry = Thread32First(Snapshot, &ThreadEntry); bHasEntry; bHasEntry = Thread32Next(Snapshot, &ThreadEntry))
+	{
+		if (ThreadEntry.th32OwnerProcessID == CurrentProcessId)
+			NumThreads++;
+	}
+
+	/* No allocations once the first thread is suspended, it might be holding the heap-lock */
+	SuspendedThreads.reserve(NumThreads);
+
+	ThreadEntry = { .dwSize = sizeof(THREADENTRY32) };
+
+	for (BOOL bHasEntry = Thread32First(Snapshot, &ThreadEntry); bHasEntry; bHasEntry = Thread32Next(Snapshot, &ThreadEntry))
+	{
+		if (ThreadEntry.th32OwnerProcessID != CurrentProcessId || ThreadEntry.th32ThreadID == CurrentThreadId)
+			continue;
+
+		/* Threads started after the first pass are left running */
+		if (SuspendedThreads.size() == SuspendedThreads.capacity())
+			break;
+
+		const HANDLE Thread = OpenThread(THREAD_SUSPEND_RESUME, FALSE, ThreadEntry.th32ThreadID);
+
+		if (!Thread)
+			continue;
+
+		if (SuspendThread(Thread) == static_cast<DWORD>(-1))
 		{
-			const uintptr_t StrPtr = Architecture_x86_64::Resolve32BitRelativeLea(reinterpret_cast<uintptr_t>(SearchStart + i));
+			CloseHandle(Thread);
+			continue;
+		}
 
-			if (!IsAddressInProcessRange(StrPtr))
-				continue;
+		SuspendedThreads.push_back(Thread);
+	}
 
-			if (!IsInAnySection(StrPtr, IMAGE_SCN_MEM_READ) && IsBadReadPtr(StrPtr))
-				continue;
+	CloseHandle(Snapshot);
+}
 
+PlatformWindows::ThreadFreeze::~ThreadFreeze()
+{
+	Resume();
+}
 
-			if (StrnCmpHelper(RefStr, reinterpret_cast<const CharType*>(StrPtr), RefStrLen))
-				return { SearchStart + i };
+void PlatformWindows::ThreadFreeze::Resume()
+{
+	for (const HANDLE Thread : SuspendedThreads)
+	{
+		ResumeThread(Thread);
+		CloseHandle(Thread);
+	}
 
-			if constexpr (bCheckIfLeaIsStrPtr)
-			{
-				const CharType* StrPtrContentFirst8Bytes = *reinterpret_cast<const CharType* const*>(StrPtr);
+	SuspendedThreads.clear();
+}
 
-				if (!IsAddressInProcessRange(StrPtrContentFirst8Bytes))
-					continue;
 
-				if (StrnCmpHelper(RefStr, StrPtrContentFirst8Bytes, RefStrLen))
-					return { SearchStart + i };
-			}
+int32_t PlatformWindows::ScanBatch::AddEntry(Entry&& NewEntry)
+{
+	Entries.push_back(std::move(NewEntry));
+
+	return static_cast<int32_t>(Entries.size() - 1);
+}
+
+int32_t PlatformWindows::ScanBatch::AddSignature(const char* Signature, uint32_t MaxMatches)
+{
+	Signatures.emplace_back(Signature);
+
+	return AddEntry({ .Type = EEntryType::Signature, .SignatureIndex = static_cast<int32_t>(Signatures.size() - 1), .MaxMatches = MaxMatches });
+}
+
+int32_t PlatformWindows::ScanBatch::AddSignature(std::vector<int>&& Signature, uint32_t MaxMatches)
+{
+	Signatures.emplace_back(Signature);
+
+	return AddEntry({ .Type = EEntryType::Signature, .SignatureIndex = static_cast<int32_t>(Signatures.size() - 1), .MaxMatches = MaxMatches });
+}
+
+int32_t PlatformWindows::ScanBatch::AddStringRef(const char* RefStr, bool bCheckIfLeaIsStrPtr, bool bSearchOnlyExecutableSections, uint32_t MaxMatches)
+{
+	return AddEntry({ .Type = EEntryType::String, .String = RefStr, .bCheckIfLeaIsStrPtr = bCheckIfLeaIsStrPtr, .bSearchOnlyExecutableSections = bSearchOnlyExecutableSections, .MaxMatches = MaxMatches });
+}
+
+int32_t PlatformWindows::ScanBatch::AddStringRef(const wchar_t* RefStr, bool bCheckIfLeaIsStrPtr, bool bSearchOnlyExecutableSections, uint32_t MaxMatches)
+{
+	return AddEntry({ .Type = EEntryType::WString, .WString = RefStr, .bCheckIfLeaIsStrPtr = bCheckIfLeaIsStrPtr, .bSearchOnlyExecutableSections = bSearchOnlyExecutableSections, .MaxMatches = MaxMatches });
+}
+
+void PlatformWindows::ScanBatch::ScanRange(const void* Start, uintptr_t Range)
+{
+	ScanRangeImpl(static_cast<const uint8_t*>(Start), Range, true);
+}
+
+void PlatformWindows::ScanBatch::ScanAllSections(const uintptr_t StartAddress, int32_t Range, const char* const ModuleName)
+{
+	const auto ModuleBase = GetModuleBase(ModuleName);
+
+	IterateAllSectionObjects(ModuleBase, [this, &Range, StartAddress, ModuleBase](const IMAGE_SECTION_HEADER* SectionHeader) -> bool
+	{
+		const auto [SearchStartAddress, SearchRange] = GetSearchStartAndRangeBasedOnOverrides(ModuleBase, SectionHeader, StartAddress, Range);
+
+		if (SearchStartAddress == NULL || SearchRange == 0x0)
+			return false;
+
+		if (Range > 0x0)
+			Range -= SearchRange;
+
+		ScanRangeImpl(reinterpret_cast<const uint8_t*>(SearchStartAddress), SearchRange, (SectionHeader->Characteristics & IMAGE_SCN_MEM_EXECUTE) != 0x0);
+
+		return IsComplete();
+	});
+}
+
+bool PlatformWindows::ScanBatch::IsComplete() const
+{
+	if (bStopOnFirstCompleteEntry && bHasCompleteEntry)
+		return true;
+
+	return std::all_of(Entries.begin(), Entries.end(), [](const Entry& Current) { return Current.IsComplete(); });
+}
+
+void* PlatformWindows::ScanBatch::GetMatch(int32_t Id) const
+{
+	const std::vector<void*>& Matches = Entries[Id].Matches;
+
+	return !Matches.empty() ? Matches[0] : nullptr;
+}
+
+const std::vector<void*>& PlatformWindows::ScanBatch::GetMatches(int32_t Id) const
+{
+	return Entries[Id].Matches;
+}
+
+PatternScan::EScanAction PlatformWindows::ScanBatch::OnEntryMatched(Entry& MatchedEntry, const uint8_t* Match)
+{
+	MatchedEntry.Matches.push_back(const_cast<uint8_t*>(Match));
+
+	if (!MatchedEntry.IsComplete())
+		return PatternScan::EScanAction::Continue;
+
+	bHasCompleteEntry = true;
+
+	return bStopOnFirstCompleteEntry ? PatternScan::EScanAction::StopScan : PatternScan::EScanAction::StopSignature;
+}
+
+void PlatformWindows::ScanBatch::ScanRangeImpl(const uint8_t* Start, uintptr_t Range, bool bIsExecutable)
+{
+	if (IsComplete())
+		return;
+
+	std::vector<const PatternScan::Signature*> ScanSignatures;
+
+	/* Index of the entry for every signature in ScanSignatures, -1 for StringRefOpcodeSignature */
+	std::vector<int32_t> SignatureEntries;
+
+	bool bHasStringRefs = false;
+
+	for (int32_t i = 0; i < Entries.size(); i++)
+	{
+		const Entry& Current = Entries[i];
+
+		if (Current.IsComplete())
+			continue;
+
+		if (Current.Type == EEntryType::Signature)
+		{
+			ScanSignatures.push_back(&Signatures[Current.SignatureIndex]);
+			SignatureEntries.push_back(i);
 		}
-#elif defined(_WIN32)
-		// opcode: push
-		if ((SearchStart[i] == uint8_t(0x68)))
+		else if (bIsExecutable || !Current.bSearchOnlyExecutableSections)
 		{
-			const uintptr_t StrPtr = Architecture_x86_64::Resolve32BitRelativePush(reinterpret_cast<uintptr_t>(SearchStart + i));
+			bHasStringRefs = true;
+		}
+	}
 
-			if (!IsAddressInProcessRange(StrPtr))
-				continue;
+	/* All string-references share one signature, so every lea/push is only resolved once */
+	if (bHasStringRefs)
+	{
+		ScanSignatures.push_back(&StringRefOpcodeSignature);
+		SignatureEntries.push_back(-1);
+	}
 
-			if (!IsBadReadPtr(StrPtr))
+	if (ScanSignatures.empty())
+		return;
+
+	auto OnStringRefCandidate = [this, bIsExecutable](const uint8_t* Instruction) -> PatternScan::EScanAction
+	{
+		const uintptr_t StrPtr = ResolveStringRefCandidate(Instruction);
+
+		bool bHasIncompleteStringRefs = false;
+
+		for (Entry& Current : Entries)
+		{
+			if (Current.Type == EEntryType::Signature || Current.IsComplete() || (!bIsExecutable && Current.bSearchOnlyExecutableSections))
 				continue;
 
-			if (StrnCmpHelper(RefStr, reinterpret_cast<const CharType*>(StrPtr), RefStrLen))
+			if (StrPtr != 0x0)
 			{
-				return { SearchStart + i };
+				const bool bIsMatch = Current.Type == EEntryType::String
+					? IsStringRef(Current.String.c_str(), static_cast<int32_t>(Current.String.size()), StrPtr, Current.bCheckIfLeaIsStrPtr)
+					: IsStringRef(Current.WString.c_str(), static_cast<int32_t>(Current.WString.size()), StrPtr, Current.bCheckIfLeaIsStrPtr);
+
+				if (bIsMatch && OnEntryMatched(Current, Instruction) == PatternScan::EScanAction::StopScan)
+					return PatternScan::EScanAction::StopScan;
 			}
+
+			bHasIncompleteStringRefs |= !Current.IsComplete();
 		}
-#endif
-	}
 
-	return nullptr;
-}
+		return bHasIncompleteStringRefs ? PatternScan::EScanAction::Continue : PatternScan::EScanAction::StopSignature;
+	};
+
+	PatternScan::FindMultiple(ScanSignatures, Start, Range, [this, &SignatureEntries, &OnStringRefCandidate](size_t SignatureIndex, const uint8_t* Match) -> PatternScan::EScanAction
+	{
+		const int32_t EntryIndex = SignatureEntries[SignatureIndex];
 
+		if (EntryIndex == -1)
+			return OnStringRefCandidate(Match);
+
+		return OnEntryMatched(Entries[EntryIndex], Match);
+	});
+}
 
 
 /*
@@ -7,6 +7,8 @@
 #include <algorithm>
 #include <functional>
 
+#include "PatternScan.h"
+
 /*
 Interface:
 	ASMUtils:
@@ -22,17 +24,25 @@ Interface:
 		- uintptr_t Resolve32bitAbsoluteCall(uintptr_t Address)
 		- uintptr_t Resolve32bitAbsoluteMove(uintptr_t Address)
 		-
+		- bool DecodeInstruction(uintptr_t Address, InstructionInfo& OutInfo)
+		- uintptr_t GetNextInstruction(uintptr_t Address)
+		- uintptr_t FindFirstRipRelativeTarget(uintptr_t Address, uint32_t Range = 0x100, uintptr_t* OutInstructionAddress = nullptr)
+		- uintptr_t ResolveBranchTarget(uintptr_t Address)
+		- uintptr_t FollowThunks(uintptr_t Address, int32_t MaxDepth = 0x8)
 		-
 	WindowsPE:
 		-
 		-
 	General Interface:
 		- uintptr_t GetModuleBase(const char* const ModuleName = nullptr)
+		- void SetMainModuleOverride(uintptr_t ImageBase)
 		- uintptr_t GetOffset(uintptr_t Address, const char* const ModuleName = nullptr)
 		- uintptr_t GetOffset(void* Address, const char* const ModuleName = nullptr)
+		- uint64_t GetModuleFingerprint(const char* const ModuleName = nullptr)
 		-
 		- SectionInfo GetSectionInfo(const std::string& SectionName)
-		- void IterateSectionWithCallback(const SectionInfo& Info, std::function<bool(void* Address)> Callback, uint32_t Granularity = 0x4, uint32_t OffsetFromEnd = 0x0);
+		- void IterateSectionWithCallback(const SectionInfo& Info, std::function<bool(void* Address)> Callback, uint32_t Granularity = 0x4, uint32_t OffsetFromEnd = 0x0, bool bMultithreaded = false);
+		- void IterateAllSectionsWithCallback(std::function<bool(void* Address)> Callback, uint32_t Granularity = 0x4, uint32_t OffsetFromEnd = 0x0, const char* const ModuleName = nullptr, bool bMultithreaded = false);
 		-
 		- bool IsAddressInAnyModule(const uintptr_t Address)
 		- bool IsAddressInAnyModule(const void* Address)
@@ -41,11 +51,34 @@ Interface:
 		- bool IsBadReadPtr(const uintptr_t Address)
 		- bool IsBadReadPtr(const void* Address)
 		-
+		- void RefreshMemoryRegionCache()
+		- void ClearMemoryRegionCache()
+		- bool IsMemoryRegionCacheBuilt()
+		-
 		- void* GetAddressOfImportedFunction(const char* SearchModuleName, const char* ModuleToImportFrom, const char* SearchFunctionName)
 		- void* GetAddressOfImportedFunctionFromAnyModule(const char* ModuleToImportFrom, const char* SearchFunctionName)
 		-
+		- bool WriteEntireFile(const wchar_t* FilePath, const void* Data, uint64_t Size)
+		- void SetCurrentThreadBackgroundMode(bool bEnable)
+		-
 		- std::pair<const void*, int32_t> IterateVTableFunctions(void** VTable, const std::function<bool(const uint8_t* Addr, int32_t Index)>& CallBackForEachFunc, int32_t NumFunctions = 0x150, int32_t OffsetFromStart = 0x0)
 		-
+	ThreadFreeze:
+		- ThreadFreeze()
+		- void Resume()
+		-
+	ScanBatch:
+		- ScanBatch(bool bStopOnFirstComplete = false)
+		-
+		- int32_t AddSignature(const char* Signature, uint32_t MaxMatches = 1)
+		- int32_t AddStringRef(const CharType* RefStr, bool bCheckIfLeaIsStrPtr = false, bool bSearchOnlyExecutableSections = true, uint32_t MaxMatches = 1)
+		-
+		- void ScanRange(const void* Start, uintptr_t Range)
+		- void ScanAllSections(uintptr_t StartAddress = 0x0, int32_t Range = 0x0, const char* const ModuleName = nullptr)
+		-
+		- void* GetMatch(int32_t Id)
+		- const std::vector<void*>& GetMatches(int32_t Id)
+		-
 */
 
 // Purposefully opaque section-handle, must be obtained from function-call
@@ -118,12 +151,24 @@ namespace PlatformWindows
 	}
 
 	uintptr_t GetModuleBase(const char* const ModuleName = nullptr);
+
+	/* Main module returned by GetModuleBase(nullptr) instead of the executable of this process, 0x0 to reset. Used to replay a MemorySnapshot. */
+	void SetMainModuleOverride(const uintptr_t ImageBase);
+
 	uintptr_t GetOffset(const uintptr_t Address, const char* const ModuleName = nullptr);
 	uintptr_t GetOffset(const void* Address, const char* const ModuleName = nullptr);
+
+	/* Identifies a build of a module by its PE-header. Changes whenever the module is rebuilt, but stays the same across runs of the same build. */
+	uint64_t GetModuleFingerprint(const char* const ModuleName = nullptr);
 	
 	SectionInfo GetSectionInfo(const std::string& SectionName, const char* const ModuleName = nullptr);
-	void* IterateSectionWithCallback(const SectionInfo& Info, const std::function<bool(void* Address)>& Callback, uint32_t Granularity = 0x4, uint32_t OffsetFromEnd = 0x0);
-	void* IterateAllSectionsWithCallback(const std::function<bool(void* Address)>& Callback, uint32_t Granularity = 0x4, uint32_t OffsetFromEnd = 0x0, const char* const ModuleName = nullptr);
+
+	/*
+	* With 'bMultithreaded' the section is split into page-aligned ranges that are searched on multiple threads, so 'Callback' must be thread-safe.
+	* The returned address is always the lowest address for which 'Callback' returned true, regardless of 'bMultithreaded'.
+	*/
+	void* IterateSectionWithCallback(const SectionInfo& Info, const std::function<bool(void* Address)>& Callback, uint32_t Granularity = 0x4, uint32_t OffsetFromEnd = 0x0, bool bMultithreaded = false);
+	void* IterateAllSectionsWithCallback(const std::function<bool(void* Address)>& Callback, uint32_t Granularity = 0x4, uint32_t OffsetFromEnd = 0x0, const char* const ModuleName = nullptr, bool bMultithreaded = false);
 
 	bool IsAddressInAnyModule(const uintptr_t Address);
 	bool IsAddressInAnyModule(const void* Address);
@@ -132,11 +177,27 @@ namespace PlatformWindows
 	bool IsBadReadPtr(const uintptr_t Address);
 	bool IsBadReadPtr(const void* Address);
 
+	/*
+	* Takes a snapshot of all readable memory-regions and loaded modules. While it exists IsBadReadPtr, IsAddressInAnyModule and IsAddressInProcessRange
+	* look addresses up in the snapshot first, and only fall back to VirtualQuery or the loader-list for addresses that weren't readable when it was taken.
+	*
+	* Memory freed after the refresh is still reported as readable. Must not be called while other threads use the functions above.
+	*/
+	void RefreshMemoryRegionCache();
+	void ClearMemoryRegionCache();
+	bool IsMemoryRegionCacheBuilt();
+
 	const void* GetAddressOfImportedFunction(const char* SearchModuleName, const char* ModuleToImportFrom, const char* SearchFunctionName);
 	const void* GetAddressOfImportedFunctionFromAnyModule(const char* ModuleToImportFrom, const char* SearchFunctionName);
 
 	const void* GetAddressOfExportedFunction(const char* SearchModuleName, const char* SearchFunctionName);
 
+	/* Creates or truncates the file and writes all of 'Data' to it, in as few WriteFile calls as possible */
+	bool WriteEntireFile(const wchar_t* FilePath, const void* Data, uint64_t Size);
+
+	/* Lowers the CPU- and IO-priority of the calling thread while enabled, for work that shouldn't slow down the rest of the process */
+	void SetCurrentThreadBackgroundMode(bool bEnable);
+
 	template<bool bShouldResolve32BitJumps = true>
 	std::pair<const void*, int32_t> IterateVTableFunctions(void** VTable, const std::function<bool(const uint8_t* Address, int32_t Index)>&CallBackForEachFunc, int32_t NumFunctions = 0x150, int32_t OffsetFromStart = 0x0);
 
@@ -153,6 +214,113 @@ namespace PlatformWindows
 	void* FindStringInRange(const CharType* RefStr, const uintptr_t StartAddress, const int32_t Range);
 
 
+	/*
+	* Suspends every other thread of this process for the lifetime of the object, or until Resume() is called.
+	*
+	* The suspended threads may hold locks, such as the heap-lock. Code running while the threads are suspended must not allocate, or take any lock the game might hold.
+	*/
+	class ThreadFreeze
+	{
+	private:
+		std::vector<HANDLE> SuspendedThreads;
+
+	public:
+		ThreadFreeze();
+		~ThreadFreeze();
+
+		ThreadFreeze(const ThreadFreeze&) = delete;
+		ThreadFreeze& operator=(const ThreadFreeze&) = delete;
+
+	public:
+		void Resume();
+
+		inline int32_t GetNumSuspendedThreads() const
+		{
+			return static_cast<int32_t>(SuspendedThreads.size());
+		}
+	};
+
+	/*
+	* Collects signatures and string-references that are searched for in a single pass over memory, instead of one pass per FindPattern/FindByString call.
+	*
+	* Each entry is identified by the id returned when adding it, and stops being searched for once it has found 'MaxMatches' matches.
+	*/
+	class ScanBatch
+	{
+	private:
+		enum class EEntryType : uint8_t
+		{
+			Signature,
+			String,
+			WString,
+		};
+
+		struct Entry
+		{
+			EEntryType Type;
+
+			/* Index into Signatures, only valid for EEntryType::Signature */
+			int32_t SignatureIndex = -1;
+
+			std::string String;
+			std::wstring WString;
+
+			bool bCheckIfLeaIsStrPtr = false;
+			bool bSearchOnlyExecutableSections = false;
+
+			uint32_t MaxMatches = 1;
+			std::vector<void*> Matches;
+
+		public:
+			inline bool IsComplete() const
+			{
+				return Matches.size() >= MaxMatches;
+			}
+		};
+
+	private:
+		std::vector<PatternScan::Signature> Signatures;
+		std::vector<Entry> Entries;
+
+		/* Ends the scan once the first entry is complete, for entries that are alternatives to one another */
+		bool bStopOnFirstCompleteEntry = false;
+
+		bool bHasCompleteEntry = false;
+
+	public:
+		ScanBatch(bool bStopOnFirstComplete = false)
+			: bStopOnFirstCompleteEntry(bStopOnFirstComplete)
+		{
+		}
+
+	public:
+		int32_t AddSignature(const char* Signature, uint32_t MaxMatches = 1);
+		int32_t AddSignature(std::vector<int>&& Signature, uint32_t MaxMatches = 1);
+
+		int32_t AddStringRef(const char* RefStr, bool bCheckIfLeaIsStrPtr = false, bool bSearchOnlyExecutableSections = true, uint32_t MaxMatches = 1);
+		int32_t AddStringRef(const wchar_t* RefStr, bool bCheckIfLeaIsStrPtr = false, bool bSearchOnlyExecutableSections = true, uint32_t MaxMatches = 1);
+
+	public:
+		/* Treats [Start, Start + Range) as executable memory */
+		void ScanRange(const void* Start, uintptr_t Range);
+
+		/* Same section- and range-handling as FindByStringInAllSections */
+		void ScanAllSections(const uintptr_t StartAddress = 0x0, int32_t Range = 0x0, const char* const ModuleName = nullptr);
+
+		bool IsComplete() const;
+
+	public:
+		/* First match, or nullptr if there was none */
+		void* GetMatch(int32_t Id) const;
+		const std::vector<void*>& GetMatches(int32_t Id) const;
+
+	private:
+		int32_t AddEntry(Entry&& NewEntry);
+		PatternScan::EScanAction OnEntryMatched(Entry& MatchedEntry, const uint8_t* Match);
+		void ScanRangeImpl(const uint8_t* Start, uintptr_t Range, bool bIsExecutable);
+	};
+
+
 	template<typename T>
 	T* FinAlignedValueInRange(const T Value, const int32_t Alignment, uintptr_t StartAddress, uint32_t Range)
 	{
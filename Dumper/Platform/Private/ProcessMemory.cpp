@@ -0,0 +1,235 @@
+#include <mutex>
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+
+#include <Windows.h>
+#include <Psapi.h>
+
+#include "ProcessMemory.h"
+#include "PlatformWindows.h"
+
+namespace
+{
+	constexpr uintptr_t PageSize = 0x1000;
+
+	/* Misses fetch the whole surrounding block, reads of one object are usually close to reads of its neighbours */
+	constexpr uintptr_t BlockSize = 0x10000;
+
+	/* The cache is flushed once it grows beyond this, 256MB */
+	constexpr size_t MaxCachedPages = 0x10000;
+
+	/* ReadBatch combines adjacent missing pages into runs of at most this size */
+	constexpr uintptr_t MaxBatchRunSize = 0x100000;
+
+	HANDLE ProcessHandle = nullptr;
+
+	/* nullptr for pages that couldn't be read */
+	std::unordered_map<uintptr_t, std::unique_ptr<uint8_t[]>> CachedPages;
+
+	std::mutex CacheMutex;
+
+	inline uintptr_t AlignDown(uintptr_t Address, uintptr_t Alignment)
+	{
+		return Address & ~(Alignment - 1);
+	}
+
+	void StorePages(uintptr_t Start, const uint8_t* Data, uintptr_t Size)
+	{
+		for (uintptr_t Offset = 0x0; Offset < Size; Offset += PageSize)
+		{
+			std::unique_ptr<uint8_t[]> Page = std::make_unique<uint8_t[]>(PageSize);
+			memcpy(Page.get(), Data + Offset, PageSize);
+
+			CachedPages[Start + Offset] = std::move(Page);
+		}
+	}
+
+	/* Reads [Start, Start + Size) with one call, or page by page if part of the range isn't readable */
+	void FetchRange(uintptr_t Start, uintptr_t Size, std::vector<uint8_t>& Buffer)
+	{
+		if (CachedPages.size() > MaxCachedPages)
+			CachedPages.clear();
+
+		Buffer.resize(Size);
+
+		SIZE_T BytesRead = 0x0;
+
+		if (ReadProcessMemory(ProcessHandle, reinterpret_cast<LPCVOID>(Start), Buffer.data(), Size, &BytesRead) && BytesRead == Size)
+		{
+			StorePages(Start, Buffer.data(), Size);
+			return;
+		}
+
+		for (uintptr_t Page = Start; Page < (Start + Size); Page += PageSize)
+		{
+			if (ReadProcessMemory(ProcessHandle, reinterpret_cast<LPCVOID>(Page), Buffer.data(), PageSize, &BytesRead) && BytesRead == PageSize)
+			{
+				StorePages(Page, Buffer.data(), PageSize);
+				continue;
+			}
+
+			CachedPages[Page] = nullptr;
+		}
+	}
+
+	const uint8_t* GetPage(uintptr_t PageAddress, std::vector<uint8_t>& Buffer)
+	{
+		auto It = CachedPages.find(PageAddress);
+
+		if (It == CachedPages.end())
+		{
+			FetchRange(AlignDown(PageAddress, BlockSize), BlockSize, Buffer);
+			It = CachedPages.find(PageAddress);
+		}
+
+		return It != CachedPages.end() ? It->second.get() : nullptr;
+	}
+}
+
+
+bool ProcessMemory::AttachExternal(uint32_t ProcessId)
+{
+	DetachExternal();
+
+	ProcessHandle = OpenProcess(PROCESS_VM_READ | PROCESS_QUERY_INFORMATION, FALSE, ProcessId);
+
+	if (!ProcessHandle)
+		return false;
+
+	/* The first module listed is the executable of the process */
+	HMODULE MainModule = nullptr;
+	DWORD BytesNeeded = 0x0;
+
+	if (!K32EnumProcessModulesEx(ProcessHandle, &MainModule, sizeof(MainModule), &BytesNeeded, LIST_MODULES_DEFAULT) || !MainModule)
+	{
+		CloseHandle(ProcessHandle);
+		ProcessHandle = nullptr;
+
+		return false;
+	}
+
+	Internal::bIsExternal = true;
+
+	PlatformWindows::SetMainModuleOverride(reinterpret_cast<uintptr_t>(MainModule));
+
+	return true;
+}
+
+void ProcessMemory::DetachExternal()
+{
+	FlushCache();
+
+	if (ProcessHandle)
+		CloseHandle(ProcessHandle);
+
+	if (Internal::bIsExternal)
+		PlatformWindows::SetMainModuleOverride(0x0);
+
+	ProcessHandle = nullptr;
+	Internal::bIsExternal = false;
+}
+
+void* ProcessMemory::GetExternalProcessHandle()
+{
+	return ProcessHandle;
+}
+
+bool ProcessMemory::ReadRaw(uintptr_t Address, void* Buffer, size_t Size)
+{
+	if (!Internal::bIsExternal)
+	{
+		memcpy(Buffer, reinterpret_cast<const void*>(Address), Size);
+		return true;
+	}
+
+	std::scoped_lock Lock(CacheMutex);
+
+	std::vector<uint8_t> FetchBuffer;
+
+	uint8_t* Output = static_cast<uint8_t*>(Buffer);
+	bool bReadAll = true;
+
+	while (Size > 0x0)
+	{
+		const uintptr_t PageAddress = AlignDown(Address, PageSize);
+		const uintptr_t OffsetInPage = Address - PageAddress;
+		const size_t BytesFromPage = std::min<size_t>(Size, PageSize - OffsetInPage);
+
+		if (const uint8_t* Page = GetPage(PageAddress, FetchBuffer))
+		{
+			memcpy(Output, Page + OffsetInPage, BytesFromPage);
+		}
+		else
+		{
+			memset(Output, 0x0, BytesFromPage);
+			bReadAll = false;
+		}
+
+		Address += BytesFromPage;
+		Output += BytesFromPage;
+		Size -= BytesFromPage;
+	}
+
+	return bReadAll;
+}
+
+void ProcessMemory::ReadBatch(std::span<const ReadRequest> Requests)
+{
+	if (!Internal::bIsExternal)
+	{
+		for (const ReadRequest& Request : Requests)
+			memcpy(Request.Buffer, reinterpret_cast<const void*>(Request.Address), Request.Size);
+
+		return;
+	}
+
+	for (const ReadRequest& Request : Requests)
+		Prefetch(Request.Address, Request.Size);
+
+	for (const ReadRequest& Request : Requests)
+		ReadRaw(Request.Address, Request.Buffer, Request.Size);
+}
+
+void ProcessMemory::Prefetch(uintptr_t Address, size_t Size)
+{
+	if (!Internal::bIsExternal || Size == 0x0)
+		return;
+
+	std::scoped_lock Lock(CacheMutex);
+
+	std::vector<uint8_t> FetchBuffer;
+
+	const uintptr_t FirstPage = AlignDown(Address, PageSize);
+	const uintptr_t EndPage = AlignDown(Address + Size - 1, PageSize) + PageSize;
+
+	/* Fetch every run of consecutive missing pages with a single ReadProcessMemory call */
+	uintptr_t RunStart = 0x0;
+
+	for (uintptr_t Page = FirstPage; Page <= EndPage; Page += PageSize)
+	{
+		const bool bIsMissing = Page < EndPage && !CachedPages.contains(Page);
+
+		if (bIsMissing && RunStart == 0x0)
+			RunStart = Page;
+
+		const bool bEndsRun = !bIsMissing || (Page + PageSize - RunStart) >= MaxBatchRunSize;
+
+		if (RunStart != 0x0 && bEndsRun)
+		{
+			const uintptr_t RunEnd = bIsMissing ? (Page + PageSize) : Page;
+
+			FetchRange(RunStart, RunEnd - RunStart, FetchBuffer);
+			RunStart = 0x0;
+		}
+	}
+}
+
+void ProcessMemory::FlushCache()
+{
+	std::scoped_lock Lock(CacheMutex);
+
+	CachedPages.clear();
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+/*
+Interface:
+	- bool AttachExternal(uint32_t ProcessId)
+	- void DetachExternal()
+	- bool IsExternal()
+	- void* GetExternalProcessHandle()
+	-
+	- T Read<T>(const void* Address)
+	- bool ReadRaw(uintptr_t Address, void* Buffer, size_t Size)
+	- std::vector<T> ReadArray<T>(const void* Data, int32_t Num)
+	- std::basic_string<CharType> ReadCString<CharType>(const void* Address)
+	- void ReadBatch(std::span<const ReadRequest> Requests)
+	- void Prefetch(uintptr_t Address, size_t Size)
+	- void FlushCache()
+*/
+
+/*
+* Memory-access layer for reads of game memory.
+*
+* The default backend dereferences addresses directly, as the dumper runs inside of the game. After AttachExternal all reads go to another process
+* through ReadProcessMemory instead. Memory is fetched in 64KB blocks and kept in a page-cache, ReadBatch/Prefetch fetch all pages a set of reads needs
+* with as few calls as possible.
+*/
+namespace ProcessMemory
+{
+	namespace Internal
+	{
+		inline bool bIsExternal = false;
+	}
+
+	struct ReadRequest
+	{
+		uintptr_t Address;
+		void* Buffer;
+		size_t Size;
+	};
+
+	/* Reads from the process 'ProcessId' from now on, Platform::GetModuleBase() returns the main module of that process. Returns false if it couldn't be opened. */
+	bool AttachExternal(uint32_t ProcessId);
+
+	/* Goes back to reading memory of this process directly */
+	void DetachExternal();
+
+	inline bool IsExternal()
+	{
+		return Internal::bIsExternal;
+	}
+
+	/* HANDLE of the process opened by AttachExternal, nullptr if memory is read directly */
+	void* GetExternalProcessHandle();
+
+	/* Unreadable bytes are zeroed, returns false if any byte couldn't be read */
+	bool ReadRaw(uintptr_t Address, void* Buffer, size_t Size);
+
+	void ReadBatch(std::span<const ReadRequest> Requests);
+	void Prefetch(uintptr_t Address, size_t Size);
+
+	/* Drops all cached pages, the next reads see the current state of the target */
+	void FlushCache();
+
+	template<typename T>
+	inline T Read(const void* Address)
+	{
+		if (!Internal::bIsExternal) [[likely]]
+			return *static_cast<const T*>(Address);
+
+		T Value{};
+		ReadRaw(reinterpret_cast<uintptr_t>(Address), &Value, sizeof(T));
+
+		return Value;
+	}
+
+	/* Copies 'Num' elements starting at 'Data', for example the elements of a TArray in game memory */
+	template<typename T>
+	inline std::vector<T> ReadArray(const void* Data, int32_t Num)
+	{
+		if (!Data || Num <= 0)
+			return {};
+
+		std::vector<T> Elements(Num);
+		ReadRaw(reinterpret_cast<uintptr_t>(Data), Elements.data(), Num * sizeof(T));
+
+		return Elements;
+	}
+
+	/* Reads a null-terminated string, at most 'MaxLength' characters */
+	template<typename CharType>
+	inline std::basic_string<CharType> ReadCString(const void* Address, size_t MaxLength = 0x400)
+	{
+		if (!Internal::bIsExternal) [[likely]]
+			return std::basic_string<CharType>(static_cast<const CharType*>(Address));
+
+		std::basic_string<CharType> Result;
+
+		for (const CharType* It = static_cast<const CharType*>(Address); Result.size() < MaxLength; It++)
+		{
+			const CharType Char = Read<CharType>(It);
+
+			if (Char == CharType(0))
+				break;
+
+			Result += Char;
+		}
+
+		return Result;
+	}
+}
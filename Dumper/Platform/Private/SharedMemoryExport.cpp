@@ -0,0 +1,134 @@
+#include <mutex>
+#include <format>
+#include <cstring>
+#include <iostream>
+
+#include <Windows.h>
+
+#include "SharedMemoryExport.h"
+
+namespace
+{
+	constexpr uint64_t SectionSize = SharedMemoryExport::SlotsOffset + (SharedMemoryExport::SlotSize * 2);
+
+	std::mutex PublishMutex;
+
+	HANDLE SectionHandle = nullptr;
+	uint8_t* View = nullptr;
+
+	/* Committed bytes of each slot, memory is never decommitted while the section is mapped */
+	uint64_t CommittedSizes[2] = {};
+
+	inline SharedMemoryExport::ChannelHeader* GetHeader()
+	{
+		return reinterpret_cast<SharedMemoryExport::ChannelHeader*>(View);
+	}
+
+	inline void IncrementSequence()
+	{
+		InterlockedIncrement64(reinterpret_cast<volatile LONG64*>(&GetHeader()->Sequence));
+	}
+
+	void CloseSection()
+	{
+		if (View)
+			UnmapViewOfFile(View);
+
+		if (SectionHandle)
+			CloseHandle(SectionHandle);
+
+		View = nullptr;
+		SectionHandle = nullptr;
+
+		CommittedSizes[0] = 0x0;
+		CommittedSizes[1] = 0x0;
+	}
+
+	bool CreateSection()
+	{
+		const std::wstring Name = SharedMemoryExport::GetChannelName(GetCurrentProcessId());
+
+		/* SEC_RESERVE, so both slots only take up address-space until they are committed */
+		SectionHandle = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE | SEC_RESERVE, static_cast<DWORD>(SectionSize >> 32), static_cast<DWORD>(SectionSize), Name.c_str());
+
+		if (!SectionHandle)
+		{
+			std::cerr << std::format("SharedMemoryExport: CreateFileMappingW failed with error {}!\n", GetLastError());
+			return false;
+		}
+
+		View = static_cast<uint8_t*>(MapViewOfFile(SectionHandle, FILE_MAP_WRITE, 0, 0, static_cast<SIZE_T>(SectionSize)));
+
+		if (!View || !VirtualAlloc(View, static_cast<SIZE_T>(SharedMemoryExport::SlotsOffset), MEM_COMMIT, PAGE_READWRITE))
+		{
+			std::cerr << std::format("SharedMemoryExport: Mapping the section failed with error {}!\n", GetLastError());
+
+			CloseSection();
+			return false;
+		}
+
+		SharedMemoryExport::ChannelHeader* Header = GetHeader();
+		*Header = {};
+
+		Header->Magic = SharedMemoryExport::ChannelMagic;
+		Header->Version = SharedMemoryExport::ChannelVersion;
+		Header->SlotSize = SharedMemoryExport::SlotSize;
+
+		return true;
+	}
+}
+
+bool SharedMemoryExport::Publish(const void* Data, uint64_t Size)
+{
+	std::scoped_lock Lock(PublishMutex);
+
+	if (Size > SlotSize)
+	{
+		std::cerr << std::format("SharedMemoryExport: The image ({} bytes) is larger than a slot ({} bytes), nothing was published!\n", Size, SlotSize);
+		return false;
+	}
+
+	if (!View && !CreateSection())
+		return false;
+
+	ChannelHeader* Header = GetHeader();
+
+	/* The current image, if there is one, is in the other slot */
+	const uint64_t Slot = Header->NumPublished % 2;
+	const uint64_t SlotOffset = SlotsOffset + (Slot * SlotSize);
+
+	if (Size > CommittedSizes[Slot])
+	{
+		if (!VirtualAlloc(View + SlotOffset, static_cast<SIZE_T>(Size), MEM_COMMIT, PAGE_READWRITE))
+		{
+			std::cerr << std::format("SharedMemoryExport: Committing {} bytes failed with error {}!\n", Size, GetLastError());
+			return false;
+		}
+
+		CommittedSizes[Slot] = Size;
+	}
+
+	IncrementSequence();
+
+	memcpy(View + SlotOffset, Data, static_cast<size_t>(Size));
+
+	Header->PayloadOffset = SlotOffset;
+	Header->PayloadSize = Size;
+	Header->NumPublished++;
+
+	IncrementSequence();
+
+	return true;
+}
+
+void SharedMemoryExport::Close()
+{
+	std::scoped_lock Lock(PublishMutex);
+
+	CloseSection();
+}
+
+std::wstring SharedMemoryExport::GetChannelName(uint32_t ProcessId)
+{
+	return std::format(L"Local\\Dumper-7-{}", ProcessId);
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+/*
+Interface:
+	- bool Publish(const void* Data, uint64_t Size)
+	- void Close()
+	-
+	- std::wstring GetChannelName(uint32_t ProcessId)
+*/
+
+/*
+* Publishes images of the object-table (GObjects-Dump.bin, see BinaryObjectDump in ObjectArray.h) to a named shared-memory section, so tools running
+* next to the game get every dump the moment it's complete, without waiting for the file and without parsing any text.
+*
+* The section "Local\Dumper-7-<ProcessId>" starts with a ChannelHeader, followed by two slots of SlotSize bytes. Publish writes into the slot that doesn't
+* hold the current image and only then points the header at it, an image stays intact until the next-but-one Publish.
+*
+* Consumers open the section with OpenFileMappingW and read an image like this:
+*	1. Read Sequence, an odd value means a Publish is in progress and the slots may be changing
+*	2. Read the image at PayloadOffset, PayloadSize bytes
+*	3. Read Sequence again, if it grew by more than 2 the slot may have been overwritten and the image has to be read again
+*
+* Watch-mode publishes every regeneration, NumPublished tells consumers whether there is a new image. Slots are only committed as far as they were used.
+*/
+namespace SharedMemoryExport
+{
+	inline constexpr uint32_t ChannelMagic = 0x4D533744; // 'D7SM'
+	inline constexpr uint32_t ChannelVersion = 1;
+
+	/* Largest image that can be published. Reserved twice, but only committed as far as images were written. */
+	inline constexpr uint64_t SlotSize = sizeof(void*) == 0x8 ? 0x40000000 : 0x8000000;
+
+	/* The header has a page to itself, slots start page-aligned */
+	inline constexpr uint64_t SlotsOffset = 0x1000;
+
+	struct ChannelHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+
+		/* Incremented when a Publish begins and when it ends, odd while one is in progress */
+		uint64_t Sequence;
+		uint64_t NumPublished;
+
+		/* Location of the current image, relative to the start of the section */
+		uint64_t PayloadOffset;
+		uint64_t PayloadSize;
+
+		uint64_t SlotSize;
+	};
+
+	static_assert(sizeof(ChannelHeader) == 0x30);
+
+	/* Creates the section on the first call. Thread-safe, returns false if the image is larger than SlotSize or memory couldn't be committed. */
+	bool Publish(const void* Data, uint64_t Size);
+
+	/* Unmaps the section, it lives on until the last consumer closed its handle */
+	void Close();
+
+	std::wstring GetChannelName(uint32_t ProcessId);
+}
@@ -3,6 +3,9 @@
 #if defined(_WIN32) || defined(_WIN64)
 
 #include "Platform/Private/PlatformWindows.h"
+#include "Platform/Private/ProcessMemory.h"
+#include "Platform/Private/MemorySnapshot.h"
+#include "Platform/Private/SharedMemoryExport.h"
 
 namespace Platform = PlatformWindows;
 
@@ -3,6 +3,7 @@
 #include <Windows.h>
 #include <filesystem>
 #include <string>
+#include <string_view>
 
 #include "Unreal/UnrealObjects.h"
 #include "Unreal/ObjectArray.h"
@@ -132,4 +133,43 @@ void Settings::Config::Load()
 
 	SDKNamespaceName = SDKNamespace;
 	SleepTimeout = max(GetPrivateProfileIntA("Settings", "SleepTimeout", 0, ConfigPath), 0);
+	bCaptureMemorySnapshot = GetPrivateProfileIntA("Settings", "CaptureMemorySnapshot", 0, ConfigPath) != 0;
+	bWatchMode = GetPrivateProfileIntA("Settings", "WatchMode", 0, ConfigPath) != 0;
+	WatchIntervalMs = max(GetPrivateProfileIntA("Settings", "WatchIntervalMs", 5000, ConfigPath), 100);
+	bExportToSharedMemory = GetPrivateProfileIntA("Settings", "SharedMemoryExport", 0, ConfigPath) != 0;
+	TimeSliceBudgetMs = max(GetPrivateProfileIntA("Settings", "TimeSliceBudgetMs", 0, ConfigPath), 0);
+	TimeSliceYieldMs = max(GetPrivateProfileIntA("Settings", "TimeSliceYieldMs", 2, ConfigPath), 1);
+	MemoryBudgetMB = max(GetPrivateProfileIntA("Settings", "MemoryBudgetMB", 0, ConfigPath), 0);
+
+	/* GetPrivateProfileStringA truncates silently and returns Size - 1 then, retry with a larger buffer until the whole value fits */
+	std::string Filter(0x1000, '\0');
+
+	while (true)
+	{
+		const DWORD Length = GetPrivateProfileStringA("Settings", "PackageFilter", "", Filter.data(), static_cast<DWORD>(Filter.size()), ConfigPath);
+
+		if (Length < Filter.size() - 1)
+		{
+			Filter.resize(Length);
+			break;
+		}
+
+		Filter.resize(Filter.size() * 2);
+	}
+
+	PackageFilter.clear();
+
+	for (std::string_view Remaining = Filter; !Remaining.empty();)
+	{
+		const size_t Comma = Remaining.find(',');
+		std::string_view Entry = Remaining.substr(0, Comma);
+
+		Remaining = Comma != std::string_view::npos ? Remaining.substr(Comma + 1) : std::string_view();
+
+		const size_t First = Entry.find_first_not_of(" \t");
+		const size_t Last = Entry.find_last_not_of(" \t");
+
+		if (First != std::string_view::npos)
+			PackageFilter.emplace_back(Entry.substr(First, Last - First + 1));
+	}
 }
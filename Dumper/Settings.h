@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "Unreal/Enums.h"
 
@@ -10,6 +11,27 @@ namespace Settings
 	{
 		/* This option determines whether calls to FindByStringInAllSections should only search executable sections, or all sections. */
 		constexpr bool bSearchOnlyExecutableSectionsForStrings = true;
+
+		/* Decodes GObjects into a flat table once, before the managers are initialized. All object-iteration afterwards reads from this table. */
+		constexpr bool bUseObjectArraySnapshot = false;
+
+		/* Suspends all other threads of the game while the ObjectArraySnapshot is taken, so GObjects can't change while it's read. Requires bUseObjectArraySnapshot. */
+		constexpr bool bFreezeGameForSnapshot = false;
+
+		/* Reads names from GNames directly instead of calling AppendString while dumping, if GNames was found. The SDK keeps using AppendString. */
+		constexpr bool bUseNativeNameDecoding = false;
+
+		/* Stores GObjects, FName::AppendString/GNames, the ProcessEvent index and GWorld in Dumper-7-Offsets.ini, keyed by the build of the game. Cached values are validated before use. */
+		constexpr bool bUseOffsetCache = true;
+
+		/* Splits the search for GObjects across all cores. The first match by address is still the one that's used. */
+		constexpr bool bUseMultithreadedMemoryScans = true;
+
+		/* Answers IsBadReadPtr/IsAddressInProcessRange from a snapshot of the address space, refreshed once before the offsets are searched and once before the SDK is generated. */
+		constexpr bool bUseMemoryRegionCache = true;
+
+		/* Shrinks the tables of all managers to their used size once Generator::InitInternal finished, lowers the peak memory-usage inside of the game */
+		constexpr bool bCompactManagersAfterInit = true;
 	}
   
 	inline constexpr const char* GlobalConfigPath = "C:/Dumper-7/Dumper-7.ini";
@@ -19,6 +41,30 @@ namespace Settings
 		inline int SleepTimeout = 0;
 		inline std::string SDKNamespaceName = "SDK";
 
+		/* "PackageFilter" in Dumper-7.ini, comma-separated names of packages ("Engine" or "/Script/Engine") or classes/structs. Only these, CoreUObject and Engine, and the packages they depend on, are generated. Empty generates everything. Only filters the output, the managers still analyze every package in Generator::InitInternal. */
+		inline std::vector<std::string> PackageFilter;
+
+		/* "CaptureMemorySnapshot=1" in Dumper-7.ini, writes a snapshot of the game's memory next to the dump, to be replayed by Dumper7Bench. See Generator::CaptureMemorySnapshot. */
+		inline bool bCaptureMemorySnapshot = false;
+
+		/* "WatchMode=1" in Dumper-7.ini, keeps watching GObjects after the dump and regenerates it when new structs, classes or enums were loaded. See Generator::HasNewTypes. */
+		inline bool bWatchMode = false;
+
+		/* "WatchIntervalMs" in Dumper-7.ini, time between two checks for new types in WatchMode */
+		inline int WatchIntervalMs = 5000;
+
+		/* "SharedMemoryExport=1" in Dumper-7.ini, publishes the binary object-dump of every dump to shared memory for tools running next to the game. See SharedMemoryExport.h */
+		inline bool bExportToSharedMemory = false;
+
+		/* "TimeSliceBudgetMs" in Dumper-7.ini, passes over GObjects pause after working for this long, trading dump-speed for fewer hitches in the game. 0 disables it. See TimeSlicer.h */
+		inline int TimeSliceBudgetMs = 0;
+
+		/* "TimeSliceYieldMs" in Dumper-7.ini, how long a pass pauses once its time-slice is used up */
+		inline int TimeSliceYieldMs = 2;
+
+		/* "MemoryBudgetMB" in Dumper-7.ini, generates packages in waves that keep the dumpers' memory below this budget. 0 disables it. See MemoryBudget.h */
+		inline int MemoryBudgetMB = 0;
+
 		void Load();
 	};
 
@@ -29,6 +75,9 @@ namespace Settings
 
 		/* Enables support for TEncryptedObjectProperty */
 		constexpr bool bEnableEncryptedObjectPropertySupport = false;
+
+		/* Runs the independent OffsetFinder heuristics in Off::Init on multiple threads. Results are identical to the sequential order. */
+		constexpr bool bRunOffsetFindersInParallel = true;
 	}
 
 	namespace MachineLearning
@@ -53,6 +102,30 @@ namespace Settings
 		inline std::string GameVersion = "";
 
 		inline constexpr const char* SDKGenerationPath = "C:/Dumper-7";
+
+		/* Writes GObjects-Dump.txt and GObjects-Dump-WithProperties.txt on a background thread, while the SDK is being generated */
+		constexpr bool bDumpObjectsInBackground = true;
+
+		/* Writes GObjects-Dump.bin next to the text-dumps, a memory-mappable table of all objects, their properties and names. See BinaryObjectDump in ObjectArray.h */
+		constexpr bool bDumpObjectsBinary = true;
+
+		/* Files written by the generators are handed to the WorkerPool once they are complete, so generation doesn't wait on the disk. See BufferedFileStream.h */
+		constexpr bool bWriteFilesInBackground = true;
+
+		/* Reuses the folder of the previous run instead of moving it to "_OLD", files with unchanged contents aren't rewritten and keep their timestamp. See FileManifest.h */
+		constexpr bool bSkipUnchangedFiles = false;
+
+		/* bSkipUnchangedFiles, or WatchMode, whose regenerations only write the files that changed */
+		inline bool ShouldSkipUnchangedFiles()
+		{
+			return bSkipUnchangedFiles || Config::bWatchMode;
+		}
+
+		/* Number of previous dumps that are kept as "_OLD", "_OLD2", ..., older ones are deleted in the background. 0 deletes the previous dump right away. */
+		constexpr int32 NumOldDumpsToKeep = 1;
+
+		/* Runs all generators passed to Generator::GenerateAll at the same time, each on its own thread, once their folders were created. */
+		constexpr bool bRunGeneratorsConcurrently = true;
 	}
 
 	namespace CppGenerator
@@ -92,6 +165,36 @@ R"(
 
 		/* Adds the 'final' specifier to classes with no loaded child class at SDK-generation time. */
 		constexpr bool bAddFinalSpecifier = true;
+
+		/* Makes UObject::FindObject/FindObjectFast (and StaticClass() through them) look objects up in an index of GObjects built lazily by the SDK, instead of comparing every object's name. */
+		constexpr bool bAddObjectLookupIndex = false;
+
+		/* Makes FName::GetRawString (and ToString through it) convert every distinct FName only once, and adds FName::FindName to get the FName of a string through the same cache. */
+		constexpr bool bCacheNameStrings = false;
+
+		/* Adds the ActorRegistry namespace, an index of the actors of all loaded levels by class. Requires the ULevel::Actors offset, does nothing unless ActorRegistry::Update() is called. */
+		constexpr bool bAddActorRegistry = true;
+
+		/* Packages whose contents, and the contents of everything they include, match the previous run are taken from disk instead of being generated again. Requires Settings::Generator::bSkipUnchangedFiles. See PackageFingerprints.h */
+		constexpr bool bSkipUnchangedPackages = false;
+
+		/* bSkipUnchangedPackages, or WatchMode, whose regenerations only generate the packages that changed */
+		inline bool ShouldSkipUnchangedPackages()
+		{
+			return bSkipUnchangedPackages || Config::bWatchMode;
+		}
+
+		/* Generates "SDK_pch.hpp", a header to precompile containing Basic.hpp and every package-header included by most packages */
+		constexpr bool bGeneratePrecompiledHeader = false;
+
+		/* Percentage of packages that need to include a header, directly or through other headers, for it to be part of "SDK_pch.hpp" */
+		constexpr int32 PrecompiledHeaderMinUsagePercent = 50;
+
+		/* Number of "_functions.cpp" files bundled into each "SDK_Unity_N.cpp" file, compiled instead of the individual files. 0 disables unity-files. */
+		constexpr int32 NumPackagesPerUnityFile = 0;
+
+		/* Generates "SDK/<Package>_package.hpp" for every package, including only that package's headers and the headers they require, as a lighter alternative to SDK.hpp */
+		constexpr bool bGeneratePackageHeaders = false;
 	}
 
 	namespace MappingGenerator
@@ -104,6 +207,30 @@ R"(
 
 		/* Which compression method to use when generating the file. */
 		constexpr EUsmapCompressionMethod CompressionMethod = EUsmapCompressionMethod::ZStandard;
+
+		/* Compression level used with EUsmapCompressionMethod::ZStandard, from 1 to 22 (ZSTD_maxCLevel()). */
+		constexpr int32 ZStandardCompressionLevel = 22;
+
+		/* Number of threads zstd compresses with, 0 compresses on the generating thread. */
+		constexpr int32 ZStandardNumWorkers = 4;
+
+		/* Whether zstd should use long-distance matching. Finds repeated layouts of structs that are far apart in the file. */
+		constexpr bool bZStandardLongDistanceMatching = true;
+	}
+
+	namespace IDAMappingGenerator
+	{
+		/* Writes "<Game>.idmap.idx" next to the '.idmap', the same names sorted by offset in a memory-mappable layout. See IDAMappingGenerator::WriteReadMe */
+		constexpr bool bGenerateBinaryIndex = true;
+	}
+
+	namespace DumpspaceGenerator
+	{
+		/* Whether the Dumpspace files should be written zstd compressed, as *.json.zst. The Dumpspace website expects uncompressed files. */
+		constexpr bool bCompressOutput = false;
+
+		/* Compression level used with bCompressOutput, from 1 to 22. */
+		constexpr int32 CompressionLevel = 3;
 	}
 
 	/* Partially implemented  */
@@ -125,6 +252,16 @@ R"(
 
 		/* Prints debug information during Mapping-Generation */
 		inline constexpr bool bShouldPrintMappingDebugData = false;
+
+		/* Prints the memory used by every manager after Generator::InitInternal */
+		inline constexpr bool bPrintManagerMemoryReports = false;
+
+		/* Times the phases of the dump, prints a summary and writes a Chrome trace ("Dumper-7-Trace.json") into the dump folder. See Utils/Profiler.h. Always on in Dumper7Bench, which defines DUMPER7_ENABLE_PROFILING. */
+#ifdef DUMPER7_ENABLE_PROFILING
+		inline constexpr bool bEnableProfiling = true;
+#else
+		inline constexpr bool bEnableProfiling = false;
+#endif
 	}
 
 	//* * * * * * * * * * * * * * * * * * * * *// 
@@ -1,6 +1,10 @@
 #include "DSGen.h"
 
 #include <fstream>
+#include <charconv>
+#include <stdexcept>
+
+#include "../Compression/zstd.h"
 
 DSGen::DSGen()
 {
@@ -13,6 +17,12 @@ void DSGen::setDirectory(const std::filesystem::path& directory)
 	dumpTimeStamp = std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
 }
 
+void DSGen::setCompression(bool compress, int level)
+{
+	compressOutput = compress;
+	compressionLevel = level;
+}
+
 void DSGen::addOffset(const std::string& name, uintptr_t offset)
 {
 	offsets.push_back(std::pair(name, offset));
@@ -107,87 +117,311 @@ void DSGen::createFunction(ClassHolder& owningClass, const std::string& function
 	owningClass.functions.push_back(f);
 }
 
-void DSGen::bakeStructOrClass(ClassHolder& classHolder)
+namespace
+{
+	// appends a JSON string exactly like nlohmann::json::dump(-1, ' ', false, error_handler_t::replace) would write it
+	void appendString(std::string& out, std::string_view str)
+	{
+		bool needsEscaping = false;
+
+		for (const char c : str)
+		{
+			const auto byte = static_cast<unsigned char>(c);
+
+			if (byte < 0x20 || byte >= 0x80 || c == '"' || c == '\\')
+			{
+				needsEscaping = true;
+				break;
+			}
+		}
+
+		if (!needsEscaping)
+		{
+			out += '"';
+			out += str;
+			out += '"';
+			return;
+		}
+
+		out += nlohmann::json(std::string(str)).dump(-1, ' ', false, nlohmann::detail::error_handler_t::replace);
+	}
+
+	template<typename T>
+	void appendNumber(std::string& out, T value)
+	{
+		char buffer[24];
+		const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+		out.append(buffer, result.ptr);
+	}
+
+	void appendMemberType(std::string& out, const DSGen::MemberType& type)
+	{
+		out += '[';
+		appendString(out, type.typeName);
+		out += ',';
+		appendString(out, DSGen::getTypeShort(type.type));
+		out += ',';
+		appendString(out, type.extendedType);
+		out += ",[";
+
+		for (size_t i = 0; i < type.subTypes.size(); i++)
+		{
+			if (i > 0)
+				out += ',';
+
+			appendMemberType(out, type.subTypes[i]);
+		}
+
+		out += "]]";
+	}
+
+	template<typename T>
+	void appendSingleValueObject(std::string& out, std::string_view key, T value)
+	{
+		out += '{';
+		appendString(out, key);
+		out += ':';
+		appendNumber(out, value);
+		out += '}';
+	}
+}
+
+bool DSGen::StreamingFile::open(const std::filesystem::path& path, bool compress, int level)
+{
+	file.open(path, std::ios::binary);
+
+	if (!file.is_open())
+		return false;
+
+	hasRecords = false;
+
+	if (!compress)
+		return true;
+
+	compressionContext = ZSTD_createCCtx();
+
+	if (!compressionContext)
+		return true;
+
+	ZSTD_CCtx_setParameter(compressionContext, ZSTD_c_compressionLevel, level);
+	compressedBuffer.resize(ZSTD_CStreamOutSize());
+
+	return true;
+}
+
+void DSGen::StreamingFile::write(std::string_view data)
+{
+	if (!compressionContext)
+	{
+		file.write(data.data(), static_cast<std::streamsize>(data.size()));
+		return;
+	}
+
+	ZSTD_inBuffer input = { data.data(), data.size(), 0 };
+
+	while (input.pos < input.size)
+	{
+		ZSTD_outBuffer output = { compressedBuffer.data(), compressedBuffer.size(), 0 };
+
+		if (ZSTD_isError(ZSTD_compressStream2(compressionContext, &output, &input, ZSTD_e_continue)))
+			return;
+
+		file.write(compressedBuffer.data(), static_cast<std::streamsize>(output.pos));
+	}
+}
+
+void DSGen::StreamingFile::writeRecord(std::string_view record)
 {
-	nlohmann::json jClass;
+	if (hasRecords)
+		write(",");
 
-	nlohmann::json membersArray = nlohmann::json::array();
+	write(record);
+	hasRecords = true;
+}
+
+void DSGen::StreamingFile::close()
+{
+	if (compressionContext)
+	{
+		ZSTD_inBuffer input = { nullptr, 0, 0 };
+		size_t remaining = 0;
+
+		do
+		{
+			ZSTD_outBuffer output = { compressedBuffer.data(), compressedBuffer.size(), 0 };
+			remaining = ZSTD_compressStream2(compressionContext, &output, &input, ZSTD_e_end);
+
+			if (ZSTD_isError(remaining))
+				break;
+
+			file.write(compressedBuffer.data(), static_cast<std::streamsize>(output.pos));
+
+		} while (remaining != 0);
+
+		ZSTD_freeCCtx(compressionContext);
+		compressionContext = nullptr;
+		compressedBuffer = std::vector<char>();
+	}
+
+	file.close();
+}
 
-	nlohmann::json inheritInfo = nlohmann::json::array();
-	for (auto super : classHolder.interitedTypes)
-		inheritInfo.push_back(super);
+void DSGen::openFile(StreamingFile& file, const std::string& fileName)
+{
+	const std::string fullName = compressOutput ? fileName + ".zst" : fileName;
 
-	nlohmann::json InheritInfo;
-	InheritInfo["__InheritInfo"] = inheritInfo;
-	membersArray.push_back(InheritInfo);
+	if (!file.open(directory / fullName, compressOutput, compressionLevel))
+		throw std::runtime_error("Couldn't open " + fullName + "!");
+}
 
-	nlohmann::json gSize;
-	gSize["__MDKClassSize"] = classHolder.classSize;
-	membersArray.push_back(gSize);
+void DSGen::beginStreaming()
+{
+	if (directory.empty())
+		throw std::runtime_error("Please initialize a directory first!");
 
-	nlohmann::json gAlign;
-	gAlign["__MDKClassAlignment"] = classHolder.classAlignment;
-	membersArray.push_back(gAlign);
+	openFile(classesFile, "ClassesInfo.json");
+	openFile(functionsFile, "FunctionsInfo.json");
+	openFile(structsFile, "StructsInfo.json");
+	openFile(enumsFile, "EnumsInfo.json");
 
-	nlohmann::json gUnalignedSize;
-	gUnalignedSize["__MDKClassUnalignedSize"] = classHolder.classUnalignedSize;
-	membersArray.push_back(gUnalignedSize);
+	// nlohmann::json sorts the keys of objects, "data" comes before "updated_at" and "version"
+	for (StreamingFile* file : { &classesFile, &functionsFile, &structsFile, &enumsFile })
+		file->write("{\"data\":[");
+}
 
-	for(auto& member : classHolder.members)
+void DSGen::bakeStructOrClass(ClassHolder& classHolder)
+{
+	if (!classesFile.isOpen())
+		beginStreaming();
+
+	std::string& out = recordBuffer;
+	out.clear();
+
+	out += '{';
+	appendString(out, classHolder.className);
+	out += ":[{\"__InheritInfo\":[";
+
+	for (size_t i = 0; i < classHolder.interitedTypes.size(); i++)
 	{
-		nlohmann::json jmember;
+		if (i > 0)
+			out += ',';
+
+		appendString(out, classHolder.interitedTypes[i]);
+	}
+
+	out += "]},";
+	appendSingleValueObject(out, "__MDKClassSize", classHolder.classSize);
+	out += ',';
+	appendSingleValueObject(out, "__MDKClassAlignment", classHolder.classAlignment);
+	out += ',';
+	appendSingleValueObject(out, "__MDKClassUnalignedSize", classHolder.classUnalignedSize);
 
+	for (auto& member : classHolder.members)
+	{
+		out += ",{";
+		appendString(out, member.memberName);
+		out += ":[";
+		appendMemberType(out, member.memberType);
+		out += ',';
+		appendNumber(out, member.offset);
+		out += ',';
+		appendNumber(out, member.size);
+		out += ',';
+		appendNumber(out, member.arrayDim);
 
 		if (member.bitOffset > -1)
-			jmember[member.memberName] = std::make_tuple(member.memberType.jsonify(), member.offset, member.size, member.arrayDim, member.bitOffset);
-		else
-			jmember[member.memberName] = std::make_tuple(member.memberType.jsonify(), member.offset, member.size, member.arrayDim);
-		membersArray.push_back(jmember);
+		{
+			out += ',';
+			appendNumber(out, member.bitOffset);
+		}
+
+		out += "]}";
 	}
-	nlohmann::json j;
 
-	j[classHolder.className] = membersArray;
+	out += "]}";
 
 	if (classHolder.classType == ET_Class)
-		classes.push_back(j);
+		classesFile.writeRecord(out);
 	else
-		structs.push_back(j);
+		structsFile.writeRecord(out);
+
+	if (classHolder.functions.empty())
+		return;
+
+	out.clear();
 
-	if(!classHolder.functions.empty())
+	out += '{';
+	appendString(out, classHolder.className);
+	out += ":[";
+
+	for (size_t i = 0; i < classHolder.functions.size(); i++)
 	{
-		nlohmann::json classFunctions = nlohmann::json::array();
-		for (auto& func : classHolder.functions)
+		const FunctionHolder& func = classHolder.functions[i];
+
+		if (i > 0)
+			out += ',';
+
+		out += '{';
+		appendString(out, func.functionName);
+		out += ":[";
+		appendMemberType(out, func.returnType);
+		out += ",[";
+
+		for (size_t j = 0; j < func.functionParams.size(); j++)
 		{
-			nlohmann::json functionParams = nlohmann::json::array();
+			const auto& param = func.functionParams[j];
 
-			for (const auto& param : func.functionParams)
-				functionParams.push_back(std::make_tuple(param.first.jsonify(), param.first.reference ? "&" : "", param.second));
+			if (j > 0)
+				out += ',';
 
-			nlohmann::json j1;
-			j1[func.functionName] = std::make_tuple(func.returnType.jsonify(), functionParams, func.functionOffset, func.functionFlags);
-			classFunctions.push_back(j1);
+			out += '[';
+			appendMemberType(out, param.first);
+			out += param.first.reference ? ",\"&\"," : ",\"\",";
+			appendString(out, param.second);
+			out += ']';
 		}
-		nlohmann::json f;
-
-		f[classHolder.className] = classFunctions;
 
-		functions.push_back(f);
+		out += "],";
+		appendNumber(out, func.functionOffset);
+		out += ',';
+		appendString(out, func.functionFlags);
+		out += "]}";
 	}
 
+	out += "]}";
+
+	functionsFile.writeRecord(out);
 }
 
 void DSGen::bakeEnum(EnumHolder& enumHolder)
 {
-	nlohmann::json members = nlohmann::json::array();
-	for(const auto& member : enumHolder.enumMembers)
+	if (!enumsFile.isOpen())
+		beginStreaming();
+
+	std::string& out = recordBuffer;
+	out.clear();
+
+	out += '{';
+	appendString(out, enumHolder.enumName);
+	out += ":[[";
+
+	for (size_t i = 0; i < enumHolder.enumMembers.size(); i++)
 	{
-		nlohmann::json m;
-		m[member.first] = member.second;
-		members.push_back(m);
+		if (i > 0)
+			out += ',';
+
+		out += '{';
+		appendString(out, enumHolder.enumMembers[i].first);
+		out += ':';
+		appendNumber(out, enumHolder.enumMembers[i].second);
+		out += '}';
 	}
-	nlohmann::json j;
-	j[enumHolder.enumName] = std::make_tuple(members, enumHolder.enumType);
-	enums.push_back(j);
+
+	out += "],";
+	appendString(out, enumHolder.enumType);
+	out += "]}";
+
+	enumsFile.writeRecord(out);
 }
 
 void DSGen::dump()
@@ -197,29 +431,35 @@ void DSGen::dump()
 
 	constexpr auto version = 10202;
 
-	auto saveToDisk = [&](const nlohmann::json& json, const std::string& fileName, bool offsetFile = false)
-	{
-		nlohmann::json j;
-		j["updated_at"] = dumpTimeStamp;
-		j["data"] = json;
-		j["version"] = version;
-
-		if(offsetFile){
-			nlohmann::json credit;
-			credit["dumper_used"] = "Dumper-7";
-			credit["dumper_link"] = "https://github.com/Encryqed/Dumper-7";
-			j["credit"] = credit;
-		}
-
-		std::ofstream file(directory / fileName);
-		file << j.dump(-1, ' ', false, nlohmann::detail::error_handler_t::replace);
-	};
-
-	saveToDisk(nlohmann::json(nlohmann::json(offsets)), "OffsetsInfo.json", true);
-	saveToDisk(nlohmann::json(classes), "ClassesInfo.json");
-	saveToDisk(nlohmann::json(functions), "FunctionsInfo.json");
-	saveToDisk(nlohmann::json(structs), "StructsInfo.json");
-	saveToDisk(nlohmann::json(enums), "EnumsInfo.json");
+	if (!classesFile.isOpen())
+		beginStreaming();
 
+	nlohmann::json j;
+	j["updated_at"] = dumpTimeStamp;
+	j["data"] = nlohmann::json(offsets);
+	j["version"] = version;
+
+	nlohmann::json credit;
+	credit["dumper_used"] = "Dumper-7";
+	credit["dumper_link"] = "https://github.com/Encryqed/Dumper-7";
+	j["credit"] = credit;
+
+	StreamingFile offsetsFile;
+	openFile(offsetsFile, "OffsetsInfo.json");
+	offsetsFile.write(j.dump(-1, ' ', false, nlohmann::detail::error_handler_t::replace));
+	offsetsFile.close();
+
+	std::string fileEnd = "],\"updated_at\":";
+	appendString(fileEnd, dumpTimeStamp);
+	fileEnd += ",\"version\":";
+	appendNumber(fileEnd, version);
+	fileEnd += '}';
+
+	for (StreamingFile* file : { &classesFile, &functionsFile, &structsFile, &enumsFile })
+	{
+		file->write(fileEnd);
+		file->close();
+	}
 
+	recordBuffer = std::string();
 }
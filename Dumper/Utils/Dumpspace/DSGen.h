@@ -1,9 +1,12 @@
 #pragma once
 
 #include <string>
+#include <fstream>
 #include <filesystem>
 #include "../Json/json.hpp"
 
+struct ZSTD_CCtx_s;
+
 class DSGen
 {
 public:
@@ -122,6 +125,34 @@ public:
 
 
 
+private:
+	// One output file, baked records are written to it right away instead of being kept until dump()
+	class StreamingFile
+	{
+	private:
+		std::ofstream file;
+
+		// only set if the file is zstd compressed
+		ZSTD_CCtx_s* compressionContext;
+		std::vector<char> compressedBuffer;
+
+		bool hasRecords;
+
+	public:
+		StreamingFile() : compressionContext(nullptr), hasRecords(false) {}
+
+		bool open(const std::filesystem::path& path, bool compress, int compressionLevel);
+
+		void write(std::string_view data);
+
+		// writes the ',' between the records of the data array
+		void writeRecord(std::string_view record);
+
+		void close();
+
+		bool isOpen() const { return file.is_open(); }
+	};
+
 private:
 	static inline std::string dumpTimeStamp{};
 
@@ -129,10 +160,22 @@ private:
 
 	static inline std::vector<std::tuple<std::string, uintptr_t>> offsets{};
 
-	static inline nlohmann::json classes = nlohmann::json::array();
-	static inline nlohmann::json structs = nlohmann::json::array();
-	static inline nlohmann::json functions = nlohmann::json::array();
-	static inline nlohmann::json enums = nlohmann::json::array();
+	static inline bool compressOutput = false;
+	static inline int compressionLevel = 3;
+
+	static inline StreamingFile classesFile;
+	static inline StreamingFile structsFile;
+	static inline StreamingFile functionsFile;
+	static inline StreamingFile enumsFile;
+
+	// reused by every bake, only ever holds a single record
+	static inline std::string recordBuffer;
+
+private:
+	static void openFile(StreamingFile& file, const std::string& fileName);
+
+	// opens all record files and writes everything that comes before the data array
+	static void beginStreaming();
 
 public:
 	//redundant constructor
@@ -144,6 +187,13 @@ public:
 	 */
 	static void setDirectory(const std::filesystem::path& directory);
 
+	/**
+	 * \brief compresses all files with zstd, they're written as *.json.zst. Has to be called before the first bake
+	 * \param compress whether the files should be compressed
+	 * \param level the zstd compression level
+	 */
+	static void setCompression(bool compress, int level = 3);
+
 	/**
 	 * \brief 
 	 * \param name the name of the offset
@@ -261,20 +311,20 @@ public:
 	);
 
 	/**
-	 * \brief bakes a ClassHolder which gets later dumped
+	 * \brief bakes a ClassHolder, it's written to disk right away
 	 * \param classHolder the classHolder that should get baked
 	 */
 	static void bakeStructOrClass(ClassHolder& classHolder);
 
 	/**
-	 * \brief bakes a EnumHolder which gets later dumped
+	 * \brief bakes a EnumHolder, it's written to disk right away
 	 * \param enumHolder the enumHolder that should get baked
 	 */
 	static void bakeEnum(EnumHolder& enumHolder);
 
 
 	/**
-	 * \brief dumps all baked information to disk. This should be the final step
+	 * \brief dumps the offsets and finishes all files. This should be the final step
 	 */
 	static void dump();
 };
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+
+#include "Unreal/Enums.h"
+#include "Settings.h"
+
+/*
+* RAM budget for memory-limited processes, enabled with "MemoryBudgetMB" in Dumper-7.ini.
+*
+* The managers and the tables they are built from (TypeIR, StructMemberCache, StructHierarchy, ...) stay resident for the whole run. What grows with
+* the number of packages generated at once are the GeneratorArena blocks of every package being generated and the output-buffers of
+* BufferedFileStream, both are accounted here until they are released, a buffer once its file was written. With a budget, CppGenerator
+* generates packages in dependency-ordered waves sized to keep resident data plus the output of one wave below the budget, and waits for all
+* files of a wave to be written before the next one starts.
+*/
+class MemoryBudget
+{
+private:
+	static inline std::atomic<uint64> TransientBytes = 0x0;
+	static inline std::atomic<uint64> PeakTransientBytes = 0x0;
+
+public:
+	static inline bool IsEnabled()
+	{
+		return Settings::Config::MemoryBudgetMB > 0;
+	}
+
+	static inline uint64 GetBudgetBytes()
+	{
+		return static_cast<uint64>(Settings::Config::MemoryBudgetMB) * 1024 * 1024;
+	}
+
+	static inline void Acquire(uint64 Bytes)
+	{
+		const uint64 Current = (TransientBytes += Bytes);
+
+		uint64 Peak = PeakTransientBytes.load(std::memory_order_relaxed);
+
+		while (Current > Peak && !PeakTransientBytes.compare_exchange_weak(Peak, Current, std::memory_order_relaxed))
+			;
+	}
+
+	static inline void Release(uint64 Bytes)
+	{
+		TransientBytes -= Bytes;
+	}
+
+	/* Highest amount of transient memory since the last ResetPeak() */
+	static inline uint64 GetPeakTransientBytes()
+	{
+		return PeakTransientBytes;
+	}
+
+	static inline void ResetPeak()
+	{
+		PeakTransientBytes = TransientBytes.load();
+	}
+};
@@ -0,0 +1,314 @@
+#pragma once
+
+#include <mutex>
+#include <chrono>
+#include <format>
+#include <memory>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <filesystem>
+#include <string_view>
+#include <unordered_map>
+
+#include "Settings.h"
+
+/* Counters summed up over all threads, shown in the summary and as counter-tracks in the trace */
+enum class EProfilerCounter : int32
+{
+	ObjectsVisited,
+	NamesResolved,
+	BytesWritten,
+
+	Num
+};
+
+/*
+* Lightweight instrumentation of the dump-pipeline, enabled with Settings::Debug::bEnableProfiling.
+*
+* Profiler::Scope measures everything from its construction until its destruction. Scopes nest per thread, every scope records its thread
+* and depth. Events and counters are written to buffers owned by the recording thread, recording never takes a lock after a thread's first event.
+*
+* PrintSummary() and WriteChromeTrace() read the buffers of all threads, they must only be called once the instrumented work has finished.
+* The trace is a Chrome 'trace_event' JSON, to be opened with chrome://tracing or https://ui.perfetto.dev.
+*/
+class Profiler
+{
+public:
+	class Scope;
+
+private:
+	using ClockType = std::chrono::steady_clock;
+
+	struct Event
+	{
+		std::string Name;
+		std::string Detail;
+		int64 StartNs;
+		int64 DurationNs;
+		int32 Depth;
+	};
+
+	struct ThreadBuffer
+	{
+		int32 ThreadIndex;
+		int32 CurrentDepth = 0x0;
+		uint64 Counters[static_cast<int32>(EProfilerCounter::Num)] = {};
+		std::vector<Event> Events;
+	};
+
+private:
+	static inline const ClockType::time_point StartTime = ClockType::now();
+
+	static inline std::mutex BuffersMutex;
+	static inline std::vector<std::unique_ptr<ThreadBuffer>> Buffers;
+
+	static inline thread_local ThreadBuffer* CurrentThreadBuffer = nullptr;
+
+private:
+	static inline ThreadBuffer& GetThreadBuffer()
+	{
+		if (!CurrentThreadBuffer) [[unlikely]]
+		{
+			std::scoped_lock Lock(BuffersMutex);
+
+			Buffers.push_back(std::make_unique<ThreadBuffer>());
+			Buffers.back()->ThreadIndex = static_cast<int32>(Buffers.size());
+
+			CurrentThreadBuffer = Buffers.back().get();
+		}
+
+		return *CurrentThreadBuffer;
+	}
+
+	static inline int64 GetTimeNs()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(ClockType::now() - StartTime).count();
+	}
+
+	static inline void AppendJsonString(std::string& Out, std::string_view Str)
+	{
+		Out += '"';
+
+		for (const char C : Str)
+		{
+			if (C == '"' || C == '\\')
+			{
+				Out += '\\';
+				Out += C;
+			}
+			else if (static_cast<uint8>(C) < 0x20)
+			{
+				Out += std::format("\\u{:04x}", static_cast<int32>(C));
+			}
+			else
+			{
+				Out += C;
+			}
+		}
+
+		Out += '"';
+	}
+
+public:
+	static inline const char* GetCounterName(EProfilerCounter Counter)
+	{
+		switch (Counter)
+		{
+		case EProfilerCounter::ObjectsVisited:
+			return "ObjectsVisited";
+		case EProfilerCounter::NamesResolved:
+			return "NamesResolved";
+		case EProfilerCounter::BytesWritten:
+			return "BytesWritten";
+		default:
+			return "Unknown";
+		}
+	}
+
+	static inline void AddCount(EProfilerCounter Counter, uint64 Count = 1)
+	{
+		if constexpr (Settings::Debug::bEnableProfiling)
+			GetThreadBuffer().Counters[static_cast<int32>(Counter)] += Count;
+	}
+
+	static inline uint64 GetCount(EProfilerCounter Counter)
+	{
+		std::scoped_lock Lock(BuffersMutex);
+
+		uint64 Total = 0x0;
+
+		for (const std::unique_ptr<ThreadBuffer>& Buffer : Buffers)
+			Total += Buffer->Counters[static_cast<int32>(Counter)];
+
+		return Total;
+	}
+
+	struct PhaseSummary
+	{
+		std::string Name;
+		int32 MinDepth = 0x7FFFFFFF;
+		uint64 NumCalls = 0x0;
+		int64 TotalNs = 0x0;
+		int64 MaxNs = 0x0;
+	};
+
+	/* Time spent in, and number of, all scopes of the same name, longest first. Nested scopes are counted into their parents too. */
+	static inline std::vector<PhaseSummary> GetSummary()
+	{
+		std::scoped_lock Lock(BuffersMutex);
+
+		std::unordered_map<std::string_view, PhaseSummary> Entries;
+
+		for (const std::unique_ptr<ThreadBuffer>& Buffer : Buffers)
+		{
+			for (const Event& Ev : Buffer->Events)
+			{
+				PhaseSummary& Current = Entries[Ev.Name];
+				Current.MinDepth = std::min(Current.MinDepth, Ev.Depth);
+				Current.NumCalls++;
+				Current.TotalNs += Ev.DurationNs;
+				Current.MaxNs = std::max(Current.MaxNs, Ev.DurationNs);
+			}
+		}
+
+		std::vector<PhaseSummary> Summary;
+		Summary.reserve(Entries.size());
+
+		for (auto& [Name, Current] : Entries)
+		{
+			Current.Name = Name;
+			Summary.push_back(std::move(Current));
+		}
+
+		std::sort(Summary.begin(), Summary.end(), [](const PhaseSummary& Left, const PhaseSummary& Right) { return Left.TotalNs > Right.TotalNs; });
+
+		return Summary;
+	}
+
+	static inline void PrintSummary()
+	{
+		if constexpr (!Settings::Debug::bEnableProfiling)
+			return;
+
+		std::cerr << std::format("\n{:<48} {:>8} {:>12} {:>12} {:>12}\n", "Phase", "Calls", "Total (ms)", "Avg (ms)", "Max (ms)");
+
+		for (const PhaseSummary& Current : GetSummary())
+		{
+			const std::string IndentedName = std::string(std::min(Current.MinDepth, 8) * 2, ' ') + Current.Name;
+
+			std::cerr << std::format("{:<48} {:>8} {:>12.2f} {:>12.3f} {:>12.2f}\n", IndentedName, Current.NumCalls, Current.TotalNs / 1e6,
+				(Current.TotalNs / 1e6) / Current.NumCalls, Current.MaxNs / 1e6);
+		}
+
+		for (int32 i = 0; i < static_cast<int32>(EProfilerCounter::Num); i++)
+			std::cerr << std::format("{:<48} {:>8}\n", GetCounterName(static_cast<EProfilerCounter>(i)), GetCount(static_cast<EProfilerCounter>(i)));
+
+		std::cerr << "\n";
+	}
+
+	/* Writes all events as complete-events ("ph":"X") and the final value of every counter as a counter-event ("ph":"C") */
+	static inline bool WriteChromeTrace(const std::filesystem::path& FilePath)
+	{
+		if constexpr (!Settings::Debug::bEnableProfiling)
+			return false;
+
+		std::scoped_lock Lock(BuffersMutex);
+
+		std::string Json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		bool bIsFirst = true;
+
+		int64 EndNs = 0x0;
+
+		for (const std::unique_ptr<ThreadBuffer>& Buffer : Buffers)
+		{
+			Json += std::format("{}{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"Thread {}\"}}}}", bIsFirst ? "" : ",\n", Buffer->ThreadIndex, Buffer->ThreadIndex);
+			bIsFirst = false;
+
+			for (const Event& Ev : Buffer->Events)
+			{
+				Json += ",\n{\"name\":";
+				AppendJsonString(Json, Ev.Name);
+				Json += std::format(",\"cat\":\"Dumper-7\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":1,\"tid\":{}", Ev.StartNs / 1e3, Ev.DurationNs / 1e3, Buffer->ThreadIndex);
+
+				if (!Ev.Detail.empty())
+				{
+					Json += ",\"args\":{\"detail\":";
+					AppendJsonString(Json, Ev.Detail);
+					Json += "}";
+				}
+
+				Json += "}";
+
+				EndNs = std::max(EndNs, Ev.StartNs + Ev.DurationNs);
+			}
+		}
+
+		for (int32 i = 0; i < static_cast<int32>(EProfilerCounter::Num); i++)
+		{
+			uint64 Total = 0x0;
+
+			for (const std::unique_ptr<ThreadBuffer>& Buffer : Buffers)
+				Total += Buffer->Counters[i];
+
+			const char* Name = GetCounterName(static_cast<EProfilerCounter>(i));
+
+			Json += std::format("{}{{\"name\":\"{}\",\"ph\":\"C\",\"ts\":{:.3f},\"pid\":1,\"tid\":0,\"args\":{{\"{}\":{}}}}}", bIsFirst ? "" : ",\n", Name, EndNs / 1e3, Name, Total);
+			bIsFirst = false;
+		}
+
+		Json += "\n]}\n";
+
+		std::ofstream TraceFile(FilePath, std::ios::binary | std::ios::trunc);
+
+		if (!TraceFile.is_open())
+		{
+			std::cerr << "Error writing the profiler-trace!\n";
+			return false;
+		}
+
+		TraceFile.write(Json.data(), Json.size());
+
+		return TraceFile.good();
+	}
+};
+
+class Profiler::Scope
+{
+private:
+	ThreadBuffer* Buffer = nullptr;
+	std::string_view Name;
+	std::string Detail;
+	int64 StartNs = 0x0;
+
+public:
+	/* Name is the phase shown in the summary, Detail, like the name of a package, only appears in the trace */
+	inline explicit Scope(std::string_view InName, std::string&& InDetail = {})
+	{
+		if constexpr (Settings::Debug::bEnableProfiling)
+		{
+			Buffer = &GetThreadBuffer();
+			Buffer->CurrentDepth++;
+
+			Name = InName;
+			Detail = std::move(InDetail);
+			StartNs = GetTimeNs();
+		}
+	}
+
+	inline ~Scope()
+	{
+		if constexpr (Settings::Debug::bEnableProfiling)
+		{
+			const int64 EndNs = GetTimeNs();
+
+			Buffer->CurrentDepth--;
+			Buffer->Events.push_back({ std::string(Name), std::move(Detail), StartNs, EndNs - StartNs, Buffer->CurrentDepth });
+		}
+	}
+
+	Scope(const Scope&) = delete;
+	Scope& operator=(const Scope&) = delete;
+};
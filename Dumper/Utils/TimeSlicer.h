@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+#include <thread>
+
+#include "Settings.h"
+
+/*
+* Cooperative time-slicing of the passes over the whole object-array, enabled with "TimeSliceBudgetMs" in Dumper-7.ini.
+*
+* Passes call YieldPoint() between bounded pieces of work, like a block of ObjectsIterator, an item of WorkerPool::ParallelFor or a block of the
+* object-dumps. Time is split into slices of Settings::Config::TimeSliceBudgetMs of work followed by a pause of TimeSliceYieldMs, a thread
+* reaching a YieldPoint during a pause sleeps until it ends. The game gets its cores, the name-pool lock and memory bandwidth back in between,
+* dumping takes longer but no longer causes long hitches.
+*
+* The slices are the same for every thread, all workers of a parallel pass pause together instead of one at a time, which would keep all but
+* one of them busy at any point. There is no per-thread state, a worker that was idle doesn't pause for work it didn't do. Yielding never
+* changes the output.
+*/
+class TimeSlicer
+{
+private:
+	using ClockType = std::chrono::steady_clock;
+
+	/* Start of the first slice, every following one starts a multiple of (TimeSliceBudgetMs + TimeSliceYieldMs) later */
+	static inline const ClockType::time_point FirstSliceStart = ClockType::now();
+
+public:
+	static inline bool IsEnabled()
+	{
+		return Settings::Config::TimeSliceBudgetMs > 0;
+	}
+
+	/* Pauses the calling thread if the current slice is used up, cheap enough to be called every few hundred objects */
+	static inline void YieldPoint()
+	{
+		if (!IsEnabled()) [[likely]]
+			return;
+
+		const std::chrono::milliseconds Budget(Settings::Config::TimeSliceBudgetMs);
+		const std::chrono::milliseconds Pause(Settings::Config::TimeSliceYieldMs);
+
+		const ClockType::duration TimeInSlice = (ClockType::now() - FirstSliceStart) % (Budget + Pause);
+
+		if (TimeInSlice < Budget)
+			return;
+
+		std::this_thread::sleep_for((Budget + Pause) - TimeInSlice);
+	}
+};
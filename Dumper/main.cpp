@@ -3,6 +3,7 @@
 #include <chrono>
 #include <format>
 #include <fstream>
+#include <optional>
 
 #include "Generators/CppGenerator.h"
 #include "Generators/MappingGenerator.h"
@@ -10,6 +11,9 @@
 #include "Generators/DumpspaceGenerator.h"
 
 #include "Generators/Generator.h"
+#include "WorkerPool.h"
+#include "Profiler.h"
+#include "Platform.h"
 
 DWORD MainThread(HMODULE Module)
 {
@@ -30,8 +34,9 @@ DWORD MainThread(HMODULE Module)
 		Sleep(Settings::Config::SleepTimeout);
 	}
 
+	std::optional<Profiler::Scope> TotalScope(std::in_place, "Total");
+
 	Generator::InitEngineCore();
-	Generator::InitInternal();
 
 	if (Settings::Generator::GameName.empty() && Settings::Generator::GameVersion.empty())
 	{
@@ -54,21 +59,79 @@ DWORD MainThread(HMODULE Module)
 
 	std::cerr << std::format("FolderName: {}-{}\n\n", Settings::Generator::GameVersion, Settings::Generator::GameName);
 
-	Generator::Generate<CppGenerator>();
-	Generator::Generate<MappingGenerator>();
-	Generator::Generate<IDAMappingGenerator>();
-	Generator::Generate<DumpspaceGenerator>();
+	/* Taken before InitInternal, so the snapshot doesn't contain the tables of the managers */
+	if (Settings::Config::bCaptureMemorySnapshot)
+		Generator::CaptureMemorySnapshot();
+
+	Generator::InitInternal();
+
+	Generator::GenerateAll<CppGenerator, MappingGenerator, IDAMappingGenerator, DumpspaceGenerator>();
+
+	Generator::WaitForBackgroundTasks();
+
+	/* The workers must be joined before FreeLibraryAndExitThread unloads their code */
+	WorkerPool::Shutdown();
+
+	TotalScope.reset();
 
 	auto t_C = std::chrono::high_resolution_clock::now();
 
 	std::chrono::duration<double, std::milli> ms_double_ = t_C - t_1;
 
-	std::cerr << "\n\nGenerating SDK took (" << ms_double_.count() << "ms)\n\n\n";
+	std::cerr << "\n\nGenerating SDK took (" << ms_double_.count() << "ms)\n\n";
+
+	BufferedFileStream::PrintStatistics();
+
+	FName::DEBUGPrintNameCacheStats();
+	std::cerr << "\n\n";
+
+	if constexpr (Settings::Debug::bEnableProfiling)
+	{
+		Profiler::PrintSummary();
+
+		if (!Generator::GetDumperFolder().empty())
+			Profiler::WriteChromeTrace(Generator::GetDumperFolder() / "Dumper-7-Trace.json");
+	}
+
+	if (Settings::Config::bWatchMode)
+	{
+		std::cerr << std::format("WatchMode: checking for new types every {}ms, press F6 to unload.\n", Settings::Config::WatchIntervalMs);
+
+		std::cerr << "WatchMode: every regeneration rebuilds the whole SDK in memory, only files and packages that changed are written to disk.\n";
+
+		std::cerr << "\n";
+	}
+
+	auto LastWatchTime = std::chrono::steady_clock::now();
 
 	while (true)
 	{
+		/* Levels and plugins loaded after the dump bring new types, see Generator::Regenerate for which files are written again */
+		if (Settings::Config::bWatchMode && (std::chrono::steady_clock::now() - LastWatchTime) >= std::chrono::milliseconds(Settings::Config::WatchIntervalMs))
+		{
+			if (Generator::HasNewTypes())
+			{
+				std::cerr << "New types were loaded, regenerating the SDK...\n\n";
+
+				const auto RegenerationStartTime = std::chrono::high_resolution_clock::now();
+
+				Generator::Regenerate<CppGenerator, MappingGenerator, IDAMappingGenerator, DumpspaceGenerator>();
+
+				/* Started again by the next regeneration, no worker may be running once F6 unloads the module */
+				WorkerPool::Shutdown();
+
+				const std::chrono::duration<double, std::milli> RegenerationTime = std::chrono::high_resolution_clock::now() - RegenerationStartTime;
+
+				std::cerr << std::format("\nRegenerating SDK took ({:.0f}ms)\n\n", RegenerationTime.count());
+			}
+
+			LastWatchTime = std::chrono::steady_clock::now();
+		}
+
 		if (GetAsyncKeyState(VK_F6) & 1)
 		{
+			SharedMemoryExport::Close();
+
 			fclose(stderr);
 			if (Dummy) fclose(Dummy);
 			FreeConsole();
@@ -31,4 +31,37 @@ target("Dumper-7")
         set_targetdir("Bin/Debug/")
         set_objectdir("Bin/Intermediates/Debug/.objs")
         set_dependir("Bin/Intermediates/Debug/.deps")
-    end
\ No newline at end of file
+    end
+
+-- Shared by the benchmarks, every source of the dumper except the dll entry point
+function add_bench_sources()
+    set_kind("binary")
+
+    add_files("Dumper/**.cpp|main.cpp")
+    add_files("Dumper/**.c")
+    add_files("Bench/AllocationCounter.cpp")
+
+    add_includedirs("Dumper", "Dumper/Utils", "Dumper/Engine/Public", "Dumper/Generator/Public", "Dumper/Platform/Public")
+
+    add_cxflags("/wd4244", "/wd4267", "/wd4369", "/wd4715")
+    add_links("kernel32", "user32", "advapi32", "shell32", "ole32", "ntdll")
+
+    set_runtimes(is_mode("release") and "MD" or "MDd")
+    set_targetdir(is_mode("release") and "Bin/Release/" or "Bin/Debug/")
+end
+
+-- Replays memory-snapshots written with "CaptureMemorySnapshot=1" (see Bench/Dumper7Bench.cpp)
+target("Dumper7Bench")
+    add_bench_sources()
+    add_files("Bench/Dumper7Bench.cpp")
+    add_defines("DUMPER7_ENABLE_PROFILING") -- the phase-times are read from the Profiler
+
+-- Times the core data-structures on synthetic workloads (see Bench/Dumper7MicroBench.cpp)
+target("Dumper7MicroBench")
+    add_bench_sources()
+    add_files("Bench/Dumper7MicroBench.cpp")
+
+-- Dumps a running game from another process, with the offsets of its Dumper-7-Offsets.ini entry (see Bench/Dumper7External.cpp)
+target("Dumper7External")
+    add_bench_sources()
+    add_files("Bench/Dumper7External.cpp")